@@ -0,0 +1,115 @@
+#include <QJsonArray>
+
+#include "BenchmarkSuite.h"
+#include "Benchmark.h"
+#include "Version.h"
+
+#ifndef OFFBENCH_REVISION
+#define OFFBENCH_REVISION "unknown"
+#endif
+
+BenchmarkSuite::BenchmarkSuite(const Options & options) : options(options)
+{
+}
+
+QString BenchmarkSuite::dataFile(MeshGenerator::Shape shape, qint64 size) const
+{
+	return QDir(options.dataDirectory).filePath(QString("%1-%2-%3.off")
+		.arg(MeshGenerator::shapeNames()[shape])
+		.arg(MeshGenerator::formatSize(size))
+		.arg(options.seed));
+}
+
+QJsonObject BenchmarkSuite::run()
+{
+	QTextStream progress(stderr);
+	if (!QDir().mkpath(options.dataDirectory)) {
+		throw tr("Unable to create directory ") + options.dataDirectory;
+	}
+
+	QJsonArray results;
+	for (int s = 0; s < options.sizes.size(); s++) {
+		for (int i = 0; i < options.shapes.size(); i++) {
+			MeshGenerator::Shape shape = options.shapes[i];
+			qint64 size = options.sizes[s];
+			QString name = MeshGenerator::shapeNames()[shape];
+			QString file = dataFile(shape, size);
+
+			// Write into a temporary file first, so an aborted run
+			// does not leave an incomplete file for the next one
+			if (!QFile::exists(file)) {
+				progress << tr("Generating %1").arg(file) << endl;
+				QString partial = file + ".part";
+				MeshGenerator(shape, size, options.seed).write(partial);
+				if (!QFile::rename(partial, file)) {
+					throw tr("Unable to write file ") + file;
+				}
+			}
+
+			progress << tr("Measuring %1 with %2 faces").arg(name)
+				.arg(MeshGenerator::formatSize(size)) << endl;
+			QJsonObject result;
+			result["shape"] = name;
+			result["size"] = MeshGenerator::formatSize(size);
+			result["report"] = Benchmark::measure(file, SceneFactory::LoadOptions(),
+				options.iterations);
+			results.append(result);
+		}
+	}
+
+	QJsonObject report;
+	report["version"] = QString(OFFVIEW_VERSION);
+	report["revision"] = QString(OFFBENCH_REVISION);
+	report["iterations"] = options.iterations;
+	report["seed"] = static_cast<double>(options.seed);
+	report["results"] = results;
+	return report;
+}
+
+QMap<QString, double> BenchmarkSuite::medians(const QJsonObject & report)
+{
+	QMap<QString, double> times;
+	QJsonArray results = report["results"].toArray();
+	for (int i = 0; i < results.size(); i++) {
+		QJsonObject result = results[i].toObject();
+		QString mesh = result["shape"].toString() + "-" + result["size"].toString();
+		QJsonObject phases = result["report"].toObject()["phases"].toObject();
+		QStringList names = phases.keys();
+		for (int p = 0; p < names.size(); p++) {
+			times[mesh + " " + names[p]] = phases[names[p]].toObject()["median"].toDouble();
+		}
+	}
+	return times;
+}
+
+QString BenchmarkSuite::compare(const QJsonObject & before, const QJsonObject & after)
+{
+	QMap<QString, double> oldTimes = medians(before);
+	QMap<QString, double> newTimes = medians(after);
+
+	QString table;
+	QTextStream out(&table);
+	out << QString("%1 %2 %3 %4\n")
+		.arg(tr("Mesh and phase"), -44)
+		.arg(before["revision"].toString(), 12)
+		.arg(after["revision"].toString(), 12)
+		.arg(tr("Change"), 9);
+
+	// Only the entries of both reports can be compared
+	QStringList keys = newTimes.keys();
+	for (int i = 0; i < keys.size(); i++) {
+		if (!oldTimes.contains(keys[i])) {
+			continue;
+		}
+		double oldTime = oldTimes[keys[i]];
+		double newTime = newTimes[keys[i]];
+		QString change = oldTime > 0.0 ?
+			QString("%1%").arg(100.0 * (newTime - oldTime) / oldTime, 0, 'f', 1) : QString("-");
+		out << QString("%1 %2 %3 %4\n")
+			.arg(keys[i], -44)
+			.arg(oldTime, 12, 'f', 3)
+			.arg(newTime, 12, 'f', 3)
+			.arg(change, 9);
+	}
+	return table;
+}
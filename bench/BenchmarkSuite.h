@@ -0,0 +1,94 @@
+#pragma once
+
+#include <QtCore>
+#include <QJsonObject>
+
+#include "MeshGenerator.h"
+
+/**
+ * @brief Runs the Benchmark of OffView on generated meshes
+ *
+ * Generates one file for each combination of shape and size with the
+ * MeshGenerator and measures it with Benchmark::measure(). The files are
+ * kept in a data directory and reused by later runs, since generating the
+ * large meshes takes longer than the benchmark itself. The results are
+ * collected in one JSON report, which contains the revision of the build,
+ * so reports of different commits can be compared with compare().
+ *
+ * @see Benchmark
+ */
+class BenchmarkSuite
+{
+	Q_DECLARE_TR_FUNCTIONS(BenchmarkSuite)
+
+public:
+	/**
+	 * @brief Settings of a benchmark run
+	 */
+	struct Options
+	{
+		/**
+		 * @brief The measured shapes
+		 */
+		QVector<MeshGenerator::Shape> shapes;
+
+		/**
+		 * @brief Target number of faces of the measured meshes
+		 */
+		QVector<qint64> sizes;
+
+		/**
+		 * @brief How often each file is loaded
+		 */
+		int iterations;
+
+		/**
+		 * @brief Directory for the generated files
+		 */
+		QString dataDirectory;
+
+		/**
+		 * @brief Start value of the random numbers of the generator
+		 */
+		quint32 seed;
+	};
+
+	/**
+	 * @brief Constructor
+	 *
+	 * @param [in] options The settings of the run
+	 */
+	BenchmarkSuite(const Options & options);
+
+	/**
+	 * @brief Generates the missing files and runs all benchmarks
+	 *
+	 * Prints the progress to the standard error output. Throws a QString
+	 * if a file can not be generated or loaded.
+	 *
+	 * @return The report with one entry for each file
+	 */
+	QJsonObject run();
+
+	/**
+	 * @brief Compares the median times of two reports
+	 *
+	 * @param [in] before The report of the older build
+	 * @param [in] after The report of the newer build
+	 * @return A table with the times of both reports and the change in percent
+	 */
+	static QString compare(const QJsonObject & before, const QJsonObject & after);
+
+	/**
+	 * @brief Returns the path of the generated file for a shape and size
+	 */
+	QString dataFile(MeshGenerator::Shape shape, qint64 size) const;
+
+private:
+	/**
+	 * @brief Returns the median times of a report by file and phase
+	 */
+	static QMap<QString, double> medians(const QJsonObject & report);
+
+	Options options;
+};
@@ -0,0 +1,385 @@
+#include <cmath>
+
+#include "MeshGenerator.h"
+
+/**
+ * @brief Collects the tokens in a large buffer and writes it in blocks
+ */
+class MeshGenerator::Writer
+{
+	Q_DECLARE_TR_FUNCTIONS(MeshGenerator)
+
+public:
+	Writer(const QString & fileName) : file(fileName), separator(' '), lineStart(true)
+	{
+		if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+			throw tr("Unable to write file ") + fileName;
+		}
+		buffer.reserve(BlockSize + 1024);
+	}
+
+	void text(const char *value)
+	{
+		token();
+		buffer.append(value);
+	}
+
+	void number(qint64 value)
+	{
+		token();
+		buffer.append(QByteArray::number(value));
+	}
+
+	void number(float value)
+	{
+		token();
+		buffer.append(QByteArray::number(static_cast<double>(value), 'f', 5));
+	}
+
+	void comment(const QByteArray & value)
+	{
+		token();
+		buffer.append("# ");
+		buffer.append(value);
+	}
+
+	void endLine()
+	{
+		buffer.append('\n');
+		lineStart = true;
+		if (buffer.size() >= BlockSize) {
+			flush();
+		}
+	}
+
+	void setSeparator(char value)
+	{
+		separator = value;
+	}
+
+	void close()
+	{
+		flush();
+		file.close();
+	}
+
+private:
+	static const int BlockSize = 1 << 20;
+
+	void token()
+	{
+		if (!lineStart) {
+			buffer.append(separator);
+		}
+		lineStart = false;
+	}
+
+	void flush()
+	{
+		if (file.write(buffer) != buffer.size()) {
+			throw tr("Unable to write file ") + file.fileName();
+		}
+		buffer.clear();
+	}
+
+	QFile file;
+	QByteArray buffer;
+	char separator;
+	bool lineStart;
+};
+
+MeshGenerator::Random::Random(quint32 seed) : state(seed ? seed : 0x9e3779b9u)
+{
+}
+
+float MeshGenerator::Random::uniform()
+{
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+	return (state >> 8) / 16777216.0f;
+}
+
+int MeshGenerator::Random::integer(int min, int max)
+{
+	return min + qMin(static_cast<int>(uniform() * (max - min + 1)), max - min);
+}
+
+MeshGenerator::MeshGenerator(Shape shape, qint64 faces, quint32 seed)
+	: shape(shape), faces(qMax(faces, qint64(1))), seed(seed)
+{
+}
+
+QStringList MeshGenerator::shapeNames()
+{
+	return QStringList() << "sphere" << "heightfield" << "soup" << "colored"
+		<< "ngons" << "comments";
+}
+
+qint64 MeshGenerator::parseSize(const QString & text)
+{
+	QString digits = text.trimmed().toUpper();
+	qint64 factor = 1;
+	if (digits.endsWith('K')) {
+		factor = 1000;
+		digits.chop(1);
+	} else if (digits.endsWith('M')) {
+		factor = 1000000;
+		digits.chop(1);
+	}
+
+	bool valid = false;
+	qint64 value = digits.toLongLong(&valid);
+	return valid && value > 0 ? value * factor : 0;
+}
+
+QString MeshGenerator::formatSize(qint64 faces)
+{
+	if (faces % 1000000 == 0) {
+		return QString::number(faces / 1000000) + "M";
+	} else if (faces % 1000 == 0) {
+		return QString::number(faces / 1000) + "K";
+	}
+	return QString::number(faces);
+}
+
+void MeshGenerator::write(const QString & fileName) const
+{
+	Writer out(fileName);
+	switch (shape) {
+		case Sphere: writeSphere(&out); break;
+		case HeightField: writeHeightField(&out, false, false); break;
+		case Soup: writeSoup(&out); break;
+		case Colored: writeHeightField(&out, true, false); break;
+		case Polygons: writePolygons(&out); break;
+		case Comments: writeHeightField(&out, false, true); break;
+		default: throw tr("Unknown shape");
+	}
+	out.close();
+}
+
+void MeshGenerator::writeSphere(Writer *out) const
+{
+	// The rings have twice as many segments as there are rings,
+	// which results in rings*segments faces
+	const float pi = 3.14159265f;
+	qint64 rings = qMax(qint64(3), qRound64(std::sqrt(faces / 2.0)));
+	qint64 segments = 2 * rings;
+	qint64 bottom = 1 + (rings - 1) * segments;
+
+	out->text("OFF");
+	out->endLine();
+	out->number(bottom + 1);
+	out->number(rings * segments);
+	out->number(qint64(0));
+	out->endLine();
+
+	out->number(0.0f); out->number(0.0f); out->number(1.0f);
+	out->endLine();
+	for (qint64 k = 1; k < rings; k++) {
+		float theta = pi * k / rings;
+		for (qint64 j = 0; j < segments; j++) {
+			float phi = 2.0f * pi * j / segments;
+			out->number(std::sin(theta) * std::cos(phi));
+			out->number(std::sin(theta) * std::sin(phi));
+			out->number(std::cos(theta));
+			out->endLine();
+		}
+	}
+	out->number(0.0f); out->number(0.0f); out->number(-1.0f);
+	out->endLine();
+
+	// All faces are counter clockwise when seen from outside
+	for (qint64 j = 0; j < segments; j++) {
+		out->number(qint64(3));
+		out->number(qint64(0));
+		out->number(1 + j);
+		out->number(1 + (j + 1) % segments);
+		out->endLine();
+	}
+	for (qint64 k = 1; k + 1 < rings; k++) {
+		qint64 ring = 1 + (k - 1) * segments;
+		for (qint64 j = 0; j < segments; j++) {
+			qint64 next = (j + 1) % segments;
+			out->number(qint64(4));
+			out->number(ring + j);
+			out->number(ring + segments + j);
+			out->number(ring + segments + next);
+			out->number(ring + next);
+			out->endLine();
+		}
+	}
+	qint64 ring = 1 + (rings - 2) * segments;
+	for (qint64 j = 0; j < segments; j++) {
+		out->number(qint64(3));
+		out->number(ring + j);
+		out->number(bottom);
+		out->number(ring + (j + 1) % segments);
+		out->endLine();
+	}
+}
+
+void MeshGenerator::writeHeightField(Writer *out, bool colored, bool comments) const
+{
+	Random random(seed);
+	qint64 n = qMax(qint64(1), qRound64(std::sqrt(static_cast<double>(faces))));
+	qint64 side = n + 1;
+
+	if (comments) {
+		out->comment("Synthetic height field for the OffView benchmarks");
+		out->endLine();
+		out->comment("Every line may be followed by a comment or empty lines");
+		out->endLine();
+		out->endLine();
+	}
+	out->text(colored ? "COFF" : "OFF");
+	if (comments) {
+		out->comment("format");
+	}
+	out->endLine();
+	out->number(side * side);
+	out->number(n * n);
+	out->number(qint64(0));
+	if (comments) {
+		out->comment("vertices, faces, edges");
+		out->setSeparator('\t');
+	}
+	out->endLine();
+
+	for (qint64 j = 0; j < side; j++) {
+		if (comments) {
+			out->endLine();
+			out->comment("Row " + QByteArray::number(j));
+			out->endLine();
+		}
+		for (qint64 i = 0; i < side; i++) {
+			float x = -1.0f + 2.0f * i / n;
+			float y = -1.0f + 2.0f * j / n;
+			float z = 0.2f * std::sin(3.0f * x) * std::cos(2.0f * y)
+				+ 0.02f * (random.uniform() - 0.5f);
+			out->number(x);
+			out->number(y);
+			out->number(z);
+			if (colored) {
+				out->number(0.5f * (x + 1.0f));
+				out->number(0.5f * (y + 1.0f));
+				out->number(qBound(0.0f, 2.5f * z + 0.5f, 1.0f));
+				out->number(1.0f);
+			}
+			if (comments && i % 3 == 0) {
+				out->comment("vertex " + QByteArray::number(j * side + i));
+			}
+			out->endLine();
+		}
+	}
+
+	for (qint64 j = 0; j < n; j++) {
+		if (comments) {
+			out->comment("Quads of row " + QByteArray::number(j));
+			out->endLine();
+		}
+		for (qint64 i = 0; i < n; i++) {
+			qint64 first = j * side + i;
+			out->number(qint64(4));
+			out->number(first);
+			out->number(first + 1);
+			out->number(first + side + 1);
+			out->number(first + side);
+			if (colored) {
+				// Every fourth face is translucent to exercise the sorting
+				out->number(qint64(random.integer(0, 255)));
+				out->number(qint64(random.integer(0, 255)));
+				out->number(qint64(random.integer(0, 255)));
+				out->number(qint64((j * n + i) % 4 == 0 ? 128 : 255));
+			}
+			if (comments && i % 5 == 0) {
+				out->comment("face");
+			}
+			out->endLine();
+			if (comments && i % 7 == 0) {
+				out->endLine();
+			}
+		}
+	}
+}
+
+void MeshGenerator::writeSoup(Writer *out) const
+{
+	Random random(seed);
+
+	out->text("OFF");
+	out->endLine();
+	out->number(3 * faces);
+	out->number(faces);
+	out->number(qint64(0));
+	out->endLine();
+
+	for (qint64 i = 0; i < faces; i++) {
+		float center[3];
+		for (int c = 0; c < 3; c++) {
+			center[c] = 2.0f * random.uniform() - 1.0f;
+		}
+		for (int k = 0; k < 3; k++) {
+			for (int c = 0; c < 3; c++) {
+				out->number(center[c] + 0.1f * (random.uniform() - 0.5f));
+			}
+			out->endLine();
+		}
+	}
+
+	for (qint64 i = 0; i < faces; i++) {
+		out->number(qint64(3));
+		out->number(3 * i);
+		out->number(3 * i + 1);
+		out->number(3 * i + 2);
+		out->endLine();
+	}
+}
+
+void MeshGenerator::writePolygons(Writer *out) const
+{
+	// The corner counts have their own sequence, so they can be
+	// counted for the header before the vertices are written
+	const float pi = 3.14159265f;
+	Random cornerCounts(seed);
+	qint64 verticesCount = 0;
+	for (qint64 i = 0; i < faces; i++) {
+		verticesCount += cornerCounts.integer(3, 10);
+	}
+
+	out->text("OFF");
+	out->endLine();
+	out->number(verticesCount);
+	out->number(faces);
+	out->number(qint64(0));
+	out->endLine();
+
+	cornerCounts = Random(seed);
+	Random random(seed + 1);
+	for (qint64 i = 0; i < faces; i++) {
+		int corners = cornerCounts.integer(3, 10);
+		float x = 2.0f * random.uniform() - 1.0f;
+		float y = 2.0f * random.uniform() - 1.0f;
+		float z = 2.0f * random.uniform() - 1.0f;
+		float rotation = 2.0f * pi * random.uniform();
+		for (int k = 0; k < corners; k++) {
+			float angle = rotation + 2.0f * pi * k / corners;
+			out->number(x + 0.05f * std::cos(angle));
+			out->number(y + 0.05f * std::sin(angle));
+			out->number(z);
+			out->endLine();
+		}
+	}
+
+	cornerCounts = Random(seed);
+	qint64 first = 0;
+	for (qint64 i = 0; i < faces; i++) {
+		int corners = cornerCounts.integer(3, 10);
+		out->number(qint64(corners));
+		for (int k = 0; k < corners; k++) {
+			out->number(first + k);
+		}
+		out->endLine();
+		first += corners;
+	}
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <QtCore>
+
+/**
+ * @brief Writes synthetic OFF files for benchmarks
+ *
+ * The files only depend on the shape, the number of faces and the seed.
+ * The random numbers do not come from the C library and the numbers are
+ * written with a fixed precision, so the same arguments produce the same
+ * file on every platform and benchmark results of different commits
+ * can be compared. The number of faces is a target, some shapes round it
+ * to the next complete mesh.
+ *
+ * @see BenchmarkSuite
+ */
+class MeshGenerator
+{
+	Q_DECLARE_TR_FUNCTIONS(MeshGenerator)
+
+public:
+	/**
+	 * @brief The available kinds of meshes
+	 */
+	enum Shape
+	{
+		/**
+		 * @brief Tessellated sphere with quads and triangle fans at the poles
+		 */
+		Sphere,
+
+		/**
+		 * @brief Square grid of quads with a wavy height
+		 */
+		HeightField,
+
+		/**
+		 * @brief Unconnected random triangles
+		 */
+		Soup,
+
+		/**
+		 * @brief COFF height field with vertex and face colors, partly translucent
+		 */
+		Colored,
+
+		/**
+		 * @brief Unconnected convex polygons with 3 to 10 corners
+		 */
+		Polygons,
+
+		/**
+		 * @brief Height field with comments, empty lines and tabs everywhere
+		 */
+		Comments,
+
+		ShapesCount
+	};
+
+	/**
+	 * @brief Constructor
+	 *
+	 * @param [in] shape The kind of mesh
+	 * @param [in] faces Target number of faces
+	 * @param [in] seed Start value of the random numbers
+	 */
+	MeshGenerator(Shape shape, qint64 faces, quint32 seed = 1);
+
+	/**
+	 * @brief Writes the mesh into a file
+	 *
+	 * Throws a QString if the file can not be written.
+	 *
+	 * @param [in] fileName Path of the new OFF file
+	 */
+	void write(const QString & fileName) const;
+
+	/**
+	 * @brief Returns the names of the shapes for the command line
+	 *
+	 * The index of a name is the value of its Shape.
+	 */
+	static QStringList shapeNames();
+
+	/**
+	 * @brief Parses a face count like "2500", "10K" or "100M"
+	 *
+	 * @param [in] text The face count with an optional K or M suffix
+	 * @return The number of faces or 0 if the text is invalid
+	 */
+	static qint64 parseSize(const QString & text);
+
+	/**
+	 * @brief Formats a face count with a K or M suffix if possible
+	 */
+	static QString formatSize(qint64 faces);
+
+private:
+	/**
+	 * @brief Small and fast random number generator (xorshift)
+	 *
+	 * Unlike qrand() the sequence is the same on all platforms.
+	 */
+	class Random
+	{
+	public:
+		Random(quint32 seed);
+
+		/**
+		 * @brief Returns a random number between 0 and 1
+		 */
+		float uniform();
+
+		/**
+		 * @brief Returns a random integer between min and max (inclusive)
+		 */
+		int integer(int min, int max);
+
+	private:
+		quint32 state;
+	};
+
+	/**
+	 * @brief Buffered output of the OFF tokens
+	 */
+	class Writer;
+
+	void writeSphere(Writer *out) const;
+	void writeHeightField(Writer *out, bool colored, bool comments) const;
+	void writeSoup(Writer *out) const;
+	void writePolygons(Writer *out) const;
+
+	Shape shape;
+	qint64 faces;
+	quint32 seed;
+};
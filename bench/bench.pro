@@ -0,0 +1,99 @@
+# qmake file for the OffView benchmarks
+#
+# Build it separately from the application, for example in a directory
+# next to the sources: qmake ../offview/bench/bench.pro && make
+
+QT += opengl concurrent
+
+CONFIG += c++11
+CONFIG += warn_on
+CONFIG += qt
+CONFIG += console
+CONFIG -= app_bundle
+
+TARGET = offbench
+
+msvc:LIBS += opengl32.lib
+mingw:LIBS += -lopengl32
+win32:LIBS += -lpsapi
+
+# The revision is stored in the reports, so they can be compared later
+OFFBENCH_REVISION = $$system(git -C $$PWD rev-parse --short HEAD)
+isEmpty(OFFBENCH_REVISION): OFFBENCH_REVISION = unknown
+DEFINES += OFFBENCH_REVISION=\\\"$$OFFBENCH_REVISION\\\"
+
+INCLUDEPATH += ../src
+
+SOURCES += main.cpp \
+	MeshGenerator.cpp \
+	BenchmarkSuite.cpp \
+	../src/CVertex.cpp \
+	../src/CPolygon.cpp \
+	../src/OffScene.cpp \
+	../src/WireframeMode.cpp \
+	../src/DotMode.cpp \
+	../src/ShadedMode.cpp \
+	../src/FlatShadedMode.cpp \
+	../src/SmoothShadedMode.cpp \
+	../src/ColoredMode.cpp \
+	../src/ComponentMode.cpp \
+	../src/SceneFactory.cpp \
+	../src/SceneBvh.cpp \
+	../src/Parallel.cpp \
+	../src/RenderGeometry.cpp \
+	../src/GeometryBuffer.cpp \
+	../src/Frustum.cpp \
+	../src/TileFile.cpp \
+	../src/SoftwareRenderer.cpp \
+	../src/Camera.cpp \
+	../src/BatchRenderer.cpp \
+	../src/LoadTimings.cpp \
+	../src/Benchmark.cpp \
+	../src/Trace.cpp \
+	../src/MemoryReport.cpp \
+	../src/VertexWelder.cpp \
+	../src/StlReader.cpp \
+	../src/PlyReader.cpp \
+	../src/ObjReader.cpp \
+	../src/OffBinaryReader.cpp \
+	../src/QuantizedFile.cpp \
+	../src/HalfEdgeMesh.cpp \
+	../src/MeshComponents.cpp
+
+HEADERS += MeshGenerator.h \
+	BenchmarkSuite.h \
+	../src/CVertex.h \
+	../src/CPolygon.h \
+	../src/IScene.h \
+	../src/OffScene.h \
+	../src/IRenderMode.h \
+	../src/WireframeMode.h \
+	../src/DotMode.h \
+	../src/ShadedMode.h \
+	../src/FlatShadedMode.h \
+	../src/SmoothShadedMode.h \
+	../src/ColoredMode.h \
+	../src/ComponentMode.h \
+	../src/SceneFactory.h \
+	../src/SceneBvh.h \
+	../src/Parallel.h \
+	../src/RenderGeometry.h \
+	../src/GeometryBuffer.h \
+	../src/Frustum.h \
+	../src/TileFile.h \
+	../src/SoftwareRenderer.h \
+	../src/Camera.h \
+	../src/BatchRenderer.h \
+	../src/LoadTimings.h \
+	../src/Benchmark.h \
+	../src/Trace.h \
+	../src/MemoryReport.h \
+	../src/MeshData.h \
+	../src/VertexWelder.h \
+	../src/StlReader.h \
+	../src/PlyReader.h \
+	../src/ObjReader.h \
+	../src/OffBinaryReader.h \
+	../src/QuantizedFile.h \
+	../src/HalfEdgeMesh.h \
+	../src/MeshComponents.h
@@ -0,0 +1,155 @@
+/**
+* @file bench/main.cpp
+*
+* @brief Command line tool for the OffView benchmarks
+*
+* Three commands are available:
+*
+* offbench generate SHAPE SIZE FILE writes a single synthetic OFF file.
+*
+* offbench run measures all combinations of the selected shapes and sizes
+* and prints a JSON report.
+*
+* offbench compare BEFORE AFTER prints the change of the median times
+* between two reports.
+*/
+
+#include <QtCore>
+#include <QCommandLineParser>
+#include <QJsonDocument>
+
+#include "MeshGenerator.h"
+#include "BenchmarkSuite.h"
+#include "Version.h"
+
+/**
+ * @brief Reads a JSON report of the run command
+ */
+static QJsonObject readReport(const QString & fileName)
+{
+	QFile file(fileName);
+	if (!file.open(QIODevice::ReadOnly)) {
+		throw QCoreApplication::tr("Unable to open file ") + fileName;
+	}
+	QJsonDocument document = QJsonDocument::fromJson(file.readAll());
+	if (!document.isObject()) {
+		throw QCoreApplication::tr("Invalid report ") + fileName;
+	}
+	return document.object();
+}
+
+/**
+ * @brief Parses a shape name or throws a QString
+ */
+static MeshGenerator::Shape parseShape(const QString & name)
+{
+	int index = MeshGenerator::shapeNames().indexOf(name);
+	if (index < 0) {
+		throw QCoreApplication::tr("Unknown shape %1").arg(name);
+	}
+	return static_cast<MeshGenerator::Shape>(index);
+}
+
+/**
+ * @brief Parses a face count or throws a QString
+ */
+static qint64 parseSize(const QString & text)
+{
+	qint64 size = MeshGenerator::parseSize(text);
+	if (size <= 0) {
+		throw QCoreApplication::tr("Invalid size %1").arg(text);
+	}
+	return size;
+}
+
+int main(int argc, char** argv)
+{
+	QCoreApplication app(argc, argv);
+	QCoreApplication::setApplicationName("offbench");
+	QCoreApplication::setApplicationVersion(OFFVIEW_VERSION);
+
+	QCommandLineParser parser;
+	parser.setApplicationDescription(QCoreApplication::tr(
+		"Generates synthetic OFF files and measures how long OffView needs to load them.\n\n"
+		"Commands:\n"
+		"  generate SHAPE SIZE FILE  Writes a single file\n"
+		"  run                       Measures all shapes and sizes, prints JSON\n"
+		"  compare BEFORE AFTER      Compares two reports of the run command\n\n"
+		"Shapes: %1\n"
+		"Sizes are face counts like 2500, 10K or 100M.")
+		.arg(MeshGenerator::shapeNames().join(", ")));
+	parser.addHelpOption();
+	parser.addVersionOption();
+	parser.addPositionalArgument("command", QCoreApplication::tr("generate, run or compare"));
+
+	QCommandLineOption shapesOption("shapes", QCoreApplication::tr("Comma separated list of shapes."),
+		"shapes", MeshGenerator::shapeNames().join(","));
+	QCommandLineOption sizesOption("sizes", QCoreApplication::tr("Comma separated list of face counts."),
+		"sizes", "1K,10K,100K,1M");
+	QCommandLineOption iterationsOption("iterations",
+		QCoreApplication::tr("How often each file is loaded."), "count", "5");
+	QCommandLineOption dataOption("data",
+		QCoreApplication::tr("Directory for the generated files."), "directory", "bench-data");
+	QCommandLineOption seedOption("seed",
+		QCoreApplication::tr("Start value of the random numbers."), "number", "1");
+	parser.addOption(shapesOption);
+	parser.addOption(sizesOption);
+	parser.addOption(iterationsOption);
+	parser.addOption(dataOption);
+	parser.addOption(seedOption);
+	parser.process(app);
+
+	QTextStream errors(stderr);
+	QStringList arguments = parser.positionalArguments();
+	QString command = arguments.value(0);
+
+	try {
+		bool validSeed = false;
+		quint32 seed = parser.value(seedOption).toUInt(&validSeed);
+		if (!validSeed) {
+			throw QCoreApplication::tr("Invalid seed %1").arg(parser.value(seedOption));
+		}
+
+		if (command == "generate" && arguments.size() == 4) {
+			MeshGenerator generator(parseShape(arguments[1]), parseSize(arguments[2]), seed);
+			generator.write(arguments[3]);
+			return 0;
+		}
+
+		if (command == "run" && arguments.size() == 1) {
+			BenchmarkSuite::Options options;
+			QStringList shapes = parser.value(shapesOption).split(',', QString::SkipEmptyParts);
+			for (int i = 0; i < shapes.size(); i++) {
+				options.shapes.append(parseShape(shapes[i]));
+			}
+			QStringList sizes = parser.value(sizesOption).split(',', QString::SkipEmptyParts);
+			for (int i = 0; i < sizes.size(); i++) {
+				options.sizes.append(parseSize(sizes[i]));
+			}
+			bool validIterations = false;
+			options.iterations = parser.value(iterationsOption).toInt(&validIterations);
+			if (!validIterations || options.iterations < 1) {
+				throw QCoreApplication::tr("Invalid number of iterations %1")
+					.arg(parser.value(iterationsOption));
+			}
+			options.dataDirectory = parser.value(dataOption);
+			options.seed = seed;
+
+			BenchmarkSuite suite(options);
+			QTextStream(stdout) << QJsonDocument(suite.run()).toJson();
+			return 0;
+		}
+
+		if (command == "compare" && arguments.size() == 3) {
+			QTextStream(stdout) << BenchmarkSuite::compare(readReport(arguments[1]),
+				readReport(arguments[2]));
+			return 0;
+		}
+	}
+	catch (QString & message) {
+		errors << message << endl;
+		return 1;
+	}
+
+	parser.showHelp(1);
+}
@@ -1,6 +1,14 @@
 <?xml version="1.0" encoding="utf-8"?>
 <!DOCTYPE TS>
 <TS version="2.1" language="de_DE" sourcelanguage="en_GB">
+<context>
+    <name>BatchRenderer</name>
+    <message>
+        <location filename="../src/BatchRenderer.cpp" line="64"/>
+        <source>Unable to write image %1</source>
+        <translation>Das Bild %1 konnte nicht geschrieben werden</translation>
+    </message>
+</context>
 <context>
     <name>ColoredMode</name>
     <message>
@@ -9,6 +17,152 @@
         <translation>Farbig</translation>
     </message>
 </context>
+<context>
+    <name>CommandLine</name>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="26"/>
+        <source>The files which should be rendered.</source>
+        <translation>Die Dateien, die gezeichnet werden sollen.</translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="28"/>
+        <source>Render PNG images instead of opening the main window.</source>
+        <translation>PNG-Bilder erzeugen, statt das Hauptfenster zu öffnen.</translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="30"/>
+        <source>Render mode: auto, %1.</source>
+        <translation>Darstellungsmodus: auto, %1.</translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="31"/>
+        <source>Image size in pixels.</source>
+        <translation>Bildgröße in Pixeln.</translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="33"/>
+        <source>Camera rotation around the X and Y axis in degrees.</source>
+        <translation>Drehung der Kamera um die X- und die Y-Achse in Grad.</translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="34"/>
+        <source>Camera zoom, 1 shows the whole object.</source>
+        <translation>Zoom der Kamera, 1 zeigt das ganze Objekt.</translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="35"/>
+        <source>Background color.</source>
+        <translation>Hintergrundfarbe.</translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="36"/>
+        <source>Object color for uncolored files.</source>
+        <translation>Objektfarbe für Dateien ohne Farben.</translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="32"/>
+        <source>Renders preview images of OFF files without a display or measures how long loading a file takes or prints the statistics of the meshes or cuts them into slices.</source>
+        <translation>Erzeugt Vorschaubilder von OFF-Dateien ohne Bildschirm, misst wie lange das Laden einer Datei dauert, gibt die Statistik der Netze aus oder schneidet sie in Schichten.</translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="49"/>
+        <source>Directory for the images and slices, default is the directory of each file.</source>
+        <translation>Verzeichnis für die Bilder und Schichten, ohne Angabe das Verzeichnis der jeweiligen Datei.</translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="44"/>
+        <source>Load a file several times and print the time of each phase as JSON.</source>
+        <translation>Eine Datei mehrmals laden und die Zeit jeder Phase als JSON ausgeben.</translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="49"/>
+        <source>Print the size and the topology of the files instead of opening the main window.</source>
+        <translation>Größe und Topologie der Dateien ausgeben, statt das Hauptfenster zu öffnen.</translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="56"/>
+        <source>Cut the files into evenly spaced slices and save them as CLI files.</source>
+        <translation>Die Dateien in gleichmäßig verteilte Schichten schneiden und als CLI-Dateien speichern.</translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="57"/>
+        <source>Axis along which the slices are stacked: x, y or z.</source>
+        <translation>Achse, entlang der die Schichten gestapelt werden: x, y oder z.</translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="45"/>
+        <source>Number of benchmark runs.</source>
+        <translation>Anzahl der Messdurchläufe.</translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="61"/>
+        <source>Merge vertices closer than the tolerance and remove broken polygons while loading.</source>
+        <translation>Beim Laden Eckpunkte zusammenführen, die näher als die Toleranz liegen, und fehlerhafte Polygone entfernen.</translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="39"/>
+        <source>Number of files rendered at the same time.</source>
+        <translation>Anzahl der gleichzeitig gezeichneten Dateien.</translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="106"/>
+        <source>Invalid weld tolerance %1</source>
+        <translation>Ungültige Toleranz zum Zusammenführen: %1</translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="57"/>
+        <source>Unknown render mode %1</source>
+        <translation>Unbekannter Darstellungsmodus %1</translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="65"/>
+        <source>Invalid image size %1</source>
+        <translation>Ungültige Bildgröße %1</translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="76"/>
+        <source>Invalid rotation %1</source>
+        <translation>Ungültige Drehung %1</translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="83"/>
+        <source>Invalid zoom %1</source>
+        <translation>Ungültiger Zoom %1</translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="90"/>
+        <source>Invalid color</source>
+        <translation>Ungültige Farbe</translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="99"/>
+        <source>No files given</source>
+        <translation>Keine Dateien angegeben</translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="131"/>
+        <source>Invalid number of iterations %1</source>
+        <translation>Ungültige Anzahl Durchläufe %1</translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="205"/>
+        <source>Invalid number of slices %1</source>
+        <translation>Ungültige Anzahl Schichten %1</translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="211"/>
+        <source>Invalid axis %1</source>
+        <translation>Ungültige Achse %1</translation>
+    </message>
+</context>
+<context>
+    <name>ComponentMode</name>
+    <message>
+        <location filename="../src/ComponentMode.cpp" line="18"/>
+        <source>Component Mode</source>
+        <translation>Zusammenhangskomponenten</translation>
+    </message>
+</context>
 <context>
     <name>DotMode</name>
     <message>
@@ -25,6 +179,14 @@
         <translation>Hart schattiert</translation>
     </message>
 </context>
+<context>
+    <name>GlWidget</name>
+    <message>
+        <location filename="../src/GlWidget.cpp" line="123"/>
+        <source>%1 (Software)</source>
+        <translation>%1 (Software)</translation>
+    </message>
+</context>
 <context>
     <name>MainWindow</name>
     <message>
@@ -37,6 +199,16 @@
         <source>Select &quot;Open File&quot; from the &quot;File&quot; menu to load an object</source>
         <translation>Wählen Sie &quot;Datei öffnen&quot; aus dem &quot;Datei&quot; Menü um ein Objekt zu laden</translation>
     </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="134"/>
+        <source>File %1 was taken from the cache, it uses %2 of memory</source>
+        <translation>Datei %1 wurde aus dem Zwischenspeicher genommen, sie belegt %2 Speicher</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="125"/>
+        <source>File %1 was loaded, it uses %2 of memory</source>
+        <translation>Datei %1 wurde geladen, sie belegt %2 Speicher</translation>
+    </message>
     <message>
         <location filename="../src/MainWindow.cpp" line="107"/>
         <location filename="../src/MainWindow.cpp" line="295"/>
@@ -49,6 +221,31 @@
         <source>An error occured while processing file </source>
         <translation>Beim Lesen folgender Datei ist ein Fehler aufgetreten: </translation>
     </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="177"/>
+        <source>Standard Input</source>
+        <translation>Standardeingabe</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="178"/>
+        <source>Reading from the standard input...</source>
+        <translation>Lese von der Standardeingabe...</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="206"/>
+        <source>Reading from the standard input: %1 of %2 polygons</source>
+        <translation>Lese von der Standardeingabe: %1 von %2 Polygonen</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="213"/>
+        <source>Read %1 vertices and %2 polygons from the standard input</source>
+        <translation>%1 Eckpunkte und %2 Polygone wurden von der Standardeingabe gelesen</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="220"/>
+        <source>An error occured while reading the standard input</source>
+        <translation>Beim Lesen der Standardeingabe ist ein Fehler aufgetreten</translation>
+    </message>
     <message>
         <location filename="../src/MainWindow.cpp" line="230"/>
         <source>LanguageMenuItem</source>
@@ -79,6 +276,233 @@
         <source>Open File</source>
         <translation>Datei öffnen</translation>
     </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="411"/>
+        <source> (in memory)</source>
+        <translation> (im Speicher)</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="419"/>
+        <source>No recent files</source>
+        <translation>Keine zuletzt geöffneten Dateien</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="423"/>
+        <source>Set Cache &amp;Budget...</source>
+        <translation>&amp;Größe des Zwischenspeichers...</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="469"/>
+        <source>This is the last file in the folder</source>
+        <translation>Dies ist die letzte Datei im Ordner</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="470"/>
+        <source>This is the first file in the folder</source>
+        <translation>Dies ist die erste Datei im Ordner</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="625"/>
+        <source>Weld Tolerance</source>
+        <translation>Toleranz beim Zusammenführen</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="626"/>
+        <source>Merge vertices closer than (0 merges only identical vertices):</source>
+        <translation>Eckpunkte zusammenführen, die näher liegen als (0 führt nur gleiche Eckpunkte zusammen):</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="660"/>
+        <source>, %1 vertices merged, %2 degenerate and %3 duplicate polygons removed</source>
+        <translation>, %1 Eckpunkte zusammengeführt, %2 entartete und %3 doppelte Polygone entfernt</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="560"/>
+        <source>File %1 was updated</source>
+        <translation>Datei %1 wurde aktualisiert</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="573"/>
+        <source>File %1 was reloaded</source>
+        <translation>Datei %1 wurde neu geladen</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="578"/>
+        <source>File %1 could not be reloaded: %2</source>
+        <translation>Datei %1 konnte nicht neu geladen werden: %2</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="617"/>
+        <source>Playback stopped</source>
+        <translation>Wiedergabe angehalten</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="629"/>
+        <source>The opened file is not part of a numbered frame sequence</source>
+        <translation>Die geöffnete Datei gehört zu keiner nummerierten Bildfolge</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="837"/>
+        <source>Frame sequences can not be played while vertices are welded when loading</source>
+        <translation>Bildfolgen können nicht abgespielt werden, während Eckpunkte beim Laden zusammengeführt werden</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="644"/>
+        <source>Sequence Frame Rate</source>
+        <translation>Bildrate der Bildfolge</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="645"/>
+        <source>Frames per second:</source>
+        <translation>Bilder pro Sekunde:</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="659"/>
+        <source>Frame %1 of %2, %3 frames per second, %4 dropped</source>
+        <translation>Bild %1 von %2, %3 Bilder pro Sekunde, %4 ausgelassen</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="668"/>
+        <source>An error occured while playing file </source>
+        <translation>Beim Abspielen folgender Datei ist ein Fehler aufgetreten: </translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="439"/>
+        <location filename="../src/MainWindow.cpp" line="445"/>
+        <source>Cache Budget</source>
+        <translation>Größe des Zwischenspeichers</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="440"/>
+        <source>Main memory for recently opened files (MB):</source>
+        <translation>Arbeitsspeicher für zuletzt geöffnete Dateien (MB):</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="446"/>
+        <source>Graphics memory for recently opened files (MB):</source>
+        <translation>Grafikspeicher für zuletzt geöffnete Dateien (MB):</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="760"/>
+        <location filename="../src/MainWindow.cpp" line="765"/>
+        <location filename="../src/MainWindow.cpp" line="777"/>
+        <source>Save As</source>
+        <translation>Speichern unter</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="761"/>
+        <source>Only loaded OFF files can be saved.</source>
+        <translation>Nur geladene OFF-Dateien können gespeichert werden.</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="766"/>
+        <source>The scene can be saved when the pipe is closed.</source>
+        <translation>Die Szene kann gespeichert werden, sobald die Pipe geschlossen ist.</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="774"/>
+        <source>Binary Off Files (*.off)</source>
+        <translation>Binäre Off Dateien (*.off)</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="791"/>
+        <source>Bits per coordinate:</source>
+        <translation>Bits pro Koordinate:</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="785"/>
+        <source>Saving file...</source>
+        <translation>Speichere Datei...</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="786"/>
+        <source>Saving OFF file</source>
+        <translation>Speichere OFF-Datei</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="800"/>
+        <source>An error occured while saving file </source>
+        <translation>Beim Speichern folgender Datei ist ein Fehler aufgetreten: </translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="805"/>
+        <source>Saved %1 in %2 s</source>
+        <translation>%1 wurde in %2 s gespeichert</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="930"/>
+        <location filename="../src/MainWindow.cpp" line="935"/>
+        <location filename="../src/MainWindow.cpp" line="941"/>
+        <location filename="../src/MainWindow.cpp" line="952"/>
+        <location filename="../src/MainWindow.cpp" line="960"/>
+        <source>Export Slices</source>
+        <translation>Schichten exportieren</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="931"/>
+        <source>Only loaded scenes can be sliced.</source>
+        <translation>Nur geladene Szenen können in Schichten geschnitten werden.</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="936"/>
+        <source>The scene can be sliced when the pipe is closed.</source>
+        <translation>Die Szene kann in Schichten geschnitten werden, sobald die Pipe geschlossen ist.</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="941"/>
+        <source>Number of slices:</source>
+        <translation>Anzahl der Schichten:</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="952"/>
+        <source>Stacked along axis:</source>
+        <translation>Gestapelt entlang der Achse:</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="962"/>
+        <source>Common Layer Interface Files (*.cli)</source>
+        <translation>Common Layer Interface Dateien (*.cli)</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="987"/>
+        <source>Saved %1 slices to %2 in %3 s</source>
+        <translation>%1 Schichten wurden in %3 s nach %2 gespeichert</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="366"/>
+        <source>Convert File</source>
+        <translation>Datei umwandeln</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="368"/>
+        <source>Off Files (*.off)</source>
+        <translation>Off Dateien (*.off)</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="376"/>
+        <source>Save Tiled File</source>
+        <translation>Gekachelte Datei speichern</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="384"/>
+        <source>Converting file...</source>
+        <translation>Wandle Datei um...</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="384"/>
+        <source>Cancel</source>
+        <translation>Abbrechen</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="385"/>
+        <source>Converting OFF file</source>
+        <translation>Wandle OFF-Datei um</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="396"/>
+        <source>An error occured while converting file </source>
+        <translation>Beim Umwandeln folgender Datei ist ein Fehler aufgetreten: </translation>
+    </message>
     <message>
         <location filename="../src/MainWindow.cpp" line="425"/>
         <source>Choose background color</source>
@@ -89,6 +513,85 @@
         <source>Choose object color</source>
         <translation>Objektfarbe wählen</translation>
     </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="1097"/>
+        <source>Clipping at %1 = %2, the section has %3 polylines with %4 points (Shift+Wheel moves the plane)</source>
+        <translation>Schnitt bei %1 = %2, der Schnitt hat %3 Linienzüge mit %4 Punkten (Umschalt+Mausrad verschiebt die Ebene)</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="477"/>
+        <location filename="../src/MainWindow.cpp" line="502"/>
+        <source>Memory Usage</source>
+        <translation>Speicherverbrauch</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="478"/>
+        <source>Memory usage is only available for loaded OFF files.</source>
+        <translation>Der Speicherverbrauch ist nur für geladene OFF-Dateien verfügbar.</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="491"/>
+        <source>Total</source>
+        <translation>Gesamt</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="495"/>
+        <source>File size: %1</source>
+        <translation>Dateigröße: %1</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="497"/>
+        <source>Memory per polygon: %1 bytes</source>
+        <translation>Speicher pro Polygon: %1 Bytes</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="1019"/>
+        <location filename="../src/MainWindow.cpp" line="1035"/>
+        <location filename="../src/MainWindow.cpp" line="1040"/>
+        <source>Check Mesh</source>
+        <translation>Netz prüfen</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="1020"/>
+        <source>Only scenes in memory can be checked.</source>
+        <translation>Nur Szenen im Arbeitsspeicher können geprüft werden.</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="1179"/>
+        <source>The scene can be checked when the standard input is read completely.</source>
+        <translation>Die Szene kann geprüft werden, sobald die Standardeingabe vollständig gelesen ist.</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="1191"/>
+        <source>Checking %1 polygons...</source>
+        <translation>Prüfe %1 Polygone...</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="1032"/>
+        <source>Checked %1 polygons in %2 s</source>
+        <translation>%1 Polygone wurden in %2 s geprüft</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="1039"/>
+        <source>Highlight the defective polygons and vertices?</source>
+        <translation>Sollen die fehlerhaften Polygone und Eckpunkte hervorgehoben werden?</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="1057"/>
+        <location filename="../src/MainWindow.cpp" line="1071"/>
+        <source>Click on a polygon to select its component first.</source>
+        <translation>Klicken Sie zuerst auf ein Polygon, um seine Komponente auszuwählen.</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="1062"/>
+        <source>Component %1 hidden, %2 of %3 components are hidden</source>
+        <translation>Komponente %1 ausgeblendet, %2 von %3 Komponenten sind ausgeblendet</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="1076"/>
+        <source>Component %1 isolated, %2 of %3 components are hidden</source>
+        <translation>Komponente %1 isoliert, %2 von %3 Komponenten sind ausgeblendet</translation>
+    </message>
     <message>
         <location filename="../src/MainWindow.cpp" line="542"/>
         <source>help_en.html</source>
@@ -99,6 +602,27 @@
         <source> activated</source>
         <translation> aktiviert</translation>
     </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="448"/>
+        <location filename="../src/MainWindow.cpp" line="457"/>
+        <source>none</source>
+        <translation>keine</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="449"/>
+        <source>Polygon %1: vertices %2, normal (%3, %4, %5), color %6</source>
+        <translation>Polygon %1: Eckpunkte %2, Normale (%3, %4, %5), Farbe %6</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="458"/>
+        <source> | Vertex %1: (%2, %3, %4), color %5</source>
+        <translation> | Eckpunkt %1: (%2, %3, %4), Farbe %5</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="1182"/>
+        <source> | Component %1 of %2: %3 polygons</source>
+        <translation> | Komponente %1 von %2: %3 Polygone</translation>
+    </message>
     <message>
         <location filename="../src/MainWindow.cpp" line="576"/>
         <source>&lt;h3&gt;About OffView version %1&lt;/h3&gt;&lt;p&gt;This program is for viewing Object File Format (.off) files with OpenGL.&lt;/p&gt;&lt;p&gt;Object File Format files are used to represent the geometry of a model by specifying the polygons of the model&apos;s surface. The polygons can have any number of vertices.&lt;/p&gt;&lt;p&gt;OffView was written by four students of Software Engineering at the University of Applied Sciences in Constance:&lt;/p&gt;&lt;ul&gt;&lt;li&gt;Manuel Caputo,&lt;/li&gt;&lt;li&gt;Markus Haecker,&lt;/li&gt;&lt;li&gt;Daniel Fritz and&lt;/li&gt;&lt;li&gt;Benjamin Stauder.&lt;/li&gt;&lt;/ul&gt;&lt;p&gt;The project is hosted on GitHub and can be found under &lt;a href=&quot;https://github.com/cry-inc/offview&quot;&gt;https://github.com/cry-inc/offview&lt;/a&gt;. It&apos;s free software under the conditions of version 3 of the GNU General Public License (&lt;a href=&quot;http://www.gnu.org/licenses/gpl-3.0.html&quot;&gt;GPLv3&lt;/a&gt;). &lt;/p&gt;</source>
@@ -122,6 +646,11 @@
         <source>&amp;File</source>
         <translation>&amp;Datei</translation>
     </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="39"/>
+        <source>Recent &amp;Files</source>
+        <translation>&amp;Zuletzt geöffnete Dateien</translation>
+    </message>
     <message>
         <location filename="../src/MainWindow.ui" line="44"/>
         <source>&amp;View</source>
@@ -132,6 +661,16 @@
         <source>Show &amp;Planes</source>
         <translation>Zeige &amp;Ebene</translation>
     </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="73"/>
+        <source>C&amp;lipping Plane</source>
+        <translation>&amp;Schnittebene</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="72"/>
+        <source>&amp;Components</source>
+        <translation>&amp;Komponenten</translation>
+    </message>
     <message>
         <location filename="../src/MainWindow.ui" line="56"/>
         <source>&amp;Mode</source>
@@ -167,6 +706,76 @@
         <source>Ctrl+W</source>
         <translation></translation>
     </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="127"/>
+        <source>&amp;Next File in Folder</source>
+        <translation>&amp;Nächste Datei im Ordner</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="130"/>
+        <source>PgDown</source>
+        <translation></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="135"/>
+        <source>&amp;Previous File in Folder</source>
+        <translation>&amp;Vorherige Datei im Ordner</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="138"/>
+        <source>PgUp</source>
+        <translation></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="149"/>
+        <source>Play Frame &amp;Sequence</source>
+        <translation>&amp;Bildfolge abspielen</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="152"/>
+        <source>Ctrl+Space</source>
+        <translation></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="157"/>
+        <source>Sequence Frame &amp;Rate...</source>
+        <translation>Bild&amp;rate der Bildfolge...</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="147"/>
+        <source>&amp;Reload Changed Files</source>
+        <translation>Geänderte Dateien &amp;neu laden</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="176"/>
+        <source>&amp;Weld Vertices When Loading</source>
+        <translation>Eckpunkte beim Laden &amp;zusammenführen</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="181"/>
+        <source>Weld &amp;Tolerance...</source>
+        <translation>&amp;Toleranz beim Zusammenführen...</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="171"/>
+        <source>&amp;Save As...</source>
+        <translation>&amp;Speichern unter...</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="174"/>
+        <source>Ctrl+Shift+S</source>
+        <translation></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="219"/>
+        <source>Export S&amp;lices...</source>
+        <translation>Sch&amp;ichten exportieren...</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="115"/>
+        <source>Convert for &amp;Out-of-Core Viewing...</source>
+        <translation>Für die Anzeige &amp;außerhalb des Arbeitsspeichers umwandeln...</translation>
+    </message>
     <message>
         <location filename="../src/MainWindow.ui" line="117"/>
         <source>&amp;Exit</source>
@@ -208,9 +817,74 @@
         <translation></translation>
     </message>
     <message>
-        <location filename="../src/MainWindow.ui" line="155"/>
-        <source>&amp;Reset View</source>
-        <translation>&amp;Ansicht zurücksetzen</translation>
+        <location filename="../src/MainWindow.ui" line="167"/>
+        <source>&amp;Software Rendering</source>
+        <translation>&amp;Software-Darstellung</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="176"/>
+        <source>&amp;Performance Overlay</source>
+        <translation>&amp;Leistungsanzeige</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="285"/>
+        <source>F9</source>
+        <translation></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="185"/>
+        <source>&amp;Memory Usage...</source>
+        <translation>&amp;Speicherverbrauch...</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="266"/>
+        <source>&amp;Check Mesh for Defects...</source>
+        <translation>Netz auf &amp;Fehler prüfen...</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="284"/>
+        <source>&amp;Statistics Panel</source>
+        <translation>S&amp;tatistik</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="287"/>
+        <source>F8</source>
+        <translation></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="280"/>
+        <source>&amp;Hide Picked Component</source>
+        <translation>Gewählte Komponente &amp;ausblenden</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="283"/>
+        <source>Ctrl+H</source>
+        <translation></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="288"/>
+        <source>&amp;Isolate Picked Component</source>
+        <translation>Gewählte Komponente &amp;isolieren</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="291"/>
+        <source>Ctrl+I</source>
+        <translation></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="296"/>
+        <source>&amp;Show All Components</source>
+        <translation>Alle Komponenten &amp;zeigen</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="299"/>
+        <source>Ctrl+Shift+H</source>
+        <translation></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="155"/>
+        <source>&amp;Reset View</source>
+        <translation>&amp;Ansicht zurücksetzen</translation>
     </message>
     <message>
         <location filename="../src/MainWindow.ui" line="158"/>
@@ -267,9 +941,309 @@
         <source>F7</source>
         <translation></translation>
     </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="410"/>
+        <source>&amp;None</source>
+        <translation>&amp;Keine</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="439"/>
+        <source>Move &amp;Forward</source>
+        <translation>Nach &amp;vorne verschieben</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="442"/>
+        <source>Ctrl+Shift+Up</source>
+        <translation></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="447"/>
+        <source>Move &amp;Backward</source>
+        <translation>Nach &amp;hinten verschieben</translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="450"/>
+        <source>Ctrl+Shift+Down</source>
+        <translation></translation>
+    </message>
+</context>
+<context>
+    <name>MemoryReport</name>
+    <message>
+        <location filename="../src/MemoryReport.cpp" line="53"/>
+        <source>%1 GiB</source>
+        <translation>%1 GiB</translation>
+    </message>
+    <message>
+        <location filename="../src/MemoryReport.cpp" line="55"/>
+        <source>%1 MiB</source>
+        <translation>%1 MiB</translation>
+    </message>
+    <message>
+        <location filename="../src/MemoryReport.cpp" line="57"/>
+        <source>%1 KiB</source>
+        <translation>%1 KiB</translation>
+    </message>
+    <message>
+        <location filename="../src/MemoryReport.cpp" line="59"/>
+        <source>%1 bytes</source>
+        <translation>%1 Bytes</translation>
+    </message>
+    <message>
+        <location filename="../src/MemoryReport.cpp" line="65"/>
+        <source>Positions</source>
+        <translation>Positionen</translation>
+    </message>
+    <message>
+        <location filename="../src/MemoryReport.cpp" line="66"/>
+        <source>Normals</source>
+        <translation>Normalen</translation>
+    </message>
+    <message>
+        <location filename="../src/MemoryReport.cpp" line="67"/>
+        <source>Colors</source>
+        <translation>Farben</translation>
+    </message>
+    <message>
+        <location filename="../src/MemoryReport.cpp" line="68"/>
+        <source>Topology</source>
+        <translation>Topologie</translation>
+    </message>
+    <message>
+        <location filename="../src/MemoryReport.cpp" line="69"/>
+        <source>Adjacency</source>
+        <translation>Nachbarschaft</translation>
+    </message>
+    <message>
+        <location filename="../src/MemoryReport.cpp" line="70"/>
+        <source>Caches</source>
+        <translation>Zwischenspeicher</translation>
+    </message>
+    <message>
+        <location filename="../src/MemoryReport.cpp" line="71"/>
+        <source>GPU mirrors</source>
+        <translation>Kopien für die GPU</translation>
+    </message>
+</context>
+<context>
+    <name>MeshSlicer</name>
+    <message>
+        <location filename="../src/MeshSlicer.cpp" line="272"/>
+        <source>Unable to open file </source>
+        <translation>Folgende Datei konnte nicht geöffnet werden: </translation>
+    </message>
+    <message>
+        <location filename="../src/MeshSlicer.cpp" line="283"/>
+        <source>Unable to write file </source>
+        <translation>Folgende Datei konnte nicht geschrieben werden: </translation>
+    </message>
+</context>
+<context>
+    <name>MeshStatistics</name>
+    <message>
+        <location filename="../src/MeshStatistics.cpp" line="244"/>
+        <source>Polygons: %1, vertices: %2, edges: %3</source>
+        <translation>Polygone: %1, Eckpunkte: %2, Kanten: %3</translation>
+    </message>
+    <message>
+        <location filename="../src/MeshStatistics.cpp" line="246"/>
+        <source>Connected components: %1</source>
+        <translation>Zusammenhangskomponenten: %1</translation>
+    </message>
+    <message>
+        <location filename="../src/MeshStatistics.cpp" line="248"/>
+        <source>Bounding box: (%1, %2, %3) to (%4, %5, %6)</source>
+        <translation>Umgebender Quader: (%1, %2, %3) bis (%4, %5, %6)</translation>
+    </message>
+    <message>
+        <location filename="../src/MeshStatistics.cpp" line="252"/>
+        <source>Surface area: %1</source>
+        <translation>Oberfläche: %1</translation>
+    </message>
+    <message>
+        <location filename="../src/MeshStatistics.cpp" line="254"/>
+        <source>Enclosed volume: %1 (the surface is not closed)</source>
+        <translation>Eingeschlossenes Volumen: %1 (die Oberfläche ist nicht geschlossen)</translation>
+    </message>
+    <message>
+        <location filename="../src/MeshStatistics.cpp" line="256"/>
+        <source>Enclosed volume: %1</source>
+        <translation>Eingeschlossenes Volumen: %1</translation>
+    </message>
+    <message>
+        <location filename="../src/MeshStatistics.cpp" line="258"/>
+        <source>Edge length: min %1, max %2, mean %3, deviation %4</source>
+        <translation>Kantenlänge: min %1, max %2, Mittel %3, Abweichung %4</translation>
+    </message>
+    <message>
+        <location filename="../src/MeshStatistics.cpp" line="262"/>
+        <source>Boundary edges: %1 in %2 loops</source>
+        <translation>Randkanten: %1 in %2 Schleifen</translation>
+    </message>
+    <message>
+        <location filename="../src/MeshStatistics.cpp" line="265"/>
+        <source>Boundary edges: %1</source>
+        <translation>Randkanten: %1</translation>
+    </message>
+    <message>
+        <location filename="../src/MeshStatistics.cpp" line="267"/>
+        <source>Non-manifold edges: %1, non-manifold vertices: %2</source>
+        <translation>Nicht-mannigfaltige Kanten: %1, nicht-mannigfaltige Eckpunkte: %2</translation>
+    </message>
+    <message>
+        <location filename="../src/MeshStatistics.cpp" line="270"/>
+        <source>Euler characteristic: %1, genus: %2</source>
+        <translation>Euler-Charakteristik: %1, Geschlecht: %2</translation>
+    </message>
+    <message>
+        <location filename="../src/MeshStatistics.cpp" line="273"/>
+        <source>Euler characteristic: %1, genus: not defined for non-manifold meshes</source>
+        <translation>Euler-Charakteristik: %1, Geschlecht: für nicht-mannigfaltige Netze nicht definiert</translation>
+    </message>
+    <message>
+        <location filename="../src/MeshStatistics.cpp" line="280"/>
+        <source>%1 corners: %2</source>
+        <translation>%1 Ecken: %2</translation>
+    </message>
+    <message>
+        <location filename="../src/MeshStatistics.cpp" line="283"/>
+        <source>Polygons by corners: %1</source>
+        <translation>Polygone nach Ecken: %1</translation>
+    </message>
+</context>
+<context>
+    <name>MeshValidator</name>
+    <message>
+        <location filename="../src/MeshValidator.cpp" line="241"/>
+        <source>%1 polygons with vertex numbers out of range</source>
+        <translation>%1 Polygone mit ungültigen Eckpunktnummern</translation>
+    </message>
+    <message>
+        <location filename="../src/MeshValidator.cpp" line="245"/>
+        <source>%1 polygons which use a vertex twice</source>
+        <translation>%1 Polygone, die einen Eckpunkt doppelt verwenden</translation>
+    </message>
+    <message>
+        <location filename="../src/MeshValidator.cpp" line="248"/>
+        <source>%1 polygons without area</source>
+        <translation>%1 Polygone ohne Fläche</translation>
+    </message>
+    <message>
+        <location filename="../src/MeshValidator.cpp" line="251"/>
+        <source>%1 duplicate polygons</source>
+        <translation>%1 doppelte Polygone</translation>
+    </message>
+    <message>
+        <location filename="../src/MeshValidator.cpp" line="254"/>
+        <source>%1 edges shared by more than two polygons</source>
+        <translation>%1 Kanten mit mehr als zwei Polygonen</translation>
+    </message>
+    <message>
+        <location filename="../src/MeshValidator.cpp" line="257"/>
+        <source>%1 edges between polygons of opposite orientation</source>
+        <translation>%1 Kanten zwischen Polygonen entgegengesetzter Orientierung</translation>
+    </message>
+    <message>
+        <location filename="../src/MeshValidator.cpp" line="261"/>
+        <source>%1 vertices where separate surfaces touch</source>
+        <translation>%1 Eckpunkte, an denen sich getrennte Oberflächen berühren</translation>
+    </message>
+    <message>
+        <location filename="../src/MeshValidator.cpp" line="265"/>
+        <source>%1 vertices without polygons</source>
+        <translation>%1 Eckpunkte ohne Polygone</translation>
+    </message>
+    <message>
+        <location filename="../src/MeshValidator.cpp" line="268"/>
+        <source>No defects found</source>
+        <translation>Keine Fehler gefunden</translation>
+    </message>
+    <message>
+        <location filename="../src/MeshValidator.cpp" line="290"/>
+        <source>Defective polygons in the file: %1</source>
+        <translation>Fehlerhafte Polygone in der Datei: %1</translation>
+    </message>
+    <message>
+        <location filename="../src/MeshValidator.cpp" line="271"/>
+        <source>%1 boundary edges, the surface is open</source>
+        <translation>%1 Randkanten, die Oberfläche ist offen</translation>
+    </message>
+</context>
+<context>
+    <name>ObjReader</name>
+    <message>
+        <location filename="../src/ObjReader.cpp" line="14"/>
+        <source>Unable to open file </source>
+        <translation>Folgende Datei konnte nicht geöffnet werden: </translation>
+    </message>
+    <message>
+        <location filename="../src/ObjReader.cpp" line="19"/>
+        <source>Unable to map file </source>
+        <translation>Folgende Datei konnte nicht eingeblendet werden: </translation>
+    </message>
+    <message>
+        <location filename="../src/ObjReader.cpp" line="76"/>
+        <source>Invalid vertex or polygon number!</source>
+        <translation>Ungültige Angabe bei der Anzahl Eckpunkte oder Polygone!</translation>
+    </message>
+    <message>
+        <location filename="../src/ObjReader.cpp" line="105"/>
+        <source>Aborted file loading!</source>
+        <translation>Das Laden der Datei wurde abgebrochen!</translation>
+    </message>
+    <message>
+        <location filename="../src/ObjReader.cpp" line="108"/>
+        <source>The OBJ file contains a line that can not be read!</source>
+        <translation>Die OBJ-Datei enthält eine Zeile, die nicht gelesen werden kann!</translation>
+    </message>
+</context>
+<context>
+    <name>OffBinaryReader</name>
+    <message>
+        <location filename="../src/OffBinaryReader.cpp" line="23"/>
+        <source>Unable to open file </source>
+        <translation>Folgende Datei konnte nicht geöffnet werden: </translation>
+    </message>
+    <message>
+        <location filename="../src/OffBinaryReader.cpp" line="28"/>
+        <source>Unable to map file </source>
+        <translation>Folgende Datei konnte nicht eingeblendet werden: </translation>
+    </message>
+    <message>
+        <location filename="../src/OffBinaryReader.cpp" line="35"/>
+        <location filename="../src/OffBinaryReader.cpp" line="96"/>
+        <location filename="../src/OffBinaryReader.cpp" line="174"/>
+        <source>The binary OFF file is damaged!</source>
+        <translation>Die binäre OFF-Datei ist beschädigt!</translation>
+    </message>
+    <message>
+        <location filename="../src/OffBinaryReader.cpp" line="44"/>
+        <source>Invalid vertex or polygon number!</source>
+        <translation>Ungültige Angabe bei der Anzahl Eckpunkte oder Polygone!</translation>
+    </message>
+    <message>
+        <location filename="../src/OffBinaryReader.cpp" line="96"/>
+        <location filename="../src/OffBinaryReader.cpp" line="171"/>
+        <source>Aborted file loading!</source>
+        <translation>Das Laden der Datei wurde abgebrochen!</translation>
+    </message>
 </context>
 <context>
     <name>OffScene</name>
+    <message>
+        <location filename="../src/OffScene.cpp" line="83"/>
+        <location filename="../src/OffScene.cpp" line="102"/>
+        <location filename="../src/OffScene.cpp" line="110"/>
+        <location filename="../src/OffScene.cpp" line="118"/>
+        <location filename="../src/OffScene.cpp" line="131"/>
+        <source>The snapshot is damaged!</source>
+        <translation>Die Momentaufnahme ist beschädigt!</translation>
+    </message>
+    <message>
+        <location filename="../src/OffScene.cpp" line="207"/>
+        <source>A polygon references less than 3 vertices or a missing vertex!</source>
+        <translation>Es wurde ein Polygon gefunden, für das weniger als drei oder nicht vorhandene Eckpunkte angegeben sind!</translation>
+    </message>
     <message>
         <location filename="../src/OffScene.cpp" line="86"/>
         <source>Unexpected end of file!</source>
@@ -300,11 +1274,21 @@
         <source>A polygon references less than 3 vertices!</source>
         <translation>Es wurde ein Polygon gefunden, für das weniger als drei Eckpunkte angegeben sind!</translation>
     </message>
+    <message>
+        <location filename="../src/OffScene.cpp" line="445"/>
+        <source>A polygon line has less indices than its vertex number!</source>
+        <translation>Es wurde eine Polygonzeile mit weniger Indizes als angegebenen Eckpunkten gefunden!</translation>
+    </message>
     <message>
         <location filename="../src/OffScene.cpp" line="259"/>
         <source>Can&apos;t parse polygon data!</source>
         <translation>Beim Lesen der Polygondaten ist ein Fehler aufgetreten!</translation>
     </message>
+    <message>
+        <location filename="../src/OffScene.cpp" line="457"/>
+        <source>A polygon references a missing vertex!</source>
+        <translation>Es wurde ein Polygon gefunden, das einen nicht vorhandenen Eckpunkt verwendet!</translation>
+    </message>
     <message>
         <location filename="../src/OffScene.cpp" line="311"/>
         <source>Unable to open file </source>
@@ -351,6 +1335,160 @@
         <translation>Das Laden der Datei wurde abgebrochen!</translation>
     </message>
 </context>
+<context>
+    <name>OffWriter</name>
+    <message>
+        <location filename="../src/OffWriter.cpp" line="27"/>
+        <source>Unable to open file </source>
+        <translation>Folgende Datei konnte nicht geöffnet werden: </translation>
+    </message>
+    <message>
+        <location filename="../src/OffWriter.cpp" line="43"/>
+        <location filename="../src/OffWriter.cpp" line="67"/>
+        <location filename="../src/OffWriter.cpp" line="92"/>
+        <source>Unable to write file </source>
+        <translation>Folgende Datei konnte nicht geschrieben werden: </translation>
+    </message>
+    <message>
+        <location filename="../src/OffWriter.cpp" line="98"/>
+        <source>Aborted writing file!</source>
+        <translation>Das Schreiben der Datei wurde abgebrochen!</translation>
+    </message>
+</context>
+<context>
+    <name>PerformanceOverlay</name>
+    <message>
+        <location filename="../src/PerformanceOverlay.cpp" line="60"/>
+        <source>Mode: %1</source>
+        <translation>Modus: %1</translation>
+    </message>
+    <message>
+        <location filename="../src/PerformanceOverlay.cpp" line="61"/>
+        <source>CPU: %1 ms</source>
+        <translation>CPU: %1 ms</translation>
+    </message>
+    <message>
+        <location filename="../src/PerformanceOverlay.cpp" line="63"/>
+        <source>GPU: not available</source>
+        <translation>GPU: nicht verfügbar</translation>
+    </message>
+    <message>
+        <location filename="../src/PerformanceOverlay.cpp" line="65"/>
+        <source>GPU: %1 ms</source>
+        <translation>GPU: %1 ms</translation>
+    </message>
+    <message>
+        <location filename="../src/PerformanceOverlay.cpp" line="67"/>
+        <source>Triangles: %L1</source>
+        <translation>Dreiecke: %L1</translation>
+    </message>
+    <message>
+        <location filename="../src/PerformanceOverlay.cpp" line="68"/>
+        <source>Vertices: %L1</source>
+        <translation>Eckpunkte: %L1</translation>
+    </message>
+    <message>
+        <location filename="../src/PerformanceOverlay.cpp" line="73"/>
+        <source>Triangles/s: %L1 M</source>
+        <translation>Dreiecke/s: %L1 M</translation>
+    </message>
+    <message>
+        <location filename="../src/PerformanceOverlay.cpp" line="75"/>
+        <source>GPU buffers: %1</source>
+        <translation>GPU-Puffer: %1</translation>
+    </message>
+    <message>
+        <location filename="../src/PerformanceOverlay.cpp" line="76"/>
+        <source>Scene memory: %1</source>
+        <translation>Speicher der Szene: %1</translation>
+    </message>
+</context>
+<context>
+    <name>PlyReader</name>
+    <message>
+        <location filename="../src/PlyReader.cpp" line="13"/>
+        <source>Unable to open file </source>
+        <translation>Folgende Datei konnte nicht geöffnet werden: </translation>
+    </message>
+    <message>
+        <location filename="../src/PlyReader.cpp" line="18"/>
+        <source>Unable to map file </source>
+        <translation>Folgende Datei konnte nicht eingeblendet werden: </translation>
+    </message>
+    <message>
+        <location filename="../src/PlyReader.cpp" line="45"/>
+        <source>The PLY file has no vertices or faces!</source>
+        <translation>Die PLY-Datei hat keine Eckpunkte oder Flächen!</translation>
+    </message>
+    <message>
+        <location filename="../src/PlyReader.cpp" line="55"/>
+        <location filename="../src/PlyReader.cpp" line="353"/>
+        <source>Aborted file loading!</source>
+        <translation>Das Laden der Datei wurde abgebrochen!</translation>
+    </message>
+    <message>
+        <location filename="../src/PlyReader.cpp" line="67"/>
+        <source>The PLY header is incomplete!</source>
+        <translation>Der PLY-Kopf ist unvollständig!</translation>
+    </message>
+    <message>
+        <location filename="../src/PlyReader.cpp" line="75"/>
+        <source>Wrong file format!</source>
+        <translation>Falsches Dateiformat!</translation>
+    </message>
+    <message>
+        <location filename="../src/PlyReader.cpp" line="84"/>
+        <source>Only binary PLY files are supported!</source>
+        <translation>Nur binäre PLY-Dateien werden unterstützt!</translation>
+    </message>
+    <message>
+        <location filename="../src/PlyReader.cpp" line="93"/>
+        <location filename="../src/PlyReader.cpp" line="109"/>
+        <location filename="../src/PlyReader.cpp" line="114"/>
+        <source>The PLY header is damaged!</source>
+        <translation>Der PLY-Kopf ist beschädigt!</translation>
+    </message>
+    <message>
+        <location filename="../src/PlyReader.cpp" line="141"/>
+        <source>Unknown PLY property type </source>
+        <translation>Unbekannter Typ einer PLY-Eigenschaft: </translation>
+    </message>
+    <message>
+        <location filename="../src/PlyReader.cpp" line="207"/>
+        <location filename="../src/PlyReader.cpp" line="216"/>
+        <location filename="../src/PlyReader.cpp" line="276"/>
+        <location filename="../src/PlyReader.cpp" line="394"/>
+        <source>The PLY file is truncated!</source>
+        <translation>Die PLY-Datei ist unvollständig!</translation>
+    </message>
+    <message>
+        <location filename="../src/PlyReader.cpp" line="211"/>
+        <source>The PLY file is damaged!</source>
+        <translation>Die PLY-Datei ist beschädigt!</translation>
+    </message>
+    <message>
+        <location filename="../src/PlyReader.cpp" line="266"/>
+        <source>The PLY vertices have no x, y and z coordinates!</source>
+        <translation>Die PLY-Eckpunkte haben keine x-, y- und z-Koordinaten!</translation>
+    </message>
+    <message>
+        <location filename="../src/PlyReader.cpp" line="270"/>
+        <source>The PLY vertices must not contain lists!</source>
+        <translation>Die PLY-Eckpunkte dürfen keine Listen enthalten!</translation>
+    </message>
+    <message>
+        <location filename="../src/PlyReader.cpp" line="273"/>
+        <location filename="../src/PlyReader.cpp" line="324"/>
+        <location filename="../src/PlyReader.cpp" line="350"/>
+        <source>Invalid vertex or polygon number!</source>
+        <translation>Ungültige Angabe bei der Anzahl Eckpunkte oder Polygone!</translation>
+    </message>
+    <message>
+        <location filename="../src/PlyReader.cpp" line="321"/>
+        <source>The PLY faces have no vertex indices!</source>
+        <translation>Die PLY-Flächen haben keine Eckpunktindizes!</translation>
+    </message>
+</context>
 <context>
     <name>QApplication</name>
     <message>
@@ -364,6 +1502,70 @@
         <translation>Ihr System unterstützt kein OpenGL!</translation>
     </message>
 </context>
+<context>
+    <name>QuantizedFile</name>
+    <message>
+        <location filename="../src/QuantizedFile.cpp" line="16"/>
+        <source>Quantized Files (*.ofq)</source>
+        <translation>Quantisierte Dateien (*.ofq)</translation>
+    </message>
+    <message>
+        <location filename="../src/QuantizedFile.cpp" line="25"/>
+        <source>Invalid number of bits!</source>
+        <translation>Ungültige Anzahl Bits!</translation>
+    </message>
+    <message>
+        <location filename="../src/QuantizedFile.cpp" line="94"/>
+        <location filename="../src/QuantizedFile.cpp" line="249"/>
+        <source>Unable to open file </source>
+        <translation>Folgende Datei konnte nicht geöffnet werden: </translation>
+    </message>
+    <message>
+        <location filename="../src/QuantizedFile.cpp" line="106"/>
+        <location filename="../src/QuantizedFile.cpp" line="231"/>
+        <location filename="../src/QuantizedFile.cpp" line="409"/>
+        <source>Unable to write file </source>
+        <translation>Folgende Datei konnte nicht geschrieben werden: </translation>
+    </message>
+    <message>
+        <location filename="../src/QuantizedFile.cpp" line="127"/>
+        <location filename="../src/QuantizedFile.cpp" line="143"/>
+        <location filename="../src/QuantizedFile.cpp" line="182"/>
+        <source>Aborted writing file!</source>
+        <translation>Das Schreiben der Datei wurde abgebrochen!</translation>
+    </message>
+    <message>
+        <location filename="../src/QuantizedFile.cpp" line="219"/>
+        <source>Invalid vertex or polygon number!</source>
+        <translation>Ungültige Angabe bei der Anzahl Eckpunkte oder Polygone!</translation>
+    </message>
+    <message>
+        <location filename="../src/QuantizedFile.cpp" line="254"/>
+        <source>Wrong file format!</source>
+        <translation>Falsches Dateiformat!</translation>
+    </message>
+    <message>
+        <location filename="../src/QuantizedFile.cpp" line="257"/>
+        <source>Unsupported quantized file version!</source>
+        <translation>Nicht unterstützte Version der quantisierten Datei!</translation>
+    </message>
+    <message>
+        <location filename="../src/QuantizedFile.cpp" line="285"/>
+        <location filename="../src/QuantizedFile.cpp" line="388"/>
+        <source>The quantized file is damaged!</source>
+        <translation>Die quantisierte Datei ist beschädigt!</translation>
+    </message>
+    <message>
+        <location filename="../src/QuantizedFile.cpp" line="290"/>
+        <source>Unable to map file </source>
+        <translation>Folgende Datei konnte nicht eingeblendet werden: </translation>
+    </message>
+    <message>
+        <location filename="../src/QuantizedFile.cpp" line="385"/>
+        <source>Aborted file loading!</source>
+        <translation>Das Laden der Datei wurde abgebrochen!</translation>
+    </message>
+</context>
 <context>
     <name>SceneFactory</name>
     <message>
@@ -371,6 +1573,21 @@
         <source>Off Files (*.off)</source>
         <translation>Off Dateien (*.off)</translation>
     </message>
+    <message>
+        <location filename="../src/SceneFactory.cpp" line="14"/>
+        <source>STL Files (*.stl)</source>
+        <translation>STL Dateien (*.stl)</translation>
+    </message>
+    <message>
+        <location filename="../src/SceneFactory.cpp" line="15"/>
+        <source>PLY Files (*.ply)</source>
+        <translation>PLY Dateien (*.ply)</translation>
+    </message>
+    <message>
+        <location filename="../src/SceneFactory.cpp" line="16"/>
+        <source>OBJ Files (*.obj)</source>
+        <translation>OBJ Dateien (*.obj)</translation>
+    </message>
     <message>
         <location filename="../src/SceneFactory.cpp" line="45"/>
         <source>File does not exist!</source>
@@ -382,6 +1599,14 @@
         <translation>Nicht unterstütztes Dateiformat!</translation>
     </message>
 </context>
+<context>
+    <name>SequencePlayer</name>
+    <message>
+        <location filename="../src/SequencePlayer.cpp" line="178"/>
+        <source>The frame has other polygons than the played scene!</source>
+        <translation>Das Bild hat andere Polygone als die abgespielte Szene!</translation>
+    </message>
+</context>
 <context>
     <name>SmoothShadedMode</name>
     <message>
@@ -390,6 +1615,204 @@
         <translation>Weich schattiert</translation>
     </message>
 </context>
+<context>
+    <name>StatisticsPanel</name>
+    <message>
+        <location filename="../src/StatisticsPanel.cpp" line="41"/>
+        <source>Statistics</source>
+        <translation>Statistik</translation>
+    </message>
+    <message>
+        <location filename="../src/StatisticsPanel.cpp" line="43"/>
+        <source>No object is loaded</source>
+        <translation>Kein Objekt geladen</translation>
+    </message>
+    <message>
+        <location filename="../src/StatisticsPanel.cpp" line="47"/>
+        <source>Calculating the statistics of %1 polygons...</source>
+        <translation>Berechne die Statistik von %1 Polygonen...</translation>
+    </message>
+</context>
+<context>
+    <name>StlReader</name>
+    <message>
+        <location filename="../src/StlReader.cpp" line="13"/>
+        <source>Unable to open file </source>
+        <translation>Folgende Datei konnte nicht geöffnet werden: </translation>
+    </message>
+    <message>
+        <location filename="../src/StlReader.cpp" line="18"/>
+        <source>The STL file is too small!</source>
+        <translation>Die STL-Datei ist zu klein!</translation>
+    </message>
+    <message>
+        <location filename="../src/StlReader.cpp" line="22"/>
+        <source>Unable to map file </source>
+        <translation>Folgende Datei konnte nicht eingeblendet werden: </translation>
+    </message>
+    <message>
+        <location filename="../src/StlReader.cpp" line="29"/>
+        <source>Only binary STL files are supported!</source>
+        <translation>Nur binäre STL-Dateien werden unterstützt!</translation>
+    </message>
+    <message>
+        <location filename="../src/StlReader.cpp" line="33"/>
+        <source>Invalid vertex or polygon number!</source>
+        <translation>Ungültige Angabe bei der Anzahl Eckpunkte oder Polygone!</translation>
+    </message>
+    <message>
+        <location filename="../src/StlReader.cpp" line="68"/>
+        <source>Aborted file loading!</source>
+        <translation>Das Laden der Datei wurde abgebrochen!</translation>
+    </message>
+</context>
+<context>
+    <name>StreamLoader</name>
+    <message>
+        <location filename="../src/StreamLoader.cpp" line="119"/>
+        <source>Unable to read the standard input!</source>
+        <translation>Die Standardeingabe konnte nicht gelesen werden!</translation>
+    </message>
+    <message>
+        <location filename="../src/StreamLoader.cpp" line="124"/>
+        <source>Wrong file format!</source>
+        <translation>Falsches Dateiformat!</translation>
+    </message>
+    <message>
+        <location filename="../src/StreamLoader.cpp" line="129"/>
+        <source>Can&apos;t read vertex, polygon and edge numbers!</source>
+        <translation>Die Anzahl der Eckpunkte, Polygone und Kanten konnte nicht gelesen werden!</translation>
+    </message>
+    <message>
+        <location filename="../src/StreamLoader.cpp" line="134"/>
+        <source>Invalid vertex or polygon number!</source>
+        <translation>Ungültige Angabe bei der Anzahl Eckpunkte oder Polygone!</translation>
+    </message>
+</context>
+<context>
+    <name>TileConverter</name>
+    <message>
+        <location filename="../src/TileConverter.cpp" line="57"/>
+        <source>Aborted file conversion!</source>
+        <translation>Das Umwandeln der Datei wurde abgebrochen!</translation>
+    </message>
+    <message>
+        <location filename="../src/TileConverter.cpp" line="129"/>
+        <source>Unable to open file </source>
+        <translation>Folgende Datei konnte nicht geöffnet werden: </translation>
+    </message>
+    <message>
+        <location filename="../src/TileConverter.cpp" line="135"/>
+        <source>Wrong file format!</source>
+        <translation>Falsches Dateiformat!</translation>
+    </message>
+    <message>
+        <location filename="../src/TileConverter.cpp" line="142"/>
+        <source>Can&apos;t read vertex, polygon and edge numbers!</source>
+        <translation>Die Anzahl der Eckpunkte, Polygone und Kanten konnte nicht gelesen werden!</translation>
+    </message>
+    <message>
+        <location filename="../src/TileConverter.cpp" line="148"/>
+        <source>Invalid vertex or polygon number!</source>
+        <translation>Ungültige Angabe bei der Anzahl Eckpunkte oder Polygone!</translation>
+    </message>
+    <message>
+        <location filename="../src/TileConverter.cpp" line="161"/>
+        <location filename="../src/TileConverter.cpp" line="178"/>
+        <location filename="../src/TileConverter.cpp" line="224"/>
+        <source>Unable to create a temporary file!</source>
+        <translation>Eine temporäre Datei konnte nicht erzeugt werden!</translation>
+    </message>
+    <message>
+        <location filename="../src/TileConverter.cpp" line="168"/>
+        <location filename="../src/TileConverter.cpp" line="215"/>
+        <location filename="../src/TileConverter.cpp" line="627"/>
+        <source>Unable to write file </source>
+        <translation>Folgende Datei konnte nicht geschrieben werden: </translation>
+    </message>
+    <message>
+        <location filename="../src/TileConverter.cpp" line="185"/>
+        <location filename="../src/TileConverter.cpp" line="228"/>
+        <location filename="../src/TileConverter.cpp" line="364"/>
+        <source>Unable to map a temporary file!</source>
+        <translation>Eine temporäre Datei konnte nicht eingeblendet werden!</translation>
+    </message>
+    <message>
+        <location filename="../src/TileConverter.cpp" line="239"/>
+        <source>Can&apos;t find all three vertex components!</source>
+        <translation>Für einen Eckpunkt konnten nicht alle seiner drei Komponenten gefunden werden!</translation>
+    </message>
+    <message>
+        <location filename="../src/TileConverter.cpp" line="247"/>
+        <source>Can&apos;t parse vertex data!</source>
+        <translation>Beim Lesen der Eckpunkte ist ein Fehler aufgetreten!</translation>
+    </message>
+    <message>
+        <location filename="../src/TileConverter.cpp" line="274"/>
+        <source>A polygon line has less than 4 components!</source>
+        <translation>Es wurde ein Polygonzeile mit weniger als 4 Komponenten gefunden!</translation>
+    </message>
+    <message>
+        <location filename="../src/TileConverter.cpp" line="280"/>
+        <source>A polygon references less than 3 vertices!</source>
+        <translation>Es wurde ein Polygon gefunden, für das weniger als drei Eckpunkte angegeben sind!</translation>
+    </message>
+    <message>
+        <location filename="../src/TileConverter.cpp" line="283"/>
+        <location filename="../src/TileConverter.cpp" line="290"/>
+        <source>Can&apos;t parse polygon data!</source>
+        <translation>Beim Lesen der Polygondaten ist ein Fehler aufgetreten!</translation>
+    </message>
+    <message>
+        <location filename="../src/TileConverter.cpp" line="343"/>
+        <location filename="../src/TileConverter.cpp" line="359"/>
+        <source>Unable to write a temporary file!</source>
+        <translation>Eine temporäre Datei konnte nicht geschrieben werden!</translation>
+    </message>
+    <message>
+        <location filename="../src/TileConverter.cpp" line="657"/>
+        <source>Unable to read file </source>
+        <translation>Folgende Datei konnte nicht gelesen werden: </translation>
+    </message>
+</context>
+<context>
+    <name>TileFile</name>
+    <message>
+        <location filename="../src/TileFile.cpp" line="12"/>
+        <source>Tile Files (*.oft)</source>
+        <translation>Kachel Dateien (*.oft)</translation>
+    </message>
+    <message>
+        <location filename="../src/TileFile.cpp" line="21"/>
+        <source>Unable to open file </source>
+        <translation>Folgende Datei konnte nicht geöffnet werden: </translation>
+    </message>
+    <message>
+        <location filename="../src/TileFile.cpp" line="26"/>
+        <source>Wrong file format!</source>
+        <translation>Falsches Dateiformat!</translation>
+    </message>
+    <message>
+        <location filename="../src/TileFile.cpp" line="29"/>
+        <source>Unsupported tile file version!</source>
+        <translation>Nicht unterstützte Version der Kacheldatei!</translation>
+    </message>
+    <message>
+        <location filename="../src/TileFile.cpp" line="37"/>
+        <location filename="../src/TileFile.cpp" line="42"/>
+        <location filename="../src/TileFile.cpp" line="49"/>
+        <source>The tile table is damaged!</source>
+        <translation>Die Kacheltabelle ist beschädigt!</translation>
+    </message>
+</context>
+<context>
+    <name>Trace</name>
+    <message>
+        <location filename="../src/Trace.cpp" line="117"/>
+        <source>Unable to write trace file </source>
+        <translation>Folgende Ablaufdatei konnte nicht geschrieben werden: </translation>
+    </message>
+</context>
 <context>
     <name>WireframeMode</name>
     <message>
@@ -1,6 +1,14 @@
 <?xml version="1.0" encoding="utf-8"?>
 <!DOCTYPE TS>
 <TS version="2.1" language="en_US">
+<context>
+    <name>BatchRenderer</name>
+    <message>
+        <location filename="../src/BatchRenderer.cpp" line="64"/>
+        <source>Unable to write image %1</source>
+        <translation type="unfinished"></translation>
+    </message>
+</context>
 <context>
     <name>ColoredMode</name>
     <message>
@@ -9,6 +17,152 @@
         <translation type="unfinished"></translation>
     </message>
 </context>
+<context>
+    <name>CommandLine</name>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="26"/>
+        <source>The files which should be rendered.</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="28"/>
+        <source>Render PNG images instead of opening the main window.</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="30"/>
+        <source>Render mode: auto, %1.</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="31"/>
+        <source>Image size in pixels.</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="33"/>
+        <source>Camera rotation around the X and Y axis in degrees.</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="34"/>
+        <source>Camera zoom, 1 shows the whole object.</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="35"/>
+        <source>Background color.</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="36"/>
+        <source>Object color for uncolored files.</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="32"/>
+        <source>Renders preview images of OFF files without a display or measures how long loading a file takes or prints the statistics of the meshes or cuts them into slices.</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="49"/>
+        <source>Directory for the images and slices, default is the directory of each file.</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="44"/>
+        <source>Load a file several times and print the time of each phase as JSON.</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="49"/>
+        <source>Print the size and the topology of the files instead of opening the main window.</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="56"/>
+        <source>Cut the files into evenly spaced slices and save them as CLI files.</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="57"/>
+        <source>Axis along which the slices are stacked: x, y or z.</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="45"/>
+        <source>Number of benchmark runs.</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="61"/>
+        <source>Merge vertices closer than the tolerance and remove broken polygons while loading.</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="39"/>
+        <source>Number of files rendered at the same time.</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="106"/>
+        <source>Invalid weld tolerance %1</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="57"/>
+        <source>Unknown render mode %1</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="65"/>
+        <source>Invalid image size %1</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="76"/>
+        <source>Invalid rotation %1</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="83"/>
+        <source>Invalid zoom %1</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="90"/>
+        <source>Invalid color</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="99"/>
+        <source>No files given</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="131"/>
+        <source>Invalid number of iterations %1</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="205"/>
+        <source>Invalid number of slices %1</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/CommandLine.cpp" line="211"/>
+        <source>Invalid axis %1</source>
+        <translation type="unfinished"></translation>
+    </message>
+</context>
+<context>
+    <name>ComponentMode</name>
+    <message>
+        <location filename="../src/ComponentMode.cpp" line="18"/>
+        <source>Component Mode</source>
+        <translation type="unfinished"></translation>
+    </message>
+</context>
 <context>
     <name>DotMode</name>
     <message>
@@ -25,6 +179,14 @@
         <translation type="unfinished"></translation>
     </message>
 </context>
+<context>
+    <name>GlWidget</name>
+    <message>
+        <location filename="../src/GlWidget.cpp" line="123"/>
+        <source>%1 (Software)</source>
+        <translation type="unfinished"></translation>
+    </message>
+</context>
 <context>
     <name>MainWindow</name>
     <message>
@@ -37,6 +199,16 @@
         <source>Select &quot;Open File&quot; from the &quot;File&quot; menu to load an object</source>
         <translation type="unfinished"></translation>
     </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="134"/>
+        <source>File %1 was taken from the cache, it uses %2 of memory</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="125"/>
+        <source>File %1 was loaded, it uses %2 of memory</source>
+        <translation type="unfinished"></translation>
+    </message>
     <message>
         <location filename="../src/MainWindow.cpp" line="107"/>
         <location filename="../src/MainWindow.cpp" line="295"/>
@@ -49,6 +221,31 @@
         <source>An error occured while processing file </source>
         <translation type="unfinished"></translation>
     </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="177"/>
+        <source>Standard Input</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="178"/>
+        <source>Reading from the standard input...</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="206"/>
+        <source>Reading from the standard input: %1 of %2 polygons</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="213"/>
+        <source>Read %1 vertices and %2 polygons from the standard input</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="220"/>
+        <source>An error occured while reading the standard input</source>
+        <translation type="unfinished"></translation>
+    </message>
     <message>
         <location filename="../src/MainWindow.cpp" line="230"/>
         <source>LanguageMenuItem</source>
@@ -80,316 +277,1542 @@
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/MainWindow.cpp" line="425"/>
-        <source>Choose background color</source>
+        <location filename="../src/MainWindow.cpp" line="411"/>
+        <source> (in memory)</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/MainWindow.cpp" line="444"/>
-        <source>Choose object color</source>
+        <location filename="../src/MainWindow.cpp" line="419"/>
+        <source>No recent files</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/MainWindow.cpp" line="542"/>
-        <source>help_en.html</source>
+        <location filename="../src/MainWindow.cpp" line="423"/>
+        <source>Set Cache &amp;Budget...</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/MainWindow.cpp" line="563"/>
-        <source> activated</source>
+        <location filename="../src/MainWindow.cpp" line="469"/>
+        <source>This is the last file in the folder</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/MainWindow.cpp" line="576"/>
-        <source>&lt;h3&gt;About OffView version %1&lt;/h3&gt;&lt;p&gt;This program is for viewing Object File Format (.off) files with OpenGL.&lt;/p&gt;&lt;p&gt;Object File Format files are used to represent the geometry of a model by specifying the polygons of the model&apos;s surface. The polygons can have any number of vertices.&lt;/p&gt;&lt;p&gt;OffView was written by four students of Software Engineering at the University of Applied Sciences in Constance:&lt;/p&gt;&lt;ul&gt;&lt;li&gt;Manuel Caputo,&lt;/li&gt;&lt;li&gt;Markus Haecker,&lt;/li&gt;&lt;li&gt;Daniel Fritz and&lt;/li&gt;&lt;li&gt;Benjamin Stauder.&lt;/li&gt;&lt;/ul&gt;&lt;p&gt;The project is hosted on GitHub and can be found under &lt;a href=&quot;https://github.com/cry-inc/offview&quot;&gt;https://github.com/cry-inc/offview&lt;/a&gt;. It&apos;s free software under the conditions of version 3 of the GNU General Public License (&lt;a href=&quot;http://www.gnu.org/licenses/gpl-3.0.html&quot;&gt;GPLv3&lt;/a&gt;). &lt;/p&gt;</source>
+        <location filename="../src/MainWindow.cpp" line="470"/>
+        <source>This is the first file in the folder</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/MainWindow.cpp" line="595"/>
-        <source>About OffView</source>
+        <location filename="../src/MainWindow.cpp" line="625"/>
+        <source>Weld Tolerance</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/MainWindow.cpp" line="305"/>
-        <source>Couldn&apos;t load language file </source>
+        <location filename="../src/MainWindow.cpp" line="626"/>
+        <source>Merge vertices closer than (0 merges only identical vertices):</source>
         <translation type="unfinished"></translation>
     </message>
-</context>
-<context>
-    <name>MainWindowClass</name>
     <message>
-        <location filename="../src/MainWindow.ui" line="35"/>
-        <source>&amp;File</source>
+        <location filename="../src/MainWindow.cpp" line="660"/>
+        <source>, %1 vertices merged, %2 degenerate and %3 duplicate polygons removed</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/MainWindow.ui" line="44"/>
-        <source>&amp;View</source>
+        <location filename="../src/MainWindow.cpp" line="560"/>
+        <source>File %1 was updated</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/MainWindow.ui" line="48"/>
-        <source>Show &amp;Planes</source>
+        <location filename="../src/MainWindow.cpp" line="573"/>
+        <source>File %1 was reloaded</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/MainWindow.ui" line="56"/>
-        <source>&amp;Mode</source>
+        <location filename="../src/MainWindow.cpp" line="578"/>
+        <source>File %1 could not be reloaded: %2</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/MainWindow.ui" line="71"/>
-        <source>&amp;Language</source>
+        <location filename="../src/MainWindow.cpp" line="617"/>
+        <source>Playback stopped</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/MainWindow.ui" line="76"/>
-        <source>&amp;Help</source>
+        <location filename="../src/MainWindow.cpp" line="629"/>
+        <source>The opened file is not part of a numbered frame sequence</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/MainWindow.ui" line="91"/>
-        <source>&amp;Open File</source>
+        <location filename="../src/MainWindow.cpp" line="837"/>
+        <source>Frame sequences can not be played while vertices are welded when loading</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/MainWindow.ui" line="94"/>
-        <source>Ctrl+O</source>
+        <location filename="../src/MainWindow.cpp" line="644"/>
+        <source>Sequence Frame Rate</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/MainWindow.ui" line="102"/>
-        <source>&amp;Close File</source>
+        <location filename="../src/MainWindow.cpp" line="645"/>
+        <source>Frames per second:</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/MainWindow.ui" line="105"/>
-        <source>Ctrl+W</source>
+        <location filename="../src/MainWindow.cpp" line="659"/>
+        <source>Frame %1 of %2, %3 frames per second, %4 dropped</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/MainWindow.ui" line="117"/>
-        <source>&amp;Exit</source>
+        <location filename="../src/MainWindow.cpp" line="668"/>
+        <source>An error occured while playing file </source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/MainWindow.ui" line="120"/>
-        <source>Ctrl+Q</source>
+        <location filename="../src/MainWindow.cpp" line="439"/>
+        <location filename="../src/MainWindow.cpp" line="445"/>
+        <source>Cache Budget</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/MainWindow.ui" line="128"/>
-        <source>Choose &amp;Background Color</source>
+        <location filename="../src/MainWindow.cpp" line="440"/>
+        <source>Main memory for recently opened files (MB):</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/MainWindow.ui" line="131"/>
-        <source>F3</source>
+        <location filename="../src/MainWindow.cpp" line="446"/>
+        <source>Graphics memory for recently opened files (MB):</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/MainWindow.ui" line="136"/>
-        <source>Choose &amp;Object Color</source>
+        <location filename="../src/MainWindow.cpp" line="760"/>
+        <location filename="../src/MainWindow.cpp" line="765"/>
+        <location filename="../src/MainWindow.cpp" line="777"/>
+        <source>Save As</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/MainWindow.ui" line="139"/>
-        <source>F4</source>
+        <location filename="../src/MainWindow.cpp" line="761"/>
+        <source>Only loaded OFF files can be saved.</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/MainWindow.ui" line="147"/>
-        <source>Show &amp;Coordinate System</source>
+        <location filename="../src/MainWindow.cpp" line="766"/>
+        <source>The scene can be saved when the pipe is closed.</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/MainWindow.ui" line="150"/>
-        <source>F2</source>
+        <location filename="../src/MainWindow.cpp" line="774"/>
+        <source>Binary Off Files (*.off)</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/MainWindow.ui" line="155"/>
-        <source>&amp;Reset View</source>
+        <location filename="../src/MainWindow.cpp" line="791"/>
+        <source>Bits per coordinate:</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/MainWindow.ui" line="158"/>
-        <source>Esc</source>
+        <location filename="../src/MainWindow.cpp" line="785"/>
+        <source>Saving file...</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/MainWindow.ui" line="167"/>
-        <source>&amp;Help Contents</source>
+        <location filename="../src/MainWindow.cpp" line="786"/>
+        <source>Saving OFF file</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/MainWindow.ui" line="170"/>
-        <source>F1</source>
+        <location filename="../src/MainWindow.cpp" line="800"/>
+        <source>An error occured while saving file </source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/MainWindow.ui" line="178"/>
-        <source>About &amp;OffView</source>
+        <location filename="../src/MainWindow.cpp" line="805"/>
+        <source>Saved %1 in %2 s</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/MainWindow.ui" line="186"/>
-        <source>About &amp;Qt</source>
+        <location filename="../src/MainWindow.cpp" line="930"/>
+        <location filename="../src/MainWindow.cpp" line="935"/>
+        <location filename="../src/MainWindow.cpp" line="941"/>
+        <location filename="../src/MainWindow.cpp" line="952"/>
+        <location filename="../src/MainWindow.cpp" line="960"/>
+        <source>Export Slices</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/MainWindow.ui" line="197"/>
-        <source>&amp;xz Plane</source>
+        <location filename="../src/MainWindow.cpp" line="931"/>
+        <source>Only loaded scenes can be sliced.</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/MainWindow.ui" line="200"/>
-        <source>F5</source>
+        <location filename="../src/MainWindow.cpp" line="936"/>
+        <source>The scene can be sliced when the pipe is closed.</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/MainWindow.ui" line="208"/>
-        <source>x&amp;y Plane</source>
+        <location filename="../src/MainWindow.cpp" line="941"/>
+        <source>Number of slices:</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/MainWindow.ui" line="211"/>
-        <source>F6</source>
+        <location filename="../src/MainWindow.cpp" line="952"/>
+        <source>Stacked along axis:</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/MainWindow.ui" line="219"/>
-        <source>y&amp;z Plane</source>
+        <location filename="../src/MainWindow.cpp" line="962"/>
+        <source>Common Layer Interface Files (*.cli)</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/MainWindow.ui" line="222"/>
-        <source>F7</source>
+        <location filename="../src/MainWindow.cpp" line="987"/>
+        <source>Saved %1 slices to %2 in %3 s</source>
         <translation type="unfinished"></translation>
     </message>
-</context>
-<context>
-    <name>OffScene</name>
     <message>
-        <location filename="../src/OffScene.cpp" line="86"/>
-        <source>Unexpected end of file!</source>
+        <location filename="../src/MainWindow.cpp" line="366"/>
+        <source>Convert File</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/OffScene.cpp" line="176"/>
-        <source>Invalid color value!</source>
+        <location filename="../src/MainWindow.cpp" line="368"/>
+        <source>Off Files (*.off)</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/OffScene.cpp" line="207"/>
-        <source>Can&apos;t find all three vertex components!</source>
+        <location filename="../src/MainWindow.cpp" line="376"/>
+        <source>Save Tiled File</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/OffScene.cpp" line="216"/>
-        <source>Can&apos;t parse vertex data!</source>
+        <location filename="../src/MainWindow.cpp" line="384"/>
+        <source>Converting file...</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/OffScene.cpp" line="246"/>
-        <source>A polygon line has less than 4 components!</source>
+        <location filename="../src/MainWindow.cpp" line="384"/>
+        <source>Cancel</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/OffScene.cpp" line="252"/>
-        <source>A polygon references less than 3 vertices!</source>
+        <location filename="../src/MainWindow.cpp" line="385"/>
+        <source>Converting OFF file</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/OffScene.cpp" line="259"/>
-        <source>Can&apos;t parse polygon data!</source>
+        <location filename="../src/MainWindow.cpp" line="396"/>
+        <source>An error occured while converting file </source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/OffScene.cpp" line="311"/>
-        <source>Unable to open file </source>
+        <location filename="../src/MainWindow.cpp" line="425"/>
+        <source>Choose background color</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/OffScene.cpp" line="317"/>
-        <source>Wrong file format!</source>
+        <location filename="../src/MainWindow.cpp" line="444"/>
+        <source>Choose object color</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/OffScene.cpp" line="324"/>
-        <source>Can&apos;t read vertex, polygon and edge numbers!</source>
+        <location filename="../src/MainWindow.cpp" line="1097"/>
+        <source>Clipping at %1 = %2, the section has %3 polylines with %4 points (Shift+Wheel moves the plane)</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/OffScene.cpp" line="331"/>
-        <source>Invalid vertex or polygon number!</source>
+        <location filename="../src/MainWindow.cpp" line="477"/>
+        <location filename="../src/MainWindow.cpp" line="502"/>
+        <source>Memory Usage</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/OffScene.cpp" line="339"/>
-        <source>Loading vertices...</source>
+        <location filename="../src/MainWindow.cpp" line="478"/>
+        <source>Memory usage is only available for loaded OFF files.</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/OffScene.cpp" line="339"/>
-        <source>Cancel</source>
+        <location filename="../src/MainWindow.cpp" line="491"/>
+        <source>Total</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/OffScene.cpp" line="340"/>
-        <source>Loading OFF file</source>
+        <location filename="../src/MainWindow.cpp" line="495"/>
+        <source>File size: %1</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/OffScene.cpp" line="357"/>
-        <source>Loading polygons...</source>
+        <location filename="../src/MainWindow.cpp" line="497"/>
+        <source>Memory per polygon: %1 bytes</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/OffScene.cpp" line="405"/>
-        <source>Aborted file loading!</source>
+        <location filename="../src/MainWindow.cpp" line="1019"/>
+        <location filename="../src/MainWindow.cpp" line="1035"/>
+        <location filename="../src/MainWindow.cpp" line="1040"/>
+        <source>Check Mesh</source>
         <translation type="unfinished"></translation>
     </message>
-</context>
-<context>
-    <name>QApplication</name>
     <message>
-        <location filename="../src/main.cpp" line="39"/>
-        <source>Warning</source>
+        <location filename="../src/MainWindow.cpp" line="1020"/>
+        <source>Only scenes in memory can be checked.</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/main.cpp" line="40"/>
-        <source>This system has no OpenGL support!</source>
+        <location filename="../src/MainWindow.cpp" line="1179"/>
+        <source>The scene can be checked when the standard input is read completely.</source>
         <translation type="unfinished"></translation>
     </message>
-</context>
-<context>
-    <name>SceneFactory</name>
     <message>
-        <location filename="../src/SceneFactory.cpp" line="25"/>
-        <source>Off Files (*.off)</source>
+        <location filename="../src/MainWindow.cpp" line="1191"/>
+        <source>Checking %1 polygons...</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/SceneFactory.cpp" line="45"/>
-        <source>File does not exist!</source>
+        <location filename="../src/MainWindow.cpp" line="1032"/>
+        <source>Checked %1 polygons in %2 s</source>
         <translation type="unfinished"></translation>
     </message>
     <message>
-        <location filename="../src/SceneFactory.cpp" line="52"/>
-        <source>File format not supported!</source>
+        <location filename="../src/MainWindow.cpp" line="1039"/>
+        <source>Highlight the defective polygons and vertices?</source>
         <translation type="unfinished"></translation>
     </message>
-</context>
-<context>
-    <name>SmoothShadedMode</name>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="1057"/>
+        <location filename="../src/MainWindow.cpp" line="1071"/>
+        <source>Click on a polygon to select its component first.</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="1062"/>
+        <source>Component %1 hidden, %2 of %3 components are hidden</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="1076"/>
+        <source>Component %1 isolated, %2 of %3 components are hidden</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="542"/>
+        <source>help_en.html</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="563"/>
+        <source> activated</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="448"/>
+        <location filename="../src/MainWindow.cpp" line="457"/>
+        <source>none</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="449"/>
+        <source>Polygon %1: vertices %2, normal (%3, %4, %5), color %6</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="458"/>
+        <source> | Vertex %1: (%2, %3, %4), color %5</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="1182"/>
+        <source> | Component %1 of %2: %3 polygons</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="576"/>
+        <source>&lt;h3&gt;About OffView version %1&lt;/h3&gt;&lt;p&gt;This program is for viewing Object File Format (.off) files with OpenGL.&lt;/p&gt;&lt;p&gt;Object File Format files are used to represent the geometry of a model by specifying the polygons of the model&apos;s surface. The polygons can have any number of vertices.&lt;/p&gt;&lt;p&gt;OffView was written by four students of Software Engineering at the University of Applied Sciences in Constance:&lt;/p&gt;&lt;ul&gt;&lt;li&gt;Manuel Caputo,&lt;/li&gt;&lt;li&gt;Markus Haecker,&lt;/li&gt;&lt;li&gt;Daniel Fritz and&lt;/li&gt;&lt;li&gt;Benjamin Stauder.&lt;/li&gt;&lt;/ul&gt;&lt;p&gt;The project is hosted on GitHub and can be found under &lt;a href=&quot;https://github.com/cry-inc/offview&quot;&gt;https://github.com/cry-inc/offview&lt;/a&gt;. It&apos;s free software under the conditions of version 3 of the GNU General Public License (&lt;a href=&quot;http://www.gnu.org/licenses/gpl-3.0.html&quot;&gt;GPLv3&lt;/a&gt;). &lt;/p&gt;</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="595"/>
+        <source>About OffView</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.cpp" line="305"/>
+        <source>Couldn&apos;t load language file </source>
+        <translation type="unfinished"></translation>
+    </message>
+</context>
+<context>
+    <name>MainWindowClass</name>
+    <message>
+        <location filename="../src/MainWindow.ui" line="35"/>
+        <source>&amp;File</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="39"/>
+        <source>Recent &amp;Files</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="44"/>
+        <source>&amp;View</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="48"/>
+        <source>Show &amp;Planes</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="73"/>
+        <source>C&amp;lipping Plane</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="72"/>
+        <source>&amp;Components</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="56"/>
+        <source>&amp;Mode</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="71"/>
+        <source>&amp;Language</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="76"/>
+        <source>&amp;Help</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="91"/>
+        <source>&amp;Open File</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="94"/>
+        <source>Ctrl+O</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="102"/>
+        <source>&amp;Close File</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="105"/>
+        <source>Ctrl+W</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="127"/>
+        <source>&amp;Next File in Folder</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="130"/>
+        <source>PgDown</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="135"/>
+        <source>&amp;Previous File in Folder</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="138"/>
+        <source>PgUp</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="149"/>
+        <source>Play Frame &amp;Sequence</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="152"/>
+        <source>Ctrl+Space</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="157"/>
+        <source>Sequence Frame &amp;Rate...</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="147"/>
+        <source>&amp;Reload Changed Files</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="176"/>
+        <source>&amp;Weld Vertices When Loading</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="181"/>
+        <source>Weld &amp;Tolerance...</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="171"/>
+        <source>&amp;Save As...</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="174"/>
+        <source>Ctrl+Shift+S</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="219"/>
+        <source>Export S&amp;lices...</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="115"/>
+        <source>Convert for &amp;Out-of-Core Viewing...</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="117"/>
+        <source>&amp;Exit</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="120"/>
+        <source>Ctrl+Q</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="128"/>
+        <source>Choose &amp;Background Color</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="131"/>
+        <source>F3</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="136"/>
+        <source>Choose &amp;Object Color</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="139"/>
+        <source>F4</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="147"/>
+        <source>Show &amp;Coordinate System</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="150"/>
+        <source>F2</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="167"/>
+        <source>&amp;Software Rendering</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="176"/>
+        <source>&amp;Performance Overlay</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="285"/>
+        <source>F9</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="185"/>
+        <source>&amp;Memory Usage...</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="266"/>
+        <source>&amp;Check Mesh for Defects...</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="284"/>
+        <source>&amp;Statistics Panel</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="287"/>
+        <source>F8</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="280"/>
+        <source>&amp;Hide Picked Component</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="283"/>
+        <source>Ctrl+H</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="288"/>
+        <source>&amp;Isolate Picked Component</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="291"/>
+        <source>Ctrl+I</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="296"/>
+        <source>&amp;Show All Components</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="299"/>
+        <source>Ctrl+Shift+H</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="155"/>
+        <source>&amp;Reset View</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="158"/>
+        <source>Esc</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="167"/>
+        <source>&amp;Help Contents</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="170"/>
+        <source>F1</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="178"/>
+        <source>About &amp;OffView</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="186"/>
+        <source>About &amp;Qt</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="197"/>
+        <source>&amp;xz Plane</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="200"/>
+        <source>F5</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="208"/>
+        <source>x&amp;y Plane</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="211"/>
+        <source>F6</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="219"/>
+        <source>y&amp;z Plane</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="222"/>
+        <source>F7</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="410"/>
+        <source>&amp;None</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="439"/>
+        <source>Move &amp;Forward</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="442"/>
+        <source>Ctrl+Shift+Up</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="447"/>
+        <source>Move &amp;Backward</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MainWindow.ui" line="450"/>
+        <source>Ctrl+Shift+Down</source>
+        <translation type="unfinished"></translation>
+    </message>
+</context>
+<context>
+    <name>MemoryReport</name>
+    <message>
+        <location filename="../src/MemoryReport.cpp" line="53"/>
+        <source>%1 GiB</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MemoryReport.cpp" line="55"/>
+        <source>%1 MiB</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MemoryReport.cpp" line="57"/>
+        <source>%1 KiB</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MemoryReport.cpp" line="59"/>
+        <source>%1 bytes</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MemoryReport.cpp" line="65"/>
+        <source>Positions</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MemoryReport.cpp" line="66"/>
+        <source>Normals</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MemoryReport.cpp" line="67"/>
+        <source>Colors</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MemoryReport.cpp" line="68"/>
+        <source>Topology</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MemoryReport.cpp" line="69"/>
+        <source>Adjacency</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MemoryReport.cpp" line="70"/>
+        <source>Caches</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MemoryReport.cpp" line="71"/>
+        <source>GPU mirrors</source>
+        <translation type="unfinished"></translation>
+    </message>
+</context>
+<context>
+    <name>MeshSlicer</name>
+    <message>
+        <location filename="../src/MeshSlicer.cpp" line="272"/>
+        <source>Unable to open file </source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MeshSlicer.cpp" line="283"/>
+        <source>Unable to write file </source>
+        <translation type="unfinished"></translation>
+    </message>
+</context>
+<context>
+    <name>MeshStatistics</name>
+    <message>
+        <location filename="../src/MeshStatistics.cpp" line="244"/>
+        <source>Polygons: %1, vertices: %2, edges: %3</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MeshStatistics.cpp" line="246"/>
+        <source>Connected components: %1</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MeshStatistics.cpp" line="248"/>
+        <source>Bounding box: (%1, %2, %3) to (%4, %5, %6)</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MeshStatistics.cpp" line="252"/>
+        <source>Surface area: %1</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MeshStatistics.cpp" line="254"/>
+        <source>Enclosed volume: %1 (the surface is not closed)</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MeshStatistics.cpp" line="256"/>
+        <source>Enclosed volume: %1</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MeshStatistics.cpp" line="258"/>
+        <source>Edge length: min %1, max %2, mean %3, deviation %4</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MeshStatistics.cpp" line="262"/>
+        <source>Boundary edges: %1 in %2 loops</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MeshStatistics.cpp" line="265"/>
+        <source>Boundary edges: %1</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MeshStatistics.cpp" line="267"/>
+        <source>Non-manifold edges: %1, non-manifold vertices: %2</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MeshStatistics.cpp" line="270"/>
+        <source>Euler characteristic: %1, genus: %2</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MeshStatistics.cpp" line="273"/>
+        <source>Euler characteristic: %1, genus: not defined for non-manifold meshes</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MeshStatistics.cpp" line="280"/>
+        <source>%1 corners: %2</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MeshStatistics.cpp" line="283"/>
+        <source>Polygons by corners: %1</source>
+        <translation type="unfinished"></translation>
+    </message>
+</context>
+<context>
+    <name>MeshValidator</name>
+    <message>
+        <location filename="../src/MeshValidator.cpp" line="241"/>
+        <source>%1 polygons with vertex numbers out of range</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MeshValidator.cpp" line="245"/>
+        <source>%1 polygons which use a vertex twice</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MeshValidator.cpp" line="248"/>
+        <source>%1 polygons without area</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MeshValidator.cpp" line="251"/>
+        <source>%1 duplicate polygons</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MeshValidator.cpp" line="254"/>
+        <source>%1 edges shared by more than two polygons</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MeshValidator.cpp" line="257"/>
+        <source>%1 edges between polygons of opposite orientation</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MeshValidator.cpp" line="261"/>
+        <source>%1 vertices where separate surfaces touch</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MeshValidator.cpp" line="265"/>
+        <source>%1 vertices without polygons</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MeshValidator.cpp" line="268"/>
+        <source>No defects found</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MeshValidator.cpp" line="290"/>
+        <source>Defective polygons in the file: %1</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/MeshValidator.cpp" line="271"/>
+        <source>%1 boundary edges, the surface is open</source>
+        <translation type="unfinished"></translation>
+    </message>
+</context>
+<context>
+    <name>ObjReader</name>
+    <message>
+        <location filename="../src/ObjReader.cpp" line="14"/>
+        <source>Unable to open file </source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/ObjReader.cpp" line="19"/>
+        <source>Unable to map file </source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/ObjReader.cpp" line="76"/>
+        <source>Invalid vertex or polygon number!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/ObjReader.cpp" line="105"/>
+        <source>Aborted file loading!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/ObjReader.cpp" line="108"/>
+        <source>The OBJ file contains a line that can not be read!</source>
+        <translation type="unfinished"></translation>
+    </message>
+</context>
+<context>
+    <name>OffBinaryReader</name>
+    <message>
+        <location filename="../src/OffBinaryReader.cpp" line="23"/>
+        <source>Unable to open file </source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/OffBinaryReader.cpp" line="28"/>
+        <source>Unable to map file </source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/OffBinaryReader.cpp" line="35"/>
+        <location filename="../src/OffBinaryReader.cpp" line="96"/>
+        <location filename="../src/OffBinaryReader.cpp" line="174"/>
+        <source>The binary OFF file is damaged!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/OffBinaryReader.cpp" line="44"/>
+        <source>Invalid vertex or polygon number!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/OffBinaryReader.cpp" line="96"/>
+        <location filename="../src/OffBinaryReader.cpp" line="171"/>
+        <source>Aborted file loading!</source>
+        <translation type="unfinished"></translation>
+    </message>
+</context>
+<context>
+    <name>OffScene</name>
+    <message>
+        <location filename="../src/OffScene.cpp" line="83"/>
+        <location filename="../src/OffScene.cpp" line="102"/>
+        <location filename="../src/OffScene.cpp" line="110"/>
+        <location filename="../src/OffScene.cpp" line="118"/>
+        <location filename="../src/OffScene.cpp" line="131"/>
+        <source>The snapshot is damaged!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/OffScene.cpp" line="207"/>
+        <source>A polygon references less than 3 vertices or a missing vertex!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/OffScene.cpp" line="86"/>
+        <source>Unexpected end of file!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/OffScene.cpp" line="176"/>
+        <source>Invalid color value!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/OffScene.cpp" line="207"/>
+        <source>Can&apos;t find all three vertex components!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/OffScene.cpp" line="216"/>
+        <source>Can&apos;t parse vertex data!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/OffScene.cpp" line="246"/>
+        <source>A polygon line has less than 4 components!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/OffScene.cpp" line="252"/>
+        <source>A polygon references less than 3 vertices!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/OffScene.cpp" line="445"/>
+        <source>A polygon line has less indices than its vertex number!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/OffScene.cpp" line="259"/>
+        <source>Can&apos;t parse polygon data!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/OffScene.cpp" line="457"/>
+        <source>A polygon references a missing vertex!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/OffScene.cpp" line="311"/>
+        <source>Unable to open file </source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/OffScene.cpp" line="317"/>
+        <source>Wrong file format!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/OffScene.cpp" line="324"/>
+        <source>Can&apos;t read vertex, polygon and edge numbers!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/OffScene.cpp" line="331"/>
+        <source>Invalid vertex or polygon number!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/OffScene.cpp" line="339"/>
+        <source>Loading vertices...</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/OffScene.cpp" line="339"/>
+        <source>Cancel</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/OffScene.cpp" line="340"/>
+        <source>Loading OFF file</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/OffScene.cpp" line="357"/>
+        <source>Loading polygons...</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/OffScene.cpp" line="405"/>
+        <source>Aborted file loading!</source>
+        <translation type="unfinished"></translation>
+    </message>
+</context>
+<context>
+    <name>OffWriter</name>
+    <message>
+        <location filename="../src/OffWriter.cpp" line="27"/>
+        <source>Unable to open file </source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/OffWriter.cpp" line="43"/>
+        <location filename="../src/OffWriter.cpp" line="67"/>
+        <location filename="../src/OffWriter.cpp" line="92"/>
+        <source>Unable to write file </source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/OffWriter.cpp" line="98"/>
+        <source>Aborted writing file!</source>
+        <translation type="unfinished"></translation>
+    </message>
+</context>
+<context>
+    <name>PerformanceOverlay</name>
+    <message>
+        <location filename="../src/PerformanceOverlay.cpp" line="60"/>
+        <source>Mode: %1</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/PerformanceOverlay.cpp" line="61"/>
+        <source>CPU: %1 ms</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/PerformanceOverlay.cpp" line="63"/>
+        <source>GPU: not available</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/PerformanceOverlay.cpp" line="65"/>
+        <source>GPU: %1 ms</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/PerformanceOverlay.cpp" line="67"/>
+        <source>Triangles: %L1</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/PerformanceOverlay.cpp" line="68"/>
+        <source>Vertices: %L1</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/PerformanceOverlay.cpp" line="73"/>
+        <source>Triangles/s: %L1 M</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/PerformanceOverlay.cpp" line="75"/>
+        <source>GPU buffers: %1</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/PerformanceOverlay.cpp" line="76"/>
+        <source>Scene memory: %1</source>
+        <translation type="unfinished"></translation>
+    </message>
+</context>
+<context>
+    <name>PlyReader</name>
+    <message>
+        <location filename="../src/PlyReader.cpp" line="13"/>
+        <source>Unable to open file </source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/PlyReader.cpp" line="18"/>
+        <source>Unable to map file </source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/PlyReader.cpp" line="45"/>
+        <source>The PLY file has no vertices or faces!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/PlyReader.cpp" line="55"/>
+        <location filename="../src/PlyReader.cpp" line="353"/>
+        <source>Aborted file loading!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/PlyReader.cpp" line="67"/>
+        <source>The PLY header is incomplete!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/PlyReader.cpp" line="75"/>
+        <source>Wrong file format!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/PlyReader.cpp" line="84"/>
+        <source>Only binary PLY files are supported!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/PlyReader.cpp" line="93"/>
+        <location filename="../src/PlyReader.cpp" line="109"/>
+        <location filename="../src/PlyReader.cpp" line="114"/>
+        <source>The PLY header is damaged!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/PlyReader.cpp" line="141"/>
+        <source>Unknown PLY property type </source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/PlyReader.cpp" line="207"/>
+        <location filename="../src/PlyReader.cpp" line="216"/>
+        <location filename="../src/PlyReader.cpp" line="276"/>
+        <location filename="../src/PlyReader.cpp" line="394"/>
+        <source>The PLY file is truncated!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/PlyReader.cpp" line="211"/>
+        <source>The PLY file is damaged!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/PlyReader.cpp" line="266"/>
+        <source>The PLY vertices have no x, y and z coordinates!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/PlyReader.cpp" line="270"/>
+        <source>The PLY vertices must not contain lists!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/PlyReader.cpp" line="273"/>
+        <location filename="../src/PlyReader.cpp" line="324"/>
+        <location filename="../src/PlyReader.cpp" line="350"/>
+        <source>Invalid vertex or polygon number!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/PlyReader.cpp" line="321"/>
+        <source>The PLY faces have no vertex indices!</source>
+        <translation type="unfinished"></translation>
+    </message>
+</context>
+<context>
+    <name>QApplication</name>
+    <message>
+        <location filename="../src/main.cpp" line="39"/>
+        <source>Warning</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/main.cpp" line="40"/>
+        <source>This system has no OpenGL support!</source>
+        <translation type="unfinished"></translation>
+    </message>
+</context>
+<context>
+    <name>QuantizedFile</name>
+    <message>
+        <location filename="../src/QuantizedFile.cpp" line="16"/>
+        <source>Quantized Files (*.ofq)</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/QuantizedFile.cpp" line="25"/>
+        <source>Invalid number of bits!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/QuantizedFile.cpp" line="94"/>
+        <location filename="../src/QuantizedFile.cpp" line="249"/>
+        <source>Unable to open file </source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/QuantizedFile.cpp" line="106"/>
+        <location filename="../src/QuantizedFile.cpp" line="231"/>
+        <location filename="../src/QuantizedFile.cpp" line="409"/>
+        <source>Unable to write file </source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/QuantizedFile.cpp" line="127"/>
+        <location filename="../src/QuantizedFile.cpp" line="143"/>
+        <location filename="../src/QuantizedFile.cpp" line="182"/>
+        <source>Aborted writing file!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/QuantizedFile.cpp" line="219"/>
+        <source>Invalid vertex or polygon number!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/QuantizedFile.cpp" line="254"/>
+        <source>Wrong file format!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/QuantizedFile.cpp" line="257"/>
+        <source>Unsupported quantized file version!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/QuantizedFile.cpp" line="285"/>
+        <location filename="../src/QuantizedFile.cpp" line="388"/>
+        <source>The quantized file is damaged!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/QuantizedFile.cpp" line="290"/>
+        <source>Unable to map file </source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/QuantizedFile.cpp" line="385"/>
+        <source>Aborted file loading!</source>
+        <translation type="unfinished"></translation>
+    </message>
+</context>
+<context>
+    <name>SceneFactory</name>
+    <message>
+        <location filename="../src/SceneFactory.cpp" line="25"/>
+        <source>Off Files (*.off)</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/SceneFactory.cpp" line="14"/>
+        <source>STL Files (*.stl)</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/SceneFactory.cpp" line="15"/>
+        <source>PLY Files (*.ply)</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/SceneFactory.cpp" line="16"/>
+        <source>OBJ Files (*.obj)</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/SceneFactory.cpp" line="45"/>
+        <source>File does not exist!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/SceneFactory.cpp" line="52"/>
+        <source>File format not supported!</source>
+        <translation type="unfinished"></translation>
+    </message>
+</context>
+<context>
+    <name>SequencePlayer</name>
+    <message>
+        <location filename="../src/SequencePlayer.cpp" line="178"/>
+        <source>The frame has other polygons than the played scene!</source>
+        <translation type="unfinished"></translation>
+    </message>
+</context>
+<context>
+    <name>SmoothShadedMode</name>
     <message>
         <location filename="../src/SmoothShadedMode.cpp" line="23"/>
         <source>Smooth Shaded Mode</source>
         <translation type="unfinished"></translation>
     </message>
 </context>
+<context>
+    <name>StatisticsPanel</name>
+    <message>
+        <location filename="../src/StatisticsPanel.cpp" line="41"/>
+        <source>Statistics</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/StatisticsPanel.cpp" line="43"/>
+        <source>No object is loaded</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/StatisticsPanel.cpp" line="47"/>
+        <source>Calculating the statistics of %1 polygons...</source>
+        <translation type="unfinished"></translation>
+    </message>
+</context>
+<context>
+    <name>StlReader</name>
+    <message>
+        <location filename="../src/StlReader.cpp" line="13"/>
+        <source>Unable to open file </source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/StlReader.cpp" line="18"/>
+        <source>The STL file is too small!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/StlReader.cpp" line="22"/>
+        <source>Unable to map file </source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/StlReader.cpp" line="29"/>
+        <source>Only binary STL files are supported!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/StlReader.cpp" line="33"/>
+        <source>Invalid vertex or polygon number!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/StlReader.cpp" line="68"/>
+        <source>Aborted file loading!</source>
+        <translation type="unfinished"></translation>
+    </message>
+</context>
+<context>
+    <name>StreamLoader</name>
+    <message>
+        <location filename="../src/StreamLoader.cpp" line="119"/>
+        <source>Unable to read the standard input!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/StreamLoader.cpp" line="124"/>
+        <source>Wrong file format!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/StreamLoader.cpp" line="129"/>
+        <source>Can&apos;t read vertex, polygon and edge numbers!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/StreamLoader.cpp" line="134"/>
+        <source>Invalid vertex or polygon number!</source>
+        <translation type="unfinished"></translation>
+    </message>
+</context>
+<context>
+    <name>TileConverter</name>
+    <message>
+        <location filename="../src/TileConverter.cpp" line="57"/>
+        <source>Aborted file conversion!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/TileConverter.cpp" line="129"/>
+        <source>Unable to open file </source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/TileConverter.cpp" line="135"/>
+        <source>Wrong file format!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/TileConverter.cpp" line="142"/>
+        <source>Can&apos;t read vertex, polygon and edge numbers!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/TileConverter.cpp" line="148"/>
+        <source>Invalid vertex or polygon number!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/TileConverter.cpp" line="161"/>
+        <location filename="../src/TileConverter.cpp" line="178"/>
+        <location filename="../src/TileConverter.cpp" line="224"/>
+        <source>Unable to create a temporary file!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/TileConverter.cpp" line="168"/>
+        <location filename="../src/TileConverter.cpp" line="215"/>
+        <location filename="../src/TileConverter.cpp" line="627"/>
+        <source>Unable to write file </source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/TileConverter.cpp" line="185"/>
+        <location filename="../src/TileConverter.cpp" line="228"/>
+        <location filename="../src/TileConverter.cpp" line="364"/>
+        <source>Unable to map a temporary file!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/TileConverter.cpp" line="239"/>
+        <source>Can&apos;t find all three vertex components!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/TileConverter.cpp" line="247"/>
+        <source>Can&apos;t parse vertex data!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/TileConverter.cpp" line="274"/>
+        <source>A polygon line has less than 4 components!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/TileConverter.cpp" line="280"/>
+        <source>A polygon references less than 3 vertices!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/TileConverter.cpp" line="283"/>
+        <location filename="../src/TileConverter.cpp" line="290"/>
+        <source>Can&apos;t parse polygon data!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/TileConverter.cpp" line="343"/>
+        <location filename="../src/TileConverter.cpp" line="359"/>
+        <source>Unable to write a temporary file!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/TileConverter.cpp" line="657"/>
+        <source>Unable to read file </source>
+        <translation type="unfinished"></translation>
+    </message>
+</context>
+<context>
+    <name>TileFile</name>
+    <message>
+        <location filename="../src/TileFile.cpp" line="12"/>
+        <source>Tile Files (*.oft)</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/TileFile.cpp" line="21"/>
+        <source>Unable to open file </source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/TileFile.cpp" line="26"/>
+        <source>Wrong file format!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/TileFile.cpp" line="29"/>
+        <source>Unsupported tile file version!</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <location filename="../src/TileFile.cpp" line="37"/>
+        <location filename="../src/TileFile.cpp" line="42"/>
+        <location filename="../src/TileFile.cpp" line="49"/>
+        <source>The tile table is damaged!</source>
+        <translation type="unfinished"></translation>
+    </message>
+</context>
+<context>
+    <name>Trace</name>
+    <message>
+        <location filename="../src/Trace.cpp" line="117"/>
+        <source>Unable to write trace file </source>
+        <translation type="unfinished"></translation>
+    </message>
+</context>
 <context>
     <name>WireframeMode</name>
     <message>
@@ -5,7 +5,7 @@ contains(QT_VERSION, ^4\\.[0-9]\\..*) {
 	error("Use at least Qt 5.0")
 }
 
-QT += opengl
+QT += opengl concurrent
 
 CONFIG += c++11
 CONFIG += warn_on
@@ -13,6 +13,7 @@ CONFIG += qt
 
 msvc:LIBS += opengl32.lib
 mingw:LIBS += -lopengl32
+win32:LIBS += -lpsapi
 
 FORMS += src/MainWindow.ui
 
@@ -28,7 +29,41 @@ SOURCES += src/main.cpp \
 	src/FlatShadedMode.cpp \
 	src/SmoothShadedMode.cpp \
 	src/ColoredMode.cpp \
-	src/SceneFactory.cpp
+	src/ComponentMode.cpp \
+	src/SceneFactory.cpp \
+	src/SceneBvh.cpp \
+	src/Parallel.cpp \
+	src/RenderGeometry.cpp \
+	src/GeometryBuffer.cpp \
+	src/Frustum.cpp \
+	src/TileFile.cpp \
+	src/TileConverter.cpp \
+	src/TileStreamer.cpp \
+	src/SoftwareRenderer.cpp \
+	src/Camera.cpp \
+	src/BatchRenderer.cpp \
+	src/CommandLine.cpp \
+	src/LoadTimings.cpp \
+	src/Benchmark.cpp \
+	src/Trace.cpp \
+	src/PerformanceOverlay.cpp \
+	src/MemoryReport.cpp \
+	src/SceneCache.cpp \
+	src/SequencePlayer.cpp \
+	src/StreamLoader.cpp \
+	src/VertexWelder.cpp \
+	src/StlReader.cpp \
+	src/PlyReader.cpp \
+	src/ObjReader.cpp \
+	src/OffBinaryReader.cpp \
+	src/OffWriter.cpp \
+	src/QuantizedFile.cpp \
+	src/MeshValidator.cpp \
+	src/HalfEdgeMesh.cpp \
+	src/MeshComponents.cpp \
+	src/MeshStatistics.cpp \
+	src/StatisticsPanel.cpp \
+	src/MeshSlicer.cpp
     
 HEADERS += src/MainWindow.h \
 	src/GlWidget.h \
@@ -43,7 +78,42 @@ HEADERS += src/MainWindow.h \
 	src/FlatShadedMode.h \
 	src/SmoothShadedMode.h \
 	src/ColoredMode.h \
-	src/SceneFactory.h
+	src/ComponentMode.h \
+	src/SceneFactory.h \
+	src/SceneBvh.h \
+	src/Parallel.h \
+	src/RenderGeometry.h \
+	src/GeometryBuffer.h \
+	src/Frustum.h \
+	src/TileFile.h \
+	src/TileConverter.h \
+	src/TileStreamer.h \
+	src/SoftwareRenderer.h \
+	src/Camera.h \
+	src/BatchRenderer.h \
+	src/CommandLine.h \
+	src/LoadTimings.h \
+	src/Benchmark.h \
+	src/Trace.h \
+	src/PerformanceOverlay.h \
+	src/MemoryReport.h \
+	src/SceneCache.h \
+	src/SequencePlayer.h \
+	src/StreamLoader.h \
+	src/MeshData.h \
+	src/VertexWelder.h \
+	src/StlReader.h \
+	src/PlyReader.h \
+	src/ObjReader.h \
+	src/OffBinaryReader.h \
+	src/OffWriter.h \
+	src/QuantizedFile.h \
+	src/MeshValidator.h \
+	src/HalfEdgeMesh.h \
+	src/MeshComponents.h \
+	src/MeshStatistics.h \
+	src/StatisticsPanel.h \
+	src/MeshSlicer.h
     
 TRANSLATIONS += lang/offview_de.ts \
 	lang/offview_en.ts
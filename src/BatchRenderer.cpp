@@ -0,0 +1,129 @@
+#include <QtConcurrent>
+
+#include "BatchRenderer.h"
+#include "SceneFactory.h"
+#include "SceneBvh.h"
+#include "SoftwareRenderer.h"
+#include "Camera.h"
+#include "WireframeMode.h"
+#include "DotMode.h"
+#include "FlatShadedMode.h"
+#include "SmoothShadedMode.h"
+#include "ColoredMode.h"
+#include "ComponentMode.h"
+#include "Trace.h"
+
+BatchRenderer::BatchRenderer(const Options & options)
+{
+	this->options = options;
+	failures = 0;
+	renderModes = createRenderModes();
+}
+
+BatchRenderer::~BatchRenderer()
+{
+	for (int i = 0; i < renderModes.size(); i++) {
+		delete renderModes[i];
+	}
+}
+
+QStringList BatchRenderer::modeNames()
+{
+	return QStringList() << "wireframe" << "dots" << "flat" << "smooth" << "colored" << "components";
+}
+
+QVector<IRenderMode*> BatchRenderer::createRenderModes()
+{
+	QVector<IRenderMode*> modes;
+	modes.append(new WireframeMode());
+	modes.append(new DotMode());
+	modes.append(new FlatShadedMode());
+	modes.append(new SmoothShadedMode());
+	modes.append(new ColoredMode());
+	modes.append(new ComponentMode());
+	return modes;
+}
+
+int BatchRenderer::run(const QStringList & files)
+{
+	failures = 0;
+
+	// Each file is rendered by a worker of a pool limited to the jobs option
+	QThreadPool pool;
+	pool.setMaxThreadCount(qMax(1, options.jobs));
+	for (int i = 0; i < files.size(); i++) {
+		QString file = files[i];
+		QtConcurrent::run(&pool, [this, file]() {
+			renderFile(file);
+		});
+	}
+	pool.waitForDone();
+
+	return failures;
+}
+
+void BatchRenderer::renderFile(const QString & file)
+{
+	TRACE_ZONE("BatchRenderer::renderFile");
+
+	try {
+		QScopedPointer<IScene> scene(SceneFactory::openFile(file, options.loadOptions, false));
+		QImage image = render(scene.data());
+
+		QString path = outputPath(file);
+		if (!image.save(path, "PNG")) {
+			throw QString(tr("Unable to write image %1").arg(path));
+		}
+
+		QMutexLocker locker(&mutex);
+		QTextStream(stdout) << file << " -> " << path << endl;
+	}
+	catch (QString & message) {
+		QMutexLocker locker(&mutex);
+		failures++;
+		QTextStream(stderr) << file << ": " << message << endl;
+	}
+}
+
+QImage BatchRenderer::render(const IScene *scene) const
+{
+	SceneBvh bvh(scene);
+	const IRenderMode *mode = modeFor(scene);
+	QScopedPointer<RenderGeometry> geometry(mode->createGeometry(scene, &bvh, &options.color));
+
+	// Same framing and camera as in the viewer
+	Camera camera;
+	camera.frame(scene);
+	camera.rotate(options.rotationX, options.rotationY);
+	camera.setZoom(options.zoom);
+	QMatrix4x4 projection = camera.projectionMatrix(options.size.width(), options.size.height());
+
+	QVector<int> chunks;
+	QVector<int> parts;
+	bvh.cull(projection * camera.modelMatrix(), &chunks);
+	bvh.chunkParts(chunks, &parts);
+
+	SoftwareRenderer renderer;
+	renderer.resize(options.size.width(), options.size.height());
+	renderer.clear(options.background);
+	renderer.setMatrices(projection, camera.modelMatrix());
+	mode->render(&renderer, geometry.data(), parts, &options.color);
+	return renderer.image();
+}
+
+const IRenderMode* BatchRenderer::modeFor(const IScene *scene) const
+{
+	int index = modeNames().indexOf(options.mode);
+	if (index < 0) {
+		// Same choice as the main window makes after loading a file
+		index = scene->isColored() ? modeNames().indexOf("colored") : modeNames().indexOf("smooth");
+	}
+	return renderModes[index];
+}
+
+QString BatchRenderer::outputPath(const QString & file) const
+{
+	QFileInfo info(file);
+	QDir directory = options.outputDirectory.isEmpty() ? info.dir() : QDir(options.outputDirectory);
+	return directory.filePath(info.completeBaseName() + ".png");
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <QtCore>
+#include <QImage>
+
+#include "IScene.h"
+#include "IRenderMode.h"
+#include "SceneFactory.h"
+
+/**
+ * @brief Renders preview images of many files without a display
+ *
+ * Each file is loaded through the SceneFactory, framed like in the viewer,
+ * drawn by the SoftwareRenderer with one of the render modes and saved
+ * as PNG image. The files are processed in parallel by a pool of worker
+ * threads, each with its own renderer. No OpenGL context is needed,
+ * so this works on servers without graphics card or display.
+ *
+ * @see CommandLine
+ */
+class BatchRenderer
+{
+	Q_DECLARE_TR_FUNCTIONS(BatchRenderer)
+
+public:
+	/**
+	 * @brief Settings for all rendered images
+	 */
+	struct Options
+	{
+		/**
+		 * @brief Name of the render mode, see modeNames(), or "auto"
+		 */
+		QString mode;
+
+		/**
+		 * @brief Size of the images in pixels
+		 */
+		QSize size;
+
+		/**
+		 * @brief Rotation of the camera around the X and Y axis in degrees
+		 */
+		float rotationX;
+		float rotationY;
+
+		/**
+		 * @brief Zoom factor of the camera, 1 shows the whole scene
+		 */
+		float zoom;
+
+		QColor background;
+		QColor color;
+
+		/**
+		 * @brief Directory for the images, next to the input files if empty
+		 */
+		QString outputDirectory;
+
+		/**
+		 * @brief Number of files rendered at the same time
+		 */
+		int jobs;
+
+		/**
+		 * @brief Options for loading the files
+		 */
+		SceneFactory::LoadOptions loadOptions;
+	};
+
+	/**
+	 * @brief Constructor
+	 *
+	 * @param [in] options The settings for all images
+	 */
+	BatchRenderer(const Options & options);
+
+	/**
+	 * @brief Destructor
+	 */
+	~BatchRenderer();
+
+	/**
+	 * @brief Returns the names of the render modes for the command line
+	 */
+	static QStringList modeNames();
+
+	/**
+	 * @brief Creates one render mode for each entry of modeNames()
+	 *
+	 * @return The new render modes, the caller takes the ownership
+	 */
+	static QVector<IRenderMode*> createRenderModes();
+
+	/**
+	 * @brief Renders all files and writes the images
+	 *
+	 * Prints one line for each written image to the standard output
+	 * and the errors to the standard error output.
+	 *
+	 * @param [in] files Paths of the scene files
+	 * @return Number of files which failed
+	 */
+	int run(const QStringList & files);
+
+	/**
+	 * @brief Renders a single scene into an image
+	 *
+	 * Can be called from several threads at the same time.
+	 *
+	 * @param [in] scene The scene which should be drawn
+	 * @return The rendered image
+	 */
+	QImage render(const IScene *scene) const;
+
+private:
+	/**
+	 * @brief Loads, renders and saves one file
+	 */
+	void renderFile(const QString & file);
+
+	/**
+	 * @brief Returns the render mode for a scene
+	 */
+	const IRenderMode* modeFor(const IScene *scene) const;
+
+	/**
+	 * @brief Returns the path of the image for a scene file
+	 */
+	QString outputPath(const QString & file) const;
+
+	Options options;
+
+	/**
+	 * @brief The render modes in the order of modeNames()
+	 */
+	QVector<IRenderMode*> renderModes;
+
+	/**
+	 * @brief Protects the output and the error counter
+	 */
+	QMutex mutex;
+	int failures;
+};
@@ -0,0 +1,185 @@
+#include <algorithm>
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "Benchmark.h"
+#include "BatchRenderer.h"
+#include "Camera.h"
+#include "HalfEdgeMesh.h"
+#include "LoadTimings.h"
+#include "RenderGeometry.h"
+#include "SceneBvh.h"
+#include "SceneFactory.h"
+#include "Version.h"
+
+QByteArray Benchmark::run(const QString & file, const SceneFactory::LoadOptions & options,
+	int iterations)
+{
+	return QJsonDocument(measure(file, options, iterations)).toJson();
+}
+
+QJsonObject Benchmark::measure(const QString & file, const SceneFactory::LoadOptions & options,
+	int iterations)
+{
+	QVector<IRenderMode*> modes = BatchRenderer::createRenderModes();
+	QStringList modeNames = BatchRenderer::modeNames();
+	QColor color(160, 160, 160);
+
+	// Milliseconds of each phase and iteration, in the order of the report
+	QStringList phases;
+	for (int p = 0; p < LoadTimings::PhasesCount; p++) {
+		phases.append(LoadTimings::name(static_cast<LoadTimings::Phase>(p)));
+	}
+	phases << "bounds" << "hierarchy" << "triangulation";
+	for (int m = 0; m < modeNames.size(); m++) {
+		phases.append("geometry." + modeNames[m]);
+	}
+	phases << "total" << "halfedges";
+	QMap<QString, QVector<double> > times;
+
+	int verticesCount = 0;
+	int polygonsCount = 0;
+	MemoryReport memory;
+	for (int i = 0; i < iterations; i++) {
+		QElapsedTimer total;
+		total.start();
+
+		LoadTimings timings;
+		QScopedPointer<IScene> scene(SceneFactory::openFile(file, options, false, &timings));
+		verticesCount = scene->verticesCount();
+		polygonsCount = scene->polygonsCount();
+		for (int p = 0; p < LoadTimings::PhasesCount; p++) {
+			LoadTimings::Phase phase = static_cast<LoadTimings::Phase>(p);
+			times[LoadTimings::name(phase)].append(timings.nanoseconds(phase) / 1e6);
+		}
+
+		QElapsedTimer timer;
+		timer.start();
+		Camera camera;
+		camera.frame(scene.data());
+		times["bounds"].append(timer.nsecsElapsed() / 1e6);
+
+		timer.start();
+		SceneBvh bvh(scene.data());
+		times["hierarchy"].append(timer.nsecsElapsed() / 1e6);
+
+		memory = scene->memoryReport();
+		memory.add(MemoryReport::Caches, bvh.bytes());
+
+		timer.start();
+		delete triangulate(scene.data(), &bvh);
+		times["triangulation"].append(timer.nsecsElapsed() / 1e6);
+
+		// The geometry of the first frame, without the upload to OpenGL
+		for (int m = 0; m < modes.size(); m++) {
+			timer.start();
+			delete modes[m]->createGeometry(scene.data(), &bvh, &color);
+			times["geometry." + modeNames[m]].append(timer.nsecsElapsed() / 1e6);
+		}
+
+		times["total"].append(total.nsecsElapsed() / 1e6);
+
+		// Built on demand, so it is not part of the total
+		timer.start();
+		HalfEdgeMesh halfEdges(scene.data());
+		times["halfedges"].append(timer.nsecsElapsed() / 1e6);
+	}
+
+	for (int m = 0; m < modes.size(); m++) {
+		delete modes[m];
+	}
+
+	QJsonObject phaseReport;
+	QJsonArray order;
+	for (int p = 0; p < phases.size(); p++) {
+		QVector<double> values = times.value(phases[p]);
+		std::sort(values.begin(), values.end());
+		int n = values.size();
+		double median = (n % 2) ? values[n/2] : 0.5 * (values[n/2 - 1] + values[n/2]);
+
+		QJsonObject phase;
+		phase["min"] = values.first();
+		phase["median"] = median;
+		phase["max"] = values.last();
+		phaseReport[phases[p]] = phase;
+		order.append(phases[p]);
+	}
+
+	QJsonObject report;
+	report["version"] = QString(OFFVIEW_VERSION);
+	report["file"] = file;
+	report["iterations"] = iterations;
+	report["vertices"] = verticesCount;
+	report["polygons"] = polygonsCount;
+	report["unit"] = QString("ms");
+	report["phaseOrder"] = order;
+	report["phases"] = phaseReport;
+	report["peakMemoryBytes"] = static_cast<double>(peakMemory());
+
+	// Main memory of the loaded scene and its hierarchy, in bytes
+	QJsonObject sceneMemory;
+	for (int c = 0; c < MemoryReport::CategoriesCount; c++) {
+		MemoryReport::Category category = static_cast<MemoryReport::Category>(c);
+		sceneMemory[MemoryReport::name(category)] = static_cast<double>(memory.bytes(category));
+	}
+	sceneMemory["total"] = static_cast<double>(memory.total());
+	report["sceneMemory"] = sceneMemory;
+	return report;
+}
+
+RenderGeometry* Benchmark::triangulate(const IScene *scene, const SceneBvh *bvh)
+{
+	return RenderGeometry::fromPolygons(scene, bvh, RenderGeometry::Triangles, false, false,
+		[](const CPolygon *poly) {
+			int cv = static_cast<int>(poly->vertexCount());
+			return cv >= 3 ? 3 * (cv - 2) : 0;
+		},
+		[](const CPolygon *) {
+			return false;
+		},
+		[](const CPolygon *poly, RenderGeometry *geometry, int first) {
+			float *positions = geometry->positions() + 3 * first;
+			size_t cv = poly->vertexCount();
+			for(size_t t=1; t+1<cv; t++) {
+				const size_t corners[3] = { 0, t, t + 1 };
+				for(int k=0; k<3; k++) {
+					const float *data = poly->vertex(corners[k])->vertex();
+					positions[0] = data[0];
+					positions[1] = data[1];
+					positions[2] = data[2];
+					positions += 3;
+				}
+			}
+		});
+}
+
+qint64 Benchmark::peakMemory()
+{
+#ifdef Q_OS_WIN
+	PROCESS_MEMORY_COUNTERS counters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+		return counters.PeakWorkingSetSize;
+	}
+	return -1;
+#else
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0) {
+		return -1;
+	}
+#ifdef Q_OS_MAC
+	// Bytes on Mac OS X, kilobytes everywhere else
+	return usage.ru_maxrss;
+#else
+	return static_cast<qint64>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <QtCore>
+#include <QJsonObject>
+
+#include "IScene.h"
+#include "SceneFactory.h"
+
+class RenderGeometry;
+class SceneBvh;
+
+/**
+ * @brief Measures the loading pipeline of a file
+ *
+ * Loads a file several times and measures each phase: the phases of the
+ * reader (see LoadTimings), the bounding box for the camera framing, the
+ * polygon hierarchy, the triangulation and the geometry of every render mode. The result is
+ * a JSON report with the minimum, median and maximum time of each phase,
+ * the memory report of the scene and the peak memory usage of the process,
+ * so runs of different versions can be compared.
+ *
+ * @see CommandLine
+ */
+class Benchmark
+{
+	Q_DECLARE_TR_FUNCTIONS(Benchmark)
+
+public:
+	/**
+	 * @brief Runs the benchmark
+	 *
+	 * Throws a QString if the file can not be loaded.
+	 *
+	 * @param [in] file Path of the scene file
+	 * @param [in] options Options for loading the file
+	 * @param [in] iterations How often the file is loaded
+	 * @return The report as JSON document
+	 */
+	static QByteArray run(const QString & file, const SceneFactory::LoadOptions & options,
+		int iterations);
+
+	/**
+	 * @brief Runs the benchmark and returns the report as JSON object
+	 *
+	 * Throws a QString if the file can not be loaded.
+	 *
+	 * @param [in] file Path of the scene file
+	 * @param [in] options Options for loading the file
+	 * @param [in] iterations How often the file is loaded
+	 * @return The report
+	 */
+	static QJsonObject measure(const QString & file, const SceneFactory::LoadOptions & options,
+		int iterations);
+
+	/**
+	 * @brief Returns the peak resident memory of the process in bytes
+	 *
+	 * @return The peak memory or -1 if it is not available on this system
+	 */
+	static qint64 peakMemory();
+
+private:
+	/**
+	 * @brief Splits all polygons into triangle fans without normals or colors
+	 *
+	 * @return The triangle positions, the caller takes the ownership
+	 */
+	static RenderGeometry* triangulate(const IScene *scene, const SceneBvh *bvh);
+};
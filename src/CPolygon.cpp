@@ -8,11 +8,13 @@ CPolygon::CPolygon()
 	_normal[2] = 0.0f;
 
 	_colored = false;
+	_fileIndex = -1;
 }
 
-void CPolygon::addVertex(CVertex* vertex)
+void CPolygon::addVertex(CVertex* vertex, int index)
 {
 	_vertices.append(vertex);
+	_indices.append(index);
 }
 
 size_t CPolygon::vertexCount() const
@@ -25,12 +27,23 @@ const CVertex* CPolygon::vertex(int i) const
 	return _vertices[i];
 }
 
+int CPolygon::vertexIndex(int i) const
+{
+	return _indices[i];
+}
+
 void CPolygon::setColor(const QColor& color)
 {
 	_colored = true;
 	_color = color;
 }
 
+void CPolygon::removeColor()
+{
+	_colored = false;
+	_color = QColor();
+}
+
 bool CPolygon::isColored() const
 {
 	return _colored;
@@ -69,3 +82,13 @@ const float* CPolygon::normal() const
 {
 	return _normal;
 }
+
+void CPolygon::setFileIndex(int index)
+{
+	_fileIndex = index;
+}
+
+int CPolygon::fileIndex() const
+{
+	return _fileIndex;
+}
@@ -29,9 +29,10 @@ public:
 	/**
 	 * @brief Adds a new vertex to the polygon
 	 * @param [in] vertex A vertex which should be added to the polygon
+	 * @param [in] index The index of the vertex in the scene
 	 * @see CVertex
 	 */
-	void addVertex(CVertex* vertex);
+	void addVertex(CVertex* vertex, int index);
 
 	/**
 	 * @brief Returns the number of vertices
@@ -50,12 +51,28 @@ public:
 	 */
 	const CVertex* vertex(int i) const;
 
+	/**
+	 * @brief Getter for the vertex indices
+	 *
+	 * Returns the index of the i-th polygon vertex in the scene,
+	 * so that IScene::vertex(vertexIndex(i)) == vertex(i).
+	 *
+	 * @param [in] i Number of the vertex
+	 * @return Index of the vertex in the scene
+	 */
+	int vertexIndex(int i) const;
+
 	/**
 	 * @brief Sets the polygon color
 	 * @param [in] color The new polygon color
 	 */
 	void setColor(const QColor& color);
 
+	/**
+	 * @brief Removes the polygon color
+	 */
+	void removeColor();
+
 	/**
 	 * @brief Is the polygon colored?
 	 * @return True, if the polygon is colored
@@ -96,6 +113,22 @@ public:
 	 */
 	const float* normal() const;
 
+	/**
+	 * @brief Sets the position of the polygon in its file
+	 * @param [in] index Number of the polygon in the file, starting with 0
+	 */
+	void setFileIndex(int index);
+
+	/**
+	 * @brief Getter for the position of the polygon in its file
+	 *
+	 * The scene sorts its polygons by transparency, so the index of a
+	 * polygon in the scene is not the number of the polygon in the file.
+	 *
+	 * @return Number of the polygon in the file or -1 if it is unknown
+	 */
+	int fileIndex() const;
+
 private:
 	/**
 	 * @brief The optional polygon color
@@ -112,8 +145,18 @@ private:
 	 */
 	QVector<CVertex*> _vertices;
 
+	/**
+	 * @brief The scene indices of the polygon vertices
+	 */
+	QVector<int> _indices;
+
 	/**
 	 * @brief The normal vector for the polygon surface
 	 */
 	float _normal[3];
+
+	/**
+	 * @brief The number of the polygon in its file
+	 */
+	int _fileIndex;
 };
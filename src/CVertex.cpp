@@ -19,6 +19,19 @@ void CVertex::setColor(const QColor& color)
 	_color = color;
 }
 
+void CVertex::removeColor()
+{
+	_colored = false;
+	_color = QColor();
+}
+
+void CVertex::setPosition(const float* xyz)
+{
+	_xyz[0] = xyz[0];
+	_xyz[1] = xyz[1];
+	_xyz[2] = xyz[2];
+}
+
 const float* CVertex::vertex() const
 {
 	return _xyz;
@@ -57,6 +57,18 @@ public:
 	 */
 	void setColor(const QColor& color);
 
+	/**
+	 * Removes the vertex color.
+	 */
+	void removeColor();
+
+	/**
+	 * Moves the vertex.
+	 *
+	 * @param [in] xyz The new x, y and z data.
+	 */
+	void setPosition(const float* xyz);
+
 	/**
 	 * Is the vertex colored?
 	 *
@@ -0,0 +1,142 @@
+#include <cmath>
+
+#include "Camera.h"
+
+Camera::Camera()
+{
+	modelOffset[0] = modelOffset[1] = modelOffset[2] = 0.0f;
+	modelScale = 1.0f;
+	reset();
+}
+
+void Camera::reset()
+{
+	scale = 1.0f;
+
+	xRot = 0.0f;
+	yRot = 0.0f;
+
+	xTrans = 0.0f;
+	yTrans = 0.0f;
+}
+
+void Camera::frame(const float *min, const float *max)
+{
+	// Model dimensions
+	float widthX = max[0]-min[0];
+	float widthY = max[1]-min[1];
+	float widthZ = max[2]-min[2];
+
+	// This formula is from the offviwer at http://shape.cs.princeton.edu/benchmark/
+	modelScale = 2.0/sqrt(widthX*widthX + widthY*widthY + widthZ*widthZ);
+
+	// Center coordinates of our model
+	modelOffset[0] = -(max[0]-widthX/2.0);
+	modelOffset[1] = -(max[1]-widthY/2.0);
+	modelOffset[2] = -(max[2]-widthZ/2.0);
+}
+
+void Camera::frame(const IScene *scene)
+{
+	if (!scene || scene->verticesCount() == 0) {
+		return;
+	}
+
+	// search the x, y and z min + max values a.k.a bounding box
+	const float *data = scene->vertex(0)->vertex();
+	float maxX = data[0], minX = data[0];
+	float maxY = data[1], minY = data[1];
+	float maxZ = data[2], minZ = data[2];
+	int verticesCount = scene->verticesCount();
+	for(int i=1; i<verticesCount; i++) {
+		data = scene->vertex(i)->vertex();
+		if (data[0] > maxX) { maxX = data[0]; }
+		if (data[0] < minX) { minX = data[0]; }
+		if (data[1] > maxY) { maxY = data[1]; }
+		if (data[1] < minY) { minY = data[1]; }
+		if (data[2] > maxZ) { maxZ = data[2]; }
+		if (data[2] < minZ) { minZ = data[2]; }
+	}
+
+	const float min[3] = { minX, minY, minZ };
+	const float max[3] = { maxX, maxY, maxZ };
+	frame(min, max);
+}
+
+void Camera::rotate(float x, float y)
+{
+	xRot += x;
+	yRot += y;
+}
+
+void Camera::move(float x, float y)
+{
+	xTrans += x;
+	yTrans += y;
+}
+
+void Camera::zoomIn()
+{
+	if (scale < 20) {
+		scale += 0.1 * scale;
+	}
+}
+
+void Camera::zoomOut()
+{
+	if (scale > 0.1) {
+		scale -= 0.1 * scale;
+	}
+}
+
+void Camera::setZoom(float zoom)
+{
+	scale = zoom;
+}
+
+QMatrix4x4 Camera::projectionMatrix(int width, int height) const
+{
+	// Fixed width and variable height:
+	float w = 1.0f;
+	float h = static_cast<float>(height) / qMax(1, width);
+	w /= 3.0f;
+	h /= 3.0f;
+
+	// Set frustum with near and far clipping plane
+	QMatrix4x4 matrix;
+	matrix.frustum(-w, +w, -h, +h, 0.5f, 100.0f);
+
+	// Move the viewpoint by 3 units on the z axis so the camera
+	// will hopefully not be inside the scene object
+	matrix.translate(0.0f, 0.0f, -3.0f);
+	return matrix;
+}
+
+QMatrix4x4 Camera::viewMatrix() const
+{
+	QMatrix4x4 matrix;
+	matrix.scale(scale);
+	matrix.translate(xTrans, yTrans, 0.0f);
+	matrix.rotate(xRot, 1.0f, 0.0f, 0.0f);
+	matrix.rotate(yRot, 0.0f, 1.0f, 0.0f);
+	return matrix;
+}
+
+QMatrix4x4 Camera::modelMatrix() const
+{
+	// Scale to window size and move to center
+	QMatrix4x4 matrix = viewMatrix();
+	matrix.scale(modelScale);
+	matrix.translate(modelOffset[0], modelOffset[1], modelOffset[2]);
+	return matrix;
+}
+
+float Camera::frameToScene(int axis, float value) const
+{
+	return value / modelScale - modelOffset[axis];
+}
+
+float Camera::sceneToFrame(int axis, float value) const
+{
+	return (value + modelOffset[axis]) * modelScale;
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <QMatrix4x4>
+
+#include "IScene.h"
+
+/**
+ * @brief The camera of the viewer
+ *
+ * Holds the rotation, translation and zoom of the view and the automatic
+ * framing which centers a scene and scales it to fit. Creates the matrices
+ * for OpenGL and the SoftwareRenderer, so the widget and the command line
+ * renderer show the same image.
+ *
+ * @see GlWidget
+ */
+class Camera
+{
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * Creates a camera with the default view and without framing.
+	 */
+	Camera();
+
+	/**
+	 * @brief Resets rotation, translation and zoom to their default values
+	 *
+	 * The framing of the scene is kept.
+	 */
+	void reset();
+
+	/**
+	 * @brief Centers a bounding box and scales it to fit the view
+	 *
+	 * @param [in] min Minimum corner of the box
+	 * @param [in] max Maximum corner of the box
+	 */
+	void frame(const float *min, const float *max);
+
+	/**
+	 * @brief Centers all vertices of a scene and scales them to fit the view
+	 *
+	 * Does nothing if the scene has no vertices.
+	 *
+	 * @param [in] scene The scene which should be framed
+	 */
+	void frame(const IScene *scene);
+
+	/**
+	 * @brief Rotates the view
+	 *
+	 * @param [in] x Degrees around the horizontal axis of the screen
+	 * @param [in] y Degrees around the vertical axis of the screen
+	 */
+	void rotate(float x, float y);
+
+	/**
+	 * @brief Moves the view along the axes of the screen
+	 */
+	void move(float x, float y);
+
+	/**
+	 * @brief Enlarges the view by ten percent, up to a limit
+	 */
+	void zoomIn();
+
+	/**
+	 * @brief Shrinks the view by ten percent, down to a limit
+	 */
+	void zoomOut();
+
+	/**
+	 * @brief Sets the zoom factor, 1 shows the whole framed scene
+	 */
+	void setZoom(float zoom);
+
+	/**
+	 * @brief Returns the projection matrix for a viewport
+	 *
+	 * The width of the view is fixed, the height depends on the aspect ratio.
+	 *
+	 * @param [in] width Width of the viewport in pixels
+	 * @param [in] height Height of the viewport in pixels
+	 * @return The projection matrix
+	 */
+	QMatrix4x4 projectionMatrix(int width, int height) const;
+
+	/**
+	 * @brief Returns the camera transformation used for axes and planes
+	 */
+	QMatrix4x4 viewMatrix() const;
+
+	/**
+	 * @brief Returns the complete transformation used for the scene
+	 *
+	 * This is the view matrix combined with the framing of the scene.
+	 */
+	QMatrix4x4 modelMatrix() const;
+
+	/**
+	 * @brief Converts a coordinate of the framed view into scene coordinates
+	 *
+	 * The framed scene is centered and fits into the unit sphere, the axes
+	 * and planes are drawn in these coordinates.
+	 *
+	 * @param [in] axis 0 for X, 1 for Y and 2 for Z
+	 * @param [in] value The coordinate in the framed view
+	 * @return The coordinate in the scene
+	 */
+	float frameToScene(int axis, float value) const;
+
+	/**
+	 * @brief Converts a scene coordinate into the framed view
+	 *
+	 * @param [in] axis 0 for X, 1 for Y and 2 for Z
+	 * @param [in] value The coordinate in the scene
+	 * @return The coordinate in the framed view
+	 * @see frameToScene()
+	 */
+	float sceneToFrame(int axis, float value) const;
+
+private:
+	/**
+	 * @brief Value for the zoom.
+	 */
+	float scale;
+
+	/**
+	 * @brief Values for moving the model along the X and Y axis of the screen.
+	 */
+	float xTrans;
+	float yTrans;
+
+	/**
+	 * @brief Values for rotating the model around the axes of the screen.
+	 */
+	float xRot;
+	float yRot;
+
+	/**
+	 * @brief The offset values which are needed to center our model.
+	 * @see frame()
+	 */
+	float modelOffset[3];
+
+	/**
+	 * @brief The scale value which is needed to fit our model to the camera.
+	 * @see frame()
+	 */
+	float modelScale;
+};
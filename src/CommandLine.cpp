@@ -0,0 +1,276 @@
+#include <QCommandLineParser>
+
+#include "CommandLine.h"
+#include "BatchRenderer.h"
+#include "Benchmark.h"
+#include "SceneFactory.h"
+#include "HalfEdgeMesh.h"
+#include "MeshStatistics.h"
+#include "MeshSlicer.h"
+#include "SceneBvh.h"
+#include "Version.h"
+
+bool CommandLine::isBatchJob(int argc, char **argv)
+{
+	for (int i = 1; i < argc; i++) {
+		QString argument = argv[i];
+		if (argument == "--render" || argument == "--benchmark" ||
+				argument.startsWith("--benchmark=") || argument == "--statistics" ||
+				argument == "--slices" || argument.startsWith("--slices=")) {
+			return true;
+		}
+	}
+	return false;
+}
+
+int CommandLine::run(const QStringList & arguments)
+{
+	QCoreApplication::setApplicationName("OffView");
+	QCoreApplication::setApplicationVersion(OFFVIEW_VERSION);
+
+	QCommandLineParser parser;
+	parser.setApplicationDescription(tr("Renders preview images of OFF files without a display "
+		"or measures how long loading a file takes or prints the statistics of the meshes "
+		"or cuts them into slices."));
+	parser.addHelpOption();
+	parser.addVersionOption();
+	parser.addPositionalArgument("files", tr("The files which should be rendered."), "files...");
+
+	QCommandLineOption renderOption("render", tr("Render PNG images instead of opening the main window."));
+	QCommandLineOption modeOption("mode",
+		tr("Render mode: auto, %1.").arg(BatchRenderer::modeNames().join(", ")), "mode", "auto");
+	QCommandLineOption sizeOption("size", tr("Image size in pixels."), "WxH", "512x512");
+	QCommandLineOption rotateOption("rotate",
+		tr("Camera rotation around the X and Y axis in degrees."), "X,Y", "0,0");
+	QCommandLineOption zoomOption("zoom", tr("Camera zoom, 1 shows the whole object."), "factor", "1");
+	QCommandLineOption backgroundOption("background", tr("Background color."), "color", "black");
+	QCommandLineOption colorOption("color", tr("Object color for uncolored files."), "color", "#a0a0a0");
+	QCommandLineOption outputOption("output",
+		tr("Directory for the images and slices, default is the directory of each file."),
+		"directory");
+	QCommandLineOption benchmarkOption("benchmark",
+		tr("Load a file several times and print the time of each phase as JSON."), "file");
+	QCommandLineOption statisticsOption("statistics",
+		tr("Print the size and the topology of the files instead of opening the main window."));
+	QCommandLineOption slicesOption("slices",
+		tr("Cut the files into evenly spaced slices and save them as CLI files."), "count");
+	QCommandLineOption axisOption("axis", tr("Axis along which the slices are stacked: x, y or z."),
+		"axis", "z");
+	QCommandLineOption iterationsOption("iterations", tr("Number of benchmark runs."), "count", "5");
+	QCommandLineOption weldOption("weld",
+		tr("Merge vertices closer than the tolerance and remove broken polygons while loading."),
+		"tolerance");
+	QCommandLineOption jobsOption("jobs", tr("Number of files rendered at the same time."), "count",
+		QString::number(QThread::idealThreadCount()));
+	parser.addOption(renderOption);
+	parser.addOption(modeOption);
+	parser.addOption(sizeOption);
+	parser.addOption(rotateOption);
+	parser.addOption(zoomOption);
+	parser.addOption(backgroundOption);
+	parser.addOption(colorOption);
+	parser.addOption(outputOption);
+	parser.addOption(jobsOption);
+	parser.addOption(benchmarkOption);
+	parser.addOption(iterationsOption);
+	parser.addOption(statisticsOption);
+	parser.addOption(slicesOption);
+	parser.addOption(axisOption);
+	parser.addOption(weldOption);
+	parser.process(arguments);
+
+	if (parser.isSet(benchmarkOption)) {
+		return benchmark(parser);
+	}
+	if (parser.isSet(statisticsOption)) {
+		return statistics(parser);
+	}
+	if (parser.isSet(slicesOption)) {
+		return slices(parser);
+	}
+	return render(parser);
+}
+
+bool CommandLine::loadOptions(const QCommandLineParser & parser,
+	SceneFactory::LoadOptions *options)
+{
+	*options = SceneFactory::LoadOptions();
+	if (!parser.isSet("weld")) {
+		return true;
+	}
+
+	bool valid = false;
+	options->weldVertices = true;
+	options->weldTolerance = parser.value("weld").toFloat(&valid);
+	if (!valid || options->weldTolerance < 0.0f) {
+		QTextStream(stderr) << tr("Invalid weld tolerance %1").arg(parser.value("weld")) << endl;
+		return false;
+	}
+	return true;
+}
+
+int CommandLine::render(const QCommandLineParser & parser)
+{
+	QTextStream errors(stderr);
+	BatchRenderer::Options options;
+	if (!loadOptions(parser, &options.loadOptions)) {
+		return 1;
+	}
+
+	options.mode = parser.value("mode");
+	if (options.mode != "auto" && !BatchRenderer::modeNames().contains(options.mode)) {
+		errors << tr("Unknown render mode %1").arg(options.mode) << endl;
+		return 1;
+	}
+
+	QStringList size = parser.value("size").split('x');
+	int width = size.value(0).toInt();
+	int height = size.value(1).toInt();
+	if (size.size() != 2 || width <= 0 || height <= 0) {
+		errors << tr("Invalid image size %1").arg(parser.value("size")) << endl;
+		return 1;
+	}
+	options.size = QSize(width, height);
+
+	QStringList rotation = parser.value("rotate").split(',');
+	bool validX = false;
+	bool validY = false;
+	options.rotationX = rotation.value(0).toFloat(&validX);
+	options.rotationY = rotation.value(1).toFloat(&validY);
+	if (rotation.size() != 2 || !validX || !validY) {
+		errors << tr("Invalid rotation %1").arg(parser.value("rotate")) << endl;
+		return 1;
+	}
+
+	bool validZoom = false;
+	options.zoom = parser.value("zoom").toFloat(&validZoom);
+	if (!validZoom || options.zoom <= 0.0f) {
+		errors << tr("Invalid zoom %1").arg(parser.value("zoom")) << endl;
+		return 1;
+	}
+
+	options.background = QColor(parser.value("background"));
+	options.color = QColor(parser.value("color"));
+	if (!options.background.isValid() || !options.color.isValid()) {
+		errors << tr("Invalid color") << endl;
+		return 1;
+	}
+
+	options.outputDirectory = parser.value("output");
+	options.jobs = parser.value("jobs").toInt();
+
+	QStringList files = parser.positionalArguments();
+	if (files.isEmpty()) {
+		errors << tr("No files given") << endl;
+		return 1;
+	}
+
+	BatchRenderer renderer(options);
+	return renderer.run(files) > 0 ? 1 : 0;
+}
+
+int CommandLine::benchmark(const QCommandLineParser & parser)
+{
+	QTextStream errors(stderr);
+	SceneFactory::LoadOptions options;
+	if (!loadOptions(parser, &options)) {
+		return 1;
+	}
+
+	bool valid = false;
+	int iterations = parser.value("iterations").toInt(&valid);
+	if (!valid || iterations < 1) {
+		errors << tr("Invalid number of iterations %1").arg(parser.value("iterations")) << endl;
+		return 1;
+	}
+
+	try {
+		QByteArray report = Benchmark::run(parser.value("benchmark"), options, iterations);
+		QTextStream(stdout) << report;
+	}
+	catch (QString & message) {
+		errors << parser.value("benchmark") << ": " << message << endl;
+		return 1;
+	}
+	return 0;
+}
+
+int CommandLine::statistics(const QCommandLineParser & parser)
+{
+	QTextStream errors(stderr);
+	QTextStream output(stdout);
+	SceneFactory::LoadOptions options;
+	if (!loadOptions(parser, &options)) {
+		return 1;
+	}
+
+	QStringList files = parser.positionalArguments();
+	if (files.isEmpty()) {
+		errors << tr("No files given") << endl;
+		return 1;
+	}
+
+	// The files are measured one after the other, each measurement is parallel
+	int failures = 0;
+	for (int i = 0; i < files.size(); i++) {
+		try {
+			QScopedPointer<IScene> scene(SceneFactory::openFile(files[i], options, false));
+			HalfEdgeMesh halfEdges(scene.data());
+			MeshStatistics::Report report = MeshStatistics::compute(scene.data(), halfEdges, -1);
+			output << files[i] << endl << MeshStatistics::describe(report) << endl << endl;
+		}
+		catch (QString & message) {
+			failures++;
+			errors << files[i] << ": " << message << endl;
+		}
+	}
+	return failures > 0 ? 1 : 0;
+}
+
+int CommandLine::slices(const QCommandLineParser & parser)
+{
+	QTextStream errors(stderr);
+	QTextStream output(stdout);
+	SceneFactory::LoadOptions options;
+	if (!loadOptions(parser, &options)) {
+		return 1;
+	}
+
+	bool valid = false;
+	int count = parser.value("slices").toInt(&valid);
+	if (!valid || count < 1) {
+		errors << tr("Invalid number of slices %1").arg(parser.value("slices")) << endl;
+		return 1;
+	}
+
+	int axis = QStringList({ "x", "y", "z" }).indexOf(parser.value("axis").toLower());
+	if (axis < 0) {
+		errors << tr("Invalid axis %1").arg(parser.value("axis")) << endl;
+		return 1;
+	}
+
+	QStringList files = parser.positionalArguments();
+	if (files.isEmpty()) {
+		errors << tr("No files given") << endl;
+		return 1;
+	}
+
+	// The files are cut one after the other, the slices of each file are parallel
+	int failures = 0;
+	for (int i = 0; i < files.size(); i++) {
+		QFileInfo info(files[i]);
+		QString directory = parser.isSet("output") ? parser.value("output") : info.absolutePath();
+		QString target = QDir(directory).filePath(info.completeBaseName() + ".cli");
+		try {
+			QScopedPointer<IScene> scene(SceneFactory::openFile(files[i], options, false));
+			SceneBvh bvh(scene.data());
+			MeshSlicer::writeCli(target, axis, MeshSlicer(scene.data(), &bvh).slices(axis, count));
+			output << target << endl;
+		}
+		catch (QString & message) {
+			failures++;
+			errors << files[i] << ": " << message << endl;
+		}
+	}
+	return failures > 0 ? 1 : 0;
+}
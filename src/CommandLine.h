@@ -0,0 +1,73 @@
+#pragma once
+
+#include <QtCore>
+#include <QCommandLineParser>
+
+#include "SceneFactory.h"
+
+/**
+ * @brief Command line interface for jobs without a main window
+ *
+ * OffView normally opens its main window with an optional file. Some options
+ * start a batch job instead, which runs without a display and exits when
+ * it is done. These jobs only need a QCoreApplication.
+ *
+ * @see BatchRenderer
+ * @see Benchmark
+ * @see MeshStatistics
+ * @see MeshSlicer
+ */
+class CommandLine
+{
+	Q_DECLARE_TR_FUNCTIONS(CommandLine)
+
+public:
+	/**
+	 * @brief Checks if the arguments start a batch job
+	 *
+	 * Must be called before the application object is created, because
+	 * batch jobs must not create a QApplication.
+	 *
+	 * @param [in] argc Number of arguments
+	 * @param [in] argv Argument vector
+	 * @return True, if run() should be called instead of showing the main window
+	 */
+	static bool isBatchJob(int argc, char **argv);
+
+	/**
+	 * @brief Parses the arguments and runs the batch job
+	 *
+	 * @param [in] arguments The arguments of the application
+	 * @return Exit code of the application
+	 */
+	static int run(const QStringList & arguments);
+
+private:
+	/**
+	 * @brief Reads the options for loading the files
+	 *
+	 * @param [out] options Receives the options
+	 * @return False if an option is invalid, the error was printed then
+	 */
+	static bool loadOptions(const QCommandLineParser & parser, SceneFactory::LoadOptions *options);
+
+	/**
+	 * @brief Renders the files given as positional arguments
+	 */
+	static int render(const QCommandLineParser & parser);
+
+	/**
+	 * @brief Runs the benchmark and prints the report
+	 */
+	static int benchmark(const QCommandLineParser & parser);
+
+	/**
+	 * @brief Prints the MeshStatistics of the files given as positional arguments
+	 */
+	static int statistics(const QCommandLineParser & parser);
+
+	/**
+	 * @brief Cuts the files given as positional arguments into slices and saves them as CLI files
+	 */
+	static int slices(const QCommandLineParser & parser);
+};
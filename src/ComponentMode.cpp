@@ -0,0 +1,83 @@
+#include <algorithm>
+#include <cmath>
+
+#include <QtOpenGL>
+
+#include "ComponentMode.h"
+#include "Parallel.h"
+#include "Trace.h"
+
+ComponentMode::ComponentMode() :
+	ShadedMode(/* smoothShaded = */ true, /* colored = */ false, /* specular = */ false)
+{
+	// Nothing to do
+}
+
+QString ComponentMode::name() const
+{
+	return tr("Component Mode");
+}
+
+bool ComponentMode::geometryUsesDefaultColor() const
+{
+	return false;
+}
+
+QColor ComponentMode::componentColor(int component)
+{
+	// Steps of the golden ratio spread the hues evenly
+	double hue = std::fmod(component * 0.618033988749895, 1.0);
+	return QColor::fromHsvF(hue, 0.6, 0.95);
+}
+
+RenderGeometry* ComponentMode::createGeometry(const IScene *scene, const SceneBvh *bvh,
+	const QColor *) const
+{
+	TRACE_ZONE("ComponentMode::createGeometry");
+
+	RenderGeometry *geometry = RenderGeometry::fromPolygons(scene, bvh,
+		RenderGeometry::Triangles, true, true,
+		[](const CPolygon *poly) {
+			int cv = static_cast<int>(poly->vertexCount());
+			return cv >= 3 ? 3 * (cv - 2) : 0;
+		},
+		[](const CPolygon *) {
+			return false;
+		},
+		[](const CPolygon *poly, RenderGeometry *geometry, int first) {
+			float *positions = geometry->positions() + 3 * first;
+			float *normals = geometry->normals() + 3 * first;
+
+			// Split the polygon into a triangle fan like GL_POLYGON does
+			size_t cv = poly->vertexCount();
+			for(size_t t=1; t+1<cv; t++) {
+				const size_t corners[3] = { 0, t, t + 1 };
+				for(int k=0; k<3; k++) {
+					const CVertex *vert = poly->vertex(corners[k]);
+					const float *data = vert->vertex();
+					positions[0] = data[0];
+					positions[1] = data[1];
+					positions[2] = data[2];
+					RenderGeometry::normalize(vert->normal(), normals);
+					positions += 3;
+					normals += 3;
+				}
+			}
+		}
+	);
+
+	// All polygons are opaque, so only the opaque ranges contain vertices
+	Parallel::forBlocks(bvh->partsCount(), 1, [&](int begin, int end) {
+		for (int p = begin; p < end; p++) {
+			quint8 color[4];
+			RenderGeometry::writeColor(componentColor(bvh->part(p).component), color);
+			const RenderGeometry::Range & range = geometry->opaqueRange(p);
+			quint8 *colors = geometry->colors() + 4 * range.first;
+			for (int i = 0; i < range.count; i++) {
+				std::copy(color, color + 4, colors + 4 * i);
+			}
+		}
+	});
+
+	return geometry;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "ShadedMode.h"
+
+/**
+ * @brief Render mode which colors each connected component differently
+ *
+ * Smooth shaded like SmoothShadedMode, but every connected component of
+ * the scene gets its own color, so touching parts of an assembly can be
+ * told apart. The colors of the scene are ignored.
+ *
+ * @see MeshComponents
+ * @see ShadedMode
+ */
+class ComponentMode : public ShadedMode
+{
+	Q_DECLARE_TR_FUNCTIONS(ComponentMode)
+
+public:
+	/**
+	 * @brief Constructor
+	 */
+	ComponentMode();
+
+	QString name() const override;
+
+	/**
+	 * @brief Creates smooth shaded triangles with the color of their component
+	 *
+	 * Each part of the hierarchy belongs to a single component, so the
+	 * colors are written for whole vertex ranges.
+	 *
+	 * @param [in] scene The scene which should be drawn
+	 * @param [in] bvh The polygon hierarchy of the scene
+	 * @param [in] defaultColor Not used
+	 * @return The new geometry
+	 */
+	RenderGeometry* createGeometry(const IScene *scene, const SceneBvh *bvh,
+		const QColor *defaultColor) const override;
+
+	bool geometryUsesDefaultColor() const override;
+
+	/**
+	 * @brief Returns the color of a component
+	 *
+	 * The hues of neighbouring numbers are far apart.
+	 */
+	static QColor componentColor(int component);
+};
@@ -1,5 +1,7 @@
 #include <QtOpenGL>
 #include "DotMode.h"
+#include "Trace.h"
+#include "Parallel.h"
 
 QString DotMode::name() const
 {
@@ -18,35 +20,99 @@ void DotMode::unsetSettings()
 	glDisable(GL_DEPTH_TEST);
 }
 
-void DotMode::draw(const IScene *scene, const QColor *defaultColor)
+RenderGeometry* DotMode::createGeometry(const IScene *scene, const SceneBvh *bvh,
+	const QColor *) const
 {
-	// Remeber our scene pointer and the display list id
-	static const IScene *oldScene = 0;
-	static unsigned int displayList = 0;
-	
-	// Do not place the color inside the display list because it can change!
+	TRACE_ZONE("DotMode::createGeometry");
+	int vc = scene->verticesCount();
+	int parts = bvh->partsCount();
+
+	// Each vertex is drawn by the first part which uses it,
+	// vertices without polygons go into the last range
+	QVector<int> owner(vc, parts);
+	for(int p=0; p<parts; p++) {
+		const SceneBvh::Part & part = bvh->part(p);
+		for(int i=part.first; i<part.first+part.count; i++) {
+			const CPolygon *poly = scene->polygon(bvh->polygonAt(i));
+			size_t cv = poly->vertexCount();
+			for(size_t j=0; j<cv; j++) {
+				int &vertexOwner = owner[poly->vertexIndex(j)];
+				if (vertexOwner > p) {
+					vertexOwner = p;
+				}
+			}
+		}
+	}
+
+	QVector<int> counts(parts + 1, 0);
+	for(int i=0; i<vc; i++) {
+		counts[owner[i]]++;
+	}
+
+	RenderGeometry *geometry = new RenderGeometry(RenderGeometry::Points, false, false);
+	geometry->allocate(counts, QVector<int>(parts + 1, 0));
+
+	// Sort the vertices into their ranges
+	QVector<int> next(parts + 1);
+	for(int p=0; p<=parts; p++) {
+		next[p] = geometry->opaqueRange(p).first;
+	}
+	QVector<int> target(vc);
+	for(int i=0; i<vc; i++) {
+		target[i] = next[owner[i]]++;
+	}
+
+	float *positions = geometry->positions();
+	Parallel::forBlocks(vc, 1 << 14, [&](int begin, int end) {
+		for(int i=begin; i<end; i++) {
+			const float *data = scene->vertex(i)->vertex();
+			float *position = positions + 3 * target[i];
+			position[0] = data[0];
+			position[1] = data[1];
+			position[2] = data[2];
+		}
+	});
+
+	return geometry;
+}
+
+RenderGeometry::Primitive DotMode::primitive() const
+{
+	return RenderGeometry::Points;
+}
+
+bool DotMode::geometryUsesDefaultColor() const
+{
+	return false;
+}
+
+void DotMode::draw(const GeometryBuffer *geometry, const QVector<int> & parts,
+	const QColor *defaultColor)
+{
+	TRACE_ZONE("DotMode::draw");
+	// The color is not part of the geometry because it can change!
 	glColor3f(
 		defaultColor->redF(),
 		defaultColor->greenF(),
 		defaultColor->blueF()
 	);
 	
-	// Do we need to update the display list?
-	if (oldScene != scene || displayList == 0) {
-		displayList = glGenLists(1);
-		glNewList(displayList, GL_COMPILE);
-			glBegin( GL_POINTS );
-			int vc = scene->verticesCount();
-			for(int i=0; i<vc; i++) {
-				const CVertex *vert = scene->vertex(i);
-				const float *data = vert->vertex();
-				glVertex3fv(data);
-			}
-			glEnd();
-		glEndList ();
-		oldScene = scene;
-	}
-	
 	// Draw the object
-	glCallList(displayList);
+	geometry->draw(parts);
+}
+
+void DotMode::render(SoftwareRenderer *renderer, const RenderGeometry *geometry,
+	const QVector<int> & parts, const QColor *defaultColor) const
+{
+	TRACE_ZONE("DotMode::render");
+	QColor color = *defaultColor;
+	color.setAlpha(255);
+
+	renderer->setDepthTest(true);
+	renderer->setBlending(false);
+	renderer->setLighting(false, false);
+	renderer->setPointSize(2.0f);
+	renderer->setColor(color);
+	renderer->draw(geometry, parts);
+	renderer->setPointSize(1.0f);
 }
@@ -24,5 +24,15 @@ public:
 
 	void unsetSettings() override;
 
-	void draw(const IScene *scene, const QColor *defaultColor) override;
+	RenderGeometry* createGeometry(const IScene *scene, const SceneBvh *bvh,
+		const QColor *defaultColor) const override;
+
+	RenderGeometry::Primitive primitive() const override;
+
+	bool geometryUsesDefaultColor() const override;
+
+	void draw(const GeometryBuffer *geometry, const QVector<int> & parts,
+		const QColor *defaultColor) override;
+	void render(SoftwareRenderer *renderer, const RenderGeometry *geometry,
+		const QVector<int> & parts, const QColor *defaultColor) const override;
 };
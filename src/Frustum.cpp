@@ -0,0 +1,30 @@
+#include "Frustum.h"
+
+Frustum::Frustum(const QMatrix4x4 & matrix)
+{
+	// Extract the frustum planes from the rows of the matrix: a point is
+	// inside, if -w <= x, y, z <= w holds for its clip coordinates
+	QVector4D w = matrix.row(3);
+	for (int i = 0; i < 3; i++) {
+		QVector4D r = matrix.row(i);
+		for (int k = 0; k < 4; k++) {
+			planes[2*i][k] = w[k] + r[k];
+			planes[2*i+1][k] = w[k] - r[k];
+		}
+	}
+}
+
+bool Frustum::intersects(const float *min, const float *max) const
+{
+	for (int i = 0; i < 6; i++) {
+		// Test the box corner which is the farthest along the plane normal
+		const float *p = planes[i];
+		float x = p[0] >= 0.0f ? max[0] : min[0];
+		float y = p[1] >= 0.0f ? max[1] : min[1];
+		float z = p[2] >= 0.0f ? max[2] : min[2];
+		if (p[0]*x + p[1]*y + p[2]*z + p[3] < 0.0f) {
+			return false;
+		}
+	}
+	return true;
+}
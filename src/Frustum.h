@@ -0,0 +1,40 @@
+#pragma once
+
+#include <QMatrix4x4>
+
+/**
+ * @brief The six clipping planes of a view frustum
+ *
+ * The planes are extracted from a combined projection and model view
+ * matrix, so the tests work directly in scene coordinates.
+ *
+ * @see SceneBvh::cull()
+ */
+class Frustum
+{
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param [in] matrix Projection matrix multiplied with the model view matrix
+	 */
+	Frustum(const QMatrix4x4 & matrix);
+
+	/**
+	 * @brief Bounding box versus frustum test
+	 *
+	 * The test is conservative: boxes near the frustum corners may be
+	 * reported as visible even if they are outside.
+	 *
+	 * @param [in] min Minimum corner of the box
+	 * @param [in] max Maximum corner of the box
+	 * @return False, if the box is completely outside of one plane
+	 */
+	bool intersects(const float *min, const float *max) const;
+
+private:
+	/**
+	 * @brief The planes (a, b, c, d) with normals pointing inwards
+	 */
+	float planes[6][4];
+};
@@ -0,0 +1,303 @@
+#include <climits>
+
+#include "GeometryBuffer.h"
+#include "Trace.h"
+
+GeometryBuffer::GeometryBuffer(RenderGeometry *geometry)
+{
+	TRACE_ZONE("GeometryBuffer upload");
+
+	this->geometry = geometry;
+	type = geometry->primitive();
+	withNormals = geometry->hasNormals();
+	withColors = geometry->hasColors();
+	count = geometry->verticesCount();
+
+	int ranges = geometry->rangesCount();
+	opaque.resize(ranges);
+	translucent.resize(ranges);
+	for (int i = 0; i < ranges; i++) {
+		opaque[i] = geometry->opaqueRange(i);
+		translucent[i] = geometry->translucentRange(i);
+	}
+	levels = geometry->alphaLevelsCount();
+	translucentLevels.resize(ranges * levels);
+	for (int i = 0; i < ranges; i++) {
+		for (int l = 0; l < levels; l++) {
+			translucentLevels[i * levels + l] = geometry->translucentRange(i, l);
+		}
+	}
+
+	// Put as many complete ranges into each page as possible
+	int vertexBytes = 3 * sizeof(float);
+	if (withNormals) {
+		vertexBytes += 3 * sizeof(float);
+	}
+	if (withColors) {
+		vertexBytes += 4;
+	}
+	int maxPageVertices = maxPageBytes / vertexBytes;
+
+	rangePages.resize(ranges);
+	for (int i = 0; i < ranges; i++) {
+		int rangeVertices = opaque[i].count + translucent[i].count;
+		if (pages.isEmpty() || (pages.last().count > 0 &&
+				pages.last().count + rangeVertices > maxPageVertices)) {
+			Page page;
+			page.first = opaque[i].first;
+			page.count = 0;
+			pages.append(page);
+		}
+		pages.last().count += rangeVertices;
+		rangePages[i] = pages.size() - 1;
+	}
+
+	// Upload the pages
+	bool uploaded = true;
+	for (int i = 0; i < pages.size(); i++) {
+		Page & page = pages[i];
+		page.normalsOffset = page.count * 3 * sizeof(float);
+		page.colorsOffset = page.normalsOffset + (withNormals ? page.count * 3 * sizeof(float) : 0);
+
+		// A single range can be larger than a page, buffers are limited to int
+		qint64 size = qint64(page.count) * vertexBytes;
+		if (size > INT_MAX || !page.buffer.create() || !page.buffer.bind()) {
+			uploaded = false;
+			break;
+		}
+		page.buffer.setUsagePattern(QGLBuffer::StaticDraw);
+		page.buffer.allocate(static_cast<int>(size));
+		page.buffer.write(0, geometry->positions() + 3 * page.first,
+			page.count * 3 * sizeof(float));
+		if (withNormals) {
+			page.buffer.write(page.normalsOffset, geometry->normals() + 3 * page.first,
+				page.count * 3 * sizeof(float));
+		}
+		if (withColors) {
+			page.buffer.write(page.colorsOffset, geometry->colors() + 4 * page.first,
+				page.count * 4);
+		}
+		page.buffer.release();
+	}
+
+	if (uploaded) {
+		// The vertex data is now stored on the graphics card
+		delete this->geometry;
+		this->geometry = nullptr;
+	} else {
+		// Fall back to client side vertex arrays
+		for (int i = 0; i < pages.size(); i++) {
+			pages[i].buffer.destroy();
+		}
+		pages.clear();
+	}
+}
+
+GeometryBuffer::~GeometryBuffer()
+{
+	for (int i = 0; i < pages.size(); i++) {
+		pages[i].buffer.destroy();
+	}
+	delete geometry;
+}
+
+bool GeometryBuffer::rewrite(RenderGeometry *geometry)
+{
+	TRACE_ZONE("GeometryBuffer rewrite");
+
+	int ranges = geometry->rangesCount();
+	if (geometry->primitive() != type || geometry->hasNormals() != withNormals ||
+			geometry->hasColors() != withColors || geometry->verticesCount() != count ||
+			ranges != opaque.size() || geometry->alphaLevelsCount() != levels) {
+		return false;
+	}
+	for (int i = 0; i < ranges; i++) {
+		RenderGeometry::Range o = geometry->opaqueRange(i);
+		RenderGeometry::Range t = geometry->translucentRange(i);
+		if (o.first != opaque[i].first || o.count != opaque[i].count ||
+				t.first != translucent[i].first || t.count != translucent[i].count) {
+			return false;
+		}
+		for (int l = 0; l < levels; l++) {
+			RenderGeometry::Range level = geometry->translucentRange(i, l);
+			const RenderGeometry::Range & old = translucentLevels[i * levels + l];
+			if (level.first != old.first || level.count != old.count) {
+				return false;
+			}
+		}
+	}
+
+	// The fallback simply draws the new arrays
+	if (pages.isEmpty()) {
+		delete this->geometry;
+		this->geometry = geometry;
+		return true;
+	}
+
+	for (int i = 0; i < pages.size(); i++) {
+		Page & page = pages[i];
+		page.buffer.bind();
+		page.buffer.write(0, geometry->positions() + 3 * page.first,
+			page.count * 3 * sizeof(float));
+		if (withNormals) {
+			page.buffer.write(page.normalsOffset, geometry->normals() + 3 * page.first,
+				page.count * 3 * sizeof(float));
+		}
+		if (withColors) {
+			page.buffer.write(page.colorsOffset, geometry->colors() + 4 * page.first,
+				page.count * 4);
+		}
+		page.buffer.release();
+	}
+	delete geometry;
+	return true;
+}
+
+void GeometryBuffer::draw(const QVector<int> & parts) const
+{
+	if (count == 0) {
+		return;
+	}
+
+	glEnableClientState(GL_VERTEX_ARRAY);
+	if (withNormals) {
+		glEnableClientState(GL_NORMAL_ARRAY);
+	}
+	if (withColors) {
+		glEnableClientState(GL_COLOR_ARRAY);
+	}
+
+	// Opaque geometry first, so it is visible behind translucent polygons,
+	// then the translucent geometry from the most opaque to the most transparent
+	int boundPage = -2;
+	drawRanges(parts, false, 0, &boundPage);
+	for (int l = 0; l < levels; l++) {
+		drawRanges(parts, true, l, &boundPage);
+	}
+
+	if (!pages.isEmpty()) {
+		QGLBuffer::release(QGLBuffer::VertexBuffer);
+	}
+	glDisableClientState(GL_VERTEX_ARRAY);
+	glDisableClientState(GL_NORMAL_ARRAY);
+	glDisableClientState(GL_COLOR_ARRAY);
+}
+
+void GeometryBuffer::drawRanges(const QVector<int> & parts, bool translucentPass, int level,
+	int *boundPage) const
+{
+	GLenum mode = GL_TRIANGLES;
+	if (type == RenderGeometry::Points) {
+		mode = GL_POINTS;
+	} else if (type == RenderGeometry::Lines) {
+		mode = GL_LINES;
+	}
+
+	// Neighbouring ranges on the same page are merged into one call
+	int pendingPage = -2;
+	int pendingFirst = 0;
+	int pendingCount = 0;
+
+	int ranges = opaque.size();
+	for (int i = 0; i <= parts.size(); i++) {
+		// The last range does not belong to a part and is always drawn
+		int range = (i < parts.size()) ? parts[i] : ranges - 1;
+		const RenderGeometry::Range & r = translucentPass
+			? translucentLevels[range * levels + level] : opaque[range];
+		if (r.count == 0) {
+			continue;
+		}
+
+		int page = pages.isEmpty() ? -1 : rangePages[range];
+		int first = (page >= 0) ? r.first - pages[page].first : r.first;
+		if (page == pendingPage && first == pendingFirst + pendingCount) {
+			pendingCount += r.count;
+			continue;
+		}
+
+		if (pendingCount > 0) {
+			glDrawArrays(mode, pendingFirst, pendingCount);
+		}
+		if (page != *boundPage) {
+			bindPage(page);
+			*boundPage = page;
+		}
+		pendingPage = page;
+		pendingFirst = first;
+		pendingCount = r.count;
+	}
+
+	if (pendingCount > 0) {
+		glDrawArrays(mode, pendingFirst, pendingCount);
+	}
+}
+
+void GeometryBuffer::bindPage(int page) const
+{
+	const GLvoid *positions;
+	const GLvoid *normals;
+	const GLvoid *colors;
+
+	if (page >= 0) {
+		// The pointers are offsets into the bound buffer object
+		QGLBuffer buffer = pages[page].buffer;
+		buffer.bind();
+		positions = nullptr;
+		normals = reinterpret_cast<const GLvoid*>(static_cast<quintptr>(pages[page].normalsOffset));
+		colors = reinterpret_cast<const GLvoid*>(static_cast<quintptr>(pages[page].colorsOffset));
+	} else {
+		positions = geometry->positions();
+		normals = geometry->normals();
+		colors = geometry->colors();
+	}
+
+	glVertexPointer(3, GL_FLOAT, 0, positions);
+	if (withNormals) {
+		glNormalPointer(GL_FLOAT, 0, normals);
+	}
+	if (withColors) {
+		glColorPointer(4, GL_UNSIGNED_BYTE, 0, colors);
+	}
+}
+
+RenderGeometry::Primitive GeometryBuffer::primitive() const
+{
+	return type;
+}
+
+bool GeometryBuffer::hasColors() const
+{
+	return withColors;
+}
+
+qint64 GeometryBuffer::verticesCount() const
+{
+	return count;
+}
+
+qint64 GeometryBuffer::verticesCount(const QVector<int> & parts) const
+{
+	if (count == 0) {
+		return 0;
+	}
+	int last = opaque.size() - 1;
+	qint64 total = opaque[last].count + translucent[last].count;
+	for (int i = 0; i < parts.size(); i++) {
+		total += opaque[parts[i]].count + translucent[parts[i]].count;
+	}
+	return total;
+}
+
+qint64 GeometryBuffer::mainMemoryBytes() const
+{
+	return geometry ? geometry->bytes() : 0;
+}
+
+qint64 GeometryBuffer::bytes() const
+{
+	qint64 total = 0;
+	for (int i = 0; i < pages.size(); i++) {
+		total += pages[i].buffer.size();
+	}
+	return total;
+}
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <QVector>
+#include <QtOpenGL>
+
+#include "RenderGeometry.h"
+
+/**
+ * @brief RenderGeometry uploaded to the graphics card
+ *
+ * The vertex arrays are copied into OpenGL vertex buffer objects. Very large
+ * scenes are split into several buffers (pages), because many drivers fail to
+ * allocate single buffers of several hundred megabytes. A page always contains
+ * complete ranges. If vertex buffer objects are not supported, the geometry is
+ * kept in main memory and drawn with client side vertex arrays instead.
+ *
+ * The OpenGL context which was current during the construction must also be
+ * current when the buffer is drawn or deleted.
+ *
+ * @see RenderGeometry
+ */
+class GeometryBuffer
+{
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * Uploads the geometry into the current OpenGL context.
+	 *
+	 * @param [in] geometry The vertex data, the buffer takes the ownership
+	 */
+	GeometryBuffer(RenderGeometry *geometry);
+
+	/**
+	 * @brief Destructor
+	 *
+	 * Frees the OpenGL buffers.
+	 */
+	~GeometryBuffer();
+
+	/**
+	 * @brief Replaces the vertex data without allocating new buffers
+	 *
+	 * Only works if the geometry has the same primitive, attributes and
+	 * ranges as the uploaded one, like the geometry of a scene whose
+	 * vertices were moved. The buffers must not be used by a frame the
+	 * graphics card is still drawing, otherwise the upload waits for it.
+	 *
+	 * @param [in] geometry The new vertex data, the buffer takes the ownership on success
+	 * @return False, if the layout differs, the buffer is unchanged then
+	 */
+	bool rewrite(RenderGeometry *geometry);
+
+	/**
+	 * @brief Draws the ranges of the selected parts
+	 *
+	 * At first all opaque ranges are drawn, then the translucent ranges one
+	 * alpha level after the other, like the scene sorts its polygons.
+	 * The last range, which does not belong to any part, is always drawn.
+	 * The caller is responsible for the OpenGL state like the current color.
+	 *
+	 * @param [in] parts The numbers of the visible parts in ascending order
+	 */
+	void draw(const QVector<int> & parts) const;
+
+	/**
+	 * @brief Returns the primitive type of the vertices
+	 */
+	RenderGeometry::Primitive primitive() const;
+
+	/**
+	 * @brief Does the buffer contain a color for each vertex?
+	 */
+	bool hasColors() const;
+
+	/**
+	 * @brief Returns the number of vertices
+	 */
+	qint64 verticesCount() const;
+
+	/**
+	 * @brief Returns the number of vertices draw() submits for some parts
+	 *
+	 * @param [in] parts The numbers of the visible parts
+	 * @return Number of drawn vertices
+	 */
+	qint64 verticesCount(const QVector<int> & parts) const;
+
+	/**
+	 * @brief Returns the size of the uploaded vertex data
+	 *
+	 * @return Number of bytes in graphics memory, zero for the fallback
+	 */
+	qint64 bytes() const;
+
+	/**
+	 * @brief Returns the size of the vertex data kept in main memory
+	 *
+	 * @return Number of bytes for the fallback, zero if the data was uploaded
+	 */
+	qint64 mainMemoryBytes() const;
+
+private:
+	// Do not allow copy constructor and the assignment operator
+	GeometryBuffer(const GeometryBuffer & other);
+	GeometryBuffer& operator=(const GeometryBuffer& other);
+
+	/**
+	 * @brief A buffer object with a contiguous block of ranges
+	 *
+	 * The buffer contains all positions of the vertices first..first+count-1,
+	 * followed by their normals and their colors.
+	 */
+	struct Page
+	{
+		QGLBuffer buffer;
+		int first;
+		int count;
+		int normalsOffset;
+		int colorsOffset;
+	};
+
+	/**
+	 * @brief Draws one kind of range for the selected parts
+	 */
+	void drawRanges(const QVector<int> & parts, bool translucent, int level, int *boundPage) const;
+
+	/**
+	 * @brief Binds the buffer of a page and sets the vertex array pointers
+	 */
+	void bindPage(int page) const;
+
+	/**
+	 * @brief Maximum number of bytes per page
+	 */
+	static const int maxPageBytes = 128 * 1024 * 1024;
+
+	/**
+	 * @brief The vertex data, only kept if no buffers could be created
+	 */
+	RenderGeometry *geometry;
+
+	/**
+	 * @brief Copy of the ranges, so the geometry can be freed after the upload
+	 */
+	QVector<RenderGeometry::Range> opaque;
+	QVector<RenderGeometry::Range> translucent;
+
+	/**
+	 * @brief Copy of the translucent ranges of each alpha level
+	 */
+	int levels;
+	QVector<RenderGeometry::Range> translucentLevels;
+
+	/**
+	 * @brief The page of each range
+	 */
+	QVector<int> rangePages;
+
+	/**
+	 * @brief All buffer pages, empty for the fallback
+	 */
+	QVector<Page> pages;
+
+	/**
+	 * @brief Attributes of the vertex data
+	 */
+	RenderGeometry::Primitive type;
+	bool withNormals;
+	bool withColors;
+	qint64 count;
+};
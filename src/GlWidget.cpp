@@ -1,9 +1,13 @@
+#include <QtConcurrent>
+
 #include "GlWidget.h"
 #include "WireframeMode.h"
 #include "DotMode.h"
 #include "FlatShadedMode.h"
 #include "SmoothShadedMode.h"
 #include "ColoredMode.h"
+#include "ComponentMode.h"
+#include "Trace.h"
 
 GlWidget::GlWidget(QWidget *parent): QGLWidget(parent)
 {
@@ -11,6 +15,17 @@ GlWidget::GlWidget(QWidget *parent): QGLWidget(parent)
 	QGLWidget::setFormat(QGLFormat(QGL::SampleBuffers));
 
 	scene = nullptr;
+	tileFile = nullptr;
+	streamer = nullptr;
+	bvh = nullptr;
+	hierarchyWatcher = nullptr;
+	pickedPolygon = -1;
+	pickedVertex = -1;
+	defectEdges = nullptr;
+	defectCorners = nullptr;
+	hiddenCount = 0;
+	clipPlane = -1;
+	clipOffset = 0.0f;
 	activeMode = 0;
 
 	renderModes.append(new WireframeMode());
@@ -18,6 +33,19 @@ GlWidget::GlWidget(QWidget *parent): QGLWidget(parent)
 	renderModes.append(new FlatShadedMode());
 	renderModes.append(new SmoothShadedMode());
 	renderModes.append(new ColoredMode());
+	renderModes.append(new ComponentMode());
+	geometries.fill(nullptr, renderModes.size());
+	geometryColors.resize(renderModes.size());
+	softwareGeometries.fill(nullptr, renderModes.size());
+	softwareGeometryColors.resize(renderModes.size());
+	previousGeometries.fill(nullptr, renderModes.size());
+	spareGeometries.fill(nullptr, renderModes.size());
+	useSoftware = false;
+	overlay = nullptr;
+	gpuTimer = nullptr;
+	gpuTimerPending = false;
+	sceneMemory = 0;
+	stats = CullingStats();
 	
 	// Set here the best fitting render modes
 	uncoloredMode = 3; // Smooth Shaded Mode
@@ -31,40 +59,135 @@ GlWidget::GlWidget(QWidget *parent): QGLWidget(parent)
 
 GlWidget::~GlWidget()
 {
+	waitForHierarchy();
+	releaseGeometries();
+	releaseDefectGeometry();
+	for (auto it = parkedScenes.begin(); it != parkedScenes.end(); ++it) {
+		releaseResources(&it.value());
+	}
+	delete gpuTimer;
+	delete overlay;
+	delete streamer;
 	for(int i=0; i<renderModes.size(); i++) {
 		delete renderModes[i];
 	}
+	delete bvh;
 }
 
 void GlWidget::initializeGL()
 {
 	renderModes[activeMode]->setSettings();
+
+	// Without vertex buffers or with a slow software driver our own
+	// multithreaded rasterizer is faster than OpenGL
+	QString renderer = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
+	bool slowDriver = renderer.contains("softpipe") ||
+		renderer.contains("Software Rasterizer") ||
+		renderer.contains("GDI Generic");
+	if (slowDriver || !(QGLFormat::openGLVersionFlags() & QGLFormat::OpenGL_Version_1_5)) {
+		setSoftwareRendering(true);
+	}
 }
 
 void GlWidget::resizeGL(int w, int h)
 {
-	// Fixed width and variable height:
-	float width = 1.0;
-	float height = (float)h / (float)w;
-
 	glViewport(0, 0, w, h);
 	glMatrixMode(GL_PROJECTION);
-	glLoadIdentity();
-	width /= 3.0;
-	height /= 3.0;
-	
-	// Set frustum with near and far clipping plane
-	glFrustum(-width, +width, -height, +height, 0.5, 100.0);
-	
-	// Move the viewpoint by 3 units on the z axis so the camera
-	// will hopefully not be inside the scene object
-	glTranslatef(0.0, 0.0, -3.0);
-	
+	glLoadMatrixf(projectionMatrix().constData());
 	glMatrixMode(GL_MODELVIEW);
 }
 
+QMatrix4x4 GlWidget::projectionMatrix() const
+{
+	return camera.projectionMatrix(width(), height());
+}
+
 void GlWidget::paintGL()
 {
+	TRACE_ZONE("GlWidget::paintGL");
+
+	if (overlay) {
+		paintMeasuredFrame();
+	} else {
+		paintFrame();
+	}
+}
+
+void GlWidget::paintMeasuredFrame()
+{
+	// The result of an older query is only read if it does not stall
+	if (gpuTimerPending && gpuTimer->isResultAvailable()) {
+		overlay->addGpuTime(static_cast<qint64>(gpuTimer->waitForResult()));
+		gpuTimerPending = false;
+	}
+	bool measureGpu = gpuTimer && !gpuTimerPending;
+
+	QElapsedTimer timer;
+	timer.start();
+	if (measureGpu) {
+		gpuTimer->begin();
+	}
+	paintFrame();
+	if (measureGpu) {
+		gpuTimer->end();
+		gpuTimerPending = true;
+	}
+	qint64 vertices = submittedVertices();
+	overlay->addFrame(timer.nsecsElapsed(), (scene || streamer) ? stats.drawnTriangles : 0, vertices);
+
+	QString mode = renderModes[activeMode]->name();
+	if (useSoftware && !streamer) {
+		mode = tr("%1 (Software)").arg(mode);
+	}
+	overlay->setState(mode, gpuMemoryUsage(), sceneMemory);
+
+	// Light text on dark backgrounds and dark text on light ones
+	QFont font("Monospace");
+	font.setStyleHint(QFont::TypeWriter);
+	int lineHeight = QFontMetrics(font).height();
+	qglColor(bgColor.lightness() < 128 ? Qt::white : Qt::black);
+	QStringList lines = overlay->lines();
+	for (int i = 0; i < lines.size(); i++) {
+		renderText(10, 10 + (i + 1) * lineHeight, lines[i], font);
+	}
+}
+
+qint64 GlWidget::submittedVertices() const
+{
+	qint64 vertices = 0;
+	if (streamer) {
+		for (int i = 0; i < visibleTiles.size(); i++) {
+			vertices += visibleTiles[i]->verticesCount();
+		}
+	} else if (scene && useSoftware) {
+		if (softwareGeometries[activeMode]) {
+			vertices = softwareGeometries[activeMode]->verticesCount(visibleParts);
+		}
+	} else if (scene && geometries[activeMode]) {
+		vertices = geometries[activeMode]->verticesCount(visibleParts);
+	}
+	return vertices;
+}
+
+qint64 GlWidget::gpuMemoryUsage() const
+{
+	qint64 bytes = streamer ? streamer->residentBytes() : 0;
+	for (int i = 0; i < geometries.size(); i++) {
+		if (geometries[i]) {
+			bytes += geometries[i]->bytes();
+		}
+	}
+	return bytes + spareGeometryBytes();
+}
+
+void GlWidget::paintFrame()
+{
+	// Tiles are streamed into graphics memory, so they always need OpenGL
+	if (useSoftware && !streamer) {
+		paintSoftware();
+		return;
+	}
+
 	glClearColor(
 		bgColor.redF(),
 		bgColor.greenF(),
@@ -74,12 +197,7 @@ void GlWidget::paintGL()
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
 	glMatrixMode(GL_MODELVIEW);
-	glLoadIdentity();
-
-	glScalef(scale, scale, scale);
-	glTranslatef(xTrans, yTrans, 0.0);
-	glRotatef(xRot, 1.0, 0.0, 0.0);
-	glRotatef(yRot, 0.0, 1.0, 0.0);
+	glLoadMatrixf(camera.viewMatrix().constData());
 	
 	if (showAxes) {
 		drawAxes();
@@ -88,35 +206,491 @@ void GlWidget::paintGL()
 	int lines = 5;
 	float stepSize = 0.2f;
 	
-	if (showPlanes[0]) {
-		drawXzPlane(lines, stepSize, planeColor);
-	}
-	if (showPlanes[1]) {
-		drawXyPlane(lines, stepSize, planeColor);
-	}
-	if (showPlanes[2]) {
-		drawYzPlane(lines, stepSize, planeColor);
-	}
+	drawPlanes(lines, stepSize, planeColor);
+
+	// OpenGL transforms the clipping plane with the current model view matrix
+	float equation[4];
+	clippingEquation(equation);
+	GLdouble clipEquation[4] = { equation[0], equation[1], equation[2], equation[3] };
 	
-	if (scene) {
+	// The scene is drawn once its hierarchy is built
+	if (scene && bvh) {
 		// Backup the current model view matrix
 		glPushMatrix();
 
 		// Scale to window size and move to center
-		glScalef(modelScale, modelScale, modelScale);
-		glTranslatef(modelOffset[0], modelOffset[1], modelOffset[2]);
+		glLoadMatrixf(camera.modelMatrix().constData());
+
+		// Skip all chunks outside of the view frustum
+		cullScene();
+
+		if (clipPlane >= 0) {
+			glClipPlane(GL_CLIP_PLANE0, clipEquation);
+			glEnable(GL_CLIP_PLANE0);
+		}
 
 		// Draw our scene
-		renderModes[activeMode]->draw(scene, &color);
+		renderModes[activeMode]->draw(activeGeometry(), visibleParts, &color);
+
+		// The selection is drawn separately, so the scene needs no update
+		if (pickedPolygon >= 0) {
+			drawPickHighlight();
+		}
+		if (!defectPolygons.isEmpty() || !defectVertices.isEmpty()) {
+			drawDefectHighlight();
+		}
+
+		if (clipPlane >= 0) {
+			glDisable(GL_CLIP_PLANE0);
+			drawSection();
+		}
 
 		// Restore the old model view matrix
 		glPopMatrix();
+	} else if (streamer) {
+		glPushMatrix();
+		glLoadMatrixf(camera.modelMatrix().constData());
+		if (clipPlane >= 0) {
+			glClipPlane(GL_CLIP_PLANE0, clipEquation);
+			glEnable(GL_CLIP_PLANE0);
+		}
+
+		// Select the tiles for the current view and the screen resolution
+		streamer->selectTiles(projectionMatrix() * camera.modelMatrix(), height(), &visibleTiles);
+		stats = CullingStats();
+		stats.drawnChunks = visibleTiles.size();
+		for (int i = 0; i < visibleTiles.size(); i++) {
+			stats.drawnTriangles += visibleTiles[i]->verticesCount() / 3;
+		}
+
+		// Tiles always contain triangles, show them like the active mode would
+		IRenderMode *mode = renderModes[activeMode];
+		GLenum polygonMode = GL_FILL;
+		if (mode->primitive() == RenderGeometry::Lines) {
+			polygonMode = GL_LINE;
+		} else if (mode->primitive() == RenderGeometry::Points) {
+			polygonMode = GL_POINT;
+		}
+		glPolygonMode(GL_FRONT_AND_BACK, polygonMode);
+		for (int i = 0; i < visibleTiles.size(); i++) {
+			mode->draw(visibleTiles[i], QVector<int>(), &color);
+		}
+		glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+		glDisable(GL_CLIP_PLANE0);
+
+		glPopMatrix();
+	}
+}
+
+void GlWidget::cullScene()
+{
+	bvh->cull(projectionMatrix() * camera.modelMatrix(), &visibleChunks);
+
+	// Chunks above the clipping plane would be clipped completely
+	if (clipPlane >= 0) {
+		int axis = clippingAxis();
+		float height = clippingHeight();
+		int kept = 0;
+		for (int i = 0; i < visibleChunks.size(); i++) {
+			if (bvh->chunk(visibleChunks[i]).min[axis] <= height) {
+				visibleChunks[kept++] = visibleChunks[i];
+			}
+		}
+		visibleChunks.resize(kept);
+	}
+
+	// Hidden components only leave out their parts of the shared chunks
+	bvh->chunkParts(visibleChunks, &visibleParts, hiddenCount > 0 ? &hiddenComponents : nullptr);
+
+	stats = CullingStats();
+	for (int i = 0, lastChunk = -1; i < visibleParts.size(); i++) {
+		const SceneBvh::Part & part = bvh->part(visibleParts[i]);
+		if (part.chunk != lastChunk) {
+			stats.drawnChunks++;
+			lastChunk = part.chunk;
+		}
+		stats.drawnTriangles += part.triangles;
+	}
+	stats.culledChunks = bvh->chunksCount() - stats.drawnChunks;
+	for (int i = 0; i < bvh->chunksCount(); i++) {
+		stats.culledTriangles += bvh->chunk(i).triangles;
+	}
+	stats.culledTriangles -= stats.drawnTriangles;
+}
+
+void GlWidget::paintSoftware()
+{
+	softwareRenderer.resize(width(), height());
+	softwareRenderer.clear(bgColor);
+
+	// Axes and planes are drawn like in paintGL() with the mode settings
+	softwareRenderer.setMatrices(projectionMatrix(), camera.viewMatrix());
+	softwareRenderer.setDepthTest(true);
+	softwareRenderer.setBlending(false);
+	softwareRenderer.setLighting(false, false);
+
+	if (showAxes) {
+		RenderGeometry *axesGeometry = createAxesGeometry();
+		softwareRenderer.setLineWidth(3.0f);
+		softwareRenderer.draw(axesGeometry, QVector<int>());
+		softwareRenderer.setLineWidth(1.0f);
+		delete axesGeometry;
+	}
+
+	RenderGeometry *planesGeometry = createPlanesGeometry(5, 0.2f, planeColor);
+	softwareRenderer.draw(planesGeometry, QVector<int>());
+	delete planesGeometry;
+
+	if (scene && bvh) {
+		cullScene();
+		softwareRenderer.setMatrices(projectionMatrix(), camera.modelMatrix());
+		if (clipPlane >= 0) {
+			float equation[4];
+			clippingEquation(equation);
+			softwareRenderer.setClipPlane(equation);
+		}
+		renderModes[activeMode]->render(&softwareRenderer, activeSoftwareGeometry(),
+			visibleParts, &color);
+		softwareRenderer.setClipPlane(nullptr);
+
+		// The section is drawn on top like drawSection() does
+		if (clipPlane >= 0) {
+			RenderGeometry *sectionGeometry = createSectionGeometry();
+			softwareRenderer.setDepthTest(false);
+			softwareRenderer.setBlending(false);
+			softwareRenderer.setLighting(false, false);
+			softwareRenderer.setLineWidth(2.0f);
+			softwareRenderer.draw(sectionGeometry, QVector<int>());
+			softwareRenderer.setLineWidth(1.0f);
+			delete sectionGeometry;
+		}
 	}
+
+	// Copy the image into the frame buffer, the first row is the top one
+	QImage image = softwareRenderer.image().convertToFormat(QImage::Format_RGBA8888);
+	glPushAttrib(GL_ENABLE_BIT);
+	glDisable(GL_DEPTH_TEST);
+	glDisable(GL_BLEND);
+	glMatrixMode(GL_PROJECTION);
+	glPushMatrix();
+	glLoadIdentity();
+	glMatrixMode(GL_MODELVIEW);
+	glPushMatrix();
+	glLoadIdentity();
+
+	glRasterPos2f(-1.0f, 1.0f);
+	glPixelZoom(1.0f, -1.0f);
+	glDrawPixels(image.width(), image.height(), GL_RGBA, GL_UNSIGNED_BYTE, image.constBits());
+	glPixelZoom(1.0f, 1.0f);
+
+	glPopMatrix();
+	glMatrixMode(GL_PROJECTION);
+	glPopMatrix();
+	glMatrixMode(GL_MODELVIEW);
+	glPopAttrib();
+}
+
+RenderGeometry* GlWidget::createAxesGeometry() const
+{
+	RenderGeometry *geometry = new RenderGeometry(RenderGeometry::Lines, false, true);
+	geometry->allocate(QVector<int>(1, 6), QVector<int>(1, 0));
+
+	float *positions = geometry->positions();
+	quint8 *colors = geometry->colors();
+	const QColor axisColors[3] = { Qt::red, Qt::green, Qt::blue };
+	for (int axis = 0; axis < 3; axis++) {
+		for (int k = 0; k < 6; k++) {
+			positions[6*axis + k] = 0.0f;
+		}
+		positions[6*axis + 3 + axis] = 1.0f;
+		RenderGeometry::writeColor(axisColors[axis], colors + 8*axis);
+		RenderGeometry::writeColor(axisColors[axis], colors + 8*axis + 4);
+	}
+
+	return geometry;
+}
+
+RenderGeometry* GlWidget::createPlanesGeometry(int lines, float stepSize, const QColor & c) const
+{
+	// The two axes spanning the XZ, XY and YZ plane
+	const int planeAxes[3][2] = { { 0, 2 }, { 0, 1 }, { 1, 2 } };
+	int planes = 0;
+	for (int p = 0; p < 3; p++) {
+		if (showPlanes[p] || p == clipPlane) {
+			planes++;
+		}
+	}
+
+	int vertices = planes * 4 * (2*lines + 1);
+	RenderGeometry *geometry = new RenderGeometry(RenderGeometry::Lines, false, true);
+	geometry->allocate(QVector<int>(1, vertices), QVector<int>(1, 0));
+
+	float *positions = geometry->positions();
+	quint8 *colors = geometry->colors();
+	for (int p = 0; p < 3; p++) {
+		if (!showPlanes[p] && p != clipPlane) {
+			continue;
+		}
+
+		// The clipping plane is moved along its normal like in drawPlanes()
+		int normal = 3 - planeAxes[p][0] - planeAxes[p][1];
+		QColor opaque = (p == clipPlane) ? clipPlaneColor : c;
+		opaque.setAlpha(255);
+		for (int direction = 0; direction < 2; direction++) {
+			int fixed = planeAxes[p][direction];
+			int varying = planeAxes[p][1 - direction];
+			for (int i = -lines; i <= lines; i++) {
+				for (int end = 0; end < 2; end++) {
+					positions[0] = positions[1] = positions[2] = 0.0f;
+					positions[fixed] = stepSize*i;
+					positions[varying] = (end ? lines : -lines) * stepSize;
+					positions[normal] = (p == clipPlane) ? clipOffset : 0.0f;
+					RenderGeometry::writeColor(opaque, colors);
+					positions += 3;
+					colors += 4;
+				}
+			}
+		}
+	}
+
+	return geometry;
 }
 
 void GlWidget::mousePressEvent(QMouseEvent *event)
 {
 	lastPos = event->pos();
+	pressPos = event->pos();
+}
+
+void GlWidget::mouseReleaseEvent(QMouseEvent *event)
+{
+	// A left click without dragging selects a polygon
+	if (event->button() == Qt::LeftButton &&
+			(event->pos() - pressPos).manhattanLength() < 3) {
+		pick(event->pos());
+	}
+}
+
+void GlWidget::pick(const QPoint & pos)
+{
+	pickedPolygon = -1;
+	pickedVertex = -1;
+
+	if (scene && bvh && scene->polygonsCount() > 0) {
+		// Unproject the click onto the near and far clipping plane
+		QMatrix4x4 inverse = (projectionMatrix() * camera.modelMatrix()).inverted();
+		float x = 2.0f * (pos.x() + 0.5f) / qMax(1, width()) - 1.0f;
+		float y = 1.0f - 2.0f * (pos.y() + 0.5f) / qMax(1, height());
+		QVector3D nearPoint = inverse.map(QVector4D(x, y, -1.0f, 1.0f)).toVector3DAffine();
+		QVector3D farPoint = inverse.map(QVector4D(x, y, 1.0f, 1.0f)).toVector3DAffine();
+
+		float origin[3] = { nearPoint.x(), nearPoint.y(), nearPoint.z() };
+		float direction[3] = {
+			farPoint.x() - nearPoint.x(),
+			farPoint.y() - nearPoint.y(),
+			farPoint.z() - nearPoint.z()
+		};
+
+		// The ray starts at the clipping plane if the camera is above it
+		int axis = clippingAxis();
+		float height = clippingHeight();
+		bool clipped = false;
+		if (clipPlane >= 0 && origin[axis] > height) {
+			if (direction[axis] >= 0.0f) {
+				clipped = true;
+			} else {
+				float t = (height - origin[axis]) / direction[axis];
+				for (int k = 0; k < 3; k++) {
+					origin[k] += t * direction[k];
+				}
+				origin[axis] = height;
+			}
+		}
+
+		// Polygons behind the clipping plane are hidden by it
+		SceneBvh::Hit hit;
+		if (!clipped &&
+				bvh->intersect(origin, direction, &hit, hiddenCount > 0 ? &hiddenComponents : nullptr) &&
+				!(clipPlane >= 0 && hit.point[axis] > height)) {
+			pickedPolygon = hit.polygon;
+
+			// Select the polygon vertex closest to the hit point
+			const CPolygon *poly = scene->polygon(pickedPolygon);
+			float bestDistance = 0.0f;
+			for (size_t i = 0; i < poly->vertexCount(); i++) {
+				const float *data = poly->vertex(i)->vertex();
+				float dx = data[0] - hit.point[0];
+				float dy = data[1] - hit.point[1];
+				float dz = data[2] - hit.point[2];
+				float distance = dx*dx + dy*dy + dz*dz;
+				if (pickedVertex < 0 || distance < bestDistance) {
+					bestDistance = distance;
+					pickedVertex = poly->vertexIndex(i);
+				}
+			}
+		}
+	}
+
+	emit polygonPicked(pickedPolygon, pickedVertex);
+	updateGL();
+}
+
+void GlWidget::drawPickHighlight()
+{
+	const CPolygon *poly = scene->polygon(pickedPolygon);
+	size_t cv = poly->vertexCount();
+
+	// Draw on top of the object and restore the render mode settings afterwards
+	glPushAttrib(GL_ENABLE_BIT | GL_LINE_BIT | GL_POINT_BIT | GL_CURRENT_BIT);
+	glDisable(GL_LIGHTING);
+	glDisable(GL_DEPTH_TEST);
+
+	glLineWidth(3.0);
+	glColor3f(1, 1, 0);
+	glBegin(GL_LINE_LOOP);
+		for(size_t i=0; i<cv; i++) {
+			glVertex3fv(poly->vertex(i)->vertex());
+		}
+	glEnd();
+
+	if (pickedVertex >= 0) {
+		glPointSize(8.0);
+		glColor3f(1, 0, 1);
+		glBegin(GL_POINTS);
+			glVertex3fv(scene->vertex(pickedVertex)->vertex());
+		glEnd();
+	}
+
+	glPopAttrib();
+}
+
+void GlWidget::drawDefectHighlight()
+{
+	if (!defectEdges) {
+		defectEdges = new GeometryBuffer(createDefectGeometry(RenderGeometry::Lines));
+		defectCorners = new GeometryBuffer(createDefectGeometry(RenderGeometry::Points));
+	}
+
+	glPushAttrib(GL_ENABLE_BIT | GL_LINE_BIT | GL_POINT_BIT | GL_CURRENT_BIT);
+	glDisable(GL_LIGHTING);
+	glDisable(GL_DEPTH_TEST);
+	glColor3f(1, 0, 0);
+
+	glLineWidth(2.0);
+	defectEdges->draw(QVector<int>());
+	glPointSize(6.0);
+	defectCorners->draw(QVector<int>());
+
+	glPopAttrib();
+}
+
+RenderGeometry* GlWidget::createDefectGeometry(RenderGeometry::Primitive primitive) const
+{
+	// Each edge of a polygon is a pair of vertices like GL_LINE_LOOP would draw
+	int vertices = 0;
+	if (primitive == RenderGeometry::Lines) {
+		for (int i = 0; i < defectPolygons.size(); i++) {
+			vertices += 2 * int(scene->polygon(defectPolygons[i])->vertexCount());
+		}
+	} else {
+		vertices = defectVertices.size();
+	}
+
+	RenderGeometry *geometry = new RenderGeometry(primitive, false, false);
+	geometry->allocate(QVector<int>(1, vertices), QVector<int>(1, 0));
+
+	float *positions = geometry->positions();
+	if (primitive == RenderGeometry::Lines) {
+		for (int i = 0; i < defectPolygons.size(); i++) {
+			const CPolygon *poly = scene->polygon(defectPolygons[i]);
+			int cv = int(poly->vertexCount());
+			for (int j = 0; j < cv; j++) {
+				for (int end = 0; end < 2; end++) {
+					const float *point = poly->vertex((j + end) % cv)->vertex();
+					positions[0] = point[0];
+					positions[1] = point[1];
+					positions[2] = point[2];
+					positions += 3;
+				}
+			}
+		}
+	} else {
+		for (int i = 0; i < defectVertices.size(); i++) {
+			const float *point = scene->vertex(defectVertices[i])->vertex();
+			positions[3*i] = point[0];
+			positions[3*i + 1] = point[1];
+			positions[3*i + 2] = point[2];
+		}
+	}
+
+	return geometry;
+}
+
+void GlWidget::releaseDefectGeometry()
+{
+	// The buffers belong to the context of this widget
+	if (defectEdges) {
+		makeCurrent();
+		delete defectEdges;
+		delete defectCorners;
+		defectEdges = nullptr;
+		defectCorners = nullptr;
+	}
+}
+
+void GlWidget::drawSection()
+{
+	glPushAttrib(GL_ENABLE_BIT | GL_LINE_BIT | GL_CURRENT_BIT);
+	glDisable(GL_LIGHTING);
+	glDisable(GL_DEPTH_TEST);
+
+	glLineWidth(2.0);
+	glColor3f(0, 1, 1);
+	for (int i = 0; i < clipSection.polylines.size(); i++) {
+		const MeshSlicer::Polyline & polyline = clipSection.polylines[i];
+		glBegin(polyline.closed ? GL_LINE_LOOP : GL_LINE_STRIP);
+			for (int j = 0; j + 2 < polyline.points.size(); j += 3) {
+				glVertex3fv(polyline.points.constData() + j);
+			}
+		glEnd();
+	}
+
+	glPopAttrib();
+}
+
+RenderGeometry* GlWidget::createSectionGeometry() const
+{
+	int vertices = 0;
+	for (int i = 0; i < clipSection.polylines.size(); i++) {
+		const MeshSlicer::Polyline & polyline = clipSection.polylines[i];
+		int points = polyline.points.size() / 3;
+		vertices += 2 * (polyline.closed ? points : points - 1);
+	}
+
+	RenderGeometry *geometry = new RenderGeometry(RenderGeometry::Lines, false, true);
+	geometry->allocate(QVector<int>(1, vertices), QVector<int>(1, 0));
+
+	float *positions = geometry->positions();
+	for (int i = 0; i < clipSection.polylines.size(); i++) {
+		const MeshSlicer::Polyline & polyline = clipSection.polylines[i];
+		int points = polyline.points.size() / 3;
+		int segments = polyline.closed ? points : points - 1;
+		for (int j = 0; j < segments; j++) {
+			for (int end = 0; end < 2; end++) {
+				const float *point = polyline.points.constData() + 3 * ((j + end) % points);
+				positions[0] = point[0];
+				positions[1] = point[1];
+				positions[2] = point[2];
+				positions += 3;
+			}
+		}
+	}
+
+	for (int i = 0; i < vertices; i++) {
+		RenderGeometry::writeColor(Qt::cyan, geometry->colors() + 4*i);
+	}
+
+	return geometry;
 }
 
 void GlWidget::mouseMoveEvent(QMouseEvent *event)
@@ -126,12 +700,10 @@ void GlWidget::mouseMoveEvent(QMouseEvent *event)
 
 	if (event->buttons() & Qt::LeftButton) {
 		// Left mouse button is pressed: Rotate around x and y
-		xRot += static_cast<float>(dy)/2.0;
-		yRot += static_cast<float>(dx)/2.0;
+		camera.rotate(static_cast<float>(dy)/2.0, static_cast<float>(dx)/2.0);
 	} else if (event->buttons() & Qt::RightButton) {
 		// Right mouse button is pressed: Translate x and y
-		xTrans += (static_cast<double>(dx)/200.0);
-		yTrans += -(static_cast<double>(dy)/200.0);
+		camera.move(static_cast<double>(dx)/200.0, -(static_cast<double>(dy)/200.0));
 	}
 
 	// Remember the last position
@@ -143,10 +715,18 @@ void GlWidget::mouseMoveEvent(QMouseEvent *event)
 
 void GlWidget::wheelEvent(QWheelEvent *event)
 {	
-	if (event->delta() > 0 && scale < 20) {
-		scale += 0.1 * scale;
-	} else if (event->delta() < 0 && scale > 0.1) {
-		scale -= 0.1 * scale;
+	// Each step moves the clipping plane by one percent of the scene diagonal
+	if ((event->modifiers() & Qt::ShiftModifier) && clipPlane >= 0) {
+		if (event->delta() != 0) {
+			moveClippingPlane(event->delta() > 0 ? 0.02f : -0.02f);
+		}
+		return;
+	}
+
+	if (event->delta() > 0) {
+		camera.zoomIn();
+	} else if (event->delta() < 0) {
+		camera.zoomOut();
 	}
 
 	// call update to paint the changes we made here
@@ -172,6 +752,35 @@ void GlWidget::drawAxes()
 	glLineWidth(1.0);
 }
 
+void GlWidget::drawPlanes(int lines, float stepSize, const QColor & c)
+{
+	if (showPlanes[0] && clipPlane != 0) {
+		drawXzPlane(lines, stepSize, c);
+	}
+	if (showPlanes[1] && clipPlane != 1) {
+		drawXyPlane(lines, stepSize, c);
+	}
+	if (showPlanes[2] && clipPlane != 2) {
+		drawYzPlane(lines, stepSize, c);
+	}
+
+	// The clipping plane is shown even if its plane is switched off
+	if (clipPlane >= 0) {
+		float offset[3] = { 0.0f, 0.0f, 0.0f };
+		offset[clippingAxis()] = clipOffset;
+		glPushMatrix();
+		glTranslatef(offset[0], offset[1], offset[2]);
+		if (clipPlane == 0) {
+			drawXzPlane(lines, stepSize, clipPlaneColor);
+		} else if (clipPlane == 1) {
+			drawXyPlane(lines, stepSize, clipPlaneColor);
+		} else {
+			drawYzPlane(lines, stepSize, clipPlaneColor);
+		}
+		glPopMatrix();
+	}
+}
+
 void GlWidget::drawXzPlane(int lines, float stepSize, const QColor & c)
 {
 	glColor3f(c.redF(), c.greenF(), c.blueF());
@@ -219,46 +828,147 @@ void GlWidget::drawYzPlane(int lines, float stepSize, const QColor & c)
 
 void GlWidget::setScene(IScene *scene)
 {
-	this->scene = scene;
-	calculateOffsetAndScale();
+	TRACE_ZONE("GlWidget::setScene");
+	attachScene(scene);
+	camera.frame(scene);
 	reset();
 	updateGL();
 }
 
-void GlWidget::calculateOffsetAndScale()
+void GlWidget::replaceScene(IScene *scene)
+{
+	TRACE_ZONE("GlWidget::replaceScene");
+	attachScene(scene);
+	updateGL();
+}
+
+void GlWidget::attachScene(IScene *scene)
+{
+	detachScene();
+	delete streamer;
+	streamer = nullptr;
+	tileFile = nullptr;
+
+	this->scene = scene;
+	sceneMemory = 0;
+	if (scene) {
+		QApplication::setOverrideCursor(Qt::WaitCursor);
+		if (parkedScenes.contains(scene)) {
+			// Switching back to a retained scene needs no preparation
+			SceneResources resources = parkedScenes.take(scene);
+			bvh = resources.bvh;
+			geometries = resources.geometries;
+			geometryColors = resources.geometryColors;
+			softwareGeometries = resources.softwareGeometries;
+			softwareGeometryColors = resources.softwareGeometryColors;
+		} else {
+			// Large scenes need seconds, the window stays responsive meanwhile
+			const IScene *built = scene;
+			hierarchyWatcher = new QFutureWatcher<SceneBvh*>(this);
+			connect(hierarchyWatcher, SIGNAL(finished()), this, SLOT(finishHierarchy()));
+			hierarchyWatcher->setFuture(QtConcurrent::run([built]() {
+				return new SceneBvh(built);
+			}));
+		}
+		if (overlay) {
+			sceneMemory = scene->memoryReport().total();
+		}
+		QApplication::restoreOverrideCursor();
+	}
+
+	pickedPolygon = -1;
+	pickedVertex = -1;
+	defectPolygons.clear();
+	defectVertices.clear();
+	releaseDefectGeometry();
+	hiddenComponents.clear();
+	hiddenCount = 0;
+	updateSection();
+}
+
+void GlWidget::setDefects(const QVector<int> & polygons, const QVector<int> & vertices)
+{
+	defectPolygons = polygons;
+	defectVertices = vertices;
+	releaseDefectGeometry();
+	updateGL();
+}
+
+const MeshComponents* GlWidget::components() const
 {
-	if (!scene || scene->verticesCount() == 0) {
+	return bvh ? &bvh->components() : nullptr;
+}
+
+void GlWidget::setComponentHidden(int component, bool hidden)
+{
+	if (!bvh || component < 0 || component >= bvh->components().count()) {
 		return;
 	}
+	if (hiddenComponents.isEmpty()) {
+		hiddenComponents.fill(false, bvh->components().count());
+	}
+	if (hiddenComponents[component] != hidden) {
+		hiddenComponents[component] = hidden;
+		hiddenCount += hidden ? 1 : -1;
+	}
 
-	// search the x, y and z min + max values a.k.a bounding box
-	const float *data = scene->vertex(0)->vertex();
-	float maxX = data[0], minX = data[0];
-	float maxY = data[1], minY = data[1];
-	float maxZ = data[2], minZ = data[2];
-	int verticesCount = scene->verticesCount();
-	for(int i=1; i<verticesCount; i++) {
-		data = scene->vertex(i)->vertex();
-		if (data[0] > maxX) { maxX = data[0]; }
-		if (data[0] < minX) { minX = data[0]; }
-		if (data[1] > maxY) { maxY = data[1]; }
-		if (data[1] < minY) { minY = data[1]; }
-		if (data[2] > maxZ) { maxZ = data[2]; }
-		if (data[2] < minZ) { minZ = data[2]; }
+	// The highlight of a hidden polygon would float in the air
+	if (hidden && pickedPolygon >= 0 && bvh->components().componentOf(pickedPolygon) == component) {
+		pickedPolygon = -1;
+		pickedVertex = -1;
 	}
-	
-	// Model dimensions
-	float widthX = maxX-minX;
-	float widthY = maxY-minY;
-	float widthZ = maxZ-minZ;
+	updateSection();
+	updateGL();
+}
+
+void GlWidget::isolateComponent(int component)
+{
+	if (!bvh || component < 0 || component >= bvh->components().count()) {
+		return;
+	}
+	hiddenComponents.fill(true, bvh->components().count());
+	hiddenComponents[component] = false;
+	hiddenCount = hiddenComponents.size() - 1;
+	if (pickedPolygon >= 0 && bvh->components().componentOf(pickedPolygon) != component) {
+		pickedPolygon = -1;
+		pickedVertex = -1;
+	}
+	updateSection();
+	updateGL();
+}
+
+void GlWidget::showAllComponents()
+{
+	hiddenComponents.clear();
+	hiddenCount = 0;
+	updateSection();
+	updateGL();
+}
+
+int GlWidget::hiddenComponentsCount() const
+{
+	return hiddenCount;
+}
+
+int GlWidget::pickedComponent() const
+{
+	return (bvh && pickedPolygon >= 0) ? bvh->components().componentOf(pickedPolygon) : -1;
+}
+
+void GlWidget::setTileFile(TileFile *file)
+{
+	setScene(nullptr);
 
-	// This formula is from the offviwer at http://shape.cs.princeton.edu/benchmark/ 
-	modelScale = 2.0/sqrt(widthX*widthX + widthY*widthY + widthZ*widthZ);
+	tileFile = file;
+	if (tileFile) {
+		// The streamer deletes its buffers, so it needs our context
+		makeCurrent();
+		streamer = new TileStreamer(tileFile, tileMemoryBudget, this);
+		connect(streamer, SIGNAL(tileLoaded()), this, SLOT(updateGL()));
+		camera.frame(tileFile->min(), tileFile->max());
+	}
 
-	// Center coordinates of our model
-	modelOffset[0] = -(maxX-widthX/2.0);
-	modelOffset[1] = -(maxY-widthY/2.0);
-	modelOffset[2] = -(maxZ-widthZ/2.0);
+	updateGL();
 }
 
 void GlWidget::setBackgroundColor(const QColor& c)
@@ -316,6 +1026,73 @@ bool GlWidget::yzPlane()
 	return showPlanes[2];
 }
 
+void GlWidget::setClippingPlane(int plane)
+{
+	if (plane != clipPlane) {
+		clipPlane = plane;
+		clipOffset = 0.0f;
+		updateSection();
+		emit clippingChanged();
+	}
+	updateGL();
+}
+
+int GlWidget::clippingPlane() const
+{
+	return clipPlane;
+}
+
+void GlWidget::moveClippingPlane(float distance)
+{
+	if (clipPlane < 0) {
+		return;
+	}
+
+	clipOffset = qBound(-1.0f, clipOffset + distance, 1.0f);
+	updateSection();
+	emit clippingChanged();
+	updateGL();
+}
+
+int GlWidget::clippingAxis() const
+{
+	// The normals of the XZ, XY and YZ plane
+	const int normals[3] = { 1, 2, 0 };
+	return clipPlane >= 0 ? normals[clipPlane] : -1;
+}
+
+float GlWidget::clippingHeight() const
+{
+	return clipPlane >= 0 ? camera.frameToScene(clippingAxis(), clipOffset) : 0.0f;
+}
+
+const MeshSlicer::Slice& GlWidget::section() const
+{
+	return clipSection;
+}
+
+void GlWidget::clippingEquation(float *equation) const
+{
+	for (int k = 0; k < 4; k++) {
+		equation[k] = 0.0f;
+	}
+	if (clipPlane >= 0) {
+		equation[clippingAxis()] = -1.0f;
+		equation[3] = clippingHeight();
+	}
+}
+
+void GlWidget::updateSection()
+{
+	clipSection = MeshSlicer::Slice();
+	clipSection.height = clippingHeight();
+	if (clipPlane >= 0 && scene && bvh) {
+		MeshSlicer slicer(scene, bvh);
+		clipSection = slicer.slice(clippingAxis(), clipSection.height,
+			hiddenCount > 0 ? &hiddenComponents : nullptr);
+	}
+}
+
 void GlWidget::setAxes(bool status)
 {
 	showAxes = status;
@@ -334,20 +1111,18 @@ void GlWidget::reset()
 	showPlanes[0] = true;
 	showPlanes[1] = false;
 	showPlanes[2] = false;
+	clipPlane = -1;
+	clipOffset = 0.0f;
+	clipSection = MeshSlicer::Slice();
 
 	// Reset the colors
 	color = QColor(160, 160, 160);
 	bgColor = QColor("black");
 	planeColor = QColor(100, 100, 100);
+	clipPlaneColor = QColor(0, 140, 140);
 
 	// Reset scale, rotation and translation values
-	scale = 1.0f;
-
-	xRot = 0.0f;
-	yRot = 0.0f;
-
-	xTrans = 0.0f;
-	yTrans = 0.0f;
+	camera.reset();
 	
 	updateGL();
 }
@@ -388,3 +1163,352 @@ QString GlWidget::renderModeName()
 {
 	return renderModes[activeMode]->name();
 }
+
+const GlWidget::CullingStats& GlWidget::cullingStats() const
+{
+	return stats;
+}
+
+void GlWidget::setSoftwareRendering(bool status)
+{
+	if (useSoftware != status) {
+		useSoftware = status;
+		emit softwareRenderingChanged(status);
+	}
+	updateGL();
+}
+
+bool GlWidget::softwareRendering()
+{
+	return useSoftware;
+}
+
+void GlWidget::setPerformanceOverlay(bool status)
+{
+	if (status && !overlay) {
+		overlay = new PerformanceOverlay();
+		sceneMemory = scene ? scene->memoryReport().total() : 0;
+
+		// Timer queries need OpenGL 3.3 or GL_ARB_timer_query
+		makeCurrent();
+		gpuTimer = new QOpenGLTimerQuery();
+		if (!gpuTimer->create()) {
+			delete gpuTimer;
+			gpuTimer = nullptr;
+		}
+		gpuTimerPending = false;
+	} else if (!status && overlay) {
+		delete overlay;
+		overlay = nullptr;
+		makeCurrent();
+		delete gpuTimer;
+		gpuTimer = nullptr;
+		gpuTimerPending = false;
+	}
+	updateGL();
+}
+
+bool GlWidget::performanceOverlay()
+{
+	return overlay != nullptr;
+}
+
+MemoryReport GlWidget::memoryReport() const
+{
+	MemoryReport report;
+	if (scene) {
+		report = scene->memoryReport();
+	}
+	if (bvh) {
+		report.add(MemoryReport::Caches, bvh->bytes());
+	}
+	for (int i = 0; i < geometries.size(); i++) {
+		if (geometries[i]) {
+			report.add(MemoryReport::GpuMirrors, geometries[i]->mainMemoryBytes());
+		}
+		if (softwareGeometries[i]) {
+			report.add(MemoryReport::GpuMirrors, softwareGeometries[i]->bytes());
+		}
+	}
+	return report;
+}
+
+GeometryBuffer* GlWidget::activeGeometry()
+{
+	IRenderMode *mode = renderModes[activeMode];
+	GeometryBuffer *&geometry = geometries[activeMode];
+
+	// Colored geometry needs to be created again after a color change
+	if (geometry && mode->geometryUsesDefaultColor() && geometryColors[activeMode] != color) {
+		delete geometry;
+		geometry = nullptr;
+	}
+
+	if (!geometry) {
+		QApplication::setOverrideCursor(Qt::WaitCursor);
+		RenderGeometry *data = mode->createGeometry(scene, bvh, &color);
+		GeometryBuffer *&spare = spareGeometries[activeMode];
+		if (spare && spare->rewrite(data)) {
+			geometry = spare;
+		} else {
+			delete spare;
+			geometry = new GeometryBuffer(data);
+		}
+		spare = nullptr;
+		geometryColors[activeMode] = color;
+		QApplication::restoreOverrideCursor();
+	}
+
+	return geometry;
+}
+
+const RenderGeometry* GlWidget::activeSoftwareGeometry()
+{
+	IRenderMode *mode = renderModes[activeMode];
+	RenderGeometry *&geometry = softwareGeometries[activeMode];
+
+	if (geometry && mode->geometryUsesDefaultColor() && softwareGeometryColors[activeMode] != color) {
+		delete geometry;
+		geometry = nullptr;
+	}
+
+	if (!geometry) {
+		QApplication::setOverrideCursor(Qt::WaitCursor);
+		geometry = mode->createGeometry(scene, bvh, &color);
+		softwareGeometryColors[activeMode] = color;
+		QApplication::restoreOverrideCursor();
+	}
+
+	return geometry;
+}
+
+void GlWidget::releaseGeometries()
+{
+	// The buffers belong to the context of this widget
+	makeCurrent();
+	for (int i = 0; i < geometries.size(); i++) {
+		delete geometries[i];
+		geometries[i] = nullptr;
+		delete softwareGeometries[i];
+		softwareGeometries[i] = nullptr;
+	}
+	releaseSpareGeometries();
+}
+
+void GlWidget::releaseSpareGeometries()
+{
+	makeCurrent();
+	for (int i = 0; i < previousGeometries.size(); i++) {
+		delete previousGeometries[i];
+		previousGeometries[i] = nullptr;
+		delete spareGeometries[i];
+		spareGeometries[i] = nullptr;
+	}
+}
+
+qint64 GlWidget::spareGeometryBytes() const
+{
+	qint64 bytes = 0;
+	for (int i = 0; i < previousGeometries.size(); i++) {
+		if (previousGeometries[i]) {
+			bytes += previousGeometries[i]->bytes();
+		}
+		if (spareGeometries[i]) {
+			bytes += spareGeometries[i]->bytes();
+		}
+	}
+	return bytes;
+}
+
+void GlWidget::detachScene()
+{
+	waitForHierarchy();
+	if (scene && retainedScenes.contains(scene)) {
+		SceneResources resources;
+		resources.bvh = bvh;
+		resources.geometries = geometries;
+		resources.geometryColors = geometryColors;
+		resources.softwareGeometries = softwareGeometries;
+		resources.softwareGeometryColors = softwareGeometryColors;
+		parkedScenes.insert(scene, resources);
+		geometries.fill(nullptr);
+		softwareGeometries.fill(nullptr);
+		releaseSpareGeometries();
+	} else {
+		releaseGeometries();
+		delete bvh;
+	}
+	bvh = nullptr;
+}
+
+void GlWidget::releaseResources(SceneResources* resources)
+{
+	makeCurrent();
+	for (int i = 0; i < resources->geometries.size(); i++) {
+		delete resources->geometries[i];
+		delete resources->softwareGeometries[i];
+	}
+	resources->geometries.clear();
+	resources->softwareGeometries.clear();
+	delete resources->bvh;
+	resources->bvh = nullptr;
+}
+
+void GlWidget::setSceneRetained(const IScene* scene, bool retained)
+{
+	if (retained) {
+		retainedScenes.insert(scene);
+		return;
+	}
+
+	retainedScenes.remove(scene);
+	if (parkedScenes.contains(scene)) {
+		SceneResources resources = parkedScenes.take(scene);
+		releaseResources(&resources);
+	}
+}
+
+void GlWidget::updateSceneVertices(const IScene* scene)
+{
+	TRACE_ZONE("GlWidget::updateSceneVertices");
+	if (scene && scene == this->scene) {
+		// The buffers of the last two updates alternate, so the new
+		// vertices are never written into a buffer that the graphics
+		// card may still draw for the previous frame
+		makeCurrent();
+		for (int i = 0; i < geometries.size(); i++) {
+			delete spareGeometries[i];
+			spareGeometries[i] = previousGeometries[i];
+			previousGeometries[i] = geometries[i];
+			geometries[i] = nullptr;
+			delete softwareGeometries[i];
+			softwareGeometries[i] = nullptr;
+		}
+		waitForHierarchy();
+		bvh->refit();
+		releaseDefectGeometry();
+		updateSection();
+		if (overlay) {
+			sceneMemory = scene->memoryReport().total();
+		}
+		updateGL();
+		return;
+	}
+
+	auto it = parkedScenes.find(scene);
+	if (it != parkedScenes.end()) {
+		makeCurrent();
+		for (int i = 0; i < it->geometries.size(); i++) {
+			delete it->geometries[i];
+			it->geometries[i] = nullptr;
+			delete it->softwareGeometries[i];
+			it->softwareGeometries[i] = nullptr;
+		}
+		it->bvh->refit();
+	}
+}
+
+void GlWidget::setPreparedHierarchy(const IScene* scene, SceneBvh* hierarchy)
+{
+	if (!hierarchy || !retainedScenes.contains(scene) || scene == this->scene ||
+			parkedScenes.contains(scene)) {
+		delete hierarchy;
+		return;
+	}
+
+	SceneResources resources;
+	resources.bvh = hierarchy;
+	resources.geometries.fill(nullptr, renderModes.size());
+	resources.geometryColors.resize(renderModes.size());
+	resources.softwareGeometries.fill(nullptr, renderModes.size());
+	resources.softwareGeometryColors.resize(renderModes.size());
+	parkedScenes.insert(scene, resources);
+}
+
+void GlWidget::waitForHierarchy()
+{
+	if (hierarchyWatcher) {
+		hierarchyWatcher->waitForFinished();
+		takeHierarchy();
+	}
+}
+
+void GlWidget::finishHierarchy()
+{
+	if (hierarchyWatcher) {
+		takeHierarchy();
+		updateSection();
+		updateGL();
+	}
+}
+
+void GlWidget::takeHierarchy()
+{
+	bvh = hierarchyWatcher->result();
+	// This may be called by the watcher itself
+	hierarchyWatcher->disconnect(this);
+	hierarchyWatcher->deleteLater();
+	hierarchyWatcher = nullptr;
+}
+
+void GlWidget::releaseSceneBuffers(const IScene* scene)
+{
+	auto it = parkedScenes.find(scene);
+	if (it == parkedScenes.end()) {
+		return;
+	}
+
+	// The software geometry stays, it is only in main memory
+	makeCurrent();
+	for (int i = 0; i < it->geometries.size(); i++) {
+		delete it->geometries[i];
+		it->geometries[i] = nullptr;
+	}
+}
+
+qint64 GlWidget::sceneGpuBytes(const IScene* scene) const
+{
+	const QVector<GeometryBuffer*> *buffers = &geometries;
+	if (scene != this->scene) {
+		auto it = parkedScenes.constFind(scene);
+		if (it == parkedScenes.constEnd()) {
+			return 0;
+		}
+		buffers = &it->geometries;
+	}
+
+	qint64 bytes = (scene == this->scene) ? spareGeometryBytes() : 0;
+	for (int i = 0; i < buffers->size(); i++) {
+		if (buffers->at(i)) {
+			bytes += buffers->at(i)->bytes();
+		}
+	}
+	return bytes;
+}
+
+qint64 GlWidget::sceneCacheBytes(const IScene* scene) const
+{
+	const SceneBvh *sceneBvh = bvh;
+	const QVector<GeometryBuffer*> *buffers = &geometries;
+	const QVector<RenderGeometry*> *mirrors = &softwareGeometries;
+	if (scene != this->scene) {
+		auto it = parkedScenes.constFind(scene);
+		if (it == parkedScenes.constEnd()) {
+			return 0;
+		}
+		sceneBvh = it->bvh;
+		buffers = &it->geometries;
+		mirrors = &it->softwareGeometries;
+	}
+
+	qint64 bytes = sceneBvh ? sceneBvh->bytes() : 0;
+	for (int i = 0; i < buffers->size(); i++) {
+		if (buffers->at(i)) {
+			bytes += buffers->at(i)->mainMemoryBytes();
+		}
+		if (mirrors->at(i)) {
+			bytes += mirrors->at(i)->bytes();
+		}
+	}
+	return bytes;
+}
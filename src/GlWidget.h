@@ -2,9 +2,19 @@
 
 #include <QtCore>
 #include <QtOpenGL>
+#include <QOpenGLTimerQuery>
+#include <QFutureWatcher>
 
 #include "IScene.h"
 #include "IRenderMode.h"
+#include "SceneBvh.h"
+#include "MeshSlicer.h"
+#include "GeometryBuffer.h"
+#include "TileFile.h"
+#include "TileStreamer.h"
+#include "SoftwareRenderer.h"
+#include "Camera.h"
+#include "PerformanceOverlay.h"
 
 /**
  * @brief Qt widget that can display an IScene object with OpenGL
@@ -22,6 +32,17 @@ class GlWidget : public QGLWidget
 Q_OBJECT
 
 public:
+	/**
+	 * @brief Results of the view frustum culling for the last drawn frame.
+	 */
+	struct CullingStats
+	{
+		int drawnChunks;
+		int culledChunks;
+		qint64 drawnTriangles;
+		qint64 culledTriangles;
+	};
+
 	/**
 	 * @brief Constructor of class GlWidget that holds the OpenGL scence.
 	 */
@@ -36,6 +57,70 @@ public:
 	 * @brief Sets the object that is rendered.
 	 */
 	void setScene(IScene* scene);
+
+	/**
+	 * @brief Replaces the current scene with a reloaded version of it.
+	 *
+	 * Same as setScene(), but the view and the colors are kept.
+	 */
+	void replaceScene(IScene* scene);
+
+	/**
+	 * @brief Highlights defective polygons and vertices of the scene.
+	 *
+	 * The highlight is removed when another scene is set.
+	 *
+	 * @param[in] polygons Indices of the polygons, drawn as red outlines.
+	 * @param[in] vertices Indices of the vertices, drawn as red points.
+	 *
+	 * @see MeshValidator
+	 */
+	void setDefects(const QVector<int> & polygons, const QVector<int> & vertices);
+
+	/**
+	 * @brief Returns the connected components of the current scene or null.
+	 */
+	const MeshComponents* components() const;
+
+	/**
+	 * @brief Hides or shows a connected component of the current scene.
+	 *
+	 * The parts of hidden components are left out of the drawn ranges and
+	 * their polygons cannot be picked. The geometry is not created again.
+	 * All components are visible again when another scene is set.
+	 *
+	 * @param[in] component Number of the component.
+	 * @param[in] hidden Hide the component?
+	 */
+	void setComponentHidden(int component, bool hidden);
+
+	/**
+	 * @brief Hides all components of the current scene except one.
+	 */
+	void isolateComponent(int component);
+
+	/**
+	 * @brief Shows all components of the current scene.
+	 */
+	void showAllComponents();
+
+	/**
+	 * @brief Returns the number of hidden components.
+	 */
+	int hiddenComponentsCount() const;
+
+	/**
+	 * @brief Returns the component of the picked polygon or -1.
+	 */
+	int pickedComponent() const;
+
+	/**
+	 * @brief Sets a tiled scene that is streamed from the disk.
+	 *
+	 * Replaces the current scene. The tiles are drawn with the active
+	 * render mode in the style of its primitive type.
+	 */
+	void setTileFile(TileFile* file);
 	
 	/**
 	 * @brief Sets the background color.
@@ -87,6 +172,46 @@ public:
 	 */
 	bool yzPlane();
 	
+	/**
+	 * @brief Cuts the scene with one of the planes.
+	 *
+	 * The part of the scene above the plane is not drawn and cannot be
+	 * picked, the section of the plane with the scene is drawn as outline.
+	 * The plane starts at the origin of the view.
+	 *
+	 * @param[in] plane 0 for the XZ, 1 for the XY and 2 for the YZ plane or -1 to show the whole scene.
+	 */
+	void setClippingPlane(int plane);
+
+	/**
+	 * @brief Returns the plane that cuts the scene or -1.
+	 */
+	int clippingPlane() const;
+
+	/**
+	 * @brief Moves the clipping plane along its normal.
+	 *
+	 * The plane stays inside of the framed scene.
+	 *
+	 * @param[in] distance Distance in the units of the view, 1 is half the diagonal of the scene.
+	 */
+	void moveClippingPlane(float distance);
+
+	/**
+	 * @brief Returns the position of the clipping plane on its axis in scene coordinates.
+	 */
+	float clippingHeight() const;
+
+	/**
+	 * @brief Returns the axis of the scene the clipping plane is orthogonal to or -1.
+	 */
+	int clippingAxis() const;
+
+	/**
+	 * @brief Returns the polylines where the clipping plane cuts the scene.
+	 */
+	const MeshSlicer::Slice& section() const;
+
 	/**
 	 * @brief Enabled/disables the XYZ axes.
 	 */
@@ -131,6 +256,128 @@ public:
 	 * @brief Resets the camera, zoom, colors axes and planes to their default values.
 	 */
 	void reset();
+
+	/**
+	 * @brief Returns how many chunks of the scene were skipped in the last frame.
+	 */
+	const CullingStats& cullingStats() const;
+
+	/**
+	 * @brief Enables/disables drawing with the SoftwareRenderer instead of OpenGL.
+	 *
+	 * Is enabled automatically if the OpenGL driver is too old or a slow
+	 * software implementation. Tiled scenes are always drawn with OpenGL.
+	 */
+	void setSoftwareRendering(bool status);
+
+	/**
+	 * @brief Returns true if the SoftwareRenderer is used.
+	 */
+	bool softwareRendering();
+
+	/**
+	 * @brief Shows/hides the frame times and counters in the corner of the view.
+	 *
+	 * Nothing is measured while the overlay is hidden.
+	 */
+	void setPerformanceOverlay(bool status);
+
+	/**
+	 * @brief Returns true if the performance overlay is visible.
+	 */
+	bool performanceOverlay();
+
+	/**
+	 * @brief Returns the main memory used by the scene and the widget.
+	 *
+	 * Adds the polygon hierarchy and the render geometry kept in main
+	 * memory to the report of the scene.
+	 */
+	MemoryReport memoryReport() const;
+
+	/**
+	 * @brief Keeps the render data of a scene when another scene is set.
+	 *
+	 * The polygon hierarchy and the geometry of a retained scene are put
+	 * aside by setScene() and used again when the scene is set the next
+	 * time, so switching back to it needs no preparation. Releasing a
+	 * scene deletes the data that was put aside. The scene itself is
+	 * still owned by the caller, see SceneCache.
+	 *
+	 * @param [in] scene The scene
+	 * @param [in] retained Keep the data of the scene?
+	 */
+	void setSceneRetained(const IScene* scene, bool retained);
+
+	/**
+	 * @brief Updates the render data after the vertices of a scene changed.
+	 *
+	 * The polygons and their vertices must be the same, only positions,
+	 * normals and colors may have changed. The polygon hierarchy is
+	 * refitted and the geometry is created again when it is drawn. For
+	 * the current scene, the new geometry is written into the buffers of
+	 * the update before the last one, so a scene that is updated every
+	 * frame does not allocate new buffers.
+	 */
+	void updateSceneVertices(const IScene* scene);
+
+	/**
+	 * @brief Takes a polygon hierarchy that was built in the background.
+	 *
+	 * The hierarchy is used when the retained scene is set the next time.
+	 * The widget deletes it if the scene is not retained, is the current
+	 * scene or already has one.
+	 */
+	void setPreparedHierarchy(const IScene* scene, SceneBvh* hierarchy);
+
+	/**
+	 * @brief Waits until the polygon hierarchy of the current scene is built.
+	 *
+	 * The hierarchy of a scene that was not prepared is built in the
+	 * background, the scene is drawn when it is done. Call this before
+	 * the vertices or polygons of the current scene change.
+	 */
+	void waitForHierarchy();
+
+	/**
+	 * @brief Deletes the vertex buffers that were put aside for a scene.
+	 *
+	 * Frees graphics memory, the buffers are uploaded again when the
+	 * scene is drawn. Does nothing for the current scene.
+	 */
+	void releaseSceneBuffers(const IScene* scene);
+
+	/**
+	 * @brief Returns the graphics memory used by the vertex buffers of a scene.
+	 */
+	qint64 sceneGpuBytes(const IScene* scene) const;
+
+	/**
+	 * @brief Returns the main memory used by the widget for a scene.
+	 *
+	 * Counts the polygon hierarchy and the geometry kept in main memory,
+	 * but not the scene itself.
+	 */
+	qint64 sceneCacheBytes(const IScene* scene) const;
+
+signals:
+	/**
+	 * @brief Emitted after the user clicked on the scene.
+	 *
+	 * @param polygon Index of the polygon under the mouse or -1 if nothing was hit.
+	 * @param vertex Index of the polygon vertex closest to the click or -1.
+	 */
+	void polygonPicked(int polygon, int vertex);
+
+	/**
+	 * @brief Emitted when the software rendering was enabled or disabled.
+	 */
+	void softwareRenderingChanged(bool status);
+
+	/**
+	 * @brief Emitted after the clipping plane was selected or moved.
+	 */
+	void clippingChanged();
 	
 protected:
 	/**
@@ -157,12 +404,25 @@ protected:
 	 *	@brief Processes mouse move events of the GlWidget for rotation and translation.
 	 */
 	void mouseMoveEvent(QMouseEvent *event) override;
+
+	/**
+	 *	@brief Processes mouse release events of the GlWidget for picking.
+	 */
+	void mouseReleaseEvent(QMouseEvent *event) override;
 	
 	/**
 	 *	@brief Processes mouse wheel events of the GlWidget for zooming
+	 *
+	 * With the shift key the clipping plane is moved instead.
 	 */
 	void wheelEvent(QWheelEvent *event) override;
 
+private slots:
+	/**
+	 * @brief Draws the current scene once its polygon hierarchy is built.
+	 */
+	void finishHierarchy();
+
 private:
 	// Do not allow copy constructor and the assignment operator
 	GlWidget(const GlWidget & other);
@@ -189,12 +449,263 @@ private:
 	void drawYzPlane(int lines, float stepSize, const QColor & c);
 
 	/**
-	 * @brief Calculate the model offset and scale values.
+	 * @brief Draws the planes to the OpenGL context, the clipping plane at its position.
+	 */
+	void drawPlanes(int lines, float stepSize, const QColor & c);
+
+	/**
+	 * @brief Draws the outline of the section with the clipping plane.
+	 */
+	void drawSection();
+
+	/**
+	 * @brief Returns the plane equation of the clipping plane in scene coordinates.
 	 *
-	 * The values calculated here are used by paintGL() to center our model
-	 * and scale it so it fits the window.
+	 * The equation is positive for the part of the scene which is drawn.
+	 */
+	void clippingEquation(float *equation) const;
+
+	/**
+	 * @brief Cuts the visible components with the clipping plane again.
+	 */
+	void updateSection();
+
+	/**
+	 * @brief Creates the lines of the section for the SoftwareRenderer.
+	 */
+	RenderGeometry* createSectionGeometry() const;
+
+	/**
+	 * @brief Draws the frame with the SoftwareRenderer and copies it to the context.
+	 */
+	void paintSoftware();
+
+	/**
+	 * @brief Draws the frame, paintGL() adds the measurements around it.
+	 */
+	void paintFrame();
+
+	/**
+	 * @brief Measures the frame and draws the performance overlay.
+	 */
+	void paintMeasuredFrame();
+
+	/**
+	 * @brief Returns the number of vertices submitted in the last frame.
+	 */
+	qint64 submittedVertices() const;
+
+	/**
+	 * @brief Returns the size of all vertex buffers in graphics memory.
+	 */
+	qint64 gpuMemoryUsage() const;
+
+	/**
+	 * @brief Creates the lines of the coordinate axes for the SoftwareRenderer.
+	 */
+	RenderGeometry* createAxesGeometry() const;
+
+	/**
+	 * @brief Creates the lines of all visible planes for the SoftwareRenderer.
 	 */
-	void calculateOffsetAndScale();
+	RenderGeometry* createPlanesGeometry(int lines, float stepSize, const QColor & c) const;
+
+	/**
+	 * @brief Culls the chunks of the scene and updates the culling statistics.
+	 *
+	 * The chunks above the clipping plane count as culled, the triangles
+	 * of hidden components too. A chunk whose parts are all hidden is not
+	 * drawn.
+	 */
+	void cullScene();
+
+	/**
+	 * @brief Returns the projection matrix of the camera for the widget size.
+	 */
+	QMatrix4x4 projectionMatrix() const;
+
+	/**
+	 * @brief Selects the polygon below a point of the widget.
+	 *
+	 * The point is unprojected with the current transformations and the
+	 * resulting ray is cast into the polygon hierarchy of the scene.
+	 * Emits polygonPicked() with the result.
+	 */
+	void pick(const QPoint & pos);
+
+	/**
+	 * @brief Draws the outline of the picked polygon and its picked vertex.
+	 */
+	void drawPickHighlight();
+
+	/**
+	 * @brief Draws the outlines of the defective polygons and the defective vertices.
+	 *
+	 * The geometry is uploaded at the first frame and kept until the
+	 * defects change or the vertices move.
+	 */
+	void drawDefectHighlight();
+
+	/**
+	 * @brief Creates the outlines of the defective polygons or the defective vertices.
+	 *
+	 * @param [in] primitive Lines for the polygons, Points for the vertices
+	 */
+	RenderGeometry* createDefectGeometry(RenderGeometry::Primitive primitive) const;
+
+	/**
+	 * @brief Frees the uploaded geometry of the defects.
+	 */
+	void releaseDefectGeometry();
+
+	/**
+	 * @brief Returns the uploaded geometry of the active render mode.
+	 *
+	 * The geometry is created on first use and again after the object
+	 * color changed, if the render mode uses it.
+	 */
+	GeometryBuffer* activeGeometry();
+
+	/**
+	 * @brief Returns the geometry of the active render mode for the SoftwareRenderer.
+	 *
+	 * Same as activeGeometry(), but the geometry stays in main memory.
+	 */
+	const RenderGeometry* activeSoftwareGeometry();
+
+	/**
+	 * @brief Deletes the geometry of all render modes.
+	 */
+	void releaseGeometries();
+
+	/**
+	 * @brief Deletes the buffers kept by updateSceneVertices().
+	 */
+	void releaseSpareGeometries();
+
+	/**
+	 * @brief Returns the size of the buffers kept by updateSceneVertices().
+	 */
+	qint64 spareGeometryBytes() const;
+
+	/**
+	 * @brief Render data of a retained scene that is not displayed.
+	 */
+	struct SceneResources
+	{
+		SceneBvh* bvh;
+		QVector<GeometryBuffer*> geometries;
+		QVector<QColor> geometryColors;
+		QVector<RenderGeometry*> softwareGeometries;
+		QVector<QColor> softwareGeometryColors;
+	};
+
+	/**
+	 * @brief Makes a scene the current scene without changing the view.
+	 */
+	void attachScene(IScene* scene);
+
+	/**
+	 * @brief Puts the render data of the current scene aside or deletes it.
+	 */
+	void detachScene();
+
+	/**
+	 * @brief Makes the finished background build the hierarchy of the current scene.
+	 */
+	void takeHierarchy();
+
+	/**
+	 * @brief Deletes render data that was put aside.
+	 */
+	void releaseResources(SceneResources* resources);
+
+	/**
+	 * @brief Scenes whose render data is kept by setScene().
+	 */
+	QSet<const IScene*> retainedScenes;
+
+	/**
+	 * @brief Render data of the retained scenes that are not displayed.
+	 */
+	QHash<const IScene*, SceneResources> parkedScenes;
+
+	/**
+	 * @brief Uploaded geometry for each render mode or null.
+	 */
+	QVector<GeometryBuffer*> geometries;
+
+	/**
+	 * @brief The object color each geometry was created with.
+	 */
+	QVector<QColor> geometryColors;
+
+	/**
+	 * @brief Geometry of the current scene before the last update or null.
+	 *
+	 * The graphics card may still draw it, so it is not rewritten yet.
+	 */
+	QVector<GeometryBuffer*> previousGeometries;
+
+	/**
+	 * @brief Geometry of the update before, which activeGeometry() rewrites, or null.
+	 */
+	QVector<GeometryBuffer*> spareGeometries;
+
+	/**
+	 * @brief Geometry for the SoftwareRenderer for each render mode or null.
+	 */
+	QVector<RenderGeometry*> softwareGeometries;
+
+	/**
+	 * @brief The object color each software geometry was created with.
+	 */
+	QVector<QColor> softwareGeometryColors;
+
+	/**
+	 * @brief Draws the frames if software rendering is enabled.
+	 */
+	SoftwareRenderer softwareRenderer;
+
+	/**
+	 * @brief Is the SoftwareRenderer used instead of OpenGL?
+	 */
+	bool useSoftware;
+
+	/**
+	 * @brief Measurements of the performance overlay or null if it is hidden.
+	 */
+	PerformanceOverlay *overlay;
+
+	/**
+	 * @brief Measures the GPU time of a frame, null if not supported.
+	 */
+	QOpenGLTimerQuery *gpuTimer;
+
+	/**
+	 * @brief Was the timer query started and its result not read yet?
+	 */
+	bool gpuTimerPending;
+
+	/**
+	 * @brief Memory usage of the scene, updated with the overlay.
+	 */
+	qint64 sceneMemory;
+
+	/**
+	 * @brief Chunks inside of the view frustum.
+	 */
+	QVector<int> visibleChunks;
+
+	/**
+	 * @brief The drawn parts of the visible chunks.
+	 */
+	QVector<int> visibleParts;
+
+	/**
+	 * @brief Culling results of the last frame.
+	 */
+	CullingStats stats;
 
 	/**
 	 * @brief Holds all available render modes.
@@ -229,6 +740,77 @@ private:
 	 */
 	IScene* scene;
 
+	/**
+	 * @brief The active tiled scene or null.
+	 */
+	TileFile* tileFile;
+
+	/**
+	 * @brief Loads the tiles of the tiled scene.
+	 */
+	TileStreamer* streamer;
+
+	/**
+	 * @brief Tiles selected for the current frame.
+	 */
+	QVector<const GeometryBuffer*> visibleTiles;
+
+	/**
+	 * @brief Graphics memory available for the tiles of a tiled scene.
+	 */
+	static const qint64 tileMemoryBudget = 512 * 1024 * 1024;
+
+	/**
+	 * @brief Polygon hierarchy of the current scene, used for culling and picking.
+	 */
+	SceneBvh* bvh;
+
+	/**
+	 * @brief Builds the hierarchy of the current scene, null if no build is running.
+	 */
+	QFutureWatcher<SceneBvh*>* hierarchyWatcher;
+
+	/**
+	 * @brief Index of the picked polygon or -1.
+	 */
+	int pickedPolygon;
+
+	/**
+	 * @brief Index of the picked vertex or -1.
+	 */
+	int pickedVertex;
+
+	/**
+	 * @brief Indices of the highlighted defective polygons.
+	 */
+	QVector<int> defectPolygons;
+
+	/**
+	 * @brief Indices of the highlighted defective vertices.
+	 */
+	QVector<int> defectVertices;
+
+	/**
+	 * @brief The uploaded outlines of defectPolygons and defectVertices or null.
+	 */
+	GeometryBuffer* defectEdges;
+	GeometryBuffer* defectCorners;
+
+	/**
+	 * @brief Is each component of the scene hidden? Empty if all are visible.
+	 */
+	QVector<bool> hiddenComponents;
+
+	/**
+	 * @brief Number of hidden components.
+	 */
+	int hiddenCount;
+
+	/**
+	 * @brief Position where the last mouse button was pressed.
+	 */
+	QPoint pressPos;
+
 	/**
 	 * @brief Last Position where a mouse event happend.
 	 */
@@ -244,6 +826,11 @@ private:
 	 */
 	QColor planeColor;
 
+	/**
+	 * @brief Line color of the clipping plane.
+	 */
+	QColor clipPlaneColor;
+
 	/**
 	 * @brief Color of the object.
 	 */
@@ -260,39 +847,22 @@ private:
 	bool showPlanes[3]; // XZ, XY, ZY
 
 	/**
-	 * @brief Value for the model scale.
+	 * @brief The plane that cuts the scene, in the order of showPlanes, or -1.
 	 */
-	float scale;
+	int clipPlane;
 
 	/**
-	 * @brief Value for moving the model along the X axis of the screen.
+	 * @brief Position of the clipping plane along its normal in the units of the view.
 	 */
-	float xTrans;
+	float clipOffset;
 
 	/**
-	 * @brief Value for moving the model along the Y axis of the screen.
-	 */
-	float yTrans;
-
-	/**
-	 * @brief Value for rotating the model around the vertical axis of the screen.
-	 */
-	float xRot;
-	
-	/**
-	 * @brief Value for rotating the model around the horizontal axis of the screen.
+	 * @brief Outline of the scene at the clipping plane.
 	 */
-	float yRot;
+	MeshSlicer::Slice clipSection;
 
 	/**
-	 * @brief The offset values which are needed to center our model.
-	 * @see calculateOffsetAndScale()
-	 */
-	float modelOffset[3];
-	
-	/**
-	 * @brief The scale value which is needed to fit our model to the camera.
-	 * @see	calculateOffsetAndScale()
+	 * @brief Rotation, translation and zoom of the view and the scene framing.
 	 */
-	float modelScale;
+	Camera camera;
 };
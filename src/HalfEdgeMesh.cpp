@@ -0,0 +1,141 @@
+#include "HalfEdgeMesh.h"
+#include "Parallel.h"
+#include "Trace.h"
+
+HalfEdgeMesh::HalfEdgeMesh(const IScene *scene)
+{
+	TRACE_ZONE("HalfEdgeMesh::HalfEdgeMesh");
+	int pCount = scene->polygonsCount();
+	int vCount = scene->verticesCount();
+
+	faceStarts.resize(pCount + 1);
+	faceStarts[0] = 0;
+	for (int f = 0; f < pCount; f++) {
+		faceStarts[f + 1] = faceStarts[f] + int(scene->polygon(f)->vertexCount());
+	}
+	int count = faceStarts[pCount];
+
+	origins.resize(count);
+	faces.resize(count);
+	twins.resize(count);
+	QVector<EdgeKey> keys(count);
+	Parallel::forBlocks(pCount, 1 << 12, [&](int begin, int end) {
+		for (int f = begin; f < end; f++) {
+			const CPolygon *polygon = scene->polygon(f);
+			int n = int(polygon->vertexCount());
+			for (int j = 0; j < n; j++) {
+				int h = faceStarts[f] + j;
+				int a = polygon->vertexIndex(j);
+				int b = polygon->vertexIndex((j + 1) % n);
+				origins[h] = a;
+				faces[h] = f;
+				keys[h].key = a == b ? noKey : quint64(qMin(a, b)) << 32 | quint32(qMax(a, b));
+				keys[h].halfEdge = h;
+			}
+		}
+	});
+
+	// The half-edges of an edge follow each other
+	Parallel::sort(keys, [](const EdgeKey & a, const EdgeKey & b) {
+		return a.key < b.key || (a.key == b.key && a.halfEdge < b.halfEdge);
+	});
+
+	// A thread handles the runs that start in its block, even if they end behind it
+	const int minBlockSize = 1 << 14;
+	int blocks = Parallel::blockCount(count, minBlockSize);
+	QVector<int> blockEdges(blocks, 0);
+	QVector<int> blockBoundary(blocks, 0);
+	QVector<int> blockNonManifold(blocks, 0);
+	Parallel::forEachBlock(count, minBlockSize, [&](int block, int begin, int end) {
+		for (int k = begin; k < end; k++) {
+			quint64 key = keys[k].key;
+			if (key == noKey) {
+				twins[keys[k].halfEdge] = nonManifold;
+				blockNonManifold[block]++;
+				continue;
+			}
+			if (k > 0 && keys[k - 1].key == key) {
+				continue;
+			}
+			int last = k + 1;
+			while (last < count && keys[last].key == key) {
+				last++;
+			}
+
+			blockEdges[block]++;
+			int first = keys[k].halfEdge;
+			if (last - k == 1) {
+				twins[first] = none;
+				blockBoundary[block]++;
+			} else if (last - k == 2 && origins[first] != origins[keys[k + 1].halfEdge]) {
+				int second = keys[k + 1].halfEdge;
+				twins[first] = second;
+				twins[second] = first;
+			} else {
+				for (int m = k; m < last; m++) {
+					twins[keys[m].halfEdge] = nonManifold;
+				}
+				blockNonManifold[block] += last - k;
+			}
+		}
+	});
+	keys = QVector<EdgeKey>();
+
+	edges = 0;
+	boundaryHalfEdges = 0;
+	nonManifoldHalfEdges = 0;
+	for (int b = 0; b < blocks; b++) {
+		edges += blockEdges[b];
+		boundaryHalfEdges += blockBoundary[b];
+		nonManifoldHalfEdges += blockNonManifold[b];
+	}
+
+	// Half-edges without twin come first, so the walks around boundary vertices start at the boundary
+	QVector<QAtomicInteger<quint64> > best(vCount, QAtomicInteger<quint64>(noKey));
+	Parallel::forBlocks(count, 1 << 14, [&](int begin, int end) {
+		for (int h = begin; h < end; h++) {
+			quint64 key = (twins[h] >= 0 ? quint64(1) << 32 : 0) | quint32(h);
+			QAtomicInteger<quint64> & slot = best[origins[h]];
+			quint64 known = slot.load();
+			while (key < known && !slot.testAndSetOrdered(known, key)) {
+				known = slot.load();
+			}
+		}
+	});
+	vertexHalfEdges.resize(vCount);
+	Parallel::forBlocks(vCount, 1 << 16, [&](int begin, int end) {
+		for (int v = begin; v < end; v++) {
+			quint64 key = best[v].load();
+			vertexHalfEdges[v] = key == noKey ? none : int(key & 0xffffffffu);
+		}
+	});
+}
+
+void HalfEdgeMesh::oneRing(int v, QVector<int> *neighbours) const
+{
+	neighbours->clear();
+	int start = vertexHalfEdges[v];
+	if (start == none) {
+		return;
+	}
+
+	int h = start;
+	do {
+		neighbours->append(target(h));
+		int incoming = previous(h);
+		h = twin(incoming);
+		if (h == none) {
+			// The fan is open, the last neighbour is only reached by the incoming edge
+			neighbours->append(origin(incoming));
+			break;
+		}
+	} while (h != start);
+}
+
+void HalfEdgeMesh::addMemory(MemoryReport *report) const
+{
+	const qint64 array = sizeof(QArrayData) + MemoryReport::allocationOverhead;
+	report->add(MemoryReport::Caches, sizeof(HalfEdgeMesh)
+		+ 5 * array + qint64(origins.capacity() + faces.capacity() + twins.capacity()
+			+ faceStarts.capacity() + vertexHalfEdges.capacity()) * sizeof(int));
+}
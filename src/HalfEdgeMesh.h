@@ -0,0 +1,288 @@
+#pragma once
+
+#include <QVector>
+
+#include "IScene.h"
+#include "MemoryReport.h"
+
+/**
+ * @brief Index based half-edge connectivity of a scene
+ *
+ * Each corner of each polygon starts one half-edge, which runs to the next
+ * corner of the polygon. The half-edges are numbered like the corners:
+ * polygon f owns the half-edges faceHalfEdge(f) to faceHalfEdge(f+1)-1 in
+ * the order of its vertices, so next() and previous() need no arrays of
+ * their own. The start vertex, the polygon and the twin of each half-edge
+ * are stored.
+ *
+ * The twins are found without a map: the half-edges are sorted in parallel
+ * by the key of their vertex pair, so the half-edges of an edge follow each
+ * other. Two half-edges in opposite directions become twins. All other
+ * edges are left without twins: boundary edges have a single half-edge,
+ * non-manifold edges have more than two half-edges or two in the same
+ * direction and are marked by isNonManifold(). The structure is therefore
+ * valid for any input, but walks around a vertex stop at such edges.
+ *
+ * The structure does not change when vertices are moved, but it has to be
+ * built again when polygons are added or removed.
+ *
+ * @see OffScene::halfEdges()
+ */
+class HalfEdgeMesh
+{
+public:
+	/**
+	 * @brief Marks a missing half-edge
+	 */
+	static const int none = -1;
+
+	/**
+	 * @brief Builds the half-edges of all polygons of a scene in parallel
+	 *
+	 * @param [in] scene The scene, its polygons must only use existing vertices
+	 */
+	explicit HalfEdgeMesh(const IScene *scene);
+
+	/**
+	 * @brief Returns the number of half-edges
+	 */
+	int halfEdgesCount() const
+	{
+		return origins.size();
+	}
+
+	/**
+	 * @brief Returns the number of polygons
+	 */
+	int facesCount() const
+	{
+		return faceStarts.size() - 1;
+	}
+
+	/**
+	 * @brief Returns the number of vertices
+	 */
+	int verticesCount() const
+	{
+		return vertexHalfEdges.size();
+	}
+
+	/**
+	 * @brief Returns the vertex a half-edge starts at
+	 */
+	int origin(int h) const
+	{
+		return origins[h];
+	}
+
+	/**
+	 * @brief Returns the vertex a half-edge ends at
+	 */
+	int target(int h) const
+	{
+		return origins[next(h)];
+	}
+
+	/**
+	 * @brief Returns the polygon of a half-edge
+	 */
+	int face(int h) const
+	{
+		return faces[h];
+	}
+
+	/**
+	 * @brief Returns the following half-edge of the same polygon
+	 */
+	int next(int h) const
+	{
+		return h + 1 < faceStarts[faces[h] + 1] ? h + 1 : faceStarts[faces[h]];
+	}
+
+	/**
+	 * @brief Returns the preceding half-edge of the same polygon
+	 */
+	int previous(int h) const
+	{
+		return h > faceStarts[faces[h]] ? h - 1 : faceStarts[faces[h] + 1] - 1;
+	}
+
+	/**
+	 * @brief Returns the half-edge in the opposite direction or none
+	 *
+	 * Boundary and non-manifold edges have no twin.
+	 */
+	int twin(int h) const
+	{
+		return twins[h] >= 0 ? twins[h] : none;
+	}
+
+	/**
+	 * @brief Is the half-edge the only one of its edge?
+	 */
+	bool isBoundary(int h) const
+	{
+		return twins[h] == none;
+	}
+
+	/**
+	 * @brief Is the edge shared by more than two half-edges or by two in the same direction?
+	 *
+	 * Half-edges from a vertex to itself also count as non-manifold.
+	 */
+	bool isNonManifold(int h) const
+	{
+		return twins[h] == nonManifold;
+	}
+
+	/**
+	 * @brief Returns the first half-edge of a polygon
+	 *
+	 * @param [in] f Number of the polygon, facesCount() returns the end of the last polygon
+	 */
+	int faceHalfEdge(int f) const
+	{
+		return faceStarts[f];
+	}
+
+	/**
+	 * @brief Returns the number of corners of a polygon
+	 */
+	int faceSize(int f) const
+	{
+		return faceStarts[f + 1] - faceStarts[f];
+	}
+
+	/**
+	 * @brief Returns a half-edge that starts at a vertex or none
+	 *
+	 * If the vertex is on the boundary, the half-edge has no twin, so that
+	 * the walk with nextAroundVertex() visits all polygons of the fan.
+	 */
+	int vertexHalfEdge(int v) const
+	{
+		return vertexHalfEdges[v];
+	}
+
+	/**
+	 * @brief Returns the next half-edge that starts at the same vertex
+	 *
+	 * Turns to the neighbouring polygon across the preceding edge.
+	 *
+	 * @return The half-edge or none at a boundary or non-manifold edge
+	 */
+	int nextAroundVertex(int h) const
+	{
+		return twin(previous(h));
+	}
+
+	/**
+	 * @brief Collects the neighbour vertices of a vertex
+	 *
+	 * Walks around the fan of vertexHalfEdge(). At non-manifold vertices
+	 * only the polygons of this fan are visited.
+	 *
+	 * @param [in] v Number of the vertex
+	 * @param [out] neighbours Receives the neighbours in the order of the walk
+	 */
+	void oneRing(int v, QVector<int> *neighbours) const;
+
+	/**
+	 * @brief Returns the number of edges
+	 *
+	 * Each pair of different vertices that is connected by half-edges
+	 * counts once.
+	 */
+	int edgesCount() const
+	{
+		return edges;
+	}
+
+	/**
+	 * @brief Returns the number of half-edges without twin that are not non-manifold
+	 */
+	int boundaryHalfEdgesCount() const
+	{
+		return boundaryHalfEdges;
+	}
+
+	/**
+	 * @brief Returns the number of non-manifold half-edges
+	 */
+	int nonManifoldHalfEdgesCount() const
+	{
+		return nonManifoldHalfEdges;
+	}
+
+	/**
+	 * @brief Adds the used memory to a report
+	 */
+	void addMemory(MemoryReport *report) const;
+
+private:
+	/**
+	 * @brief Twin value of non-manifold half-edges
+	 */
+	static const int nonManifold = -2;
+
+	/**
+	 * @brief Sort key of a half-edge
+	 */
+	struct EdgeKey
+	{
+		/**
+		 * @brief Smaller vertex in the high and larger vertex in the low bits
+		 */
+		quint64 key;
+
+		/**
+		 * @brief Number of the half-edge
+		 */
+		int halfEdge;
+	};
+
+	/**
+	 * @brief Key of half-edges from a vertex to itself
+	 */
+	static const quint64 noKey = ~quint64(0);
+
+	/**
+	 * @brief Start vertex of each half-edge
+	 */
+	QVector<int> origins;
+
+	/**
+	 * @brief Polygon of each half-edge
+	 */
+	QVector<int> faces;
+
+	/**
+	 * @brief Twin of each half-edge, none or nonManifold
+	 */
+	QVector<int> twins;
+
+	/**
+	 * @brief First half-edge of each polygon and the number of half-edges at the end
+	 */
+	QVector<int> faceStarts;
+
+	/**
+	 * @brief An outgoing half-edge of each vertex
+	 */
+	QVector<int> vertexHalfEdges;
+
+	/**
+	 * @brief Number of edges
+	 */
+	int edges;
+
+	/**
+	 * @brief Number of boundary half-edges
+	 */
+	int boundaryHalfEdges;
+
+	/**
+	 * @brief Number of non-manifold half-edges
+	 */
+	int nonManifoldHalfEdges;
+};
@@ -3,6 +3,10 @@
 #include <QString>
 
 #include "IScene.h"
+#include "SceneBvh.h"
+#include "RenderGeometry.h"
+#include "GeometryBuffer.h"
+#include "SoftwareRenderer.h"
 
 /**
  * @brief The abstract interface for all render modes
@@ -41,15 +45,68 @@ public:
 	 */
 	virtual void unsetSettings() = 0;
 	
+	/**
+	 * @brief Creates the vertex data for the scene
+	 *
+	 * Is called by the GlWidget whenever the scene changes. The vertices must
+	 * be grouped by the parts of the polygon hierarchy, so that invisible
+	 * parts can be skipped. This method must not use OpenGL.
+	 *
+	 * @param scene			The scene which should be displayed
+	 * @param bvh			The polygon hierarchy of the scene
+	 * @param defaultColor	The default object color, only needed if the scene
+	 * 						itself is uncolored!
+	 * @return The new geometry, the caller takes the ownership
+	 */
+	virtual RenderGeometry* createGeometry(const IScene *scene, const SceneBvh *bvh,
+		const QColor *defaultColor) const = 0;
+
+	/**
+	 * @brief Returns the primitive type drawn by this mode
+	 *
+	 * Used to show geometry which was not created by createGeometry(),
+	 * like the triangles of out-of-core tiles, in the style of the mode.
+	 *
+	 * @return Points, lines or triangles
+	 */
+	virtual RenderGeometry::Primitive primitive() const = 0;
+
+	/**
+	 * @brief Is the default color part of the created geometry?
+	 *
+	 * If true, the geometry is created again when the default color changes.
+	 *
+	 * @return True, if createGeometry() uses the default color
+	 */
+	virtual bool geometryUsesDefaultColor() const = 0;
+
 	/**
 	 * @brief Draws the scene
 	 *
 	 * Is called by the GlWIdget every time the scene needs to be redrawn.
 	 * The grid and coordinate axes are already drawn at this point.
 	 * 
-	 * @param scene			The scene which should be displayed
+	 * @param geometry		The uploaded result of createGeometry()
+	 * @param parts		The visible parts of the chunks inside of the view frustum
 	 * @param defaultColor	The default object color, only needed if the scene 
 	 * 						itself is uncolored!
 	 */
-	virtual void draw(const IScene *scene, const QColor *defaultColor) = 0;
+	virtual void draw(const GeometryBuffer *geometry, const QVector<int> & parts,
+		const QColor *defaultColor) = 0;
+
+	/**
+	 * @brief Draws the scene without OpenGL
+	 *
+	 * Counterpart of draw() for the SoftwareRenderer. Must set up the renderer
+	 * state like setSettings() and draw() do for OpenGL, so both images look
+	 * the same. The matrices are already set.
+	 *
+	 * @param renderer		The renderer which receives the geometry
+	 * @param geometry		The result of createGeometry()
+	 * @param parts		The visible parts of the chunks inside of the view frustum
+	 * @param defaultColor	The default object color, only needed if the scene
+	 * 						itself is uncolored!
+	 */
+	virtual void render(SoftwareRenderer *renderer, const RenderGeometry *geometry,
+		const QVector<int> & parts, const QColor *defaultColor) const = 0;
 };
@@ -3,6 +3,7 @@
 #include <QColor>
 
 #include "CPolygon.h"
+#include "MemoryReport.h"
 
 /**
  * @brief The abstract scene interface
@@ -66,5 +67,16 @@ public:
 	 * @return A constant reference to the selected vertex
 	 */
 	virtual const CVertex* vertex(int i) const = 0;
+
+	/**
+	 * @brief Returns the main memory used by the scene
+	 *
+	 * The report is an estimate which includes the vertices, the polygons
+	 * and all helper structures of the implementation. It may take as long
+	 * as a loop over all polygons, so callers should remember it.
+	 *
+	 * @return The bytes of each category
+	 */
+	virtual MemoryReport memoryReport() const = 0;
 	
 };
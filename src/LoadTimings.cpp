@@ -0,0 +1,37 @@
+#include "LoadTimings.h"
+
+LoadTimings::LoadTimings()
+{
+	for (int i = 0; i < PhasesCount; i++) {
+		phases[i] = 0;
+	}
+	timer.start();
+}
+
+void LoadTimings::restart()
+{
+	timer.start();
+}
+
+void LoadTimings::lap(Phase phase)
+{
+	phases[phase] += timer.nsecsElapsed();
+	timer.start();
+}
+
+qint64 LoadTimings::nanoseconds(Phase phase) const
+{
+	return phases[phase];
+}
+
+QString LoadTimings::name(Phase phase)
+{
+	switch (phase) {
+		case Read: return "read";
+		case Parse: return "parse";
+		case Adjacency: return "adjacency";
+		case Normals: return "normals";
+		case Sorting: return "sorting";
+		default: return QString();
+	}
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <QtCore>
+
+/**
+ * @brief Time spent in the phases of loading a scene
+ *
+ * A scene reader measures its phases with lap() if it received a timings
+ * object. Phases which a reader does not have stay zero. Used by the
+ * benchmark mode to find out where the time goes.
+ *
+ * @see Benchmark
+ */
+class LoadTimings
+{
+public:
+	/**
+	 * @brief The measured phases
+	 */
+	enum Phase {
+		Read,		///< Reading lines from the file
+		Parse,		///< Tokenizing and converting vertices and polygons
+		Adjacency,	///< Collecting the polygons of each vertex
+		Normals,	///< Polygon and vertex normal vectors
+		Sorting,	///< Sorting the polygons by transparency
+		PhasesCount
+	};
+
+	/**
+	 * @brief Constructor
+	 *
+	 * Sets all phases to zero and starts the clock.
+	 */
+	LoadTimings();
+
+	/**
+	 * @brief Restarts the clock without adding the elapsed time to a phase
+	 */
+	void restart();
+
+	/**
+	 * @brief Adds the time since the last call to a phase
+	 *
+	 * @param [in] phase The phase which took the elapsed time
+	 */
+	void lap(Phase phase);
+
+	/**
+	 * @brief Returns the time of a phase in nanoseconds
+	 */
+	qint64 nanoseconds(Phase phase) const;
+
+	/**
+	 * @brief Returns the name of a phase for reports
+	 */
+	static QString name(Phase phase);
+
+private:
+	QElapsedTimer timer;
+	qint64 phases[PhasesCount];
+};
@@ -1,14 +1,25 @@
 #include <QFileInfo>
+#include <QProgressDialog>
+#include <QtConcurrent>
 
 #include "MainWindow.h"
 #include "SceneFactory.h"
+#include "TileConverter.h"
+#include "OffWriter.h"
+#include "OffBinaryReader.h"
+#include "QuantizedFile.h"
+#include "MeshSlicer.h"
 
 MainWindow::MainWindow(QString fileToOpen, QWidget* parent)
 	: QMainWindow(parent)
 {
 	scene = 0;
+	tileFile = 0;
+	streamLoader = 0;
 	renderModesAlignmentGroup = 0;
+	clippingGroup = 0;
 	signalMapper = 0;
+	meshCheckPending = false;
 
 	ui.setupUi(this);
 	setMainWindowTitle();
@@ -20,10 +31,43 @@ MainWindow::MainWindow(QString fileToOpen, QWidget* parent)
 		// pointer and deletes it at the appropriate time
 	setCentralWidget(glWidget);
 
+	// The scenes are kept in memory within the budgets of the settings
+	sceneCache = new SceneCache(glWidget);
+	QSettings settings;
+	qint64 megabyte = 1024 * 1024;
+	sceneCache->setBudget(
+		settings.value("cache/memoryMegabytes", sceneCache->memoryBudget() / megabyte)
+			.toLongLong() * megabyte,
+		settings.value("cache/gpuMegabytes", sceneCache->gpuBudget() / megabyte)
+			.toLongLong() * megabyte);
+	sceneCache->setLoadOptions(loadOptions());
+
+	sequencePlayer = new SequencePlayer(glWidget);
+
+	// The statistics are only calculated while the panel is shown
+	statisticsPanel = new StatisticsPanel(this);
+	addDockWidget(Qt::RightDockWidgetArea, statisticsPanel);
+	statisticsPanel->hide();
+
+	// Changed files are reloaded after a short delay
+	fileWatcher = new QFileSystemWatcher(this);
+	reloadTimer = new QTimer(this);
+	reloadTimer->setSingleShot(true);
+	reloadTimer->setInterval(300);
+	ui.actionReload_Changed_Files->setChecked(settings.value("autoReload", true).toBool());
+	ui.actionWeld_Vertices->setChecked(settings.value("loading/weldVertices", false).toBool());
+
 	createLanguageMenu();
 	loadNativeLanguageFile(); // has to be executed after createLanguageMenu()!
 
 	createRenderModesMenu();
+
+	// Only one clipping plane is active at a time
+	clippingGroup = new QActionGroup(this);
+	clippingGroup->addAction(ui.actionClip_None);
+	clippingGroup->addAction(ui.actionClip_Xz);
+	clippingGroup->addAction(ui.actionClip_Xy);
+	clippingGroup->addAction(ui.actionClip_Yz);
 	syncMenu();
 	connectSignalsAndSlots();
 
@@ -45,9 +89,18 @@ MainWindow::~MainWindow()
 		delete signalMapper;
 	}
 
-	if (scene) {
-		delete scene;
+	// The panel, the check and the player use the current scene, which belongs to the cache
+	statisticsPanel->setScene(0);
+	cancelMeshCheck();
+	delete sequencePlayer;
+
+	// The widget must not load tiles or show a cached scene any more
+	glWidget->setTileFile(0);
+	if (tileFile) {
+		delete tileFile;
 	}
+	delete streamLoader;
+	delete sceneCache;
 
 	for (int i = 0; i < actionRenderMode.size(); ++i) {
 		delete actionRenderMode.at(i);
@@ -73,32 +126,66 @@ void MainWindow::dropEvent(QDropEvent* event)
 
 void MainWindow::parseFileAndShowObject(const QString & fileToOpen)
 {
+	stopSequence();
+	if (fileToOpen == "-") {
+		openStandardInput();
+		return;
+	}
+
 	try {
-		IScene* newScene = SceneFactory::openFile(fileToOpen);
+		IScene* newScene = 0;
+		TileFile* newTileFile = 0;
+		bool cached = false;
+		if (SceneFactory::isTileFile(fileToOpen)) {
+			newTileFile = SceneFactory::openTileFile(fileToOpen);
+		} else {
+			newScene = sceneCache->open(fileToOpen, &cached);
+		}
 
 		// Save path and name of file and show filename in window title
 		openedFile.setFile(fileToOpen);
 		setMainWindowTitle(openedFile.fileName());
 
+		// The previous scene stays in the cache
 		glWidget->setScene(0);
-		if (scene) {
-			delete scene;
+		statisticsPanel->setScene(0);
+		cancelMeshCheck();
+		if (tileFile) {
+			delete tileFile;
 		}
+		delete streamLoader;
+		streamLoader = 0;
 		scene = newScene;
-		glWidget->setScene(scene);
+		tileFile = newTileFile;
+		if (tileFile) {
+			glWidget->setTileFile(tileFile);
+		} else {
+			glWidget->setScene(scene);
+		}
+		statisticsPanel->setScene(scene, componentsCount());
+		sceneCache->setCurrent(scene);
+		sceneCache->trim();
+		addRecentFile(openedFile.absoluteFilePath());
+		prefetchNeighbours();
+		watchOpenedFile();
 		syncMenu();
 
-		// Select the best available render mode
-		int mode;
-		if (scene->isColored()) {
-			mode = glWidget->modeForColoredScenes();
+		selectRenderMode(scene ? scene->isColored() : tileFile->isColored());
+
+		// Show filename and memory usage in status bar
+		if (scene && cached) {
+			statusBar()->showMessage(tr("File %1 was taken from the cache, it uses %2 of memory")
+				.arg(openedFile.fileName())
+				.arg(MemoryReport::formatBytes(glWidget->memoryReport().total()))
+				+ cleanReportText(scene));
+		} else if (scene) {
+			statusBar()->showMessage(tr("File %1 was loaded, it uses %2 of memory")
+				.arg(openedFile.fileName())
+				.arg(MemoryReport::formatBytes(glWidget->memoryReport().total()))
+				+ cleanReportText(scene));
 		} else {
-			mode = glWidget->modeForUncoloredScenes();
+			statusBar()->showMessage(tr("File %1 was loaded").arg(openedFile.fileName()));
 		}
-		actionRenderMode.at(mode)->setChecked(true);
-
-		// Show filename in status bar
-		statusBar()->showMessage(tr("File %1 was loaded").arg(openedFile.fileName()));
 	}
 	catch(QString & message) {
 		QMessageBox::warning(this, tr("Error"), tr("An error occured while "
@@ -106,6 +193,71 @@ void MainWindow::parseFileAndShowObject(const QString & fileToOpen)
 	}
 }
 
+void MainWindow::openStandardInput()
+{
+	close();
+	streamLoader = new StreamLoader();
+	connect(streamLoader, SIGNAL(aboutToGrow()), this, SLOT(streamAboutToGrow()));
+	connect(streamLoader, SIGNAL(grown()), this, SLOT(streamGrown()));
+	connect(streamLoader, SIGNAL(finished()), this, SLOT(streamFinished()));
+	connect(streamLoader, SIGNAL(failed(QString)), this, SLOT(streamFailed(QString)));
+
+	openedFile = QFileInfo();
+	setMainWindowTitle(tr("Standard Input"));
+	statusBar()->showMessage(tr("Reading from the standard input..."));
+	streamLoader->start();
+}
+
+void MainWindow::selectRenderMode(bool colored)
+{
+	int mode;
+	if (colored) {
+		mode = glWidget->modeForColoredScenes();
+	} else {
+		mode = glWidget->modeForUncoloredScenes();
+	}
+	actionRenderMode.at(mode)->setChecked(true);
+}
+
+void MainWindow::streamAboutToGrow()
+{
+	// The hierarchy of the last part may still be built from the scene
+	glWidget->waitForHierarchy();
+}
+
+void MainWindow::streamGrown()
+{
+	// The first part decides the view, later parts keep it
+	if (!scene) {
+		scene = streamLoader->scene();
+		glWidget->setScene(scene);
+		syncMenu();
+		selectRenderMode(scene->isColored());
+	} else {
+		glWidget->replaceScene(scene);
+	}
+
+	if (!streamLoader->isFinished()) {
+		statusBar()->showMessage(tr("Reading from the standard input: %1 of %2 polygons")
+			.arg(scene->polygonsCount()).arg(streamLoader->expectedPolygons()));
+	}
+}
+
+void MainWindow::streamFinished()
+{
+	// The scene does not grow any more
+	statisticsPanel->setScene(scene, componentsCount());
+	statusBar()->showMessage(tr("Read %1 vertices and %2 polygons from the standard input")
+		.arg(streamLoader->scene()->verticesCount())
+		.arg(streamLoader->scene()->polygonsCount()));
+}
+
+void MainWindow::streamFailed(const QString & message)
+{
+	QMessageBox::warning(this, tr("Error"), tr("An error occured while "
+			"reading the standard input") + "<br><br>" + message);
+}
+
 void MainWindow::setMainWindowTitle(const QString & filename)
 {
 	if (filename.isEmpty()) {
@@ -119,20 +271,80 @@ void MainWindow::connectSignalsAndSlots()
 {
 	connect(ui.actionOpen_File,	SIGNAL(triggered()), this, SLOT(open()));
 	connect(ui.actionClose_File, SIGNAL(triggered()), this, SLOT(close()));
+	connect(ui.menuRecent_Files, SIGNAL(aboutToShow()), this,
+			SLOT(updateRecentFilesMenu()));
+	connect(ui.actionReload_Changed_Files, SIGNAL(triggered()), this,
+			SLOT(toggleAutoReload()));
+	connect(ui.actionWeld_Vertices, SIGNAL(triggered()), this, SLOT(toggleWeldVertices()));
+	connect(ui.actionWeld_Tolerance, SIGNAL(triggered()), this, SLOT(setWeldTolerance()));
+	connect(fileWatcher, SIGNAL(fileChanged(QString)), this, SLOT(openedFileChanged()));
+	connect(reloadTimer, SIGNAL(timeout()), this, SLOT(reloadOpenedFile()));
+	connect(sceneCache, SIGNAL(sceneAboutToChange(const IScene*)), this,
+			SLOT(sceneAboutToChange(const IScene*)));
+	connect(sceneCache, SIGNAL(sceneUpdated(const IScene*)), this,
+			SLOT(sceneUpdated(const IScene*)));
+	connect(sceneCache, SIGNAL(sceneReplaced(const IScene*, IScene*)), this,
+			SLOT(sceneReplaced(const IScene*, IScene*)));
+	connect(sceneCache, SIGNAL(reloadFailed(QString, QString)), this,
+			SLOT(reloadFailed(QString, QString)));
+	connect(ui.actionNext_File, SIGNAL(triggered()), this, SLOT(openNextFile()));
+	connect(ui.actionPrevious_File, SIGNAL(triggered()), this, SLOT(openPreviousFile()));
+	connect(ui.actionPlay_Sequence, SIGNAL(triggered()), this, SLOT(toggleSequence()));
+	connect(ui.actionSequence_Frame_Rate, SIGNAL(triggered()), this,
+			SLOT(setSequenceFrameRate()));
+	connect(sequencePlayer, SIGNAL(sceneAboutToChange(const IScene*)), this,
+			SLOT(sceneAboutToChange(const IScene*)));
+	connect(sequencePlayer, SIGNAL(frameShown(int, int, double, int)), this,
+			SLOT(sequenceFrameShown(int, int, double, int)));
+	connect(sequencePlayer, SIGNAL(failed(QString, QString)), this,
+			SLOT(sequenceFailed(QString, QString)));
+	connect(ui.actionSave_As, SIGNAL(triggered()), this, SLOT(saveAs()));
+	connect(ui.actionConvert_To_Tiles, SIGNAL(triggered()), this, SLOT(convertToTiles()));
 	connect(ui.actionExit, SIGNAL(triggered()), this, SLOT(exit()));
 	connect(ui.actionXz_Plane, SIGNAL(triggered()), this, SLOT(toggleXzPlane()));
 	connect(ui.actionXy_Plane, SIGNAL(triggered()), this, SLOT(toggleXyPlane()));
 	connect(ui.actionYz_Plane, SIGNAL(triggered()), this, SLOT(toggleYzPlane()));
+	connect(ui.actionExport_Slices, SIGNAL(triggered()), this, SLOT(exportSlices()));
+	connect(ui.actionClip_None, SIGNAL(triggered()), this, SLOT(setClippingPlane()));
+	connect(ui.actionClip_Xz, SIGNAL(triggered()), this, SLOT(setClippingPlane()));
+	connect(ui.actionClip_Xy, SIGNAL(triggered()), this, SLOT(setClippingPlane()));
+	connect(ui.actionClip_Yz, SIGNAL(triggered()), this, SLOT(setClippingPlane()));
+	connect(ui.actionClip_Forward, SIGNAL(triggered()), this,
+			SLOT(moveClippingPlaneForward()));
+	connect(ui.actionClip_Backward, SIGNAL(triggered()), this,
+			SLOT(moveClippingPlaneBackward()));
+	connect(glWidget, SIGNAL(clippingChanged()), this, SLOT(showClipping()));
 	connect(ui.actionChoose_Background_Color, SIGNAL(triggered()), this,
 			SLOT(setBackgroundColor()));
 	connect(ui.actionChoose_Object_Color, SIGNAL(triggered()), this,
 			SLOT(setObjectColor()));
 	connect(ui.actionShow_Coordinate_System, SIGNAL(triggered()), this,
 			SLOT(toggleAxes()));
+	connect(ui.actionSoftware_Rendering, SIGNAL(triggered()), this,
+			SLOT(toggleSoftwareRendering()));
+	connect(ui.actionPerformance_Overlay, SIGNAL(triggered()), this,
+			SLOT(togglePerformanceOverlay()));
+	connect(ui.actionMemory_Usage, SIGNAL(triggered()), this,
+			SLOT(showMemoryUsage()));
+	connect(ui.actionCheck_Mesh, SIGNAL(triggered()), this, SLOT(checkMesh()));
+	connect(&meshCheck, SIGNAL(finished()), this, SLOT(meshCheckFinished()));
+	connect(ui.actionStatistics_Panel, SIGNAL(triggered(bool)), statisticsPanel,
+			SLOT(setVisible(bool)));
+	connect(statisticsPanel, SIGNAL(visibilityChanged(bool)), ui.actionStatistics_Panel,
+			SLOT(setChecked(bool)));
+	connect(ui.actionHide_Component, SIGNAL(triggered()), this, SLOT(hidePickedComponent()));
+	connect(ui.actionIsolate_Component, SIGNAL(triggered()), this,
+			SLOT(isolatePickedComponent()));
+	connect(ui.actionShow_All_Components, SIGNAL(triggered()), this,
+			SLOT(showAllComponents()));
 	connect(ui.actionReset_View, SIGNAL(triggered()), this, SLOT(resetView()));
 	connect(ui.actionHelp_Content, SIGNAL(triggered()), this, SLOT(help()));
 	connect(ui.actionAbout_OffView, SIGNAL(triggered()), this, SLOT(about()));
 	connect(ui.actionAbout_Qt, SIGNAL(triggered()), this, SLOT(aboutQt()));
+	connect(glWidget, SIGNAL(polygonPicked(int, int)), this,
+			SLOT(showPickedPolygon(int, int)));
+	connect(glWidget, SIGNAL(softwareRenderingChanged(bool)), this,
+			SLOT(syncMenu()));
 }
 
 void MainWindow::createRenderModesMenu()
@@ -257,6 +469,7 @@ void MainWindow::retranslateUi()
 {
 	updateRenderModesMenu(); // Translates the render modes in menu "View" -> "Mode"
 	ui.retranslateUi(this); // Translates all the rest
+	statisticsPanel->retranslate();
 }
 
 bool MainWindow::checkDragAndDropData(const QMimeData* mimeData, QString* filePath) const
@@ -321,15 +534,550 @@ void MainWindow::open()
 
 void MainWindow::close()
 {
+	// The scene stays in the cache, so opening it again is instant
+	stopSequence();
 	glWidget->setScene(0);
-	if (scene) {
-		delete scene;
-	}
+	statisticsPanel->setScene(0);
+	cancelMeshCheck();
 	scene = 0;
+	delete streamLoader;
+	streamLoader = 0;
+	sceneCache->setCurrent(0);
+	sceneCache->cancelPrefetches();
+	watchOpenedFile();
+	if (tileFile) {
+		delete tileFile;
+	}
+	tileFile = 0;
 	syncMenu();
 	setMainWindowTitle(); // Remove filename from window title
 }
 
+void MainWindow::addRecentFile(const QString & file)
+{
+	QSettings settings;
+	QStringList files = settings.value("recentFiles").toStringList();
+	files.removeAll(file);
+	files.prepend(file);
+	while (files.size() > maxRecentFiles) {
+		sceneCache->removeSnapshot(files.takeLast());
+	}
+	settings.setValue("recentFiles", files);
+}
+
+void MainWindow::updateRecentFilesMenu()
+{
+	ui.menuRecent_Files->clear();
+
+	QStringList files = QSettings().value("recentFiles").toStringList();
+	for (int i = 0; i < files.size(); ++i) {
+		QString text = tr("&%1 %2").arg(i + 1).arg(QFileInfo(files[i]).fileName());
+		if (sceneCache->isResident(files[i])) {
+			text += tr(" (in memory)");
+		}
+		QAction* action = ui.menuRecent_Files->addAction(text);
+		action->setData(files[i]);
+		action->setStatusTip(files[i]);
+		connect(action, SIGNAL(triggered()), this, SLOT(openRecentFile()));
+	}
+	if (files.isEmpty()) {
+		ui.menuRecent_Files->addAction(tr("No recent files"))->setEnabled(false);
+	}
+
+	ui.menuRecent_Files->addSeparator();
+	QAction* budget = ui.menuRecent_Files->addAction(tr("Set Cache &Budget..."));
+	connect(budget, SIGNAL(triggered()), this, SLOT(setCacheBudget()));
+}
+
+void MainWindow::openRecentFile()
+{
+	QAction* action = qobject_cast<QAction*>(sender());
+	if (action) {
+		parseFileAndShowObject(action->data().toString());
+	}
+}
+
+void MainWindow::openNextFile()
+{
+	openFileInFolder(1);
+}
+
+void MainWindow::openPreviousFile()
+{
+	openFileInFolder(-1);
+}
+
+QStringList MainWindow::filesInFolder()
+{
+	QString folder = openedFile.absolutePath();
+	if (folder != listedFolder || !folderFiles.contains(openedFile.fileName())) {
+		listedFolder = folder;
+		folderFiles = QDir(folder).entryList(SceneFactory::nameFilters(), QDir::Files,
+				QDir::Name | QDir::IgnoreCase | QDir::LocaleAware);
+	}
+	return folderFiles;
+}
+
+void MainWindow::openFileInFolder(int step)
+{
+	if (openedFile.fileName().isEmpty()) {
+		return;
+	}
+
+	QStringList files = filesInFolder();
+	int index = files.indexOf(openedFile.fileName()) + step;
+	if (index < 0 || index >= files.size()) {
+		statusBar()->showMessage(step > 0 ? tr("This is the last file in the folder")
+				: tr("This is the first file in the folder"));
+		return;
+	}
+	parseFileAndShowObject(QDir(listedFolder).filePath(files[index]));
+}
+
+void MainWindow::prefetchNeighbours()
+{
+	QStringList files = filesInFolder();
+	int index = files.indexOf(openedFile.fileName());
+
+	// Stepping forward is the common case, so the next file comes first
+	QStringList neighbours;
+	if (index >= 0 && index + 1 < files.size()) {
+		neighbours.append(QDir(listedFolder).filePath(files[index + 1]));
+	}
+	if (index > 0) {
+		neighbours.append(QDir(listedFolder).filePath(files[index - 1]));
+	}
+
+	// Tiled scenes are streamed, there is nothing to prefetch
+	for (int i = neighbours.size() - 1; i >= 0; i--) {
+		if (SceneFactory::isTileFile(neighbours[i])) {
+			neighbours.removeAt(i);
+		}
+	}
+	sceneCache->prefetch(neighbours);
+}
+
+void MainWindow::watchOpenedFile()
+{
+	reloadTimer->stop();
+	if (!fileWatcher->files().isEmpty()) {
+		fileWatcher->removePaths(fileWatcher->files());
+	}
+	if (scene && !streamLoader && ui.actionReload_Changed_Files->isChecked()) {
+		fileWatcher->addPath(openedFile.absoluteFilePath());
+	}
+}
+
+void MainWindow::toggleAutoReload()
+{
+	QSettings().setValue("autoReload", ui.actionReload_Changed_Files->isChecked());
+	watchOpenedFile();
+}
+
+void MainWindow::toggleWeldVertices()
+{
+	changeLoadOption("loading/weldVertices", ui.actionWeld_Vertices->isChecked());
+}
+
+void MainWindow::setWeldTolerance()
+{
+	bool ok = false;
+	double tolerance = QInputDialog::getDouble(this, tr("Weld Tolerance"),
+		tr("Merge vertices closer than (0 merges only identical vertices):"),
+		QSettings().value("loading/weldTolerance", 0.0).toDouble(), 0.0, 1e9, 6, &ok);
+	if (!ok) {
+		return;
+	}
+	changeLoadOption("loading/weldTolerance", tolerance);
+}
+
+void MainWindow::changeLoadOption(const QString & key, const QVariant & value)
+{
+	if (QSettings().value(key) == value) {
+		return;
+	}
+
+	// Scenes loaded with the old option must not be shown again
+	sceneCache->invalidate();
+	QSettings().setValue(key, value);
+	sceneCache->setLoadOptions(loadOptions());
+	if (scene && !streamLoader) {
+		sceneCache->reload(openedFile.absoluteFilePath(), false);
+		prefetchNeighbours();
+	}
+}
+
+SceneFactory::LoadOptions MainWindow::loadOptions() const
+{
+	QSettings settings;
+	SceneFactory::LoadOptions options;
+	options.weldVertices = settings.value("loading/weldVertices", false).toBool();
+	options.weldTolerance = float(settings.value("loading/weldTolerance", 0.0).toDouble());
+	return options;
+}
+
+QString MainWindow::cleanReportText(const IScene* loadedScene) const
+{
+	const OffScene* offScene = dynamic_cast<const OffScene*>(loadedScene);
+	if (!offScene) {
+		return QString();
+	}
+	VertexWelder::Report report = offScene->cleanReport();
+	if (report.vertices == 0 && report.degeneratePolygons == 0
+			&& report.duplicatePolygons == 0) {
+		return QString();
+	}
+	return tr(", %1 vertices merged, %2 degenerate and %3 duplicate polygons removed")
+		.arg(report.vertices).arg(report.degeneratePolygons).arg(report.duplicatePolygons);
+}
+
+void MainWindow::openedFileChanged()
+{
+	reloadTimer->start();
+}
+
+void MainWindow::reloadOpenedFile()
+{
+	// The played frames replace the vertices anyway
+	if (!scene || sequencePlayer->isPlaying()) {
+		return;
+	}
+
+	// Files replaced by renaming a new file are no longer watched
+	QString path = openedFile.absoluteFilePath();
+	if (!QFileInfo(path).exists()) {
+		return;
+	}
+	if (!fileWatcher->files().contains(path)) {
+		fileWatcher->addPath(path);
+	}
+	sceneCache->reload(path);
+}
+
+void MainWindow::sceneAboutToChange(const IScene* changedScene)
+{
+	// The background calculations must not read the vertices while they are replaced
+	if (changedScene == scene) {
+		statisticsPanel->cancel();
+		cancelMeshCheck();
+		glWidget->waitForHierarchy();
+	}
+}
+
+void MainWindow::sceneUpdated(const IScene* updatedScene)
+{
+	if (updatedScene == scene) {
+		statisticsPanel->setScene(scene, componentsCount());
+		statusBar()->showMessage(tr("File %1 was updated").arg(openedFile.fileName()));
+	}
+}
+
+void MainWindow::sceneReplaced(const IScene* oldScene, IScene* newScene)
+{
+	if (oldScene != scene) {
+		return;
+	}
+
+	// The reloaded file has other polygons than the played frames
+	if (sequencePlayer->playedScene() == oldScene) {
+		sequencePlayer->stop();
+		ui.actionPlay_Sequence->setChecked(false);
+	}
+
+	cancelMeshCheck();
+	scene = newScene;
+	glWidget->replaceScene(scene);
+	statisticsPanel->setScene(scene, componentsCount());
+	sceneCache->setCurrent(scene);
+	statusBar()->showMessage(tr("File %1 was reloaded").arg(openedFile.fileName())
+		+ cleanReportText(scene));
+}
+
+void MainWindow::reloadFailed(const QString & file, const QString & message)
+{
+	statusBar()->showMessage(tr("File %1 could not be reloaded: %2")
+			.arg(QFileInfo(file).fileName()).arg(message));
+}
+
+void MainWindow::stopSequence()
+{
+	ui.actionPlay_Sequence->setChecked(false);
+	if (!sequencePlayer->isPlaying()) {
+		return;
+	}
+	sequencePlayer->stop();
+	sceneCache->reload(openedFile.absoluteFilePath());
+}
+
+void MainWindow::toggleSequence()
+{
+	if (!ui.actionPlay_Sequence->isChecked()) {
+		stopSequence();
+		statusBar()->showMessage(tr("Playback stopped"));
+		return;
+	}
+
+	// Only OFF scenes can take the vertices of another frame
+	OffScene* offScene = dynamic_cast<OffScene*>(scene);
+	QStringList frames;
+	if (offScene && !streamLoader && openedFile.suffix() == "off"
+		&& !OffBinaryReader::isBinary(openedFile.absoluteFilePath())) {
+		frames = SequencePlayer::findSequence(openedFile.absoluteFilePath());
+	}
+	if (frames.isEmpty()) {
+		ui.actionPlay_Sequence->setChecked(false);
+		statusBar()->showMessage(tr("The opened file is not part of a numbered frame sequence"));
+		return;
+	}
+
+	// The frames are read without welding, so their vertices would not match
+	if (!SceneFactory::describe(loadOptions()).isEmpty()) {
+		ui.actionPlay_Sequence->setChecked(false);
+		statusBar()->showMessage(
+			tr("Frame sequences can not be played while vertices are welded when loading"));
+		return;
+	}
+
+	// The frames are read by the player, loading them as scenes would only compete
+	sceneCache->cancelPrefetches();
+	reloadTimer->stop();
+	int first = frames.indexOf(openedFile.absoluteFilePath());
+	double framesPerSecond = QSettings().value("sequence/framesPerSecond", 30).toInt();
+	sequencePlayer->start(offScene, frames, qMax(0, first), framesPerSecond);
+}
+
+void MainWindow::setSequenceFrameRate()
+{
+	bool ok = false;
+	int framesPerSecond = QInputDialog::getInt(this, tr("Sequence Frame Rate"),
+		tr("Frames per second:"), QSettings().value("sequence/framesPerSecond", 30).toInt(),
+		1, 240, 1, &ok);
+	if (!ok) {
+		return;
+	}
+
+	QSettings().setValue("sequence/framesPerSecond", framesPerSecond);
+	if (sequencePlayer->isPlaying()) {
+		toggleSequence();
+	}
+}
+
+void MainWindow::sequenceFrameShown(int frame, int frames, double framesPerSecond, int dropped)
+{
+	statisticsPanel->setScene(scene, componentsCount());
+	statusBar()->showMessage(tr("Frame %1 of %2, %3 frames per second, %4 dropped")
+			.arg(frame + 1).arg(frames).arg(framesPerSecond, 0, 'f', 1).arg(dropped));
+}
+
+void MainWindow::sequenceFailed(const QString & file, const QString & message)
+{
+	// The player has stopped, the scene may still show another frame
+	ui.actionPlay_Sequence->setChecked(false);
+	sceneCache->reload(openedFile.absoluteFilePath());
+	QMessageBox::warning(this, tr("Error"), tr("An error occured while "
+			"playing file ") + file + "<br><br>" + message);
+}
+
+void MainWindow::setCacheBudget()
+{
+	const qint64 megabyte = 1024 * 1024;
+	bool ok = false;
+	int memory = QInputDialog::getInt(this, tr("Cache Budget"),
+		tr("Main memory for recently opened files (MB):"),
+		int(sceneCache->memoryBudget() / megabyte), 0, 1024 * 1024, 256, &ok);
+	if (!ok) {
+		return;
+	}
+	int gpu = QInputDialog::getInt(this, tr("Cache Budget"),
+		tr("Graphics memory for recently opened files (MB):"),
+		int(sceneCache->gpuBudget() / megabyte), 0, 1024 * 1024, 256, &ok);
+	if (!ok) {
+		return;
+	}
+
+	QSettings settings;
+	settings.setValue("cache/memoryMegabytes", memory);
+	settings.setValue("cache/gpuMegabytes", gpu);
+	sceneCache->setBudget(memory * megabyte, gpu * megabyte);
+}
+
+void MainWindow::saveAs()
+{
+	if (!scene) {
+		QMessageBox::information(this, tr("Save As"),
+			tr("Only loaded OFF files can be saved."));
+		return;
+	}
+	if (streamLoader) {
+		QMessageBox::information(this, tr("Save As"),
+			tr("The scene can be saved when the pipe is closed."));
+		return;
+	}
+	if (sequencePlayer->isPlaying()) {
+		stopSequence();
+	}
+
+	QString textFilter = tr("Off Files (*.off)");
+	QString binaryFilter = tr("Binary Off Files (*.off)");
+	QString quantizedFilter = QuantizedFile::fileFilter();
+	QString selectedFilter = textFilter;
+	QString target = QFileDialog::getSaveFileName(
+		this, tr("Save As"),
+		openedFile.absolutePath() + "/" + openedFile.completeBaseName() + ".off",
+		textFilter + ";;" + binaryFilter + ";;" + quantizedFilter, &selectedFilter
+	);
+	if (target.isNull()) {
+		return;
+	}
+
+	// Quantized files lose precision, so the user chooses how much
+	int positionBits = 0;
+	if (selectedFilter == quantizedFilter) {
+		bool ok = false;
+		positionBits = QInputDialog::getInt(this, tr("Save As"), tr("Bits per coordinate:"),
+			QSettings().value("quantized/positionBits", 16).toInt(),
+			QuantizedFile::minPositionBits, QuantizedFile::maxPositionBits, 1, &ok);
+		if (!ok) {
+			return;
+		}
+		QSettings().setValue("quantized/positionBits", positionBits);
+	}
+
+	QProgressDialog progress(tr("Saving file..."), tr("Cancel"), 0, 100, this);
+	progress.setWindowTitle(tr("Saving OFF file"));
+	progress.setWindowModality(Qt::ApplicationModal);
+	progress.setWindowFlags(Qt::Tool);
+
+	QElapsedTimer timer;
+	timer.start();
+	OffWriter::Format format = selectedFilter == binaryFilter ? OffWriter::Binary : OffWriter::Text;
+	auto showProgress = [&progress](int percent) {
+		progress.setValue(percent);
+		return !progress.wasCanceled();
+	};
+	try {
+		if (positionBits > 0) {
+			QuantizedFile::write(scene, target, positionBits, QuantizedFile::defaultNormalBits,
+				showProgress);
+		} else {
+			OffWriter::write(scene, target, format, showProgress);
+		}
+	}
+	catch(QString & message) {
+		QMessageBox::warning(this, tr("Error"), tr("An error occured while "
+				"saving file ") + target + "<br><br>" + message);
+		return;
+	}
+
+	statusBar()->showMessage(tr("Saved %1 in %2 s").arg(QFileInfo(target).fileName())
+		.arg(timer.elapsed() / 1000.0, 0, 'f', 1));
+}
+
+void MainWindow::exportSlices()
+{
+	if (!scene) {
+		QMessageBox::information(this, tr("Export Slices"),
+			tr("Only loaded scenes can be sliced."));
+		return;
+	}
+	if (streamLoader) {
+		QMessageBox::information(this, tr("Export Slices"),
+			tr("The scene can be sliced when the pipe is closed."));
+		return;
+	}
+
+	bool ok = false;
+	int layers = QInputDialog::getInt(this, tr("Export Slices"), tr("Number of slices:"),
+		QSettings().value("slicing/layers", 100).toInt(), 1, 100000, 1, &ok);
+	if (!ok) {
+		return;
+	}
+	QSettings().setValue("slicing/layers", layers);
+
+	// The slices are stacked along the axis of the clipping plane by default
+	QStringList axes;
+	axes << "x" << "y" << "z";
+	int clippingAxis = glWidget->clippingAxis();
+	QString axisName = QInputDialog::getItem(this, tr("Export Slices"), tr("Stacked along axis:"),
+		axes, clippingAxis >= 0 ? clippingAxis : 2, false, &ok);
+	if (!ok) {
+		return;
+	}
+	int axis = axes.indexOf(axisName);
+
+	QString target = QFileDialog::getSaveFileName(
+		this, tr("Export Slices"),
+		openedFile.absolutePath() + "/" + openedFile.completeBaseName() + ".cli",
+		tr("Common Layer Interface Files (*.cli)")
+	);
+	if (target.isNull()) {
+		return;
+	}
+	if (sequencePlayer->isPlaying()) {
+		stopSequence();
+	}
+
+	// The slices have their own hierarchy, so hidden components are exported too
+	QElapsedTimer timer;
+	timer.start();
+	QApplication::setOverrideCursor(Qt::WaitCursor);
+	try {
+		SceneBvh bvh(scene);
+		MeshSlicer::writeCli(target, axis, MeshSlicer(scene, &bvh).slices(axis, layers));
+	}
+	catch(QString & message) {
+		QApplication::restoreOverrideCursor();
+		QMessageBox::warning(this, tr("Error"), tr("An error occured while "
+				"saving file ") + target + "<br><br>" + message);
+		return;
+	}
+	QApplication::restoreOverrideCursor();
+
+	statusBar()->showMessage(tr("Saved %1 slices to %2 in %3 s").arg(layers)
+		.arg(QFileInfo(target).fileName()).arg(timer.elapsed() / 1000.0, 0, 'f', 1));
+}
+
+void MainWindow::convertToTiles()
+{
+	QString source = QFileDialog::getOpenFileName(
+		this, tr("Convert File"),
+		openedFile.absoluteFilePath(),
+		tr("Off Files (*.off)")
+	);
+	if (source.isNull()) {
+		return;
+	}
+
+	QFileInfo sourceInfo(source);
+	QString target = QFileDialog::getSaveFileName(
+		this, tr("Save Tiled File"),
+		sourceInfo.absolutePath() + "/" + sourceInfo.completeBaseName() + ".oft",
+		TileFile::fileFilter()
+	);
+	if (target.isNull()) {
+		return;
+	}
+
+	QProgressDialog progress(tr("Converting file..."), tr("Cancel"), 0, 100, this);
+	progress.setWindowTitle(tr("Converting OFF file"));
+	progress.setWindowModality(Qt::ApplicationModal);
+	progress.setWindowFlags(Qt::Tool);
+
+	try {
+		TileConverter::convert(source, target, [&progress](int percent) {
+			progress.setValue(percent);
+			return !progress.wasCanceled();
+		});
+	}
+	catch(QString & message) {
+		QMessageBox::warning(this, tr("Error"), tr("An error occured while "
+				"converting file ") + source + "<br><br>" + message);
+		return;
+	}
+
+	parseFileAndShowObject(target);
+}
+
 void MainWindow::exit()
 {
 	QApplication::exit();
@@ -359,6 +1107,48 @@ void MainWindow::resetView()
 	syncMenu();
 }
 
+void MainWindow::setClippingPlane()
+{
+	int plane = -1;
+	if (ui.actionClip_Xz->isChecked()) {
+		plane = 0;
+	} else if (ui.actionClip_Xy->isChecked()) {
+		plane = 1;
+	} else if (ui.actionClip_Yz->isChecked()) {
+		plane = 2;
+	}
+	glWidget->setClippingPlane(plane);
+}
+
+void MainWindow::moveClippingPlaneForward()
+{
+	glWidget->moveClippingPlane(0.02f);
+}
+
+void MainWindow::moveClippingPlaneBackward()
+{
+	glWidget->moveClippingPlane(-0.02f);
+}
+
+void MainWindow::showClipping()
+{
+	int axis = glWidget->clippingAxis();
+	if (axis < 0) {
+		statusBar()->clearMessage();
+		return;
+	}
+
+	const MeshSlicer::Slice & section = glWidget->section();
+	int points = 0;
+	for (int i = 0; i < section.polylines.size(); i++) {
+		points += section.polylines[i].points.size() / 3;
+	}
+	statusBar()->showMessage(tr("Clipping at %1 = %2, the section has %3 polylines with %4 points "
+			"(Shift+Wheel moves the plane)")
+			.arg(QString("xyz").at(axis)).arg(glWidget->clippingHeight())
+			.arg(section.polylines.size()).arg(points));
+}
+
 void MainWindow::toggleAxes()
 {
 	if (ui.actionShow_Coordinate_System->isChecked()) {
@@ -368,6 +1158,164 @@ void MainWindow::toggleAxes()
 	}
 }
 
+void MainWindow::toggleSoftwareRendering()
+{
+	if (ui.actionSoftware_Rendering->isChecked()) {
+		glWidget->setSoftwareRendering(true);
+	} else {
+		glWidget->setSoftwareRendering(false);
+	}
+}
+
+void MainWindow::togglePerformanceOverlay()
+{
+	if (ui.actionPerformance_Overlay->isChecked()) {
+		glWidget->setPerformanceOverlay(true);
+	} else {
+		glWidget->setPerformanceOverlay(false);
+	}
+}
+
+void MainWindow::showMemoryUsage()
+{
+	if (!scene) {
+		QMessageBox::information(this, tr("Memory Usage"),
+			tr("Memory usage is only available for loaded OFF files."));
+		return;
+	}
+
+	MemoryReport report = glWidget->memoryReport();
+	QString body = "<table>";
+	for (int i = 0; i < MemoryReport::CategoriesCount; i++) {
+		MemoryReport::Category category = static_cast<MemoryReport::Category>(i);
+		body += QString("<tr><td>%1</td><td align=\"right\">%2</td></tr>")
+			.arg(MemoryReport::label(category))
+			.arg(MemoryReport::formatBytes(report.bytes(category)));
+	}
+	body += QString("<tr><td><b>%1</b></td><td align=\"right\"><b>%2</b></td></tr></table>")
+		.arg(tr("Total"))
+		.arg(MemoryReport::formatBytes(report.total()));
+
+	body += "<p>";
+	if (!streamLoader) {
+		openedFile.refresh();
+		body += tr("File size: %1").arg(MemoryReport::formatBytes(openedFile.size())) + "<br>";
+	}
+	if (scene->polygonsCount() > 0) {
+		body += tr("Memory per polygon: %1 bytes")
+			.arg(report.total() / scene->polygonsCount());
+	}
+	body += "</p>";
+
+	QMessageBox::information(this, tr("Memory Usage"), body);
+}
+
+void MainWindow::checkMesh()
+{
+	if (!scene) {
+		QMessageBox::information(this, tr("Check Mesh"),
+			tr("Only scenes in memory can be checked."));
+		return;
+	}
+	if (streamLoader && !streamLoader->isFinished()) {
+		QMessageBox::information(this, tr("Check Mesh"),
+			tr("The scene can be checked when the standard input is read completely."));
+		return;
+	}
+	if (meshCheckPending) {
+		return;
+	}
+
+	// The scene must not change until the check has finished or was canceled
+	const IScene *checked = scene;
+	const QAtomicInt *stop = &meshCheckAbort;
+	meshCheckPending = true;
+	meshCheckTimer.start();
+	statusBar()->showMessage(tr("Checking %1 polygons...").arg(scene->polygonsCount()));
+	meshCheck.setFuture(QtConcurrent::run([checked, stop]() {
+		return MeshValidator::validate(checked, stop);
+	}));
+}
+
+void MainWindow::meshCheckFinished()
+{
+	// A canceled check may finish after its scene was replaced
+	if (!meshCheckPending) {
+		return;
+	}
+	meshCheckPending = false;
+	MeshValidator::Report report = meshCheck.result();
+	qint64 elapsed = meshCheckTimer.elapsed();
+	statusBar()->clearMessage();
+
+	QString text = MeshValidator::describe(report) + "\n\n"
+		+ tr("Checked %1 polygons in %2 s").arg(scene->polygonsCount()).arg(elapsed / 1000.0);
+	if (report.isValid()) {
+		glWidget->setDefects(QVector<int>(), QVector<int>());
+		QMessageBox::information(this, tr("Check Mesh"), text);
+		return;
+	}
+
+	text += "\n\n" + tr("Highlight the defective polygons and vertices?");
+	if (QMessageBox::question(this, tr("Check Mesh"), text,
+			QMessageBox::Yes | QMessageBox::No) == QMessageBox::Yes) {
+		glWidget->setDefects(report.polygons, report.vertices);
+	} else {
+		glWidget->setDefects(QVector<int>(), QVector<int>());
+	}
+}
+
+int MainWindow::componentsCount() const
+{
+	// The widget labels the components with the hierarchy of the scene
+	const MeshComponents* components = glWidget->components();
+	return components ? components->count() : -1;
+}
+
+void MainWindow::cancelMeshCheck()
+{
+	if (meshCheck.isRunning()) {
+		meshCheckAbort.store(1);
+		meshCheck.waitForFinished();
+		meshCheckAbort.store(0);
+	}
+	meshCheckPending = false;
+}
+
+void MainWindow::hidePickedComponent()
+{
+	int component = glWidget->pickedComponent();
+	if (component < 0) {
+		statusBar()->showMessage(tr("Click on a polygon to select its component first."));
+		return;
+	}
+
+	glWidget->setComponentHidden(component, true);
+	statusBar()->showMessage(tr("Component %1 hidden, %2 of %3 components are hidden")
+			.arg(component).arg(glWidget->hiddenComponentsCount())
+			.arg(glWidget->components()->count()));
+}
+
+void MainWindow::isolatePickedComponent()
+{
+	int component = glWidget->pickedComponent();
+	if (component < 0) {
+		statusBar()->showMessage(tr("Click on a polygon to select its component first."));
+		return;
+	}
+
+	glWidget->isolateComponent(component);
+	statusBar()->showMessage(tr("Component %1 isolated, %2 of %3 components are hidden")
+			.arg(component).arg(glWidget->hiddenComponentsCount())
+			.arg(glWidget->components()->count()));
+}
+
+void MainWindow::showAllComponents()
+{
+	glWidget->showAllComponents();
+	statusBar()->clearMessage();
+}
+
 void MainWindow::toggleXzPlane()
 {
 	if (ui.actionXz_Plane->isChecked()) {
@@ -401,6 +1349,12 @@ void MainWindow::syncMenu()
 	ui.actionXz_Plane->setChecked(glWidget->xzPlane());
 	ui.actionXy_Plane->setChecked(glWidget->xyPlane());
 	ui.actionYz_Plane->setChecked(glWidget->yzPlane());
+	ui.actionClip_None->setChecked(glWidget->clippingPlane() < 0);
+	ui.actionClip_Xz->setChecked(glWidget->clippingPlane() == 0);
+	ui.actionClip_Xy->setChecked(glWidget->clippingPlane() == 1);
+	ui.actionClip_Yz->setChecked(glWidget->clippingPlane() == 2);
+	ui.actionSoftware_Rendering->setChecked(glWidget->softwareRendering());
+	ui.actionPerformance_Overlay->setChecked(glWidget->performanceOverlay());
 }
 
 void MainWindow::help()
@@ -422,6 +1376,54 @@ void MainWindow::setRenderMode()
 	statusBar()->showMessage(glWidget->renderModeName() + tr(" activated"));
 }
 
+void MainWindow::showPickedPolygon(int polygonIndex, int vertexIndex)
+{
+	if (!scene || polygonIndex < 0) {
+		statusBar()->clearMessage();
+		return;
+	}
+
+	const CPolygon* polygon = scene->polygon(polygonIndex);
+	QStringList indices;
+	for (size_t i = 0; i < polygon->vertexCount(); ++i) {
+		indices.append(QString::number(polygon->vertexIndex(i)));
+	}
+
+	// The stored normal vectors are not normalized
+	const float* n = polygon->normal();
+	float length = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+	if (length == 0.0f) {
+		length = 1.0f;
+	}
+
+	QString polygonColor = polygon->isColored() ?
+			polygon->color().name(QColor::HexArgb) : tr("none");
+	// The scene sorts its polygons, so the number in the file is shown
+	QString message = tr("Polygon %1: vertices %2, normal (%3, %4, %5), color %6")
+			.arg(polygon->fileIndex()).arg(indices.join(", "))
+			.arg(n[0] / length, 0, 'f', 3).arg(n[1] / length, 0, 'f', 3)
+			.arg(n[2] / length, 0, 'f', 3).arg(polygonColor);
+
+	if (vertexIndex >= 0) {
+		const CVertex* vertex = scene->vertex(vertexIndex);
+		QString vertexColor = vertex->isColored() ?
+				vertex->color().name(QColor::HexArgb) : tr("none");
+		message += tr(" | Vertex %1: (%2, %3, %4), color %5")
+				.arg(vertexIndex).arg(vertex->x()).arg(vertex->y())
+				.arg(vertex->z()).arg(vertexColor);
+	}
+
+	const MeshComponents* components = glWidget->components();
+	if (components) {
+		int component = components->componentOf(polygonIndex);
+		message += tr(" | Component %1 of %2: %3 polygons")
+				.arg(component).arg(components->count())
+				.arg(components->component(component).count);
+	}
+
+	statusBar()->showMessage(message);
+}
+
 void MainWindow::about()
 {
 	QString body = tr("<h3>About OffView version %1</h3>"
@@ -1,9 +1,15 @@
 #pragma once
 
 #include <QtGui>
+#include <QFutureWatcher>
 
 #include "ui_MainWindow.h"
 #include "GlWidget.h"
+#include "SceneCache.h"
+#include "SequencePlayer.h"
+#include "StreamLoader.h"
+#include "StatisticsPanel.h"
+#include "MeshValidator.h"
 #include "Version.h"
 
 /**
@@ -105,6 +111,22 @@ private:
 	 */
 	void parseFileAndShowObject(const QString & fileToOpen);
 
+	/**
+	 * @brief Reads an OFF file from stdin and shows it while it arrives.
+	 *
+	 * Used for the file name "-", like in "generator | offview -".
+	 *
+	 * @see StreamLoader
+	 */
+	void openStandardInput();
+
+	/**
+	 * @brief Select the best available render mode for a scene.
+	 *
+	 * @param[in] colored Has the scene colors?
+	 */
+	void selectRenderMode(bool colored);
+
 	/**
 	 * @brief Set the main window title.
 	 *
@@ -149,6 +171,91 @@ private:
 	 */
 	bool checkDragAndDropData(const QMimeData* mimeData, QString* filePath = 0) const;
 
+	/**
+	 * @brief Puts a file at the top of the recent files.
+	 *
+	 * The list is saved in the settings. The snapshot of a file that
+	 * drops out of the list is deleted.
+	 *
+	 * @param[in] file Absolute path of the file.
+	 */
+	void addRecentFile(const QString & file);
+
+	/**
+	 * @brief Returns the openable files in the folder of the opened file.
+	 *
+	 * The list is sorted by name and only read again when the folder
+	 * changes or the opened file is missing in it.
+	 */
+	QStringList filesInFolder();
+
+	/**
+	 * @brief Opens the file before or after the opened file in its folder.
+	 *
+	 * @param[in] step 1 for the next file, -1 for the previous file.
+	 */
+	void openFileInFolder(int step);
+
+	/**
+	 * @brief Loads the files next to the opened file in the background.
+	 *
+	 * @see SceneCache::prefetch()
+	 */
+	void prefetchNeighbours();
+
+	/**
+	 * @brief Watches the opened file for changes, if enabled.
+	 *
+	 * Only scenes in memory are watched, tiled scenes are not.
+	 */
+	void watchOpenedFile();
+
+	/**
+	 * @brief Stops the playback of a frame sequence.
+	 *
+	 * The scene is reloaded from the opened file, because it shows
+	 * another frame now.
+	 */
+	void stopSequence();
+
+	/**
+	 * @brief Changes a setting that affects the loaded scenes.
+	 *
+	 * The cached scenes are dropped and the opened file is loaded again.
+	 *
+	 * @param[in] key Name of the setting.
+	 * @param[in] value New value of the setting.
+	 */
+	void changeLoadOption(const QString & key, const QVariant & value);
+
+	/**
+	 * @brief Returns the load options of the settings.
+	 *
+	 * @return The options for SceneFactory::openFile().
+	 */
+	SceneFactory::LoadOptions loadOptions() const;
+
+	/**
+	 * @brief Describes what was removed from a scene while loading.
+	 *
+	 * @return The text for the status bar or an empty string.
+	 */
+	QString cleanReportText(const IScene* loadedScene) const;
+
+	/**
+	 * @brief Stops a running mesh check and drops its result.
+	 *
+	 * Has to be called before the checked scene changes or is deleted.
+	 *
+	 * @see checkMesh()
+	 */
+	void cancelMeshCheck();
+
+	/**
+	 * @brief Returns the number of connected components of the shown scene or -1.
+	 */
+	int componentsCount() const;
+
 private slots:
 	/**
 	 * @brief Shows an "Open File" dialog.
@@ -170,6 +277,37 @@ private slots:
 	 */
 	void close();
 
+	/**
+	 * @brief Saves the shown scene as an OFF file.
+	 *
+	 * Asks for the target file and whether it should be a text, a binary
+	 * or a quantized file and writes it with a progress dialog.
+	 *
+	 * @see OffWriter
+	 * @see QuantizedFile
+	 */
+	void saveAs();
+
+	/**
+	 * @brief Converts an .off file into a tiled file for out-of-core viewing.
+	 *
+	 * Asks for the source and the target file, converts the file with
+	 * a progress dialog and opens the result.
+	 *
+	 * @see TileConverter
+	 */
+	void convertToTiles();
+
+	/**
+	 * @brief Cuts the shown scene into evenly spaced slices and saves them.
+	 *
+	 * Asks for the number of slices, their axis and the target file and
+	 * writes the polylines as Common Layer Interface file.
+	 *
+	 * @see MeshSlicer
+	 */
+	void exportSlices();
+
 	/**
 	 * @brief Tells the application to exit.
 	 */
@@ -213,11 +351,208 @@ private slots:
 	 */
 	void toggleYzPlane();
 
+	/**
+	 * @brief Cuts the scene with the plane checked in menu "View" -> "Clipping Plane".
+	 */
+	void setClippingPlane();
+
+	/**
+	 * @brief Moves the clipping plane along its axis in positive direction.
+	 */
+	void moveClippingPlaneForward();
+
+	/**
+	 * @brief Moves the clipping plane along its axis in negative direction.
+	 */
+	void moveClippingPlaneBackward();
+
+	/**
+	 * @brief Shows the position of the clipping plane and its section in the status bar.
+	 */
+	void showClipping();
+
 	/**
 	 * @brief Toggle coordinate axes visible/hidden.
 	 */
 	void toggleAxes();
 
+	/**
+	 * @brief Toggle between OpenGL and the software renderer.
+	 */
+	void toggleSoftwareRendering();
+
+	/**
+	 * @brief Toggle the performance overlay visible/hidden.
+	 */
+	void togglePerformanceOverlay();
+
+	/**
+	 * @brief Shows how much main memory the loaded scene uses.
+	 *
+	 * The memory is broken down into the categories of MemoryReport
+	 * and compared with the size of the file.
+	 */
+	void showMemoryUsage();
+
+	/**
+	 * @brief Starts the check of the loaded scene for defects.
+	 *
+	 * The check runs in the background, meshCheckFinished() shows the report.
+	 *
+	 * @see MeshValidator
+	 */
+	void checkMesh();
+
+	/**
+	 * @brief Shows the report of the finished mesh check.
+	 *
+	 * The defective polygons and vertices can be highlighted in the view.
+	 */
+	void meshCheckFinished();
+
+	/**
+	 * @brief Hides the connected component of the picked polygon.
+	 */
+	void hidePickedComponent();
+
+	/**
+	 * @brief Hides all connected components except the one of the picked polygon.
+	 */
+	void isolatePickedComponent();
+
+	/**
+	 * @brief Shows all hidden components again.
+	 */
+	void showAllComponents();
+
+	/**
+	 * @brief Fills the "Recent Files" menu before it is shown.
+	 *
+	 * Files whose scene is still in the SceneCache are marked, switching
+	 * to them is instant.
+	 */
+	void updateRecentFilesMenu();
+
+	/**
+	 * @brief Opens the file of the triggered "Recent Files" menu item.
+	 */
+	void openRecentFile();
+
+	/**
+	 * @brief Opens the next file in the folder of the opened file.
+	 */
+	void openNextFile();
+
+	/**
+	 * @brief Opens the previous file in the folder of the opened file.
+	 */
+	void openPreviousFile();
+
+	/**
+	 * @brief Asks for the memory budgets of the SceneCache.
+	 *
+	 * The budgets are saved in the settings.
+	 */
+	void setCacheBudget();
+
+	/**
+	 * @brief Enables/disables reloading the opened file when it changes.
+	 */
+	void toggleAutoReload();
+
+	/**
+	 * @brief Enables/disables merging close vertices when loading files.
+	 *
+	 * @see VertexWelder::clean()
+	 */
+	void toggleWeldVertices();
+
+	/**
+	 * @brief Asks for the distance of vertices which are merged.
+	 *
+	 * The tolerance is saved in the settings.
+	 */
+	void setWeldTolerance();
+
+	/**
+	 * @brief Restarts the delay before a changed file is reloaded.
+	 *
+	 * A file is often written in several steps, so the reload waits
+	 * until there was no change for a short time.
+	 */
+	void openedFileChanged();
+
+	/**
+	 * @brief Reloads the opened file in the background.
+	 *
+	 * @see SceneCache::reload()
+	 */
+	void reloadOpenedFile();
+
+	/**
+	 * @brief Stops the statistics and the mesh check before the current scene changes.
+	 */
+	void sceneAboutToChange(const IScene* changedScene);
+
+	/**
+	 * @brief Shows the reloaded vertices of the current scene.
+	 */
+	void sceneUpdated(const IScene* updatedScene);
+
+	/**
+	 * @brief Shows the new scene of a reloaded file, if it was the current scene.
+	 */
+	void sceneReplaced(const IScene* oldScene, IScene* newScene);
+
+	/**
+	 * @brief Reports a file that could not be reloaded.
+	 */
+	void reloadFailed(const QString & file, const QString & message);
+
+	/**
+	 * @brief Starts/stops the playback of the frames next to the opened file.
+	 *
+	 * @see SequencePlayer::findSequence()
+	 */
+	void toggleSequence();
+
+	/**
+	 * @brief Asks for the frame rate of the sequence playback.
+	 *
+	 * The frame rate is saved in the settings.
+	 */
+	void setSequenceFrameRate();
+
+	/**
+	 * @brief Shows the frame number, frame rate and dropped frames in the status bar.
+	 */
+	void sequenceFrameShown(int frame, int frames, double framesPerSecond, int dropped);
+
+	/**
+	 * @brief Reports a frame that could not be played.
+	 */
+	void sequenceFailed(const QString & file, const QString & message);
+
+	/**
+	 * @brief Lets the widget finish reading stdin's scene before it grows.
+	 */
+	void streamAboutToGrow();
+
+	/**
+	 * @brief Shows the part of stdin that was read so far.
+	 */
+	void streamGrown();
+
+	/**
+	 * @brief Reports that stdin was read completely.
+	 */
+	void streamFinished();
+
+	/**
+	 * @brief Reports invalid data on stdin.
+	 */
+	void streamFailed(const QString & message);
+
 	/**
 	 * @brief Set new render mode.
 	 *
@@ -283,6 +618,18 @@ private slots:
 	 */
 	void setLanguage(int actionLanguageIndex);
 
+	/**
+	 * @brief Show details about a picked polygon in the status bar.
+	 *
+	 * Connected to GlWidget::polygonPicked(). Shows the polygon index, its vertex
+	 * indices, normal vector and color and the coordinates and color of the
+	 * picked vertex.
+	 *
+	 * @param[in] polygonIndex Index of the picked polygon or -1.
+	 * @param[in] vertexIndex Index of the picked vertex or -1.
+	 */
+	void showPickedPolygon(int polygonIndex, int vertexIndex);
+
 private:
 	/**
 	 * @brief Grant access to the user interface.
@@ -312,6 +659,84 @@ private:
 	 */
 	IScene* scene;
 
+	/**
+	 * @brief Pointer to a tiled scene, which is streamed from the disk.
+	 *
+	 * Only one of scene and tileFile is set at the same time.
+	 *
+	 * @see GlWidget::setTileFile()
+	 */
+	TileFile* tileFile;
+
+	/**
+	 * @brief Owns the recently opened scenes, including the current scene.
+	 *
+	 * @see SceneCache
+	 */
+	SceneCache* sceneCache;
+
+	/**
+	 * @brief Reads stdin, owns the scene while it is shown, or null.
+	 *
+	 * @see openStandardInput()
+	 */
+	StreamLoader* streamLoader;
+
+	/**
+	 * @brief Plays the frame sequence of the opened file.
+	 *
+	 * @see toggleSequence()
+	 */
+	SequencePlayer* sequencePlayer;
+
+	/**
+	 * @brief Shows the statistics of the current scene.
+	 *
+	 * @see StatisticsPanel
+	 */
+	StatisticsPanel* statisticsPanel;
+
+	/**
+	 * @brief Reports the end of the mesh check.
+	 *
+	 * @see checkMesh()
+	 */
+	QFutureWatcher<MeshValidator::Report> meshCheck;
+
+	/**
+	 * @brief Tells the mesh check to stop.
+	 */
+	QAtomicInt meshCheckAbort;
+
+	/**
+	 * @brief Is a mesh check of the current scene running?
+	 */
+	bool meshCheckPending;
+
+	/**
+	 * @brief Measures the duration of the mesh check.
+	 */
+	QElapsedTimer meshCheckTimer;
+
+	/**
+	 * @brief Watches the opened file for changes.
+	 *
+	 * @see watchOpenedFile()
+	 */
+	QFileSystemWatcher* fileWatcher;
+
+	/**
+	 * @brief Delays the reload of a changed file.
+	 *
+	 * @see openedFileChanged()
+	 */
+	QTimer* reloadTimer;
+
+	/**
+	 * @brief Maximum number of entries in menu "File" -> "Recent Files".
+	 */
+	static const int maxRecentFiles = 10;
+
 	/**
 	 * @brief Saves all available render modes from menu "View" -> "Mode".
 	 *
@@ -334,6 +759,11 @@ private:
 	 */
 	QActionGroup* renderModesAlignmentGroup;
 
+	/**
+	 * @brief The planes from menu "View" -> "Clipping Plane", only one can be checked.
+	 */
+	QActionGroup* clippingGroup;
+
 	/**
 	 * @brief Contains a set of translations to a specific target language.
 	 *
@@ -348,6 +778,20 @@ private:
 	 */
 	QFileInfo openedFile;
 
+	/**
+	 * @brief Folder of the list folderFiles.
+	 *
+	 * @see filesInFolder()
+	 */
+	QString listedFolder;
+
+	/**
+	 * @brief File names in listedFolder that can be opened.
+	 *
+	 * @see filesInFolder()
+	 */
+	QStringList folderFiles;
+
 	/**
 	 * @brief To make out which item in the dynamically created Language menu has been selected.
 	 *
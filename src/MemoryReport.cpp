@@ -0,0 +1,74 @@
+#include "MemoryReport.h"
+
+MemoryReport::MemoryReport()
+{
+	for (int i = 0; i < CategoriesCount; i++) {
+		categories[i] = 0;
+	}
+}
+
+void MemoryReport::add(Category category, qint64 bytes)
+{
+	categories[category] += bytes;
+}
+
+void MemoryReport::add(const MemoryReport & other)
+{
+	for (int i = 0; i < CategoriesCount; i++) {
+		categories[i] += other.categories[i];
+	}
+}
+
+qint64 MemoryReport::bytes(Category category) const
+{
+	return categories[category];
+}
+
+qint64 MemoryReport::total() const
+{
+	qint64 sum = 0;
+	for (int i = 0; i < CategoriesCount; i++) {
+		sum += categories[i];
+	}
+	return sum;
+}
+
+QString MemoryReport::name(Category category)
+{
+	switch (category) {
+		case Positions: return "positions";
+		case Normals: return "normals";
+		case Colors: return "colors";
+		case Topology: return "topology";
+		case Adjacency: return "adjacency";
+		case Caches: return "caches";
+		case GpuMirrors: return "gpuMirrors";
+		default: return QString();
+	}
+}
+
+QString MemoryReport::formatBytes(qint64 bytes)
+{
+	if (bytes >= 1024 * 1024 * 1024) {
+		return tr("%1 GiB").arg(bytes / (1024.0 * 1024.0 * 1024.0), 0, 'f', 2);
+	} else if (bytes >= 1024 * 1024) {
+		return tr("%1 MiB").arg(bytes / (1024.0 * 1024.0), 0, 'f', 1);
+	} else if (bytes >= 1024) {
+		return tr("%1 KiB").arg(bytes / 1024.0, 0, 'f', 1);
+	}
+	return tr("%1 bytes").arg(bytes);
+}
+
+QString MemoryReport::label(Category category)
+{
+	switch (category) {
+		case Positions: return tr("Positions");
+		case Normals: return tr("Normals");
+		case Colors: return tr("Colors");
+		case Topology: return tr("Topology");
+		case Adjacency: return tr("Adjacency");
+		case Caches: return tr("Caches");
+		case GpuMirrors: return tr("GPU mirrors");
+		default: return QString();
+	}
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <QtCore>
+
+/**
+ * @brief Main memory used by a scene, broken down by purpose
+ *
+ * Scenes, hierarchies and render geometry add their bytes to the
+ * categories. The values are estimates: they include the objects, the
+ * array headers of Qt containers and the overhead of each heap block,
+ * but not the fragmentation of the heap.
+ *
+ * @see IScene::memoryReport()
+ */
+class MemoryReport
+{
+	Q_DECLARE_TR_FUNCTIONS(MemoryReport)
+
+public:
+	/**
+	 * @brief The categories of the report
+	 */
+	enum Category {
+		Positions,	///< Vertex coordinates
+		Normals,	///< Polygon and vertex normal vectors
+		Colors,		///< Vertex and polygon colors
+		Topology,	///< Polygon vertex lists, object pointers and allocation overhead
+		Adjacency,	///< Polygons of each vertex
+		Caches,		///< Hierarchies and other structures derived from the scene
+		GpuMirrors,	///< Render geometry kept in main memory
+		CategoriesCount
+	};
+
+	/**
+	 * @brief Constructor
+	 *
+	 * Sets all categories to zero.
+	 */
+	MemoryReport();
+
+	/**
+	 * @brief Adds bytes to a category
+	 */
+	void add(Category category, qint64 bytes);
+
+	/**
+	 * @brief Adds all categories of another report
+	 */
+	void add(const MemoryReport & other);
+
+	/**
+	 * @brief Returns the bytes of a category
+	 */
+	qint64 bytes(Category category) const;
+
+	/**
+	 * @brief Returns the sum of all categories
+	 */
+	qint64 total() const;
+
+	/**
+	 * @brief Returns the name of a category for reports
+	 */
+	static QString name(Category category);
+
+	/**
+	 * @brief Returns the translated name of a category for the user interface
+	 */
+	static QString label(Category category);
+
+	/**
+	 * @brief Formats a number of bytes with a binary prefix
+	 */
+	static QString formatBytes(qint64 bytes);
+
+	/**
+	 * @brief Estimated overhead of the heap for each allocated block
+	 */
+	static const int allocationOverhead = 2 * sizeof(void*);
+
+private:
+	qint64 categories[CategoriesCount];
+};
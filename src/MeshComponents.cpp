@@ -0,0 +1,227 @@
+#include <algorithm>
+#include <cfloat>
+
+#include "MeshComponents.h"
+#include "Parallel.h"
+#include "Trace.h"
+
+/**
+ * @brief Extends a bounding box (min xyz, max xyz) by the corners of a polygon
+ */
+static void extendBox(const CPolygon *polygon, float *box)
+{
+	int cv = static_cast<int>(polygon->vertexCount());
+	for (int j = 0; j < cv; j++) {
+		const float *data = polygon->vertex(j)->vertex();
+		for (int k = 0; k < 3; k++) {
+			box[k] = qMin(box[k], data[k]);
+			box[k+3] = qMax(box[k+3], data[k]);
+		}
+	}
+}
+
+/**
+ * @brief Sets a bounding box to the empty box
+ */
+static void clearBox(float *box)
+{
+	for (int k = 0; k < 3; k++) {
+		box[k] = FLT_MAX;
+		box[k+3] = -FLT_MAX;
+	}
+}
+
+MeshComponents::MeshComponents(const IScene *scene)
+{
+	TRACE_ZONE("MeshComponents::MeshComponents");
+	int pCount = scene->polygonsCount();
+	int vCount = scene->verticesCount();
+
+	QVector<QAtomicInteger<int> > parents(vCount);
+	QAtomicInteger<int> *parentData = parents.data();
+	Parallel::forBlocks(vCount, 1 << 14, [&](int begin, int end) {
+		for (int v = begin; v < end; v++) {
+			parentData[v].store(v);
+		}
+	});
+
+	// Each polygon connects its corners with its first corner
+	Parallel::forBlocks(pCount, 1 << 12, [&](int begin, int end) {
+		for (int p = begin; p < end; p++) {
+			const CPolygon *polygon = scene->polygon(p);
+			int cv = static_cast<int>(polygon->vertexCount());
+			for (int j = 1; j < cv; j++) {
+				unite(parentData, polygon->vertexIndex(0), polygon->vertexIndex(j));
+			}
+		}
+	});
+
+	// Sort the polygons by their root, the key contains the root in the
+	// upper and the polygon in the lower bits. Polygons without corners
+	// are components of their own.
+	QVector<quint64> keys(pCount);
+	quint64 *keyData = keys.data();
+	Parallel::forBlocks(pCount, 1 << 12, [&](int begin, int end) {
+		for (int p = begin; p < end; p++) {
+			const CPolygon *polygon = scene->polygon(p);
+			quint64 root = polygon->vertexCount() > 0
+				? quint64(find(parentData, polygon->vertexIndex(0))) : quint64(vCount) + p;
+			keyData[p] = root << 32 | quint32(p);
+		}
+	});
+	Parallel::sort(keys);
+
+	// Count the components that start in each block to number them
+	const int minBlockSize = 1 << 14;
+	int blocks = Parallel::blockCount(pCount, minBlockSize);
+	QVector<int> blockFirst(blocks + 1, 0);
+	Parallel::forEachBlock(pCount, minBlockSize, [&](int block, int begin, int end) {
+		int starts = 0;
+		for (int k = begin; k < end; k++) {
+			if (k == 0 || keys[k] >> 32 != keys[k - 1] >> 32) {
+				starts++;
+			}
+		}
+		blockFirst[block + 1] = starts;
+	});
+	for (int b = 0; b < blocks; b++) {
+		blockFirst[b + 1] += blockFirst[b];
+	}
+
+	// A thread handles the components that start in its block, even if they end behind it
+	components.resize(blockFirst[blocks]);
+	labels.resize(pCount);
+	order.resize(pCount);
+	Parallel::forEachBlock(pCount, minBlockSize, [&](int block, int begin, int end) {
+		int c = blockFirst[block];
+		for (int k = begin; k < end; k++) {
+			quint64 root = keys[k] >> 32;
+			if (k > 0 && keys[k - 1] >> 32 == root) {
+				continue;
+			}
+			int last = k + 1;
+			while (last < pCount && keys[last] >> 32 == root) {
+				last++;
+			}
+
+			components[c].first = k;
+			components[c].count = last - k;
+			for (int m = k; m < last; m++) {
+				int polygon = static_cast<int>(keys[m] & 0xFFFFFFFFu);
+				order[m] = polygon;
+				labels[polygon] = c;
+			}
+			c++;
+		}
+	});
+
+	updateBounds(scene);
+}
+
+void MeshComponents::updateBounds(const IScene *scene)
+{
+	TRACE_ZONE("MeshComponents::updateBounds");
+
+	// Large components are split among several blocks. Each block writes
+	// the components that lie completely inside of it and keeps the box
+	// of the first and the last component if they are cut by its borders.
+	int pCount = order.size();
+	const int minBlockSize = 1 << 14;
+	int blocks = Parallel::blockCount(pCount, minBlockSize);
+	QVector<float> partial(blocks * 12);
+	float *partials = partial.data();
+	Parallel::forEachBlock(pCount, minBlockSize, [&](int block, int begin, int end) {
+		float *head = partials + 12*block;
+		float *tail = head + 6;
+		clearBox(head);
+		clearBox(tail);
+		int k = begin;
+		while (k < end) {
+			Component & component = components[labels[order[k]]];
+			int last = qMin(component.first + component.count, end);
+			float box[6];
+			clearBox(box);
+			for (int m = k; m < last; m++) {
+				extendBox(scene->polygon(order[m]), box);
+			}
+
+			if (component.first >= begin && component.first + component.count <= end) {
+				std::copy(box, box + 3, component.min);
+				std::copy(box + 3, box + 6, component.max);
+			} else {
+				std::copy(box, box + 6, k == begin ? head : tail);
+			}
+			k = last;
+		}
+	});
+
+	// Combine the pieces of the cut components, they are in neighbouring blocks
+	int merged = -1;
+	for (int b = 0; b < blocks; b++) {
+		int begin = Parallel::blockBegin(b, pCount, minBlockSize);
+		int end = Parallel::blockBegin(b + 1, pCount, minBlockSize);
+		int first = labels[order[begin]];
+		int last = labels[order[end - 1]];
+		const float *pieces[2] = { partials + 12*b, partials + 12*b + 6 };
+		const int owners[2] = { first, last };
+		for (int i = 0; i < 2; i++) {
+			Component & component = components[owners[i]];
+			bool isCut = component.first < begin || component.first + component.count > end;
+			if (!isCut || (i == 1 && first == last)) {
+				continue;
+			}
+			if (owners[i] != merged) {
+				std::copy(pieces[i], pieces[i] + 3, component.min);
+				std::copy(pieces[i] + 3, pieces[i] + 6, component.max);
+				merged = owners[i];
+				continue;
+			}
+			for (int k = 0; k < 3; k++) {
+				component.min[k] = qMin(component.min[k], pieces[i][k]);
+				component.max[k] = qMax(component.max[k], pieces[i][k+3]);
+			}
+		}
+	}
+}
+
+qint64 MeshComponents::bytes() const
+{
+	return sizeof(MeshComponents)
+		+ static_cast<qint64>(labels.capacity()) * sizeof(int)
+		+ static_cast<qint64>(order.capacity()) * sizeof(int)
+		+ static_cast<qint64>(components.capacity()) * sizeof(Component);
+}
+
+int MeshComponents::find(QAtomicInteger<int> *parents, int v)
+{
+	int parent = parents[v].load();
+	while (parent != v) {
+		// Path halving, another thread may have changed the link already
+		int grandParent = parents[parent].load();
+		if (grandParent != parent) {
+			parents[v].testAndSetOrdered(parent, grandParent);
+		}
+		v = grandParent;
+		parent = parents[v].load();
+	}
+	return v;
+}
+
+void MeshComponents::unite(QAtomicInteger<int> *parents, int a, int b)
+{
+	while (true) {
+		a = find(parents, a);
+		b = find(parents, b);
+		if (a == b) {
+			return;
+		}
+		if (a < b) {
+			qSwap(a, b);
+		}
+
+		// Fails if another thread has linked the root a in the meantime
+		if (parents[a].testAndSetOrdered(a, b)) {
+			return;
+		}
+	}
+}
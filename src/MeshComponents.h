@@ -0,0 +1,137 @@
+#pragma once
+
+#include <QVector>
+#include <QAtomicInt>
+
+#include "IScene.h"
+
+/**
+ * @brief Connected components of the polygons of a scene
+ *
+ * Two polygons belong to the same component if they share a vertex,
+ * directly or through other polygons. The components are found with a
+ * union-find over the vertices: every polygon unites its corners. The
+ * threads unite the corners of their polygons at the same time, the links
+ * are set with compare and swap and always point from the larger to the
+ * smaller root, so each set ends up with its smallest vertex as root no
+ * matter in which order the threads ran.
+ *
+ * The polygons are then sorted by their root. The components are numbered
+ * in this order, which does not depend on the number of threads either.
+ *
+ * @see SceneBvh::components()
+ */
+class MeshComponents
+{
+public:
+	/**
+	 * @brief A set of polygons connected by shared vertices
+	 */
+	struct Component
+	{
+		/**
+		 * @brief Bounding box of all polygons of the component
+		 */
+		float min[3];
+		float max[3];
+
+		/**
+		 * @brief Position of the first polygon in polygonAt()
+		 */
+		int first;
+
+		/**
+		 * @brief Number of polygons
+		 */
+		int count;
+	};
+
+	/**
+	 * @brief Finds the components of all polygons of a scene in parallel
+	 *
+	 * @param [in] scene The scene, its polygons must only use existing vertices
+	 */
+	explicit MeshComponents(const IScene *scene);
+
+	/**
+	 * @brief Returns the number of components
+	 */
+	int count() const
+	{
+		return components.size();
+	}
+
+	/**
+	 * @brief Getter for the components
+	 *
+	 * @param [in] i Number of the component, from 0 to count()-1
+	 * @return The selected component
+	 */
+	const Component & component(int i) const
+	{
+		return components[i];
+	}
+
+	/**
+	 * @brief Returns the component of a polygon
+	 */
+	int componentOf(int polygon) const
+	{
+		return labels[polygon];
+	}
+
+	/**
+	 * @brief Returns the polygons sorted by their component
+	 *
+	 * Inside of a component the polygons keep their order in the scene.
+	 *
+	 * @param [in] i Position in the sorted order
+	 * @return Index of the polygon in the scene
+	 */
+	int polygonAt(int i) const
+	{
+		return order[i];
+	}
+
+	/**
+	 * @brief Calculates the bounding boxes again after vertices were moved
+	 *
+	 * @param [in] scene The scene the components were found for
+	 */
+	void updateBounds(const IScene *scene);
+
+	/**
+	 * @brief Returns the main memory used by the components
+	 * @return Number of bytes
+	 */
+	qint64 bytes() const;
+
+private:
+	/**
+	 * @brief Returns the root of a vertex and halves the path to it
+	 *
+	 * @param parents The parent of each vertex, roots are their own parent
+	 * @param [in] v Number of the vertex
+	 */
+	static int find(QAtomicInteger<int> *parents, int v);
+
+	/**
+	 * @brief Links the sets of two vertices, the larger root below the smaller one
+	 */
+	static void unite(QAtomicInteger<int> *parents, int a, int b);
+
+	/**
+	 * @brief Component of each polygon
+	 */
+	QVector<int> labels;
+
+	/**
+	 * @brief Polygon indices sorted by component
+	 */
+	QVector<int> order;
+
+	/**
+	 * @brief All components in ascending order of their smallest vertex
+	 */
+	QVector<Component> components;
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <QColor>
+#include <QVector>
+
+/**
+ * @brief Vertex and polygon arrays of a mesh that is read from a file
+ *
+ * The readers of the binary formats fill these arrays in parallel, before
+ * OffScene::fromMesh() creates the vertex and polygon objects. Polygon i
+ * uses the vertex numbers indices[offsets[i]] to indices[offsets[i+1]-1].
+ * An invalid color means no color, empty color arrays mean no colors at all.
+ *
+ * @see OffScene::fromMesh()
+ * @see VertexWelder
+ */
+struct MeshData
+{
+	/**
+	 * @brief x, y and z of each vertex
+	 */
+	QVector<float> positions;
+
+	/**
+	 * @brief Normal vector of each vertex or empty to calculate them
+	 */
+	QVector<float> normals;
+
+	/**
+	 * @brief Color of each vertex or empty
+	 */
+	QVector<QColor> vertexColors;
+
+	/**
+	 * @brief First index of each polygon, followed by the number of indices
+	 */
+	QVector<int> offsets;
+
+	/**
+	 * @brief Vertex numbers of all polygons
+	 */
+	QVector<int> indices;
+
+	/**
+	 * @brief Color of each polygon or empty
+	 */
+	QVector<QColor> polygonColors;
+
+	/**
+	 * @brief Number of each polygon in the file or empty if nothing was removed
+	 */
+	QVector<int> fileIndices;
+
+	/**
+	 * @brief Returns the number of vertices
+	 */
+	int verticesCount() const
+	{
+		return positions.size() / 3;
+	}
+
+	/**
+	 * @brief Returns the number of polygons
+	 */
+	int polygonsCount() const
+	{
+		return qMax(0, offsets.size() - 1);
+	}
+};
@@ -0,0 +1,288 @@
+#include <algorithm>
+#include <cfloat>
+
+#include <QSaveFile>
+
+#include "MeshSlicer.h"
+#include "OffWriter.h"
+#include "Parallel.h"
+#include "Trace.h"
+
+MeshSlicer::MeshSlicer(const IScene *scene, const SceneBvh *bvh)
+{
+	this->scene = scene;
+	this->bvh = bvh;
+}
+
+MeshSlicer::Slice MeshSlicer::slice(int axis, float height, const QVector<bool> *hidden) const
+{
+	TRACE_ZONE("MeshSlicer::slice");
+	return cut(axis, height, hidden, true);
+}
+
+QVector<MeshSlicer::Slice> MeshSlicer::slices(int axis, int count) const
+{
+	TRACE_ZONE("MeshSlicer::slices");
+	QVector<Slice> result(qMax(0, count));
+	if (count <= 0 || bvh->chunksCount() == 0) {
+		return result;
+	}
+
+	float minimum = FLT_MAX;
+	float maximum = -FLT_MAX;
+	for (int c = 0; c < bvh->chunksCount(); c++) {
+		minimum = qMin(minimum, bvh->chunk(c).min[axis]);
+		maximum = qMax(maximum, bvh->chunk(c).max[axis]);
+	}
+
+	// Each plane cuts its own chunks, so the planes are the parallel work
+	double thickness = (double(maximum) - minimum) / count;
+	Parallel::forBlocks(count, 1, [&](int begin, int end) {
+		for (int i = begin; i < end; i++) {
+			float height = static_cast<float>(minimum + (i + 0.5) * thickness);
+			result[i] = cut(axis, height, nullptr, false);
+		}
+	});
+	return result;
+}
+
+MeshSlicer::Slice MeshSlicer::cut(int axis, float height, const QVector<bool> *hidden,
+	bool parallel) const
+{
+	QVector<int> crossing;
+	for (int c = 0; c < bvh->chunksCount(); c++) {
+		const SceneBvh::Chunk & chunk = bvh->chunk(c);
+		if (height >= chunk.min[axis] && height <= chunk.max[axis]) {
+			crossing.append(c);
+		}
+	}
+
+	QVector<Segment> segments;
+	if (parallel) {
+		// Each block keeps its segments, they are joined in the order of the chunks
+		int blocks = Parallel::blockCount(crossing.size(), 1);
+		QVector<QVector<Segment> > blockSegments(blocks);
+		Parallel::forEachBlock(crossing.size(), 1, [&](int block, int begin, int end) {
+			QVector<int> polygons;
+			for (int i = begin; i < end; i++) {
+				cutChunk(crossing[i], axis, height, hidden, &polygons, &blockSegments[block]);
+			}
+		});
+		for (int b = 0; b < blocks; b++) {
+			segments += blockSegments[b];
+		}
+	} else {
+		QVector<int> polygons;
+		for (int i = 0; i < crossing.size(); i++) {
+			cutChunk(crossing[i], axis, height, hidden, &polygons, &segments);
+		}
+	}
+
+	Slice result;
+	result.height = height;
+	chain(segments, &result);
+	return result;
+}
+
+void MeshSlicer::cutChunk(int chunk, int axis, float height, const QVector<bool> *hidden,
+	QVector<int> *polygons, QVector<Segment> *segments) const
+{
+	// Chunks are shared by several components, so hidden ones are skipped per polygon
+	bvh->crossingPolygons(chunk, axis, height, polygons);
+	for (int i = 0; i < polygons->size(); i++) {
+		if (hidden && hidden->at(bvh->components().componentOf(polygons->at(i)))) {
+			continue;
+		}
+		const CPolygon *polygon = scene->polygon(polygons->at(i));
+		int cv = static_cast<int>(polygon->vertexCount());
+		if (cv < 3) {
+			continue;
+		}
+
+		bool anyAbove = false;
+		bool anyBelow = false;
+		for (int j = 0; j < cv; j++) {
+			bool above = polygon->vertex(j)->vertex()[axis] >= height;
+			anyAbove = anyAbove || above;
+			anyBelow = anyBelow || !above;
+		}
+		if (!anyAbove || !anyBelow) {
+			continue;
+		}
+
+		// A triangle of the fan is crossed twice, once downwards and once
+		// upwards. The segment runs from the first to the second crossing.
+		for (int j = 1; j + 1 < cv; j++) {
+			const int corners[3] = { 0, j, j + 1 };
+			Segment segment;
+			int found = 0;
+			for (int e = 0; e < 3; e++) {
+				int u = corners[e];
+				int w = corners[(e + 1) % 3];
+				const float *pu = polygon->vertex(u)->vertex();
+				const float *pw = polygon->vertex(w)->vertex();
+				bool aboveU = pu[axis] >= height;
+				if (aboveU == (pw[axis] >= height)) {
+					continue;
+				}
+
+				int end = aboveU ? 0 : 1;
+				int low = aboveU ? w : u;
+				int high = aboveU ? u : w;
+				const float *pLow = aboveU ? pw : pu;
+				const float *pHigh = aboveU ? pu : pw;
+				quint32 lowIndex = polygon->vertexIndex(low);
+				quint32 highIndex = polygon->vertexIndex(high);
+				float *point = segment.points + 3*end;
+				if (pHigh[axis] == height) {
+					segment.keys[end] = quint64(highIndex) << 32 | highIndex;
+					std::copy(pHigh, pHigh + 3, point);
+				} else {
+					double t = (double(height) - pLow[axis]) / (double(pHigh[axis]) - pLow[axis]);
+					for (int k = 0; k < 3; k++) {
+						point[k] = static_cast<float>(pLow[k] + t * (double(pHigh[k]) - pLow[k]));
+					}
+					point[axis] = height;
+					segment.keys[end] = quint64(lowIndex) << 32 | highIndex;
+				}
+				found++;
+			}
+
+			// A triangle touching the plane with one corner gives a point
+			if (found == 2 && segment.keys[0] != segment.keys[1]) {
+				segments->append(segment);
+			}
+		}
+	}
+}
+
+void MeshSlicer::chain(const QVector<Segment> & segments, Slice *slice)
+{
+	// Sorting the ends by their edge puts the ends which meet next to each other
+	int count = segments.size();
+	QVector<SegmentEnd> ends(2 * count);
+	for (int s = 0; s < count; s++) {
+		for (int k = 0; k < 2; k++) {
+			ends[2*s + k].key = segments[s].keys[k];
+			ends[2*s + k].end = 2*s + k;
+		}
+	}
+	std::sort(ends.begin(), ends.end(), [](const SegmentEnd & a, const SegmentEnd & b) {
+		return a.key < b.key || (a.key == b.key && a.end < b.end);
+	});
+
+	// Pairs of ends are connected, a third end at the same edge stays open
+	QVector<int> partners(2 * count, -1);
+	for (int i = 0; i + 1 < ends.size(); i++) {
+		if (ends[i].key == ends[i + 1].key) {
+			partners[ends[i].end] = ends[i + 1].end;
+			partners[ends[i + 1].end] = ends[i].end;
+			i++;
+		}
+	}
+
+	// Open polylines start at an unconnected end, the remaining segments form loops
+	QVector<bool> visited(count, false);
+	for (int pass = 0; pass < 2; pass++) {
+		for (int start = 0; start < 2 * count; start++) {
+			if (visited[start / 2] || (pass == 0 && partners[start] >= 0)) {
+				continue;
+			}
+
+			Polyline polyline;
+			polyline.closed = false;
+			const float *first = segments[start / 2].points + 3 * (start % 2);
+			polyline.points.append(first[0]);
+			polyline.points.append(first[1]);
+			polyline.points.append(first[2]);
+			int end = start;
+			while (true) {
+				visited[end / 2] = true;
+				int other = end ^ 1;
+				int next = partners[other];
+				if (next == start) {
+					polyline.closed = true;
+					break;
+				}
+				const float *point = segments[other / 2].points + 3 * (other % 2);
+				polyline.points.append(point[0]);
+				polyline.points.append(point[1]);
+				polyline.points.append(point[2]);
+				if (next < 0 || visited[next / 2]) {
+					break;
+				}
+				end = next;
+			}
+			slice->polylines.append(polyline);
+		}
+	}
+}
+
+void MeshSlicer::writeCli(const QString & fileName, int axis, const QVector<Slice> & slices)
+{
+	TRACE_ZONE("MeshSlicer::writeCli");
+
+	// Right handed axes inside of the planes, so counter-clockwise is seen from above
+	const int planeAxes[3][2] = { { 1, 2 }, { 2, 0 }, { 0, 1 } };
+	int u = planeAxes[axis][0];
+	int v = planeAxes[axis][1];
+
+	// The layers are independent, each block formats its own layers
+	int blocks = Parallel::blockCount(slices.size(), 1);
+	QVector<QByteArray> buffers(blocks);
+	Parallel::forEachBlock(slices.size(), 1, [&](int block, int begin, int end) {
+		QByteArray & buffer = buffers[block];
+		char number[OffWriter::maxFloatChars + 1];
+		for (int i = begin; i < end; i++) {
+			const Slice & slice = slices[i];
+			buffer += "$$LAYER/";
+			buffer.append(number, static_cast<int>(OffWriter::formatFloat(slice.height, number) - number));
+			buffer += '\n';
+			for (int p = 0; p < slice.polylines.size(); p++) {
+				const Polyline & polyline = slice.polylines[p];
+				int points = polyline.points.size() / 3;
+
+				// 0 marks inner contours, 1 outer contours and 2 open lines
+				int direction = 2;
+				if (polyline.closed) {
+					double area = 0.0;
+					for (int j = 0; j < points; j++) {
+						const float *a = polyline.points.constData() + 3*j;
+						const float *b = polyline.points.constData() + 3*((j + 1) % points);
+						area += double(a[u]) * b[v] - double(b[u]) * a[v];
+					}
+					direction = area > 0.0 ? 1 : 0;
+				}
+
+				// Closed contours repeat their first point
+				int written = polyline.closed ? points + 1 : points;
+				buffer += "$$POLYLINE/1," + QByteArray::number(direction) + ","
+					+ QByteArray::number(written);
+				for (int j = 0; j < written; j++) {
+					const float *point = polyline.points.constData() + 3*(j % points);
+					buffer += ',';
+					buffer.append(number, static_cast<int>(OffWriter::formatFloat(point[u], number) - number));
+					buffer += ',';
+					buffer.append(number, static_cast<int>(OffWriter::formatFloat(point[v], number) - number));
+				}
+				buffer += '\n';
+			}
+		}
+	});
+
+	QSaveFile file(fileName);
+	if (!file.open(QIODevice::WriteOnly)) {
+		throw tr("Unable to open file ") + fileName;
+	}
+	QByteArray header = "$$HEADERSTART\n$$ASCII\n$$UNITS/1\n$$VERSION/200\n$$LAYERS/"
+		+ QByteArray::number(slices.size()) + "\n$$HEADEREND\n$$GEOMETRYSTART\n";
+	QByteArray footer = "$$GEOMETRYEND\n";
+	bool written = file.write(header) == header.size();
+	for (int b = 0; b < blocks && written; b++) {
+		written = file.write(buffers[b]) == buffers[b].size();
+	}
+	written = written && file.write(footer) == footer.size();
+	if (!written || !file.commit()) {
+		throw tr("Unable to write file ") + fileName;
+	}
+}
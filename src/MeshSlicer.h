@@ -0,0 +1,167 @@
+#pragma once
+
+#include <QtCore>
+
+#include "IScene.h"
+#include "SceneBvh.h"
+
+/**
+ * @brief Cuts a scene with axis aligned planes into polylines
+ *
+ * Only the chunks of the SceneBvh whose bounding box reaches the plane are
+ * visited, and inside of them only the leaves touching it, so a cut costs
+ * little more than the polygons it actually crosses. The polygons are split
+ * into triangle fans like OpenGL does for GL_POLYGON. Each triangle that
+ * crosses the plane gives one segment between two of its edges.
+ *
+ * The end points of the segments are exact: a point on an edge is always
+ * interpolated from the vertex below to the vertex above the plane, so both
+ * polygons of the edge calculate the same float values. Vertices exactly on
+ * the plane count as above it, polygons lying in the plane are left out.
+ * The segments are joined at their shared edges, not by comparing
+ * positions, which gives closed polylines for closed surfaces. Edges of
+ * more than two polygons end the polylines that meet there.
+ *
+ * A single cut is parallel over the crossing chunks, several cuts are
+ * parallel over the planes.
+ *
+ * @see GlWidget::setClippingPlane()
+ */
+class MeshSlicer
+{
+	Q_DECLARE_TR_FUNCTIONS(MeshSlicer)
+
+public:
+	/**
+	 * @brief A chain of connected segments
+	 */
+	struct Polyline
+	{
+		/**
+		 * @brief Coordinates of the points, three per point
+		 */
+		QVector<float> points;
+
+		/**
+		 * @brief Is the last point connected to the first?
+		 *
+		 * The first point is not repeated at the end.
+		 */
+		bool closed;
+	};
+
+	/**
+	 * @brief All polylines of one plane
+	 */
+	struct Slice
+	{
+		/**
+		 * @brief The coordinate of the plane on its axis
+		 */
+		float height;
+
+		QVector<Polyline> polylines;
+	};
+
+	/**
+	 * @brief Constructor
+	 *
+	 * @param [in] scene The scene which is cut
+	 * @param [in] bvh The hierarchy of the scene
+	 */
+	MeshSlicer(const IScene *scene, const SceneBvh *bvh);
+
+	/**
+	 * @brief Cuts the scene with one plane
+	 *
+	 * @param [in] axis The normal of the plane, 0 for X, 1 for Y and 2 for Z
+	 * @param [in] height The coordinate of the plane on its axis
+	 * @param [in] hidden Components whose polygons are skipped, indexed by component, may be null
+	 * @return The polylines in scene coordinates
+	 */
+	Slice slice(int axis, float height, const QVector<bool> *hidden = nullptr) const;
+
+	/**
+	 * @brief Cuts the scene with evenly spaced planes
+	 *
+	 * The bounding box of the scene is divided into layers of equal
+	 * thickness along the axis, each layer is cut in its middle.
+	 *
+	 * @param [in] axis The normal of the planes, 0 for X, 1 for Y and 2 for Z
+	 * @param [in] count Number of planes
+	 * @return The slices from the lowest to the highest plane
+	 */
+	QVector<Slice> slices(int axis, int count) const;
+
+	/**
+	 * @brief Writes slices as ASCII file in the Common Layer Interface format
+	 *
+	 * CLI is read by the machines and tools of additive manufacturing. The
+	 * coordinates inside of a layer are the two other axes in right handed
+	 * order, so closed polylines which run counter-clockwise seen from
+	 * above are marked as outer contours. Throws a QString on errors.
+	 *
+	 * @param [in] fileName Path of the new file
+	 * @param [in] axis The normal of the planes
+	 * @param [in] slices The slices from the lowest to the highest plane
+	 */
+	static void writeCli(const QString & fileName, int axis, const QVector<Slice> & slices);
+
+private:
+	/**
+	 * @brief A piece of a polygon inside of the plane
+	 */
+	struct Segment
+	{
+		/**
+		 * @brief The crossed edge of each end
+		 *
+		 * The vertex below the plane in the upper and the vertex above in
+		 * the lower 32 bits, or the same vertex twice if the end lies on it.
+		 */
+		quint64 keys[2];
+
+		/**
+		 * @brief Coordinates of both ends
+		 */
+		float points[6];
+	};
+
+	/**
+	 * @brief One end of a segment, sorted by its edge when joining
+	 */
+	struct SegmentEnd
+	{
+		quint64 key;
+
+		/**
+		 * @brief Two times the segment plus 0 for the first or 1 for the second end
+		 */
+		int end;
+	};
+
+	/**
+	 * @brief Cuts the scene with one plane
+	 *
+	 * @param [in] parallel Cut the chunks in parallel?
+	 */
+	Slice cut(int axis, float height, const QVector<bool> *hidden, bool parallel) const;
+
+	/**
+	 * @brief Cuts the polygons of one chunk
+	 *
+	 * @param [in] hidden Components whose polygons are skipped, may be null
+	 * @param [in, out] polygons Buffer for the crossing polygons
+	 * @param [out] segments Receives the segments of the chunk
+	 */
+	void cutChunk(int chunk, int axis, float height, const QVector<bool> *hidden,
+		QVector<int> *polygons, QVector<Segment> *segments) const;
+
+	/**
+	 * @brief Joins segments at their shared edges into polylines
+	 */
+	static void chain(const QVector<Segment> & segments, Slice *slice);
+
+	const IScene *scene;
+	const SceneBvh *bvh;
+};
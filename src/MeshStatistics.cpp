@@ -0,0 +1,304 @@
+#include <cfloat>
+#include <cmath>
+
+#include "MeshStatistics.h"
+#include "HalfEdgeMesh.h"
+#include "MeshComponents.h"
+#include "Parallel.h"
+#include "Trace.h"
+
+MeshStatistics::Report MeshStatistics::compute(const IScene *scene, const HalfEdgeMesh & halfEdges,
+	int components, const QAtomicInt *abort)
+{
+	TRACE_ZONE("MeshStatistics::compute");
+	Report report = Report();
+	report.polygons = scene->polygonsCount();
+	report.boundaryLoops = -1;
+	report.genus = -1;
+	for (int k = 0; k < 3; k++) {
+		report.min[k] = FLT_MAX;
+		report.max[k] = -FLT_MAX;
+	}
+
+	// Area, volume and number of corners of the polygons
+	int pCount = scene->polygonsCount();
+	const int polygonBlockSize = 1 << 12;
+	int polygonBlocks = Parallel::blockCount(pCount, polygonBlockSize);
+	QVector<double> blockArea(polygonBlocks, 0.0);
+	QVector<double> blockVolume(polygonBlocks, 0.0);
+	QVector<QVector<int> > blockValences(polygonBlocks);
+	// Each block checks the abort flag, so a stopped calculation ends soon
+	Parallel::forEachBlock(pCount, polygonBlockSize, [&](int block, int begin, int end) {
+		if (abort && abort->load()) {
+			return;
+		}
+		double area = 0.0;
+		double volume = 0.0;
+		QVector<int> & valences = blockValences[block];
+		for (int p = begin; p < end; p++) {
+			const CPolygon *polygon = scene->polygon(p);
+			int cv = static_cast<int>(polygon->vertexCount());
+			if (valences.size() <= cv) {
+				valences.resize(cv + 1);
+			}
+			valences[cv]++;
+			if (cv < 3) {
+				continue;
+			}
+
+			// The cross products of the triangle fan add up to twice the
+			// area vector, the fan also yields the signed volume of the cone
+			// from the origin
+			const float *a = polygon->vertex(0)->vertex();
+			double normal[3] = { 0.0, 0.0, 0.0 };
+			for (int j = 1; j + 1 < cv; j++) {
+				const float *b = polygon->vertex(j)->vertex();
+				const float *c = polygon->vertex(j + 1)->vertex();
+				double ab[3] = { double(b[0]) - a[0], double(b[1]) - a[1], double(b[2]) - a[2] };
+				double ac[3] = { double(c[0]) - a[0], double(c[1]) - a[1], double(c[2]) - a[2] };
+				normal[0] += ab[1]*ac[2] - ab[2]*ac[1];
+				normal[1] += ab[2]*ac[0] - ab[0]*ac[2];
+				normal[2] += ab[0]*ac[1] - ab[1]*ac[0];
+				volume += (double(a[0]) * (double(b[1])*c[2] - double(b[2])*c[1])
+					+ double(a[1]) * (double(b[2])*c[0] - double(b[0])*c[2])
+					+ double(a[2]) * (double(b[0])*c[1] - double(b[1])*c[0])) / 6.0;
+			}
+			area += 0.5 * std::sqrt(normal[0]*normal[0] + normal[1]*normal[1] + normal[2]*normal[2]);
+		}
+		blockArea[block] = area;
+		blockVolume[block] = volume;
+	});
+	for (int b = 0; b < polygonBlocks; b++) {
+		report.area += blockArea[b];
+		report.volume += blockVolume[b];
+		const QVector<int> & valences = blockValences[b];
+		if (report.valences.size() < valences.size()) {
+			report.valences.resize(valences.size());
+		}
+		for (int i = 0; i < valences.size(); i++) {
+			report.valences[i] += valences[i];
+		}
+	}
+	if (abort && abort->load()) {
+		return report;
+	}
+
+	// Bounding box of the used vertices. A vertex is not a manifold if the
+	// fan around it does not reach all of its half-edges.
+	int vCount = halfEdges.verticesCount();
+	int hCount = halfEdges.halfEdgesCount();
+	QVector<QAtomicInt> degrees(vCount);
+	QAtomicInt *degreeData = degrees.data();
+	Parallel::forBlocks(hCount, 1 << 14, [&](int begin, int end) {
+		if (abort && abort->load()) {
+			return;
+		}
+		for (int h = begin; h < end; h++) {
+			degreeData[halfEdges.origin(h)].fetchAndAddOrdered(1);
+		}
+	});
+	const int vertexBlockSize = 1 << 14;
+	int vertexBlocks = Parallel::blockCount(vCount, vertexBlockSize);
+	QVector<float> blockBounds(vertexBlocks * 6);
+	QVector<int> blockUsed(vertexBlocks, 0);
+	QVector<int> blockNonManifold(vertexBlocks, 0);
+	Parallel::forEachBlock(vCount, vertexBlockSize, [&](int block, int begin, int end) {
+		float *box = blockBounds.data() + 6*block;
+		for (int k = 0; k < 3; k++) {
+			box[k] = FLT_MAX;
+			box[k+3] = -FLT_MAX;
+		}
+		if (abort && abort->load()) {
+			return;
+		}
+		for (int v = begin; v < end; v++) {
+			int start = halfEdges.vertexHalfEdge(v);
+			if (start == HalfEdgeMesh::none) {
+				continue;
+			}
+			blockUsed[block]++;
+			const float *data = scene->vertex(v)->vertex();
+			for (int k = 0; k < 3; k++) {
+				box[k] = qMin(box[k], data[k]);
+				box[k+3] = qMax(box[k+3], data[k]);
+			}
+
+			int fan = 0;
+			int h = start;
+			do {
+				fan++;
+				h = halfEdges.nextAroundVertex(h);
+			} while (h != HalfEdgeMesh::none && h != start && fan <= hCount);
+			if (fan != degreeData[v].load()) {
+				blockNonManifold[block]++;
+			}
+		}
+	});
+	for (int b = 0; b < vertexBlocks; b++) {
+		const float *box = blockBounds.constData() + 6*b;
+		for (int k = 0; k < 3; k++) {
+			report.min[k] = qMin(report.min[k], box[k]);
+			report.max[k] = qMax(report.max[k], box[k+3]);
+		}
+		report.vertices += blockUsed[b];
+		report.nonManifoldVertices += blockNonManifold[b];
+	}
+	if (abort && abort->load()) {
+		return report;
+	}
+
+	// Edge lengths, an edge with two polygons is counted by the half-edge
+	// with the smaller number, all half-edges of non-manifold edges count
+	const int edgeBlockSize = 1 << 14;
+	int edgeBlocks = Parallel::blockCount(hCount, edgeBlockSize);
+	QVector<double> blockSum(edgeBlocks, 0.0);
+	QVector<double> blockSquares(edgeBlocks, 0.0);
+	QVector<double> blockMin(edgeBlocks, DBL_MAX);
+	QVector<double> blockMax(edgeBlocks, 0.0);
+	QVector<int> blockCount(edgeBlocks, 0);
+	Parallel::forEachBlock(hCount, edgeBlockSize, [&](int block, int begin, int end) {
+		if (abort && abort->load()) {
+			return;
+		}
+		for (int h = begin; h < end; h++) {
+			int twin = halfEdges.twin(h);
+			int a = halfEdges.origin(h);
+			int b = halfEdges.target(h);
+			if ((twin != HalfEdgeMesh::none && twin < h) || a == b) {
+				continue;
+			}
+			const float *p = scene->vertex(a)->vertex();
+			const float *q = scene->vertex(b)->vertex();
+			double dx = double(q[0]) - p[0];
+			double dy = double(q[1]) - p[1];
+			double dz = double(q[2]) - p[2];
+			double squared = dx*dx + dy*dy + dz*dz;
+			double length = std::sqrt(squared);
+			blockSum[block] += length;
+			blockSquares[block] += squared;
+			blockMin[block] = qMin(blockMin[block], length);
+			blockMax[block] = qMax(blockMax[block], length);
+			blockCount[block]++;
+		}
+	});
+	double sum = 0.0;
+	double squares = 0.0;
+	qint64 count = 0;
+	report.minEdgeLength = DBL_MAX;
+	for (int b = 0; b < edgeBlocks; b++) {
+		sum += blockSum[b];
+		squares += blockSquares[b];
+		count += blockCount[b];
+		report.minEdgeLength = qMin(report.minEdgeLength, blockMin[b]);
+		report.maxEdgeLength = qMax(report.maxEdgeLength, blockMax[b]);
+	}
+	if (count > 0) {
+		report.meanEdgeLength = sum / count;
+		double variance = squares / count - report.meanEdgeLength * report.meanEdgeLength;
+		report.edgeLengthDeviation = std::sqrt(qMax(0.0, variance));
+	} else {
+		report.minEdgeLength = 0.0;
+	}
+	if (abort && abort->load()) {
+		return report;
+	}
+
+	// Edges with two half-edges in opposite directions are inside of the
+	// surface, all other edges are either boundaries or non-manifold
+	int interiorEdges = (hCount - halfEdges.boundaryHalfEdgesCount()
+		- halfEdges.nonManifoldHalfEdgesCount()) / 2;
+	report.edges = halfEdges.edgesCount();
+	report.boundaryEdges = halfEdges.boundaryHalfEdgesCount();
+	report.nonManifoldEdges = report.edges - interiorEdges - report.boundaryEdges;
+	report.components = components >= 0 ? components : MeshComponents(scene).count();
+	report.eulerCharacteristic = report.vertices - report.edges + report.polygons;
+	if (halfEdges.nonManifoldHalfEdgesCount() > 0 || report.nonManifoldVertices > 0) {
+		return report;
+	}
+
+	// The boundary half-edge that follows a boundary half-edge is found by
+	// turning around its end vertex until the next boundary
+	QVector<int> successors(hCount, HalfEdgeMesh::none);
+	Parallel::forBlocks(hCount, 1 << 14, [&](int begin, int end) {
+		if (abort && abort->load()) {
+			return;
+		}
+		for (int h = begin; h < end; h++) {
+			if (!halfEdges.isBoundary(h)) {
+				continue;
+			}
+			int g = halfEdges.next(h);
+			while (!halfEdges.isBoundary(g)) {
+				g = halfEdges.next(halfEdges.twin(g));
+			}
+			successors[h] = g;
+		}
+	});
+	if (abort && abort->load()) {
+		return report;
+	}
+	QVector<bool> visited(hCount, false);
+	report.boundaryLoops = 0;
+	for (int h = 0; h < hCount; h++) {
+		if (successors[h] == HalfEdgeMesh::none || visited[h]) {
+			continue;
+		}
+		report.boundaryLoops++;
+		for (int g = h; !visited[g]; g = successors[g]) {
+			visited[g] = true;
+		}
+	}
+
+	// Each component has the characteristic 2 - 2 * genus - boundary loops
+	int twiceGenus = 2 * report.components - report.eulerCharacteristic - report.boundaryLoops;
+	if (twiceGenus >= 0 && twiceGenus % 2 == 0) {
+		report.genus = twiceGenus / 2;
+	}
+	return report;
+}
+
+QString MeshStatistics::describe(const Report & report)
+{
+	QStringList lines;
+	lines.append(tr("Polygons: %1, vertices: %2, edges: %3")
+		.arg(report.polygons).arg(report.vertices).arg(report.edges));
+	lines.append(tr("Connected components: %1").arg(report.components));
+	if (report.vertices > 0) {
+		lines.append(tr("Bounding box: (%1, %2, %3) to (%4, %5, %6)")
+			.arg(report.min[0]).arg(report.min[1]).arg(report.min[2])
+			.arg(report.max[0]).arg(report.max[1]).arg(report.max[2]));
+	}
+	lines.append(tr("Surface area: %1").arg(report.area));
+	if (report.boundaryEdges > 0 || report.nonManifoldEdges > 0) {
+		lines.append(tr("Enclosed volume: %1 (the surface is not closed)").arg(report.volume));
+	} else {
+		lines.append(tr("Enclosed volume: %1").arg(report.volume));
+	}
+	lines.append(tr("Edge length: min %1, max %2, mean %3, deviation %4")
+		.arg(report.minEdgeLength).arg(report.maxEdgeLength)
+		.arg(report.meanEdgeLength).arg(report.edgeLengthDeviation));
+	if (report.boundaryLoops >= 0) {
+		lines.append(tr("Boundary edges: %1 in %2 loops")
+			.arg(report.boundaryEdges).arg(report.boundaryLoops));
+	} else {
+		lines.append(tr("Boundary edges: %1").arg(report.boundaryEdges));
+	}
+	lines.append(tr("Non-manifold edges: %1, non-manifold vertices: %2")
+		.arg(report.nonManifoldEdges).arg(report.nonManifoldVertices));
+	if (report.genus >= 0) {
+		lines.append(tr("Euler characteristic: %1, genus: %2")
+			.arg(report.eulerCharacteristic).arg(report.genus));
+	} else {
+		lines.append(tr("Euler characteristic: %1, genus: not defined for non-manifold meshes")
+			.arg(report.eulerCharacteristic));
+	}
+
+	QStringList valences;
+	for (int i = 0; i < report.valences.size(); i++) {
+		if (report.valences[i] > 0) {
+			valences.append(tr("%1 corners: %2").arg(i).arg(report.valences[i]));
+		}
+	}
+	lines.append(tr("Polygons by corners: %1").arg(valences.join(", ")));
+	return lines.join("\n");
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <QtCore>
+
+#include "IScene.h"
+
+class HalfEdgeMesh;
+
+/**
+ * @brief Measures the size and the topology of a scene
+ *
+ * All sums are parallel reductions: each block of polygons or half-edges
+ * of the global thread pool writes its partial result into its own slot,
+ * the slots are combined afterwards in the order of the blocks.
+ *
+ * The topology is taken from the half-edges. The Euler characteristic
+ * counts the used vertices, the edges and the polygons. The genus follows
+ * from it together with the number of connected components and boundary
+ * loops, it is only defined if no edge has more than two polygons.
+ */
+class MeshStatistics
+{
+	Q_DECLARE_TR_FUNCTIONS(MeshStatistics)
+
+public:
+	/**
+	 * @brief Result of compute()
+	 */
+	struct Report
+	{
+		int vertices;			///< Vertices used by polygons
+		int edges;				///< Pairs of vertices connected by polygon sides
+		int polygons;			///< All polygons
+		int components;			///< Sets of polygons connected by shared vertices
+		int boundaryEdges;		///< Edges of one polygon
+		int nonManifoldEdges;	///< Edges of more than two polygons or two in the same direction
+		int nonManifoldVertices;	///< Vertices where separate fans of polygons touch
+		int boundaryLoops;		///< Closed chains of boundary edges, -1 if not defined
+		int eulerCharacteristic;	///< vertices - edges + polygons
+		int genus;				///< Number of handles, -1 if not defined
+
+		double area;			///< Sum of the polygon areas
+		double volume;			///< Signed volume enclosed by the polygons, negative if they face inwards
+
+		float min[3];			///< Bounding box of the used vertices
+		float max[3];
+
+		double minEdgeLength;	///< Shortest edge
+		double maxEdgeLength;	///< Longest edge
+		double meanEdgeLength;	///< Average edge length
+		double edgeLengthDeviation;	///< Standard deviation of the edge lengths
+
+		/**
+		 * @brief Number of polygons with each number of corners
+		 */
+		QVector<int> valences;
+	};
+
+	/**
+	 * @brief Measures a scene
+	 *
+	 * @param [in] scene The scene, its polygons must only use existing vertices
+	 * @param [in] halfEdges The half-edges of the scene
+	 * @param [in] components Number of connected components if already known, -1 to find them
+	 * @param [in] abort Stops the calculation soon if set, may be null
+	 * @return The measurements, incomplete if the calculation was stopped
+	 */
+	static Report compute(const IScene *scene, const HalfEdgeMesh & halfEdges,
+		int components, const QAtomicInt *abort = nullptr);
+
+	/**
+	 * @brief Formats a report as text with one line per value
+	 */
+	static QString describe(const Report & report);
+};
@@ -0,0 +1,407 @@
+#include <algorithm>
+#include <cmath>
+
+#include "MeshValidator.h"
+#include "CPolygon.h"
+#include "Parallel.h"
+#include "Trace.h"
+
+const float MeshValidator::zeroAreaRatio = 1e-6f;
+
+bool MeshValidator::Report::isValid() const
+{
+	return invalidIndexPolygons == 0 && repeatedIndexPolygons == 0 && zeroAreaPolygons == 0
+		&& duplicatePolygons == 0 && nonManifoldEdges == 0 && flippedEdges == 0
+		&& nonManifoldVertices == 0 && unreferencedVertices == 0;
+}
+
+MeshValidator::Report MeshValidator::validate(const IScene *scene, const QAtomicInt *abort)
+{
+	TRACE_ZONE("MeshValidator::validate");
+	Report report = Report();
+	int pCount = scene->polygonsCount();
+	int vCount = scene->verticesCount();
+
+	// The corners of polygon p are numbered from firstCorner[p] to firstCorner[p+1]-1
+	QVector<int> firstCorner(pCount + 1);
+	firstCorner[0] = 0;
+	for (int p = 0; p < pCount; p++) {
+		firstCorner[p + 1] = firstCorner[p] + int(scene->polygon(p)->vertexCount());
+	}
+	int corners = firstCorner[pCount];
+
+	QVector<int> polygonFlags(pCount);
+	QVector<SortKey> edges(corners);
+	QVector<quint64> incidence(corners);
+	Parallel::forBlocks(pCount, 1 << 12, [&](int begin, int end) {
+		for (int p = begin; p < end; p++) {
+			polygonFlags[p] = checkPolygon(scene, p);
+			const CPolygon *polygon = scene->polygon(p);
+			int n = int(polygon->vertexCount());
+			for (int j = 0; j < n; j++) {
+				int corner = firstCorner[p] + j;
+				SortKey & edge = edges[corner];
+				edge.element = corner;
+				edge.forward = 0;
+				if (polygonFlags[p] & InvalidIndex) {
+					edge.key = noKey;
+					incidence[corner] = noKey;
+					continue;
+				}
+				int a = polygon->vertexIndex(j);
+				int b = polygon->vertexIndex((j + 1) % n);
+				edge.key = a == b ? noKey
+					: quint64(qMin(a, b)) << 32 | quint32(qMax(a, b));
+				edge.forward = a < b;
+				incidence[corner] = quint64(a) << 32 | quint32(corner);
+			}
+		}
+	});
+
+	// Edges of the same vertex pair follow each other
+	Parallel::sort(edges, [](const SortKey & a, const SortKey & b) {
+		return a.key < b.key || (a.key == b.key && a.element < b.element);
+	});
+
+	// A thread handles the runs that start in its block, even if they end behind it
+	const int minBlockSize = 1 << 14;
+	int blocks = Parallel::blockCount(corners, minBlockSize);
+	QVector<int> nonManifold(blocks, 0);
+	QVector<int> flipped(blocks, 0);
+	QVector<int> boundary(blocks, 0);
+	QVector<uchar> cornerFlags(corners, 0);
+	Parallel::forEachBlock(corners, minBlockSize, [&](int block, int begin, int end) {
+		for (int k = begin; k < end; k++) {
+			quint64 key = edges[k].key;
+			if (key == noKey || (k > 0 && edges[k - 1].key == key)) {
+				continue;
+			}
+			int last = k + 1;
+			while (last < corners && edges[last].key == key) {
+				last++;
+			}
+
+			if (last - k == 1) {
+				boundary[block]++;
+			} else if (last - k == 2) {
+				if (edges[k].forward == edges[k + 1].forward) {
+					flipped[block]++;
+					cornerFlags[edges[k].element] = FlippedEdge;
+					cornerFlags[edges[k + 1].element] = FlippedEdge;
+				}
+			} else {
+				nonManifold[block]++;
+				for (int m = k; m < last; m++) {
+					cornerFlags[edges[m].element] = NonManifoldEdge;
+				}
+			}
+		}
+	});
+	for (int b = 0; b < blocks; b++) {
+		report.nonManifoldEdges += nonManifold[b];
+		report.flippedEdges += flipped[b];
+		report.boundaryEdges += boundary[b];
+	}
+	edges = QVector<SortKey>();
+	if (abort && abort->load()) {
+		return report;
+	}
+
+	// The corners of each vertex follow each other, the left out ones are at the end
+	Parallel::sort(incidence);
+	auto vertexOf = [&](int k) {
+		return incidence[k] == noKey ? vCount : int(incidence[k] >> 32);
+	};
+	QVector<int> vertexStart(vCount + 1);
+	Parallel::forBlocks(corners, 1 << 16, [&](int begin, int end) {
+		for (int k = begin; k < end; k++) {
+			int previous = k > 0 ? vertexOf(k - 1) : -1;
+			for (int v = previous + 1; v <= vertexOf(k); v++) {
+				vertexStart[v] = k;
+			}
+		}
+	});
+	for (int v = corners > 0 ? vertexOf(corners - 1) + 1 : 0; v <= vCount; v++) {
+		vertexStart[v] = corners;
+	}
+
+	QVector<uchar> vertexFlags(vCount, 0);
+	Parallel::forBlocks(vCount, 1 << 12, [&](int begin, int end) {
+		QVector<int> neighbours;
+		QVector<quint64> pairs;
+		QVector<int> parents;
+		for (int v = begin; v < end; v++) {
+			int count = vertexStart[v + 1] - vertexStart[v];
+			if (count == 0) {
+				vertexFlags[v] = Unreferenced;
+				continue;
+			}
+
+			neighbours.resize(2 * count);
+			for (int i = 0; i < count; i++) {
+				int corner = int(incidence[vertexStart[v] + i] & 0xffffffffu);
+				int p = int(std::upper_bound(firstCorner.constBegin(), firstCorner.constEnd(), corner)
+					- firstCorner.constBegin()) - 1;
+				const CPolygon *polygon = scene->polygon(p);
+				int n = int(polygon->vertexCount());
+				int j = corner - firstCorner[p];
+				neighbours[2 * i] = polygon->vertexIndex((j + n - 1) % n);
+				neighbours[2 * i + 1] = polygon->vertexIndex((j + 1) % n);
+			}
+			if (countFans(neighbours, count, &pairs, &parents) > 1) {
+				vertexFlags[v] = NonManifoldVertex;
+			}
+		}
+	});
+
+	if (abort && abort->load()) {
+		return report;
+	}
+
+	// Polygons with the same sorted vertices have the same hash, the left out ones have none
+	QVector<SortKey> hashes(pCount);
+	Parallel::forBlocks(pCount, 1 << 12, [&](int begin, int end) {
+		QVector<int> sorted;
+		for (int p = begin; p < end; p++) {
+			hashes[p].element = p;
+			hashes[p].forward = 0;
+			if (polygonFlags[p] & InvalidIndex) {
+				hashes[p].key = noKey;
+				continue;
+			}
+			sortedIndices(scene, p, &sorted);
+			hashes[p].key = hashPolygon(sorted);
+		}
+	});
+	// The scene is sorted by transparency, so equal polygons are ordered by their number in the file
+	Parallel::sort(hashes, [scene](const SortKey & a, const SortKey & b) {
+		return a.key < b.key || (a.key == b.key &&
+			scene->polygon(a.element)->fileIndex() < scene->polygon(b.element)->fileIndex());
+	});
+	QVector<uchar> duplicates(pCount, 0);
+	Parallel::forBlocks(pCount, 1 << 14, [&](int begin, int end) {
+		QVector<QVector<int> > sorted;
+		for (int k = begin; k < end; k++) {
+			quint64 key = hashes[k].key;
+			if (key == noKey || (k > 0 && hashes[k - 1].key == key)) {
+				continue;
+			}
+			int last = k + 1;
+			while (last < pCount && hashes[last].key == key) {
+				last++;
+			}
+			if (last - k == 1) {
+				continue;
+			}
+
+			// The polygons of the run are in the order of the file, the first one is kept
+			sorted.resize(last - k);
+			for (int m = k; m < last; m++) {
+				sortedIndices(scene, hashes[m].element, &sorted[m - k]);
+				for (int l = k; l < m; l++) {
+					if (sorted[l - k] == sorted[m - k]) {
+						duplicates[hashes[m].element] = 1;
+						break;
+					}
+				}
+			}
+		}
+	});
+	hashes = QVector<SortKey>();
+
+	Parallel::forBlocks(pCount, 1 << 14, [&](int begin, int end) {
+		for (int p = begin; p < end; p++) {
+			for (int corner = firstCorner[p]; corner < firstCorner[p + 1]; corner++) {
+				polygonFlags[p] |= cornerFlags[corner];
+			}
+			if (duplicates[p]) {
+				polygonFlags[p] |= Duplicate;
+			}
+		}
+	});
+
+	for (int p = 0; p < pCount; p++) {
+		int flags = polygonFlags[p];
+		if (flags == 0) {
+			continue;
+		}
+		report.polygons.append(p);
+		report.fileIndices.append(scene->polygon(p)->fileIndex());
+		report.invalidIndexPolygons += (flags & InvalidIndex) != 0;
+		report.repeatedIndexPolygons += (flags & RepeatedIndex) != 0;
+		report.zeroAreaPolygons += (flags & ZeroArea) != 0;
+		report.duplicatePolygons += (flags & Duplicate) != 0;
+	}
+	for (int v = 0; v < vCount; v++) {
+		int flags = vertexFlags[v];
+		if (flags == 0) {
+			continue;
+		}
+		report.vertices.append(v);
+		report.nonManifoldVertices += (flags & NonManifoldVertex) != 0;
+		report.unreferencedVertices += (flags & Unreferenced) != 0;
+	}
+	return report;
+}
+
+QString MeshValidator::describe(const Report & report)
+{
+	QStringList lines;
+	if (report.invalidIndexPolygons > 0) {
+		lines.append(tr("%1 polygons with vertex numbers out of range")
+			.arg(report.invalidIndexPolygons));
+	}
+	if (report.repeatedIndexPolygons > 0) {
+		lines.append(tr("%1 polygons which use a vertex twice").arg(report.repeatedIndexPolygons));
+	}
+	if (report.zeroAreaPolygons > 0) {
+		lines.append(tr("%1 polygons without area").arg(report.zeroAreaPolygons));
+	}
+	if (report.duplicatePolygons > 0) {
+		lines.append(tr("%1 duplicate polygons").arg(report.duplicatePolygons));
+	}
+	if (report.nonManifoldEdges > 0) {
+		lines.append(tr("%1 edges shared by more than two polygons").arg(report.nonManifoldEdges));
+	}
+	if (report.flippedEdges > 0) {
+		lines.append(tr("%1 edges between polygons of opposite orientation")
+			.arg(report.flippedEdges));
+	}
+	if (report.nonManifoldVertices > 0) {
+		lines.append(tr("%1 vertices where separate surfaces touch")
+			.arg(report.nonManifoldVertices));
+	}
+	if (report.unreferencedVertices > 0) {
+		lines.append(tr("%1 vertices without polygons").arg(report.unreferencedVertices));
+	}
+	if (lines.isEmpty()) {
+		lines.append(tr("No defects found"));
+	} else if (!report.fileIndices.isEmpty()) {
+		// The numbers in the file are what other programs show
+		QVector<int> numbers = report.fileIndices;
+		std::sort(numbers.begin(), numbers.end());
+		QStringList first;
+		for (int i = 0; i < qMin(numbers.size(), int(listedPolygons)); i++) {
+			first.append(QString::number(numbers[i]));
+		}
+		if (numbers.size() > listedPolygons) {
+			first.append("...");
+		}
+		lines.append(tr("Defective polygons in the file: %1").arg(first.join(", ")));
+	}
+	if (report.boundaryEdges > 0) {
+		lines.append(tr("%1 boundary edges, the surface is open").arg(report.boundaryEdges));
+	}
+	return lines.join("\n");
+}
+
+int MeshValidator::checkPolygon(const IScene *scene, int polygon)
+{
+	const CPolygon *poly = scene->polygon(polygon);
+	int n = int(poly->vertexCount());
+	int vCount = scene->verticesCount();
+	for (int j = 0; j < n; j++) {
+		int index = poly->vertexIndex(j);
+		if (index < 0 || index >= vCount) {
+			return InvalidIndex;
+		}
+	}
+
+	int flags = 0;
+	if (n <= 16) {
+		for (int j = 1; j < n && !flags; j++) {
+			for (int l = 0; l < j; l++) {
+				if (poly->vertexIndex(j) == poly->vertexIndex(l)) {
+					flags = RepeatedIndex;
+					break;
+				}
+			}
+		}
+	} else {
+		QVector<int> sorted;
+		sortedIndices(scene, polygon, &sorted);
+		if (std::adjacent_find(sorted.constBegin(), sorted.constEnd()) != sorted.constEnd()) {
+			flags = RepeatedIndex;
+		}
+	}
+
+	// The Newell normal is as long as the doubled area
+	double normal[3] = {0.0, 0.0, 0.0};
+	double longest = 0.0;
+	for (int j = 0; j < n; j++) {
+		const float *a = poly->vertex(j)->vertex();
+		const float *b = poly->vertex((j + 1) % n)->vertex();
+		normal[0] += (double(a[1]) - b[1]) * (double(a[2]) + b[2]);
+		normal[1] += (double(a[2]) - b[2]) * (double(a[0]) + b[0]);
+		normal[2] += (double(a[0]) - b[0]) * (double(a[1]) + b[1]);
+		double dx = double(a[0]) - b[0], dy = double(a[1]) - b[1], dz = double(a[2]) - b[2];
+		longest = qMax(longest, dx * dx + dy * dy + dz * dz);
+	}
+	double area = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+	if (area <= zeroAreaRatio * longest) {
+		flags |= ZeroArea;
+	}
+	return flags;
+}
+
+int MeshValidator::countFans(const QVector<int> & neighbours, int count,
+	QVector<quint64> *pairs, QVector<int> *parents)
+{
+	if (count == 1) {
+		return 1;
+	}
+
+	// Corners which share a neighbour share an edge, so they are in the same fan
+	pairs->resize(2 * count);
+	for (int i = 0; i < 2 * count; i++) {
+		(*pairs)[i] = quint64(quint32(neighbours[i])) << 32 | quint32(i / 2);
+	}
+	std::sort(pairs->begin(), pairs->end());
+
+	parents->resize(count);
+	for (int i = 0; i < count; i++) {
+		(*parents)[i] = i;
+	}
+	auto root = [&](int i) {
+		while ((*parents)[i] != i) {
+			(*parents)[i] = (*parents)[(*parents)[i]];
+			i = (*parents)[i];
+		}
+		return i;
+	};
+	int fans = count;
+	for (int i = 1; i < 2 * count; i++) {
+		quint64 a = (*pairs)[i - 1], b = (*pairs)[i];
+		if (a >> 32 != b >> 32) {
+			continue;
+		}
+		int rootA = root(int(a & 0xffffffffu));
+		int rootB = root(int(b & 0xffffffffu));
+		if (rootA != rootB) {
+			(*parents)[qMax(rootA, rootB)] = qMin(rootA, rootB);
+			fans--;
+		}
+	}
+	return fans;
+}
+
+quint64 MeshValidator::hashPolygon(const QVector<int> & sorted)
+{
+	quint64 hash = 1469598103934665603ull;
+	for (int index : sorted) {
+		hash = (hash ^ quint32(index)) * 1099511628211ull;
+		hash ^= hash >> 29;
+	}
+	return hash != noKey ? hash : 0;
+}
+
+void MeshValidator::sortedIndices(const IScene *scene, int polygon, QVector<int> *sorted)
+{
+	const CPolygon *poly = scene->polygon(polygon);
+	int n = int(poly->vertexCount());
+	sorted->resize(n);
+	for (int j = 0; j < n; j++) {
+		(*sorted)[j] = poly->vertexIndex(j);
+	}
+	std::sort(sorted->begin(), sorted->end());
+}
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <QtCore>
+
+#include "IScene.h"
+
+/**
+ * @brief Finds defects in the polygons of a scene
+ *
+ * The checks run on demand, so loading a valid file costs nothing. All
+ * passes are split into blocks for the global thread pool:
+ *
+ * - Each polygon is checked for vertex numbers out of range, repeated
+ *   vertices and a (nearly) zero area.
+ * - The edges of all polygons are sorted by their vertex pair. An edge of
+ *   one polygon is a boundary, an edge of more than two polygons is non
+ *   manifold and two polygons which run through their shared edge in the
+ *   same direction have opposite orientations.
+ * - The corners are sorted by their vertex. A vertex without corners is
+ *   unreferenced, a vertex whose polygons form more than one fan around
+ *   it (a "bow tie") is non manifold.
+ * - Polygons with the same set of vertices as an earlier one in the file
+ *   are duplicates.
+ *
+ * Polygons with vertex numbers out of range are left out of the later passes.
+ * The polygons are reported by their index in the scene, which sorts them by
+ * transparency, and by their number in the file.
+ */
+class MeshValidator
+{
+	Q_DECLARE_TR_FUNCTIONS(MeshValidator)
+
+public:
+	/**
+	 * @brief Result of validate()
+	 */
+	struct Report
+	{
+		int invalidIndexPolygons;	///< Polygons with a vertex number out of range
+		int repeatedIndexPolygons;	///< Polygons which use a vertex twice
+		int zeroAreaPolygons;		///< Polygons without area
+		int duplicatePolygons;		///< Polygons with the vertices of an earlier polygon
+		int nonManifoldEdges;		///< Edges of more than two polygons
+		int flippedEdges;			///< Edges of two polygons with opposite orientation
+		int boundaryEdges;			///< Edges of one polygon, not a defect of open meshes
+		int nonManifoldVertices;	///< Vertices with more than one fan of polygons
+		int unreferencedVertices;	///< Vertices without polygons
+
+		/**
+		 * @brief The polygons with a defect in ascending order
+		 */
+		QVector<int> polygons;
+
+		/**
+		 * @brief The number in the file of each polygon in polygons
+		 *
+		 * @see CPolygon::fileIndex()
+		 */
+		QVector<int> fileIndices;
+
+		/**
+		 * @brief The vertices with a defect in ascending order
+		 */
+		QVector<int> vertices;
+
+		/**
+		 * @brief Are there no defects? Boundary edges do not count.
+		 */
+		bool isValid() const;
+	};
+
+	/**
+	 * @brief Checks all polygons and vertices of a scene
+	 *
+	 * @param [in] scene The scene to check
+	 * @param [in] abort Stops the check between two passes if set, may be null
+	 * @return The number of defects of each kind and the defective elements,
+	 *         incomplete if the check was stopped
+	 */
+	static Report validate(const IScene *scene, const QAtomicInt *abort = nullptr);
+
+	/**
+	 * @brief Formats a report as text with one line per kind of defect
+	 */
+	static QString describe(const Report & report);
+
+	/**
+	 * @brief Relative area below which a polygon counts as zero area
+	 *
+	 * The doubled area is compared with the squared longest edge, so
+	 * the check does not depend on the size of the model.
+	 */
+	static const float zeroAreaRatio;
+
+	/**
+	 * @brief Number of defective polygons that describe() lists
+	 */
+	static const int listedPolygons = 10;
+
+private:
+	/**
+	 * @brief Defects of a polygon, combined as bit flags
+	 */
+	enum PolygonDefect
+	{
+		InvalidIndex = 1,
+		RepeatedIndex = 2,
+		ZeroArea = 4,
+		Duplicate = 8,
+		NonManifoldEdge = 16,
+		FlippedEdge = 32
+	};
+
+	/**
+	 * @brief Defects of a vertex, combined as bit flags
+	 */
+	enum VertexDefect
+	{
+		NonManifoldVertex = 1,
+		Unreferenced = 2
+	};
+
+	/**
+	 * @brief Sort key of an element
+	 *
+	 * Used for the edge from a corner to the next corner of its polygon and
+	 * for the vertex hash of a polygon.
+	 */
+	struct SortKey
+	{
+		/**
+		 * @brief Smaller vertex in the high and larger vertex in the low bits, or the hash
+		 */
+		quint64 key;
+
+		/**
+		 * @brief Number of the corner or polygon
+		 */
+		int element;
+
+		/**
+		 * @brief Does the edge run from the smaller to the larger vertex?
+		 */
+		int forward;
+	};
+
+	/**
+	 * @brief Key of the elements which are left out of a pass
+	 */
+	static const quint64 noKey = ~quint64(0);
+
+	/**
+	 * @brief Checks the vertex numbers, repeated vertices and the area
+	 *
+	 * @return The defect flags of the polygon
+	 */
+	static int checkPolygon(const IScene *scene, int polygon);
+
+	/**
+	 * @brief Counts the fans of polygons around a vertex
+	 *
+	 * @param [in] neighbours The previous and the next vertex of each corner at the vertex
+	 * @param [in] count Number of corners
+	 * @param pairs Memory for the sorted neighbours, reused between calls
+	 * @param parents Memory for the union find of the corners, reused between calls
+	 */
+	static int countFans(const QVector<int> & neighbours, int count,
+		QVector<quint64> *pairs, QVector<int> *parents);
+
+	/**
+	 * @brief Returns a hash of the sorted vertex numbers of a polygon
+	 */
+	static quint64 hashPolygon(const QVector<int> & sorted);
+
+	/**
+	 * @brief Copies the sorted vertex numbers of a polygon
+	 */
+	static void sortedIndices(const IScene *scene, int polygon, QVector<int> *sorted);
+};
@@ -0,0 +1,535 @@
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "ObjReader.h"
+#include "Parallel.h"
+#include "Trace.h"
+
+void ObjReader::read(const QString & fileName, MeshData *mesh, const QAtomicInt *abort)
+{
+	TRACE_ZONE("ObjReader::read");
+	QFile file(fileName);
+	if (!file.open(QIODevice::ReadOnly)) {
+		throw tr("Unable to open file ") + fileName;
+	}
+	qint64 size = file.size();
+	const uchar *mapped = size > 0 ? file.map(0, size) : nullptr;
+	if (!mapped) {
+		throw tr("Unable to map file ") + fileName;
+	}
+	const char *data = reinterpret_cast<const char*>(mapped);
+	const char *dataEnd = data + size;
+
+	// Cut the file into a few chunks per thread, each ends behind a line break
+	qint64 chunkCount = qBound(qint64(1), size / chunkBytes,
+		qint64(QThread::idealThreadCount() * 4));
+	QVector<Chunk> chunks;
+	const char *begin = data;
+	for (qint64 i = 1; i <= chunkCount && begin < dataEnd; i++) {
+		const char *end = dataEnd;
+		if (i < chunkCount) {
+			end = qMax(begin, data + size * i / chunkCount);
+			const char *lineEnd = static_cast<const char*>(memchr(end, '\n', dataEnd - end));
+			end = lineEnd ? lineEnd + 1 : dataEnd;
+		}
+		Chunk chunk;
+		memset(&chunk, 0, sizeof(chunk));
+		chunk.begin = begin;
+		chunk.end = end;
+		chunks.append(chunk);
+		begin = end;
+	}
+
+	Parallel::forBlocks(chunks.size(), 1, [&](int first, int last) {
+		for (int i = first; i < last && !(abort && abort->load()); i++) {
+			countLines(&chunks[i]);
+		}
+	});
+
+	qint64 vertices = 0;
+	qint64 normals = 0;
+	qint64 colors = 0;
+	qint64 faces = 0;
+	qint64 corners = 0;
+	bool colored = false;
+	for (int i = 0; i < chunks.size(); i++) {
+		Chunk & chunk = chunks[i];
+		chunk.firstVertex = vertices;
+		chunk.firstNormal = normals;
+		chunk.firstColor = colors;
+		chunk.firstFace = faces;
+		chunk.firstCorner = corners;
+		vertices += chunk.vertices;
+		normals += chunk.normals;
+		colors += chunk.colors;
+		faces += chunk.faces;
+		corners += chunk.corners;
+		colored = colored || chunk.colored;
+	}
+
+	const qint64 maxCount = std::numeric_limits<int>::max() / 3;
+	const qint64 maxCorners = normals > 0 ? maxTableSize / 2 : std::numeric_limits<int>::max();
+	if (vertices == 0 || faces == 0 || vertices > maxCount || normals > maxCount
+		|| faces >= maxCount || corners > maxCorners) {
+		file.unmap(const_cast<uchar*>(mapped));
+		throw tr("Invalid vertex or polygon number!");
+	}
+
+	bool vcColors = colors > 0;
+	mesh->positions.resize(int(3 * vertices));
+	mesh->vertexColors.clear();
+	if (vcColors || colored) {
+		mesh->vertexColors.resize(int(vertices));
+	}
+	mesh->offsets.resize(int(faces) + 1);
+	mesh->polygonColors.clear();
+	mesh->fileIndices.clear();
+	mesh->normals.clear();
+	QVector<float> fileNormals(int(3 * normals));
+	QVector<int> cornerVertices(static_cast<int>(corners));
+	QVector<int> cornerNormals(normals > 0 ? int(corners) : 0);
+	int *cornerNormalData = normals > 0 ? cornerNormals.data() : nullptr;
+
+	// Parsing errors can not be thrown through the worker threads
+	QAtomicInt damaged(0);
+	Parallel::forBlocks(chunks.size(), 1, [&](int first, int last) {
+		for (int i = first; i < last && !(abort && abort->load()); i++) {
+			if (!parseLines(chunks[i], vcColors, vertices, normals, mesh,
+				fileNormals.data(), cornerVertices.data(), cornerNormalData)) {
+				damaged.store(1);
+			}
+		}
+	});
+	mesh->offsets[int(faces)] = int(corners);
+
+	file.unmap(const_cast<uchar*>(mapped));
+	if (abort && abort->load()) {
+		throw tr("Aborted file loading!");
+	}
+	if (damaged.load()) {
+		throw tr("The OBJ file contains a line that can not be read!");
+	}
+
+	if (normals > 0) {
+		splitByNormals(cornerVertices, cornerNormals, fileNormals, mesh);
+	} else {
+		mesh->indices.swap(cornerVertices);
+	}
+}
+
+ObjReader::LineType ObjReader::lineType(const char **p, const char *end)
+{
+	const char *c = *p;
+	while (c < end && (*c == ' ' || *c == '\t')) {
+		c++;
+	}
+
+	LineType type = Other;
+	int length = 0;
+	if (end - c >= 2 && c[0] == 'v' && c[1] == 'n') {
+		type = Normal;
+		length = 2;
+	} else if (end - c >= 2 && c[0] == 'v' && c[1] == 'c') {
+		type = Color;
+		length = 2;
+	} else if (end - c >= 1 && c[0] == 'v') {
+		type = Vertex;
+		length = 1;
+	} else if (end - c >= 1 && c[0] == 'f') {
+		type = Face;
+		length = 1;
+	}
+
+	// Keywords like "vt" or "fo" only start with the same letters
+	if (type == Other || (c + length < end && c[length] != ' ' && c[length] != '\t')) {
+		return Other;
+	}
+	*p = c + length;
+	return type;
+}
+
+int ObjReader::countTokens(const char *p, const char *end)
+{
+	int tokens = 0;
+	bool inToken = false;
+	for (; p < end; p++) {
+		bool space = *p == ' ' || *p == '\t' || *p == '\r';
+		if (!space && !inToken) {
+			tokens++;
+		}
+		inToken = !space;
+	}
+	return tokens;
+}
+
+void ObjReader::countLines(Chunk *chunk)
+{
+	TRACE_ZONE("ObjReader::countLines");
+	const char *p = chunk->begin;
+	while (p < chunk->end) {
+		const char *lineEnd = static_cast<const char*>(memchr(p, '\n', chunk->end - p));
+		if (!lineEnd) {
+			lineEnd = chunk->end;
+		}
+		switch (lineType(&p, lineEnd)) {
+			case Vertex:
+				chunk->vertices++;
+				if (!chunk->colored && countTokens(p, lineEnd) >= 6) {
+					chunk->colored = true;
+				}
+				break;
+			case Normal:
+				chunk->normals++;
+				break;
+			case Color:
+				chunk->colors++;
+				break;
+			case Face:
+				chunk->faces++;
+				chunk->corners += countTokens(p, lineEnd);
+				break;
+			default:
+				break;
+		}
+		p = lineEnd + 1;
+	}
+}
+
+bool ObjReader::parseLines(const Chunk & chunk, bool vcColors, qint64 vertexCount,
+	qint64 normalCount, MeshData *mesh, float *normals, int *cornerVertices,
+	int *cornerNormals)
+{
+	TRACE_ZONE("ObjReader::parseLines");
+	float *positions = mesh->positions.data() + 3 * chunk.firstVertex;
+	QColor *colors = mesh->vertexColors.isEmpty() ? nullptr : mesh->vertexColors.data();
+	int *offsets = mesh->offsets.data() + chunk.firstFace;
+	qint64 vertices = chunk.firstVertex;
+	qint64 vnLines = chunk.firstNormal;
+	qint64 vcLines = chunk.firstColor;
+	qint64 corner = chunk.firstCorner;
+	qint64 cornerEnd = chunk.firstCorner + chunk.corners;
+
+	const char *p = chunk.begin;
+	while (p < chunk.end) {
+		const char *lineEnd = static_cast<const char*>(memchr(p, '\n', chunk.end - p));
+		if (!lineEnd) {
+			lineEnd = chunk.end;
+		}
+		switch (lineType(&p, lineEnd)) {
+			case Vertex:
+				if (!parseFloat(&p, lineEnd, positions)
+					|| !parseFloat(&p, lineEnd, positions + 1)
+					|| !parseFloat(&p, lineEnd, positions + 2)) {
+					return false;
+				}
+				// A fourth value is the weight of the vertex, six or more are a color
+				if (colors && !vcColors && countTokens(p, lineEnd) >= 3
+					&& !parseColor(&p, lineEnd, colors + vertices)) {
+					return false;
+				}
+				positions += 3;
+				vertices++;
+				break;
+			case Normal:
+				if (normals) {
+					float *normal = normals + 3 * vnLines;
+					if (!parseFloat(&p, lineEnd, normal) || !parseFloat(&p, lineEnd, normal + 1)
+						|| !parseFloat(&p, lineEnd, normal + 2)) {
+						return false;
+					}
+				}
+				vnLines++;
+				break;
+			case Color:
+				if (vcLines < vertexCount && !parseColor(&p, lineEnd, colors + vcLines)) {
+					return false;
+				}
+				vcLines++;
+				break;
+			case Face:
+				*offsets++ = int(corner);
+				while (corner < cornerEnd) {
+					while (p < lineEnd && (*p == ' ' || *p == '\t' || *p == '\r')) {
+						p++;
+					}
+					if (p == lineEnd) {
+						break;
+					}
+					// The tokens are v, v/vt, v//vn or v/vt/vn
+					int index = 0;
+					if (!parseInt(&p, lineEnd, &index)) {
+						return false;
+					}
+					cornerVertices[corner] = resolveIndex(index, vertices, vertexCount);
+					if (cornerVertices[corner] < 0) {
+						return false;
+					}
+					int normal = -1;
+					if (p < lineEnd && *p == '/') {
+						p++;
+						if (p < lineEnd && *p != '/' && !parseInt(&p, lineEnd, &index)) {
+							return false;
+						}
+						if (p < lineEnd && *p == '/') {
+							p++;
+							if (!parseInt(&p, lineEnd, &index)) {
+								return false;
+							}
+							normal = resolveIndex(index, vnLines, normalCount);
+							if (normal < 0) {
+								return false;
+							}
+						}
+					}
+					if (cornerNormals) {
+						cornerNormals[corner] = normal;
+					}
+					corner++;
+				}
+				break;
+			default:
+				break;
+		}
+		p = lineEnd + 1;
+	}
+
+	// Both passes must have seen the same corners
+	return corner == cornerEnd;
+}
+
+bool ObjReader::parseFloat(const char **p, const char *end, float *value)
+{
+	const char *c = *p;
+	while (c < end && (*c == ' ' || *c == '\t')) {
+		c++;
+	}
+
+	bool negative = false;
+	if (c < end && (*c == '-' || *c == '+')) {
+		negative = *c == '-';
+		c++;
+	}
+
+	// Digits beyond the precision of the mantissa only move the exponent
+	quint64 mantissa = 0;
+	int exponent = 0;
+	int digits = 0;
+	int significant = 0;
+	for (; c < end && *c >= '0' && *c <= '9'; c++, digits++) {
+		if (significant < 18) {
+			mantissa = 10 * mantissa + (*c - '0');
+			significant += mantissa > 0;
+		} else {
+			exponent++;
+		}
+	}
+	if (c < end && *c == '.') {
+		for (c++; c < end && *c >= '0' && *c <= '9'; c++, digits++) {
+			if (significant < 18) {
+				mantissa = 10 * mantissa + (*c - '0');
+				significant += mantissa > 0;
+				exponent--;
+			}
+		}
+	}
+	if (digits == 0) {
+		return false;
+	}
+
+	if (c < end && (*c == 'e' || *c == 'E')) {
+		c++;
+		bool negativeExponent = false;
+		if (c < end && (*c == '-' || *c == '+')) {
+			negativeExponent = *c == '-';
+			c++;
+		}
+		int e = 0;
+		if (c >= end || *c < '0' || *c > '9') {
+			return false;
+		}
+		for (; c < end && *c >= '0' && *c <= '9'; c++) {
+			e = qMin(10 * e + (*c - '0'), 10000);
+		}
+		exponent += negativeExponent ? -e : e;
+	}
+
+	// Powers up to 22 are exact doubles, so the common cases round correctly
+	static const double powers[] = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+	};
+	double result = double(mantissa);
+	if (mantissa == 0 || exponent == 0) {
+		// Nothing to scale
+	} else if (exponent > 0 && exponent <= 22) {
+		result *= powers[exponent];
+	} else if (exponent < 0 && exponent >= -22) {
+		result /= powers[-exponent];
+	} else {
+		result *= std::pow(10.0, exponent);
+	}
+	*value = float(negative ? -result : result);
+	*p = c;
+	return true;
+}
+
+bool ObjReader::parseInt(const char **p, const char *end, int *value)
+{
+	const char *c = *p;
+	while (c < end && (*c == ' ' || *c == '\t')) {
+		c++;
+	}
+
+	bool negative = false;
+	if (c < end && (*c == '-' || *c == '+')) {
+		negative = *c == '-';
+		c++;
+	}
+	if (c >= end || *c < '0' || *c > '9') {
+		return false;
+	}
+	qint64 result = 0;
+	for (; c < end && *c >= '0' && *c <= '9'; c++) {
+		result = qMin(10 * result + (*c - '0'), qint64(std::numeric_limits<int>::max()));
+	}
+	*value = int(negative ? -result : result);
+	*p = c;
+	return true;
+}
+
+bool ObjReader::parseColor(const char **p, const char *end, QColor *color)
+{
+	float rgba[4] = {0.0f, 0.0f, 0.0f, 1.0f};
+	for (int k = 0; k < 3; k++) {
+		if (!parseFloat(p, end, rgba + k)) {
+			return false;
+		}
+	}
+	if (countTokens(*p, end) > 0 && !parseFloat(p, end, rgba + 3)) {
+		return false;
+	}
+	color->setRgbF(qBound(0.0f, rgba[0], 1.0f), qBound(0.0f, rgba[1], 1.0f),
+		qBound(0.0f, rgba[2], 1.0f), qBound(0.0f, rgba[3], 1.0f));
+	return true;
+}
+
+int ObjReader::resolveIndex(int index, qint64 defined, qint64 count)
+{
+	qint64 number = index > 0 ? qint64(index) - 1 : defined + index;
+	if (index == 0 || number < 0 || number >= count) {
+		return -1;
+	}
+	return int(number);
+}
+
+void ObjReader::splitByNormals(const QVector<int> & cornerVertices,
+	const QVector<int> & cornerNormals, const QVector<float> & normals, MeshData *mesh)
+{
+	TRACE_ZONE("ObjReader::splitByNormals");
+	int corners = cornerVertices.size();
+	int tableSize = 16;
+	while (tableSize < 2 * qint64(corners)) {
+		tableSize *= 2;
+	}
+
+	// The key holds the vertex in the low and the normal in the high bits,
+	// the threads claim free slots with a compare and swap
+	const quint64 empty = std::numeric_limits<quint64>::max();
+	QVector<QAtomicInteger<quint64> > table(tableSize, QAtomicInteger<quint64>(empty));
+	QVector<QAtomicInt> firstCorner(tableSize, QAtomicInt(std::numeric_limits<int>::max()));
+	QVector<int> cornerSlots(corners);
+	Parallel::forBlocks(corners, 1 << 14, [&](int begin, int end) {
+		for (int k = begin; k < end; k++) {
+			quint64 key = (quint64(quint32(cornerNormals[k] + 1)) << 32) | quint32(cornerVertices[k]);
+			int slot = int(hashKey(key) & quint64(tableSize - 1));
+			while (true) {
+				quint64 current = table[slot].loadAcquire();
+				if (current == empty) {
+					if (table[slot].testAndSetOrdered(empty, key)) {
+						break;
+					}
+					current = table[slot].loadAcquire();
+				}
+				if (current == key) {
+					break;
+				}
+				slot = (slot + 1) & (tableSize - 1);
+			}
+			cornerSlots[k] = slot;
+
+			// The smallest corner of a slot decides the number of the vertex
+			int known = firstCorner[slot].loadAcquire();
+			while (k < known && !firstCorner[slot].testAndSetOrdered(known, k)) {
+				known = firstCorner[slot].loadAcquire();
+			}
+		}
+	});
+
+	// Number the new vertices in the order of their first corner
+	int blocks = Parallel::blockCount(corners, 1 << 14);
+	QVector<int> blockVertices(blocks + 1, 0);
+	Parallel::forEachBlock(corners, 1 << 14, [&](int block, int begin, int end) {
+		int count = 0;
+		for (int k = begin; k < end; k++) {
+			count += firstCorner[cornerSlots[k]].load() == k;
+		}
+		blockVertices[block + 1] = count;
+	});
+	for (int b = 0; b < blocks; b++) {
+		blockVertices[b + 1] += blockVertices[b];
+	}
+
+	int vertices = blockVertices[blocks];
+	QVector<int> slotNumbers(tableSize);
+	QVector<float> positions(3 * vertices);
+	QVector<float> vertexNormals(3 * vertices);
+	QAtomicInt missingNormal(0);
+	QVector<QColor> colors(mesh->vertexColors.isEmpty() ? 0 : vertices);
+	Parallel::forEachBlock(corners, 1 << 14, [&](int block, int begin, int end) {
+		int number = blockVertices[block];
+		for (int k = begin; k < end; k++) {
+			int slot = cornerSlots[k];
+			if (firstCorner[slot].load() == k) {
+				int vertex = cornerVertices[k];
+				memcpy(positions.data() + 3 * number,
+					mesh->positions.constData() + 3 * vertex, 3 * sizeof(float));
+				if (cornerNormals[k] >= 0) {
+					memcpy(vertexNormals.data() + 3 * number,
+						normals.constData() + 3 * cornerNormals[k], 3 * sizeof(float));
+				} else {
+					missingNormal.store(1);
+				}
+				if (!colors.isEmpty()) {
+					colors[number] = mesh->vertexColors[vertex];
+				}
+				slotNumbers[slot] = number++;
+			}
+		}
+	});
+
+	mesh->indices.resize(corners);
+	int *indices = mesh->indices.data();
+	Parallel::forBlocks(corners, 1 << 16, [&](int begin, int end) {
+		for (int k = begin; k < end; k++) {
+			indices[k] = slotNumbers[cornerSlots[k]];
+		}
+	});
+	mesh->positions.swap(positions);
+	mesh->vertexColors.swap(colors);
+
+	// Mixed corners would leave some vertices without a normal
+	if (!missingNormal.load()) {
+		mesh->normals.swap(vertexNormals);
+	}
+}
+
+quint64 ObjReader::hashKey(quint64 key)
+{
+	key ^= key >> 33;
+	key *= 0xff51afd7ed558ccdull;
+	key ^= key >> 33;
+	key *= 0xc4ceb9fe1a85ec53ull;
+	key ^= key >> 33;
+	return key;
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <QtCore>
+
+#include "MeshData.h"
+
+/**
+ * @brief Reader for Wavefront OBJ files
+ *
+ * Reads the lines "v x y z [r g b [a]]", "vn x y z", "vc r g b [a]" and
+ * "f v/vt/vn ..." with positive and negative indices. All other lines like
+ * texture coordinates, groups and materials are ignored. The n-th "vc"
+ * line colors the n-th vertex, if a file has such lines the colors of the
+ * "v" lines are ignored.
+ *
+ * The file is mapped into memory and cut into chunks at line breaks. A
+ * first parallel pass counts the lines of each chunk, so a second parallel
+ * pass can write the positions and face corners of each chunk directly to
+ * their final place and resolve the negative indices.
+ *
+ * OffView has no textures, so the texture coordinates are ignored. Corners
+ * with different normals become different vertices which keep the normal
+ * of the file, so that hard edges of the model are kept. The unique
+ * combinations of vertex and normal are found with a hash table that is
+ * filled by several threads at once. If a single corner has no normal, all
+ * normals are calculated by OffView like for the other formats.
+ */
+class ObjReader
+{
+	Q_DECLARE_TR_FUNCTIONS(ObjReader)
+
+public:
+	/**
+	 * @brief Reads an OBJ file
+	 *
+	 * Throws a QString if the file can not be read.
+	 *
+	 * @param [in] fileName Path to the file
+	 * @param [out] mesh Receives the vertices and faces
+	 * @param [in] abort Cancels the reading from another thread if set, may be null
+	 */
+	static void read(const QString & fileName, MeshData *mesh, const QAtomicInt *abort = nullptr);
+
+private:
+	/**
+	 * @brief A part of the file which ends at a line break
+	 *
+	 * The counts are filled by the first pass, the first numbers are the
+	 * sums of the counts of all earlier chunks.
+	 */
+	struct Chunk
+	{
+		const char *begin;
+		const char *end;
+		qint64 vertices;
+		qint64 normals;
+		qint64 colors;
+		qint64 faces;
+		qint64 corners;
+		bool colored;
+		qint64 firstVertex;
+		qint64 firstNormal;
+		qint64 firstColor;
+		qint64 firstFace;
+		qint64 firstCorner;
+	};
+
+	/**
+	 * @brief Minimum size of a chunk in bytes
+	 */
+	static const int chunkBytes = 1 << 22;
+
+	/**
+	 * @brief Number of slots of the largest hash table, at least half are free
+	 */
+	static const int maxTableSize = 1 << 30;
+
+	/**
+	 * @brief Kinds of lines which are read
+	 */
+	enum LineType
+	{
+		Other, Vertex, Normal, Color, Face
+	};
+
+	/**
+	 * @brief Returns the kind of a line and moves p behind the keyword
+	 */
+	static LineType lineType(const char **p, const char *end);
+
+	/**
+	 * @brief Returns the number of whitespace separated tokens up to end
+	 */
+	static int countTokens(const char *p, const char *end);
+
+	/**
+	 * @brief Counts the lines of a chunk
+	 */
+	static void countLines(Chunk *chunk);
+
+	/**
+	 * @brief Parses the lines of a chunk into the arrays
+	 *
+	 * @param [in] chunk The chunk with its counts and first numbers
+	 * @param [in] vcColors Whether the colors come from "vc" lines
+	 * @param [out] mesh Receives the positions, colors and face offsets
+	 * @param [out] normals Receives x, y and z of each "vn" line, may be null
+	 * @param [out] cornerVertices Receives the vertex number of each corner
+	 * @param [out] cornerNormals Receives the normal number of each corner or -1, may be null
+	 * @return False if a line can not be read or an index is out of range
+	 */
+	static bool parseLines(const Chunk & chunk, bool vcColors, qint64 vertexCount,
+		qint64 normalCount, MeshData *mesh, float *normals, int *cornerVertices,
+		int *cornerNormals);
+
+	/**
+	 * @brief Reads a number and moves p behind it
+	 *
+	 * Unlike strtod() this does not depend on the locale and does not
+	 * need a terminating zero behind the mapped file.
+	 */
+	static bool parseFloat(const char **p, const char *end, float *value);
+
+	/**
+	 * @brief Reads an integer and moves p behind it
+	 */
+	static bool parseInt(const char **p, const char *end, int *value);
+
+	/**
+	 * @brief Reads a color of three or four floats
+	 */
+	static bool parseColor(const char **p, const char *end, QColor *color);
+
+	/**
+	 * @brief Converts a one based or negative index into a number
+	 *
+	 * @param [in] index Index of the file, negative ones count back from defined
+	 * @param [in] defined Number of elements defined before the line
+	 * @param [in] count Number of elements in the whole file
+	 * @return The zero based number or -1 if it is out of range
+	 */
+	static int resolveIndex(int index, qint64 defined, qint64 count);
+
+	/**
+	 * @brief Makes a vertex for each combination of vertex and normal
+	 *
+	 * The new vertices are numbered in the order of their first corner.
+	 *
+	 * @param [in] cornerVertices The vertex number of each corner
+	 * @param [in] cornerNormals The normal number of each corner or -1
+	 * @param [in] normals x, y and z of each "vn" line
+	 * @param [in, out] mesh Receives the new positions, normals, colors and indices
+	 */
+	static void splitByNormals(const QVector<int> & cornerVertices,
+		const QVector<int> & cornerNormals, const QVector<float> & normals, MeshData *mesh);
+
+	/**
+	 * @brief Spreads the bits of a key for the hash table
+	 */
+	static quint64 hashKey(quint64 key);
+};
@@ -0,0 +1,200 @@
+#include <cstring>
+#include <limits>
+
+#include "OffBinaryReader.h"
+#include "Parallel.h"
+#include "Trace.h"
+
+bool OffBinaryReader::isBinary(const QString & fileName)
+{
+	QFile file(fileName);
+	if (!file.open(QIODevice::ReadOnly)) {
+		return false;
+	}
+	QByteArray start = file.read(64);
+	return headerLength(start.constData(), start.size(), nullptr) > 0;
+}
+
+void OffBinaryReader::read(const QString & fileName, MeshData *mesh, const QAtomicInt *abort)
+{
+	TRACE_ZONE("OffBinaryReader::read");
+	QFile file(fileName);
+	if (!file.open(QIODevice::ReadOnly)) {
+		throw tr("Unable to open file ") + fileName;
+	}
+	qint64 size = file.size();
+	const uchar *data = size > 0 ? file.map(0, size) : nullptr;
+	if (!data) {
+		throw tr("Unable to map file ") + fileName;
+	}
+
+	bool colored = false;
+	int header = headerLength(reinterpret_cast<const char*>(data), size, &colored);
+	if (header == 0 || size < header + 12) {
+		file.unmap(const_cast<uchar*>(data));
+		throw tr("The binary OFF file is damaged!");
+	}
+	qint64 vCount = qFromBigEndian<quint32>(data + header);
+	qint64 pCount = qFromBigEndian<quint32>(data + header + 4);
+	int vertexFloats = colored ? 7 : 3;
+	qint64 vertexBytes = 4 * vertexFloats * vCount;
+	if (vCount == 0 || pCount == 0 || vCount > std::numeric_limits<int>::max() / 3
+		|| pCount >= std::numeric_limits<int>::max() || header + 12 + vertexBytes > size) {
+		file.unmap(const_cast<uchar*>(data));
+		throw tr("Invalid vertex or polygon number!");
+	}
+
+	// The faces have different sizes, so one pass finds the offsets of all
+	// faces and the start of each block
+	int vertices = int(vCount);
+	int polygons = int(pCount);
+	int blocks = (polygons + blockSize - 1) / blockSize;
+	QVector<const uchar*> blockStarts(blocks);
+	mesh->offsets.resize(polygons + 1);
+	int *offsets = mesh->offsets.data();
+	const uchar *vertexData = data + header + 12;
+	const uchar *dataEnd = data + size;
+	const uchar *p = vertexData + vertexBytes;
+	bool colorFaces = false;
+	bool damaged = false;
+	qint64 corners = 0;
+	for (int i = 0; i < polygons; i++) {
+		if (i % blockSize == 0) {
+			if (abort && abort->load()) {
+				break;
+			}
+			blockStarts[i / blockSize] = p;
+		}
+		offsets[i] = int(corners);
+		if (dataEnd - p < 4) {
+			damaged = true;
+			break;
+		}
+		qint64 count = qFromBigEndian<quint32>(p);
+		p += 4;
+		if (dataEnd - p < 4 * count + 4) {
+			damaged = true;
+			break;
+		}
+		p += 4 * count;
+		qint64 colors = qFromBigEndian<quint32>(p);
+		p += 4;
+		if (colors > 4 || dataEnd - p < 4 * colors) {
+			damaged = true;
+			break;
+		}
+		p += 4 * colors;
+		colorFaces = colorFaces || colors >= 3;
+		corners += count;
+		if (corners >= std::numeric_limits<int>::max()) {
+			damaged = true;
+			break;
+		}
+	}
+	if (damaged || (abort && abort->load())) {
+		file.unmap(const_cast<uchar*>(data));
+		throw damaged ? tr("The binary OFF file is damaged!") : tr("Aborted file loading!");
+	}
+	offsets[polygons] = int(corners);
+
+	mesh->positions.resize(3 * vertices);
+	mesh->normals.clear();
+	mesh->vertexColors.clear();
+	if (colored) {
+		mesh->vertexColors.resize(vertices);
+	}
+	mesh->indices.resize(int(corners));
+	mesh->polygonColors.clear();
+	if (colorFaces) {
+		mesh->polygonColors.resize(polygons);
+	}
+	mesh->fileIndices.clear();
+
+	float *positions = mesh->positions.data();
+	QColor *vertexColors = colored ? mesh->vertexColors.data() : nullptr;
+	Parallel::forBlocks(vertices, 1 << 14, [&](int begin, int end) {
+		if (abort && abort->load()) {
+			return;
+		}
+		for (int i = begin; i < end; i++) {
+			const uchar *vertex = vertexData + 4 * qint64(vertexFloats) * i;
+			for (int k = 0; k < 3; k++) {
+				positions[3 * i + k] = readFloat(vertex + 4 * k);
+			}
+			if (vertexColors) {
+				vertexColors[i].setRgbF(qBound(0.0f, readFloat(vertex + 12), 1.0f),
+					qBound(0.0f, readFloat(vertex + 16), 1.0f),
+					qBound(0.0f, readFloat(vertex + 20), 1.0f),
+					qBound(0.0f, readFloat(vertex + 24), 1.0f));
+			}
+		}
+	});
+
+	// Indices out of range can not be thrown through the worker threads
+	QAtomicInt invalid(0);
+	int *indices = mesh->indices.data();
+	QColor *polygonColors = colorFaces ? mesh->polygonColors.data() : nullptr;
+	Parallel::forBlocks(blocks, 1, [&](int firstBlock, int lastBlock) {
+		for (int block = firstBlock; block < lastBlock && !(abort && abort->load()); block++) {
+			const uchar *face = blockStarts[block];
+			int end = qMin(polygons, (block + 1) * blockSize);
+			for (int i = block * blockSize; i < end; i++) {
+				int count = offsets[i + 1] - offsets[i];
+				face += 4;
+				for (int j = 0; j < count; j++) {
+					quint32 index = qFromBigEndian<quint32>(face + 4 * j);
+					if (index >= quint32(vertices)) {
+						invalid.store(1);
+						index = 0;
+					}
+					indices[offsets[i] + j] = int(index);
+				}
+				face += 4 * count;
+				int colors = int(qFromBigEndian<quint32>(face));
+				face += 4;
+
+				// A single component is an index into a color map, which is not supported
+				if (polygonColors && colors >= 3) {
+					float rgba[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+					for (int k = 0; k < colors; k++) {
+						rgba[k] = qBound(0.0f, readFloat(face + 4 * k), 1.0f);
+					}
+					polygonColors[i].setRgbF(rgba[0], rgba[1], rgba[2], rgba[3]);
+				}
+				face += 4 * colors;
+			}
+		}
+	});
+
+	file.unmap(const_cast<uchar*>(data));
+	if (abort && abort->load()) {
+		throw tr("Aborted file loading!");
+	}
+	if (invalid.load()) {
+		throw tr("The binary OFF file is damaged!");
+	}
+}
+
+int OffBinaryReader::headerLength(const char *data, qint64 size, bool *colored)
+{
+	const char *end = static_cast<const char*>(memchr(data, '\n', size_t(qMin(size, qint64(64)))));
+	if (!end) {
+		return 0;
+	}
+	QByteArray line = QByteArray(data, int(end - data)).simplified();
+	if (line != "OFF BINARY" && line != "COFF BINARY") {
+		return 0;
+	}
+	if (colored) {
+		*colored = line.startsWith("C");
+	}
+	return int(end - data) + 1;
+}
+
+float OffBinaryReader::readFloat(const uchar *data)
+{
+	quint32 bits = qFromBigEndian<quint32>(data);
+	float value;
+	memcpy(&value, &bits, sizeof(value));
+	return value;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <QtCore>
+
+#include "MeshData.h"
+
+/**
+ * @brief Reader for binary OFF and COFF files
+ *
+ * The binary variant of the Geomview format starts with the line
+ * "OFF BINARY" or "COFF BINARY", followed by big endian 32 bit numbers: the
+ * vertex, polygon and edge counts, three floats for each vertex plus four
+ * color floats in COFF files, and for each face the number of its vertices,
+ * the indices, the number of color components and the components. OffWriter
+ * writes such files, so they can be opened again.
+ *
+ * The file is mapped into memory. The vertices have a fixed size and are
+ * converted by several threads. The faces are walked once to find their
+ * offsets, then blocks of faces are converted in parallel.
+ *
+ * @see OffWriter
+ */
+class OffBinaryReader
+{
+	Q_DECLARE_TR_FUNCTIONS(OffBinaryReader)
+
+public:
+	/**
+	 * @brief Checks if a file starts with the header of a binary OFF file
+	 *
+	 * @param [in] fileName Path to the file
+	 * @return False for text files and files which can not be read
+	 */
+	static bool isBinary(const QString & fileName);
+
+	/**
+	 * @brief Reads a binary OFF or COFF file
+	 *
+	 * Throws a QString if the file can not be read.
+	 *
+	 * @param [in] fileName Path to the file
+	 * @param [out] mesh Receives the vertices and polygons
+	 * @param [in] abort Cancels the reading from another thread if set, may be null
+	 */
+	static void read(const QString & fileName, MeshData *mesh, const QAtomicInt *abort = nullptr);
+
+private:
+	/**
+	 * @brief Number of faces whose start is remembered by the first pass
+	 */
+	static const int blockSize = 1 << 14;
+
+	/**
+	 * @brief Returns the length of the header line including the line break
+	 *
+	 * @param [in] data Start of the file
+	 * @param [in] size Size of the file
+	 * @param [out] colored Receives whether the vertices have colors, may be null
+	 * @return 0 if the file does not start with a binary header
+	 */
+	static int headerLength(const char *data, qint64 size, bool *colored);
+
+	/**
+	 * @brief Reads a big endian float
+	 */
+	static float readFloat(const uchar *data);
+};
@@ -1,12 +1,35 @@
+#include <algorithm>
+#include <cstring>
+
 #include <QProgressDialog>
 
 #include "OffScene.h"
+#include "HalfEdgeMesh.h"
+#include "Parallel.h"
+#include "Trace.h"
+
+OffScene::OffScene(const QString & fileName, bool showProgress, LoadTimings *timings,
+	const QAtomicInt *abort)
+{
+	colored = false;
+	canceled = false;
+	report = VertexWelder::Report();
+	hasStatistics = false;
+	halfEdgeMesh = nullptr;
+	this->timings = timings;
+	this->abort = abort;
+	parseFile(fileName, showProgress);
+}
 
-OffScene::OffScene(const QString & fileName)
+OffScene::OffScene()
 {
 	colored = false;
 	canceled = false;
-	parseFile(fileName);
+	report = VertexWelder::Report();
+	hasStatistics = false;
+	halfEdgeMesh = nullptr;
+	timings = nullptr;
+	abort = nullptr;
 }
 
 OffScene::~OffScene()
@@ -34,23 +57,323 @@ int OffScene::verticesCount() const
 	return vertices.size();
 }
 
+void OffScene::writeSnapshot(QDataStream *stream) const
+{
+	TRACE_ZONE("OffScene::writeSnapshot");
+	stream->setFloatingPointPrecision(QDataStream::SinglePrecision);
+	*stream << qint32(vertices.size()) << qint32(polygons.size());
+
+	for (int i = 0; i < vertices.size(); i++) {
+		const CVertex *vertex = vertices[i];
+		*stream << vertex->x() << vertex->y() << vertex->z()
+			<< quint8(vertex->isColored());
+		if (vertex->isColored()) {
+			*stream << quint32(vertex->color().rgba());
+		}
+	}
+
+	// The polygons are already sorted by transparency
+	for (int i = 0; i < polygons.size(); i++) {
+		const CPolygon *polygon = polygons[i];
+		int count = int(polygon->vertexCount());
+		*stream << qint32(polygon->fileIndex()) << qint32(count);
+		for (int j = 0; j < count; j++) {
+			*stream << qint32(polygon->vertexIndex(j));
+		}
+		*stream << quint8(polygon->isColored());
+		if (polygon->isColored()) {
+			*stream << quint32(polygon->color().rgba());
+		}
+	}
+}
+
+OffScene* OffScene::fromSnapshot(QDataStream *stream)
+{
+	TRACE_ZONE("OffScene::fromSnapshot");
+	stream->setFloatingPointPrecision(QDataStream::SinglePrecision);
+	qint32 vCount = 0, pCount = 0;
+	*stream >> vCount >> pCount;
+	if (stream->status() != QDataStream::Ok || vCount < 0 || pCount < 0) {
+		throw tr("The snapshot is damaged!");
+	}
+
+	// The destructor deletes the vertices and polygons read so far
+	OffScene *scene = new OffScene();
+	try {
+		for (qint32 i = 0; i < vCount; i++) {
+			float xyz[3];
+			quint8 isColored = 0;
+			*stream >> xyz[0] >> xyz[1] >> xyz[2] >> isColored;
+			CVertex *vertex = new CVertex(xyz);
+			scene->vertices.append(vertex);
+			if (isColored) {
+				quint32 rgba = 0;
+				*stream >> rgba;
+				vertex->setColor(QColor::fromRgba(rgba));
+				scene->colored = true;
+			}
+			if (stream->status() != QDataStream::Ok) {
+				throw tr("The snapshot is damaged!");
+			}
+		}
+
+		for (qint32 i = 0; i < pCount; i++) {
+			qint32 fileIndex = -1, count = 0;
+			*stream >> fileIndex >> count;
+			if (stream->status() != QDataStream::Ok || count < 3) {
+				throw tr("The snapshot is damaged!");
+			}
+			CPolygon *polygon = new CPolygon();
+			polygon->setFileIndex(fileIndex);
+			scene->polygons.append(polygon);
+			for (qint32 j = 0; j < count; j++) {
+				qint32 index = -1;
+				*stream >> index;
+				if (index < 0 || index >= vCount) {
+					throw tr("The snapshot is damaged!");
+				}
+				polygon->addVertex(scene->vertices[index], index);
+			}
+			quint8 isColored = 0;
+			*stream >> isColored;
+			if (isColored) {
+				quint32 rgba = 0;
+				*stream >> rgba;
+				polygon->setColor(QColor::fromRgba(rgba));
+				scene->colored = true;
+			}
+			if (stream->status() != QDataStream::Ok) {
+				throw tr("The snapshot is damaged!");
+			}
+		}
+
+		scene->finalize();
+	}
+	catch (QString &) {
+		delete scene;
+		throw;
+	}
+	return scene;
+}
+
+OffScene* OffScene::fromMesh(const MeshData & mesh, const QAtomicInt *abort)
+{
+	TRACE_ZONE("OffScene::fromMesh");
+	int vCount = mesh.verticesCount();
+	int pCount = mesh.polygonsCount();
+	if (vCount == 0 || pCount == 0) {
+		throw tr("Invalid vertex or polygon number!");
+	}
+
+	// The destructor deletes the objects, so the vectors must not contain garbage
+	OffScene *scene = new OffScene();
+	scene->vertices.fill(nullptr, vCount);
+	scene->polygons.fill(nullptr, pCount);
+	CVertex **vertices = scene->vertices.data();
+	CPolygon **polygons = scene->polygons.data();
+	QAtomicInt colored(0);
+	QAtomicInt invalid(0);
+
+	Parallel::forBlocks(vCount, 1 << 14, [&](int begin, int end) {
+		for (int i = begin; i < end; i++) {
+			CVertex *vertex = new CVertex(const_cast<float*>(mesh.positions.constData() + 3 * i));
+			if (!mesh.normals.isEmpty()) {
+				vertex->setNormal(const_cast<float*>(mesh.normals.constData() + 3 * i));
+			}
+			if (!mesh.vertexColors.isEmpty() && mesh.vertexColors[i].isValid()) {
+				vertex->setColor(mesh.vertexColors[i]);
+				colored.store(1);
+			}
+			vertices[i] = vertex;
+		}
+	});
+
+	Parallel::forBlocks(pCount, 1 << 14, [&](int begin, int end) {
+		for (int i = begin; i < end && !(abort && abort->load()); i++) {
+			int first = mesh.offsets[i];
+			int last = mesh.offsets[i + 1];
+			CPolygon *polygon = new CPolygon();
+			polygon->setFileIndex(mesh.fileIndices.isEmpty() ? i : mesh.fileIndices[i]);
+			polygons[i] = polygon;
+			if (last - first < 3) {
+				invalid.store(1);
+				continue;
+			}
+			for (int k = first; k < last; k++) {
+				int index = mesh.indices[k];
+				if (index < 0 || index >= vCount) {
+					invalid.store(1);
+					break;
+				}
+				polygon->addVertex(vertices[index], index);
+			}
+			if (!mesh.polygonColors.isEmpty() && mesh.polygonColors[i].isValid()) {
+				polygon->setColor(mesh.polygonColors[i]);
+				colored.store(1);
+			}
+		}
+	});
+
+	if (invalid.load() || (abort && abort->load())) {
+		delete scene;
+		if (invalid.load()) {
+			throw tr("A polygon references less than 3 vertices or a missing vertex!");
+		}
+		throw tr("Aborted file loading!");
+	}
+
+	scene->colored = colored.load();
+	scene->finalize(mesh.normals.isEmpty());
+	return scene;
+}
+
+void OffScene::toMesh(MeshData *mesh) const
+{
+	TRACE_ZONE("OffScene::toMesh");
+	int vCount = vertices.size();
+	int pCount = polygons.size();
+	mesh->positions.resize(3 * vCount);
+	mesh->normals.clear();
+	mesh->vertexColors.clear();
+	mesh->fileIndices.clear();
+	if (colored) {
+		mesh->vertexColors.resize(vCount);
+		mesh->polygonColors.resize(pCount);
+	} else {
+		mesh->polygonColors.clear();
+	}
+
+	float *positions = mesh->positions.data();
+	QColor *vertexColors = mesh->vertexColors.data();
+	Parallel::forBlocks(vCount, 1 << 14, [&](int begin, int end) {
+		for (int i = begin; i < end; i++) {
+			memcpy(positions + 3 * i, vertices[i]->vertex(), 3 * sizeof(float));
+			if (colored && vertices[i]->isColored()) {
+				vertexColors[i] = vertices[i]->color();
+			}
+		}
+	});
+
+	mesh->offsets.resize(pCount + 1);
+	mesh->offsets[0] = 0;
+	for (int i = 0; i < pCount; i++) {
+		mesh->offsets[i + 1] = mesh->offsets[i] + int(polygons[i]->vertexCount());
+	}
+	mesh->indices.resize(mesh->offsets[pCount]);
+	int *indices = mesh->indices.data();
+	QColor *polygonColors = mesh->polygonColors.data();
+	Parallel::forBlocks(pCount, 1 << 14, [&](int begin, int end) {
+		for (int i = begin; i < end; i++) {
+			const CPolygon *polygon = polygons[i];
+			int first = mesh->offsets[i];
+			for (int j = 0; j < int(polygon->vertexCount()); j++) {
+				indices[first + j] = polygon->vertexIndex(j);
+			}
+			if (colored && polygon->isColored()) {
+				polygonColors[i] = polygon->color();
+			}
+		}
+	});
+}
+
+const HalfEdgeMesh* OffScene::halfEdges() const
+{
+	QMutexLocker locker(&halfEdgeMutex);
+	if (!halfEdgeMesh) {
+		halfEdgeMesh = new HalfEdgeMesh(this);
+	}
+	return halfEdgeMesh;
+}
+
+VertexWelder::Report OffScene::cleanReport() const
+{
+	return report;
+}
+
+void OffScene::setCleanReport(const VertexWelder::Report & report)
+{
+	this->report = report;
+}
+
+bool OffScene::statistics(MeshStatistics::Report *statistics) const
+{
+	if (hasStatistics) {
+		*statistics = statisticsReport;
+	}
+	return hasStatistics;
+}
+
+void OffScene::setStatistics(const MeshStatistics::Report & statistics)
+{
+	statisticsReport = statistics;
+	hasStatistics = true;
+}
+
+MemoryReport OffScene::memoryReport() const
+{
+	// Every QVector with elements has a header in front of them and
+	// every object and array is a separate block on the heap
+	const qint64 arrayHeader = sizeof(QArrayData);
+	const qint64 block = MemoryReport::allocationOverhead;
+	const qint64 floats3 = 3 * sizeof(float);
+	const qint64 color = sizeof(QColor) + sizeof(bool);
+	MemoryReport report;
+
+	qint64 vCount = vertices.size();
+	report.add(MemoryReport::Positions, vCount * floats3);
+	report.add(MemoryReport::Normals, vCount * floats3);
+	report.add(MemoryReport::Colors, vCount * color);
+	report.add(MemoryReport::Topology, vCount * (sizeof(CVertex) - 2 * floats3 - color + block));
+	report.add(MemoryReport::Topology, arrayHeader + block + vertices.capacity() * sizeof(CVertex*));
+
+	qint64 pCount = polygons.size();
+	qint64 corners = 0;
+	for (int i = 0; i < polygons.size(); i++) {
+		corners += polygons[i]->vertexCount();
+	}
+	report.add(MemoryReport::Normals, pCount * floats3);
+	report.add(MemoryReport::Colors, pCount * color);
+	report.add(MemoryReport::Topology, pCount * (sizeof(CPolygon) - floats3 - color + block));
+	report.add(MemoryReport::Topology, arrayHeader + block + polygons.capacity() * sizeof(CPolygon*));
+	// The vertex pointers and the vertex indices of each polygon
+	report.add(MemoryReport::Topology, pCount * 2 * (arrayHeader + block)
+		+ corners * (sizeof(CVertex*) + sizeof(int)));
+
+	qint64 adjacency = arrayHeader + block + hintlist.capacity() * sizeof(QVector<CPolygon*>);
+	for (int i = 0; i < hintlist.size(); i++) {
+		if (hintlist[i].capacity() > 0) {
+			adjacency += arrayHeader + block + hintlist[i].capacity() * sizeof(CPolygon*);
+		}
+	}
+	report.add(MemoryReport::Adjacency, adjacency);
+
+	QMutexLocker locker(&halfEdgeMutex);
+	if (halfEdgeMesh) {
+		halfEdgeMesh->addMemory(&report);
+	}
+
+	report.add(MemoryReport::Topology, sizeof(OffScene));
+	return report;
+}
+
 const CVertex* OffScene::vertex(int i) const
 {
 	return vertices[i];
 }
 
-QString OffScene::readNextLine(QTextStream *stream)
+QString OffScene::readNextLine(QTextStream *stream) const
 {
 	QString str;
 	
 	while (str.isEmpty()) {
 		
-		if (stream->atEnd()) {
+		// A pipe may look empty while the writer is still busy, so
+		// only a read without result marks the end
+		str = stream->readLine();
+		if (str.isNull()) {
 			throw tr("Unexpected end of file!");
 		}
 		
-		str = stream->readLine();
-		
 		int commentStart = str.indexOf("#");
 		if (commentStart != -1) {
 			str.truncate(commentStart);
@@ -61,13 +384,13 @@ QString OffScene::readNextLine(QTextStream *stream)
 	return str;
 }
 
-QStringList OffScene::split2Token(QString *string)
+QStringList OffScene::split2Token(QString *string) const
 {
 	string->replace('\t', ' ');
 	return string->split(' ', QString::SkipEmptyParts);
 }
 
-void OffScene::levelColorValues(double *values, int count)
+void OffScene::levelColorValues(double *values, int count) const
 {
 	double max = 1;
 	for(int i=0; i<count; i++) {
@@ -83,7 +406,7 @@ void OffScene::levelColorValues(double *values, int count)
 	}
 }
 
-QColor OffScene::readColor(QStringList *tokens, int offset)
+QColor OffScene::readColor(QStringList *tokens, int offset) const
 {
 	QColor color;
 	
@@ -154,14 +477,22 @@ CPolygon* OffScene::readPolygon(QStringList *tokens, const QVector<CVertex*> ver
 		throw tr("A polygon references less than 3 vertices!");
 	}
 	
+	if (tokens->size() < vCount + 1) {
+		throw tr("A polygon line has less indices than its vertex number!");
+	}
+	
 	CPolygon *polygon = new CPolygon();
 	for(int i=0; i<vCount; i++) {
 		int index = tokens->at(1+i).toInt(&ok);
 		if (!ok) {
+			delete polygon;
 			throw tr("Can't parse polygon data!");
 		}
-		polygon->addVertex(vertices[index]);
-		hintlist[index].append(polygon);
+		if (index < 0 || index >= vertices.size()) {
+			delete polygon;
+			throw tr("A polygon references a missing vertex!");
+		}
+		polygon->addVertex(vertices[index], index);
 	}
 	
 	QColor color = readColor(tokens, vCount+1);
@@ -173,13 +504,20 @@ CPolygon* OffScene::readPolygon(QStringList *tokens, const QVector<CVertex*> ver
 	return polygon;
 }
 
-void OffScene::parseFile(const QString & fileName)
+void OffScene::parseFile(const QString & fileName, bool showProgress)
 {
+	TRACE_ZONE("OffScene::parseFile");
 	QFile file(fileName);
     QTextStream stream(&file);
 	
-    // Open the file in read only mode
-    if(!file.open(QIODevice::ReadOnly)) {
+    // Open the file in read only mode, stdin is only read forward
+    bool opened;
+    if (fileName == "-") {
+        opened = file.open(stdin, QIODevice::ReadOnly);
+    } else {
+        opened = file.open(QIODevice::ReadOnly);
+    }
+    if(!opened) {
         throw tr("Unable to open file ") + fileName;
     }
 
@@ -207,32 +545,61 @@ void OffScene::parseFile(const QString & fileName)
 	int stepSize = (vCount+pCount)/50;
 	stepSize = stepSize<1 ? 1 : stepSize;
 	
-	// Create a progress dialog
-	QProgressDialog progress(tr("Loading vertices..."), tr("Cancel"), 0, vCount+pCount);
-	progress.setWindowTitle(tr("Loading OFF file"));
-	progress.setWindowModality(Qt::ApplicationModal);
-	progress.setWindowFlags(Qt::Tool);
-	connect(&progress, SIGNAL(canceled()), this, SLOT(cancel()));
+	// Create a progress dialog, without a GUI the file is parsed silently
+	QScopedPointer<QProgressDialog> progress;
+	if (showProgress) {
+		progress.reset(new QProgressDialog(tr("Loading vertices..."), tr("Cancel"), 0, vCount+pCount));
+		progress->setWindowTitle(tr("Loading OFF file"));
+		progress->setWindowModality(Qt::ApplicationModal);
+		progress->setWindowFlags(Qt::Tool);
+		connect(progress.data(), SIGNAL(canceled()), this, SLOT(cancel()));
+	}
 
 	// Read all vertices into an temporary field
+	if (timings) {
+		timings->restart();
+	}
 	for(int i=0; i<vCount && !canceled; i++) {
 		line = readNextLine(&stream);
+		if (timings) {
+			timings->lap(LoadTimings::Read);
+		}
 		tokens = split2Token(&line);
 		vertices.append(readVertex(&tokens));
-		hintlist.append(QVector<CPolygon*>());
+		if (timings) {
+			timings->lap(LoadTimings::Parse);
+		}
 		if (i%stepSize == 0) {
-			progress.setValue(i);
+			if (progress) {
+				progress->setValue(i);
+			}
+			if (abort && abort->load()) {
+				canceled = true;
+			}
 		}
 	}
 
 	// Construct the polygons with the indices for the vertices
-	progress.setLabelText(tr("Loading polygons..."));
+	if (progress) {
+		progress->setLabelText(tr("Loading polygons..."));
+	}
 	for(int i=0; i<pCount && !canceled; i++) {
 		line = readNextLine(&stream);
+		if (timings) {
+			timings->lap(LoadTimings::Read);
+		}
 		tokens = split2Token(&line);
 		polygons.append(readPolygon(&tokens, vertices));
+		if (timings) {
+			timings->lap(LoadTimings::Parse);
+		}
 		if (i%stepSize == 0) {
-			progress.setValue(vCount+i);
+			if (progress) {
+				progress->setValue(vCount+i);
+			}
+			if (abort && abort->load()) {
+				canceled = true;
+			}
 		}
 	}
 	
@@ -243,7 +610,9 @@ void OffScene::parseFile(const QString & fileName)
 	} else {
 		finalize();
 	}
-	progress.setValue(vCount+pCount);
+	if (progress) {
+		progress->setValue(vCount+pCount);
+	}
 }
 
 bool OffScene::alphaChannelCompare(const CPolygon *p1, const CPolygon *p2)
@@ -260,19 +629,53 @@ bool OffScene::alphaChannelCompare(const CPolygon *p1, const CPolygon *p2)
 	return false;
 }
 
+bool OffScene::alphaColorCompare(const QColor & c1, const QColor & c2)
+{
+	if (c1.isValid() && c2.isValid()) {
+		return c1.alpha() > c2.alpha();
+	}
+	return c2.isValid();
+}
+
 void OffScene::cancel()
 {
 	canceled = true;
 }
 
-void OffScene::finalize()
+void OffScene::finalize(bool vertexNormals)
 {
+	TRACE_ZONE("OffScene::finalize");
+
+	// Remember the connected polygons of each vertex in file order
+	hintlist.resize(vertices.size());
+	int pCount = polygons.size();
+	for(int i=0; i<pCount; i++) {
+		CPolygon *polygon = polygons[i];
+		size_t cv = polygon->vertexCount();
+		for(size_t j=0; j<cv; j++) {
+			hintlist[polygon->vertexIndex(j)].append(polygon);
+		}
+	}
+	if (timings) {
+		timings->lap(LoadTimings::Adjacency);
+	}
+
+	// The sorting changes the index, so the number in the file is kept
+	for(int i=0; i<pCount; i++) {
+		if (polygons[i]->fileIndex() < 0) {
+			polygons[i]->setFileIndex(i);
+		}
+	}
+
 	// Sort polygons for a better (but not perfect) transparency effect
 	// -> Solid polygons should be drawn first
-	qSort(polygons.begin(), polygons.end(), alphaChannelCompare);
+	// The sort is stable, so readUpdate() can find the same order again
+	std::stable_sort(polygons.begin(), polygons.end(), alphaChannelCompare);
+	if (timings) {
+		timings->lap(LoadTimings::Sorting);
+	}
 	
 	// calculate normal vectors for all polygons
-	int pCount = polygons.size();
 	for(int i=0; i<pCount; i++) {
 		polygons[i]->calculateNormal();
 	}
@@ -280,24 +683,236 @@ void OffScene::finalize()
 	// calculate normal vectors for each vertex. the normal vector for a 
 	// vertex is the average of all connected polygon normal vectors
 	int vCount = vertices.size();
-	for(int i=0; i<vCount; i++) {
-		float normal[3] = {0.0f, 0.0f, 0.0f};
-		int count = hintlist[i].size();
-		for(int j=0; j<count; j++) {
-			const float *nv = hintlist[i].at(j)->normal();
-			normal[0] += nv[0];
-			normal[1] += nv[1];
-			normal[2] += nv[2];
+	for(int i=0; i<vCount && vertexNormals; i++) {
+		calculateVertexNormal(i);
+	}
+	if (timings) {
+		timings->lap(LoadTimings::Normals);
+	}
+}
+
+void OffScene::append(const QVector<CVertex*> & newVertices,
+	const QVector<CPolygon*> & newPolygons, bool newColored)
+{
+	TRACE_ZONE("OffScene::append");
+	{
+		QMutexLocker locker(&halfEdgeMutex);
+		delete halfEdgeMesh;
+		halfEdgeMesh = nullptr;
+	}
+	hasStatistics = false;
+	colored = colored || newColored;
+	vertices += newVertices;
+	hintlist.resize(vertices.size());
+
+	// Only the vertices of the new polygons get a new average
+	QVector<bool> changed(vertices.size(), false);
+	for (int i = 0; i < newPolygons.size(); i++) {
+		CPolygon *polygon = newPolygons[i];
+		if (polygon->fileIndex() < 0) {
+			polygon->setFileIndex(polygons.size() + i);
+		}
+		size_t cv = polygon->vertexCount();
+		for (size_t j = 0; j < cv; j++) {
+			int index = polygon->vertexIndex(j);
+			hintlist[index].append(polygon);
+			changed[index] = true;
+		}
+		polygon->calculateNormal();
+	}
+
+	// The old polygons are sorted and come first in the stream, so the
+	// stable sort gives the same order as finalize() for the whole file
+	polygons += newPolygons;
+	std::stable_sort(polygons.begin(), polygons.end(), alphaChannelCompare);
+
+	int vCount = vertices.size();
+	for (int i = 0; i < vCount; i++) {
+		if (changed[i]) {
+			calculateVertexNormal(i);
+		}
+	}
+}
+
+void OffScene::calculateVertexNormal(int i)
+{
+	float normal[3] = {0.0f, 0.0f, 0.0f};
+	int count = hintlist[i].size();
+	for(int j=0; j<count; j++) {
+		const float *nv = hintlist[i].at(j)->normal();
+		normal[0] += nv[0];
+		normal[1] += nv[1];
+		normal[2] += nv[2];
+	}
+	normal[0] /= count;
+	normal[1] /= count;
+	normal[2] /= count;
+	vertices[i]->setNormal(normal);
+}
+
+bool OffScene::readUpdate(const QString & fileName, Update *update,
+	const QAtomicInt *abort) const
+{
+	TRACE_ZONE("OffScene::readUpdate");
+	QFile file(fileName);
+	QTextStream stream(&file);
+	if (!file.open(QIODevice::ReadOnly)) {
+		throw tr("Unable to open file ") + fileName;
+	}
+
+	QString line = readNextLine(&stream);
+	if (line != "OFF" && line != "COFF") {
+		throw tr("Wrong file format!");
+	}
+	line = readNextLine(&stream);
+	QStringList tokens = split2Token(&line);
+	if (tokens.size() != 3) {
+		throw tr("Can't read vertex, polygon and edge numbers!");
+	}
+	int vCount = tokens[0].toInt();
+	int pCount = tokens[1].toInt();
+	if (vCount != vertices.size() || pCount != polygons.size()) {
+		return false;
+	}
+
+	update->positions.resize(3 * vCount);
+	update->vertexColors.resize(vCount);
+	for (int i = 0; i < vCount; i++) {
+		line = readNextLine(&stream);
+		tokens = split2Token(&line);
+		if (tokens.size() < 3) {
+			throw tr("Can't find all three vertex components!");
+		}
+		for (int k = 0; k < 3; k++) {
+			bool ok;
+			update->positions[3*i+k] = tokens[k].toDouble(&ok);
+			if (!ok) {
+				throw tr("Can't parse vertex data!");
+			}
+		}
+		update->vertexColors[i] = readColor(&tokens, 3);
+		if (abort && i % 65536 == 0 && abort->load()) {
+			return false;
+		}
+	}
+
+	// The polygon lines are kept in file order for now
+	QVector<int> offsets(pCount + 1);
+	QVector<int> indices;
+	indices.reserve(3 * pCount);
+	QVector<QColor> colors(pCount);
+	for (int i = 0; i < pCount; i++) {
+		line = readNextLine(&stream);
+		tokens = split2Token(&line);
+		bool ok;
+		int count = tokens.value(0).toInt(&ok);
+		if (!ok || count < 3 || tokens.size() < count + 1) {
+			return false;
+		}
+		offsets[i] = indices.size();
+		for (int j = 0; j < count; j++) {
+			indices.append(tokens[1+j].toInt(&ok));
+			if (!ok) {
+				throw tr("Can't parse polygon data!");
+			}
+		}
+		colors[i] = readColor(&tokens, count + 1);
+		if (abort && i % 65536 == 0 && abort->load()) {
+			return false;
+		}
+	}
+	offsets[pCount] = indices.size();
+
+	// Sorting the new polygons like finalize() gives the order of the scene,
+	// if each polygon has the same vertices as the polygon at its position
+	QVector<int> order(pCount);
+	for (int i = 0; i < pCount; i++) {
+		order[i] = i;
+	}
+	std::stable_sort(order.begin(), order.end(), [&colors](int a, int b) {
+		return alphaColorCompare(colors[a], colors[b]);
+	});
+
+	update->polygonColors.resize(pCount);
+	for (int i = 0; i < pCount; i++) {
+		const CPolygon *polygon = polygons[i];
+		int first = offsets[order[i]];
+		int count = offsets[order[i] + 1] - first;
+		if (count != static_cast<int>(polygon->vertexCount())) {
+			return false;
+		}
+		for (int j = 0; j < count; j++) {
+			if (indices[first + j] != polygon->vertexIndex(j)) {
+				return false;
+			}
+		}
+		update->polygonColors[i] = colors[order[i]];
+	}
+	return true;
+}
+
+void OffScene::applyUpdate(const Update & update)
+{
+	TRACE_ZONE("OffScene::applyUpdate");
+	colored = false;
+	hasStatistics = false;
+
+	int vCount = vertices.size();
+	QVector<bool> moved(vCount, false);
+	for (int i = 0; i < vCount; i++) {
+		const float *xyz = update.positions.constData() + 3*i;
+		CVertex *vertex = vertices[i];
+		if (xyz[0] != vertex->x() || xyz[1] != vertex->y() || xyz[2] != vertex->z()) {
+			vertex->setPosition(xyz);
+			moved[i] = true;
+		}
+		if (update.vertexColors[i].isValid()) {
+			vertex->setColor(update.vertexColors[i]);
+			colored = true;
+		} else {
+			vertex->removeColor();
+		}
+	}
+
+	// Only polygons with a moved vertex get a new normal, and only
+	// the vertices of these polygons need a new average
+	QVector<bool> changed(vCount, false);
+	int pCount = polygons.size();
+	for (int i = 0; i < pCount; i++) {
+		CPolygon *polygon = polygons[i];
+		if (update.polygonColors[i].isValid()) {
+			polygon->setColor(update.polygonColors[i]);
+			colored = true;
+		} else {
+			polygon->removeColor();
+		}
+
+		size_t cv = polygon->vertexCount();
+		bool polygonMoved = false;
+		for (size_t j = 0; j < cv && !polygonMoved; j++) {
+			polygonMoved = moved[polygon->vertexIndex(j)];
+		}
+		if (polygonMoved) {
+			polygon->calculateNormal();
+			for (size_t j = 0; j < cv; j++) {
+				changed[polygon->vertexIndex(j)] = true;
+			}
+		}
+	}
+
+	for (int i = 0; i < vCount; i++) {
+		if (changed[i]) {
+			calculateVertexNormal(i);
 		}
-		normal[0] /= count;
-		normal[1] /= count;
-		normal[2] /= count;
-		vertices[i]->setNormal(normal);
 	}
 }
 
 void OffScene::cleanup()
 {
+	delete halfEdgeMesh;
+	halfEdgeMesh = nullptr;
+	hasStatistics = false;
+
 	for(int i=0; i<polygons.size(); i++) {
 		delete polygons[i];
 	}
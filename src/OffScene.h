@@ -4,6 +4,12 @@
 
 #include "IScene.h"
 #include "CPolygon.h"
+#include "LoadTimings.h"
+#include "MeshData.h"
+#include "VertexWelder.h"
+#include "MeshStatistics.h"
+
+class HalfEdgeMesh;
 
 /**
  * @brief Parser and IScene implementation for OFF files
@@ -27,9 +33,13 @@ public:
 	 *
 	 * Constructor of OffScene, delegates almost all work to parseFile().
 	 *
-	 * @param [in] fileName The OFF file which should get parsed
+	 * @param [in] fileName The OFF file which should get parsed, "-" for stdin
+	 * @param [in] showProgress Show a progress dialog, needs a QApplication
+	 * @param [out] timings Receives the time of the loading phases, may be null
+	 * @param [in] abort Cancels the loading from another thread if set, may be null
 	 */
-	OffScene(const QString & fileName);
+	OffScene(const QString & fileName, bool showProgress = true, LoadTimings *timings = nullptr,
+		const QAtomicInt *abort = nullptr);
 
 	/**
 	 * @brief Destructor
@@ -43,6 +53,142 @@ public:
 	const CPolygon* polygon(int i) const override;
 	int verticesCount() const override;
 	const CVertex* vertex(int i) const override;
+	MemoryReport memoryReport() const override;
+
+	/**
+	 * @brief Writes the parsed scene in a binary form
+	 *
+	 * Reading the snapshot with fromSnapshot() is much faster than parsing
+	 * the OFF file again, because no text has to be converted to numbers.
+	 * Only the vertices and polygons are written, the normals and the
+	 * connected polygons are calculated again when reading.
+	 *
+	 * @param [in] stream Receives the vertices and polygons
+	 */
+	void writeSnapshot(QDataStream *stream) const;
+
+	/**
+	 * @brief Creates a scene from a snapshot
+	 *
+	 * Throws a QString if the snapshot is damaged.
+	 *
+	 * @param [in] stream Contains a snapshot written by writeSnapshot()
+	 * @return The new scene
+	 */
+	static OffScene* fromSnapshot(QDataStream *stream);
+
+	/**
+	 * @brief Creates a scene from the arrays of another file format
+	 *
+	 * The vertex and polygon objects are created in parallel. Stored vertex
+	 * normals are taken over instead of being calculated. Throws a
+	 * QString if a polygon has less than three vertices or uses a vertex
+	 * that does not exist.
+	 *
+	 * @param [in] mesh Vertices and polygons read from the file
+	 * @param [in] abort Cancels the creation from another thread if set, may be null
+	 * @return The new scene
+	 */
+	static OffScene* fromMesh(const MeshData & mesh, const QAtomicInt *abort = nullptr);
+
+	/**
+	 * @brief Copies the vertices and polygons into plain arrays
+	 *
+	 * The polygons are copied in the order of polygon(), the normals
+	 * are left out.
+	 *
+	 * @param [out] mesh Receives the vertices and polygons
+	 */
+	void toMesh(MeshData *mesh) const;
+
+	/**
+	 * @brief Returns the half-edge connectivity of the polygons
+	 *
+	 * The structure is built in parallel on the first call and kept until
+	 * polygons are added. Moving vertices with applyUpdate() keeps it.
+	 * May be called from several threads.
+	 *
+	 * @return The half-edges, owned by the scene
+	 */
+	const HalfEdgeMesh* halfEdges() const;
+
+	/**
+	 * @brief Returns what was removed from the file while loading
+	 *
+	 * All counts are zero if the scene was not cleaned.
+	 */
+	VertexWelder::Report cleanReport() const;
+
+	/**
+	 * @brief Remembers what VertexWelder::clean() removed from the file
+	 */
+	void setCleanReport(const VertexWelder::Report & report);
+
+	/**
+	 * @brief Returns the remembered statistics of the scene
+	 *
+	 * The statistics are forgotten when polygons are added or vertices
+	 * are moved.
+	 *
+	 * @param [out] statistics Receives the statistics
+	 * @return False, if no statistics are remembered
+	 */
+	bool statistics(MeshStatistics::Report *statistics) const;
+
+	/**
+	 * @brief Remembers the statistics of the scene
+	 */
+	void setStatistics(const MeshStatistics::Report & statistics);
+
+	/**
+	 * @brief New vertex data of a changed file with the same topology
+	 *
+	 * An invalid color means no color.
+	 */
+	struct Update
+	{
+		/**
+		 * @brief x, y and z of each vertex
+		 */
+		QVector<float> positions;
+
+		/**
+		 * @brief Color of each vertex
+		 */
+		QVector<QColor> vertexColors;
+
+		/**
+		 * @brief Color of each polygon in the order of polygon()
+		 */
+		QVector<QColor> polygonColors;
+	};
+
+	/**
+	 * @brief Reads the vertices and colors of a changed file
+	 *
+	 * The polygon lines are only compared with the polygons of this scene.
+	 * The scene is not changed, so this may run in a background thread
+	 * while the scene is drawn. Throws a QString if the file is invalid.
+	 *
+	 * @param [in] fileName The changed OFF file
+	 * @param [out] update Receives the new vertices and colors
+	 * @param [in] abort Cancels the reading from another thread if set, may be null
+	 * @return False, if the file has other vertex or polygon numbers or
+	 *         other polygon indices than the scene, or if it was canceled
+	 */
+	bool readUpdate(const QString & fileName, Update *update,
+		const QAtomicInt *abort = nullptr) const;
+
+	/**
+	 * @brief Replaces the vertices and colors with the result of readUpdate()
+	 *
+	 * The connected polygons of each vertex are reused. Only the normal
+	 * vectors of polygons with a moved vertex and of their vertices are
+	 * calculated again.
+	 *
+	 * @param [in] update New vertex data for exactly this scene
+	 */
+	void applyUpdate(const Update & update);
 
 private slots:
 	/**
@@ -54,6 +200,35 @@ private slots:
 	void cancel();
 	
 private:
+	/**
+	 * @brief Reads stdin with the parser of this class into a growing scene
+	 */
+	friend class StreamLoader;
+
+	/**
+	 * @brief Streams files into tiles with the parser of this class
+	 */
+	friend class TileConverter;
+
+	/**
+	 * @brief Creates an empty scene for fromSnapshot() and StreamLoader
+	 */
+	OffScene();
+
+	/**
+	 * @brief Adds vertices and polygons read from a stream
+	 *
+	 * The scene takes the ownership. The polygons may only use vertices
+	 * which are already in the scene or added by the same call. Only the
+	 * normal vectors of the new polygons and of their vertices are
+	 * calculated, the polygons are sorted like in finalize().
+	 *
+	 * @param [in] newVertices Vertices that follow the existing ones
+	 * @param [in] newPolygons Polygons in the order of the stream
+	 * @param [in] newColored Has one of the new vertices or polygons a color?
+	 */
+	void append(const QVector<CVertex*> & newVertices,
+		const QVector<CPolygon*> & newPolygons, bool newColored);
 
 	/**
 	 * @brief Opens a file to create a OffScene
@@ -75,17 +250,21 @@ private:
 	 *    number of polygons. Each polygon line should consist of the vertex counter
 	 *    followed by the vertex indices and an another optional color value.
 	 *
-	 * 6. Sort the polygons by the transparency value to archieve a better result
+	 * 6. Collect the connected polygons of each vertex
+	 *
+	 * 7. Sort the polygons by the transparency value to archieve a better result
 	 *    when rendering the scene in OpenGL. (Details are provided in the German
 	 *    OffView documentation!)
 	 *
-	 * 7. Precalculate the normal vectors for all polygon surfaces. They are used
+	 * 8. Precalculate the normal vectors for all polygon surfaces. They are used
 	 *    when rendering the scene in OpenGL with lights. (Details are provided in 
 	 *    the German OffView documentation!)
 	 *
-	 * @param [in] fileName Contains the path to the file which will be parsed
+	 * @param [in] fileName Contains the path to the file which will be parsed,
+	 *             "-" reads stdin in a single forward pass
+	 * @param [in] showProgress Show a progress dialog while parsing
 	 */
-	void parseFile(const QString & fileName);
+	void parseFile(const QString & fileName, bool showProgress);
 
 	/**
 	 * @brief Skips empty lines and comments and reads the next line
@@ -93,12 +272,13 @@ private:
 	 * Reads the next non empty and comment free line of of the supplied
 	 * QTextStream. The line is also trimmed, so it has no whitespaces at the
 	 * beginning or end. Throws an QString exception if there is no more valid
-	 * line to read. 
+	 * line to read. Works on pipes, which only know their end after a read
+	 * returned nothing.
 	 *
 	 * @param [in] stream A stream to read the next valid line
 	 * @return The next not empty line free from comments
 	 */
-	QString readNextLine(QTextStream *stream);
+	QString readNextLine(QTextStream *stream) const;
 
 	/**
 	 * @brief Splits at tab and space, skips the empty parts
@@ -112,7 +292,7 @@ private:
 	 * @param string The string which should be splitted
 	 * @return A list of strings
 	 */
-	QStringList split2Token(QString *string);
+	QStringList split2Token(QString *string) const;
 	
 	/**
 	 * @brief Create a (colored) vertex from a list of tokens
@@ -153,7 +333,7 @@ private:
 	 * @param [in] offset The offset at which the color information is assumed
 	 * @return A color object which may be invalid or empty
 	 */
-	QColor readColor(QStringList *tokens, int offset);
+	QColor readColor(QStringList *tokens, int offset) const;
 
 	/**
 	 * @brief Levels a list of double values
@@ -169,7 +349,7 @@ private:
 	 * @param [in, out] values A array of double values which shall be leveled
 	 * @param [in] count Number of double values in the supplied field
 	 */
-	void levelColorValues(double *values, int count);
+	void levelColorValues(double *values, int count) const;
 
 	/**
 	 * @brief Comparison method for transparency sorting
@@ -183,14 +363,38 @@ private:
 	 */
 	static bool alphaChannelCompare(const CPolygon *p1, const CPolygon *p2);
 
+	/**
+	 * @brief Comparison method for transparency sorting of colors
+	 *
+	 * Same order as alphaChannelCompare(), an invalid color stands
+	 * for a polygon without color.
+	 *
+	 * @param [in] c1 Color of polygon 1
+	 * @param [in] c2 Color of polygon 2
+	 * @return Alpha channel of c1 > Alpha channel of c2?
+	 */
+	static bool alphaColorCompare(const QColor & c1, const QColor & c2);
+
+	/**
+	 * @brief Calculates the normal vector of a vertex
+	 *
+	 * The normal vector of a vertex is the average of the normal vectors
+	 * of all connected polygons.
+	 *
+	 * @param [in] i Number of the vertex
+	 */
+	void calculateVertexNormal(int i);
+
 	/**
 	 * @brief Additional calculations after data parsing
 	 *
 	 * For advanced features like transparency and (smooth) shading we
 	 * need to calculate some additional things like polygon and vertex normals.
 	 * We do also sort the polygons for a better transparency effect.
+	 *
+	 * @param [in] vertexNormals False if the vertices already have their normals
 	 */
-	void finalize();
+	void finalize(bool vertexNormals = true);
 
 	/**
 	 * @brief Deletes all vertices and polygons
@@ -205,6 +409,16 @@ private:
 	 */
 	bool colored;
 
+	/**
+	 * @brief Receives the time of the loading phases or null
+	 */
+	LoadTimings *timings;
+
+	/**
+	 * @brief Cancels the loading from another thread if set, or null
+	 */
+	const QAtomicInt *abort;
+
 	/**
 	 * @brief Contains the polygons of the OffScene
 	 */
@@ -224,4 +438,29 @@ private:
 	 * @brief Was the loading process of the file canceled?
 	 */
 	bool canceled;
+
+	/**
+	 * @brief What was removed while loading
+	 */
+	VertexWelder::Report report;
+
+	/**
+	 * @brief The statistics, only valid if hasStatistics is true
+	 */
+	MeshStatistics::Report statisticsReport;
+
+	/**
+	 * @brief Were statistics remembered?
+	 */
+	bool hasStatistics;
+
+	/**
+	 * @brief The half-edges or null if they were not needed yet
+	 */
+	mutable HalfEdgeMesh *halfEdgeMesh;
+
+	/**
+	 * @brief Protects halfEdgeMesh while it is built
+	 */
+	mutable QMutex halfEdgeMutex;
 };
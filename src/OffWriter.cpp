@@ -0,0 +1,350 @@
+#include <cmath>
+#include <cstring>
+
+#include "OffWriter.h"
+#include "Parallel.h"
+#include "Trace.h"
+
+void OffWriter::write(const IScene *scene, const QString & fileName, Format format,
+	const ProgressFunction & progress)
+{
+	TRACE_ZONE("OffWriter::write");
+	int vCount = scene->verticesCount();
+	int pCount = scene->polygonsCount();
+
+	QAtomicInt coloredVertices(0);
+	Parallel::forBlocks(vCount, 1 << 16, [&](int begin, int end) {
+		for (int i = begin; i < end && !coloredVertices.load(); i++) {
+			if (scene->vertex(i)->isColored()) {
+				coloredVertices.store(1);
+			}
+		}
+	});
+	bool withColor = coloredVertices.load();
+
+	QFile file(fileName);
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+		throw tr("Unable to open file ") + fileName;
+	}
+
+	try {
+		QByteArray header = withColor ? "COFF" : "OFF";
+		if (format == Binary) {
+			header += " BINARY\n";
+			quint32 counts[3];
+			qToBigEndian<quint32>(quint32(vCount), reinterpret_cast<uchar*>(counts));
+			qToBigEndian<quint32>(quint32(pCount), reinterpret_cast<uchar*>(counts + 1));
+			qToBigEndian<quint32>(0, reinterpret_cast<uchar*>(counts + 2));
+			header.append(reinterpret_cast<const char*>(counts), sizeof(counts));
+		} else {
+			header += "\n" + QByteArray::number(vCount) + " " + QByteArray::number(pCount) + " 0\n";
+		}
+		if (file.write(header) != header.size()) {
+			throw tr("Unable to write file ") + fileName;
+		}
+
+		qint64 total = qint64(vCount) + pCount;
+		writeElements(&file, vCount, [&](int begin, int end, QByteArray *buffer) {
+			for (int i = begin; i < end; i++) {
+				if (format == Binary) {
+					packVertex(scene->vertex(i), withColor, buffer);
+				} else {
+					formatVertex(scene->vertex(i), withColor, buffer);
+				}
+			}
+		}, 0, total, progress);
+		writeElements(&file, pCount, [&](int begin, int end, QByteArray *buffer) {
+			for (int i = begin; i < end; i++) {
+				if (format == Binary) {
+					packPolygon(scene->polygon(i), buffer);
+				} else {
+					formatPolygon(scene->polygon(i), buffer);
+				}
+			}
+		}, vCount, total, progress);
+
+		if (!file.flush()) {
+			throw tr("Unable to write file ") + fileName;
+		}
+	}
+	catch (QString &) {
+		file.close();
+		file.remove();
+		throw;
+	}
+}
+
+void OffWriter::writeElements(QFile *file, int count, const FormatFunction & format,
+	qint64 done, qint64 total, const ProgressFunction & progress)
+{
+	TRACE_ZONE("OffWriter::writeElements");
+	for (int window = 0; window < count; window += windowSize) {
+		int windowEnd = qMin(count, window + windowSize);
+		int blocks = Parallel::blockCount(windowEnd - window, minBlockSize);
+		QVector<QByteArray> buffers(blocks);
+		Parallel::forEachBlock(windowEnd - window, minBlockSize,
+			[&](int block, int begin, int end) {
+				format(window + begin, window + end, &buffers[block]);
+			});
+
+		for (int b = 0; b < blocks; b++) {
+			if (file->write(buffers[b]) != buffers[b].size()) {
+				throw tr("Unable to write file ") + file->fileName();
+			}
+		}
+
+		int percent = total > 0 ? int(100 * (done + windowEnd) / total) : 100;
+		if (progress && !progress(percent)) {
+			throw tr("Aborted writing file!");
+		}
+	}
+}
+
+void OffWriter::formatVertex(const CVertex *vertex, bool withColor, QByteArray *buffer)
+{
+	char line[7 * (maxFloatChars + 1)];
+	char *p = line;
+	const float *xyz = vertex->vertex();
+	for (int k = 0; k < 3; k++) {
+		p = formatFloat(xyz[k], p);
+		*p++ = k < 2 ? ' ' : '\n';
+	}
+	if (withColor) {
+		QColor color = fileColor(vertex);
+		float rgba[4] = {
+			float(color.redF()), float(color.greenF()), float(color.blueF()), float(color.alphaF())
+		};
+		p[-1] = ' ';
+		for (int k = 0; k < 4; k++) {
+			p = formatFloat(rgba[k], p);
+			*p++ = k < 3 ? ' ' : '\n';
+		}
+	}
+	buffer->append(line, int(p - line));
+}
+
+void OffWriter::formatPolygon(const CPolygon *polygon, QByteArray *buffer)
+{
+	char text[4 * (maxFloatChars + 1)];
+	int count = int(polygon->vertexCount());
+	char *p = formatInt(count, text);
+	buffer->append(text, int(p - text));
+	for (int j = 0; j < count; j++) {
+		text[0] = ' ';
+		p = formatInt(polygon->vertexIndex(j), text + 1);
+		buffer->append(text, int(p - text));
+	}
+
+	p = text;
+	if (polygon->isColored()) {
+		const QColor & color = polygon->color();
+		float rgba[4] = {
+			float(color.redF()), float(color.greenF()), float(color.blueF()), float(color.alphaF())
+		};
+		for (int k = 0; k < 4; k++) {
+			*p++ = ' ';
+			p = formatFloat(rgba[k], p);
+		}
+	}
+	*p++ = '\n';
+	buffer->append(text, int(p - text));
+}
+
+void OffWriter::packVertex(const CVertex *vertex, bool withColor, QByteArray *buffer)
+{
+	float values[7];
+	memcpy(values, vertex->vertex(), 3 * sizeof(float));
+	int count = 3;
+	if (withColor) {
+		QColor color = fileColor(vertex);
+		values[3] = float(color.redF());
+		values[4] = float(color.greenF());
+		values[5] = float(color.blueF());
+		values[6] = float(color.alphaF());
+		count = 7;
+	}
+
+	uchar data[7 * 4];
+	for (int k = 0; k < count; k++) {
+		quint32 bits;
+		memcpy(&bits, values + k, sizeof(bits));
+		qToBigEndian<quint32>(bits, data + 4 * k);
+	}
+	buffer->append(reinterpret_cast<const char*>(data), 4 * count);
+}
+
+void OffWriter::packPolygon(const CPolygon *polygon, QByteArray *buffer)
+{
+	uchar data[4 * 4];
+	int count = int(polygon->vertexCount());
+	qToBigEndian<quint32>(quint32(count), data);
+	buffer->append(reinterpret_cast<const char*>(data), 4);
+	for (int j = 0; j < count; j++) {
+		qToBigEndian<quint32>(quint32(polygon->vertexIndex(j)), data);
+		buffer->append(reinterpret_cast<const char*>(data), 4);
+	}
+
+	// The number of color components and the components as floats
+	if (polygon->isColored()) {
+		const QColor & color = polygon->color();
+		float rgba[4] = {
+			float(color.redF()), float(color.greenF()), float(color.blueF()), float(color.alphaF())
+		};
+		qToBigEndian<quint32>(4, data);
+		buffer->append(reinterpret_cast<const char*>(data), 4);
+		for (int k = 0; k < 4; k++) {
+			quint32 bits;
+			memcpy(&bits, rgba + k, sizeof(bits));
+			qToBigEndian<quint32>(bits, data + 4 * k);
+		}
+		buffer->append(reinterpret_cast<const char*>(data), 16);
+	} else {
+		qToBigEndian<quint32>(0, data);
+		buffer->append(reinterpret_cast<const char*>(data), 4);
+	}
+}
+
+QColor OffWriter::fileColor(const CVertex *vertex)
+{
+	return vertex->isColored() ? vertex->color() : QColor(Qt::white);
+}
+
+char* OffWriter::formatInt(int value, char *out)
+{
+	char digits[12];
+	int count = 0;
+	quint32 rest = value < 0 ? 0u - quint32(value) : quint32(value);
+	do {
+		digits[count++] = char('0' + rest % 10);
+		rest /= 10;
+	} while (rest > 0);
+
+	if (value < 0) {
+		*out++ = '-';
+	}
+	while (count > 0) {
+		*out++ = digits[--count];
+	}
+	return out;
+}
+
+char* OffWriter::formatFloat(float value, char *out)
+{
+	if (value == 0.0f) {
+		*out++ = '0';
+		return out;
+	}
+	if (!qIsFinite(value)) {
+		QByteArray text = QByteArray::number(double(value));
+		memcpy(out, text.constData(), text.size());
+		return out + text.size();
+	}
+	if (value < 0.0f) {
+		*out++ = '-';
+		value = -value;
+	}
+
+	// The decimal exponent of the first digit, log10() may be off by one
+	double magnitude = value;
+	int exponent = int(std::floor(std::log10(magnitude)));
+	if (scale(1.0, exponent) > magnitude) {
+		exponent--;
+	} else if (scale(1.0, exponent + 1) <= magnitude) {
+		exponent++;
+	}
+
+	// Try more and more digits until the number reads back to the same float
+	quint64 digits = 0;
+	int precision = 1;
+	quint64 limit = 10;
+	for (; precision <= 9; precision++, limit *= 10) {
+		digits = quint64(std::floor(scale(magnitude, precision - 1 - exponent) + 0.5));
+		int first = exponent;
+		if (digits >= limit) {
+			digits /= 10;
+			first++;
+		}
+		if (readsBack(digits, first - precision + 1, value)) {
+			exponent = first;
+			break;
+		}
+	}
+	if (precision > 9) {
+		QByteArray text = QByteArray::number(double(value), 'g', 9);
+		memcpy(out, text.constData(), text.size());
+		return out + text.size();
+	}
+	while (precision > 1 && digits % 10 == 0) {
+		digits /= 10;
+		precision--;
+	}
+
+	char text[10];
+	for (int k = precision - 1; k >= 0; k--) {
+		text[k] = char('0' + digits % 10);
+		digits /= 10;
+	}
+
+	if (exponent >= -5 && exponent < 0) {
+		// 0.000ddd
+		*out++ = '0';
+		*out++ = '.';
+		for (int k = -1; k > exponent; k--) {
+			*out++ = '0';
+		}
+		memcpy(out, text, precision);
+		out += precision;
+	} else if (exponent >= 0 && exponent < 9) {
+		// ddd000 or ddd.ddd
+		for (int k = 0; k <= qMax(exponent, precision - 1); k++) {
+			if (k == exponent + 1) {
+				*out++ = '.';
+			}
+			*out++ = k < precision ? text[k] : '0';
+		}
+	} else {
+		// d.ddde-12
+		*out++ = text[0];
+		if (precision > 1) {
+			*out++ = '.';
+			memcpy(out, text + 1, precision - 1);
+			out += precision - 1;
+		}
+		*out++ = 'e';
+		out = formatInt(exponent, out);
+	}
+	return out;
+}
+
+bool OffWriter::readsBack(quint64 digits, int power, float value)
+{
+	// The digits and the powers up to 22 are exact doubles, so a single
+	// multiplication or division rounds like a correct parser does
+	if (power >= -22 && power <= 22) {
+		return float(scale(double(digits), power)) == value;
+	}
+
+	// Further away scale() rounds twice, so the text is parsed like OffScene does
+	QByteArray text = QByteArray::number(digits);
+	text += 'e';
+	text += QByteArray::number(power);
+	return float(text.toDouble()) == value;
+}
+
+double OffWriter::scale(double value, int exponent)
+{
+	// Powers up to 22 are exact doubles
+	static const double powers[] = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+	};
+	while (exponent > 22) {
+		value *= 1e22;
+		exponent -= 22;
+	}
+	while (exponent < -22) {
+		value /= 1e22;
+		exponent += 22;
+	}
+	return exponent >= 0 ? value * powers[exponent] : value / powers[-exponent];
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <functional>
+
+#include <QtCore>
+
+#include "IScene.h"
+
+/**
+ * @brief Writes scenes as OFF or COFF files
+ *
+ * The vertices and polygons are formatted in windows of a few million
+ * elements. Each window is cut into blocks which are formatted by several
+ * threads into their own buffers, then the buffers are written in order.
+ * So the output is the same as a serial writer would produce, but only one
+ * window of text is held in memory.
+ *
+ * Numbers are formatted without the C library: the shortest decimal which
+ * reads back to the same float is searched directly. This is faster than
+ * printf() and does not depend on the locale of the user. Each candidate is
+ * checked with the conversion of the readers, a correctly rounded double
+ * that is cast to float.
+ *
+ * The file is a COFF file if any vertex is colored. Polygon colors are also
+ * part of plain OFF files. The binary variant follows the Geomview format:
+ * big endian 32 bit integers and floats, each face has its number of colors
+ * behind the indices.
+ *
+ * Every vertex of a COFF file has a color, which the binary variant can not
+ * leave out. So vertices without a color are written opaque white, in text
+ * files as well, and read back as white vertices.
+ */
+class OffWriter
+{
+	Q_DECLARE_TR_FUNCTIONS(OffWriter)
+
+public:
+	/**
+	 * @brief The variants of the file format
+	 */
+	enum Format
+	{
+		Text, Binary
+	};
+
+	/**
+	 * @brief Function type for progress reports
+	 *
+	 * Receives the progress from 0 to 100 and returns false to abort.
+	 */
+	typedef std::function<bool(int percent)> ProgressFunction;
+
+	/**
+	 * @brief Writes a scene into a file
+	 *
+	 * Throws a QString with an error message if the file can not be
+	 * written. An incomplete file is removed.
+	 *
+	 * @param [in] scene The scene which should be saved
+	 * @param [in] fileName Path of the new file
+	 * @param [in] format Text or binary
+	 * @param [in] progress Optional progress callback
+	 */
+	static void write(const IScene *scene, const QString & fileName, Format format,
+		const ProgressFunction & progress = ProgressFunction());
+
+	/**
+	 * @brief Formats the shortest decimal that reads back to the same float
+	 *
+	 * @param [in] value The number
+	 * @param [out] out Receives up to maxFloatChars characters
+	 * @return The end of the written characters
+	 */
+	static char* formatFloat(float value, char *out);
+
+	/**
+	 * @brief Maximum number of characters formatFloat() writes
+	 */
+	static const int maxFloatChars = 16;
+
+private:
+	/**
+	 * @brief Number of elements which are formatted before they are written
+	 */
+	static const int windowSize = 1 << 21;
+
+	/**
+	 * @brief Minimum number of elements a thread formats
+	 */
+	static const int minBlockSize = 1 << 12;
+
+	/**
+	 * @brief Formats elements [begin, end) by appending to a buffer
+	 */
+	typedef std::function<void(int begin, int end, QByteArray *buffer)> FormatFunction;
+
+	/**
+	 * @brief Formats and writes count elements window by window
+	 *
+	 * @param [in] file The open output file
+	 * @param [in] count Number of elements
+	 * @param [in] format Formats a range of elements in a worker thread
+	 * @param [in] done Number of elements written before, for the progress
+	 * @param [in] total Number of all elements, for the progress
+	 */
+	static void writeElements(QFile *file, int count, const FormatFunction & format,
+		qint64 done, qint64 total, const ProgressFunction & progress);
+
+	/**
+	 * @brief Appends a vertex line
+	 */
+	static void formatVertex(const CVertex *vertex, bool withColor, QByteArray *buffer);
+
+	/**
+	 * @brief Appends a polygon line
+	 */
+	static void formatPolygon(const CPolygon *polygon, QByteArray *buffer);
+
+	/**
+	 * @brief Appends a binary vertex
+	 */
+	static void packVertex(const CVertex *vertex, bool withColor, QByteArray *buffer);
+
+	/**
+	 * @brief Appends a binary face
+	 */
+	static void packPolygon(const CPolygon *polygon, QByteArray *buffer);
+
+	/**
+	 * @brief Returns the color of a vertex in a COFF file, white if it has none
+	 */
+	static QColor fileColor(const CVertex *vertex);
+
+	/**
+	 * @brief Does digits * 10^power read back to the value?
+	 */
+	static bool readsBack(quint64 digits, int power, float value);
+
+	/**
+	 * @brief Writes an integer as text
+	 */
+	static char* formatInt(int value, char *out);
+
+	/**
+	 * @brief Multiplies a value with a power of ten
+	 */
+	static double scale(double value, int exponent);
+};
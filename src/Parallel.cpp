@@ -0,0 +1,56 @@
+#include "Parallel.h"
+#include "Trace.h"
+
+int Parallel::blockCount(int count, int minBlockSize)
+{
+	if (count <= 0) {
+		return 0;
+	}
+
+	// Use a few blocks per thread to balance uneven work
+	int maxBlocks = QThread::idealThreadCount() * 4;
+	int blocks = count / qMax(1, minBlockSize);
+	return qBound(1, blocks, qMax(1, maxBlocks));
+}
+
+int Parallel::blockBegin(int block, int count, int minBlockSize)
+{
+	int blocks = blockCount(count, minBlockSize);
+	if (block >= blocks) {
+		return count;
+	}
+	return static_cast<int>(static_cast<qint64>(count) * block / blocks);
+}
+
+void Parallel::forBlocks(int count, int minBlockSize,
+	const std::function<void(int begin, int end)> & function)
+{
+	forEachBlock(count, minBlockSize, [&](int, int begin, int end) {
+		function(begin, end);
+	});
+}
+
+void Parallel::forEachBlock(int count, int minBlockSize,
+	const std::function<void(int block, int begin, int end)> & function)
+{
+	int blocks = blockCount(count, minBlockSize);
+	if (blocks == 0) {
+		return;
+	}
+	if (blocks == 1) {
+		function(0, 0, count);
+		return;
+	}
+
+	QVector<int> numbers(blocks);
+	for (int i = 0; i < blocks; i++) {
+		numbers[i] = i;
+	}
+
+	QtConcurrent::blockingMap(numbers, [&](int & block) {
+		TRACE_ZONE("Parallel block");
+		int begin = blockBegin(block, count, minBlockSize);
+		int end = blockBegin(block + 1, count, minBlockSize);
+		function(block, begin, end);
+	});
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+
+#include <QVector>
+#include <QThread>
+#include <QtConcurrent>
+
+/**
+ * @brief Small helpers for data parallel loops
+ *
+ * The scene data is stored in plain vectors, so most of the heavy lifting
+ * after loading can be split into independent index ranges. These helpers
+ * cut such a range into blocks and process the blocks on the global
+ * QThreadPool. Small inputs are processed directly in the calling thread.
+ */
+class Parallel
+{
+public:
+	/**
+	 * @brief Calls a function for blocks of an index range in parallel
+	 *
+	 * Splits the range [0, count) into blocks of at least minBlockSize
+	 * indices and calls function(begin, end) for each block. The call
+	 * returns after all blocks have been processed. The blocks are
+	 * disjoint, so the function can write to per-index output without
+	 * any locking.
+	 *
+	 * @param [in] count Number of indices
+	 * @param [in] minBlockSize Minimum number of indices per block
+	 * @param [in] function Function which processes the range [begin, end)
+	 */
+	static void forBlocks(int count, int minBlockSize,
+		const std::function<void(int begin, int end)> & function);
+
+	/**
+	 * @brief Returns the number of blocks forBlocks() would use
+	 *
+	 * Useful to allocate per-block partial results before a parallel
+	 * reduction. Block i covers blockBegin(i) to blockBegin(i+1).
+	 *
+	 * @param [in] count Number of indices
+	 * @param [in] minBlockSize Minimum number of indices per block
+	 * @return Number of blocks
+	 */
+	static int blockCount(int count, int minBlockSize);
+
+	/**
+	 * @brief Returns the first index of a block
+	 *
+	 * @param [in] block Number of the block, may be equal to blockCount()
+	 * @param [in] count Number of indices
+	 * @param [in] minBlockSize Minimum number of indices per block
+	 * @return First index of the block
+	 */
+	static int blockBegin(int block, int count, int minBlockSize);
+
+	/**
+	 * @brief Calls a function for each block with the block number
+	 *
+	 * Same as forBlocks(), but the function also receives the number of
+	 * the block, so that it can write into a per-block result slot.
+	 *
+	 * @param [in] count Number of indices
+	 * @param [in] minBlockSize Minimum number of indices per block
+	 * @param [in] function Function which processes block number block
+	 */
+	static void forEachBlock(int count, int minBlockSize,
+		const std::function<void(int block, int begin, int end)> & function);
+
+	/**
+	 * @brief Sorts a vector in parallel
+	 *
+	 * The blocks are sorted independently and merged pairwise afterwards.
+	 *
+	 * @param [in, out] values The values which should be sorted
+	 */
+	template<typename T>
+	static void sort(QVector<T> & values)
+	{
+		sort(values, std::less<T>());
+	}
+
+	/**
+	 * @brief Sorts a vector in parallel with a custom comparison
+	 *
+	 * @param [in, out] values The values which should be sorted
+	 * @param [in] less Strict weak ordering of the values
+	 */
+	template<typename T, typename Less>
+	static void sort(QVector<T> & values, Less less)
+	{
+		const int minBlockSize = 1 << 16;
+		int count = values.size();
+		int blocks = blockCount(count, minBlockSize);
+		T *data = values.data();
+
+		forBlocks(count, minBlockSize, [&](int begin, int end) {
+			std::sort(data + begin, data + end, less);
+		});
+
+		// Merge neighbouring sorted runs until only one is left
+		for (int width = 1; width < blocks; width *= 2) {
+			int pairs = (blocks + 2*width - 1) / (2*width);
+			forEachBlock(pairs, 1, [&](int, int begin, int end) {
+				for (int i = begin; i < end; i++) {
+					int first = blockBegin(2*i*width, count, minBlockSize);
+					int middle = blockBegin(qMin(blocks, (2*i+1)*width), count, minBlockSize);
+					int last = blockBegin(qMin(blocks, (2*i+2)*width), count, minBlockSize);
+					std::inplace_merge(data + first, data + middle, data + last, less);
+				}
+			});
+		}
+	}
+};
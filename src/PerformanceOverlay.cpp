@@ -0,0 +1,79 @@
+#include "PerformanceOverlay.h"
+#include "MemoryReport.h"
+
+PerformanceOverlay::RollingAverage::RollingAverage(int window)
+	: values(qMax(1, window), 0.0), next(0), count(0)
+{
+}
+
+void PerformanceOverlay::RollingAverage::add(double value)
+{
+	values[next] = value;
+	next = (next + 1) % values.size();
+	count = qMin(count + 1, values.size());
+}
+
+bool PerformanceOverlay::RollingAverage::isEmpty() const
+{
+	return count == 0;
+}
+
+double PerformanceOverlay::RollingAverage::value() const
+{
+	if (count == 0) {
+		return 0.0;
+	}
+	double sum = 0.0;
+	for (int i = 0; i < count; i++) {
+		sum += values[i];
+	}
+	return sum / count;
+}
+
+PerformanceOverlay::PerformanceOverlay(int window)
+	: cpuTime(window), gpuTime(window), triangles(window), vertices(window),
+	gpuBytes(0), sceneBytes(0)
+{
+}
+
+void PerformanceOverlay::addFrame(qint64 cpuNanoseconds, qint64 triangles, qint64 vertices)
+{
+	cpuTime.add(cpuNanoseconds / 1e6);
+	this->triangles.add(triangles);
+	this->vertices.add(vertices);
+}
+
+void PerformanceOverlay::addGpuTime(qint64 nanoseconds)
+{
+	gpuTime.add(nanoseconds / 1e6);
+}
+
+void PerformanceOverlay::setState(const QString & mode, qint64 gpuBytes, qint64 sceneBytes)
+{
+	this->mode = mode;
+	this->gpuBytes = gpuBytes;
+	this->sceneBytes = sceneBytes;
+}
+
+QStringList PerformanceOverlay::lines() const
+{
+	QStringList lines;
+	lines.append(tr("Mode: %1").arg(mode));
+	lines.append(tr("CPU: %1 ms").arg(cpuTime.value(), 0, 'f', 2));
+	if (gpuTime.isEmpty()) {
+		lines.append(tr("GPU: not available"));
+	} else {
+		lines.append(tr("GPU: %1 ms").arg(gpuTime.value(), 0, 'f', 2));
+	}
+	lines.append(tr("Triangles: %L1").arg(qRound64(triangles.value())));
+	lines.append(tr("Vertices: %L1").arg(qRound64(vertices.value())));
+
+	// The slower of both processors limits the throughput
+	double frameTime = qMax(cpuTime.value(), gpuTime.value());
+	if (frameTime > 0.0) {
+		lines.append(tr("Triangles/s: %L1 M").arg(triangles.value() / frameTime / 1e3, 0, 'f', 1));
+	}
+	lines.append(tr("GPU buffers: %1").arg(MemoryReport::formatBytes(gpuBytes)));
+	lines.append(tr("Scene memory: %1").arg(MemoryReport::formatBytes(sceneBytes)));
+	return lines;
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <QtCore>
+
+/**
+ * @brief Collects the measurements of the performance overlay
+ *
+ * GlWidget reports the time and the amount of geometry of each frame.
+ * The time values are averaged over the last frames, so the numbers
+ * shown in the overlay do not flicker. The GPU time arrives later than
+ * the other values, because the result of an OpenGL timer query is
+ * only read after the graphics card has finished the frame.
+ *
+ * GlWidget creates this object only while the overlay is visible.
+ *
+ * @see GlWidget
+ */
+class PerformanceOverlay
+{
+	Q_DECLARE_TR_FUNCTIONS(PerformanceOverlay)
+
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param [in] window Number of frames for the rolling averages
+	 */
+	PerformanceOverlay(int window = 60);
+
+	/**
+	 * @brief Adds the values of a finished frame
+	 *
+	 * @param [in] cpuNanoseconds Time spent in paintGL()
+	 * @param [in] triangles Number of scene triangles in the visible chunks
+	 * @param [in] vertices Number of vertices sent to OpenGL or the SoftwareRenderer
+	 */
+	void addFrame(qint64 cpuNanoseconds, qint64 triangles, qint64 vertices);
+
+	/**
+	 * @brief Adds the result of a timer query
+	 *
+	 * @param [in] nanoseconds Time the graphics card needed for a frame
+	 */
+	void addGpuTime(qint64 nanoseconds);
+
+	/**
+	 * @brief Sets the values which do not change every frame
+	 *
+	 * @param [in] mode Name of the active render mode or the SoftwareRenderer
+	 * @param [in] gpuBytes Size of the vertex buffers in graphics memory
+	 * @param [in] sceneBytes Main memory used by the scene
+	 */
+	void setState(const QString & mode, qint64 gpuBytes, qint64 sceneBytes);
+
+	/**
+	 * @brief Returns the text lines of the overlay
+	 */
+	QStringList lines() const;
+
+private:
+	/**
+	 * @brief Average of the last values
+	 */
+	class RollingAverage
+	{
+	public:
+		RollingAverage(int window);
+		void add(double value);
+		bool isEmpty() const;
+		double value() const;
+
+	private:
+		QVector<double> values;
+		int next;
+		int count;
+	};
+
+	RollingAverage cpuTime;
+	RollingAverage gpuTime;
+	RollingAverage triangles;
+	RollingAverage vertices;
+
+	QString mode;
+	qint64 gpuBytes;
+	qint64 sceneBytes;
+};
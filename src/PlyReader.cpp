@@ -0,0 +1,406 @@
+#include <cstring>
+#include <limits>
+
+#include "PlyReader.h"
+#include "Parallel.h"
+#include "Trace.h"
+
+void PlyReader::read(const QString & fileName, MeshData *mesh, const QAtomicInt *abort)
+{
+	TRACE_ZONE("PlyReader::read");
+	QFile file(fileName);
+	if (!file.open(QIODevice::ReadOnly)) {
+		throw tr("Unable to open file ") + fileName;
+	}
+	qint64 size = file.size();
+	const uchar *mapped = size > 0 ? file.map(0, size) : nullptr;
+	if (!mapped) {
+		throw tr("Unable to map file ") + fileName;
+	}
+
+	Data data;
+	data.begin = mapped;
+	data.end = mapped + size;
+	data.bigEndian = false;
+	mesh->vertexColors.clear();
+	mesh->polygonColors.clear();
+	mesh->fileIndices.clear();
+
+	try {
+		QVector<Element> elements;
+		const uchar *p = data.begin + readHeader(&data, &elements);
+		bool vertices = false;
+		bool faces = false;
+		for (int i = 0; i < elements.size() && !(vertices && faces); i++) {
+			if (elements[i].name == "vertex" && !vertices) {
+				p = readVertices(data, elements[i], p, mesh, abort);
+				vertices = true;
+			} else if (elements[i].name == "face" && !faces) {
+				p = readFaces(data, elements[i], p, mesh, abort);
+				faces = true;
+			} else {
+				p = skipElement(data, elements[i], p);
+			}
+		}
+		if (!vertices || !faces) {
+			throw tr("The PLY file has no vertices or faces!");
+		}
+	}
+	catch (QString &) {
+		file.unmap(const_cast<uchar*>(mapped));
+		throw;
+	}
+
+	file.unmap(const_cast<uchar*>(mapped));
+	if (abort && abort->load()) {
+		throw tr("Aborted file loading!");
+	}
+}
+
+qint64 PlyReader::readHeader(Data *data, QVector<Element> *elements)
+{
+	const uchar *p = data->begin;
+	bool format = false;
+	bool first = true;
+	while (true) {
+		const uchar *end = static_cast<const uchar*>(memchr(p, '\n', data->end - p));
+		if (!end) {
+			throw tr("The PLY header is incomplete!");
+		}
+		QByteArray line = QByteArray(reinterpret_cast<const char*>(p), end - p).simplified();
+		p = end + 1;
+		QList<QByteArray> words = line.split(' ');
+
+		if (first) {
+			if (line != "ply") {
+				throw tr("Wrong file format!");
+			}
+			first = false;
+		} else if (words[0] == "format") {
+			if (words.value(1) == "binary_little_endian") {
+				data->bigEndian = false;
+			} else if (words.value(1) == "binary_big_endian") {
+				data->bigEndian = true;
+			} else {
+				throw tr("Only binary PLY files are supported!");
+			}
+			format = true;
+		} else if (words[0] == "element" && words.size() == 3) {
+			Element element;
+			bool ok;
+			element.name = words[1];
+			element.count = words[2].toLongLong(&ok);
+			if (!ok || element.count < 0) {
+				throw tr("The PLY header is damaged!");
+			}
+			elements->append(element);
+		} else if (words[0] == "property" && !elements->isEmpty()) {
+			Property property;
+			if (words.value(1) == "list" && words.size() == 5) {
+				property.isList = true;
+				property.countType = parseType(words[2]);
+				property.type = parseType(words[3]);
+				property.name = words[4];
+			} else if (words.size() == 3) {
+				property.isList = false;
+				property.countType = UInt8;
+				property.type = parseType(words[1]);
+				property.name = words[2];
+			} else {
+				throw tr("The PLY header is damaged!");
+			}
+			elements->last().properties.append(property);
+		} else if (words[0] == "end_header") {
+			if (!format) {
+				throw tr("The PLY header is damaged!");
+			}
+			return p - data->begin;
+		}
+		// Comments and other lines are ignored
+	}
+}
+
+PlyReader::Type PlyReader::parseType(const QByteArray & name)
+{
+	if (name == "char" || name == "int8") {
+		return Int8;
+	} else if (name == "uchar" || name == "uint8") {
+		return UInt8;
+	} else if (name == "short" || name == "int16") {
+		return Int16;
+	} else if (name == "ushort" || name == "uint16") {
+		return UInt16;
+	} else if (name == "int" || name == "int32") {
+		return Int32;
+	} else if (name == "uint" || name == "uint32") {
+		return UInt32;
+	} else if (name == "float" || name == "float32") {
+		return Float32;
+	} else if (name == "double" || name == "float64") {
+		return Float64;
+	}
+	throw tr("Unknown PLY property type ") + QString::fromLatin1(name);
+}
+
+int PlyReader::typeBytes(Type type)
+{
+	switch (type) {
+		case Int8: case UInt8: return 1;
+		case Int16: case UInt16: return 2;
+		case Int32: case UInt32: case Float32: return 4;
+		case Float64: return 8;
+		default: return 0;
+	}
+}
+
+double PlyReader::value(const Data & data, const uchar *p, Type type)
+{
+	switch (type) {
+		case Int8: return qint8(p[0]);
+		case UInt8: return p[0];
+		case Int16:
+			return qint16(data.bigEndian ? qFromBigEndian<quint16>(p) : qFromLittleEndian<quint16>(p));
+		case UInt16:
+			return data.bigEndian ? qFromBigEndian<quint16>(p) : qFromLittleEndian<quint16>(p);
+		case Int32:
+			return qint32(data.bigEndian ? qFromBigEndian<quint32>(p) : qFromLittleEndian<quint32>(p));
+		case UInt32:
+			return data.bigEndian ? qFromBigEndian<quint32>(p) : qFromLittleEndian<quint32>(p);
+		case Float32: {
+			quint32 bits = data.bigEndian ? qFromBigEndian<quint32>(p) : qFromLittleEndian<quint32>(p);
+			float f;
+			memcpy(&f, &bits, sizeof(f));
+			return f;
+		}
+		case Float64: {
+			quint64 bits = data.bigEndian ? qFromBigEndian<quint64>(p) : qFromLittleEndian<quint64>(p);
+			double d;
+			memcpy(&d, &bits, sizeof(d));
+			return d;
+		}
+		default: return 0;
+	}
+}
+
+int PlyReader::fixedBytes(const Element & element)
+{
+	int bytes = 0;
+	for (int i = 0; i < element.properties.size(); i++) {
+		if (element.properties[i].isList) {
+			return -1;
+		}
+		bytes += typeBytes(element.properties[i].type);
+	}
+	return bytes;
+}
+
+const uchar* PlyReader::locate(const Data & data, const Element & element,
+	const uchar *record, const uchar **starts)
+{
+	const uchar *p = record;
+	for (int i = 0; i < element.properties.size(); i++) {
+		const Property & property = element.properties[i];
+		starts[i] = p;
+		qint64 bytes = typeBytes(property.type);
+		if (property.isList) {
+			int countBytes = typeBytes(property.countType);
+			if (data.end - p < countBytes) {
+				throw tr("The PLY file is truncated!");
+			}
+			double count = value(data, p, property.countType);
+			if (count < 0) {
+				throw tr("The PLY file is damaged!");
+			}
+			bytes = countBytes + qint64(count) * bytes;
+		}
+		if (data.end - p < bytes) {
+			throw tr("The PLY file is truncated!");
+		}
+		p += bytes;
+	}
+	return p;
+}
+
+int PlyReader::findProperty(const Element & element, const QList<QByteArray> & names)
+{
+	for (int i = 0; i < element.properties.size(); i++) {
+		if (names.contains(element.properties[i].name)) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+QColor PlyReader::readColor(const Data & data, const Element & element,
+	const int *colorProperties, const uchar * const *starts)
+{
+	double values[4] = {0.0, 0.0, 0.0, 1.0};
+	for (int k = 0; k < 4; k++) {
+		int property = colorProperties[k];
+		if (property < 0) {
+			continue;
+		}
+		// Integer colors go up to 255, floating point colors up to 1
+		Type type = element.properties[property].type;
+		double v = value(data, starts[property], type);
+		if (type != Float32 && type != Float64) {
+			v /= 255.0;
+		}
+		values[k] = qBound(0.0, v, 1.0);
+	}
+
+	QColor color;
+	color.setRgbF(values[0], values[1], values[2], values[3]);
+	return color;
+}
+
+const uchar* PlyReader::readVertices(const Data & data, const Element & element,
+	const uchar *start, MeshData *mesh, const QAtomicInt *abort)
+{
+	TRACE_ZONE("PlyReader::readVertices");
+	int xyz[3] = {
+		findProperty(element, {"x"}),
+		findProperty(element, {"y"}),
+		findProperty(element, {"z"})
+	};
+	if (xyz[0] < 0 || xyz[1] < 0 || xyz[2] < 0) {
+		throw tr("The PLY vertices have no x, y and z coordinates!");
+	}
+	int bytes = fixedBytes(element);
+	if (bytes < 0) {
+		throw tr("The PLY vertices must not contain lists!");
+	}
+	if (element.count > std::numeric_limits<int>::max() / 3) {
+		throw tr("Invalid vertex or polygon number!");
+	}
+	if ((data.end - start) / bytes < element.count) {
+		throw tr("The PLY file is truncated!");
+	}
+
+	int colorProperties[4] = {
+		findProperty(element, {"red", "diffuse_red", "r"}),
+		findProperty(element, {"green", "diffuse_green", "g"}),
+		findProperty(element, {"blue", "diffuse_blue", "b"}),
+		findProperty(element, {"alpha", "diffuse_alpha", "a"})
+	};
+	bool withColors = colorProperties[0] >= 0 && colorProperties[1] >= 0 && colorProperties[2] >= 0;
+
+	int count = int(element.count);
+	mesh->positions.resize(3 * count);
+	mesh->vertexColors.resize(withColors ? count : 0);
+	float *positions = mesh->positions.data();
+	QColor *colors = mesh->vertexColors.data();
+	int properties = element.properties.size();
+
+	// The records have the same size, so each block finds its own start
+	Parallel::forBlocks(count, 1 << 14, [&](int begin, int end) {
+		if (abort && abort->load()) {
+			return;
+		}
+		QVector<const uchar*> starts(properties);
+		for (int i = begin; i < end; i++) {
+			locate(data, element, start + qint64(i) * bytes, starts.data());
+			for (int k = 0; k < 3; k++) {
+				positions[3 * i + k] = float(value(data, starts[xyz[k]],
+					element.properties[xyz[k]].type));
+			}
+			if (withColors) {
+				colors[i] = readColor(data, element, colorProperties, starts.data());
+			}
+		}
+	});
+
+	return start + qint64(count) * bytes;
+}
+
+const uchar* PlyReader::readFaces(const Data & data, const Element & element,
+	const uchar *start, MeshData *mesh, const QAtomicInt *abort)
+{
+	TRACE_ZONE("PlyReader::readFaces");
+	int list = findProperty(element, {"vertex_indices", "vertex_index"});
+	if (list < 0 || !element.properties[list].isList) {
+		throw tr("The PLY faces have no vertex indices!");
+	}
+	if (element.count >= std::numeric_limits<int>::max()) {
+		throw tr("Invalid vertex or polygon number!");
+	}
+
+	int colorProperties[4] = {
+		findProperty(element, {"red", "diffuse_red", "r"}),
+		findProperty(element, {"green", "diffuse_green", "g"}),
+		findProperty(element, {"blue", "diffuse_blue", "b"}),
+		findProperty(element, {"alpha", "diffuse_alpha", "a"})
+	};
+	bool withColors = colorProperties[0] >= 0 && colorProperties[1] >= 0 && colorProperties[2] >= 0;
+
+	// The lists have different sizes, so the records are found one after another
+	int count = int(element.count);
+	int properties = element.properties.size();
+	const Property & indexList = element.properties[list];
+	QVector<const uchar*> records(count);
+	QVector<const uchar*> starts(properties);
+	mesh->offsets.resize(count + 1);
+	qint64 indices = 0;
+	const uchar *p = start;
+	for (int i = 0; i < count; i++) {
+		records[i] = p;
+		p = locate(data, element, p, starts.data());
+		mesh->offsets[i] = int(indices);
+		indices += qint64(value(data, starts[list], indexList.countType));
+		if (indices > std::numeric_limits<int>::max()) {
+			throw tr("Invalid vertex or polygon number!");
+		}
+		if (abort && i % 65536 == 0 && abort->load()) {
+			throw tr("Aborted file loading!");
+		}
+	}
+	mesh->offsets[count] = int(indices);
+
+	mesh->indices.resize(int(indices));
+	mesh->polygonColors.resize(withColors ? count : 0);
+	int *indexData = mesh->indices.data();
+	QColor *colors = mesh->polygonColors.data();
+	const int *offsets = mesh->offsets.constData();
+	int countBytes = typeBytes(indexList.countType);
+	int indexBytes = typeBytes(indexList.type);
+
+	// The serial pass has checked the records, so locate() does not throw here
+	Parallel::forBlocks(count, 1 << 14, [&](int begin, int end) {
+		if (abort && abort->load()) {
+			return;
+		}
+		QVector<const uchar*> recordStarts(properties);
+		for (int i = begin; i < end; i++) {
+			locate(data, element, records[i], recordStarts.data());
+			const uchar *values = recordStarts[list] + countBytes;
+			for (int k = offsets[i]; k < offsets[i + 1]; k++) {
+				indexData[k] = int(value(data, values, indexList.type));
+				values += indexBytes;
+			}
+			if (withColors) {
+				colors[i] = readColor(data, element, colorProperties, recordStarts.data());
+			}
+		}
+	});
+
+	return p;
+}
+
+const uchar* PlyReader::skipElement(const Data & data, const Element & element,
+	const uchar *start)
+{
+	int bytes = fixedBytes(element);
+	if (bytes >= 0) {
+		if (bytes > 0 && (data.end - start) / bytes < element.count) {
+			throw tr("The PLY file is truncated!");
+		}
+		return start + element.count * bytes;
+	}
+
+	QVector<const uchar*> starts(element.properties.size());
+	const uchar *p = start;
+	for (qint64 i = 0; i < element.count; i++) {
+		p = locate(data, element, p, starts.data());
+	}
+	return p;
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <QtCore>
+
+#include "MeshData.h"
+
+/**
+ * @brief Reader for binary PLY files
+ *
+ * A PLY file starts with a text header that describes the elements and
+ * their properties, followed by the data of all elements. The vertex
+ * element must have the properties x, y and z and may have the colors
+ * red, green, blue and alpha. The face element must have a list property
+ * vertex_indices or vertex_index and may have colors. Other elements
+ * and properties are skipped. Little and big endian files are supported,
+ * ASCII files are not.
+ *
+ * The file is mapped into memory. The vertices have a fixed size, so
+ * they are converted by several threads directly. The faces are lists,
+ * so their start offsets are found in a quick serial pass, before the
+ * indices are converted in parallel.
+ */
+class PlyReader
+{
+	Q_DECLARE_TR_FUNCTIONS(PlyReader)
+
+public:
+	/**
+	 * @brief Reads a binary PLY file
+	 *
+	 * Throws a QString if the file can not be read.
+	 *
+	 * @param [in] fileName Path to the file
+	 * @param [out] mesh Receives the vertices and faces
+	 * @param [in] abort Cancels the reading from another thread if set, may be null
+	 */
+	static void read(const QString & fileName, MeshData *mesh, const QAtomicInt *abort = nullptr);
+
+private:
+	/**
+	 * @brief Scalar types of the properties
+	 */
+	enum Type
+	{
+		Int8, UInt8, Int16, UInt16, Int32, UInt32, Float32, Float64
+	};
+
+	/**
+	 * @brief A property of an element
+	 */
+	struct Property
+	{
+		QByteArray name;
+		Type type;
+		bool isList;
+		Type countType;
+	};
+
+	/**
+	 * @brief An element of the header with its properties
+	 */
+	struct Element
+	{
+		QByteArray name;
+		qint64 count;
+		QVector<Property> properties;
+	};
+
+	/**
+	 * @brief The mapped data of a file
+	 */
+	struct Data
+	{
+		const uchar *begin;
+		const uchar *end;
+		bool bigEndian;
+	};
+
+	/**
+	 * @brief Parses the header, returns the offset of the first element
+	 *
+	 * @param [in, out] data Receives the byte order of the file
+	 * @param [out] elements Receives the elements in the order of the file
+	 */
+	static qint64 readHeader(Data *data, QVector<Element> *elements);
+
+	/**
+	 * @brief Converts a type name like "float" or "uint8"
+	 */
+	static Type parseType(const QByteArray & name);
+
+	/**
+	 * @brief Returns the size of a type in bytes
+	 */
+	static int typeBytes(Type type);
+
+	/**
+	 * @brief Reads a value of a type
+	 */
+	static double value(const Data & data, const uchar *p, Type type);
+
+	/**
+	 * @brief Returns the size of a record of an element without lists or -1
+	 */
+	static int fixedBytes(const Element & element);
+
+	/**
+	 * @brief Finds the start of each property of a record
+	 *
+	 * Throws a QString if the record does not end within the file.
+	 *
+	 * @param [in] record Start of the record
+	 * @param [out] starts Receives the start of each property
+	 * @return The end of the record
+	 */
+	static const uchar* locate(const Data & data, const Element & element,
+		const uchar *record, const uchar **starts);
+
+	/**
+	 * @brief Returns the index of the first property with one of the names or -1
+	 */
+	static int findProperty(const Element & element, const QList<QByteArray> & names);
+
+	/**
+	 * @brief Reads the color properties of a record
+	 *
+	 * @param [in] colorProperties Index of red, green, blue and alpha, the last may be -1
+	 * @param [in] starts The start of each property of the record
+	 */
+	static QColor readColor(const Data & data, const Element & element,
+		const int *colorProperties, const uchar * const *starts);
+
+	/**
+	 * @brief Converts the vertices in parallel, returns the end of the element
+	 */
+	static const uchar* readVertices(const Data & data, const Element & element,
+		const uchar *start, MeshData *mesh, const QAtomicInt *abort);
+
+	/**
+	 * @brief Converts the faces in parallel, returns the end of the element
+	 */
+	static const uchar* readFaces(const Data & data, const Element & element,
+		const uchar *start, MeshData *mesh, const QAtomicInt *abort);
+
+	/**
+	 * @brief Returns the end of an element that is skipped
+	 */
+	static const uchar* skipElement(const Data & data, const Element & element,
+		const uchar *start);
+};
@@ -0,0 +1,704 @@
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "QuantizedFile.h"
+#include "Parallel.h"
+#include "Trace.h"
+
+const char* QuantizedFile::magic()
+{
+	return "OFFQUANT";
+}
+
+QString QuantizedFile::fileFilter()
+{
+	return tr("Quantized Files (*.ofq)");
+}
+
+void QuantizedFile::write(const IScene *scene, const QString & fileName, int positionBits,
+	int normalBits, const ProgressFunction & progress)
+{
+	TRACE_ZONE("QuantizedFile::write");
+	if (positionBits < minPositionBits || positionBits > maxPositionBits
+		|| (normalBits != 0 && (normalBits < 4 || normalBits > 16))) {
+		throw tr("Invalid number of bits!");
+	}
+	int vCount = scene->verticesCount();
+	int pCount = scene->polygonsCount();
+
+	// Bounding box and colors with one pass over the vertices
+	int boxBlocks = Parallel::blockCount(vCount, 1 << 14);
+	QVector<float> boxes(6 * boxBlocks);
+	QAtomicInt coloredVertices(0);
+	QAtomicInt coloredPolygons(0);
+	Parallel::forEachBlock(vCount, 1 << 14, [&](int block, int begin, int end) {
+		float *box = boxes.data() + 6 * block;
+		const float *xyz = scene->vertex(begin)->vertex();
+		for (int k = 0; k < 3; k++) {
+			box[k] = box[3 + k] = xyz[k];
+		}
+		for (int i = begin; i < end; i++) {
+			const CVertex *vertex = scene->vertex(i);
+			xyz = vertex->vertex();
+			for (int k = 0; k < 3; k++) {
+				box[k] = qMin(box[k], xyz[k]);
+				box[3 + k] = qMax(box[3 + k], xyz[k]);
+			}
+			if (vertex->isColored()) {
+				coloredVertices.store(1);
+			}
+		}
+	});
+	Parallel::forBlocks(pCount, 1 << 16, [&](int begin, int end) {
+		for (int i = begin; i < end && !coloredPolygons.load(); i++) {
+			if (scene->polygon(i)->isColored()) {
+				coloredPolygons.store(1);
+			}
+		}
+	});
+
+	Header header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, magic(), sizeof(header.magic));
+	header.version = currentVersion;
+	header.flags = (coloredVertices.load() ? VertexColors : 0)
+		| (coloredPolygons.load() ? PolygonColors : 0);
+	header.positionBits = positionBits;
+	header.normalBits = normalBits;
+	header.verticesCount = vCount;
+	header.polygonsCount = pCount;
+	for (int b = 0; b < boxBlocks; b++) {
+		for (int k = 0; k < 3; k++) {
+			header.min[k] = b == 0 ? boxes[k] : qMin(header.min[k], boxes[6 * b + k]);
+			header.max[k] = b == 0 ? boxes[3 + k] : qMax(header.max[k], boxes[6 * b + 3 + k]);
+		}
+	}
+
+	QVector<QRgb> palette;
+	QHash<QRgb, int> paletteIndex;
+	header.colorMode = Rgba8;
+	if (header.flags != 0) {
+		palette = collectPalette(scene, coloredVertices.load(), coloredPolygons.load());
+		if (!palette.isEmpty()) {
+			header.colorMode = palette.size() < 256 ? Palette8 : Palette16;
+			header.paletteCount = palette.size() + 1;
+			for (int i = 0; i < palette.size(); i++) {
+				paletteIndex.insert(palette[i], i + 1);
+			}
+		}
+	}
+
+	QFile file(fileName);
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+		throw tr("Unable to open file ") + fileName;
+	}
+
+	try {
+		// The header is written again when the offsets are known
+		uchar headerData[headerBytes];
+		encodeHeader(header, headerData);
+		bool ok = file.write(reinterpret_cast<const char*>(headerData), headerBytes) == headerBytes;
+		if (header.paletteCount > 0) {
+			palette.prepend(0);
+			QByteArray paletteData(4 * palette.size(), 0);
+			for (int i = 0; i < palette.size(); i++) {
+				qToLittleEndian<quint32>(palette[i], reinterpret_cast<uchar*>(paletteData.data()) + 4 * i);
+			}
+			ok = ok && file.write(paletteData) == paletteData.size();
+		}
+		if (!ok) {
+			throw tr("Unable to write file ") + fileName;
+		}
+
+		int vertexBlocks = (vCount + blockVertices - 1) / blockVertices;
+		header.positionsOffset = file.pos();
+		quint32 maxValue = (1u << positionBits) - 1;
+		writeBlocks(&file, vertexBlocks, [&](int block, QByteArray *buffer) {
+			int begin = block * blockVertices;
+			int end = qMin(vCount, begin + blockVertices);
+			QVector<quint32> values(3 * (end - begin));
+			for (int i = begin; i < end; i++) {
+				const float *xyz = scene->vertex(i)->vertex();
+				for (int k = 0; k < 3; k++) {
+					double extent = header.max[k] - header.min[k];
+					double t = extent > 0.0 ? (xyz[k] - header.min[k]) / extent : 0.0;
+					values[3 * (i - begin) + k] = quint32(qBound(0.0, t, 1.0) * maxValue + 0.5);
+				}
+			}
+			pack(values.constData(), values.size(), positionBits, buffer);
+		}, nullptr);
+		if (progress && !progress(30)) {
+			throw tr("Aborted writing file!");
+		}
+
+		header.normalsOffset = file.pos();
+		if (normalBits > 0) {
+			writeBlocks(&file, vertexBlocks, [&](int block, QByteArray *buffer) {
+				int begin = block * blockVertices;
+				int end = qMin(vCount, begin + blockVertices);
+				QVector<quint32> values(2 * (end - begin));
+				for (int i = begin; i < end; i++) {
+					encodeNormal(scene->vertex(i)->normal(), normalBits, values.data() + 2 * (i - begin));
+				}
+				pack(values.constData(), values.size(), normalBits, buffer);
+			}, nullptr);
+		}
+		if (progress && !progress(45)) {
+			throw tr("Aborted writing file!");
+		}
+
+		// Palette indices or a flag and the RGBA bytes
+		auto appendColor = [&](bool isColored, const QColor & color, QByteArray *buffer) {
+			QRgb rgba = isColored ? color.rgba() : 0;
+			uchar data[5];
+			if (header.colorMode == Palette8) {
+				data[0] = uchar(isColored ? paletteIndex.value(rgba) : 0);
+			} else if (header.colorMode == Palette16) {
+				qToLittleEndian<quint16>(quint16(isColored ? paletteIndex.value(rgba) : 0), data);
+			} else {
+				data[0] = uchar(isColored);
+				data[1] = uchar(qRed(rgba));
+				data[2] = uchar(qGreen(rgba));
+				data[3] = uchar(qBlue(rgba));
+				data[4] = uchar(qAlpha(rgba));
+			}
+			buffer->append(reinterpret_cast<const char*>(data), colorBytes(header.colorMode));
+		};
+		header.vertexColorsOffset = file.pos();
+		if (header.flags & VertexColors) {
+			writeBlocks(&file, vertexBlocks, [&](int block, QByteArray *buffer) {
+				int end = qMin(vCount, (block + 1) * blockVertices);
+				for (int i = block * blockVertices; i < end; i++) {
+					const CVertex *vertex = scene->vertex(i);
+					appendColor(vertex->isColored(), vertex->color(), buffer);
+				}
+			}, nullptr);
+		}
+		int polygonBlocks = (pCount + blockPolygons - 1) / blockPolygons;
+		header.polygonColorsOffset = file.pos();
+		if (header.flags & PolygonColors) {
+			writeBlocks(&file, polygonBlocks, [&](int block, QByteArray *buffer) {
+				int end = qMin(pCount, (block + 1) * blockPolygons);
+				for (int i = block * blockPolygons; i < end; i++) {
+					const CPolygon *polygon = scene->polygon(i);
+					appendColor(polygon->isColored(), polygon->color(), buffer);
+				}
+			}, nullptr);
+		}
+		if (progress && !progress(55)) {
+			throw tr("Aborted writing file!");
+		}
+
+		// Each block starts with the previous index 0, so it can be decoded alone
+		QVector<quint32> blockIndices(polygonBlocks);
+		QVector<quint32> blockBytes;
+		qint64 polygonsOffset = file.pos();
+		writeBlocks(&file, polygonBlocks, [&](int block, QByteArray *buffer) {
+			int end = qMin(pCount, (block + 1) * blockPolygons);
+			quint32 indices = 0;
+			int previous = 0;
+			for (int i = block * blockPolygons; i < end; i++) {
+				const CPolygon *polygon = scene->polygon(i);
+				int count = int(polygon->vertexCount());
+				appendVarint(quint32(qMax(0, count - 3)), buffer);
+				for (int j = 0; j < count; j++) {
+					int index = polygon->vertexIndex(j);
+					qint32 delta = index - previous;
+					appendVarint((quint32(delta) << 1) ^ quint32(delta >> 31), buffer);
+					previous = index;
+				}
+				indices += count;
+			}
+			blockIndices[block] = indices;
+		}, &blockBytes);
+
+		QVector<Block> table(polygonBlocks);
+		qint64 indices = 0;
+		qint64 offset = polygonsOffset;
+		for (int b = 0; b < polygonBlocks; b++) {
+			table[b].offset = offset;
+			table[b].bytes = blockBytes[b];
+			table[b].firstIndex = quint32(indices);
+			offset += blockBytes[b];
+			indices += blockIndices[b];
+		}
+		if (indices > std::numeric_limits<int>::max()) {
+			throw tr("Invalid vertex or polygon number!");
+		}
+		header.indicesCount = quint32(indices);
+		header.blocksCount = polygonBlocks;
+		header.tableOffset = file.pos();
+
+		QByteArray tableData(blockRecordBytes * table.size(), 0);
+		for (int b = 0; b < table.size(); b++) {
+			uchar *record = reinterpret_cast<uchar*>(tableData.data()) + blockRecordBytes * b;
+			qToLittleEndian<quint64>(table[b].offset, record);
+			qToLittleEndian<quint32>(table[b].bytes, record + 8);
+			qToLittleEndian<quint32>(table[b].firstIndex, record + 12);
+		}
+		encodeHeader(header, headerData);
+		ok = file.write(tableData) == tableData.size();
+		ok = ok && file.seek(0);
+		ok = ok && file.write(reinterpret_cast<const char*>(headerData), headerBytes) == headerBytes;
+		ok = ok && file.flush();
+		if (!ok) {
+			throw tr("Unable to write file ") + fileName;
+		}
+		if (progress) {
+			progress(100);
+		}
+	}
+	catch (QString &) {
+		file.close();
+		file.remove();
+		throw;
+	}
+}
+
+void QuantizedFile::read(const QString & fileName, MeshData *mesh, const QAtomicInt *abort)
+{
+	TRACE_ZONE("QuantizedFile::read");
+	QFile file(fileName);
+	if (!file.open(QIODevice::ReadOnly)) {
+		throw tr("Unable to open file ") + fileName;
+	}
+	QByteArray headerData = file.read(headerBytes);
+	if (headerData.size() != headerBytes) {
+		throw tr("Wrong file format!");
+	}
+	Header header;
+	decodeHeader(reinterpret_cast<const uchar*>(headerData.constData()), &header);
+	if (memcmp(header.magic, magic(), sizeof(header.magic)) != 0) {
+		throw tr("Wrong file format!");
+	}
+	if (header.version != currentVersion) {
+		throw tr("Unsupported quantized file version!");
+	}
+
+	// Every section must be inside of the file
+	quint64 size = file.size();
+	quint64 bytesPerColor = colorBytes(header.colorMode);
+	quint64 vCount = header.verticesCount;
+	quint64 pCount = header.polygonsCount;
+	const quint64 maxCount = std::numeric_limits<int>::max() / 3;
+	bool valid = header.positionBits >= quint32(minPositionBits)
+		&& header.positionBits <= quint32(maxPositionBits)
+		&& (header.normalBits == 0 || (header.normalBits >= 4 && header.normalBits <= 16))
+		&& header.colorMode <= Rgba8
+		&& (header.colorMode == Rgba8 || header.paletteCount > 0)
+		&& header.paletteCount <= (header.colorMode == Palette8 ? 256u : 65536u)
+		&& vCount > 0 && pCount > 0 && vCount <= maxCount && pCount < maxCount
+		&& header.indicesCount <= quint32(std::numeric_limits<int>::max())
+		&& header.blocksCount == (pCount + blockPolygons - 1) / blockPolygons
+		&& headerBytes + 4 * quint64(header.paletteCount) <= header.positionsOffset
+		&& header.positionsOffset + packedBytes(3 * vCount, header.positionBits) <= header.normalsOffset
+		&& header.normalsOffset + packedBytes(2 * vCount, header.normalBits) <= header.vertexColorsOffset
+		&& header.vertexColorsOffset + ((header.flags & VertexColors) ? vCount * bytesPerColor : 0)
+			<= header.polygonColorsOffset
+		&& header.polygonColorsOffset + ((header.flags & PolygonColors) ? pCount * bytesPerColor : 0)
+			<= header.tableOffset
+		&& header.tableOffset <= size
+		&& quint64(header.blocksCount) * blockRecordBytes <= size - header.tableOffset;
+	if (!valid) {
+		throw tr("The quantized file is damaged!");
+	}
+
+	const uchar *data = file.map(0, size);
+	if (!data) {
+		throw tr("Unable to map file ") + fileName;
+	}
+	QVector<Block> table(header.blocksCount);
+	for (int b = 0; b < table.size(); b++) {
+		const uchar *record = data + header.tableOffset + blockRecordBytes * b;
+		table[b].offset = qFromLittleEndian<quint64>(record);
+		table[b].bytes = qFromLittleEndian<quint32>(record + 8);
+		table[b].firstIndex = qFromLittleEndian<quint32>(record + 12);
+	}
+	QVector<QRgb> palette(header.paletteCount);
+	for (int i = 0; i < palette.size(); i++) {
+		palette[i] = qFromLittleEndian<quint32>(data + headerBytes + 4 * i);
+	}
+
+	int vertices = int(vCount);
+	int polygons = int(pCount);
+	int vertexBlocks = (vertices + blockVertices - 1) / blockVertices;
+	mesh->positions.resize(3 * vertices);
+	mesh->normals.resize(header.normalBits > 0 ? 3 * vertices : 0);
+	float *positions = mesh->positions.data();
+	float *normals = header.normalBits > 0 ? mesh->normals.data() : nullptr;
+	double maxValue = double((1u << header.positionBits) - 1);
+	Parallel::forBlocks(vertexBlocks, 1, [&](int first, int last) {
+		QVector<quint32> values(3 * blockVertices);
+		for (int block = first; block < last && !(abort && abort->load()); block++) {
+			int begin = block * blockVertices;
+			int count = qMin(vertices, begin + blockVertices) - begin;
+			unpack(data + header.positionsOffset + packedBytes(3 * qint64(begin), header.positionBits),
+				3 * count, header.positionBits, values.data());
+			for (int i = 0; i < 3 * count; i++) {
+				int k = i % 3;
+				double extent = header.max[k] - header.min[k];
+				positions[3 * begin + i] = float(header.min[k] + values[i] * extent / maxValue);
+			}
+			if (normals) {
+				unpack(data + header.normalsOffset + packedBytes(2 * qint64(begin), header.normalBits),
+					2 * count, header.normalBits, values.data());
+				for (int i = 0; i < count; i++) {
+					decodeNormal(values.constData() + 2 * i, header.normalBits,
+						normals + 3 * (begin + i));
+				}
+			}
+		}
+	});
+
+	bool ok = true;
+	mesh->vertexColors.clear();
+	mesh->polygonColors.clear();
+	mesh->fileIndices.clear();
+	if (header.flags & VertexColors) {
+		ok = readColors(header, palette.constData(), data + header.vertexColorsOffset,
+			vertices, &mesh->vertexColors);
+	}
+	if (ok && (header.flags & PolygonColors)) {
+		ok = readColors(header, palette.constData(), data + header.polygonColorsOffset,
+			polygons, &mesh->polygonColors);
+	}
+
+	mesh->offsets.resize(polygons + 1);
+	mesh->indices.resize(int(header.indicesCount));
+	int *offsets = mesh->offsets.data();
+	int *indices = mesh->indices.data();
+	QAtomicInt damaged(ok ? 0 : 1);
+	Parallel::forBlocks(table.size(), 1, [&](int first, int last) {
+		for (int block = first; block < last && !(abort && abort->load()); block++) {
+			const Block & b = table[block];
+			quint32 next = block + 1 < table.size() ? table[block + 1].firstIndex : header.indicesCount;
+			if (b.offset + b.bytes > header.tableOffset || b.firstIndex > next
+				|| (block == 0 && b.firstIndex != 0)) {
+				damaged.store(1);
+				return;
+			}
+			const uchar *p = data + b.offset;
+			const uchar *end = p + b.bytes;
+			quint32 cursor = b.firstIndex;
+			qint32 previous = 0;
+			int polygonEnd = qMin(polygons, (block + 1) * blockPolygons);
+			for (int i = block * blockPolygons; i < polygonEnd; i++) {
+				quint32 count;
+				if (!readVarint(&p, end, &count) || next - cursor < 3 || count > next - cursor - 3) {
+					damaged.store(1);
+					return;
+				}
+				offsets[i] = int(cursor);
+				for (quint32 j = 0; j < count + 3; j++) {
+					quint32 zigzag;
+					if (!readVarint(&p, end, &zigzag)) {
+						damaged.store(1);
+						return;
+					}
+					previous += qint32((zigzag >> 1) ^ (0u - (zigzag & 1)));
+					indices[cursor++] = previous;
+				}
+			}
+			if (cursor != next) {
+				damaged.store(1);
+			}
+		}
+	});
+	offsets[polygons] = int(header.indicesCount);
+
+	file.unmap(const_cast<uchar*>(data));
+	if (abort && abort->load()) {
+		throw tr("Aborted file loading!");
+	}
+	if (damaged.load()) {
+		throw tr("The quantized file is damaged!");
+	}
+}
+
+void QuantizedFile::writeBlocks(QFile *file, int blocks, const EncodeFunction & encode,
+	QVector<quint32> *bytes)
+{
+	if (bytes) {
+		bytes->resize(blocks);
+	}
+	for (int window = 0; window < blocks; window += windowBlocks) {
+		int windowEnd = qMin(blocks, window + windowBlocks);
+		QVector<QByteArray> buffers(windowEnd - window);
+		Parallel::forBlocks(buffers.size(), 1, [&](int begin, int end) {
+			for (int b = begin; b < end; b++) {
+				encode(window + b, &buffers[b]);
+			}
+		});
+
+		for (int b = 0; b < buffers.size(); b++) {
+			if (file->write(buffers[b]) != buffers[b].size()) {
+				throw tr("Unable to write file ") + file->fileName();
+			}
+			if (bytes) {
+				(*bytes)[window + b] = buffers[b].size();
+			}
+		}
+	}
+}
+
+qint64 QuantizedFile::packedBytes(qint64 count, int bits)
+{
+	return (count * bits + 7) / 8;
+}
+
+void QuantizedFile::pack(const quint32 *values, int count, int bits, QByteArray *buffer)
+{
+	int start = buffer->size();
+	buffer->resize(start + int(packedBytes(count, bits)));
+	uchar *out = reinterpret_cast<uchar*>(buffer->data()) + start;
+	quint64 bitBuffer = 0;
+	int filled = 0;
+	for (int i = 0; i < count; i++) {
+		bitBuffer |= quint64(values[i]) << filled;
+		filled += bits;
+		while (filled >= 8) {
+			*out++ = uchar(bitBuffer);
+			bitBuffer >>= 8;
+			filled -= 8;
+		}
+	}
+	if (filled > 0) {
+		*out = uchar(bitBuffer);
+	}
+}
+
+void QuantizedFile::unpack(const uchar *data, int count, int bits, quint32 *values)
+{
+	quint64 mask = (quint64(1) << bits) - 1;
+	quint64 bitBuffer = 0;
+	int filled = 0;
+	for (int i = 0; i < count; i++) {
+		while (filled < bits) {
+			bitBuffer |= quint64(*data++) << filled;
+			filled += 8;
+		}
+		values[i] = quint32(bitBuffer & mask);
+		bitBuffer >>= bits;
+		filled -= bits;
+	}
+}
+
+void QuantizedFile::encodeNormal(const float *normal, int bits, quint32 *values)
+{
+	// Project onto the octahedron and fold the lower half over the upper one
+	float sum = std::fabs(normal[0]) + std::fabs(normal[1]) + std::fabs(normal[2]);
+	float u = sum > 0.0f ? normal[0] / sum : 0.0f;
+	float v = sum > 0.0f ? normal[1] / sum : 0.0f;
+	if (sum > 0.0f && normal[2] < 0.0f) {
+		float foldedU = (1.0f - std::fabs(v)) * (u >= 0.0f ? 1.0f : -1.0f);
+		float foldedV = (1.0f - std::fabs(u)) * (v >= 0.0f ? 1.0f : -1.0f);
+		u = foldedU;
+		v = foldedV;
+	}
+
+	float maxValue = float((1u << bits) - 1);
+	values[0] = quint32(qBound(0.0f, u * 0.5f + 0.5f, 1.0f) * maxValue + 0.5f);
+	values[1] = quint32(qBound(0.0f, v * 0.5f + 0.5f, 1.0f) * maxValue + 0.5f);
+}
+
+void QuantizedFile::decodeNormal(const quint32 *values, int bits, float *normal)
+{
+	float maxValue = float((1u << bits) - 1);
+	float u = values[0] / maxValue * 2.0f - 1.0f;
+	float v = values[1] / maxValue * 2.0f - 1.0f;
+	float z = 1.0f - std::fabs(u) - std::fabs(v);
+	if (z < 0.0f) {
+		float unfoldedU = (1.0f - std::fabs(v)) * (u >= 0.0f ? 1.0f : -1.0f);
+		float unfoldedV = (1.0f - std::fabs(u)) * (v >= 0.0f ? 1.0f : -1.0f);
+		u = unfoldedU;
+		v = unfoldedV;
+	}
+
+	float length = std::sqrt(u * u + v * v + z * z);
+	normal[0] = u / length;
+	normal[1] = v / length;
+	normal[2] = z / length;
+}
+
+void QuantizedFile::appendVarint(quint32 value, QByteArray *buffer)
+{
+	char bytes[5];
+	int count = 0;
+	while (value >= 0x80) {
+		bytes[count++] = char((value & 0x7f) | 0x80);
+		value >>= 7;
+	}
+	bytes[count++] = char(value);
+	buffer->append(bytes, count);
+}
+
+bool QuantizedFile::readVarint(const uchar **p, const uchar *end, quint32 *value)
+{
+	quint32 result = 0;
+	for (int shift = 0; shift < 35; shift += 7) {
+		if (*p >= end) {
+			return false;
+		}
+		uchar byte = *(*p)++;
+		result |= quint32(byte & 0x7f) << shift;
+		if (!(byte & 0x80)) {
+			*value = result;
+			return true;
+		}
+	}
+	return false;
+}
+
+QVector<QRgb> QuantizedFile::collectPalette(const IScene *scene, bool vertexColors,
+	bool polygonColors)
+{
+	TRACE_ZONE("QuantizedFile::collectPalette");
+	const int maxColors = 65535;
+	int vCount = vertexColors ? scene->verticesCount() : 0;
+	int pCount = polygonColors ? scene->polygonsCount() : 0;
+
+	// Each block collects its colors in the order of appearance, so the
+	// merged palette is the same for every number of threads
+	int vertexBlocks = Parallel::blockCount(vCount, 1 << 14);
+	int polygonBlocks = Parallel::blockCount(pCount, 1 << 14);
+	QVector<QVector<QRgb> > found(vertexBlocks + polygonBlocks);
+	QAtomicInt tooMany(0);
+	auto collect = [&](const QColor & color, QSet<QRgb> *seen, QVector<QRgb> *colors) {
+		QRgb rgba = color.rgba();
+		if (!seen->contains(rgba)) {
+			seen->insert(rgba);
+			colors->append(rgba);
+			if (colors->size() > maxColors) {
+				tooMany.store(1);
+			}
+		}
+	};
+	Parallel::forEachBlock(vCount, 1 << 14, [&](int block, int begin, int end) {
+		QSet<QRgb> seen;
+		for (int i = begin; i < end && !tooMany.load(); i++) {
+			const CVertex *vertex = scene->vertex(i);
+			if (vertex->isColored()) {
+				collect(vertex->color(), &seen, &found[block]);
+			}
+		}
+	});
+	Parallel::forEachBlock(pCount, 1 << 14, [&](int block, int begin, int end) {
+		QSet<QRgb> seen;
+		for (int i = begin; i < end && !tooMany.load(); i++) {
+			const CPolygon *polygon = scene->polygon(i);
+			if (polygon->isColored()) {
+				collect(polygon->color(), &seen, &found[vertexBlocks + block]);
+			}
+		}
+	});
+
+	QVector<QRgb> palette;
+	QSet<QRgb> seen;
+	for (int b = 0; b < found.size() && !tooMany.load(); b++) {
+		for (int i = 0; i < found[b].size(); i++) {
+			collect(QColor::fromRgba(found[b][i]), &seen, &palette);
+		}
+	}
+	return tooMany.load() ? QVector<QRgb>() : palette;
+}
+
+bool QuantizedFile::readColors(const Header & header, const QRgb *palette, const uchar *data,
+	int count, QVector<QColor> *colors)
+{
+	colors->resize(count);
+	QColor *target = colors->data();
+	QAtomicInt damaged(0);
+	Parallel::forBlocks(count, 1 << 14, [&](int begin, int end) {
+		for (int i = begin; i < end; i++) {
+			if (header.colorMode == Rgba8) {
+				const uchar *color = data + 5 * qint64(i);
+				if (color[0]) {
+					target[i] = QColor(color[1], color[2], color[3], color[4]);
+				}
+				continue;
+			}
+
+			quint32 index;
+			if (header.colorMode == Palette8) {
+				index = data[i];
+			} else {
+				index = qFromLittleEndian<quint16>(data + 2 * qint64(i));
+			}
+			if (index >= header.paletteCount) {
+				damaged.store(1);
+			} else if (index > 0) {
+				target[i] = QColor::fromRgba(palette[index]);
+			}
+		}
+	});
+	return !damaged.load();
+}
+
+int QuantizedFile::colorBytes(quint32 colorMode)
+{
+	return colorMode == Palette8 ? 1 : (colorMode == Palette16 ? 2 : 5);
+}
+
+void QuantizedFile::encodeHeader(const Header & header, uchar *data)
+{
+	memcpy(data, header.magic, sizeof(header.magic));
+	const quint32 counts[10] = {
+		header.version, header.flags, header.positionBits, header.normalBits,
+		header.colorMode, header.paletteCount, header.verticesCount,
+		header.polygonsCount, header.indicesCount, header.blocksCount
+	};
+	for (int i = 0; i < 10; i++) {
+		qToLittleEndian<quint32>(counts[i], data + 8 + 4 * i);
+	}
+	for (int k = 0; k < 3; k++) {
+		encodeFloat(header.min[k], data + 48 + 4 * k);
+		encodeFloat(header.max[k], data + 60 + 4 * k);
+	}
+	const quint64 offsets[5] = {
+		header.positionsOffset, header.normalsOffset, header.vertexColorsOffset,
+		header.polygonColorsOffset, header.tableOffset
+	};
+	for (int i = 0; i < 5; i++) {
+		qToLittleEndian<quint64>(offsets[i], data + 72 + 8 * i);
+	}
+}
+
+void QuantizedFile::decodeHeader(const uchar *data, Header *header)
+{
+	memcpy(header->magic, data, sizeof(header->magic));
+	quint32 *counts[10] = {
+		&header->version, &header->flags, &header->positionBits, &header->normalBits,
+		&header->colorMode, &header->paletteCount, &header->verticesCount,
+		&header->polygonsCount, &header->indicesCount, &header->blocksCount
+	};
+	for (int i = 0; i < 10; i++) {
+		*counts[i] = qFromLittleEndian<quint32>(data + 8 + 4 * i);
+	}
+	for (int k = 0; k < 3; k++) {
+		header->min[k] = decodeFloat(data + 48 + 4 * k);
+		header->max[k] = decodeFloat(data + 60 + 4 * k);
+	}
+	quint64 *offsets[5] = {
+		&header->positionsOffset, &header->normalsOffset, &header->vertexColorsOffset,
+		&header->polygonColorsOffset, &header->tableOffset
+	};
+	for (int i = 0; i < 5; i++) {
+		*offsets[i] = qFromLittleEndian<quint64>(data + 72 + 8 * i);
+	}
+}
+
+void QuantizedFile::encodeFloat(float value, uchar *data)
+{
+	quint32 bits;
+	memcpy(&bits, &value, sizeof(bits));
+	qToLittleEndian<quint32>(bits, data);
+}
+
+float QuantizedFile::decodeFloat(const uchar *data)
+{
+	quint32 bits = qFromLittleEndian<quint32>(data);
+	float value;
+	memcpy(&value, &bits, sizeof(value));
+	return value;
+}
@@ -0,0 +1,279 @@
+#pragma once
+
+#include <functional>
+
+#include <QtCore>
+
+#include "IScene.h"
+#include "MeshData.h"
+
+/**
+ * @brief Compact file format for archiving and transferring meshes
+ *
+ * Positions are stored as integers of a chosen number of bits within the
+ * bounding box, normals in the octahedral projection with two integers and
+ * colors as indices into a palette, or as RGBA8 if there are too many. The
+ * polygons are stored in blocks with variable length integers: the number of
+ * vertices minus three and for each vertex the zigzag coded difference to
+ * the previous index. Every block starts from zero, so the blocks can be
+ * decoded by several threads independently.
+ *
+ * File layout (little endian, independent of the machine):
+ * - Header, headerBytes bytes
+ * - The palette with Header::paletteCount RGBA values
+ * - The positions, 3 * Header::positionBits bits per vertex
+ * - The normals, 2 * Header::normalBits bits per vertex (optional)
+ * - The vertex colors and the polygon colors (optional)
+ * - The polygon blocks
+ * - The table with one Block record of blockRecordBytes bytes per polygon block
+ *
+ * The bit streams are cut into blocks of blockVertices vertices, such a
+ * block always ends at a byte boundary.
+ *
+ * @see OffWriter
+ */
+class QuantizedFile
+{
+	Q_DECLARE_TR_FUNCTIONS(QuantizedFile)
+
+public:
+	/**
+	 * @brief Function type for progress reports
+	 *
+	 * Receives the progress from 0 to 100 and returns false to abort.
+	 */
+	typedef std::function<bool(int percent)> ProgressFunction;
+
+	/**
+	 * @brief Smallest and largest number of bits for a coordinate
+	 */
+	static const int minPositionBits = 8;
+	static const int maxPositionBits = 24;
+
+	/**
+	 * @brief Bits of each of the two components of a normal vector
+	 */
+	static const int defaultNormalBits = 12;
+
+	/**
+	 * @brief Returns the file dialog filter for quantized files
+	 */
+	static QString fileFilter();
+
+	/**
+	 * @brief Writes a scene into a quantized file
+	 *
+	 * Throws a QString with an error message if the file can not be
+	 * written. An incomplete file is removed.
+	 *
+	 * @param [in] scene The scene which should be saved
+	 * @param [in] fileName Path of the new file
+	 * @param [in] positionBits Bits of each coordinate, from minPositionBits to maxPositionBits
+	 * @param [in] normalBits Bits of each normal component, 0 to calculate the normals when reading
+	 * @param [in] progress Optional progress callback
+	 */
+	static void write(const IScene *scene, const QString & fileName, int positionBits,
+		int normalBits = defaultNormalBits, const ProgressFunction & progress = ProgressFunction());
+
+	/**
+	 * @brief Reads a quantized file
+	 *
+	 * Throws a QString if the file can not be read.
+	 *
+	 * @param [in] fileName Path to the file
+	 * @param [out] mesh Receives the vertices and polygons
+	 * @param [in] abort Cancels the reading from another thread if set, may be null
+	 */
+	static void read(const QString & fileName, MeshData *mesh, const QAtomicInt *abort = nullptr);
+
+private:
+	/**
+	 * @brief The header at the start of the file
+	 *
+	 * The fields are written one after the other without padding.
+	 */
+	struct Header
+	{
+		char magic[8];
+		quint32 version;
+		quint32 flags;
+		quint32 positionBits;
+		quint32 normalBits;
+		quint32 colorMode;
+		quint32 paletteCount;
+		quint32 verticesCount;
+		quint32 polygonsCount;
+		quint32 indicesCount;
+		quint32 blocksCount;
+		float min[3];
+		float max[3];
+		quint64 positionsOffset;
+		quint64 normalsOffset;
+		quint64 vertexColorsOffset;
+		quint64 polygonColorsOffset;
+		quint64 tableOffset;
+	};
+
+	/**
+	 * @brief A block of polygons
+	 */
+	struct Block
+	{
+		quint64 offset;
+		quint32 bytes;
+		quint32 firstIndex;
+	};
+
+	/**
+	 * @brief Header flags
+	 */
+	enum Flags
+	{
+		VertexColors = 1,
+		PolygonColors = 2
+	};
+
+	/**
+	 * @brief How the colors are stored
+	 *
+	 * Palette entry 0 means no color. RGBA8 writes a flag byte, which is
+	 * 0 for uncolored elements, followed by the red, green, blue and alpha
+	 * bytes.
+	 */
+	enum ColorMode
+	{
+		Palette8, Palette16, Rgba8
+	};
+
+	/**
+	 * @brief Current version of the file format
+	 */
+	static const quint32 currentVersion = 2;
+
+	/**
+	 * @brief Size of the header in the file
+	 */
+	static const int headerBytes = 112;
+
+	/**
+	 * @brief Size of a Block record in the file
+	 */
+	static const int blockRecordBytes = 16;
+
+	/**
+	 * @brief Number of vertices of a position or normal block
+	 */
+	static const int blockVertices = 1 << 16;
+
+	/**
+	 * @brief Number of polygons of a connectivity block
+	 */
+	static const int blockPolygons = 1 << 14;
+
+	/**
+	 * @brief Number of blocks which are encoded before they are written
+	 */
+	static const int windowBlocks = 64;
+
+	/**
+	 * @brief Returns the magic bytes at the start of each quantized file
+	 */
+	static const char* magic();
+
+	/**
+	 * @brief Returns the number of bytes of a color in the given mode
+	 */
+	static int colorBytes(quint32 colorMode);
+
+	/**
+	 * @brief Writes a header with little endian numbers
+	 *
+	 * @param [in] header The header
+	 * @param [out] data Receives headerBytes bytes
+	 */
+	static void encodeHeader(const Header & header, uchar *data);
+
+	/**
+	 * @brief Reads a header written by encodeHeader()
+	 */
+	static void decodeHeader(const uchar *data, Header *header);
+
+	/**
+	 * @brief Writes a little endian float
+	 */
+	static void encodeFloat(float value, uchar *data);
+
+	/**
+	 * @brief Reads a little endian float
+	 */
+	static float decodeFloat(const uchar *data);
+
+	/**
+	 * @brief Encodes a block into a buffer
+	 */
+	typedef std::function<void(int block, QByteArray *buffer)> EncodeFunction;
+
+	/**
+	 * @brief Encodes blocks in parallel and writes them in order
+	 *
+	 * @param [in] file The open output file
+	 * @param [in] blocks Number of blocks
+	 * @param [in] encode Encodes a block in a worker thread
+	 * @param [out] bytes Receives the size of each block, may be null
+	 */
+	static void writeBlocks(QFile *file, int blocks, const EncodeFunction & encode,
+		QVector<quint32> *bytes);
+
+	/**
+	 * @brief Returns the number of bytes of count packed values
+	 */
+	static qint64 packedBytes(qint64 count, int bits);
+
+	/**
+	 * @brief Appends values with the given number of bits, the lowest bits first
+	 */
+	static void pack(const quint32 *values, int count, int bits, QByteArray *buffer);
+
+	/**
+	 * @brief Reads values written by pack()
+	 */
+	static void unpack(const uchar *data, int count, int bits, quint32 *values);
+
+	/**
+	 * @brief Encodes a normal vector into two integers
+	 */
+	static void encodeNormal(const float *normal, int bits, quint32 *values);
+
+	/**
+	 * @brief Decodes a normal vector of encodeNormal()
+	 */
+	static void decodeNormal(const quint32 *values, int bits, float *normal);
+
+	/**
+	 * @brief Appends a variable length integer
+	 */
+	static void appendVarint(quint32 value, QByteArray *buffer);
+
+	/**
+	 * @brief Reads a variable length integer, returns false at the end of the data
+	 */
+	static bool readVarint(const uchar **p, const uchar *end, quint32 *value);
+
+	/**
+	 * @brief Collects the colors of the scene in the order of appearance
+	 *
+	 * Stops collecting when the palette would need more than 16 bit indices.
+	 *
+	 * @return The colors behind the "no color" entry or an empty list if there are too many
+	 */
+	static QVector<QRgb> collectPalette(const IScene *scene, bool vertexColors,
+		bool polygonColors);
+
+	/**
+	 * @brief Reads the colors of count elements
+	 *
+	 * @return False if a palette index is out of range
+	 */
+	static bool readColors(const Header & header, const QRgb *palette, const uchar *data,
+		int count, QVector<QColor> *colors);
+};
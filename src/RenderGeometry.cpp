@@ -0,0 +1,260 @@
+#include <climits>
+#include <cmath>
+
+#include "RenderGeometry.h"
+#include "Parallel.h"
+
+RenderGeometry::RenderGeometry(Primitive primitive, bool hasNormals, bool hasColors)
+{
+	type = primitive;
+	withNormals = hasNormals;
+	withColors = hasColors;
+	count = 0;
+	levels = 1;
+}
+
+RenderGeometry* RenderGeometry::fromPolygons(const IScene *scene, const SceneBvh *bvh,
+	Primitive primitive, bool hasNormals, bool hasColors,
+	const CountFunction & count, const TranslucentFunction & translucent,
+	const FillFunction & fill)
+{
+	int parts = bvh->partsCount();
+
+	// Find the alpha values of the translucent polygons, each one gets a level
+	int blocks = Parallel::blockCount(parts, 1);
+	QVector<QVector<bool> > blockKeys(blocks);
+	Parallel::forEachBlock(parts, 1, [&](int block, int begin, int end) {
+		QVector<bool> & used = blockKeys[block];
+		used.fill(false, alphaKeys);
+		for (int p = begin; p < end; p++) {
+			const SceneBvh::Part & part = bvh->part(p);
+			for (int i = part.first; i < part.first + part.count; i++) {
+				const CPolygon *poly = scene->polygon(bvh->polygonAt(i));
+				if (translucent(poly)) {
+					used[alphaKey(poly)] = true;
+				}
+			}
+		}
+	});
+	QVector<int> keyLevels(alphaKeys, 0);
+	int levelsCount = 0;
+	for (int key = alphaKeys - 1; key >= 0; key--) {
+		for (int b = 0; b < blocks; b++) {
+			if (blockKeys[b][key]) {
+				keyLevels[key] = levelsCount++;
+				break;
+			}
+		}
+	}
+	levelsCount = qMax(1, levelsCount);
+
+	// Count the vertices of each part and level, the last range stays empty
+	QVector<int> opaqueCounts(parts + 1, 0);
+	QVector<int> translucentCounts(parts + 1, 0);
+	QVector<int> levelCounts((parts + 1) * levelsCount, 0);
+	Parallel::forBlocks(parts, 1, [&](int begin, int end) {
+		for (int p = begin; p < end; p++) {
+			const SceneBvh::Part & part = bvh->part(p);
+			for (int i = part.first; i < part.first + part.count; i++) {
+				const CPolygon *poly = scene->polygon(bvh->polygonAt(i));
+				if (translucent(poly)) {
+					int n = count(poly);
+					translucentCounts[p] += n;
+					levelCounts[p * levelsCount + keyLevels[alphaKey(poly)]] += n;
+				} else {
+					opaqueCounts[p] += count(poly);
+				}
+			}
+		}
+	});
+
+	RenderGeometry *geometry = new RenderGeometry(primitive, hasNormals, hasColors);
+	geometry->allocate(opaqueCounts, translucentCounts);
+	geometry->splitTranslucent(levelsCount, levelCounts);
+
+	// Each part writes into its own ranges
+	Parallel::forBlocks(parts, 1, [&](int begin, int end) {
+		QVector<int> translucentNext(levelsCount);
+		for (int p = begin; p < end; p++) {
+			const SceneBvh::Part & part = bvh->part(p);
+			int opaqueNext = geometry->opaque[p].first;
+			for (int l = 0; l < levelsCount; l++) {
+				translucentNext[l] = geometry->translucentLevels[p * levelsCount + l].first;
+			}
+			for (int i = part.first; i < part.first + part.count; i++) {
+				const CPolygon *poly = scene->polygon(bvh->polygonAt(i));
+				int &next = translucent(poly) ? translucentNext[keyLevels[alphaKey(poly)]] : opaqueNext;
+				fill(poly, geometry, next);
+				next += count(poly);
+			}
+		}
+	});
+
+	return geometry;
+}
+
+int RenderGeometry::alphaKey(const CPolygon *poly)
+{
+	return poly->isColored() ? poly->color().alpha() : alphaKeys - 1;
+}
+
+void RenderGeometry::splitTranslucent(int levelsCount, const QVector<int> & levelCounts)
+{
+	levels = levelsCount;
+	int ranges = translucent.size();
+	translucentLevels.resize(ranges * levels);
+	for (int i = 0; i < ranges; i++) {
+		int first = translucent[i].first;
+		for (int l = 0; l < levels; l++) {
+			Range & range = translucentLevels[i * levels + l];
+			range.first = first;
+			range.count = levelCounts[i * levels + l];
+			first += range.count;
+		}
+	}
+}
+
+void RenderGeometry::allocate(const QVector<int> & opaqueCounts, const QVector<int> & translucentCounts)
+{
+	Q_ASSERT(opaqueCounts.size() == translucentCounts.size());
+
+	int ranges = opaqueCounts.size();
+	opaque.resize(ranges);
+	translucent.resize(ranges);
+
+	count = 0;
+	for (int i = 0; i < ranges; i++) {
+		opaque[i].first = static_cast<int>(count);
+		opaque[i].count = opaqueCounts[i];
+		count += opaqueCounts[i];
+		translucent[i].first = static_cast<int>(count);
+		translucent[i].count = translucentCounts[i];
+		count += translucentCounts[i];
+	}
+
+	levels = 1;
+	translucentLevels = translucent;
+
+	// QVector sizes are int, larger geometry does not fit into memory anyway
+	Q_ASSERT(4 * count <= INT_MAX);
+	positionData.resize(static_cast<int>(3 * count));
+	normalData.resize(withNormals ? static_cast<int>(3 * count) : 0);
+	colorData.resize(withColors ? static_cast<int>(4 * count) : 0);
+}
+
+RenderGeometry::Primitive RenderGeometry::primitive() const
+{
+	return type;
+}
+
+bool RenderGeometry::hasNormals() const
+{
+	return withNormals;
+}
+
+bool RenderGeometry::hasColors() const
+{
+	return withColors;
+}
+
+qint64 RenderGeometry::verticesCount() const
+{
+	return count;
+}
+
+qint64 RenderGeometry::verticesCount(const QVector<int> & parts) const
+{
+	if (opaque.isEmpty()) {
+		return 0;
+	}
+	int last = opaque.size() - 1;
+	qint64 total = opaque[last].count + translucent[last].count;
+	for (int i = 0; i < parts.size(); i++) {
+		total += opaque[parts[i]].count + translucent[parts[i]].count;
+	}
+	return total;
+}
+
+int RenderGeometry::rangesCount() const
+{
+	return opaque.size();
+}
+
+const RenderGeometry::Range & RenderGeometry::opaqueRange(int i) const
+{
+	return opaque[i];
+}
+
+const RenderGeometry::Range & RenderGeometry::translucentRange(int i) const
+{
+	return translucent[i];
+}
+
+int RenderGeometry::alphaLevelsCount() const
+{
+	return levels;
+}
+
+const RenderGeometry::Range & RenderGeometry::translucentRange(int i, int level) const
+{
+	return translucentLevels[i * levels + level];
+}
+
+const float* RenderGeometry::positions() const
+{
+	return positionData.constData();
+}
+
+float* RenderGeometry::positions()
+{
+	return positionData.data();
+}
+
+const float* RenderGeometry::normals() const
+{
+	return normalData.constData();
+}
+
+float* RenderGeometry::normals()
+{
+	return normalData.data();
+}
+
+const quint8* RenderGeometry::colors() const
+{
+	return colorData.constData();
+}
+
+quint8* RenderGeometry::colors()
+{
+	return colorData.data();
+}
+
+qint64 RenderGeometry::bytes() const
+{
+	return static_cast<qint64>(positionData.size()) * sizeof(float)
+		+ static_cast<qint64>(normalData.size()) * sizeof(float)
+		+ colorData.size();
+}
+
+void RenderGeometry::normalize(const float *normal, float *target)
+{
+	float length = std::sqrt(normal[0]*normal[0] + normal[1]*normal[1] + normal[2]*normal[2]);
+	if (length > 0.0f) {
+		target[0] = normal[0] / length;
+		target[1] = normal[1] / length;
+		target[2] = normal[2] / length;
+	} else {
+		target[0] = 0.0f;
+		target[1] = 0.0f;
+		target[2] = 1.0f;
+	}
+}
+
+void RenderGeometry::writeColor(const QColor & color, quint8 *target)
+{
+	target[0] = static_cast<quint8>(color.red());
+	target[1] = static_cast<quint8>(color.green());
+	target[2] = static_cast<quint8>(color.blue());
+	target[3] = static_cast<quint8>(color.alpha());
+}
@@ -0,0 +1,307 @@
+#pragma once
+
+#include <functional>
+
+#include <QVector>
+
+#include "IScene.h"
+#include "SceneBvh.h"
+
+/**
+ * @brief Vertex data of a scene prepared for drawing
+ *
+ * A render mode converts the polygons of a scene into plain arrays of points,
+ * lines or triangles with optional normal vectors and RGBA colors. The vertices
+ * are grouped by the parts of the SceneBvh, so the parts of hidden components
+ * can be left out like the chunks outside of the view. Inside of each part the
+ * opaque vertices are stored before the translucent ones, so all opaque
+ * geometry can be drawn before the translucent geometry of the visible parts.
+ *
+ * The translucent vertices of each part are further sorted into alpha
+ * levels, one for each alpha value of the translucent polygons. Drawing the
+ * levels one after the other over all visible parts gives the order of the
+ * scene, which sorts its polygons from opaque to transparent.
+ *
+ * There is one more range than parts. The last range contains geometry
+ * which does not belong to any polygon and is never culled.
+ *
+ * The geometry does not depend on OpenGL, so it can be created in any thread.
+ *
+ * @see GeometryBuffer
+ * @see IRenderMode::createGeometry()
+ */
+class RenderGeometry
+{
+public:
+	/**
+	 * @brief The primitive type of the vertices
+	 */
+	enum Primitive {
+		Points,
+		Lines,
+		Triangles
+	};
+
+	/**
+	 * @brief A range of vertices
+	 */
+	struct Range
+	{
+		int first;
+		int count;
+	};
+
+	/**
+	 * @brief Function type which returns the number of vertices for a polygon
+	 */
+	typedef std::function<int(const CPolygon *poly)> CountFunction;
+
+	/**
+	 * @brief Function type which decides if a polygon is translucent
+	 */
+	typedef std::function<bool(const CPolygon *poly)> TranslucentFunction;
+
+	/**
+	 * @brief Function type which writes the vertices of a polygon
+	 *
+	 * Writes exactly as many vertices as the CountFunction returned
+	 * for the polygon, starting at the vertex first.
+	 */
+	typedef std::function<void(const CPolygon *poly, RenderGeometry *geometry, int first)> FillFunction;
+
+	/**
+	 * @brief Constructor
+	 *
+	 * Creates an empty geometry without any ranges.
+	 *
+	 * @param [in] primitive The primitive type of the vertices
+	 * @param [in] hasNormals Does the geometry contain normal vectors?
+	 * @param [in] hasColors Does the geometry contain colors?
+	 */
+	RenderGeometry(Primitive primitive, bool hasNormals, bool hasColors);
+
+	/**
+	 * @brief Creates the geometry for all polygons of a scene
+	 *
+	 * The parts are processed in parallel. For each part the vertices are
+	 * counted first, then the arrays are allocated and filled by the supplied
+	 * functions. The opaque polygons keep the order of the hierarchy,
+	 * the translucent polygons are sorted into alpha levels by their color
+	 * like OffScene sorts them.
+	 *
+	 * @param [in] scene The scene which should be converted
+	 * @param [in] bvh The polygon hierarchy of the scene
+	 * @param [in] primitive The primitive type of the vertices
+	 * @param [in] hasNormals Does the geometry contain normal vectors?
+	 * @param [in] hasColors Does the geometry contain colors?
+	 * @param [in] count Returns the number of vertices for a polygon
+	 * @param [in] translucent Decides if a polygon belongs to the translucent range
+	 * @param [in] fill Writes the vertices of a polygon
+	 * @return The new geometry, the caller takes the ownership
+	 */
+	static RenderGeometry* fromPolygons(const IScene *scene, const SceneBvh *bvh,
+		Primitive primitive, bool hasNormals, bool hasColors,
+		const CountFunction & count, const TranslucentFunction & translucent,
+		const FillFunction & fill);
+
+	/**
+	 * @brief Allocates the arrays for the given number of vertices
+	 *
+	 * Creates one pair of opaque and translucent ranges for each entry of the
+	 * supplied vectors. Both vectors must have the same size. The translucent
+	 * ranges have a single alpha level. The content of the arrays is undefined
+	 * until it is written.
+	 *
+	 * @param [in] opaqueCounts Number of opaque vertices for each range
+	 * @param [in] translucentCounts Number of translucent vertices for each range
+	 */
+	void allocate(const QVector<int> & opaqueCounts, const QVector<int> & translucentCounts);
+
+	/**
+	 * @brief Returns the primitive type
+	 * @return Primitive type of the vertices
+	 */
+	Primitive primitive() const;
+
+	/**
+	 * @brief Does the geometry contain normal vectors?
+	 * @return True, if normals() is available
+	 */
+	bool hasNormals() const;
+
+	/**
+	 * @brief Does the geometry contain colors?
+	 * @return True, if colors() is available
+	 */
+	bool hasColors() const;
+
+	/**
+	 * @brief Returns the number of vertices
+	 * @return Number of vertices
+	 */
+	qint64 verticesCount() const;
+
+	/**
+	 * @brief Returns the number of vertices in the ranges of some parts
+	 *
+	 * Includes the range which is never culled, like the renderers do.
+	 *
+	 * @param [in] parts The numbers of the visible parts
+	 * @return Number of vertices which are drawn for these parts
+	 */
+	qint64 verticesCount(const QVector<int> & parts) const;
+
+	/**
+	 * @brief Returns the number of ranges
+	 *
+	 * This is the number of parts plus the one range which is never culled.
+	 *
+	 * @return Number of ranges
+	 */
+	int rangesCount() const;
+
+	/**
+	 * @brief Returns the opaque vertices of a range
+	 * @param [in] i Number of the range
+	 * @return The opaque vertex range
+	 */
+	const Range & opaqueRange(int i) const;
+
+	/**
+	 * @brief Returns the translucent vertices of a range
+	 * @param [in] i Number of the range
+	 * @return The translucent vertex range
+	 */
+	const Range & translucentRange(int i) const;
+
+	/**
+	 * @brief Returns the number of alpha levels of the translucent ranges
+	 * @return Number of levels, at least one
+	 */
+	int alphaLevelsCount() const;
+
+	/**
+	 * @brief Returns the translucent vertices of one alpha level of a range
+	 *
+	 * The levels of a range follow each other and fill its translucent
+	 * range, level 0 is the most opaque one.
+	 *
+	 * @param [in] i Number of the range
+	 * @param [in] level Number of the alpha level
+	 * @return The translucent vertex range of the level
+	 */
+	const Range & translucentRange(int i, int level) const;
+
+	/**
+	 * @brief Returns the vertex positions, three floats for each vertex
+	 */
+	const float* positions() const;
+	float* positions();
+
+	/**
+	 * @brief Returns the normalized normal vectors, three floats for each vertex
+	 *
+	 * Only available if hasNormals() is true.
+	 */
+	const float* normals() const;
+	float* normals();
+
+	/**
+	 * @brief Returns the RGBA colors, four bytes for each vertex
+	 *
+	 * Only available if hasColors() is true.
+	 */
+	const quint8* colors() const;
+	quint8* colors();
+
+	/**
+	 * @brief Returns the size of the vertex data
+	 * @return Number of bytes of all arrays
+	 */
+	qint64 bytes() const;
+
+	/**
+	 * @brief Writes a normalized copy of a normal vector
+	 *
+	 * Zero vectors are replaced by (0|0|1).
+	 *
+	 * @param [in] normal The vector which should be normalized
+	 * @param [out] target Three floats which receive the normalized vector
+	 */
+	static void normalize(const float *normal, float *target);
+
+	/**
+	 * @brief Writes a color as four RGBA bytes
+	 *
+	 * @param [in] color The color which should be written
+	 * @param [out] target Four bytes which receive the color
+	 */
+	static void writeColor(const QColor & color, quint8 *target);
+
+private:
+	/**
+	 * @brief Returns the sort key of a translucent polygon
+	 *
+	 * Higher keys are drawn first. Polygons without color come before all
+	 * colored ones, like OffScene::alphaChannelCompare() sorts them.
+	 */
+	static int alphaKey(const CPolygon *poly);
+
+	/**
+	 * @brief Number of different values alphaKey() returns
+	 */
+	static const int alphaKeys = 257;
+
+	/**
+	 * @brief Divides each translucent range into its alpha levels
+	 *
+	 * @param [in] levelsCount Number of alpha levels
+	 * @param [in] levelCounts Number of vertices of each range and level,
+	 *             levelsCount entries for each range
+	 */
+	void splitTranslucent(int levelsCount, const QVector<int> & levelCounts);
+
+	/**
+	 * @brief The primitive type of the vertices
+	 */
+	Primitive type;
+
+	/**
+	 * @brief Are normals and colors stored?
+	 */
+	bool withNormals;
+	bool withColors;
+
+	/**
+	 * @brief Number of vertices
+	 *
+	 * The arrays hold three or four values per vertex, so the sizes are
+	 * calculated with 64 bits.
+	 */
+	qint64 count;
+
+	/**
+	 * @brief The vertex arrays
+	 */
+	QVector<float> positionData;
+	QVector<float> normalData;
+	QVector<quint8> colorData;
+
+	/**
+	 * @brief The opaque and translucent range of each part
+	 */
+	QVector<Range> opaque;
+	QVector<Range> translucent;
+
+	/**
+	 * @brief Number of alpha levels
+	 */
+	int levels;
+
+	/**
+	 * @brief The translucent range of each part and alpha level
+	 *
+	 * The levels of range i are stored at i * levels to i * levels + levels - 1.
+	 */
+	QVector<Range> translucentLevels;
+};
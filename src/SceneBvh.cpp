@@ -0,0 +1,546 @@
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include <QtAlgorithms>
+#include <QVarLengthArray>
+
+#include "SceneBvh.h"
+#include "Parallel.h"
+#include "Frustum.h"
+#include "Trace.h"
+
+/**
+ * @brief Spreads the lower 10 bits of a value to every third bit
+ */
+static quint32 expandBits(quint32 v)
+{
+	v = (v * 0x00010001u) & 0xFF0000FFu;
+	v = (v * 0x00000101u) & 0x0F00F00Fu;
+	v = (v * 0x00000011u) & 0xC30C30C3u;
+	v = (v * 0x00000005u) & 0x49249249u;
+	return v;
+}
+
+SceneBvh::SceneBvh(const IScene *scene, int leafSize, int chunkSize) :
+	meshComponents(scene)
+{
+	TRACE_ZONE("SceneBvh build");
+
+	this->scene = scene;
+	this->leafSize = qMax(1, leafSize);
+	this->chunkSize = qMax(this->leafSize, chunkSize);
+
+	int pCount = scene->polygonsCount();
+	if (pCount == 0) {
+		return;
+	}
+
+	// Calculate the bounding box of each polygon
+	QVector<float> bounds(pCount * 6);
+	float *boxes = bounds.data();
+	Parallel::forBlocks(pCount, 4096, [&](int begin, int end) {
+		for (int i = begin; i < end; i++) {
+			const CPolygon *poly = scene->polygon(i);
+			float *box = boxes + 6*i;
+			const float *data = poly->vertex(0)->vertex();
+			for (int k = 0; k < 3; k++) {
+				box[k] = box[k+3] = data[k];
+			}
+			int cv = static_cast<int>(poly->vertexCount());
+			for (int j = 1; j < cv; j++) {
+				data = poly->vertex(j)->vertex();
+				for (int k = 0; k < 3; k++) {
+					box[k] = qMin(box[k], data[k]);
+					box[k+3] = qMax(box[k+3], data[k]);
+				}
+			}
+		}
+	});
+
+	// Bounding box of all polygon centers
+	int blocks = Parallel::blockCount(pCount, 4096);
+	QVector<float> partial(blocks * 6);
+	float *partials = partial.data();
+	Parallel::forEachBlock(pCount, 4096, [&](int block, int begin, int end) {
+		float *result = partials + 6*block;
+		for (int k = 0; k < 3; k++) {
+			result[k] = FLT_MAX;
+			result[k+3] = -FLT_MAX;
+		}
+		for (int i = begin; i < end; i++) {
+			const float *box = boxes + 6*i;
+			for (int k = 0; k < 3; k++) {
+				float center = 0.5f * (box[k] + box[k+3]);
+				result[k] = qMin(result[k], center);
+				result[k+3] = qMax(result[k+3], center);
+			}
+		}
+	});
+	float centerMin[3], centerScale[3];
+	for (int k = 0; k < 3; k++) {
+		float minimum = partials[k];
+		float maximum = partials[k+3];
+		for (int i = 1; i < blocks; i++) {
+			minimum = qMin(minimum, partials[6*i+k]);
+			maximum = qMax(maximum, partials[6*i+k+3]);
+		}
+		centerMin[k] = minimum;
+		centerScale[k] = maximum > minimum ? 1023.0f / (maximum - minimum) : 0.0f;
+	}
+
+	// Sort the polygons along a Morton curve through the centers
+	QVector<PolygonKey> keys(pCount);
+	PolygonKey *keyData = keys.data();
+	Parallel::forBlocks(pCount, 4096, [&](int begin, int end) {
+		for (int i = begin; i < end; i++) {
+			const float *box = boxes + 6*i;
+			quint32 code = 0;
+			for (int k = 0; k < 3; k++) {
+				float center = 0.5f * (box[k] + box[k+3]);
+				quint32 cell = static_cast<quint32>((center - centerMin[k]) * centerScale[k]);
+				code |= expandBits(qMin(cell, 1023u)) << (2 - k);
+			}
+			keyData[i].key = code;
+			keyData[i].polygon = i;
+		}
+	});
+	Parallel::sort(keys, [](const PolygonKey & a, const PolygonKey & b) {
+		return a.key < b.key || (a.key == b.key && a.polygon < b.polygon);
+	});
+
+	// Build the tree top down
+	order.resize(pCount);
+	nodes.reserve(2 * (pCount / this->leafSize) + 1);
+	buildNode(keys, bounds, 0, pCount, false);
+	nodes.squeeze();
+	parts.squeeze();
+}
+
+int SceneBvh::buildNode(QVector<PolygonKey> & keys, const QVector<float> & bounds,
+	int first, int last, bool insideChunk)
+{
+	int index = nodes.size();
+	nodes.append(Node());
+
+	// The first node small enough starts a new chunk, whose polygons are
+	// grouped by their component and along the Morton curve inside of it
+	int chunkIndex = -1;
+	if (!insideChunk && last - first <= chunkSize) {
+		for (int i = first; i < last; i++) {
+			keys[i].key |= static_cast<quint64>(meshComponents.componentOf(keys[i].polygon)) << 32;
+		}
+		std::sort(keys.begin() + first, keys.begin() + last, [](const PolygonKey & a, const PolygonKey & b) {
+			return a.key < b.key || (a.key == b.key && a.polygon < b.polygon);
+		});
+
+		Chunk chunk;
+		chunk.first = first;
+		chunk.count = last - first;
+		chunk.triangles = 0;
+		chunk.firstPart = parts.size();
+		chunkIndex = chunks.size();
+		for (int i = first; i < last; i++) {
+			int component = static_cast<int>(keys[i].key >> 32);
+			if (i == first || component != parts.last().component) {
+				Part part;
+				part.component = component;
+				part.chunk = chunkIndex;
+				part.first = i;
+				part.count = 0;
+				part.triangles = 0;
+				parts.append(part);
+			}
+			int triangles = static_cast<int>(scene->polygon(keys[i].polygon)->vertexCount()) - 2;
+			parts.last().count++;
+			parts.last().triangles += triangles;
+			chunk.triangles += triangles;
+		}
+		chunk.partsCount = parts.size() - chunk.firstPart;
+		chunks.append(chunk);
+		chunkNodes.append(index);
+		insideChunk = true;
+	}
+
+	// Inside of a chunk the ranges are split between the components first
+	bool singleComponent = (keys[first].key >> 32) == (keys[last-1].key >> 32);
+
+	Node node;
+	if (singleComponent && last - first <= leafSize) {
+		node.offset = first;
+		node.count = last - first;
+		for (int k = 0; k < 3; k++) {
+			node.min[k] = FLT_MAX;
+			node.max[k] = -FLT_MAX;
+		}
+		for (int i = first; i < last; i++) {
+			int polygon = keys[i].polygon;
+			order[i] = polygon;
+			const float *box = bounds.constData() + 6*polygon;
+			for (int k = 0; k < 3; k++) {
+				node.min[k] = qMin(node.min[k], box[k]);
+				node.max[k] = qMax(node.max[k], box[k+3]);
+			}
+		}
+		nodes[index] = node;
+		if (chunkIndex >= 0) {
+			std::copy(node.min, node.min + 3, chunks[chunkIndex].min);
+			std::copy(node.max, node.max + 3, chunks[chunkIndex].max);
+		}
+		return index;
+	}
+
+	// Split where the highest differing bit of the components or, inside of
+	// a component, of the Morton codes changes. If all codes are equal, we
+	// simply split in the middle.
+	int shift = singleComponent ? 0 : 32;
+	int split = (first + last) / 2;
+	quint32 firstCode = static_cast<quint32>(keys[first].key >> shift);
+	quint32 lastCode = static_cast<quint32>(keys[last-1].key >> shift);
+	if (firstCode != lastCode) {
+		uint prefix = qCountLeadingZeroBits(firstCode ^ lastCode);
+		split = first;
+		int step = last - 1 - first;
+		do {
+			step = (step + 1) >> 1;
+			int candidate = split + step;
+			if (candidate < last - 1) {
+				quint32 code = static_cast<quint32>(keys[candidate].key >> shift);
+				if (qCountLeadingZeroBits(firstCode ^ code) > prefix) {
+					split = candidate;
+				}
+			}
+		} while (step > 1);
+		split++;
+	}
+
+	int left = buildNode(keys, bounds, first, split, insideChunk);
+	int right = buildNode(keys, bounds, split, last, insideChunk);
+	for (int k = 0; k < 3; k++) {
+		node.min[k] = qMin(nodes[left].min[k], nodes[right].min[k]);
+		node.max[k] = qMax(nodes[left].max[k], nodes[right].max[k]);
+	}
+	node.offset = right;
+	node.count = 0;
+	nodes[index] = node;
+	if (chunkIndex >= 0) {
+		std::copy(node.min, node.min + 3, chunks[chunkIndex].min);
+		std::copy(node.max, node.max + 3, chunks[chunkIndex].max);
+	}
+	return index;
+}
+
+void SceneBvh::refit()
+{
+	TRACE_ZONE("SceneBvh refit");
+
+	// The leaves are independent of each other
+	Node *nodeData = nodes.data();
+	Parallel::forBlocks(nodes.size(), 4096, [&](int begin, int end) {
+		for (int i = begin; i < end; i++) {
+			Node & node = nodeData[i];
+			if (node.count == 0) {
+				continue;
+			}
+			for (int k = 0; k < 3; k++) {
+				node.min[k] = FLT_MAX;
+				node.max[k] = -FLT_MAX;
+			}
+			for (int p = node.offset; p < node.offset + node.count; p++) {
+				const CPolygon *poly = scene->polygon(order[p]);
+				int cv = static_cast<int>(poly->vertexCount());
+				for (int j = 0; j < cv; j++) {
+					const float *data = poly->vertex(j)->vertex();
+					for (int k = 0; k < 3; k++) {
+						node.min[k] = qMin(node.min[k], data[k]);
+						node.max[k] = qMax(node.max[k], data[k]);
+					}
+				}
+			}
+		}
+	});
+
+	// Children are stored after their parent, so a backward pass
+	// always sees them before the parent
+	for (int i = nodes.size() - 1; i >= 0; i--) {
+		Node & node = nodes[i];
+		if (node.count > 0) {
+			continue;
+		}
+		const Node & left = nodes[i+1];
+		const Node & right = nodes[node.offset];
+		for (int k = 0; k < 3; k++) {
+			node.min[k] = qMin(left.min[k], right.min[k]);
+			node.max[k] = qMax(left.max[k], right.max[k]);
+		}
+	}
+
+	for (int c = 0; c < chunks.size(); c++) {
+		const Node & node = nodes[chunkNodes[c]];
+		std::copy(node.min, node.min + 3, chunks[c].min);
+		std::copy(node.max, node.max + 3, chunks[c].max);
+	}
+
+	meshComponents.updateBounds(scene);
+}
+
+int SceneBvh::nodesCount() const
+{
+	return nodes.size();
+}
+
+int SceneBvh::chunksCount() const
+{
+	return chunks.size();
+}
+
+int SceneBvh::partsCount() const
+{
+	return parts.size();
+}
+
+qint64 SceneBvh::bytes() const
+{
+	return sizeof(SceneBvh)
+		+ static_cast<qint64>(nodes.capacity()) * sizeof(Node)
+		+ static_cast<qint64>(order.capacity()) * sizeof(int)
+		+ static_cast<qint64>(chunks.capacity()) * sizeof(Chunk)
+		+ static_cast<qint64>(parts.capacity()) * sizeof(Part)
+		+ static_cast<qint64>(chunkNodes.capacity()) * sizeof(int)
+		+ meshComponents.bytes() - static_cast<qint64>(sizeof(MeshComponents));
+}
+
+const SceneBvh::Chunk & SceneBvh::chunk(int i) const
+{
+	return chunks[i];
+}
+
+const MeshComponents & SceneBvh::components() const
+{
+	return meshComponents;
+}
+
+const SceneBvh::Part & SceneBvh::part(int i) const
+{
+	return parts[i];
+}
+
+void SceneBvh::chunkParts(const QVector<int> & chunks, QVector<int> *parts,
+	const QVector<bool> *hidden) const
+{
+	parts->clear();
+	for (int i = 0; i < chunks.size(); i++) {
+		const Chunk & chunk = this->chunks[chunks[i]];
+		for (int p = chunk.firstPart; p < chunk.firstPart + chunk.partsCount; p++) {
+			if (!hidden || !hidden->at(this->parts[p].component)) {
+				parts->append(p);
+			}
+		}
+	}
+}
+
+int SceneBvh::polygonAt(int i) const
+{
+	return order[i];
+}
+
+int SceneBvh::chunkOfNode(int node) const
+{
+	const int *begin = chunkNodes.constData();
+	const int *end = begin + chunkNodes.size();
+	const int *found = std::lower_bound(begin, end, node);
+	if (found != end && *found == node) {
+		return static_cast<int>(found - begin);
+	}
+	return -1;
+}
+
+void SceneBvh::cull(const QMatrix4x4 & matrix, QVector<int> *visible) const
+{
+	visible->clear();
+	if (nodes.isEmpty()) {
+		return;
+	}
+
+	Frustum frustum(matrix);
+
+	// The depth is not bounded, deep hierarchies move the stack to the heap
+	QVarLengthArray<int, 128> stack;
+	stack.append(0);
+	while (!stack.isEmpty()) {
+		int index = stack[stack.size() - 1];
+		stack.resize(stack.size() - 1);
+		const Node & node = nodes[index];
+		if (!frustum.intersects(node.min, node.max)) {
+			continue;
+		}
+
+		int chunk = chunkOfNode(index);
+		if (chunk >= 0) {
+			visible->append(chunk);
+		} else if (node.count == 0) {
+			// Push the right child first to report the chunks in ascending order
+			stack.append(node.offset);
+			stack.append(index + 1);
+		}
+	}
+}
+
+void SceneBvh::crossingPolygons(int chunk, int axis, float value, QVector<int> *polygons) const
+{
+	polygons->clear();
+
+	QVarLengthArray<int, 128> stack;
+	stack.append(chunkNodes[chunk]);
+	while (!stack.isEmpty()) {
+		int index = stack[stack.size() - 1];
+		stack.resize(stack.size() - 1);
+		const Node & node = nodes[index];
+		if (value < node.min[axis] || value > node.max[axis]) {
+			continue;
+		}
+
+		if (node.count > 0) {
+			for (int i = node.offset; i < node.offset + node.count; i++) {
+				polygons->append(order[i]);
+			}
+		} else {
+			// Push the right child first to report the polygons in their order
+			stack.append(node.offset);
+			stack.append(index + 1);
+		}
+	}
+}
+
+float SceneBvh::intersectTriangle(const float *origin, const float *direction,
+	const float *a, const float *b, const float *c)
+{
+	float e1[3] = { b[0]-a[0], b[1]-a[1], b[2]-a[2] };
+	float e2[3] = { c[0]-a[0], c[1]-a[1], c[2]-a[2] };
+
+	// p = direction x e2
+	float p[3] = {
+		direction[1]*e2[2] - direction[2]*e2[1],
+		direction[2]*e2[0] - direction[0]*e2[2],
+		direction[0]*e2[1] - direction[1]*e2[0]
+	};
+	float det = e1[0]*p[0] + e1[1]*p[1] + e1[2]*p[2];
+	if (std::fabs(det) < 1e-12f) {
+		return -1.0f;
+	}
+	float inverseDet = 1.0f / det;
+
+	float s[3] = { origin[0]-a[0], origin[1]-a[1], origin[2]-a[2] };
+	float u = (s[0]*p[0] + s[1]*p[1] + s[2]*p[2]) * inverseDet;
+	if (u < 0.0f || u > 1.0f) {
+		return -1.0f;
+	}
+
+	// q = s x e1
+	float q[3] = {
+		s[1]*e1[2] - s[2]*e1[1],
+		s[2]*e1[0] - s[0]*e1[2],
+		s[0]*e1[1] - s[1]*e1[0]
+	};
+	float v = (direction[0]*q[0] + direction[1]*q[1] + direction[2]*q[2]) * inverseDet;
+	if (v < 0.0f || u + v > 1.0f) {
+		return -1.0f;
+	}
+
+	return (e2[0]*q[0] + e2[1]*q[1] + e2[2]*q[2]) * inverseDet;
+}
+
+bool SceneBvh::intersectBox(const Node & node, const float *origin,
+	const float *inverseDirection, float maxDistance)
+{
+	float entry = 0.0f;
+	float exit = maxDistance;
+	for (int k = 0; k < 3; k++) {
+		float t1 = (node.min[k] - origin[k]) * inverseDirection[k];
+		float t2 = (node.max[k] - origin[k]) * inverseDirection[k];
+		if (t1 > t2) {
+			qSwap(t1, t2);
+		}
+		entry = qMax(entry, t1);
+		exit = qMin(exit, t2);
+		if (entry > exit) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool SceneBvh::intersect(const float *origin, const float *direction, Hit *hit,
+	const QVector<bool> *hidden) const
+{
+	if (nodes.isEmpty()) {
+		return false;
+	}
+
+	float inverseDirection[3];
+	for (int k = 0; k < 3; k++) {
+		inverseDirection[k] = 1.0f / direction[k];
+	}
+
+	float best = FLT_MAX;
+	int bestPolygon = -1;
+
+	QVarLengthArray<int, 128> stack;
+	stack.append(0);
+	while (!stack.isEmpty()) {
+		int index = stack[stack.size() - 1];
+		stack.resize(stack.size() - 1);
+		const Node & node = nodes[index];
+		if (!intersectBox(node, origin, inverseDirection, best)) {
+			continue;
+		}
+
+		if (node.count > 0) {
+			// Test all polygons of the leaf as triangle fans
+			for (int i = node.offset; i < node.offset + node.count; i++) {
+				if (hidden && hidden->at(meshComponents.componentOf(order[i]))) {
+					continue;
+				}
+				const CPolygon *poly = scene->polygon(order[i]);
+				int cv = static_cast<int>(poly->vertexCount());
+				const float *a = poly->vertex(0)->vertex();
+				for (int j = 1; j < cv - 1; j++) {
+					float t = intersectTriangle(origin, direction, a,
+						poly->vertex(j)->vertex(), poly->vertex(j+1)->vertex());
+					if (t >= 0.0f && t < best) {
+						best = t;
+						bestPolygon = order[i];
+					}
+				}
+			}
+			continue;
+		}
+
+		// Visit the child closer to the ray origin first
+		int left = index + 1;
+		int right = node.offset;
+		float leftDistance = 0.0f, rightDistance = 0.0f;
+		for (int k = 0; k < 3; k++) {
+			leftDistance += (nodes[left].min[k] + nodes[left].max[k]) * direction[k];
+			rightDistance += (nodes[right].min[k] + nodes[right].max[k]) * direction[k];
+		}
+		if (leftDistance < rightDistance) {
+			stack.append(right);
+			stack.append(left);
+		} else {
+			stack.append(left);
+			stack.append(right);
+		}
+	}
+
+	if (bestPolygon < 0) {
+		return false;
+	}
+
+	hit->polygon = bestPolygon;
+	hit->distance = best;
+	for (int k = 0; k < 3; k++) {
+		hit->point[k] = origin[k] + best * direction[k];
+	}
+	return true;
+}
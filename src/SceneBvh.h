@@ -0,0 +1,377 @@
+#pragma once
+
+#include <QVector>
+#include <QMatrix4x4>
+
+#include "IScene.h"
+#include "MeshComponents.h"
+
+/**
+ * @brief Bounding volume hierarchy over the polygons of a scene
+ *
+ * The polygons are sorted along a Morton curve through the bounding box of
+ * the scene and then split recursively into a binary tree of axis aligned
+ * bounding boxes. Each node covers a contiguous range of the sorted polygon
+ * order, so a ray only needs to test the polygons inside the few leaves it
+ * actually passes through. This makes picking independent of the scene size.
+ *
+ * The nodes are stored in depth first order: the left child of an inner
+ * node always follows its parent directly.
+ *
+ * The upper levels of the tree also split the scene into chunks of spatially
+ * close polygons. The render modes create separate vertex ranges for each
+ * chunk, so chunks outside of the view frustum can be skipped when drawing.
+ *
+ * Inside of each chunk the polygons are grouped by their connected
+ * component and split into parts, one for each component in the chunk. The
+ * render modes create their vertex ranges for each part, so the parts of
+ * hidden components are simply left out when drawing, while many small
+ * components still share the chunks of their neighbourhood.
+ *
+ * @see IScene
+ */
+class SceneBvh
+{
+public:
+	/**
+	 * @brief Result of a ray intersection test
+	 */
+	struct Hit
+	{
+		/**
+		 * @brief Index of the hit polygon in the scene
+		 */
+		int polygon;
+
+		/**
+		 * @brief Ray parameter of the hit point
+		 */
+		float distance;
+
+		/**
+		 * @brief Hit point in scene coordinates
+		 */
+		float point[3];
+	};
+
+	/**
+	 * @brief The polygons of one component inside of a chunk
+	 *
+	 * The part contains the polygons polygonAt(first) to
+	 * polygonAt(first+count-1).
+	 */
+	struct Part
+	{
+		/**
+		 * @brief The connected component of all part polygons
+		 */
+		int component;
+
+		/**
+		 * @brief The chunk which contains the part
+		 */
+		int chunk;
+
+		/**
+		 * @brief First polygon in the order of the hierarchy
+		 */
+		int first;
+
+		/**
+		 * @brief Number of polygons
+		 */
+		int count;
+
+		/**
+		 * @brief Number of triangles when the polygons are drawn as fans
+		 */
+		int triangles;
+	};
+
+	/**
+	 * @brief A chunk of spatially close polygons
+	 *
+	 * The chunk contains the polygons polygonAt(first) to
+	 * polygonAt(first+count-1), which are the polygons of the parts
+	 * firstPart to firstPart+partsCount-1.
+	 */
+	struct Chunk
+	{
+		/**
+		 * @brief Bounding box of all chunk polygons
+		 */
+		float min[3];
+		float max[3];
+
+		/**
+		 * @brief First polygon in the order of the hierarchy
+		 */
+		int first;
+
+		/**
+		 * @brief Number of polygons
+		 */
+		int count;
+
+		/**
+		 * @brief Number of triangles when the polygons are drawn as fans
+		 */
+		int triangles;
+
+		/**
+		 * @brief The first part of the chunk
+		 */
+		int firstPart;
+
+		/**
+		 * @brief Number of parts, one for each component in the chunk
+		 */
+		int partsCount;
+	};
+
+	/**
+	 * @brief Constructor
+	 *
+	 * Builds the hierarchy for all polygons of the scene. The scene must
+	 * not change as long as the hierarchy is in use.
+	 *
+	 * @param [in] scene The scene which should be indexed
+	 * @param [in] leafSize Maximum number of polygons per leaf
+	 * @param [in] chunkSize Maximum number of polygons per chunk
+	 */
+	SceneBvh(const IScene *scene, int leafSize = 8, int chunkSize = 8192);
+
+	/**
+	 * @brief Updates the bounding boxes after vertices were moved
+	 *
+	 * The tree, the chunks, the parts and the components keep their polygons, only
+	 * the boxes are calculated again. This is much faster than a new hierarchy, but
+	 * the boxes overlap more if the vertices moved far.
+	 */
+	void refit();
+
+	/**
+	 * @brief Finds the first polygon hit by a ray
+	 *
+	 * The ray is given in scene coordinates and consists of all points
+	 * origin + t * direction with t >= 0. Polygons are split into triangle
+	 * fans for the test, like OpenGL does for GL_POLYGON.
+	 *
+	 * @param [in] origin The start point of the ray
+	 * @param [in] direction The direction of the ray, must not be zero
+	 * @param [out] hit Information about the closest hit
+	 * @param [in] hidden Components whose polygons are skipped, indexed by component, may be null
+	 * @return True, if any polygon was hit
+	 */
+	bool intersect(const float *origin, const float *direction, Hit *hit,
+		const QVector<bool> *hidden = nullptr) const;
+
+	/**
+	 * @brief Returns the number of tree nodes
+	 * @return Number of nodes
+	 */
+	int nodesCount() const;
+
+	/**
+	 * @brief Returns the number of chunks
+	 * @return Number of chunks
+	 */
+	int chunksCount() const;
+
+	/**
+	 * @brief Returns the number of parts
+	 * @return Number of parts
+	 */
+	int partsCount() const;
+
+	/**
+	 * @brief Returns the main memory used by the hierarchy
+	 * @return Number of bytes
+	 */
+	qint64 bytes() const;
+
+	/**
+	 * @brief Getter for the chunks
+	 *
+	 * @param [in] i Number of the chunk, from 0 to chunksCount()-1
+	 * @return The selected chunk
+	 */
+	const Chunk & chunk(int i) const;
+
+	/**
+	 * @brief Getter for the parts
+	 *
+	 * @param [in] i Number of the part, from 0 to partsCount()-1
+	 * @return The selected part
+	 */
+	const Part & part(int i) const;
+
+	/**
+	 * @brief Returns the connected components of the scene
+	 */
+	const MeshComponents & components() const;
+
+	/**
+	 * @brief Collects the parts of some chunks
+	 *
+	 * @param [in] chunks Numbers of chunks in ascending order
+	 * @param [out] parts Receives the numbers of their parts in ascending order
+	 * @param [in] hidden Components whose parts are left out, indexed by component, may be null
+	 */
+	void chunkParts(const QVector<int> & chunks, QVector<int> *parts,
+		const QVector<bool> *hidden = nullptr) const;
+
+	/**
+	 * @brief Returns the polygons in the order of the hierarchy
+	 *
+	 * The polygons follow the Morton curve, inside of each chunk they are
+	 * grouped by their component.
+	 *
+	 * @param [in] i Position in the order
+	 * @return Index of the polygon in the scene
+	 */
+	int polygonAt(int i) const;
+
+	/**
+	 * @brief Finds all chunks inside of the view frustum
+	 *
+	 * The tree is traversed from the top, so whole
+	 * subtrees outside of the frustum are rejected with a single test.
+	 * Chunks are conservatively reported as visible if their bounding
+	 * box intersects the frustum.
+	 *
+	 * @param [in] matrix Projection matrix multiplied with the model view matrix
+	 * @param [out] visible Receives the numbers of all visible chunks in ascending order
+	 */
+	void cull(const QMatrix4x4 & matrix, QVector<int> *visible) const;
+
+	/**
+	 * @brief Finds the polygons of a chunk which may cross an axis aligned plane
+	 *
+	 * The subtree of the chunk is traversed from its top node, subtrees
+	 * whose bounding box lies completely on one side of the plane are
+	 * skipped. The polygons of all leaves touching the plane are reported,
+	 * so some of them may not cross it.
+	 *
+	 * @param [in] chunk Number of the chunk
+	 * @param [in] axis The normal of the plane, 0 for X, 1 for Y and 2 for Z
+	 * @param [in] value The coordinate of the plane on its axis
+	 * @param [out] polygons Receives the indices of the polygons in the order of the hierarchy
+	 */
+	void crossingPolygons(int chunk, int axis, float value, QVector<int> *polygons) const;
+
+private:
+	/**
+	 * @brief Sort key of a polygon
+	 */
+	struct PolygonKey
+	{
+		/**
+		 * @brief Morton code in the lower 32 bits, inside of a chunk also
+		 * the component in the upper 32 bits
+		 */
+		quint64 key;
+
+		/**
+		 * @brief Index of the polygon in the scene
+		 */
+		int polygon;
+	};
+
+	/**
+	 * @brief A node of the hierarchy
+	 *
+	 * Leaves have a count greater than zero and cover the polygons
+	 * order[offset] to order[offset+count-1]. Inner nodes have a count
+	 * of zero, their right child is stored at offset.
+	 */
+	struct Node
+	{
+		float min[3];
+		float max[3];
+		int offset;
+		int count;
+	};
+
+	/**
+	 * @brief Creates the subtree for a range of the sorted keys
+	 *
+	 * The first node small enough for a chunk sorts its keys by component
+	 * and creates the parts of the chunk.
+	 *
+	 * @param [in, out] keys Morton code of each polygon, sorted
+	 * @param [in] bounds Bounding box for each polygon (min xyz, max xyz)
+	 * @param [in] first First key of the range
+	 * @param [in] last One after the last key of the range
+	 * @param [in] insideChunk True, if a parent node has already started a chunk
+	 * @return Index of the new node
+	 */
+	int buildNode(QVector<PolygonKey> & keys, const QVector<float> & bounds,
+		int first, int last, bool insideChunk);
+
+	/**
+	 * @brief Returns the chunk which starts at a node or -1
+	 */
+	int chunkOfNode(int node) const;
+
+	/**
+	 * @brief Ray versus triangle test (Moeller-Trumbore)
+	 *
+	 * @return The ray parameter of the hit or a negative value
+	 */
+	static float intersectTriangle(const float *origin, const float *direction,
+		const float *a, const float *b, const float *c);
+
+	/**
+	 * @brief Ray versus bounding box test (slab method)
+	 *
+	 * @return True, if the ray enters the box before maxDistance
+	 */
+	static bool intersectBox(const Node & node, const float *origin,
+		const float *inverseDirection, float maxDistance);
+
+	/**
+	 * @brief The indexed scene
+	 */
+	const IScene *scene;
+
+	/**
+	 * @brief Maximum number of polygons per leaf
+	 */
+	int leafSize;
+
+	/**
+	 * @brief Maximum number of polygons per chunk
+	 */
+	int chunkSize;
+
+	/**
+	 * @brief All nodes in depth first order, the root is the first node
+	 */
+	QVector<Node> nodes;
+
+	/**
+	 * @brief Polygon indices in the order of the hierarchy
+	 */
+	QVector<int> order;
+
+	/**
+	 * @brief All chunks in depth first order
+	 */
+	QVector<Chunk> chunks;
+
+	/**
+	 * @brief All parts in the order of their chunks
+	 */
+	QVector<Part> parts;
+
+	/**
+	 * @brief The node at which each chunk starts, in ascending order
+	 */
+	QVector<int> chunkNodes;
+
+	/**
+	 * @brief Connected components of the scene
+	 */
+	MeshComponents meshComponents;
+};
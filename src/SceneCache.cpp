@@ -0,0 +1,642 @@
+#include <QtConcurrent>
+#include <QStandardPaths>
+
+#include "SceneCache.h"
+#include "SceneFactory.h"
+#include "OffScene.h"
+#include "OffBinaryReader.h"
+#include "Trace.h"
+
+SceneCache::SceneCache(GlWidget *widget, QObject *parent) : QObject(parent)
+{
+	this->widget = widget;
+	current = nullptr;
+	options = SceneFactory::LoadOptions();
+	memoryBytes = qint64(2048) * 1024 * 1024;
+	gpuBytes = qint64(1024) * 1024 * 1024;
+	prefetchPool.setMaxThreadCount(1);
+}
+
+SceneCache::~SceneCache()
+{
+	cancelPrefetches();
+	for (int i = 0; i < prefetches.size(); i++) {
+		prefetches[i].watcher->waitForFinished();
+	}
+	finishPrefetches();
+
+	for (int i = 0; i < reloads.size(); i++) {
+		reloads[i].abort->store(1);
+		reloads[i].watcher->waitForFinished();
+	}
+	finishReloads();
+
+	for (int i = 0; i < evictions.size(); i++) {
+		evictions[i].watcher->waitForFinished();
+	}
+	finishEvictions();
+
+	for (int i = 0; i < entries.size(); i++) {
+		widget->setSceneRetained(entries[i].scene, false);
+		delete entries[i].scene;
+	}
+}
+
+IScene* SceneCache::open(const QString & file, bool *cached)
+{
+	TRACE_ZONE("SceneCache::open");
+	QFileInfo info(file);
+	QString path = info.absoluteFilePath();
+	if (cached) {
+		*cached = false;
+	}
+
+	// A running prefetch of the file is faster than loading it again
+	for (int i = 0; i < prefetches.size(); i++) {
+		if (prefetches[i].file == path && !prefetches[i].abort->load()) {
+			prefetches[i].watcher->waitForFinished();
+		}
+	}
+	finishPrefetches();
+
+	// A running reload brings the cached scene up to date
+	for (int i = 0; i < reloads.size(); i++) {
+		if (reloads[i].file == path) {
+			reloads[i].watcher->waitForFinished();
+		}
+	}
+	finishReloads();
+
+	int index = indexOf(path);
+	if (index >= 0 && entries[index].fileSize == info.size() &&
+			entries[index].modified == info.lastModified()) {
+		entries.move(index, 0);
+		entries[0].opened = true;
+		if (cached) {
+			*cached = true;
+		}
+		return entries[0].scene;
+	}
+
+	waitForSnapshot(path);
+	IScene *scene = readSnapshot(path, options, info.size(), info.lastModified());
+	if (!scene) {
+		scene = SceneFactory::openFile(file, options);
+	}
+
+	// The file was modified, the old scene is only removed after the new
+	// one was loaded, so a failed reload keeps the current view
+	if (index >= 0) {
+		Entry outdated = entries.takeAt(index);
+		if (outdated.scene == current) {
+			widget->setScene(nullptr);
+			current = nullptr;
+		}
+		widget->setSceneRetained(outdated.scene, false);
+		delete outdated.scene;
+	}
+
+	Entry entry;
+	entry.file = path;
+	entry.scene = scene;
+	entry.sceneBytes = scene->memoryReport().total();
+	entry.fileSize = info.size();
+	entry.modified = info.lastModified();
+	entry.opened = true;
+	entries.prepend(entry);
+	widget->setSceneRetained(scene, true);
+	return scene;
+}
+
+void SceneCache::setCurrent(const IScene *scene)
+{
+	current = scene;
+}
+
+void SceneCache::trim()
+{
+	TRACE_ZONE("SceneCache::trim");
+
+	// Vertex buffers are uploaded again quickly, so they go first
+	qint64 gpu = 0;
+	for (int i = 0; i < entries.size(); i++) {
+		gpu += widget->sceneGpuBytes(entries[i].scene);
+	}
+	for (int i = entries.size() - 1; i >= 0 && gpu > gpuBytes; i--) {
+		if (entries[i].scene != current) {
+			gpu -= widget->sceneGpuBytes(entries[i].scene);
+			widget->releaseSceneBuffers(entries[i].scene);
+		}
+	}
+
+	qint64 memory = 0;
+	for (int i = 0; i < entries.size(); i++) {
+		memory += entries[i].sceneBytes + widget->sceneCacheBytes(entries[i].scene);
+	}
+	for (int i = entries.size() - 1; i >= 0 && memory > memoryBytes; i--) {
+		if (entries[i].scene != current && !isReloading(entries[i].scene)) {
+			memory -= entries[i].sceneBytes + widget->sceneCacheBytes(entries[i].scene);
+			evict(i);
+		}
+	}
+}
+
+bool SceneCache::isResident(const QString & file) const
+{
+	return indexOf(QFileInfo(file).absoluteFilePath()) >= 0;
+}
+
+void SceneCache::setBudget(qint64 memoryBytes, qint64 gpuBytes)
+{
+	this->memoryBytes = memoryBytes;
+	this->gpuBytes = gpuBytes;
+	trim();
+}
+
+qint64 SceneCache::memoryBudget() const
+{
+	return memoryBytes;
+}
+
+qint64 SceneCache::gpuBudget() const
+{
+	return gpuBytes;
+}
+
+void SceneCache::removeSnapshot(const QString & file)
+{
+	QString path = QFileInfo(file).absoluteFilePath();
+	waitForSnapshot(path);
+	QFile::remove(snapshotFile(path, options));
+}
+
+void SceneCache::setLoadOptions(const SceneFactory::LoadOptions & options)
+{
+	this->options = options;
+}
+
+void SceneCache::invalidate()
+{
+	TRACE_ZONE("SceneCache::invalidate");
+	cancelPrefetches();
+	finishPrefetches();
+
+	// The snapshots of evicted scenes belong to the old options
+	for (int i = 0; i < evictions.size(); i++) {
+		evictions[i].watcher->waitForFinished();
+	}
+	finishEvictions();
+
+	for (int i = entries.size() - 1; i >= 0; i--) {
+		if (entries[i].scene == current) {
+			continue;
+		}
+		Entry entry = entries.takeAt(i);
+		waitForReloads(entry.scene);
+		widget->setSceneRetained(entry.scene, false);
+		delete entry.scene;
+	}
+}
+
+void SceneCache::prefetch(const QStringList & files)
+{
+	QStringList paths;
+	for (int i = 0; i < files.size(); i++) {
+		paths.append(QFileInfo(files[i]).absoluteFilePath());
+	}
+
+	// Only the last requested files are still needed
+	QSet<QString> running;
+	for (int i = 0; i < prefetches.size(); i++) {
+		if (!paths.contains(prefetches[i].file)) {
+			prefetches[i].abort->store(1);
+		} else if (!prefetches[i].abort->load()) {
+			running.insert(prefetches[i].file);
+		}
+	}
+
+	for (int i = 0; i < paths.size(); i++) {
+		QFileInfo info(paths[i]);
+		if (running.contains(paths[i]) || indexOf(paths[i]) >= 0 || !info.isFile()) {
+			continue;
+		}
+
+		Prefetch prefetch;
+		prefetch.file = paths[i];
+		prefetch.fileSize = info.size();
+		prefetch.modified = info.lastModified();
+		prefetch.abort = QSharedPointer<QAtomicInt>(new QAtomicInt(0));
+		prefetch.watcher = new QFutureWatcher<Prepared>(this);
+		connect(prefetch.watcher, SIGNAL(finished()), this, SLOT(finishPrefetches()));
+
+		// The lambda keeps the abort flag alive until the prefetch is done
+		QSharedPointer<QAtomicInt> abort = prefetch.abort;
+		QString file = prefetch.file;
+		qint64 fileSize = prefetch.fileSize;
+		QDateTime modified = prefetch.modified;
+		SceneFactory::LoadOptions loadOptions = options;
+		prefetch.watcher->setFuture(QtConcurrent::run(&prefetchPool,
+			[file, loadOptions, fileSize, modified, abort]() {
+				// Prefetching must not slow down the work with the current scene
+				QThread::currentThread()->setPriority(QThread::LowPriority);
+				return prepare(file, loadOptions, fileSize, modified, abort.data());
+			}));
+		prefetches.append(prefetch);
+	}
+}
+
+void SceneCache::cancelPrefetches()
+{
+	prefetch(QStringList());
+}
+
+void SceneCache::finishPrefetches()
+{
+	bool added = false;
+	for (int i = prefetches.size() - 1; i >= 0; i--) {
+		if (!prefetches[i].watcher->isFinished()) {
+			continue;
+		}
+		Prefetch prefetch = prefetches.takeAt(i);
+		Prepared prepared = prefetch.watcher->result();
+		// This slot may be called by the watcher itself
+		prefetch.watcher->deleteLater();
+		if (!prepared.scene) {
+			continue;
+		}
+
+		// Old scenes may be evicted for a prefetched one, the current not
+		qint64 bytes = prepared.sceneBytes + (prepared.bvh ? prepared.bvh->bytes() : 0);
+		if (prefetch.abort->load() || indexOf(prefetch.file) >= 0 ||
+				currentBytes() + bytes > memoryBytes) {
+			delete prepared.bvh;
+			delete prepared.scene;
+			continue;
+		}
+
+		// The prefetched scene follows the current one in the order of use
+		Entry entry;
+		entry.file = prefetch.file;
+		entry.scene = prepared.scene;
+		entry.sceneBytes = prepared.sceneBytes;
+		entry.fileSize = prefetch.fileSize;
+		entry.modified = prefetch.modified;
+		entry.opened = false;
+		entries.insert(qMin(1, entries.size()), entry);
+		widget->setSceneRetained(prepared.scene, true);
+		widget->setPreparedHierarchy(prepared.scene, prepared.bvh);
+		added = true;
+	}
+
+	if (added) {
+		trim();
+	}
+}
+
+void SceneCache::reload(const QString & file, bool incremental)
+{
+	QString path = QFileInfo(file).absoluteFilePath();
+	int index = indexOf(path);
+	if (index < 0) {
+		return;
+	}
+
+	// A running reload may have read the file before the last change
+	for (int i = 0; i < reloads.size(); i++) {
+		if (reloads[i].file == path) {
+			reloads[i].abort->store(1);
+		}
+	}
+
+	QFileInfo info(path);
+	Reload reload;
+	reload.file = path;
+	reload.scene = entries[index].scene;
+	reload.fileSize = info.size();
+	reload.modified = info.lastModified();
+	reload.abort = QSharedPointer<QAtomicInt>(new QAtomicInt(0));
+	reload.watcher = new QFutureWatcher<Reloaded>(this);
+	connect(reload.watcher, SIGNAL(finished()), this, SLOT(finishReloads()));
+
+	QSharedPointer<QAtomicInt> abort = reload.abort;
+	const IScene *scene = reload.scene;
+	qint64 fileSize = reload.fileSize;
+	QDateTime modified = reload.modified;
+	SceneFactory::LoadOptions loadOptions = options;
+	reload.watcher->setFuture(QtConcurrent::run(
+		[scene, path, loadOptions, fileSize, modified, incremental, abort]() {
+			return reloadScene(scene, path, loadOptions, fileSize, modified, incremental,
+				abort.data());
+		}));
+	reloads.append(reload);
+}
+
+void SceneCache::finishReloads()
+{
+	bool replaced = false;
+	for (int i = reloads.size() - 1; i >= 0; i--) {
+		if (!reloads[i].watcher->isFinished()) {
+			continue;
+		}
+		Reload reload = reloads.takeAt(i);
+		Reloaded result = reload.watcher->result();
+		// This slot may be called by the watcher itself
+		reload.watcher->deleteLater();
+
+		int index = indexOf(reload.file);
+		if (reload.abort->load() || index < 0 || entries[index].scene != reload.scene) {
+			delete result.prepared.bvh;
+			delete result.prepared.scene;
+			continue;
+		}
+
+		// Canceled reloads of the same file may still read the scene
+		waitForReloads(reload.scene);
+
+		if (result.incremental) {
+			OffScene *offScene = dynamic_cast<OffScene*>(entries[index].scene);
+			emit sceneAboutToChange(offScene);
+			offScene->applyUpdate(result.update);
+			entries[index].fileSize = reload.fileSize;
+			entries[index].modified = reload.modified;
+			widget->updateSceneVertices(offScene);
+			emit sceneUpdated(offScene);
+		} else if (result.prepared.scene) {
+			IScene *oldScene = entries[index].scene;
+			IScene *newScene = result.prepared.scene;
+			entries[index].scene = newScene;
+			entries[index].sceneBytes = result.prepared.sceneBytes;
+			entries[index].fileSize = reload.fileSize;
+			entries[index].modified = reload.modified;
+			widget->setSceneRetained(newScene, true);
+			widget->setPreparedHierarchy(newScene, result.prepared.bvh);
+			emit sceneReplaced(oldScene, newScene);
+
+			widget->setSceneRetained(oldScene, false);
+			delete oldScene;
+			replaced = true;
+		} else {
+			// The file is loaded again when the user opens it
+			emit reloadFailed(reload.file, result.prepared.error);
+		}
+	}
+
+	if (replaced) {
+		trim();
+	}
+}
+
+void SceneCache::finishEvictions()
+{
+	for (int i = evictions.size() - 1; i >= 0; i--) {
+		if (evictions[i].watcher->isFinished()) {
+			Eviction eviction = evictions.takeAt(i);
+			delete eviction.scene;
+			// This slot may be called by the watcher itself
+			eviction.watcher->deleteLater();
+		}
+	}
+}
+
+int SceneCache::indexOf(const QString & file) const
+{
+	for (int i = 0; i < entries.size(); i++) {
+		if (entries[i].file == file) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+void SceneCache::evict(int index)
+{
+	Entry entry = entries.takeAt(index);
+	widget->setSceneRetained(entry.scene, false);
+
+	// A snapshot only pays off for files the user has looked at
+	if (!entry.opened) {
+		delete entry.scene;
+		return;
+	}
+
+	Eviction eviction;
+	eviction.file = entry.file;
+	eviction.scene = entry.scene;
+	eviction.watcher = new QFutureWatcher<void>(this);
+	connect(eviction.watcher, SIGNAL(finished()), this, SLOT(finishEvictions()));
+	eviction.watcher->setFuture(QtConcurrent::run(writeSnapshot, entry.file, options,
+		entry.fileSize, entry.modified, static_cast<const IScene*>(entry.scene)));
+	evictions.append(eviction);
+}
+
+void SceneCache::waitForSnapshot(const QString & file)
+{
+	for (int i = 0; i < evictions.size(); i++) {
+		if (evictions[i].file == file) {
+			evictions[i].watcher->waitForFinished();
+		}
+	}
+	finishEvictions();
+}
+
+qint64 SceneCache::currentBytes() const
+{
+	for (int i = 0; i < entries.size(); i++) {
+		if (entries[i].scene == current) {
+			return entries[i].sceneBytes + widget->sceneCacheBytes(current);
+		}
+	}
+	return 0;
+}
+
+SceneCache::Prepared SceneCache::prepare(const QString & file,
+	const SceneFactory::LoadOptions & options, qint64 fileSize, const QDateTime & modified,
+	const QAtomicInt *abort)
+{
+	TRACE_ZONE("SceneCache::prepare");
+	Prepared prepared;
+	prepared.scene = nullptr;
+	prepared.bvh = nullptr;
+	prepared.sceneBytes = 0;
+	if (abort->load()) {
+		return prepared;
+	}
+
+	try {
+		prepared.scene = readSnapshot(file, options, fileSize, modified);
+		if (!prepared.scene) {
+			prepared.scene = SceneFactory::openFile(file, options, false, nullptr, abort);
+		}
+	}
+	catch (QString & message) {
+		// A prefetch ignores the error, it is shown when the user opens the file
+		prepared.error = message;
+		return prepared;
+	}
+
+	// The scene is used and deleted by the GUI thread
+	QObject *object = dynamic_cast<QObject*>(prepared.scene);
+	if (object) {
+		object->moveToThread(QCoreApplication::instance()->thread());
+	}
+	prepared.sceneBytes = prepared.scene->memoryReport().total();
+	if (!abort->load()) {
+		prepared.bvh = new SceneBvh(prepared.scene);
+	}
+	return prepared;
+}
+
+SceneCache::Reloaded SceneCache::reloadScene(const IScene *scene, const QString & file,
+	const SceneFactory::LoadOptions & options, qint64 fileSize, const QDateTime & modified,
+	bool incremental, const QAtomicInt *abort)
+{
+	TRACE_ZONE("SceneCache::reloadScene");
+	Reloaded result;
+	result.incremental = false;
+	result.prepared.scene = nullptr;
+	result.prepared.bvh = nullptr;
+	result.prepared.sceneBytes = 0;
+
+	// Deforming meshes keep their polygons, so most reloads end here. The
+	// update holds the vertices of the file, a welded scene has other ones.
+	const OffScene *offScene = dynamic_cast<const OffScene*>(scene);
+	if (incremental && offScene && SceneFactory::describe(options).isEmpty()
+		&& QFileInfo(file).suffix() == "off" && !OffBinaryReader::isBinary(file)) {
+		try {
+			if (offScene->readUpdate(file, &result.update, abort)) {
+				result.incremental = true;
+				return result;
+			}
+		}
+		catch (QString & message) {
+			result.prepared.error = message;
+			return result;
+		}
+	}
+
+	if (!abort->load()) {
+		result.prepared = prepare(file, options, fileSize, modified, abort);
+	}
+	return result;
+}
+
+bool SceneCache::isReloading(const IScene *scene) const
+{
+	for (int i = 0; i < reloads.size(); i++) {
+		if (reloads[i].scene == scene) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void SceneCache::waitForReloads(const IScene *scene)
+{
+	for (int i = 0; i < reloads.size(); i++) {
+		if (reloads[i].scene == scene) {
+			reloads[i].watcher->waitForFinished();
+		}
+	}
+}
+
+QString SceneCache::snapshotFile(const QString & file, const SceneFactory::LoadOptions & options)
+{
+	// Scenes loaded with other options have their own snapshots
+	QByteArray key = file.toUtf8();
+	QString description = SceneFactory::describe(options);
+	if (!description.isEmpty()) {
+		key += "\n" + description.toUtf8();
+	}
+	QByteArray hash = QCryptographicHash::hash(key, QCryptographicHash::Sha1);
+	return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) +
+		"/snapshots/" + QString::fromLatin1(hash.toHex()) + ".snapshot";
+}
+
+IScene* SceneCache::readSnapshot(const QString & file, const SceneFactory::LoadOptions & options,
+	qint64 fileSize, const QDateTime & modified)
+{
+	QFile input(snapshotFile(file, options));
+	if (!input.open(QIODevice::ReadOnly)) {
+		return nullptr;
+	}
+
+	QDataStream stream(&input);
+	if (!readHeader(&stream, fileSize, modified)) {
+		return nullptr;
+	}
+
+	try {
+		return OffScene::fromSnapshot(&stream);
+	}
+	catch (QString &) {
+		// The file is parsed instead and a new snapshot written later
+		input.close();
+		input.remove();
+		return nullptr;
+	}
+}
+
+bool SceneCache::readHeader(QDataStream *stream, qint64 fileSize,
+	const QDateTime & modified)
+{
+	stream->setVersion(QDataStream::Qt_5_0);
+	quint32 magic = 0;
+	quint16 version = 0;
+	qint64 size = -1;
+	qint64 time = 0;
+	*stream >> magic >> version >> size >> time;
+	return stream->status() == QDataStream::Ok && magic == snapshotMagic &&
+		version == snapshotVersion && size == fileSize &&
+		time == modified.toMSecsSinceEpoch();
+}
+
+void SceneCache::writeSnapshot(const QString & file, const SceneFactory::LoadOptions & options,
+	qint64 fileSize, const QDateTime & modified, const IScene *scene)
+{
+	TRACE_ZONE("SceneCache::writeSnapshot");
+	const OffScene *offScene = dynamic_cast<const OffScene*>(scene);
+	if (!offScene) {
+		return;
+	}
+
+	// A scene that was read from a snapshot needs no new one
+	QString target = snapshotFile(file, options);
+	QFile existing(target);
+	if (existing.open(QIODevice::ReadOnly)) {
+		QDataStream stream(&existing);
+		if (readHeader(&stream, fileSize, modified)) {
+			return;
+		}
+	}
+
+	if (!QDir().mkpath(QFileInfo(target).absolutePath())) {
+		return;
+	}
+
+	// QSaveFile replaces an old snapshot only after the new one is complete
+	QSaveFile output(target);
+	if (!output.open(QIODevice::WriteOnly)) {
+		return;
+	}
+	QDataStream stream(&output);
+	stream.setVersion(QDataStream::Qt_5_0);
+	stream << snapshotMagic << snapshotVersion << fileSize << modified.toMSecsSinceEpoch();
+	offScene->writeSnapshot(&stream);
+	if (stream.status() == QDataStream::Ok && output.commit()) {
+		pruneSnapshots(QFileInfo(target).absolutePath());
+	}
+}
+
+void SceneCache::pruneSnapshots(const QString & folder)
+{
+	// The newest snapshots are kept, they are most likely opened again
+	QFileInfoList snapshots = QDir(folder).entryInfoList(QStringList("*.snapshot"),
+		QDir::Files, QDir::Time);
+	qint64 bytes = 0;
+	for (int i = 0; i < snapshots.size(); i++) {
+		bytes += snapshots[i].size();
+		if (bytes > snapshotBudget) {
+			QFile::remove(snapshots[i].absoluteFilePath());
+		}
+	}
+}
@@ -0,0 +1,404 @@
+#pragma once
+
+#include <QtCore>
+#include <QFutureWatcher>
+
+#include "IScene.h"
+#include "OffScene.h"
+#include "GlWidget.h"
+#include "SceneFactory.h"
+
+/**
+ * @brief Keeps the recently opened scenes in memory
+ *
+ * The scenes are kept in the order of their last use. The GlWidget
+ * retains the polygon hierarchy and the vertex buffers of each cached
+ * scene, so switching back to a cached file is instant.
+ *
+ * Two budgets limit the cache. If the vertex buffers need more graphics
+ * memory than allowed, the buffers of the least recently used scenes are
+ * deleted, they are uploaded again when needed. If the scenes need more
+ * main memory than allowed, the least recently used scenes are evicted.
+ * The current scene is never evicted.
+ *
+ * An evicted OFF scene that the user has opened is written as binary
+ * snapshot into the cache directory of the application. Opening the file
+ * again reads the snapshot instead of parsing the text, as long as the
+ * file was not modified. The snapshots are written in the background, the
+ * oldest ones are deleted when the directory grows beyond snapshotBudget.
+ * Prefetched scenes which were never opened are deleted without snapshot.
+ *
+ * Files which are likely opened next can be prefetched. They are loaded
+ * and their polygon hierarchy is built by a low priority thread. A
+ * prefetched scene is only kept if it fits into the memory budget next
+ * to the current scene.
+ *
+ * @see GlWidget::setSceneRetained()
+ * @see OffScene::writeSnapshot()
+ */
+class SceneCache : public QObject
+{
+	Q_OBJECT
+
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param [in] widget Widget that displays the scenes
+	 * @param [in] parent Parent object
+	 */
+	SceneCache(GlWidget *widget, QObject *parent = nullptr);
+
+	/**
+	 * @brief Destructor, waits for the snapshots and deletes all scenes
+	 *
+	 * The widget must not display a cached scene any more.
+	 */
+	~SceneCache();
+
+	/**
+	 * @brief Returns the scene of a file
+	 *
+	 * Returns the cached scene if the file was not modified since it was
+	 * loaded. Otherwise the scene is read from a snapshot or from the file.
+	 * The cache owns the returned scene. Throws a QString if the file can
+	 * not be loaded.
+	 *
+	 * @param [in] file Path to the file
+	 * @param [out] cached Is set to true if the scene was already in memory, may be null
+	 * @return The scene of the file
+	 */
+	IScene* open(const QString & file, bool *cached = nullptr);
+
+	/**
+	 * @brief Marks the scene displayed by the widget
+	 *
+	 * The current scene is never evicted. Call trim() afterwards.
+	 *
+	 * @param [in] scene A scene returned by open() or null
+	 */
+	void setCurrent(const IScene *scene);
+
+	/**
+	 * @brief Releases vertex buffers and evicts scenes until the budgets are met
+	 */
+	void trim();
+
+	/**
+	 * @brief Is the scene of the file in memory?
+	 */
+	bool isResident(const QString & file) const;
+
+	/**
+	 * @brief Sets the budgets and trims the cache
+	 *
+	 * @param [in] memoryBytes Main memory for the scenes and their render data
+	 * @param [in] gpuBytes Graphics memory for the vertex buffers
+	 */
+	void setBudget(qint64 memoryBytes, qint64 gpuBytes);
+
+	/**
+	 * @brief Returns the main memory budget in bytes
+	 */
+	qint64 memoryBudget() const;
+
+	/**
+	 * @brief Returns the graphics memory budget in bytes
+	 */
+	qint64 gpuBudget() const;
+
+	/**
+	 * @brief Deletes the snapshot of a file, if there is one
+	 */
+	void removeSnapshot(const QString & file);
+
+	/**
+	 * @brief Loads files in the background, so opening them is instant
+	 *
+	 * Running prefetches of files which are not in the list are canceled.
+	 * Files which are already in memory are skipped.
+	 *
+	 * @param [in] files Paths of the files, the most likely first
+	 */
+	void prefetch(const QStringList & files);
+
+	/**
+	 * @brief Cancels all running prefetches
+	 */
+	void cancelPrefetches();
+
+	/**
+	 * @brief Reloads a changed file in the background
+	 *
+	 * Emits sceneUpdated(), sceneReplaced() or reloadFailed() when done.
+	 * A running reload of the same file is canceled. Does nothing for
+	 * files which are not in the cache.
+	 *
+	 * @param [in] file Path to the file
+	 * @param [in] incremental Only read the new vertices if the polygons of
+	 *             an OFF file did not change, false loads the file again.
+	 *             Scenes loaded with welding are always loaded again.
+	 */
+	void reload(const QString & file, bool incremental = true);
+
+	/**
+	 * @brief Sets the options for loading the files
+	 *
+	 * Call invalidate() before, if scenes with the old options are cached.
+	 *
+	 * @param [in] options Passed to SceneFactory::openFile()
+	 */
+	void setLoadOptions(const SceneFactory::LoadOptions & options);
+
+	/**
+	 * @brief Forgets all scenes except the current one
+	 *
+	 * Must be called before the load options change, so the other files
+	 * are loaded again when they are opened. No snapshots are written,
+	 * running snapshots are finished with the old options.
+	 */
+	void invalidate();
+
+signals:
+	/**
+	 * @brief The vertices or colors of a cached scene are updated next
+	 *
+	 * Receivers must stop everything that reads the scene in other threads.
+	 */
+	void sceneAboutToChange(const IScene *scene);
+
+	/**
+	 * @brief The vertices or colors of a cached scene were updated
+	 *
+	 * The render data in the widget was already updated.
+	 */
+	void sceneUpdated(const IScene *scene);
+
+	/**
+	 * @brief A cached scene was replaced by the reloaded file
+	 *
+	 * The old scene is deleted after this signal, so receivers must
+	 * switch to the new scene and call setCurrent() if needed.
+	 */
+	void sceneReplaced(const IScene *oldScene, IScene *newScene);
+
+	/**
+	 * @brief A changed file could not be reloaded, the old scene is kept
+	 */
+	void reloadFailed(const QString & file, const QString & message);
+
+private slots:
+	/**
+	 * @brief Deletes the scenes whose snapshot was written
+	 */
+	void finishEvictions();
+
+	/**
+	 * @brief Adds the finished prefetches to the cache
+	 */
+	void finishPrefetches();
+
+	/**
+	 * @brief Applies the finished reloads to the cache
+	 */
+	void finishReloads();
+
+private:
+	/**
+	 * @brief A cached scene
+	 */
+	struct Entry
+	{
+		QString file;
+		IScene *scene;
+		qint64 sceneBytes;
+		qint64 fileSize;
+		QDateTime modified;
+
+		/**
+		 * @brief Was the scene returned by open()? False for prefetched scenes.
+		 */
+		bool opened;
+	};
+
+	/**
+	 * @brief A scene whose snapshot is written in the background
+	 */
+	struct Eviction
+	{
+		QString file;
+		IScene *scene;
+		QFutureWatcher<void> *watcher;
+	};
+
+	/**
+	 * @brief A scene loaded by a prefetch
+	 */
+	struct Prepared
+	{
+		IScene *scene;
+		SceneBvh *bvh;
+		qint64 sceneBytes;
+		QString error;
+	};
+
+	/**
+	 * @brief A file that is loaded in the background
+	 */
+	struct Prefetch
+	{
+		QString file;
+		qint64 fileSize;
+		QDateTime modified;
+		QSharedPointer<QAtomicInt> abort;
+		QFutureWatcher<Prepared> *watcher;
+	};
+
+	/**
+	 * @brief Result of a reload
+	 *
+	 * Either the update is valid or a new scene was prepared.
+	 */
+	struct Reloaded
+	{
+		bool incremental;
+		OffScene::Update update;
+		Prepared prepared;
+	};
+
+	/**
+	 * @brief A changed file that is reloaded in the background
+	 */
+	struct Reload
+	{
+		QString file;
+		const IScene *scene;
+		qint64 fileSize;
+		QDateTime modified;
+		QSharedPointer<QAtomicInt> abort;
+		QFutureWatcher<Reloaded> *watcher;
+	};
+
+	/**
+	 * @brief Returns the index of the entry of a file or -1
+	 */
+	int indexOf(const QString & file) const;
+
+	/**
+	 * @brief Removes an entry and writes its snapshot in the background
+	 *
+	 * Scenes which were only prefetched are deleted at once.
+	 */
+	void evict(int index);
+
+	/**
+	 * @brief Waits until the snapshot of the file is written
+	 */
+	void waitForSnapshot(const QString & file);
+
+	/**
+	 * @brief Returns the main memory used by the current scene
+	 */
+	qint64 currentBytes() const;
+
+	/**
+	 * @brief Loads a scene and builds its hierarchy, runs in the background
+	 */
+	static Prepared prepare(const QString & file, const SceneFactory::LoadOptions & options,
+		qint64 fileSize, const QDateTime & modified, const QAtomicInt *abort);
+
+	/**
+	 * @brief Reads a changed file for a cached scene, runs in the background
+	 */
+	static Reloaded reloadScene(const IScene *scene, const QString & file,
+		const SceneFactory::LoadOptions & options, qint64 fileSize,
+		const QDateTime & modified, bool incremental, const QAtomicInt *abort);
+
+	/**
+	 * @brief Is a reload reading the scene?
+	 */
+	bool isReloading(const IScene *scene) const;
+
+	/**
+	 * @brief Waits until no reload reads the scene any more
+	 */
+	void waitForReloads(const IScene *scene);
+
+	/**
+	 * @brief Returns the path of the snapshot of a file loaded with the options
+	 */
+	static QString snapshotFile(const QString & file, const SceneFactory::LoadOptions & options);
+
+	/**
+	 * @brief Reads a snapshot, returns null if there is no valid one
+	 */
+	static IScene* readSnapshot(const QString & file, const SceneFactory::LoadOptions & options,
+		qint64 fileSize, const QDateTime & modified);
+
+	/**
+	 * @brief Reads the header of a snapshot, returns true if it matches the file
+	 */
+	static bool readHeader(QDataStream *stream, qint64 fileSize,
+		const QDateTime & modified);
+
+	/**
+	 * @brief Writes the snapshot of an OFF scene, does nothing for other scenes
+	 *
+	 * Prunes the snapshot directory afterwards.
+	 */
+	static void writeSnapshot(const QString & file, const SceneFactory::LoadOptions & options,
+		qint64 fileSize, const QDateTime & modified, const IScene *scene);
+
+	/**
+	 * @brief Deletes the oldest snapshots until the directory fits into snapshotBudget
+	 *
+	 * @param [in] folder The snapshot directory
+	 */
+	static void pruneSnapshots(const QString & folder);
+
+	/**
+	 * @brief Identifies the snapshot files
+	 */
+	static const quint32 snapshotMagic = 0x4f565343;
+
+	/**
+	 * @brief Changes when the format of the snapshots changes
+	 */
+	static const quint16 snapshotVersion = 2;
+
+	/**
+	 * @brief Maximum size of all snapshots in bytes
+	 */
+	static const qint64 snapshotBudget = qint64(2) << 30;
+
+	GlWidget *widget;
+	const IScene *current;
+	SceneFactory::LoadOptions options;
+	qint64 memoryBytes;
+	qint64 gpuBytes;
+
+	/**
+	 * @brief The cached scenes, the most recently used first
+	 */
+	QList<Entry> entries;
+
+	/**
+	 * @brief Evicted scenes that are not deleted yet
+	 */
+	QList<Eviction> evictions;
+
+	/**
+	 * @brief Running prefetches, including canceled ones
+	 */
+	QList<Prefetch> prefetches;
+
+	/**
+	 * @brief Running reloads, including canceled ones
+	 */
+	QList<Reload> reloads;
+
+	/**
+	 * @brief Runs one prefetch at a time, so the render threads are not slowed down
+	 */
+	QThreadPool prefetchPool;
+};
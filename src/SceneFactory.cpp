@@ -2,26 +2,108 @@
 
 #include "SceneFactory.h"
 #include "OffScene.h"
+#include "StlReader.h"
+#include "PlyReader.h"
+#include "ObjReader.h"
+#include "OffBinaryReader.h"
+#include "QuantizedFile.h"
+#include "VertexWelder.h"
+#include "Trace.h"
 
 QString SceneFactory::openFileString()
 {
 	// Seperate additional file formats with ';;'
 	// Example: "Off Files (*.off);;Bla files (*.bla)"
-	return QString(tr("Off Files (*.off)"));
+	return QString(tr("Off Files (*.off)")) + ";;" + tr("STL Files (*.stl)") + ";;"
+		+ tr("PLY Files (*.ply)") + ";;" + tr("OBJ Files (*.obj)") + ";;"
+		+ QuantizedFile::fileFilter() + ";;" + TileFile::fileFilter();
 }
 
-IScene* SceneFactory::openFile(QString file)
+QStringList SceneFactory::nameFilters()
 {
+	return QStringList() << "*.off" << "*.stl" << "*.ply" << "*.obj" << "*.ofq" << "*.oft";
+}
+
+IScene* SceneFactory::openFile(QString file, const LoadOptions & options, bool showProgress,
+	LoadTimings *timings, const QAtomicInt *abort)
+{
+	TRACE_ZONE("SceneFactory::openFile");
 	QFileInfo fileInfo(file);
+
+	// Pipes like "generator | offview -" deliver OFF data
+	if (file == "-") {
+		return new OffScene(file, showProgress, timings, abort);
+	}
 	
 	if (!fileInfo.exists()) {
 		throw QString(tr("File does not exist!"));
 	}
 	
 	QString ext = fileInfo.suffix();
-	if (ext == "off") {
-		return new OffScene(file);
+	bool clean = options.weldVertices;
+	float tolerance = options.weldTolerance;
+	MeshData mesh;
+	bool binaryOff = ext == "off" && OffBinaryReader::isBinary(file);
+	if (ext == "off" && !binaryOff) {
+		OffScene *scene = new OffScene(file, showProgress, timings, abort);
+		if (!clean) {
+			return scene;
+		}
+		scene->toMesh(&mesh);
+		VertexWelder::Report report = VertexWelder::clean(&mesh, tolerance);
+		if (report.vertices == 0 && report.degeneratePolygons == 0
+				&& report.duplicatePolygons == 0) {
+			return scene;
+		}
+		delete scene;
+		scene = OffScene::fromMesh(mesh, abort);
+		scene->setCleanReport(report);
+		return scene;
+	} else if (binaryOff) {
+		OffBinaryReader::read(file, &mesh, abort);
+	} else if (ext == "stl") {
+		StlReader::read(file, &mesh, abort);
+	} else if (ext == "ply") {
+		PlyReader::read(file, &mesh, abort);
+	} else if (ext == "obj") {
+		ObjReader::read(file, &mesh, abort);
+	} else if (ext == "ofq") {
+		QuantizedFile::read(file, &mesh, abort);
 	} else {
 		throw QString(tr("File format not supported!"));
 	}
+
+	if (!clean) {
+		// Every STL triangle has its own corners, the shared ones are always welded
+		if (ext == "stl") {
+			VertexWelder::weld(&mesh);
+		}
+		return OffScene::fromMesh(mesh, abort);
+	}
+	VertexWelder::Report report = VertexWelder::clean(&mesh, tolerance);
+	OffScene *scene = OffScene::fromMesh(mesh, abort);
+	scene->setCleanReport(report);
+	return scene;
+}
+
+QString SceneFactory::describe(const LoadOptions & options)
+{
+	if (!options.weldVertices) {
+		return QString();
+	}
+	return "weld " + QString::number(double(options.weldTolerance), 'g', 9);
+}
+
+bool SceneFactory::isTileFile(QString file)
+{
+	return QFileInfo(file).suffix() == "oft";
+}
+
+TileFile* SceneFactory::openTileFile(QString file)
+{
+	if (!QFileInfo(file).exists()) {
+		throw QString(tr("File does not exist!"));
+	}
+
+	return new TileFile(file);
 }
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "IScene.h"
+#include "TileFile.h"
+#include "LoadTimings.h"
 
 /**
  * @brief Class for format independent file loading
@@ -16,6 +18,23 @@ class SceneFactory
 	Q_DECLARE_TR_FUNCTIONS(SceneFactory)
 
 public:
+	/**
+	 * @brief Options which change the loaded scenes
+	 *
+	 * SceneFactory::LoadOptions() loads the files unchanged.
+	 */
+	struct LoadOptions
+	{
+		/**
+		 * @brief Merge close vertices and remove broken polygons, see VertexWelder::clean()
+		 */
+		bool weldVertices;
+
+		/**
+		 * @brief Maximum distance of merged vertices, 0 for identical ones
+		 */
+		float weldTolerance;
+	};
 
 	/**
 	 * @brief Getter for the filter string
@@ -27,6 +46,15 @@ public:
 	 */
 	static QString openFileString();
 
+	/**
+	 * @brief Getter for the name filters of all supported files
+	 *
+	 * Used to find the files of a folder that can be opened.
+	 *
+	 * @return Returns wildcards like "*.off" for QDir
+	 */
+	static QStringList nameFilters();
+
 	/**
 	 * @brief Loads a file into memory
 	 *
@@ -36,8 +64,46 @@ public:
 	 * or else we are not able to return a reference to a scene object!
 	 * This method will throw a string if somethings goes wrong!
 	 *
-	 * @param [in] file Path to the file which should be parsed
+	 * @param [in] file Path to the file which should be parsed, "-" reads OFF from stdin
+	 * @param [in] options Changes applied to the scene, stdin is always read unchanged
+	 * @param [in] showProgress Show a progress dialog, must be false without
+	 * 				a QApplication or outside of the GUI thread
+	 * @param [out] timings Receives the time of the loading phases, may be null
+	 * @param [in] abort Cancels the loading from another thread if set, may be null
 	 * @return Returns a pointer to an scene object, see IScene
 	 */
-	static IScene* openFile(QString file);
+	static IScene* openFile(QString file, const LoadOptions & options, bool showProgress = true,
+		LoadTimings *timings = nullptr, const QAtomicInt *abort = nullptr);
+
+	/**
+	 * @brief Describes options which change the loaded scenes
+	 *
+	 * Scenes loaded with other options must not be reused, so caches
+	 * include this text in their keys.
+	 *
+	 * @param [in] options The options
+	 * @return An empty string for the default options
+	 */
+	static QString describe(const LoadOptions & options);
+
+	/**
+	 * @brief Checks if a file is a tiled scene for out-of-core rendering
+	 *
+	 * Tiled scenes can not be loaded into memory. They are opened with
+	 * openTileFile() instead of openFile().
+	 *
+	 * @param [in] file Path to the file
+	 * @return True, if the file should be opened with openTileFile()
+	 */
+	static bool isTileFile(QString file);
+
+	/**
+	 * @brief Opens a tiled scene
+	 *
+	 * This method will throw a string if somethings goes wrong!
+	 *
+	 * @param [in] file Path to the tile file
+	 * @return Returns a pointer to the opened tile file
+	 */
+	static TileFile* openTileFile(QString file);
 };
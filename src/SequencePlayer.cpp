@@ -0,0 +1,186 @@
+#include <QtConcurrent>
+
+#include "SequencePlayer.h"
+#include "Trace.h"
+
+SequencePlayer::SequencePlayer(GlWidget *widget, QObject *parent)
+	: QObject(parent)
+{
+	this->widget = widget;
+	scene = nullptr;
+	framesPerSecond = 30;
+	startPosition = 0;
+	shownPosition = 0;
+	dropped = 0;
+	pool.setMaxThreadCount(qMax(1, QThread::idealThreadCount() - 1));
+	timer.setTimerType(Qt::PreciseTimer);
+	connect(&timer, SIGNAL(timeout()), this, SLOT(tick()));
+}
+
+SequencePlayer::~SequencePlayer()
+{
+	stop();
+}
+
+QStringList SequencePlayer::findSequence(const QString & file)
+{
+	QFileInfo info(file);
+
+	// The frame number is the last number in the name
+	QRegularExpression numbered("^(.*?)(\\d+)(\\D*)$");
+	QRegularExpressionMatch match = numbered.match(info.fileName());
+	if (!match.hasMatch()) {
+		return QStringList();
+	}
+	QString prefix = match.captured(1);
+	QString suffix = match.captured(3);
+	QRegularExpression frame("^" + QRegularExpression::escape(prefix) + "(\\d+)" +
+		QRegularExpression::escape(suffix) + "$");
+
+	QDir folder = info.absoluteDir();
+	QStringList names = folder.entryList(QStringList(prefix + "*" + suffix), QDir::Files);
+	QMap<qint64, QString> sorted;
+	for (int i = 0; i < names.size(); i++) {
+		match = frame.match(names[i]);
+		if (match.hasMatch()) {
+			sorted.insert(match.captured(1).toLongLong(), folder.filePath(names[i]));
+		}
+	}
+
+	if (sorted.size() < 2) {
+		return QStringList();
+	}
+	return sorted.values();
+}
+
+void SequencePlayer::start(OffScene *scene, const QStringList & frames, int first,
+	double framesPerSecond)
+{
+	stop();
+	this->scene = scene;
+	this->frames = frames;
+	this->framesPerSecond = framesPerSecond;
+	startPosition = first;
+	shownPosition = first;
+	dropped = 0;
+	shownTimes.clear();
+	clock.start();
+	schedule(first);
+
+	// Several checks per frame keep the delay of a due frame small
+	timer.start(qMax(1, int(250 / framesPerSecond)));
+}
+
+void SequencePlayer::stop()
+{
+	timer.stop();
+	for (int i = 0; i < ring.size(); i++) {
+		ring[i].abort->store(1);
+	}
+	ring.clear();
+
+	// Canceled workers may still read the polygons of the scene
+	pool.waitForDone();
+	scene = nullptr;
+}
+
+bool SequencePlayer::isPlaying() const
+{
+	return scene != nullptr;
+}
+
+const OffScene* SequencePlayer::playedScene() const
+{
+	return scene;
+}
+
+void SequencePlayer::tick()
+{
+	TRACE_ZONE("SequencePlayer::tick");
+	qint64 now = clock.nsecsElapsed();
+	qint64 due = startPosition + qint64(now * framesPerSecond / 1000000000.0);
+
+	// The newest frame that is read and due is shown, older ones are skipped
+	int newest = -1;
+	for (int i = 0; i < ring.size() && ring[i].position <= due; i++) {
+		if (ring[i].future.isFinished()) {
+			newest = i;
+		}
+	}
+
+	if (newest >= 0) {
+		Slot slot = ring[newest];
+		for (int i = 0; i < newest; i++) {
+			ring[i].abort->store(1);
+		}
+		ring.erase(ring.begin(), ring.begin() + newest + 1);
+
+		Loaded loaded = slot.future.result();
+		if (!loaded.valid) {
+			QString file = frames[slot.position % frames.size()];
+			stop();
+			emit failed(file, loaded.error);
+			return;
+		}
+
+		emit sceneAboutToChange(scene);
+		scene->applyUpdate(loaded.update);
+		widget->updateSceneVertices(scene);
+		dropped += slot.position - shownPosition - 1;
+		shownPosition = slot.position;
+
+		shownTimes.append(now);
+		while (shownTimes.first() < now - 1000000000) {
+			shownTimes.removeFirst();
+		}
+		double seconds = qMin(now, qint64(1000000000)) / 1000000000.0;
+		emit frameShown(slot.position % frames.size(), frames.size(),
+			seconds > 0 ? shownTimes.size() / seconds : 0.0, dropped);
+	}
+
+	schedule(due);
+}
+
+void SequencePlayer::schedule(qint64 due)
+{
+	// Frames which are late and still read would only be skipped
+	for (int i = ring.size() - 1; i >= 0; i--) {
+		if (ring[i].position < due && !ring[i].future.isFinished()) {
+			ring[i].abort->store(1);
+			ring.removeAt(i);
+		}
+	}
+
+	qint64 next = ring.isEmpty() ? qMax(shownPosition + 1, due) : ring.last().position + 1;
+	while (ring.size() < ringSize) {
+		Slot slot;
+		slot.position = next++;
+		slot.abort = QSharedPointer<QAtomicInt>(new QAtomicInt(0));
+
+		QSharedPointer<QAtomicInt> abort = slot.abort;
+		const OffScene *played = scene;
+		QString file = frames[slot.position % frames.size()];
+		slot.future = QtConcurrent::run(&pool, [played, file, abort]() {
+			return load(played, file, abort.data());
+		});
+		ring.append(slot);
+	}
+}
+
+SequencePlayer::Loaded SequencePlayer::load(const OffScene *scene, const QString & file,
+	const QAtomicInt *abort)
+{
+	TRACE_ZONE("SequencePlayer::load");
+	Loaded loaded;
+	loaded.valid = false;
+	try {
+		loaded.valid = scene->readUpdate(file, &loaded.update, abort);
+		if (!loaded.valid && !abort->load()) {
+			loaded.error = tr("The frame has other polygons than the played scene!");
+		}
+	}
+	catch (QString & message) {
+		loaded.error = message;
+	}
+	return loaded;
+}
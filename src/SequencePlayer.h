@@ -0,0 +1,190 @@
+#pragma once
+
+#include <QtCore>
+#include <QFuture>
+
+#include "OffScene.h"
+#include "GlWidget.h"
+
+/**
+ * @brief Plays a sequence of OFF files with the same topology
+ *
+ * Animations are often exported as numbered files like frame_0001.off,
+ * frame_0002.off and so on, which all have the same polygons. Only the
+ * first frame is loaded as scene. The following frames are read with
+ * OffScene::readUpdate() by several worker threads, which stay a few
+ * frames ahead of the playback. The frames that are read form a ring,
+ * a finished frame waits there until it is due.
+ *
+ * The playback follows the clock. If a frame is not read when the next
+ * one is due, it is skipped and counted as dropped. The sequence starts
+ * again after the last frame.
+ *
+ * The player changes the vertices of the scene. The caller must stop it
+ * before the scene is deleted or displayed otherwise.
+ *
+ * @see OffScene::readUpdate()
+ * @see GlWidget::updateSceneVertices()
+ */
+class SequencePlayer : public QObject
+{
+	Q_OBJECT
+
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param [in] widget Widget that displays the scene
+	 * @param [in] parent Parent object
+	 */
+	SequencePlayer(GlWidget *widget, QObject *parent = nullptr);
+
+	/**
+	 * @brief Destructor, stops the playback
+	 */
+	~SequencePlayer();
+
+	/**
+	 * @brief Returns the frames of the sequence a file belongs to
+	 *
+	 * The frames are the files in the same folder whose names only differ
+	 * in the last number, sorted by this number.
+	 *
+	 * @param [in] file Path to one frame
+	 * @return Paths of all frames or an empty list if there are less than two
+	 */
+	static QStringList findSequence(const QString & file);
+
+	/**
+	 * @brief Starts the playback
+	 *
+	 * @param [in] scene The scene of one frame, displayed by the widget,
+	 *             loaded without options that change the vertices
+	 * @param [in] frames Paths of all frames
+	 * @param [in] first Index of the frame of the scene
+	 * @param [in] framesPerSecond Target frame rate
+	 */
+	void start(OffScene *scene, const QStringList & frames, int first,
+		double framesPerSecond);
+
+	/**
+	 * @brief Stops the playback and waits for the worker threads
+	 *
+	 * The scene keeps the vertices of the last shown frame.
+	 */
+	void stop();
+
+	/**
+	 * @brief Is a sequence played?
+	 */
+	bool isPlaying() const;
+
+	/**
+	 * @brief Returns the scene that is played or null
+	 */
+	const OffScene* playedScene() const;
+
+signals:
+	/**
+	 * @brief The vertices of the played scene are replaced by the next frame
+	 *
+	 * Receivers must stop everything that reads the scene in other threads.
+	 */
+	void sceneAboutToChange(const IScene *scene);
+
+	/**
+	 * @brief A frame was shown
+	 *
+	 * @param [in] frame Index of the frame
+	 * @param [in] frames Number of frames
+	 * @param [in] framesPerSecond Frames shown during the last second
+	 * @param [in] dropped Number of skipped frames since the start
+	 */
+	void frameShown(int frame, int frames, double framesPerSecond, int dropped);
+
+	/**
+	 * @brief A frame could not be read, the playback was stopped
+	 */
+	void failed(const QString & file, const QString & message);
+
+private slots:
+	/**
+	 * @brief Shows the newest due frame and reads the next ones
+	 */
+	void tick();
+
+private:
+	/**
+	 * @brief A frame read by a worker thread
+	 */
+	struct Loaded
+	{
+		bool valid;
+		OffScene::Update update;
+		QString error;
+	};
+
+	/**
+	 * @brief A frame in the ring
+	 *
+	 * The position counts the frames since the start, so it keeps
+	 * growing when the sequence starts again.
+	 */
+	struct Slot
+	{
+		qint64 position;
+		QSharedPointer<QAtomicInt> abort;
+		QFuture<Loaded> future;
+	};
+
+	/**
+	 * @brief Reads the vertices and colors of a frame, runs in the background
+	 */
+	static Loaded load(const OffScene *scene, const QString & file, const QAtomicInt *abort);
+
+	/**
+	 * @brief Fills the ring with the frames after the shown one
+	 *
+	 * @param [in] due Position of the frame that is due now
+	 */
+	void schedule(qint64 due);
+
+	/**
+	 * @brief Number of frames that are read ahead of the playback
+	 */
+	static const int ringSize = 8;
+
+	GlWidget *widget;
+	OffScene *scene;
+	QStringList frames;
+	double framesPerSecond;
+
+	/**
+	 * @brief Position of the first frame, at the start of the clock
+	 */
+	qint64 startPosition;
+
+	/**
+	 * @brief Position of the shown frame
+	 */
+	qint64 shownPosition;
+
+	int dropped;
+	QElapsedTimer clock;
+	QTimer timer;
+
+	/**
+	 * @brief The frames that are read or wait to be shown, in the order of their positions
+	 */
+	QList<Slot> ring;
+
+	/**
+	 * @brief Times in nanoseconds at which the frames of the last second were shown
+	 */
+	QList<qint64> shownTimes;
+
+	/**
+	 * @brief Reads the frames, one thread is left for the rendering
+	 */
+	QThreadPool pool;
+};
@@ -1,14 +1,12 @@
 #include <QtOpenGL>
 #include "ShadedMode.h"
+#include "Trace.h"
 
 ShadedMode::ShadedMode(bool smoothShaded, bool colored, bool specular)
 {
 	this->smoothShaded = smoothShaded;
 	this->colored = colored;
 	this->specular = specular;
-	
-	oldScene = 0;
-	displayList = 0;
 }
 
 void ShadedMode::setSettings()
@@ -30,15 +28,20 @@ void ShadedMode::unsetSettings()
 	glDisable(GL_NORMALIZE);
 }
 
-void ShadedMode::draw(const IScene *scene, const QColor *color)
-{	
-	// If the scene or the color has changed, we need to create an new display list
-	if (displayList == 0 || oldScene != scene || oldColor != *color) {
-		createDisplayList(scene, color);
-		oldScene = scene;
-		oldColor = *color;
+void ShadedMode::draw(const GeometryBuffer *geometry, const QVector<int> & parts,
+	const QColor *color)
+{
+	TRACE_ZONE("ShadedMode::draw");
+	// Uncolored geometry uses the current color for all vertices
+	if (!geometry->hasColors()) {
+		glColor4f(
+			color->redF(),
+			color->greenF(),
+			color->blueF(),
+			color->alphaF()
+		);
 	}
-	
+
 	// Specular settings
 	if (specular) {
 		const float specularColor[] = { 1.0, 1.0, 1.0, 1.0 };
@@ -61,61 +64,92 @@ void ShadedMode::draw(const IScene *scene, const QColor *color)
 
 	// Turn on the light only for the object on
 	glEnable(GL_LIGHTING);
-	glCallList(displayList);
+	geometry->draw(parts);
 	glDisable(GL_LIGHTING);
 }
 
-void ShadedMode::createDisplayList(const IScene *scene, const QColor *color)
+void ShadedMode::render(SoftwareRenderer *renderer, const RenderGeometry *geometry,
+	const QVector<int> & parts, const QColor *color) const
+{
+	TRACE_ZONE("ShadedMode::render");
+	renderer->setDepthTest(true);
+	renderer->setBlending(true);
+	renderer->setLighting(true, specular);
+	renderer->setColor(*color);
+	renderer->draw(geometry, parts);
+	renderer->setLighting(false, false);
+}
+
+RenderGeometry::Primitive ShadedMode::primitive() const
+{
+	return RenderGeometry::Triangles;
+}
+
+bool ShadedMode::geometryUsesDefaultColor() const
 {
-	displayList = glGenLists(1);
-	glNewList(displayList, GL_COMPILE);
-		int cp = scene->polygonsCount();
-		for(int i=0; i<cp; i++) {
-			const CPolygon *poly = scene->polygon(i);
+	return colored;
+}
+
+RenderGeometry* ShadedMode::createGeometry(const IScene *scene, const SceneBvh *bvh,
+	const QColor *color) const
+{
+	TRACE_ZONE("ShadedMode::createGeometry");
+	QColor defaultColor = *color;
+
+	return RenderGeometry::fromPolygons(scene, bvh, RenderGeometry::Triangles, true, colored,
+		[](const CPolygon *poly) {
+			int cv = static_cast<int>(poly->vertexCount());
+			return cv >= 3 ? 3 * (cv - 2) : 0;
+		},
+		[this, defaultColor](const CPolygon *poly) {
+			if (!colored) {
+				return false;
+			}
 			size_t cv = poly->vertexCount();
-			const float *nv = 0;
-			if (!smoothShaded) {
-				nv = poly->normal();
+			for(size_t j=0; j<cv; j++) {
+				const CVertex *vert = poly->vertex(j);
+				const QColor & c = vert->isColored() ? vert->color()
+					: (poly->isColored() ? poly->color() : defaultColor);
+				if (c.alpha() < 255) {
+					return true;
+				}
 			}
-			glBegin( GL_POLYGON );
-				for(size_t j=0; j<cv; j++) {
-					const CVertex *vert = poly->vertex(j);
+			return false;
+		},
+		[this, defaultColor](const CPolygon *poly, RenderGeometry *geometry, int first) {
+			float *positions = geometry->positions() + 3 * first;
+			float *normals = geometry->normals() + 3 * first;
+			quint8 *colors = colored ? geometry->colors() + 4 * first : nullptr;
+
+			// Split the polygon into a triangle fan like GL_POLYGON does
+			size_t cv = poly->vertexCount();
+			for(size_t t=1; t+1<cv; t++) {
+				const size_t corners[3] = { 0, t, t + 1 };
+				for(int k=0; k<3; k++) {
+					const CVertex *vert = poly->vertex(corners[k]);
 					const float *data = vert->vertex();
+					positions[0] = data[0];
+					positions[1] = data[1];
+					positions[2] = data[2];
+					RenderGeometry::normalize(smoothShaded ? vert->normal() : poly->normal(), normals);
+					positions += 3;
+					normals += 3;
 
-					// If the vertex is colored, this overrides all other colors
-					if (colored && vert->isColored()) {
-						glColor4f(
-							vert->color().redF(),
-							vert->color().greenF(),
-							vert->color().blueF(),
-							vert->color().alphaF()
-						);
-					// A polygon color is replacing the default object color
-					} else if (colored && poly->isColored()) {
-						glColor4f(
-							poly->color().redF(),
-							poly->color().greenF(),
-							poly->color().blueF(),
-							poly->color().alphaF()
-						);
-					// The default color is our failsafe fallback solution :)
-					} else {
-						glColor4f(
-							color->redF(),
-							color->greenF(),
-							color->blueF(),
-							color->alphaF()
-						);
-					}
-					
-					if (smoothShaded) {
-						nv = vert->normal();
+					if (colored) {
+						// If the vertex is colored, this overrides all other colors
+						if (vert->isColored()) {
+							RenderGeometry::writeColor(vert->color(), colors);
+						// A polygon color is replacing the default object color
+						} else if (poly->isColored()) {
+							RenderGeometry::writeColor(poly->color(), colors);
+						// The default color is our failsafe fallback solution :)
+						} else {
+							RenderGeometry::writeColor(defaultColor, colors);
+						}
+						colors += 4;
 					}
-					glNormal3fv(nv);
-					glVertex3fv(data); 
 				}
-			glEnd();
+			}
 		}
-	
-	glEndList ();
+	);
 }
@@ -37,49 +37,53 @@ public:
 	void unsetSettings() override;
 
 	/**
-	 * @brief Draws a flat or smooth shaded IScene object
+	 * @brief Creates flat or smooth shaded triangles
 	 *
-	 * This is an implenentation of IRenderMode::draw() with an additional
-	 * parameter to control the shading. To use it, you can
-	 * inherit a new render mode from this class and delegate draw() to
-	 * this method!
+	 * Each polygon is split into a triangle fan. Depending on the settings
+	 * of the constructor the triangles get the normal vector of the polygon
+	 * or of their vertices. Only the colored mode stores vertex colors,
+	 * polygons with translucent colors are put into the translucent ranges.
 	 *
 	 * @param [in] scene The scene which should be drawn
+	 * @param [in] bvh The polygon hierarchy of the scene
 	 * @param [in] defaultColor The default scene color
+	 * @return The new geometry
 	 */
-	void draw(const IScene *scene, const QColor *defaultColor) override;
-	
-private:
-	/**
-	 * @brief Creates a display list for the object 
-	 *
-	 * To get more perfomance out of OpenGL we use the display list
-	 * feature. This can create a precompiled list of OpenGL commands
-	 * which can be drawn much faster than with the normal immediate mode.
-	 * The refenece number for the display list will be stored in the
-	 * object variable displayList.
-	 *
-	 * @see ShadedMode::displayList
-	 * @param [in] scene The scene which should be drawn
-	 * @param [in] color Default model color
-	 */
-	void createDisplayList(const IScene *scene, const QColor *color);
+	RenderGeometry* createGeometry(const IScene *scene, const SceneBvh *bvh,
+		const QColor *defaultColor) const override;
 
-	/**
-	 * @brief Stores the display list identifier
-	 */
-	unsigned int displayList;
+	RenderGeometry::Primitive primitive() const override;
+
+	bool geometryUsesDefaultColor() const override;
 
 	/**
-	 * @brief Used to determine whether the scene has changed
+	 * @brief Draws a flat or smooth shaded IScene object
+	 *
+	 * This is an implenentation of IRenderMode::draw() which sets up the
+	 * lighting. To use it, you can inherit a new render mode from this
+	 * class and call the constructor with the right settings!
+	 *
+	 * @param [in] geometry The uploaded geometry of the scene
+	 * @param [in] parts The visible parts
+	 * @param [in] defaultColor The default scene color
 	 */
-	const IScene *oldScene;
+	void draw(const GeometryBuffer *geometry, const QVector<int> & parts,
+		const QColor *defaultColor) override;
 
 	/**
-	 * @brief Used to determine whether the color has changed
+	 * @brief Draws a flat or smooth shaded IScene object without OpenGL
+	 *
+	 * Uses the same light and material settings as draw().
+	 *
+	 * @param [in] renderer The software renderer
+	 * @param [in] geometry The geometry of the scene
+	 * @param [in] parts The visible parts
+	 * @param [in] defaultColor The default scene color
 	 */
-	QColor oldColor;
+	void render(SoftwareRenderer *renderer, const RenderGeometry *geometry,
+		const QVector<int> & parts, const QColor *defaultColor) const override;
 	
+private:
 	/**
 	 * @brief Smooth shading or flat shading?
 	 */
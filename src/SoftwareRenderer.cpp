@@ -0,0 +1,659 @@
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OFFVIEW_SSE2
+#include <emmintrin.h>
+#endif
+
+#include "SoftwareRenderer.h"
+#include "Parallel.h"
+#include "Trace.h"
+
+SoftwareRenderer::SoftwareRenderer()
+{
+	tilesX = 0;
+	tilesY = 0;
+	pixels = nullptr;
+	stride = 0;
+
+	for (int i = 0; i < 9; i++) {
+		normalMatrix[i] = (i % 4 == 0) ? 1.0f : 0.0f;
+	}
+
+	for (int k = 0; k < 4; k++) {
+		clipEquation[k] = clipPlane[k] = 0.0f;
+	}
+	clipping = false;
+
+	color[0] = color[1] = color[2] = color[3] = 1.0f;
+	lighting = false;
+	specular = false;
+	blending = false;
+	depthTest = false;
+	pointSize = 1.0f;
+	lineWidth = 1.0f;
+}
+
+void SoftwareRenderer::resize(int width, int height)
+{
+	width = qMax(1, width);
+	height = qMax(1, height);
+	if (target.width() == width && target.height() == height) {
+		return;
+	}
+
+	target = QImage(width, height, QImage::Format_RGB32);
+	depth.resize(width * height);
+	tilesX = (width + tileSize - 1) / tileSize;
+	tilesY = (height + tileSize - 1) / tileSize;
+}
+
+const QImage & SoftwareRenderer::image() const
+{
+	return target;
+}
+
+void SoftwareRenderer::clear(const QColor & color)
+{
+	target.fill(color.rgb());
+	depth.fill(1.0f);
+}
+
+void SoftwareRenderer::setMatrices(const QMatrix4x4 & projection, const QMatrix4x4 & modelView)
+{
+	modelViewProjection = projection * modelView;
+
+	// Same as the inverse transposed upper 3x3 matrix OpenGL uses for normals
+	QMatrix3x3 normals = modelView.normalMatrix();
+	for (int i = 0; i < 9; i++) {
+		normalMatrix[i] = normals.constData()[i];
+	}
+
+	if (clipping) {
+		setClipPlane(clipEquation);
+	}
+}
+
+void SoftwareRenderer::setColor(const QColor & color)
+{
+	this->color[0] = color.redF();
+	this->color[1] = color.greenF();
+	this->color[2] = color.blueF();
+	this->color[3] = color.alphaF();
+}
+
+void SoftwareRenderer::setLighting(bool enabled, bool specular)
+{
+	lighting = enabled;
+	this->specular = specular;
+}
+
+void SoftwareRenderer::setBlending(bool enabled)
+{
+	blending = enabled;
+}
+
+void SoftwareRenderer::setDepthTest(bool enabled)
+{
+	depthTest = enabled;
+}
+
+void SoftwareRenderer::setPointSize(float size)
+{
+	pointSize = size;
+}
+
+void SoftwareRenderer::setLineWidth(float width)
+{
+	lineWidth = width;
+}
+
+void SoftwareRenderer::setClipPlane(const float *equation)
+{
+	clipping = equation != nullptr;
+	if (!clipping) {
+		return;
+	}
+
+	// A plane is transformed with the inverse matrix, as row vector
+	QMatrix4x4 inverse = modelViewProjection.inverted();
+	for (int k = 0; k < 4; k++) {
+		clipEquation[k] = equation[k];
+	}
+	for (int c = 0; c < 4; c++) {
+		clipPlane[c] = 0.0f;
+		for (int r = 0; r < 4; r++) {
+			clipPlane[c] += clipEquation[r] * inverse(r, c);
+		}
+	}
+}
+
+void SoftwareRenderer::draw(const RenderGeometry *geometry, const QVector<int> & parts)
+{
+	TRACE_ZONE("SoftwareRenderer::draw");
+
+	if (target.isNull() || geometry->verticesCount() == 0) {
+		return;
+	}
+
+	int verticesPerPrimitive = 3;
+	if (geometry->primitive() == RenderGeometry::Points) {
+		verticesPerPrimitive = 1;
+	} else if (geometry->primitive() == RenderGeometry::Lines) {
+		verticesPerPrimitive = 2;
+	}
+
+	// Collect the first vertex of each primitive, opaque ranges before
+	// translucent ones by alpha level, and draw them whenever a batch is full
+	QVector<int> batch(batchSize);
+	int count = 0;
+	for (int pass = 0; pass <= geometry->alphaLevelsCount(); pass++) {
+		for (int i = 0; i <= parts.size(); i++) {
+			int index = (i < parts.size()) ? parts[i] : geometry->rangesCount() - 1;
+			const RenderGeometry::Range & range = (pass == 0)
+				? geometry->opaqueRange(index) : geometry->translucentRange(index, pass - 1);
+
+			int end = range.first + range.count;
+			for (int v = range.first; v + verticesPerPrimitive <= end; v += verticesPerPrimitive) {
+				batch[count++] = v;
+				if (count == batchSize) {
+					drawBatch(geometry, batch.constData(), count);
+					count = 0;
+				}
+			}
+		}
+	}
+
+	if (count > 0) {
+		drawBatch(geometry, batch.constData(), count);
+	}
+}
+
+void SoftwareRenderer::drawBatch(const RenderGeometry *geometry, const int *primitives, int count)
+{
+	// Detach the image once here, the threads only write through the pointer
+	pixels = reinterpret_cast<quint32*>(target.bits());
+	stride = target.bytesPerLine() / 4;
+
+	const int minSetupBlock = 4096;
+	QVector<Bin> bins(Parallel::blockCount(count, minSetupBlock));
+	Bin *binData = bins.data();
+	Parallel::forEachBlock(count, minSetupBlock, [&](int block, int begin, int end) {
+		Bin *bin = binData + block;
+		bin->tiles.resize(tilesX * tilesY);
+		for (int i = begin; i < end; i++) {
+			setupPrimitive(geometry, primitives[i], bin);
+		}
+	});
+
+	// The tiles do not overlap, so they can be rasterized without locking
+	Parallel::forBlocks(tilesX * tilesY, 1, [&](int begin, int end) {
+		for (int tile = begin; tile < end; tile++) {
+			rasterTile(tile, bins);
+		}
+	});
+}
+
+void SoftwareRenderer::setupPrimitive(const RenderGeometry *geometry, int first, Bin *bin) const
+{
+	const float *positions = geometry->positions();
+
+	if (geometry->primitive() == RenderGeometry::Triangles) {
+		ClipVertex vertices[3];
+		for (int i = 0; i < 3; i++) {
+			transform(positions + 3 * (first + i), vertices[i].position);
+		}
+		if (outsideFrustum(vertices, 3)) {
+			return;
+		}
+
+		// The sign of the homogeneous determinant is the winding in normalized
+		// device coordinates, even for vertices behind the camera
+		const float *p0 = vertices[0].position;
+		const float *p1 = vertices[1].position;
+		const float *p2 = vertices[2].position;
+		float determinant =
+			p0[0] * (p1[1] * p2[3] - p1[3] * p2[1]) -
+			p0[1] * (p1[0] * p2[3] - p1[3] * p2[0]) +
+			p0[3] * (p1[0] * p2[1] - p1[1] * p2[0]);
+		bool backFace = determinant < 0.0f;
+
+		for (int i = 0; i < 3; i++) {
+			shade(geometry, first + i, backFace, vertices[i].color);
+		}
+
+		// The clipping plane and the near plane add one corner each
+		const float nearPlane[4] = { 0.0f, 0.0f, 1.0f, 1.0f };
+		ClipVertex cut[4];
+		ClipVertex clipped[5];
+		int clippedCount;
+		if (clipping) {
+			int cutCount = clipPolygon(vertices, 3, clipPlane, cut);
+			clippedCount = clipPolygon(cut, cutCount, nearPlane, clipped);
+		} else {
+			clippedCount = clipPolygon(vertices, 3, nearPlane, clipped);
+		}
+		if (clippedCount < 3) {
+			return;
+		}
+
+		ScreenVertex screen[5];
+		for (int i = 0; i < clippedCount; i++) {
+			screen[i] = project(clipped[i]);
+		}
+		for (int i = 2; i < clippedCount; i++) {
+			addTriangle(screen[0], screen[i - 1], screen[i], bin);
+		}
+	} else if (geometry->primitive() == RenderGeometry::Lines) {
+		ClipVertex vertices[2];
+		for (int i = 0; i < 2; i++) {
+			transform(positions + 3 * (first + i), vertices[i].position);
+		}
+		if (outsideFrustum(vertices, 2)) {
+			return;
+		}
+		for (int i = 0; i < 2; i++) {
+			shade(geometry, first + i, false, vertices[i].color);
+		}
+
+		// Move the ends behind the clipping plane and the near plane onto the planes
+		const float nearPlane[4] = { 0.0f, 0.0f, 1.0f, 1.0f };
+		for (int p = clipping ? 0 : 1; p < 2; p++) {
+			const float *plane = (p == 0) ? clipPlane : nearPlane;
+			float d0 = distance(vertices[0], plane);
+			float d1 = distance(vertices[1], plane);
+			if (d0 < 0.0f && d1 < 0.0f) {
+				return;
+			}
+			if (d0 < 0.0f || d1 < 0.0f) {
+				int outside = (d0 < 0.0f) ? 0 : 1;
+				float t = d0 / (d0 - d1);
+				ClipVertex moved;
+				interpolate(vertices[0], vertices[1], t, &moved);
+				vertices[outside] = moved;
+			}
+		}
+
+		// Wide lines are drawn as a rectangle around the segment
+		ScreenVertex a = project(vertices[0]);
+		ScreenVertex b = project(vertices[1]);
+		float dx = b.x - a.x;
+		float dy = b.y - a.y;
+		float length = std::sqrt(dx * dx + dy * dy);
+		if (length <= 0.0f) {
+			return;
+		}
+		float nx = -dy / length * 0.5f * lineWidth;
+		float ny = dx / length * 0.5f * lineWidth;
+
+		ScreenVertex corners[4] = { a, b, b, a };
+		corners[0].x += nx; corners[0].y += ny;
+		corners[1].x += nx; corners[1].y += ny;
+		corners[2].x -= nx; corners[2].y -= ny;
+		corners[3].x -= nx; corners[3].y -= ny;
+		addTriangle(corners[0], corners[1], corners[2], bin);
+		addTriangle(corners[0], corners[2], corners[3], bin);
+	} else {
+		ClipVertex vertex;
+		transform(positions + 3 * first, vertex.position);
+
+		// Points are clipped by their center like in OpenGL
+		const float *p = vertex.position;
+		if (p[0] < -p[3] || p[0] > p[3] || p[1] < -p[3] || p[1] > p[3] ||
+			p[2] < -p[3] || p[2] > p[3] || (clipping && distance(vertex, clipPlane) < 0.0f)) {
+			return;
+		}
+		shade(geometry, first, false, vertex.color);
+
+		ScreenVertex center = project(vertex);
+		float half = 0.5f * pointSize;
+		ScreenVertex corners[4] = { center, center, center, center };
+		corners[0].x -= half; corners[0].y -= half;
+		corners[1].x += half; corners[1].y -= half;
+		corners[2].x += half; corners[2].y += half;
+		corners[3].x -= half; corners[3].y += half;
+		addTriangle(corners[0], corners[1], corners[2], bin);
+		addTriangle(corners[0], corners[2], corners[3], bin);
+	}
+}
+
+void SoftwareRenderer::transform(const float *position, float *clip) const
+{
+	const float *m = modelViewProjection.constData();
+	for (int r = 0; r < 4; r++) {
+		clip[r] = m[r] * position[0] + m[4 + r] * position[1] + m[8 + r] * position[2] + m[12 + r];
+	}
+}
+
+void SoftwareRenderer::shade(const RenderGeometry *geometry, int index, bool backFace,
+	float *result) const
+{
+	if (geometry->hasColors()) {
+		const quint8 *c = geometry->colors() + 4 * index;
+		for (int k = 0; k < 4; k++) {
+			result[k] = c[k] / 255.0f;
+		}
+	} else {
+		for (int k = 0; k < 4; k++) {
+			result[k] = color[k];
+		}
+	}
+
+	if (!lighting || !geometry->hasNormals()) {
+		return;
+	}
+
+	// Only the z component is needed, the light shines along the z axis
+	// of the eye coordinates and the viewer is infinitely far away
+	const float *n = geometry->normals() + 3 * index;
+	float eye[3];
+	for (int r = 0; r < 3; r++) {
+		eye[r] = normalMatrix[r] * n[0] + normalMatrix[3 + r] * n[1] + normalMatrix[6 + r] * n[2];
+	}
+	float length = std::sqrt(eye[0] * eye[0] + eye[1] * eye[1] + eye[2] * eye[2]);
+	float nz = (length > 0.0f) ? eye[2] / length : 1.0f;
+	if (backFace) {
+		nz = -nz;
+	}
+
+	// Global ambient light of 0.2, white diffuse light and
+	// specular highlights with the settings of ShadedMode
+	float diffuse = qMax(0.0f, nz);
+	float highlight = (specular && diffuse > 0.0f) ? 0.5f * std::pow(diffuse, 50.0f) : 0.0f;
+	for (int k = 0; k < 3; k++) {
+		result[k] = qMin(1.0f, result[k] * (0.2f + diffuse) + highlight);
+	}
+}
+
+bool SoftwareRenderer::outsideFrustum(const ClipVertex *vertices, int count)
+{
+	// Trivial reject, if all vertices are outside of the same plane
+	for (int axis = 0; axis < 3; axis++) {
+		bool allBelow = true;
+		bool allAbove = true;
+		for (int i = 0; i < count; i++) {
+			const float *p = vertices[i].position;
+			allBelow = allBelow && p[axis] < -p[3];
+			allAbove = allAbove && p[axis] > p[3];
+		}
+		if (allBelow || allAbove) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void SoftwareRenderer::interpolate(const ClipVertex & a, const ClipVertex & b, float t,
+	ClipVertex *result)
+{
+	for (int k = 0; k < 4; k++) {
+		result->position[k] = a.position[k] + t * (b.position[k] - a.position[k]);
+		result->color[k] = a.color[k] + t * (b.color[k] - a.color[k]);
+	}
+}
+
+float SoftwareRenderer::distance(const ClipVertex & vertex, const float *plane)
+{
+	const float *p = vertex.position;
+	return plane[0] * p[0] + plane[1] * p[1] + plane[2] * p[2] + plane[3] * p[3];
+}
+
+int SoftwareRenderer::clipPolygon(const ClipVertex *input, int count, const float *plane,
+	ClipVertex *output)
+{
+	int result = 0;
+	for (int i = 0; i < count; i++) {
+		const ClipVertex & a = input[i];
+		const ClipVertex & b = input[(i + 1) % count];
+		float da = distance(a, plane);
+		float db = distance(b, plane);
+
+		if (da >= 0.0f) {
+			output[result++] = a;
+		}
+		if ((da >= 0.0f) != (db >= 0.0f)) {
+			interpolate(a, b, da / (da - db), &output[result++]);
+		}
+	}
+	return result;
+}
+
+SoftwareRenderer::ScreenVertex SoftwareRenderer::project(const ClipVertex & vertex) const
+{
+	ScreenVertex result;
+	float w = 1.0f / vertex.position[3];
+	result.x = (vertex.position[0] * w * 0.5f + 0.5f) * target.width();
+	result.y = (0.5f - vertex.position[1] * w * 0.5f) * target.height();
+	result.z = vertex.position[2] * w * 0.5f + 0.5f;
+	result.w = w;
+	for (int k = 0; k < 4; k++) {
+		result.color[k] = vertex.color[k];
+	}
+	return result;
+}
+
+void SoftwareRenderer::addTriangle(const ScreenVertex & a, const ScreenVertex & b,
+	const ScreenVertex & c, Bin *bin) const
+{
+	// Twice the signed area, the order is changed to make it positive
+	float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+	if (area == 0.0f || !std::isfinite(area)) {
+		return;
+	}
+	const ScreenVertex *v[3] = { &a, &b, &c };
+	if (area < 0.0f) {
+		v[1] = &c;
+		v[2] = &b;
+		area = -area;
+	}
+
+	Triangle triangle;
+	triangle.minX = qMax(0, static_cast<int>(std::floor(qMin(v[0]->x, qMin(v[1]->x, v[2]->x)))));
+	triangle.minY = qMax(0, static_cast<int>(std::floor(qMin(v[0]->y, qMin(v[1]->y, v[2]->y)))));
+	triangle.maxX = qMin(target.width() - 1,
+		static_cast<int>(std::ceil(qMax(v[0]->x, qMax(v[1]->x, v[2]->x)))));
+	triangle.maxY = qMin(target.height() - 1,
+		static_cast<int>(std::ceil(qMax(v[0]->y, qMax(v[1]->y, v[2]->y)))));
+	if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY) {
+		return;
+	}
+
+	// Edge i lies opposite of vertex i, its function is positive inside
+	// and reaches the doubled area at vertex i
+	for (int i = 0; i < 3; i++) {
+		const ScreenVertex *from = v[(i + 1) % 3];
+		const ScreenVertex *to = v[(i + 2) % 3];
+		float dx = to->x - from->x;
+		float dy = to->y - from->y;
+		triangle.edges[i][0] = -dy;
+		triangle.edges[i][1] = dx;
+		triangle.edges[i][2] = dy * from->x - dx * from->y;
+
+		// Pixels exactly on a shared edge belong to only one triangle
+		triangle.topLeft[i] = dy < 0.0f || (dy == 0.0f && dx > 0.0f);
+	}
+
+	// The barycentric weights are the edge functions divided by the area,
+	// so every attribute is a plane equation over the pixel coordinates
+	float plane[3];
+	auto makePlane = [&](float value0, float value1, float value2, float *result) {
+		for (int k = 0; k < 3; k++) {
+			result[k] = (value0 * triangle.edges[0][k] + value1 * triangle.edges[1][k] +
+				value2 * triangle.edges[2][k]) / area;
+		}
+	};
+	makePlane(v[0]->z, v[1]->z, v[2]->z, triangle.z);
+	makePlane(v[0]->w, v[1]->w, v[2]->w, triangle.w);
+	for (int k = 0; k < 4; k++) {
+		makePlane(v[0]->color[k] * v[0]->w, v[1]->color[k] * v[1]->w,
+			v[2]->color[k] * v[2]->w, plane);
+		for (int j = 0; j < 3; j++) {
+			triangle.color[k][j] = plane[j];
+		}
+	}
+
+	int index = bin->triangles.size();
+	bin->triangles.append(triangle);
+
+	// Skip tiles which lie completely outside of one edge
+	for (int ty = triangle.minY / tileSize; ty <= triangle.maxY / tileSize; ty++) {
+		float y0 = static_cast<float>(ty * tileSize);
+		float y1 = y0 + tileSize;
+		for (int tx = triangle.minX / tileSize; tx <= triangle.maxX / tileSize; tx++) {
+			float x0 = static_cast<float>(tx * tileSize);
+			float x1 = x0 + tileSize;
+
+			bool overlaps = true;
+			for (int i = 0; i < 3 && overlaps; i++) {
+				const float *e = triangle.edges[i];
+				float x = (e[0] > 0.0f) ? x1 : x0;
+				float y = (e[1] > 0.0f) ? y1 : y0;
+				overlaps = e[0] * x + e[1] * y + e[2] >= 0.0f;
+			}
+			if (overlaps) {
+				bin->tiles[ty * tilesX + tx].append(index);
+			}
+		}
+	}
+}
+
+void SoftwareRenderer::rasterTile(int tile, const QVector<Bin> & bins)
+{
+	int tileX = (tile % tilesX) * tileSize;
+	int tileY = (tile / tilesX) * tileSize;
+
+	for (int b = 0; b < bins.size(); b++) {
+		const Bin & bin = bins[b];
+		const QVector<int> & indices = bin.tiles[tile];
+		for (int t = 0; t < indices.size(); t++) {
+			const Triangle & triangle = bin.triangles[indices[t]];
+			int x0 = qMax(triangle.minX, tileX);
+			int x1 = qMin(triangle.maxX, tileX + tileSize - 1);
+			int y0 = qMax(triangle.minY, tileY);
+			int y1 = qMin(triangle.maxY, tileY + tileSize - 1);
+
+			for (int y = y0; y <= y1; y++) {
+				rasterSpan(triangle, x0, x1, y);
+			}
+		}
+	}
+}
+
+void SoftwareRenderer::rasterSpan(const Triangle & triangle, int x0, int x1, int y)
+{
+	float *depthRow = depth.data() + y * target.width();
+	float py = y + 0.5f;
+
+#ifdef OFFVIEW_SSE2
+	// Four neighbouring pixels are tested at once
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 offsets = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+
+	__m128 edgeRow[3];
+	__m128 edgeStep[3];
+	__m128 topLeft[3];
+	for (int i = 0; i < 3; i++) {
+		const float *e = triangle.edges[i];
+		edgeRow[i] = _mm_set1_ps(e[1] * py + e[2]);
+		edgeStep[i] = _mm_set1_ps(e[0]);
+		topLeft[i] = _mm_castsi128_ps(_mm_set1_epi32(triangle.topLeft[i] ? -1 : 0));
+	}
+	const __m128 zRow = _mm_set1_ps(triangle.z[1] * py + triangle.z[2]);
+	const __m128 zStep = _mm_set1_ps(triangle.z[0]);
+
+	for (int x = x0; x <= x1; x += 4) {
+		__m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), offsets);
+
+		__m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+		for (int i = 0; i < 3; i++) {
+			__m128 e = _mm_add_ps(_mm_mul_ps(edgeStep[i], px), edgeRow[i]);
+			__m128 covered = _mm_or_ps(_mm_cmpgt_ps(e, zero),
+				_mm_and_ps(_mm_cmpeq_ps(e, zero), topLeft[i]));
+			inside = _mm_and_ps(inside, covered);
+		}
+
+		__m128 z = _mm_add_ps(_mm_mul_ps(zStep, px), zRow);
+		inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmpge_ps(z, zero), _mm_cmple_ps(z, one)));
+
+		int mask = _mm_movemask_ps(inside);
+		if (x + 4 > x1 + 1) {
+			mask &= (1 << (x1 + 1 - x)) - 1;
+		}
+		if (!mask) {
+			continue;
+		}
+
+		float values[4];
+		_mm_storeu_ps(values, z);
+		for (int k = 0; k < 4; k++) {
+			if (!(mask & (1 << k))) {
+				continue;
+			}
+			float *stored = depthRow + x + k;
+			if (depthTest) {
+				if (!(values[k] < *stored)) {
+					continue;
+				}
+				*stored = values[k];
+			}
+			writePixel(triangle, x + k, y);
+		}
+	}
+#else
+	for (int x = x0; x <= x1; x++) {
+		float px = x + 0.5f;
+
+		bool inside = true;
+		for (int i = 0; i < 3 && inside; i++) {
+			const float *e = triangle.edges[i];
+			float value = e[0] * px + e[1] * py + e[2];
+			inside = value > 0.0f || (value == 0.0f && triangle.topLeft[i]);
+		}
+		if (!inside) {
+			continue;
+		}
+
+		float z = triangle.z[0] * px + triangle.z[1] * py + triangle.z[2];
+		if (z < 0.0f || z > 1.0f) {
+			continue;
+		}
+		if (depthTest) {
+			if (!(z < depthRow[x])) {
+				continue;
+			}
+			depthRow[x] = z;
+		}
+		writePixel(triangle, x, y);
+	}
+#endif
+}
+
+void SoftwareRenderer::writePixel(const Triangle & triangle, int x, int y)
+{
+	float px = x + 0.5f;
+	float py = y + 0.5f;
+
+	// Perspective correct colors
+	float w = 1.0f / (triangle.w[0] * px + triangle.w[1] * py + triangle.w[2]);
+	float c[4];
+	for (int k = 0; k < 4; k++) {
+		float value = (triangle.color[k][0] * px + triangle.color[k][1] * py + triangle.color[k][2]) * w;
+		c[k] = qBound(0.0f, value, 1.0f);
+	}
+
+	quint32 *pixel = pixels + y * stride + x;
+	if (blending) {
+		float alpha = c[3];
+		QRgb old = *pixel;
+		c[0] = c[0] * alpha + qRed(old) / 255.0f * (1.0f - alpha);
+		c[1] = c[1] * alpha + qGreen(old) / 255.0f * (1.0f - alpha);
+		c[2] = c[2] * alpha + qBlue(old) / 255.0f * (1.0f - alpha);
+	}
+
+	*pixel = qRgb(
+		static_cast<int>(c[0] * 255.0f + 0.5f),
+		static_cast<int>(c[1] * 255.0f + 0.5f),
+		static_cast<int>(c[2] * 255.0f + 0.5f)
+	);
+}
@@ -0,0 +1,290 @@
+#pragma once
+
+#include <QColor>
+#include <QImage>
+#include <QMatrix4x4>
+#include <QVector>
+
+#include "RenderGeometry.h"
+
+/**
+ * @brief Multithreaded triangle rasterizer which renders into a QImage
+ *
+ * Draws RenderGeometry without OpenGL, for example on servers without a
+ * graphics card or if the OpenGL driver is a slow software implementation.
+ * The state methods follow the fixed function pipeline which is used by the
+ * render modes, so the results match the OpenGL output closely: depth test,
+ * alpha blending, point size, line width and the lighting of ShadedMode with
+ * one directional light, two sided lighting and optional specular highlights.
+ *
+ * The primitives are processed in batches. Each batch is transformed, clipped
+ * and lit in parallel and sorted into bins of 64x64 pixel tiles. Then all
+ * tiles are rasterized in parallel, the coverage and depth tests handle four
+ * pixels at once with SSE2 if it is available. Within each tile the order of
+ * the primitives is kept, so blending gives the same result as OpenGL.
+ *
+ * @see IRenderMode::render()
+ */
+class SoftwareRenderer
+{
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * Creates a renderer with an empty image and the default OpenGL state.
+	 */
+	SoftwareRenderer();
+
+	/**
+	 * @brief Changes the size of the image
+	 *
+	 * The content of the image and the depth buffer is undefined afterwards.
+	 *
+	 * @param [in] width Width of the image in pixels
+	 * @param [in] height Height of the image in pixels
+	 */
+	void resize(int width, int height);
+
+	/**
+	 * @brief Returns the rendered image
+	 */
+	const QImage & image() const;
+
+	/**
+	 * @brief Fills the image with a color and resets the depth buffer
+	 */
+	void clear(const QColor & color);
+
+	/**
+	 * @brief Sets the transformation for the following primitives
+	 *
+	 * @param [in] projection The projection matrix
+	 * @param [in] modelView The model view matrix, also used for the normals
+	 */
+	void setMatrices(const QMatrix4x4 & projection, const QMatrix4x4 & modelView);
+
+	/**
+	 * @brief Sets the color for geometry without colors (like glColor)
+	 */
+	void setColor(const QColor & color);
+
+	/**
+	 * @brief Enables the lighting of ShadedMode for geometry with normals
+	 *
+	 * @param [in] enabled Enables the lighting
+	 * @param [in] specular Enables the specular highlights
+	 */
+	void setLighting(bool enabled, bool specular);
+
+	/**
+	 * @brief Enables alpha blending (like GL_BLEND with GL_ONE_MINUS_SRC_ALPHA)
+	 */
+	void setBlending(bool enabled);
+
+	/**
+	 * @brief Enables the depth test (like GL_DEPTH_TEST with GL_LESS)
+	 */
+	void setDepthTest(bool enabled);
+
+	/**
+	 * @brief Sets the diameter of points in pixels
+	 */
+	void setPointSize(float size);
+
+	/**
+	 * @brief Sets the width of lines in pixels
+	 */
+	void setLineWidth(float width);
+
+	/**
+	 * @brief Sets a clipping plane for the following primitives (like glClipPlane)
+	 *
+	 * The plane is given in the coordinates of the primitives and keeps the
+	 * points p with a*p.x + b*p.y + c*p.z + d >= 0. Unlike in OpenGL it stays
+	 * attached to the primitives when the matrices change.
+	 *
+	 * @param [in] equation The coefficients a, b, c and d, null disables the plane
+	 */
+	void setClipPlane(const float *equation);
+
+	/**
+	 * @brief Draws the ranges of the selected parts
+	 *
+	 * Works like GeometryBuffer::draw(): all opaque ranges are drawn first,
+	 * then the translucent ones. The last range is always drawn.
+	 *
+	 * @param [in] geometry The geometry which should be drawn
+	 * @param [in] parts The numbers of the visible parts in ascending order
+	 */
+	void draw(const RenderGeometry *geometry, const QVector<int> & parts);
+
+private:
+	/**
+	 * @brief A vertex after the projection into the image
+	 *
+	 * The position is given in pixels, z is the depth from 0 to 1 and
+	 * w is the reciprocal of the clip w coordinate.
+	 */
+	struct ScreenVertex
+	{
+		float x, y, z, w;
+		float color[4];
+	};
+
+	/**
+	 * @brief A vertex in clip space with its final color
+	 */
+	struct ClipVertex
+	{
+		float position[4];
+		float color[4];
+	};
+
+	/**
+	 * @brief A triangle ready for rasterization
+	 *
+	 * All values are stored as plane equations a*x + b*y + c over the pixel
+	 * coordinates. The edge functions are positive inside of the triangle,
+	 * the other planes interpolate the vertex attributes. The colors are multiplied with w for perspective correct
+	 * interpolation.
+	 */
+	struct Triangle
+	{
+		float edges[3][3];
+		float z[3];
+		float w[3];
+		float color[4][3];
+		bool topLeft[3];
+		int minX, minY, maxX, maxY;
+	};
+
+	/**
+	 * @brief Triangles and tile bins created by one thread
+	 */
+	struct Bin
+	{
+		QVector<Triangle> triangles;
+		QVector<QVector<int> > tiles;
+	};
+
+	/**
+	 * @brief Draws a list of primitives, each given by its first vertex
+	 */
+	void drawBatch(const RenderGeometry *geometry, const int *primitives, int count);
+
+	/**
+	 * @brief Transforms, lights, clips and bins a single primitive
+	 */
+	void setupPrimitive(const RenderGeometry *geometry, int first, Bin *bin) const;
+
+	/**
+	 * @brief Transforms a position into clip space
+	 */
+	void transform(const float *position, float *clip) const;
+
+	/**
+	 * @brief Computes the color of a vertex
+	 *
+	 * @param [in] backFace Use the negated normal for two sided lighting
+	 * @param [out] result Receives the RGBA color
+	 */
+	void shade(const RenderGeometry *geometry, int index, bool backFace, float *result) const;
+
+	/**
+	 * @brief Are all vertices outside of the same clip plane?
+	 */
+	static bool outsideFrustum(const ClipVertex *vertices, int count);
+
+	/**
+	 * @brief Interpolates position and color of two clip space vertices
+	 */
+	static void interpolate(const ClipVertex & a, const ClipVertex & b, float t,
+		ClipVertex *result);
+
+	/**
+	 * @brief Returns the distance of a clip space vertex to a plane
+	 *
+	 * @param [in] plane The plane equation in clip space
+	 */
+	static float distance(const ClipVertex & vertex, const float *plane);
+
+	/**
+	 * @brief Clips a polygon against a plane in clip space
+	 *
+	 * The output needs space for one vertex more than the input.
+	 *
+	 * @param [in] plane The plane equation, the positive side is kept
+	 * @return Number of vertices of the clipped polygon
+	 */
+	static int clipPolygon(const ClipVertex *input, int count, const float *plane,
+		ClipVertex *output);
+
+	/**
+	 * @brief Projects a clip space vertex into the image
+	 */
+	ScreenVertex project(const ClipVertex & vertex) const;
+
+	/**
+	 * @brief Creates the plane equations of a triangle and bins it
+	 */
+	void addTriangle(const ScreenVertex & a, const ScreenVertex & b,
+		const ScreenVertex & c, Bin *bin) const;
+
+	/**
+	 * @brief Rasterizes all binned triangles of one tile
+	 */
+	void rasterTile(int tile, const QVector<Bin> & bins);
+
+	/**
+	 * @brief Rasterizes the pixels x0 to x1 of a row of a triangle
+	 */
+	void rasterSpan(const Triangle & triangle, int x0, int x1, int y);
+
+	/**
+	 * @brief Shades and writes one pixel which passed the depth test
+	 */
+	void writePixel(const Triangle & triangle, int x, int y);
+
+	/**
+	 * @brief Edge length of the square tiles in pixels
+	 */
+	static const int tileSize = 64;
+
+	/**
+	 * @brief Maximum number of primitives per batch
+	 */
+	static const int batchSize = 1 << 16;
+
+	QImage target;
+	QVector<float> depth;
+	int tilesX;
+	int tilesY;
+
+	/**
+	 * @brief Pixels of the image, valid while a batch is drawn
+	 */
+	quint32 *pixels;
+	int stride;
+
+	QMatrix4x4 modelViewProjection;
+	float normalMatrix[9];
+
+	/**
+	 * @brief The clipping plane in the coordinates of the primitives
+	 */
+	float clipEquation[4];
+
+	/**
+	 * @brief The clipping plane transformed into clip space
+	 */
+	float clipPlane[4];
+	bool clipping;
+
+	float color[4];
+	bool lighting;
+	bool specular;
+	bool blending;
+	bool depthTest;
+	float pointSize;
+	float lineWidth;
+};
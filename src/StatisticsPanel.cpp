@@ -0,0 +1,124 @@
+#include <QtConcurrent>
+
+#include "StatisticsPanel.h"
+#include "OffScene.h"
+#include "HalfEdgeMesh.h"
+
+StatisticsPanel::StatisticsPanel(QWidget *parent)
+	: QDockWidget(parent)
+{
+	scene = nullptr;
+	components = -1;
+	hasReport = false;
+	pending = false;
+	delay.setSingleShot(true);
+	delay.setInterval(300);
+
+	label = new QLabel(this);
+	label->setAlignment(Qt::AlignLeft | Qt::AlignTop);
+	label->setTextInteractionFlags(Qt::TextSelectableByMouse);
+	label->setMargin(6);
+	setWidget(label);
+	setObjectName("statisticsPanel");
+
+	connect(&watcher, SIGNAL(finished()), this, SLOT(computationFinished()));
+	connect(&delay, SIGNAL(timeout()), this, SLOT(startCalculation()));
+	connect(this, SIGNAL(visibilityChanged(bool)), this, SLOT(startWhenShown(bool)));
+	retranslate();
+}
+
+StatisticsPanel::~StatisticsPanel()
+{
+	cancel();
+}
+
+void StatisticsPanel::setScene(IScene *newScene, int newComponents)
+{
+	cancel();
+	scene = newScene;
+	components = newComponents;
+	hasReport = false;
+	refresh();
+}
+
+void StatisticsPanel::retranslate()
+{
+	setWindowTitle(tr("Statistics"));
+	if (!scene) {
+		label->setText(tr("No object is loaded"));
+	} else if (hasReport) {
+		label->setText(MeshStatistics::describe(report));
+	} else if (pending) {
+		label->setText(tr("Calculating the statistics of %1 polygons...")
+			.arg(scene->polygonsCount()));
+	} else {
+		label->clear();
+	}
+}
+
+void StatisticsPanel::computationFinished()
+{
+	// A stopped calculation may finish after its scene was replaced,
+	// while the delay runs no calculation is started yet
+	if (!pending || delay.isActive()) {
+		return;
+	}
+	pending = false;
+	report = watcher.result();
+	hasReport = true;
+	OffScene *offScene = dynamic_cast<OffScene*>(scene);
+	if (offScene) {
+		offScene->setStatistics(report);
+	}
+	retranslate();
+}
+
+void StatisticsPanel::startWhenShown(bool visible)
+{
+	if (visible && !hasReport && !pending) {
+		refresh();
+	}
+}
+
+void StatisticsPanel::cancel()
+{
+	delay.stop();
+	if (watcher.isRunning()) {
+		abort.store(1);
+		watcher.waitForFinished();
+		abort.store(0);
+	}
+	pending = false;
+}
+
+void StatisticsPanel::refresh()
+{
+	const OffScene *offScene = dynamic_cast<const OffScene*>(scene);
+	if (offScene && offScene->statistics(&report)) {
+		hasReport = true;
+	} else if (scene && isVisible()) {
+		pending = true;
+		delay.start();
+	}
+	retranslate();
+}
+
+void StatisticsPanel::startCalculation()
+{
+	if (!pending || !scene) {
+		return;
+	}
+
+	// OFF scenes keep their half-edges, other scenes build them for the calculation
+	const IScene *measured = scene;
+	const OffScene *offScene = dynamic_cast<const OffScene*>(scene);
+	int known = components;
+	const QAtomicInt *stop = &abort;
+	watcher.setFuture(QtConcurrent::run([measured, offScene, known, stop]() {
+		if (offScene) {
+			return MeshStatistics::compute(measured, *offScene->halfEdges(), known, stop);
+		}
+		HalfEdgeMesh halfEdges(measured);
+		return MeshStatistics::compute(measured, halfEdges, known, stop);
+	}));
+}
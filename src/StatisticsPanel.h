@@ -0,0 +1,134 @@
+#pragma once
+
+#include <QtCore>
+#include <QDockWidget>
+#include <QLabel>
+#include <QTimer>
+#include <QFutureWatcher>
+
+#include "IScene.h"
+#include "MeshStatistics.h"
+
+/**
+ * @brief Dock widget that shows the MeshStatistics of the current scene
+ *
+ * The statistics are calculated in the background while the panel is
+ * visible, so large scenes do not block the window. The result is kept by
+ * OffScene until its polygons or vertices change, switching back to a
+ * cached file shows it at once.
+ *
+ * The calculation starts after a short delay, which is started again by
+ * every change. A scene that changes with each frame of a played sequence
+ * is only measured once the playback stops.
+ *
+ * A running calculation reads the scene, so it is stopped before the scene
+ * changes: setScene() has to be called before a scene is deleted or grows,
+ * cancel() before its vertices are updated and setScene() afterwards.
+ *
+ * @see MainWindow
+ */
+class StatisticsPanel : public QDockWidget
+{
+	Q_OBJECT
+
+public:
+	/**
+	 * @brief Constructor, the panel starts without a scene
+	 *
+	 * @param [in] parent Parent widget
+	 */
+	StatisticsPanel(QWidget *parent = nullptr);
+
+	/**
+	 * @brief Destructor, stops a running calculation
+	 */
+	~StatisticsPanel();
+
+	/**
+	 * @brief Shows the statistics of another scene or of the changed current scene
+	 *
+	 * Stops a running calculation and starts a new one if the panel is
+	 * visible and the scene has no remembered statistics.
+	 *
+	 * @param [in] scene The scene or null
+	 * @param [in] components Number of connected components if already known, -1 to find them
+	 */
+	void setScene(IScene *scene, int components = -1);
+
+	/**
+	 * @brief Stops a running calculation and drops its result
+	 */
+	void cancel();
+
+	/**
+	 * @brief Translates the title and the shown text
+	 */
+	void retranslate();
+
+private slots:
+	/**
+	 * @brief Shows the result of the finished calculation
+	 */
+	void computationFinished();
+
+	/**
+	 * @brief Starts the calculation when the panel is shown
+	 */
+	void startWhenShown(bool visible);
+
+	/**
+	 * @brief Starts the calculation after the delay
+	 */
+	void startCalculation();
+
+private:
+	/**
+	 * @brief Shows the known statistics or starts the calculation
+	 */
+	void refresh();
+
+	/**
+	 * @brief The scene whose statistics are shown, may be null
+	 */
+	IScene *scene;
+
+	/**
+	 * @brief Number of connected components of the scene or -1
+	 */
+	int components;
+
+	/**
+	 * @brief Shows the description of the statistics
+	 */
+	QLabel *label;
+
+	/**
+	 * @brief The shown statistics, only valid if hasReport is true
+	 */
+	MeshStatistics::Report report;
+
+	/**
+	 * @brief Are statistics of the scene shown?
+	 */
+	bool hasReport;
+
+	/**
+	 * @brief Is a calculation for the scene waiting or running?
+	 */
+	bool pending;
+
+	/**
+	 * @brief Delays the calculation until the scene stops changing
+	 */
+	QTimer delay;
+
+	/**
+	 * @brief Tells the calculation to stop
+	 */
+	QAtomicInt abort;
+
+	/**
+	 * @brief Reports the end of the calculation
+	 */
+	QFutureWatcher<MeshStatistics::Report> watcher;
+};
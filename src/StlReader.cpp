@@ -0,0 +1,71 @@
+#include <cstring>
+#include <limits>
+
+#include "StlReader.h"
+#include "Parallel.h"
+#include "Trace.h"
+
+void StlReader::read(const QString & fileName, MeshData *mesh, const QAtomicInt *abort)
+{
+	TRACE_ZONE("StlReader::read");
+	QFile file(fileName);
+	if (!file.open(QIODevice::ReadOnly)) {
+		throw tr("Unable to open file ") + fileName;
+	}
+
+	qint64 size = file.size();
+	if (size < headerBytes + 4) {
+		throw tr("The STL file is too small!");
+	}
+	const uchar *data = file.map(0, size);
+	if (!data) {
+		throw tr("Unable to map file ") + fileName;
+	}
+
+	// ASCII files also start with "solid", but their size never matches
+	qint64 count = qFromLittleEndian<quint32>(data + headerBytes);
+	if (size != headerBytes + 4 + count * triangleBytes) {
+		file.unmap(const_cast<uchar*>(data));
+		throw tr("Only binary STL files are supported!");
+	}
+	if (count == 0 || 3 * count > std::numeric_limits<int>::max() / 3) {
+		file.unmap(const_cast<uchar*>(data));
+		throw tr("Invalid vertex or polygon number!");
+	}
+
+	int triangles = int(count);
+	mesh->positions.resize(9 * triangles);
+	mesh->vertexColors.clear();
+	mesh->offsets.resize(triangles + 1);
+	mesh->indices.resize(3 * triangles);
+	mesh->polygonColors.clear();
+	mesh->fileIndices.clear();
+
+	// The records are not aligned, so the floats are copied bytewise
+	const uchar *records = data + headerBytes + 4;
+	float *positions = mesh->positions.data();
+	int *offsets = mesh->offsets.data();
+	int *indices = mesh->indices.data();
+	Parallel::forBlocks(triangles, 1 << 14, [&](int begin, int end) {
+		if (abort && abort->load()) {
+			return;
+		}
+		for (int i = begin; i < end; i++) {
+			const uchar *corners = records + qint64(i) * triangleBytes + 12;
+			for (int k = 0; k < 9; k++) {
+				quint32 bits = qFromLittleEndian<quint32>(corners + 4 * k);
+				memcpy(positions + 9 * i + k, &bits, sizeof(float));
+			}
+			offsets[i] = 3 * i;
+			indices[3 * i] = 3 * i;
+			indices[3 * i + 1] = 3 * i + 1;
+			indices[3 * i + 2] = 3 * i + 2;
+		}
+	});
+	offsets[triangles] = 3 * triangles;
+
+	file.unmap(const_cast<uchar*>(data));
+	if (abort && abort->load()) {
+		throw tr("Aborted file loading!");
+	}
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <QtCore>
+
+#include "MeshData.h"
+
+/**
+ * @brief Reader for binary STL files
+ *
+ * A binary STL file has an 80 byte header, the number of triangles and
+ * 50 bytes for each triangle: the normal vector, the three corners and
+ * an attribute word. The file is mapped into memory and the corners are
+ * copied into the mesh by several threads. The normal vectors are
+ * ignored, they are calculated from the corners like for OFF files.
+ *
+ * Every triangle has its own corners, so the result should be passed
+ * to VertexWelder::weld() before it becomes a scene.
+ *
+ * ASCII STL files are not supported.
+ *
+ * @see VertexWelder
+ */
+class StlReader
+{
+	Q_DECLARE_TR_FUNCTIONS(StlReader)
+
+public:
+	/**
+	 * @brief Reads a binary STL file
+	 *
+	 * Throws a QString if the file can not be read.
+	 *
+	 * @param [in] fileName Path to the file
+	 * @param [out] mesh Receives three vertices and a polygon for each triangle
+	 * @param [in] abort Cancels the reading from another thread if set, may be null
+	 */
+	static void read(const QString & fileName, MeshData *mesh, const QAtomicInt *abort = nullptr);
+
+private:
+	/**
+	 * @brief Size of the header before the number of triangles
+	 */
+	static const int headerBytes = 80;
+
+	/**
+	 * @brief Size of a triangle record
+	 */
+	static const int triangleBytes = 50;
+};
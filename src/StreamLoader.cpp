@@ -0,0 +1,175 @@
+#include <cstdio>
+#include <thread>
+
+#include "StreamLoader.h"
+#include "Trace.h"
+
+StreamLoader::Shared::Shared()
+{
+	colored = false;
+	expectedPolygons = 0;
+	done = false;
+}
+
+StreamLoader::Shared::~Shared()
+{
+	// Objects read after the loader was deleted
+	qDeleteAll(polygons);
+	qDeleteAll(vertices);
+}
+
+StreamLoader::StreamLoader(QObject *parent)
+	: QObject(parent)
+{
+	shared = QSharedPointer<Shared>(new Shared());
+	growing = new OffScene();
+	waitingColored = false;
+	expected = 0;
+	complete = false;
+	connect(&timer, SIGNAL(timeout()), this, SLOT(collect()));
+}
+
+StreamLoader::~StreamLoader()
+{
+	timer.stop();
+	shared->abort.store(1);
+	qDeleteAll(waitingPolygons);
+	qDeleteAll(waitingVertices);
+	delete growing;
+}
+
+void StreamLoader::start()
+{
+	std::thread thread(read, shared);
+	thread.detach();
+	sinceGrowth.start();
+	timer.start(200);
+}
+
+OffScene* StreamLoader::scene() const
+{
+	return growing;
+}
+
+int StreamLoader::expectedPolygons() const
+{
+	return expected;
+}
+
+bool StreamLoader::isFinished() const
+{
+	return complete;
+}
+
+void StreamLoader::collect()
+{
+	bool done;
+	QString error;
+	{
+		QMutexLocker locker(&shared->mutex);
+		waitingVertices += shared->vertices;
+		waitingPolygons += shared->polygons;
+		waitingColored = waitingColored || shared->colored;
+		shared->vertices.clear();
+		shared->polygons.clear();
+		shared->colored = false;
+		expected = shared->expectedPolygons;
+		done = shared->done;
+		error = shared->error;
+	}
+
+	// Every extension builds the render data again, so the scene grows in large steps
+	bool due = done || (!waitingPolygons.isEmpty() && sinceGrowth.elapsed() >= maximumDelay) ||
+		waitingPolygons.size() >= qMax(int(minimumGrowth), growing->polygonsCount());
+	if (due && (!waitingVertices.isEmpty() || !waitingPolygons.isEmpty())) {
+		emit aboutToGrow();
+		growing->append(waitingVertices, waitingPolygons, waitingColored);
+		waitingVertices.clear();
+		waitingPolygons.clear();
+		waitingColored = false;
+		sinceGrowth.restart();
+		emit grown();
+	}
+
+	if (done) {
+		timer.stop();
+		complete = true;
+		if (error.isEmpty()) {
+			emit finished();
+		} else {
+			emit failed(error);
+		}
+	}
+}
+
+void StreamLoader::read(QSharedPointer<Shared> shared)
+{
+	TRACE_ZONE("StreamLoader::read");
+	QFile file;
+	QTextStream stream(&file);
+
+	// The parser only collects the colored flag, the objects are handed out
+	OffScene parser;
+	QVector<CVertex*> vertices;
+	QVector<CVertex*> newVertices;
+	QVector<CPolygon*> newPolygons;
+	QString error;
+
+	try {
+		if (!file.open(stdin, QIODevice::ReadOnly)) {
+			throw tr("Unable to read the standard input!");
+		}
+
+		QString line = parser.readNextLine(&stream);
+		if (line != "OFF" && line != "COFF") {
+			throw tr("Wrong file format!");
+		}
+		line = parser.readNextLine(&stream);
+		QStringList tokens = parser.split2Token(&line);
+		if (tokens.size() != 3) {
+			throw tr("Can't read vertex, polygon and edge numbers!");
+		}
+		int vCount = tokens[0].toInt();
+		int pCount = tokens[1].toInt();
+		if (vCount <= 0 || pCount <= 0) {
+			throw tr("Invalid vertex or polygon number!");
+		}
+		{
+			QMutexLocker locker(&shared->mutex);
+			shared->expectedPolygons = pCount;
+		}
+
+		vertices.reserve(vCount);
+		for (int i = 0; i < vCount + pCount && !shared->abort.load(); i++) {
+			line = parser.readNextLine(&stream);
+			tokens = parser.split2Token(&line);
+			if (i < vCount) {
+				CVertex *vertex = parser.readVertex(&tokens);
+				vertices.append(vertex);
+				newVertices.append(vertex);
+			} else {
+				newPolygons.append(parser.readPolygon(&tokens, vertices));
+			}
+
+			if ((i + 1) % batchLines == 0 || i + 1 == vCount + pCount) {
+				QMutexLocker locker(&shared->mutex);
+				shared->vertices += newVertices;
+				shared->polygons += newPolygons;
+				shared->colored = shared->colored || parser.colored;
+				newVertices.clear();
+				newPolygons.clear();
+			}
+		}
+	}
+	catch (QString & message) {
+		error = message;
+	}
+
+	// Objects that were not handed out belong to nobody else
+	qDeleteAll(newPolygons);
+	qDeleteAll(newVertices);
+
+	QMutexLocker locker(&shared->mutex);
+	shared->done = true;
+	shared->error = error;
+}
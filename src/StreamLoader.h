@@ -0,0 +1,156 @@
+#pragma once
+
+#include <QtCore>
+
+#include "OffScene.h"
+
+/**
+ * @brief Reads an OFF scene from stdin and shows it while it arrives
+ *
+ * A pipe like "generator | offview -" can not seek and may deliver the
+ * data slowly, so the text is read in a single forward pass by its own
+ * thread. Only the parsed vertices and polygons are kept, the text goes
+ * through the small buffer of the stream.
+ *
+ * The main thread collects the parsed objects regularly and adds them to
+ * a growing scene. The scene is only extended when the number of new
+ * polygons is about as large as the scene, or after a while, because the
+ * widget has to build the hierarchy and the geometry again each time.
+ *
+ * A blocking read on a pipe can not be interrupted. If the loader is
+ * deleted early, the thread is left alone and ends with the input or
+ * with the application.
+ *
+ * @see OffScene::append()
+ */
+class StreamLoader : public QObject
+{
+	Q_OBJECT
+
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param [in] parent Parent object
+	 */
+	StreamLoader(QObject *parent = nullptr);
+
+	/**
+	 * @brief Destructor, deletes the scene
+	 *
+	 * The widget must not display the scene any more.
+	 */
+	~StreamLoader();
+
+	/**
+	 * @brief Starts reading stdin
+	 */
+	void start();
+
+	/**
+	 * @brief Returns the scene read so far
+	 */
+	OffScene* scene() const;
+
+	/**
+	 * @brief Returns the number of polygons announced by the header, or zero
+	 */
+	int expectedPolygons() const;
+
+	/**
+	 * @brief Was the whole input read?
+	 */
+	bool isFinished() const;
+
+signals:
+	/**
+	 * @brief New vertices and polygons are added to the scene next
+	 *
+	 * Receivers must stop everything that reads the scene in other threads.
+	 */
+	void aboutToGrow();
+
+	/**
+	 * @brief New vertices and polygons were added to the scene
+	 */
+	void grown();
+
+	/**
+	 * @brief The whole input was read and added to the scene
+	 */
+	void finished();
+
+	/**
+	 * @brief The input is invalid, the scene keeps what was read before
+	 */
+	void failed(const QString & message);
+
+private slots:
+	/**
+	 * @brief Takes the parsed objects from the thread and extends the scene
+	 */
+	void collect();
+
+private:
+	/**
+	 * @brief Data exchanged with the reading thread
+	 */
+	struct Shared
+	{
+		Shared();
+		~Shared();
+
+		QMutex mutex;
+
+		/**
+		 * @brief Parsed objects that were not collected yet
+		 */
+		QVector<CVertex*> vertices;
+		QVector<CPolygon*> polygons;
+		bool colored;
+
+		int expectedPolygons;
+		bool done;
+		QString error;
+
+		/**
+		 * @brief Set when the loader is deleted
+		 */
+		QAtomicInt abort;
+	};
+
+	/**
+	 * @brief Reads and parses stdin, runs in its own thread
+	 */
+	static void read(QSharedPointer<Shared> shared);
+
+	/**
+	 * @brief Number of lines the thread parses before it hands them out
+	 */
+	static const int batchLines = 4096;
+
+	/**
+	 * @brief Minimum number of new polygons for extending the scene
+	 */
+	static const int minimumGrowth = 10000;
+
+	/**
+	 * @brief Time after which the scene is extended anyway, in milliseconds
+	 */
+	static const int maximumDelay = 2000;
+
+	QSharedPointer<Shared> shared;
+	OffScene *growing;
+
+	/**
+	 * @brief Collected objects that are not part of the scene yet
+	 */
+	QVector<CVertex*> waitingVertices;
+	QVector<CPolygon*> waitingPolygons;
+	bool waitingColored;
+
+	int expected;
+	bool complete;
+	QElapsedTimer sinceGrowth;
+	QTimer timer;
+};
@@ -0,0 +1,610 @@
+#include <algorithm>
+#include <cfloat>
+#include <cstring>
+
+#include "TileConverter.h"
+#include "RenderGeometry.h"
+
+/**
+ * @brief Spreads the lower 10 bits of a value to every third bit
+ */
+static quint32 expandBits(quint32 v)
+{
+	v = (v * 0x00010001u) & 0xFF0000FFu;
+	v = (v * 0x00000101u) & 0x0F00F00Fu;
+	v = (v * 0x00000011u) & 0xC30C30C3u;
+	v = (v * 0x00000005u) & 0x49249249u;
+	return v;
+}
+
+void TileConverter::convert(const QString & offFile, const QString & tileFile,
+	const ProgressFunction & progress)
+{
+	TileConverter converter(progress);
+	try {
+		converter.run(offFile, tileFile);
+	}
+	catch (QString &) {
+		// Do not leave a damaged file behind
+		converter.output.close();
+		QFile::remove(tileFile);
+		throw;
+	}
+}
+
+TileConverter::TileConverter(const ProgressFunction & progress)
+{
+	this->progress = progress;
+	vertices = nullptr;
+	verticesCount = 0;
+	trianglesCount = 0;
+	levels = 0;
+	colored = false;
+	for (int k = 0; k < 3; k++) {
+		min[k] = FLT_MAX;
+		max[k] = -FLT_MAX;
+	}
+}
+
+QRgb TileConverter::defaultColor()
+{
+	return qRgba(160, 160, 160, 255);
+}
+
+void TileConverter::report(int percent)
+{
+	if (progress && !progress(percent)) {
+		throw tr("Aborted file conversion!");
+	}
+}
+
+quint32 TileConverter::cellOf(const float *point) const
+{
+	int cells = 1 << levels;
+	quint32 coords[3];
+	for (int k = 0; k < 3; k++) {
+		float extent = max[k] - min[k];
+		int c = extent > 0.0f ? static_cast<int>((point[k] - min[k]) / extent * cells) : 0;
+		coords[k] = qBound(0, c, cells - 1);
+	}
+	return expandBits(coords[0]) | (expandBits(coords[1]) << 1) | (expandBits(coords[2]) << 2);
+}
+
+void TileConverter::run(const QString & offFile, const QString & tileFile)
+{
+	QFile file(offFile);
+	QTextStream stream(&file);
+
+	if (!file.open(QIODevice::ReadOnly)) {
+		throw tr("Unable to open file ") + offFile;
+	}
+
+	// Same header checks as OffScene
+	QString line = parser.readNextLine(&stream);
+	if (line != "OFF" && line != "COFF") {
+		throw tr("Wrong file format!");
+	}
+
+	line = parser.readNextLine(&stream);
+	QStringList tokens = parser.split2Token(&line);
+	if (tokens.size() != 3) {
+		throw tr("Can't read vertex, polygon and edge numbers!");
+	}
+
+	int vCount = tokens[0].toInt();
+	int pCount = tokens[1].toInt();
+	if (vCount <= 0 || pCount <= 0) {
+		throw tr("Invalid vertex or polygon number!");
+	}
+
+	readVertices(&stream, vCount);
+
+	// Use enough levels for the target leaf size
+	levels = 0;
+	while (levels < maxLevels && (static_cast<qint64>(pCount) >> (3 * levels)) > leafTriangles) {
+		levels++;
+	}
+
+	QTemporaryFile triangleFile;
+	if (!triangleFile.open()) {
+		throw tr("Unable to create a temporary file!");
+	}
+	readPolygons(&stream, pCount, &triangleFile);
+	file.close();
+
+	output.setFileName(tileFile);
+	if (!output.open(QIODevice::ReadWrite | QIODevice::Truncate)) {
+		throw tr("Unable to write file ") + tileFile;
+	}
+
+	// The header is written again when the table is known
+	TileFile::Header header;
+	memset(&header, 0, sizeof(header));
+	output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+	QTemporaryFile sortedFile;
+	if (!sortedFile.open()) {
+		throw tr("Unable to create a temporary file!");
+	}
+	sortTriangles(&triangleFile, &sortedFile);
+	triangleFile.close();
+
+	uchar *sorted = sortedFile.map(0, sortedFile.size());
+	if (!sorted) {
+		throw tr("Unable to map a temporary file!");
+	}
+	writeLeaves(reinterpret_cast<const TriangleRecord*>(sorted));
+	sortedFile.unmap(sorted);
+	sortedFile.close();
+
+	for (int level = levels - 1; level >= 0; level--) {
+		writeParents(level);
+		report(85 + 15 * (levels - level) / levels);
+	}
+
+	// Append the table and complete the header
+	output.seek(output.size());
+	memcpy(header.magic, TileFile::magic(), sizeof(header.magic));
+	header.version = TileFile::currentVersion;
+	header.flags = colored ? TileFile::Colored : 0;
+	for (int k = 0; k < 3; k++) {
+		header.min[k] = min[k];
+		header.max[k] = max[k];
+	}
+	header.tableOffset = output.pos();
+	header.tilesCount = tiles.size();
+	header.rootTile = pending.first().index;
+
+	qint64 tableBytes = static_cast<qint64>(tiles.size()) * sizeof(TileFile::Tile);
+	bool ok = output.write(reinterpret_cast<const char*>(tiles.constData()), tableBytes) == tableBytes;
+	ok = ok && output.seek(0);
+	ok = ok && output.write(reinterpret_cast<const char*>(&header), sizeof(header)) == sizeof(header);
+	output.close();
+	if (!ok) {
+		throw tr("Unable to write file ") + tileFile;
+	}
+
+	report(100);
+}
+
+void TileConverter::readVertices(QTextStream *stream, int count)
+{
+	if (!vertexFile.open() || !vertexFile.resize(static_cast<qint64>(count) * sizeof(VertexRecord))) {
+		throw tr("Unable to create a temporary file!");
+	}
+	uchar *mapped = vertexFile.map(0, vertexFile.size());
+	if (!mapped) {
+		throw tr("Unable to map a temporary file!");
+	}
+	vertices = reinterpret_cast<VertexRecord*>(mapped);
+	verticesCount = count;
+
+	int stepSize = qMax(1, count / 30);
+	for (int i = 0; i < count; i++) {
+		QString line = parser.readNextLine(stream);
+		QStringList tokens = parser.split2Token(&line);
+		if (tokens.size() < 3) {
+			throw tr("Can't find all three vertex components!");
+		}
+
+		VertexRecord & vertex = vertices[i];
+		bool ok;
+		for (int k = 0; k < 3; k++) {
+			vertex.xyz[k] = tokens.at(k).toDouble(&ok);
+			if (!ok) {
+				throw tr("Can't parse vertex data!");
+			}
+			vertex.normal[k] = 0.0f;
+			min[k] = qMin(min[k], vertex.xyz[k]);
+			max[k] = qMax(max[k], vertex.xyz[k]);
+		}
+
+		QColor color = parser.readColor(&tokens, 3);
+		vertex.colored = color.isValid();
+		vertex.color = color.rgba();
+		colored = colored || vertex.colored;
+
+		if (i % stepSize == 0) {
+			report(30 * i / count);
+		}
+	}
+}
+
+void TileConverter::readPolygons(QTextStream *stream, int count, QFile *triangleFile)
+{
+	QVector<TriangleRecord> batch;
+	batch.reserve(4096);
+
+	int stepSize = qMax(1, count / 30);
+	for (int i = 0; i < count; i++) {
+		QString line = parser.readNextLine(stream);
+		QStringList tokens = parser.split2Token(&line);
+		if (tokens.size() < 4) {
+			throw tr("A polygon line has less than 4 components!");
+		}
+
+		bool ok;
+		int vCount = tokens.at(0).toInt(&ok);
+		if (!ok || vCount < 3) {
+			throw tr("A polygon references less than 3 vertices!");
+		}
+		if (tokens.size() < vCount + 1) {
+			throw tr("Can't parse polygon data!");
+		}
+
+		QVector<quint32> indices(vCount);
+		for (int j = 0; j < vCount; j++) {
+			int index = tokens.at(1+j).toInt(&ok);
+			if (!ok || index < 0 || index >= verticesCount) {
+				throw tr("Can't parse polygon data!");
+			}
+			indices[j] = index;
+		}
+
+		TriangleRecord triangle;
+		QColor color = parser.readColor(&tokens, vCount+1);
+		triangle.colored = color.isValid();
+		triangle.color = color.rgba();
+		colored = colored || triangle.colored;
+
+		// Split the polygon into a triangle fan
+		for (int t = 1; t + 1 < vCount; t++) {
+			triangle.vertices[0] = indices[0];
+			triangle.vertices[1] = indices[t];
+			triangle.vertices[2] = indices[t+1];
+
+			const float *a = vertices[indices[0]].xyz;
+			const float *b = vertices[indices[t]].xyz;
+			const float *c = vertices[indices[t+1]].xyz;
+			float e1[3] = { b[0]-a[0], b[1]-a[1], b[2]-a[2] };
+			float e2[3] = { c[0]-a[0], c[1]-a[1], c[2]-a[2] };
+			float normal[3] = {
+				e1[1]*e2[2] - e1[2]*e2[1],
+				e1[2]*e2[0] - e1[0]*e2[2],
+				e1[0]*e2[1] - e1[1]*e2[0]
+			};
+			float center[3];
+			for (int k = 0; k < 3; k++) {
+				center[k] = (a[k] + b[k] + c[k]) / 3.0f;
+				for (int v = 0; v < 3; v++) {
+					vertices[triangle.vertices[v]].normal[k] += normal[k];
+				}
+			}
+
+			triangle.cell = cellOf(center);
+			cellCounts[triangle.cell]++;
+			trianglesCount++;
+
+			batch.append(triangle);
+			if (batch.size() == batch.capacity()) {
+				triangleFile->write(reinterpret_cast<const char*>(batch.constData()),
+					batch.size() * sizeof(TriangleRecord));
+				batch.clear();
+			}
+		}
+
+		if (i % stepSize == 0) {
+			report(30 + 30 * i / count);
+		}
+	}
+
+	triangleFile->write(reinterpret_cast<const char*>(batch.constData()),
+		batch.size() * sizeof(TriangleRecord));
+	if (!triangleFile->flush()) {
+		throw tr("Unable to write a temporary file!");
+	}
+}
+
+void TileConverter::sortTriangles(QFile *triangleFile, QFile *sortedFile)
+{
+	// Counting sort: each cell gets a contiguous block in the sorted file
+	QHash<quint32, quint64> next;
+	quint64 offset = 0;
+	for (QMap<quint32, quint32>::const_iterator it = cellCounts.constBegin(); it != cellCounts.constEnd(); ++it) {
+		next[it.key()] = offset;
+		offset += it.value();
+	}
+
+	qint64 bytes = static_cast<qint64>(trianglesCount) * sizeof(TriangleRecord);
+	if (!sortedFile->resize(bytes)) {
+		throw tr("Unable to write a temporary file!");
+	}
+	uchar *source = triangleFile->map(0, bytes);
+	uchar *target = sortedFile->map(0, bytes);
+	if (!source || !target) {
+		throw tr("Unable to map a temporary file!");
+	}
+
+	const TriangleRecord *triangles = reinterpret_cast<const TriangleRecord*>(source);
+	TriangleRecord *sorted = reinterpret_cast<TriangleRecord*>(target);
+	for (quint64 i = 0; i < trianglesCount; i++) {
+		sorted[next[triangles[i].cell]++] = triangles[i];
+	}
+
+	triangleFile->unmap(source);
+	sortedFile->unmap(target);
+}
+
+void TileConverter::writeLeaves(const TriangleRecord *triangles)
+{
+	quint64 first = 0;
+	int done = 0;
+	for (QMap<quint32, quint32>::const_iterator it = cellCounts.constBegin(); it != cellCounts.constEnd(); ++it) {
+		quint32 count = it.value();
+		QVector<float> positions;
+		QVector<float> normals;
+		QVector<QRgb> colors;
+		positions.reserve(9 * count);
+		normals.reserve(9 * count);
+		colors.reserve(3 * count);
+
+		// Opaque triangles first, then the translucent ones
+		int opaqueCount = 0;
+		for (int translucentPass = 0; translucentPass < 2; translucentPass++) {
+			for (quint64 t = first; t < first + count; t++) {
+				const TriangleRecord & triangle = triangles[t];
+				QRgb corners[3];
+				bool translucent = false;
+				for (int v = 0; v < 3; v++) {
+					// If the vertex is colored, this overrides all other colors
+					const VertexRecord & vertex = vertices[triangle.vertices[v]];
+					if (vertex.colored) {
+						corners[v] = vertex.color;
+					} else if (triangle.colored) {
+						corners[v] = triangle.color;
+					} else {
+						corners[v] = defaultColor();
+					}
+					translucent = translucent || qAlpha(corners[v]) < 255;
+				}
+				if (translucent != (translucentPass == 1)) {
+					continue;
+				}
+
+				for (int v = 0; v < 3; v++) {
+					const VertexRecord & vertex = vertices[triangle.vertices[v]];
+					float normal[3];
+					RenderGeometry::normalize(vertex.normal, normal);
+					for (int k = 0; k < 3; k++) {
+						positions.append(vertex.xyz[k]);
+						normals.append(normal[k]);
+					}
+					colors.append(corners[v]);
+				}
+			}
+			if (translucentPass == 0) {
+				opaqueCount = positions.size() / 3;
+			}
+		}
+
+		int index = writeTile(positions, normals, colors, opaqueCount, levels, 0.0f);
+		PendingTile tile = { it.key(), index };
+		pending.append(tile);
+
+		first += count;
+		done++;
+		report(60 + 25 * done / cellCounts.size());
+	}
+}
+
+void TileConverter::writeParents(int level)
+{
+	QVector<PendingTile> parents;
+
+	int i = 0;
+	while (i < pending.size()) {
+		// The children of a parent are neighbours in the Morton order
+		quint32 parentCell = pending[i].cell >> 3;
+		int j = i;
+		while (j < pending.size() && (pending[j].cell >> 3) == parentCell) {
+			j++;
+		}
+
+		float boxMin[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+		float boxMax[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+		float childError = 0.0f;
+		QVector<float> positions;
+		QVector<float> normals;
+		QVector<QRgb> colors;
+		for (int c = i; c < j; c++) {
+			const TileFile::Tile & child = tiles[pending[c].index];
+			for (int k = 0; k < 3; k++) {
+				boxMin[k] = qMin(boxMin[k], child.min[k]);
+				boxMax[k] = qMax(boxMax[k], child.max[k]);
+			}
+			childError = qMax(childError, child.error);
+			readTile(pending[c].index, &positions, &normals, &colors);
+		}
+
+		// Vertex clustering: all vertices inside of a grid cell are merged
+		float extent = 0.0f;
+		for (int k = 0; k < 3; k++) {
+			extent = qMax(extent, boxMax[k] - boxMin[k]);
+		}
+		float cellSize = qMax(extent / clusterGrid, FLT_MIN);
+
+		int vCount = positions.size() / 3;
+		QHash<quint32, int> clusterIndex;
+		QVector<Cluster> clusters;
+		QVector<int> vertexCluster(vCount);
+		for (int v = 0; v < vCount; v++) {
+			const float *p = positions.constData() + 3*v;
+			quint32 key = 0;
+			for (int k = 2; k >= 0; k--) {
+				int c = qBound(0, static_cast<int>((p[k] - boxMin[k]) / cellSize), clusterGrid - 1);
+				key = key * clusterGrid + c;
+			}
+
+			QHash<quint32, int>::iterator it = clusterIndex.find(key);
+			if (it == clusterIndex.end()) {
+				Cluster empty;
+				memset(&empty, 0, sizeof(empty));
+				it = clusterIndex.insert(key, clusters.size());
+				clusters.append(empty);
+			}
+			Cluster & cluster = clusters[it.value()];
+			QRgb color = colors.isEmpty() ? defaultColor() : colors[v];
+			for (int k = 0; k < 3; k++) {
+				cluster.position[k] += p[k];
+				cluster.normal[k] += normals[3*v+k];
+			}
+			cluster.color[0] += qRed(color);
+			cluster.color[1] += qGreen(color);
+			cluster.color[2] += qBlue(color);
+			cluster.color[3] += qAlpha(color);
+			cluster.count++;
+			vertexCluster[v] = it.value();
+		}
+
+		// Average the clusters
+		QVector<float> clusterPositions(3 * clusters.size());
+		QVector<float> clusterNormals(3 * clusters.size());
+		QVector<QRgb> clusterColors(clusters.size());
+		for (int c = 0; c < clusters.size(); c++) {
+			const Cluster & cluster = clusters[c];
+			float normal[3];
+			for (int k = 0; k < 3; k++) {
+				clusterPositions[3*c+k] = cluster.position[k] / cluster.count;
+				normal[k] = cluster.normal[k];
+			}
+			RenderGeometry::normalize(normal, clusterNormals.data() + 3*c);
+			clusterColors[c] = qRgba(
+				qRound(cluster.color[0] / cluster.count),
+				qRound(cluster.color[1] / cluster.count),
+				qRound(cluster.color[2] / cluster.count),
+				qRound(cluster.color[3] / cluster.count)
+			);
+		}
+
+		// Keep the triangles which still have three different corners
+		QVector<float> simplePositions;
+		QVector<float> simpleNormals;
+		QVector<QRgb> simpleColors;
+		int opaqueCount = 0;
+		for (int translucentPass = 0; translucentPass < 2; translucentPass++) {
+			QSet<quint64> seen;
+			for (int t = 0; t < vCount / 3; t++) {
+				int a = vertexCluster[3*t];
+				int b = vertexCluster[3*t+1];
+				int c = vertexCluster[3*t+2];
+				if (a == b || b == c || a == c) {
+					continue;
+				}
+
+				bool translucent = qAlpha(clusterColors[a]) < 255
+					|| qAlpha(clusterColors[b]) < 255 || qAlpha(clusterColors[c]) < 255;
+				if (translucent != (translucentPass == 1)) {
+					continue;
+				}
+
+				// Drop triangles which collapsed onto the same clusters
+				quint64 sortedCorners[3] = { static_cast<quint64>(a), static_cast<quint64>(b), static_cast<quint64>(c) };
+				std::sort(sortedCorners, sortedCorners + 3);
+				quint64 key = (sortedCorners[0] << 42) | (sortedCorners[1] << 21) | sortedCorners[2];
+				if (seen.contains(key)) {
+					continue;
+				}
+				seen.insert(key);
+
+				const int corners[3] = { a, b, c };
+				for (int v = 0; v < 3; v++) {
+					for (int k = 0; k < 3; k++) {
+						simplePositions.append(clusterPositions[3*corners[v]+k]);
+						simpleNormals.append(clusterNormals[3*corners[v]+k]);
+					}
+					simpleColors.append(clusterColors[corners[v]]);
+				}
+			}
+			if (translucentPass == 0) {
+				opaqueCount = simplePositions.size() / 3;
+			}
+		}
+
+		float error = qMax(childError, cellSize);
+		int index = writeTile(simplePositions, simpleNormals, simpleColors, opaqueCount, level, error);
+		TileFile::Tile & tile = tiles[index];
+		for (int k = 0; k < 3; k++) {
+			tile.min[k] = boxMin[k];
+			tile.max[k] = boxMax[k];
+		}
+		tile.firstChild = pending[i].index;
+		tile.childCount = j - i;
+
+		PendingTile parent = { parentCell, index };
+		parents.append(parent);
+		i = j;
+	}
+
+	pending = parents;
+}
+
+int TileConverter::writeTile(const QVector<float> & positions, const QVector<float> & normals,
+	const QVector<QRgb> & colors, int opaqueCount, int level, float error)
+{
+	int count = positions.size() / 3;
+
+	TileFile::Tile tile;
+	for (int k = 0; k < 3; k++) {
+		tile.min[k] = count > 0 ? FLT_MAX : 0.0f;
+		tile.max[k] = count > 0 ? -FLT_MAX : 0.0f;
+	}
+	for (int v = 0; v < count; v++) {
+		for (int k = 0; k < 3; k++) {
+			tile.min[k] = qMin(tile.min[k], positions[3*v+k]);
+			tile.max[k] = qMax(tile.max[k], positions[3*v+k]);
+		}
+	}
+
+	output.seek(output.size());
+	tile.offset = output.pos();
+	tile.opaqueCount = opaqueCount;
+	tile.translucentCount = count - opaqueCount;
+	tile.firstChild = -1;
+	tile.childCount = 0;
+	tile.level = level;
+	tile.error = error;
+
+	qint64 floatBytes = static_cast<qint64>(count) * 3 * sizeof(float);
+	bool ok = output.write(reinterpret_cast<const char*>(positions.constData()), floatBytes) == floatBytes;
+	ok = ok && output.write(reinterpret_cast<const char*>(normals.constData()), floatBytes) == floatBytes;
+	if (colored) {
+		QVector<quint8> rgba(4 * count);
+		for (int v = 0; v < count; v++) {
+			RenderGeometry::writeColor(QColor::fromRgba(colors[v]), rgba.data() + 4*v);
+		}
+		ok = ok && output.write(reinterpret_cast<const char*>(rgba.constData()), rgba.size()) == rgba.size();
+	}
+	if (!ok) {
+		throw tr("Unable to write file ") + output.fileName();
+	}
+
+	tiles.append(tile);
+	return tiles.size() - 1;
+}
+
+void TileConverter::readTile(int index, QVector<float> *positions, QVector<float> *normals,
+	QVector<QRgb> *colors)
+{
+	const TileFile::Tile & tile = tiles[index];
+	int count = tile.opaqueCount + tile.translucentCount;
+	int first = positions->size() / 3;
+	positions->resize(3 * (first + count));
+	normals->resize(3 * (first + count));
+
+	qint64 floatBytes = static_cast<qint64>(count) * 3 * sizeof(float);
+	bool ok = output.seek(tile.offset);
+	ok = ok && output.read(reinterpret_cast<char*>(positions->data() + 3*first), floatBytes) == floatBytes;
+	ok = ok && output.read(reinterpret_cast<char*>(normals->data() + 3*first), floatBytes) == floatBytes;
+	if (colored) {
+		QVector<quint8> rgba(4 * count);
+		ok = ok && output.read(reinterpret_cast<char*>(rgba.data()), rgba.size()) == rgba.size();
+		colors->resize(first + count);
+		for (int v = 0; v < count; v++) {
+			const quint8 *c = rgba.constData() + 4*v;
+			(*colors)[first + v] = qRgba(c[0], c[1], c[2], c[3]);
+		}
+	}
+	if (!ok) {
+		throw tr("Unable to read file ") + output.fileName();
+	}
+}
@@ -0,0 +1,214 @@
+#pragma once
+
+#include <functional>
+
+#include <QtCore>
+
+#include "TileFile.h"
+#include "OffScene.h"
+
+/**
+ * @brief Converts OFF files into tile files for out-of-core rendering
+ *
+ * The conversion never holds the whole scene in memory. The vertices and
+ * the triangles are streamed into temporary memory mapped files, so the
+ * operating system can page them out. The steps are:
+ *
+ * 1. Read the vertices and the scene bounding box.
+ * 2. Read the polygons, split them into triangles and assign each triangle
+ *    to a cell of a regular grid. Vertex normals are accumulated on the way.
+ * 3. Sort the triangles by cell and write one leaf tile per cell.
+ * 4. Create the coarser levels: eight neighbouring cells are merged into one
+ *    tile and simplified by vertex clustering until a single root is left.
+ *
+ * @see TileFile
+ */
+class TileConverter
+{
+	Q_DECLARE_TR_FUNCTIONS(TileConverter)
+
+public:
+	/**
+	 * @brief Function type for progress reports
+	 *
+	 * Receives the progress from 0 to 100 and returns false to abort.
+	 */
+	typedef std::function<bool(int percent)> ProgressFunction;
+
+	/**
+	 * @brief Converts an OFF file into a tile file
+	 *
+	 * Throws a QString with an error message if the conversion fails.
+	 *
+	 * @param [in] offFile Path of the OFF file
+	 * @param [in] tileFile Path of the new tile file
+	 * @param [in] progress Optional progress callback
+	 */
+	static void convert(const QString & offFile, const QString & tileFile,
+		const ProgressFunction & progress = ProgressFunction());
+
+private:
+	/**
+	 * @brief A vertex of the OFF file in the temporary vertex file
+	 */
+	struct VertexRecord
+	{
+		float xyz[3];
+		float normal[3];
+		QRgb color;
+		quint32 colored;
+	};
+
+	/**
+	 * @brief A triangle in the temporary triangle files
+	 */
+	struct TriangleRecord
+	{
+		quint32 cell;
+		quint32 vertices[3];
+		QRgb color;
+		quint32 colored;
+	};
+
+	/**
+	 * @brief Sums of all vertices merged by the clustering
+	 */
+	struct Cluster
+	{
+		double position[3];
+		double normal[3];
+		double color[4];
+		int count;
+	};
+
+	/**
+	 * @brief A tile which is written but whose parent is still missing
+	 */
+	struct PendingTile
+	{
+		quint32 cell;
+		int index;
+	};
+
+	TileConverter(const ProgressFunction & progress);
+
+	/**
+	 * @brief Runs all conversion steps
+	 */
+	void run(const QString & offFile, const QString & tileFile);
+
+	/**
+	 * @brief Reads the vertices into the temporary vertex file
+	 */
+	void readVertices(QTextStream *stream, int count);
+
+	/**
+	 * @brief Reads the polygons into the temporary triangle file
+	 */
+	void readPolygons(QTextStream *stream, int count, QFile *triangleFile);
+
+	/**
+	 * @brief Sorts the triangles by their cell into the sorted file
+	 */
+	void sortTriangles(QFile *triangleFile, QFile *sortedFile);
+
+	/**
+	 * @brief Writes one leaf tile for each grid cell
+	 */
+	void writeLeaves(const TriangleRecord *triangles);
+
+	/**
+	 * @brief Merges the tiles of one level into simplified parent tiles
+	 */
+	void writeParents(int level);
+
+	/**
+	 * @brief Writes the vertex data of a tile and appends it to the table
+	 *
+	 * @param [in] positions Three floats per vertex
+	 * @param [in] normals Three floats per vertex, normalized
+	 * @param [in] colors One color per vertex, only used for colored scenes
+	 * @param [in] opaqueCount Number of vertices of the opaque triangles,
+	 *                         which are stored before the translucent ones
+	 * @param [in] level Level of the tile, zero for the root
+	 * @param [in] error Geometric error of the tile
+	 * @return Index of the new tile
+	 */
+	int writeTile(const QVector<float> & positions, const QVector<float> & normals,
+		const QVector<QRgb> & colors, int opaqueCount, int level, float error);
+
+	/**
+	 * @brief Reads the vertex data of a written tile back
+	 */
+	void readTile(int index, QVector<float> *positions, QVector<float> *normals,
+		QVector<QRgb> *colors);
+
+	/**
+	 * @brief Returns the grid cell of a point as Morton code
+	 */
+	quint32 cellOf(const float *point) const;
+
+	/**
+	 * @brief Reports the progress and throws if the user aborted
+	 */
+	void report(int percent);
+
+	/**
+	 * @brief Target number of triangles per leaf tile
+	 */
+	static const int leafTriangles = 65536;
+
+	/**
+	 * @brief Maximum depth of the hierarchy
+	 */
+	static const int maxLevels = 7;
+
+	/**
+	 * @brief Resolution of the clustering grid of inner tiles
+	 */
+	static const int clusterGrid = 64;
+
+	/**
+	 * @brief Color of uncolored parts in colored scenes
+	 */
+	static QRgb defaultColor();
+
+	ProgressFunction progress;
+
+	/**
+	 * @brief Reads the lines, tokens and colors like OffScene::parseFile()
+	 */
+	OffScene parser;
+
+	/**
+	 * @brief Temporary storage of all vertices
+	 */
+	QTemporaryFile vertexFile;
+	VertexRecord *vertices;
+	int verticesCount;
+
+	/**
+	 * @brief Number of triangles per cell in ascending cell order
+	 */
+	QMap<quint32, quint32> cellCounts;
+	quint64 trianglesCount;
+
+	/**
+	 * @brief Scene bounds and grid of the leaf level
+	 */
+	float min[3];
+	float max[3];
+	int levels;
+	bool colored;
+
+	/**
+	 * @brief The new tile file, opened for writing and reading
+	 */
+	QFile output;
+	QVector<TileFile::Tile> tiles;
+
+	/**
+	 * @brief Tiles of the last written level
+	 */
+	QVector<PendingTile> pending;
+};
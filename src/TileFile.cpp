@@ -0,0 +1,135 @@
+#include <cstring>
+
+#include "TileFile.h"
+
+const char* TileFile::magic()
+{
+	return "OFFTILES";
+}
+
+QString TileFile::fileFilter()
+{
+	return tr("Tile Files (*.oft)");
+}
+
+TileFile::TileFile(const QString & fileName)
+{
+	data = nullptr;
+
+	file.setFileName(fileName);
+	if (!file.open(QIODevice::ReadOnly)) {
+		throw tr("Unable to open file ") + fileName;
+	}
+
+	if (file.read(reinterpret_cast<char*>(&header), sizeof(header)) != sizeof(header)
+			|| memcmp(header.magic, magic(), sizeof(header.magic)) != 0) {
+		throw tr("Wrong file format!");
+	}
+	if (header.version != currentVersion) {
+		throw tr("Unsupported tile file version!");
+	}
+
+	// Read and check the tile table
+	quint64 size = file.size();
+	quint64 tableBytes = static_cast<quint64>(header.tilesCount) * sizeof(Tile);
+	if (header.tilesCount == 0 || header.tableOffset > size || tableBytes > size - header.tableOffset
+			|| header.rootTile < 0 || header.rootTile >= static_cast<qint32>(header.tilesCount)) {
+		throw tr("The tile table is damaged!");
+	}
+	tiles.resize(header.tilesCount);
+	if (!file.seek(header.tableOffset)
+			|| file.read(reinterpret_cast<char*>(tiles.data()), tableBytes) != static_cast<qint64>(tableBytes)) {
+		throw tr("The tile table is damaged!");
+	}
+	for (int i = 0; i < tiles.size(); i++) {
+		const Tile & t = tiles[i];
+		quint64 end = t.offset + tileBytes(i);
+		qint64 lastChild = static_cast<qint64>(t.firstChild) + t.childCount;
+		if (end > header.tableOffset || (t.childCount > 0 && (t.firstChild < 0 || lastChild > tiles.size()))) {
+			throw tr("The tile table is damaged!");
+		}
+	}
+
+	// The operating system loads and evicts the pages of the mapping,
+	// so the vertex data does not count against our own memory
+	data = file.map(0, size);
+}
+
+TileFile::~TileFile()
+{
+	if (data) {
+		file.unmap(const_cast<uchar*>(data));
+	}
+}
+
+bool TileFile::isColored() const
+{
+	return header.flags & Colored;
+}
+
+const float* TileFile::min() const
+{
+	return header.min;
+}
+
+const float* TileFile::max() const
+{
+	return header.max;
+}
+
+int TileFile::tilesCount() const
+{
+	return tiles.size();
+}
+
+int TileFile::rootTile() const
+{
+	return header.rootTile;
+}
+
+const TileFile::Tile & TileFile::tile(int i) const
+{
+	return tiles[i];
+}
+
+qint64 TileFile::tileBytes(int i) const
+{
+	qint64 vertices = static_cast<qint64>(tiles[i].opaqueCount) + tiles[i].translucentCount;
+	return vertices * (6 * sizeof(float) + (isColored() ? 4 : 0));
+}
+
+RenderGeometry* TileFile::loadTile(int i) const
+{
+	const Tile & t = tiles[i];
+	int vertices = t.opaqueCount + t.translucentCount;
+
+	RenderGeometry *geometry = new RenderGeometry(RenderGeometry::Triangles, true, isColored());
+	geometry->allocate(QVector<int>(1, t.opaqueCount), QVector<int>(1, t.translucentCount));
+
+	qint64 floatBytes = static_cast<qint64>(vertices) * 3 * sizeof(float);
+	if (data) {
+		const uchar *source = data + t.offset;
+		memcpy(geometry->positions(), source, floatBytes);
+		memcpy(geometry->normals(), source + floatBytes, floatBytes);
+		if (isColored()) {
+			memcpy(geometry->colors(), source + 2 * floatBytes, 4 * vertices);
+		}
+	} else {
+		// Without a mapping the reads must not be interleaved
+		QMutexLocker locker(&mutex);
+		bool ok = file.seek(t.offset);
+		ok = ok && file.read(reinterpret_cast<char*>(geometry->positions()), floatBytes) == floatBytes;
+		ok = ok && file.read(reinterpret_cast<char*>(geometry->normals()), floatBytes) == floatBytes;
+		if (isColored()) {
+			ok = ok && file.read(reinterpret_cast<char*>(geometry->colors()), 4 * vertices) == 4 * vertices;
+		}
+		if (!ok) {
+			// Draw nothing instead of garbage
+			delete geometry;
+			geometry = new RenderGeometry(RenderGeometry::Triangles, true, isColored());
+			geometry->allocate(QVector<int>(1, 0), QVector<int>(1, 0));
+		}
+	}
+
+	return geometry;
+}
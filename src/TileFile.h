@@ -0,0 +1,185 @@
+#pragma once
+
+#include <QtCore>
+
+#include "RenderGeometry.h"
+
+/**
+ * @brief Tiled on-disk representation of a scene for out-of-core rendering
+ *
+ * The file contains a hierarchy of tiles. The leaves partition the
+ * triangles of the original scene along a regular grid, each inner tile
+ * contains a simplified version of the geometry of its children. All tiles
+ * store ready to draw vertex arrays (positions, normals and optional colors),
+ * so loading a tile is a plain copy from the memory mapped file.
+ *
+ * File layout (native byte order):
+ * - Header
+ * - The vertex data of all tiles
+ * - The table with one Tile record per tile, starting at Header::tableOffset
+ *
+ * Files are created by TileConverter. Only the header and the tile table are
+ * kept in memory, the vertex data is loaded on request by TileStreamer.
+ *
+ * @see TileConverter
+ * @see TileStreamer
+ */
+class TileFile
+{
+	Q_DECLARE_TR_FUNCTIONS(TileFile)
+
+public:
+	/**
+	 * @brief The header at the start of the file
+	 */
+	struct Header
+	{
+		char magic[8];
+		quint32 version;
+		quint32 flags;
+		float min[3];
+		float max[3];
+		quint64 tableOffset;
+		quint32 tilesCount;
+		qint32 rootTile;
+	};
+
+	/**
+	 * @brief One tile of the hierarchy
+	 *
+	 * The vertex data of a tile starts at offset and contains the positions
+	 * (three floats per vertex), the normals (three floats per vertex) and,
+	 * for colored files, the RGBA colors (four bytes per vertex). Every three
+	 * vertices form a triangle, opaque triangles are stored first.
+	 */
+	struct Tile
+	{
+		float min[3];
+		float max[3];
+		quint64 offset;
+		quint32 opaqueCount;
+		quint32 translucentCount;
+		qint32 firstChild;
+		quint32 childCount;
+		quint32 level;
+
+		/**
+		 * @brief Maximum distance between the tile and the original surface
+		 *
+		 * Zero for leaf tiles.
+		 */
+		float error;
+	};
+
+	/**
+	 * @brief Header flags
+	 */
+	enum Flags {
+		Colored = 1
+	};
+
+	/**
+	 * @brief Current version of the file format
+	 */
+	static const quint32 currentVersion = 1;
+
+	/**
+	 * @brief Returns the magic bytes at the start of each tile file
+	 */
+	static const char* magic();
+
+	/**
+	 * @brief Returns the file dialog filter for tile files
+	 */
+	static QString fileFilter();
+
+	/**
+	 * @brief Constructor
+	 *
+	 * Opens the file, reads the tile table and maps the file into memory.
+	 * Throws a QString with an error message if the file is invalid.
+	 *
+	 * @param [in] fileName Path to the tile file
+	 */
+	TileFile(const QString & fileName);
+
+	/**
+	 * @brief Destructor
+	 */
+	~TileFile();
+
+	/**
+	 * @brief Are the tiles colored?
+	 */
+	bool isColored() const;
+
+	/**
+	 * @brief Returns the bounding box of the whole scene
+	 */
+	const float* min() const;
+	const float* max() const;
+
+	/**
+	 * @brief Returns the number of tiles
+	 */
+	int tilesCount() const;
+
+	/**
+	 * @brief Returns the index of the coarsest tile
+	 */
+	int rootTile() const;
+
+	/**
+	 * @brief Getter for the tiles
+	 *
+	 * @param [in] i Index of the tile, from 0 to tilesCount()-1
+	 * @return The selected tile
+	 */
+	const Tile & tile(int i) const;
+
+	/**
+	 * @brief Reads the vertex data of a tile
+	 *
+	 * Can be called from any thread. The geometry contains a single range
+	 * which is not assigned to any chunk.
+	 *
+	 * @param [in] i Index of the tile
+	 * @return The new geometry, the caller takes the ownership
+	 */
+	RenderGeometry* loadTile(int i) const;
+
+	/**
+	 * @brief Returns the number of bytes of a tile's vertex data
+	 */
+	qint64 tileBytes(int i) const;
+
+private:
+	// Do not allow copy constructor and the assignment operator
+	TileFile(const TileFile & other);
+	TileFile& operator=(const TileFile& other);
+
+	/**
+	 * @brief The opened file
+	 */
+	mutable QFile file;
+
+	/**
+	 * @brief Serializes the reads if the file could not be mapped
+	 */
+	mutable QMutex mutex;
+
+	/**
+	 * @brief The mapped file or null
+	 */
+	const uchar *data;
+
+	/**
+	 * @brief The file header
+	 */
+	Header header;
+
+	/**
+	 * @brief The tile table
+	 */
+	QVector<Tile> tiles;
+};
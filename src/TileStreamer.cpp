@@ -0,0 +1,212 @@
+#include <algorithm>
+#include <cmath>
+
+#include <QtConcurrent>
+
+#include "TileStreamer.h"
+#include "Trace.h"
+
+TileStreamer::TileStreamer(const TileFile *file, qint64 memoryBudget, QObject *parent)
+	: QObject(parent)
+{
+	this->file = file;
+	budget = memoryBudget;
+	resident = 0;
+	residentCount = 0;
+	loading = 0;
+	frame = 0;
+
+	TileState empty = { nullptr, 0, 0, false };
+	states.fill(empty, file->tilesCount());
+
+	// Reading is mostly waiting for the disk, a few threads are enough
+	pool.setMaxThreadCount(2);
+}
+
+TileStreamer::~TileStreamer()
+{
+	pool.waitForDone();
+
+	for (int i = 0; i < loaded.size(); i++) {
+		delete loaded[i].second;
+	}
+	for (int i = 0; i < states.size(); i++) {
+		delete states[i].buffer;
+	}
+}
+
+qint64 TileStreamer::residentBytes() const
+{
+	return resident;
+}
+
+int TileStreamer::residentTiles() const
+{
+	return residentCount;
+}
+
+int TileStreamer::loadingTiles() const
+{
+	return loading;
+}
+
+void TileStreamer::selectTiles(const QMatrix4x4 & matrix, int viewportHeight,
+	QVector<const GeometryBuffer*> *visible)
+{
+	visible->clear();
+	requests.clear();
+	frame++;
+
+	uploadLoadedTiles();
+
+	// Converts a length in scene units at clip distance w = 1 into pixels
+	QVector4D row = matrix.row(1);
+	float pixelsPerUnit = 0.5f * viewportHeight * QVector3D(row.x(), row.y(), row.z()).length();
+
+	Frustum frustum(matrix);
+	selectTile(file->rootTile(), frustum, matrix, pixelsPerUnit, visible);
+
+	startLoads();
+	evictTiles();
+}
+
+void TileStreamer::selectTile(int index, const Frustum & frustum, const QMatrix4x4 & matrix,
+	float pixelsPerUnit, QVector<const GeometryBuffer*> *visible)
+{
+	const TileFile::Tile & tile = file->tile(index);
+	if (!frustum.intersects(tile.min, tile.max)) {
+		return;
+	}
+
+	TileState & state = states[index];
+	state.lastUsed = frame;
+	if (!state.buffer) {
+		requests.append(index);
+		return;
+	}
+
+	if (tile.childCount > 0 && needsRefinement(tile, matrix, pixelsPerUnit)) {
+		// Switch to the children only when all visible ones are available,
+		// until then the coarse tile stays on the screen
+		bool ready = true;
+		for (quint32 c = 0; c < tile.childCount; c++) {
+			int child = tile.firstChild + c;
+			const TileFile::Tile & childTile = file->tile(child);
+			if (frustum.intersects(childTile.min, childTile.max)) {
+				states[child].lastUsed = frame;
+				if (!states[child].buffer) {
+					requests.append(child);
+					ready = false;
+				}
+			}
+		}
+
+		if (ready) {
+			for (quint32 c = 0; c < tile.childCount; c++) {
+				selectTile(tile.firstChild + c, frustum, matrix, pixelsPerUnit, visible);
+			}
+			return;
+		}
+	}
+
+	visible->append(state.buffer);
+}
+
+bool TileStreamer::needsRefinement(const TileFile::Tile & tile, const QMatrix4x4 & matrix,
+	float pixelsPerUnit) const
+{
+	// Estimate the distance of the nearest box point by the clip w of
+	// the center minus the radius of the box
+	float center[3];
+	float radius = 0.0f;
+	for (int k = 0; k < 3; k++) {
+		center[k] = 0.5f * (tile.min[k] + tile.max[k]);
+		float half = 0.5f * (tile.max[k] - tile.min[k]);
+		radius += half * half;
+	}
+	radius = std::sqrt(radius);
+
+	QVector4D w = matrix.row(3);
+	float distance = w.x()*center[0] + w.y()*center[1] + w.z()*center[2] + w.w();
+	distance -= radius * QVector3D(w.x(), w.y(), w.z()).length();
+	if (distance <= 0.0f) {
+		// The camera is inside of the box
+		return true;
+	}
+
+	return tile.error * pixelsPerUnit / distance > maxPixelError;
+}
+
+void TileStreamer::uploadLoadedTiles()
+{
+	QVector<QPair<int, RenderGeometry*> > ready;
+	{
+		QMutexLocker locker(&mutex);
+		ready.swap(loaded);
+	}
+
+	for (int i = 0; i < ready.size(); i++) {
+		TileState & state = states[ready[i].first];
+		state.loading = false;
+		loading--;
+
+		state.bytes = ready[i].second->bytes();
+		state.buffer = new GeometryBuffer(ready[i].second);
+		resident += state.bytes;
+		residentCount++;
+	}
+}
+
+void TileStreamer::startLoads()
+{
+	// Coarse tiles first, so something is visible as early as possible
+	std::sort(requests.begin(), requests.end(), [this](int a, int b) {
+		return file->tile(a).level < file->tile(b).level;
+	});
+
+	for (int i = 0; i < requests.size() && loading < maxLoads; i++) {
+		int index = requests[i];
+		if (states[index].loading || states[index].buffer) {
+			continue;
+		}
+
+		states[index].loading = true;
+		loading++;
+		QtConcurrent::run(&pool, [this, index]() {
+			TRACE_ZONE("TileFile::loadTile");
+			RenderGeometry *geometry = file->loadTile(index);
+			{
+				QMutexLocker locker(&mutex);
+				loaded.append(qMakePair(index, geometry));
+			}
+			emit tileLoaded();
+		});
+	}
+}
+
+void TileStreamer::evictTiles()
+{
+	if (resident <= budget) {
+		return;
+	}
+
+	// Tiles of the current frame and the root are never released
+	QVector<int> candidates;
+	for (int i = 0; i < states.size(); i++) {
+		if (states[i].buffer && states[i].lastUsed < frame && i != file->rootTile()) {
+			candidates.append(i);
+		}
+	}
+	std::sort(candidates.begin(), candidates.end(), [this](int a, int b) {
+		return states[a].lastUsed < states[b].lastUsed;
+	});
+
+	for (int i = 0; i < candidates.size() && resident > budget; i++) {
+		TileState & state = states[candidates[i]];
+		delete state.buffer;
+		state.buffer = nullptr;
+		resident -= state.bytes;
+		residentCount--;
+		state.bytes = 0;
+	}
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <QtCore>
+
+#include "TileFile.h"
+#include "GeometryBuffer.h"
+#include "Frustum.h"
+
+/**
+ * @brief Loads the tiles of a TileFile on demand
+ *
+ * For each frame the tile hierarchy is traversed from the root. Tiles outside
+ * of the view frustum are skipped, tiles whose simplification error would be
+ * visible on the screen are replaced by their children. Missing tiles are read
+ * by background threads, until they arrive the coarser parent is drawn.
+ *
+ * The uploaded tiles are kept as long as they fit into the memory budget.
+ * If the budget is exceeded, the tiles which were not used for the longest
+ * time are released.
+ *
+ * All methods except the constructor must be called with the OpenGL context
+ * of the widget being current.
+ *
+ * @see TileFile
+ */
+class TileStreamer : public QObject
+{
+	Q_OBJECT
+
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param [in] file The tile file, must live longer than the streamer
+	 * @param [in] memoryBudget Maximum number of bytes of all uploaded tiles
+	 * @param [in] parent Parent object
+	 */
+	TileStreamer(const TileFile *file, qint64 memoryBudget, QObject *parent = nullptr);
+
+	/**
+	 * @brief Destructor
+	 *
+	 * Waits for the running loads and frees all uploaded tiles.
+	 */
+	~TileStreamer();
+
+	/**
+	 * @brief Selects the tiles for the next frame
+	 *
+	 * Uploads the tiles which were loaded since the last call, requests the
+	 * missing tiles and releases old tiles if the budget is exceeded.
+	 *
+	 * @param [in] matrix Projection matrix multiplied with the model view matrix
+	 * @param [in] viewportHeight Height of the viewport in pixels
+	 * @param [out] visible Receives the tiles which should be drawn
+	 */
+	void selectTiles(const QMatrix4x4 & matrix, int viewportHeight,
+		QVector<const GeometryBuffer*> *visible);
+
+	/**
+	 * @brief Returns the number of bytes of all uploaded tiles
+	 */
+	qint64 residentBytes() const;
+
+	/**
+	 * @brief Returns the number of uploaded tiles
+	 */
+	int residentTiles() const;
+
+	/**
+	 * @brief Returns the number of tiles which are currently loaded
+	 */
+	int loadingTiles() const;
+
+signals:
+	/**
+	 * @brief Emitted from a background thread after a tile was loaded
+	 *
+	 * The next call of selectTiles() will upload the tile.
+	 */
+	void tileLoaded();
+
+private:
+	/**
+	 * @brief State of a single tile
+	 */
+	struct TileState
+	{
+		GeometryBuffer *buffer;
+		qint64 bytes;
+		quint64 lastUsed;
+		bool loading;
+	};
+
+	/**
+	 * @brief Visits a tile and its children
+	 */
+	void selectTile(int index, const Frustum & frustum, const QMatrix4x4 & matrix,
+		float pixelsPerUnit, QVector<const GeometryBuffer*> *visible);
+
+	/**
+	 * @brief Is the error of a tile larger than the allowed screen error?
+	 */
+	bool needsRefinement(const TileFile::Tile & tile, const QMatrix4x4 & matrix,
+		float pixelsPerUnit) const;
+
+	/**
+	 * @brief Uploads all tiles which were loaded in the background
+	 */
+	void uploadLoadedTiles();
+
+	/**
+	 * @brief Starts loading the requested tiles, coarse tiles first
+	 */
+	void startLoads();
+
+	/**
+	 * @brief Releases the least recently used tiles until the budget fits
+	 */
+	void evictTiles();
+
+	/**
+	 * @brief Maximum allowed simplification error in pixels
+	 */
+	static const int maxPixelError = 2;
+
+	/**
+	 * @brief Maximum number of tiles loaded at the same time
+	 */
+	static const int maxLoads = 8;
+
+	const TileFile *file;
+	qint64 budget;
+
+	/**
+	 * @brief One state for each tile of the file
+	 */
+	QVector<TileState> states;
+	qint64 resident;
+	int residentCount;
+	int loading;
+
+	/**
+	 * @brief Number of the current frame
+	 */
+	quint64 frame;
+
+	/**
+	 * @brief Tiles requested during the current frame
+	 */
+	QVector<int> requests;
+
+	/**
+	 * @brief Threads for reading tiles
+	 */
+	QThreadPool pool;
+
+	/**
+	 * @brief Loaded tiles waiting for the upload, protected by mutex
+	 */
+	QMutex mutex;
+	QVector<QPair<int, RenderGeometry*> > loaded;
+};
@@ -0,0 +1,122 @@
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "Trace.h"
+
+QAtomicInt Trace::active(0);
+QString Trace::fileName;
+QElapsedTimer Trace::timer;
+QMutex Trace::mutex;
+QVector<Trace::ThreadEvents*> Trace::threads;
+
+QStringList Trace::start(const QStringList & arguments)
+{
+	QStringList remaining;
+	QString file = QString::fromLocal8Bit(qgetenv("OFFVIEW_TRACE"));
+	for (int i = 0; i < arguments.size(); i++) {
+		if (arguments[i].startsWith("--trace=")) {
+			file = arguments[i].mid(8);
+		} else if (arguments[i] == "--trace" && i + 1 < arguments.size()) {
+			file = arguments[++i];
+		} else {
+			remaining.append(arguments[i]);
+		}
+	}
+
+	if (!file.isEmpty() && !active.load()) {
+		fileName = file;
+		timer.start();
+		active.store(1);
+		qAddPostRoutine(finish);
+	}
+	return remaining;
+}
+
+bool Trace::isActive()
+{
+	return active.load();
+}
+
+qint64 Trace::now()
+{
+	return timer.nsecsElapsed();
+}
+
+void Trace::record(const char *name, qint64 start)
+{
+	Event event;
+	event.name = name;
+	event.start = start;
+	event.duration = now() - start;
+	ThreadEvents *thread = currentThreadEvents();
+	QMutexLocker locker(&thread->mutex);
+	thread->events.append(event);
+}
+
+Trace::ThreadEvents* Trace::currentThreadEvents()
+{
+	static thread_local ThreadEvents *current = nullptr;
+	if (!current) {
+		QMutexLocker locker(&mutex);
+		current = new ThreadEvents();
+		current->id = threads.size() + 1;
+		QThread *thread = QThread::currentThread();
+		if (QCoreApplication::instance() && thread == QCoreApplication::instance()->thread()) {
+			current->name = "Main thread";
+		} else if (!thread->objectName().isEmpty()) {
+			current->name = thread->objectName();
+		} else {
+			current->name = QString("Worker %1").arg(current->id);
+		}
+		threads.append(current);
+	}
+	return current;
+}
+
+void Trace::finish()
+{
+	// Threads which are still running may end zones, so each list is locked while it is read
+	QMutexLocker locker(&mutex);
+	active.store(0);
+
+	QJsonArray events;
+	for (int t = 0; t < threads.size(); t++) {
+		ThreadEvents *thread = threads[t];
+		QMutexLocker threadLocker(&thread->mutex);
+
+		QJsonObject args;
+		args["name"] = thread->name;
+		QJsonObject metadata;
+		metadata["name"] = QString("thread_name");
+		metadata["ph"] = QString("M");
+		metadata["pid"] = 1;
+		metadata["tid"] = thread->id;
+		metadata["args"] = args;
+		events.append(metadata);
+
+		// Chrome expects microseconds
+		for (int i = 0; i < thread->events.size(); i++) {
+			const Event & event = thread->events[i];
+			QJsonObject zone;
+			zone["name"] = QString(event.name);
+			zone["cat"] = QString("offview");
+			zone["ph"] = QString("X");
+			zone["ts"] = event.start / 1000.0;
+			zone["dur"] = event.duration / 1000.0;
+			zone["pid"] = 1;
+			zone["tid"] = thread->id;
+			events.append(zone);
+		}
+	}
+
+	QJsonObject trace;
+	trace["traceEvents"] = events;
+	trace["displayTimeUnit"] = QString("ms");
+
+	QFile file(fileName);
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) ||
+			file.write(QJsonDocument(trace).toJson(QJsonDocument::Compact)) < 0) {
+		QTextStream(stderr) << tr("Unable to write trace file ") << fileName << endl;
+	}
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <QtCore>
+
+/**
+ * @brief Records scoped zones into a Chrome trace file
+ *
+ * A zone is created with the TRACE_ZONE macro at the start of a block and
+ * ends with the block. If tracing is active, the name, the thread, the
+ * start time and the duration of each zone are recorded. When the
+ * application exits, all zones are written as JSON file, which can be
+ * opened with chrome://tracing or https://ui.perfetto.dev.
+ *
+ * Tracing is started with the command line option --trace=FILE or the
+ * environment variable OFFVIEW_TRACE=FILE. If it is not active, a zone
+ * only checks a flag. Defining OFFVIEW_NO_TRACE removes all zones
+ * at compile time.
+ *
+ * Each thread records into its own list. The lock of the list is only
+ * contended while the trace file is written, because detached threads and
+ * other thread pools may still end zones then. The zone names must be
+ * string literals, only the pointer is stored.
+ */
+class Trace
+{
+	Q_DECLARE_TR_FUNCTIONS(Trace)
+
+public:
+	/**
+	 * @brief Records the lifetime of an object as zone
+	 */
+	class Zone
+	{
+	public:
+		/**
+		 * @brief Starts the zone
+		 *
+		 * @param [in] name Name of the zone, must be a string literal
+		 */
+		Zone(const char *name) : name(name), start(active.load() ? now() : -1)
+		{
+		}
+
+		/**
+		 * @brief Ends and records the zone
+		 */
+		~Zone()
+		{
+			if (start >= 0) {
+				record(name, start);
+			}
+		}
+
+	private:
+		const char *name;
+		qint64 start;
+	};
+
+	/**
+	 * @brief Starts tracing if the command line or the environment asks for it
+	 *
+	 * Must be called after the application object was created. The trace
+	 * file is written when the application object is destroyed.
+	 *
+	 * @param [in] arguments The arguments of the application
+	 * @return The arguments without the trace option
+	 */
+	static QStringList start(const QStringList & arguments);
+
+	/**
+	 * @brief Is tracing active?
+	 */
+	static bool isActive();
+
+private:
+	/**
+	 * @brief A finished zone
+	 */
+	struct Event
+	{
+		const char *name;
+		qint64 start;
+		qint64 duration;
+	};
+
+	/**
+	 * @brief The zones recorded by one thread
+	 */
+	struct ThreadEvents
+	{
+		int id;
+		QString name;
+
+		/**
+		 * @brief Protects the events against finish()
+		 */
+		QMutex mutex;
+		QVector<Event> events;
+	};
+
+	/**
+	 * @brief Returns the nanoseconds since the start of the trace
+	 */
+	static qint64 now();
+
+	/**
+	 * @brief Adds a zone to the list of the current thread
+	 */
+	static void record(const char *name, qint64 start);
+
+	/**
+	 * @brief Returns the list of the current thread, creates it if needed
+	 */
+	static ThreadEvents* currentThreadEvents();
+
+	/**
+	 * @brief Writes the trace file, called when the application exits
+	 */
+	static void finish();
+
+	static QAtomicInt active;
+	static QString fileName;
+	static QElapsedTimer timer;
+
+	/**
+	 * @brief Protects the list of threads
+	 */
+	static QMutex mutex;
+	static QVector<ThreadEvents*> threads;
+};
+
+#ifdef OFFVIEW_NO_TRACE
+#define TRACE_ZONE(name)
+#else
+#define TRACE_JOIN_NAME(a, b) a##b
+#define TRACE_ZONE_NAME(line) TRACE_JOIN_NAME(traceZone, line)
+#define TRACE_ZONE(name) Trace::Zone TRACE_ZONE_NAME(__LINE__)(name)
+#endif
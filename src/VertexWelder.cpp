@@ -0,0 +1,491 @@
+#include <cmath>
+#include <cstring>
+
+#include "VertexWelder.h"
+#include "Parallel.h"
+#include "Trace.h"
+
+VertexWelder::Report VertexWelder::clean(MeshData *mesh, float tolerance)
+{
+	TRACE_ZONE("VertexWelder::clean");
+	Report report;
+	report.vertices = tolerance > 0.0f ? weldNear(mesh, tolerance) : weld(mesh);
+	report.degeneratePolygons = removeDegeneratePolygons(mesh);
+	report.duplicatePolygons = removeDuplicatePolygons(mesh);
+	return report;
+}
+
+int VertexWelder::weld(MeshData *mesh)
+{
+	TRACE_ZONE("VertexWelder::weld");
+	int count = mesh->verticesCount();
+	if (count == 0) {
+		return 0;
+	}
+
+	QVector<uint> hashes(count);
+	Parallel::forBlocks(count, 1 << 14, [&](int begin, int end) {
+		for (int i = begin; i < end; i++) {
+			hashes[i] = hashVertex(*mesh, i);
+		}
+	});
+
+	QVector<int> first = firstOccurrences(hashes, [&](int a, int b) {
+		return sameVertex(*mesh, a, b);
+	});
+	return mergeVertices(mesh, first);
+}
+
+int VertexWelder::weldNear(MeshData *mesh, float tolerance)
+{
+	TRACE_ZONE("VertexWelder::weldNear");
+	int count = mesh->verticesCount();
+	if (count == 0) {
+		return 0;
+	}
+
+	// Far away or invalid positions share the outermost cells
+	const float *positions = mesh->positions.constData();
+	const double limit = double(qint64(1) << 40);
+	auto cell = [&](int i, int k) {
+		double value = std::floor(double(positions[3 * i + k]) / tolerance);
+		if (!(value > -limit)) {
+			return qint64(-limit);
+		}
+		return qint64(qMin(value, limit));
+	};
+
+	QVector<quint64> keys(count);
+	QVector<int> order(count);
+	Parallel::forBlocks(count, 1 << 14, [&](int begin, int end) {
+		for (int i = begin; i < end; i++) {
+			keys[i] = cellKey(cell(i, 0), cell(i, 1), cell(i, 2));
+			order[i] = i;
+		}
+	});
+
+	// The vertices of a cell form a run in ascending order
+	Parallel::sort(order, [&](int a, int b) {
+		return keys[a] < keys[b] || (keys[a] == keys[b] && a < b);
+	});
+
+	// The table maps each key to the start of its run, 0 marks an empty slot
+	int tableSize = 16;
+	while (tableSize < 2 * count) {
+		tableSize *= 2;
+	}
+	QVector<QAtomicInteger<quint64> > table(tableSize, QAtomicInteger<quint64>(0));
+	QVector<int> runs(tableSize);
+	Parallel::forBlocks(count, 1 << 14, [&](int begin, int end) {
+		for (int k = begin; k < end; k++) {
+			quint64 key = keys[order[k]];
+			if (k > 0 && keys[order[k - 1]] == key) {
+				continue;
+			}
+			uint slot = uint(key) & (tableSize - 1);
+			while (!table[slot].testAndSetOrdered(0, key)) {
+				slot = (slot + 1) & (tableSize - 1);
+			}
+			runs[slot] = k;
+		}
+	});
+
+	// Finds the first earlier vertex within the tolerance that is accepted
+	float squared = tolerance * tolerance;
+	auto closest = [&](int i, const std::function<bool(int j)> & accept) {
+		const float *p = positions + 3 * i;
+		qint64 x = cell(i, 0), y = cell(i, 1), z = cell(i, 2);
+		int best = i;
+		for (int n = 0; n < 27; n++) {
+			quint64 key = cellKey(x + n % 3 - 1, y + n / 3 % 3 - 1, z + n / 9 - 1);
+			uint slot = uint(key) & (tableSize - 1);
+			quint64 stored;
+			while ((stored = table[slot].load()) != 0 && stored != key) {
+				slot = (slot + 1) & (tableSize - 1);
+			}
+			if (stored == 0) {
+				continue;
+			}
+			for (int k = runs[slot]; k < count && keys[order[k]] == key; k++) {
+				int j = order[k];
+				if (j >= best) {
+					break;
+				}
+				const float *q = positions + 3 * j;
+				float dx = p[0] - q[0], dy = p[1] - q[1], dz = p[2] - q[2];
+				if (dx * dx + dy * dy + dz * dz <= squared && sameColor(*mesh, i, j) &&
+						accept(j)) {
+					best = j;
+				}
+			}
+		}
+		return best;
+	};
+
+	QVector<int> first(count);
+	Parallel::forBlocks(count, 1 << 12, [&](int begin, int end) {
+		for (int i = begin; i < end; i++) {
+			first[i] = closest(i, [](int) { return true; });
+		}
+	});
+
+	// Only vertices which were not merged themselves take others, so a row
+	// of close vertices is not pulled into one. The vertices are decided in
+	// ascending order, only those whose first close vertex was merged need
+	// another search.
+	for (int i = 0; i < count; i++) {
+		int j = first[i];
+		if (j != i && first[j] != j) {
+			first[i] = closest(i, [&](int k) { return first[k] == k; });
+		}
+	}
+	return mergeVertices(mesh, first);
+}
+
+int VertexWelder::removeDegeneratePolygons(MeshData *mesh)
+{
+	TRACE_ZONE("VertexWelder::removeDegeneratePolygons");
+	int pCount = mesh->polygonsCount();
+	QVector<int> counts(pCount);
+	QAtomicInt changed(0);
+	QAtomicInt removed(0);
+	Parallel::forBlocks(pCount, 1 << 14, [&](int begin, int end) {
+		int blockRemoved = 0;
+		for (int p = begin; p < end; p++) {
+			int size = mesh->offsets[p + 1] - mesh->offsets[p];
+			const int *corners = mesh->indices.constData() + mesh->offsets[p];
+			int unique = uniqueCorners(corners, size, nullptr);
+			counts[p] = unique >= 3 && hasArea(*mesh, corners, size) ? unique : 0;
+			if (counts[p] != size || counts[p] == 0) {
+				changed.store(1);
+			}
+			if (counts[p] == 0) {
+				blockRemoved++;
+			}
+		}
+		removed.fetchAndAddOrdered(blockRemoved);
+	});
+
+	if (changed.load()) {
+		compactPolygons(mesh, counts, true);
+	}
+	return removed.load();
+}
+
+int VertexWelder::removeDuplicatePolygons(MeshData *mesh)
+{
+	TRACE_ZONE("VertexWelder::removeDuplicatePolygons");
+	int pCount = mesh->polygonsCount();
+	if (pCount == 0) {
+		return 0;
+	}
+
+	QVector<uint> hashes(pCount);
+	Parallel::forBlocks(pCount, 1 << 14, [&](int begin, int end) {
+		QVector<int> corners;
+		for (int p = begin; p < end; p++) {
+			rotatedCorners(*mesh, p, &corners);
+			uint hash = 2166136261u;
+			for (int index : corners) {
+				hash = (hash ^ uint(index)) * 16777619u;
+				hash ^= hash >> 15;
+			}
+			hashes[p] = hash;
+		}
+	});
+
+	// Only called for equal hashes, so the copies are rare
+	QVector<int> first = firstOccurrences(hashes, [&](int a, int b) {
+		QVector<int> cornersA, cornersB;
+		rotatedCorners(*mesh, a, &cornersA);
+		rotatedCorners(*mesh, b, &cornersB);
+		return cornersA == cornersB;
+	});
+
+	QVector<int> counts(pCount);
+	int removed = 0;
+	for (int p = 0; p < pCount; p++) {
+		counts[p] = first[p] == p ? mesh->offsets[p + 1] - mesh->offsets[p] : 0;
+		if (counts[p] == 0) {
+			removed++;
+		}
+	}
+	if (removed > 0) {
+		compactPolygons(mesh, counts, false);
+	}
+	return removed;
+}
+
+QVector<int> VertexWelder::firstOccurrences(const QVector<uint> & hashes,
+	const std::function<bool(int a, int b)> & same)
+{
+	int count = hashes.size();
+
+	// A counting sort by partition keeps the ascending order within each partition
+	int partitions = Parallel::blockCount(count, 1 << 14);
+	QVector<int> starts(partitions + 1, 0);
+	for (int i = 0; i < count; i++) {
+		starts[hashes[i] % partitions + 1]++;
+	}
+	for (int p = 0; p < partitions; p++) {
+		starts[p + 1] += starts[p];
+	}
+	QVector<int> order(count);
+	QVector<int> next = starts;
+	for (int i = 0; i < count; i++) {
+		order[next[hashes[i] % partitions]++] = i;
+	}
+
+	// Each element points to the first equal element
+	QVector<int> first(count);
+	Parallel::forBlocks(partitions, 1, [&](int begin, int end) {
+		for (int p = begin; p < end; p++) {
+			int size = starts[p + 1] - starts[p];
+			int tableSize = 16;
+			while (tableSize < 2 * size) {
+				tableSize *= 2;
+			}
+			QVector<int> table(tableSize, -1);
+			for (int k = starts[p]; k < starts[p + 1]; k++) {
+				int i = order[k];
+				// The low bits chose the partition, the high bits the slot
+				uint slot = (hashes[i] >> 8) & (tableSize - 1);
+				while (table[slot] >= 0
+					&& (hashes[table[slot]] != hashes[i] || !same(table[slot], i))) {
+					slot = (slot + 1) & (tableSize - 1);
+				}
+				if (table[slot] < 0) {
+					table[slot] = i;
+				}
+				first[i] = table[slot];
+			}
+		}
+	});
+	return first;
+}
+
+int VertexWelder::mergeVertices(MeshData *mesh, const QVector<int> & first)
+{
+	int count = first.size();
+
+	// The kept vertices are numbered in their original order
+	QVector<int> number(count);
+	int kept = 0;
+	for (int i = 0; i < count; i++) {
+		if (first[i] == i) {
+			number[i] = kept++;
+		}
+	}
+	if (kept == count) {
+		return 0;
+	}
+
+	QVector<float> positions(3 * kept);
+	QVector<float> normals(mesh->normals.isEmpty() ? 0 : 3 * kept);
+	QVector<QColor> colors(mesh->vertexColors.isEmpty() ? 0 : kept);
+	Parallel::forBlocks(count, 1 << 14, [&](int begin, int end) {
+		for (int i = begin; i < end; i++) {
+			if (first[i] == i) {
+				int n = number[i];
+				memcpy(positions.data() + 3 * n, mesh->positions.constData() + 3 * i,
+					3 * sizeof(float));
+				if (!normals.isEmpty()) {
+					memcpy(normals.data() + 3 * n, mesh->normals.constData() + 3 * i,
+						3 * sizeof(float));
+				}
+				if (!colors.isEmpty()) {
+					colors[n] = mesh->vertexColors[i];
+				}
+			}
+		}
+	});
+	mesh->positions.swap(positions);
+	mesh->normals.swap(normals);
+	mesh->vertexColors.swap(colors);
+
+	int *indices = mesh->indices.data();
+	Parallel::forBlocks(mesh->indices.size(), 1 << 16, [&](int begin, int end) {
+		for (int k = begin; k < end; k++) {
+			indices[k] = number[first[indices[k]]];
+		}
+	});
+
+	return count - kept;
+}
+
+void VertexWelder::compactPolygons(MeshData *mesh, const QVector<int> & counts, bool dropRepeats)
+{
+	TRACE_ZONE("VertexWelder::compactPolygons");
+	const int minBlockSize = 1 << 14;
+	int pCount = counts.size();
+	int blocks = Parallel::blockCount(pCount, minBlockSize);
+
+	// The first polygon and the first index of each block
+	QVector<int> firstPolygon(blocks + 1, 0);
+	QVector<int> firstIndex(blocks + 1, 0);
+	Parallel::forEachBlock(pCount, minBlockSize, [&](int block, int begin, int end) {
+		for (int p = begin; p < end; p++) {
+			if (counts[p] > 0) {
+				firstPolygon[block + 1]++;
+				firstIndex[block + 1] += counts[p];
+			}
+		}
+	});
+	for (int b = 0; b < blocks; b++) {
+		firstPolygon[b + 1] += firstPolygon[b];
+		firstIndex[b + 1] += firstIndex[b];
+	}
+
+	int kept = firstPolygon[blocks];
+	QVector<int> offsets(kept + 1);
+	QVector<int> indices(firstIndex[blocks]);
+	QVector<QColor> colors(mesh->polygonColors.isEmpty() ? 0 : kept);
+	QVector<int> fileIndices(kept);
+	offsets[kept] = indices.size();
+	Parallel::forEachBlock(pCount, minBlockSize, [&](int block, int begin, int end) {
+		int n = firstPolygon[block];
+		int index = firstIndex[block];
+		for (int p = begin; p < end; p++) {
+			if (counts[p] == 0) {
+				continue;
+			}
+			const int *corners = mesh->indices.constData() + mesh->offsets[p];
+			if (dropRepeats) {
+				uniqueCorners(corners, mesh->offsets[p + 1] - mesh->offsets[p],
+					indices.data() + index);
+			} else {
+				memcpy(indices.data() + index, corners, counts[p] * sizeof(int));
+			}
+			if (!colors.isEmpty()) {
+				colors[n] = mesh->polygonColors[p];
+			}
+			fileIndices[n] = mesh->fileIndices.isEmpty() ? p : mesh->fileIndices[p];
+			offsets[n++] = index;
+			index += counts[p];
+		}
+	});
+
+	mesh->offsets.swap(offsets);
+	mesh->indices.swap(indices);
+	mesh->polygonColors.swap(colors);
+	mesh->fileIndices.swap(fileIndices);
+}
+
+int VertexWelder::uniqueCorners(const int *corners, int count, int *out)
+{
+	// Neighbouring kept corners differ, so only the last one can repeat the first
+	int unique = 0;
+	int last = -1;
+	for (int j = 0; j < count; j++) {
+		if (unique == 0 || corners[j] != last) {
+			last = corners[j];
+			unique++;
+		}
+	}
+	if (unique > 1 && last == corners[0]) {
+		unique--;
+	}
+
+	if (out) {
+		int written = 0;
+		for (int j = 0; j < count && written < unique; j++) {
+			if (written == 0 || corners[j] != out[written - 1]) {
+				out[written++] = corners[j];
+			}
+		}
+	}
+	return unique;
+}
+
+bool VertexWelder::hasArea(const MeshData & mesh, const int *corners, int count)
+{
+	// Repeated corners add nothing to either sum
+	const float *positions = mesh.positions.constData();
+	double area[3] = { 0.0, 0.0, 0.0 };
+	double edges = 0.0;
+	for (int j = 0; j < count; j++) {
+		const float *a = positions + 3 * corners[j];
+		const float *b = positions + 3 * corners[(j + 1) % count];
+		area[0] += (double(a[1]) - b[1]) * (double(a[2]) + b[2]);
+		area[1] += (double(a[2]) - b[2]) * (double(a[0]) + b[0]);
+		area[2] += (double(a[0]) - b[0]) * (double(a[1]) + b[1]);
+		for (int k = 0; k < 3; k++) {
+			edges += (double(b[k]) - a[k]) * (double(b[k]) - a[k]);
+		}
+	}
+	double squared = area[0] * area[0] + area[1] * area[1] + area[2] * area[2];
+	return squared > 1e-24 * edges * edges;
+}
+
+quint64 VertexWelder::cellKey(qint64 x, qint64 y, qint64 z)
+{
+	quint64 key = quint64(x) * 0x9e3779b97f4a7c15ull;
+	key = (key ^ quint64(y)) * 0xbf58476d1ce4e5b9ull;
+	key = (key ^ quint64(z)) * 0x94d049bb133111ebull;
+	key ^= key >> 31;
+	return key != 0 ? key : 1;
+}
+
+uint VertexWelder::hashVertex(const MeshData & mesh, int i)
+{
+	// -0 and 0 are the same position, so they need the same bits
+	uint hash = 2166136261u;
+	for (int k = 0; k < 3; k++) {
+		float value = mesh.positions[3 * i + k];
+		if (value == 0.0f) {
+			value = 0.0f;
+		}
+		uint bits;
+		memcpy(&bits, &value, sizeof(bits));
+		hash = (hash ^ bits) * 16777619u;
+		hash ^= hash >> 15;
+	}
+	if (!mesh.vertexColors.isEmpty()) {
+		hash = (hash ^ mesh.vertexColors[i].rgba()) * 16777619u;
+		hash ^= hash >> 15;
+	}
+	return hash;
+}
+
+bool VertexWelder::sameVertex(const MeshData & mesh, int a, int b)
+{
+	const float *pa = mesh.positions.constData() + 3 * a;
+	const float *pb = mesh.positions.constData() + 3 * b;
+	if (pa[0] != pb[0] || pa[1] != pb[1] || pa[2] != pb[2]) {
+		return false;
+	}
+	return sameColor(mesh, a, b);
+}
+
+bool VertexWelder::sameColor(const MeshData & mesh, int a, int b)
+{
+	return mesh.vertexColors.isEmpty() || mesh.vertexColors[a] == mesh.vertexColors[b];
+}
+
+void VertexWelder::rotatedCorners(const MeshData & mesh, int polygon, QVector<int> *corners)
+{
+	const int *begin = mesh.indices.constData() + mesh.offsets[polygon];
+	int count = mesh.offsets[polygon + 1] - mesh.offsets[polygon];
+
+	// Only rotations starting at the smallest vertex can be the smallest one
+	int start = 0;
+	for (int j = 1; j < count; j++) {
+		if (begin[j] < begin[start]) {
+			start = j;
+		} else if (begin[j] == begin[start]) {
+			for (int k = 1; k < count; k++) {
+				int candidate = begin[(j + k) % count];
+				int best = begin[(start + k) % count];
+				if (candidate != best) {
+					start = candidate < best ? j : start;
+					break;
+				}
+			}
+		}
+	}
+
+	corners->resize(count);
+	for (int j = 0; j < count; j++) {
+		(*corners)[j] = begin[(start + j) % count];
+	}
+}
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <functional>
+
+#include "MeshData.h"
+
+/**
+ * @brief Merges identical vertices of a mesh
+ *
+ * Formats like STL store every corner of every triangle on its own. The
+ * corners at the same position are merged into one vertex, so the
+ * polygons share their vertices, the smooth normals are averaged over all
+ * connected polygons and the wireframe has no duplicate lines.
+ *
+ * The vertices are distributed by their hash into partitions, which are
+ * processed in parallel with an open addressing table each. Within a
+ * partition the vertices are visited in ascending order, so each group of
+ * identical vertices is replaced by its first vertex and the result does
+ * not depend on the number of threads.
+ *
+ * clean() additionally merges vertices which are only close to each other
+ * and removes the polygons which collapse, have no area or exist twice
+ * afterwards.
+ */
+class VertexWelder
+{
+public:
+	/**
+	 * @brief What clean() has removed
+	 */
+	struct Report
+	{
+		int vertices;
+		int degeneratePolygons;
+		int duplicatePolygons;
+	};
+
+	/**
+	 * @brief Merges the vertices with the same position and color
+	 *
+	 * The vertex arrays are compacted in the order of the first
+	 * occurrence and the polygon indices are renumbered.
+	 *
+	 * @param [in, out] mesh The mesh whose vertices are merged
+	 * @return Number of removed vertices
+	 */
+	static int weld(MeshData *mesh);
+
+	/**
+	 * @brief Merges close vertices and removes broken polygons
+	 *
+	 * A vertex is merged into the first vertex of the same color which is
+	 * at most tolerance away and was kept itself, so no merged vertex is
+	 * moved further than the tolerance.
+	 * Afterwards repeated corners are removed from the polygons, polygons
+	 * with less than three corners or without area are dropped, as well as
+	 * polygons with the same corners in the same cyclic order and
+	 * orientation as an earlier polygon. The first one keeps its color, a
+	 * polygon with the opposite orientation is kept as its back side.
+	 *
+	 * @param [in, out] mesh The mesh which is cleaned
+	 * @param [in] tolerance Maximum distance of merged vertices, 0 for identical ones
+	 * @return The number of removed vertices and polygons
+	 */
+	static Report clean(MeshData *mesh, float tolerance);
+
+private:
+	/**
+	 * @brief Merges the vertices within the tolerance
+	 *
+	 * The vertices are sorted into cells of the size of the tolerance, so
+	 * each vertex only compares itself with the vertices of the 27
+	 * surrounding cells. The cells are found with a hash table that the
+	 * threads fill with compare and swap.
+	 *
+	 * @return Number of removed vertices
+	 */
+	static int weldNear(MeshData *mesh, float tolerance);
+
+	/**
+	 * @brief Removes repeated corners and polygons with less than three or without area
+	 *
+	 * @return Number of removed polygons
+	 */
+	static int removeDegeneratePolygons(MeshData *mesh);
+
+	/**
+	 * @brief Removes polygons with the same corners as an earlier one
+	 *
+	 * The corners must follow each other in the same direction, only the
+	 * first corner may differ.
+	 *
+	 * @return Number of removed polygons
+	 */
+	static int removeDuplicatePolygons(MeshData *mesh);
+
+	/**
+	 * @brief Finds the first equal element for each element
+	 *
+	 * @param [in] hashes The hash of each element, equal elements have equal hashes
+	 * @param [in] same Compares two elements, called from several threads
+	 * @return The index of the first equal element for each element
+	 */
+	static QVector<int> firstOccurrences(const QVector<uint> & hashes,
+		const std::function<bool(int a, int b)> & same);
+
+	/**
+	 * @brief Keeps the vertices with first[i] == i and renumbers the indices
+	 *
+	 * @param [in] first The kept vertex for each vertex, never behind the vertex
+	 * @return Number of removed vertices
+	 */
+	static int mergeVertices(MeshData *mesh, const QVector<int> & first);
+
+	/**
+	 * @brief Keeps the polygons with a corner count above zero
+	 *
+	 * @param [in] counts New number of corners of each polygon, 0 to remove it
+	 * @param [in] dropRepeats Whether repeated corners are skipped while copying
+	 */
+	static void compactPolygons(MeshData *mesh, const QVector<int> & counts, bool dropRepeats);
+
+	/**
+	 * @brief Returns the number of corners without repetitions
+	 *
+	 * A corner is repeated if it uses the same vertex as the previous
+	 * one, the last corner is also compared with the first one.
+	 *
+	 * @param [in] corners The vertex numbers of the polygon
+	 * @param [in] count Number of corners
+	 * @param [out] out Receives the remaining corners, may be null
+	 */
+	static int uniqueCorners(const int *corners, int count, int *out);
+
+	/**
+	 * @brief Has a polygon an area?
+	 *
+	 * The area vector is summed up like Newell's method does for the
+	 * normal. It must not vanish compared to the length of the edges, so
+	 * polygons whose corners lie on a line or on one point are found.
+	 *
+	 * @param [in] corners The vertex numbers of the polygon
+	 * @param [in] count Number of corners
+	 */
+	static bool hasArea(const MeshData & mesh, const int *corners, int count);
+
+	/**
+	 * @brief Returns the hash of a cell of the spatial grid
+	 *
+	 * Different cells may have the same hash, they share a bucket then.
+	 */
+	static quint64 cellKey(qint64 x, qint64 y, qint64 z);
+
+	/**
+	 * @brief Returns the hash of the position and color of a vertex
+	 */
+	static uint hashVertex(const MeshData & mesh, int i);
+
+	/**
+	 * @brief Have two vertices the same position and color?
+	 */
+	static bool sameVertex(const MeshData & mesh, int a, int b);
+
+	/**
+	 * @brief Have two vertices the same color?
+	 */
+	static bool sameColor(const MeshData & mesh, int a, int b);
+
+	/**
+	 * @brief Copies the vertex numbers of a polygon, starting at the smallest rotation
+	 *
+	 * The rotation is the smallest in lexicographic order, so polygons
+	 * which only start at another corner give the same numbers.
+	 */
+	static void rotatedCorners(const MeshData & mesh, int polygon, QVector<int> *corners);
+};
@@ -1,5 +1,6 @@
 #include <QtOpenGL>
 #include "WireframeMode.h"
+#include "Trace.h"
 
 QString WireframeMode::name() const
 {
@@ -20,39 +21,69 @@ void WireframeMode::unsetSettings()
 	glDisable(GL_BLEND);
 }
 
-void WireframeMode::draw(const IScene *scene, const QColor *defaultColor)
+RenderGeometry* WireframeMode::createGeometry(const IScene *scene, const SceneBvh *bvh,
+	const QColor *) const
 {
-	// Remeber our scene pointer and the display list id
-	static const IScene *oldScene = 0;
-	static unsigned int displayList = 0;
-	
-	// Do not place the color inside the display list because it can change!
+	TRACE_ZONE("WireframeMode::createGeometry");
+	// Each polygon edge becomes a separate line
+	return RenderGeometry::fromPolygons(scene, bvh, RenderGeometry::Lines, false, false,
+		[](const CPolygon *poly) {
+			return 2 * static_cast<int>(poly->vertexCount());
+		},
+		[](const CPolygon *) {
+			return false;
+		},
+		[](const CPolygon *poly, RenderGeometry *geometry, int first) {
+			float *positions = geometry->positions() + 3 * first;
+			size_t cv = poly->vertexCount();
+			for(size_t j=0; j<cv; j++) {
+				const float *a = poly->vertex(j)->vertex();
+				const float *b = poly->vertex((j + 1) % cv)->vertex();
+				for(int k=0; k<3; k++) {
+					positions[k] = a[k];
+					positions[3 + k] = b[k];
+				}
+				positions += 6;
+			}
+		}
+	);
+}
+
+RenderGeometry::Primitive WireframeMode::primitive() const
+{
+	return RenderGeometry::Lines;
+}
+
+bool WireframeMode::geometryUsesDefaultColor() const
+{
+	return false;
+}
+
+void WireframeMode::draw(const GeometryBuffer *geometry, const QVector<int> & parts,
+	const QColor *defaultColor)
+{
+	TRACE_ZONE("WireframeMode::draw");
+	// The color is not part of the geometry because it can change!
 	glColor3f(
 		defaultColor->redF(),
 		defaultColor->greenF(),
 		defaultColor->blueF()
 	);
 	
-	// Do we need to update the display list?
-	if (oldScene != scene || displayList == 0) {
-		displayList = glGenLists(1);
-		glNewList(displayList, GL_COMPILE);
-			int cp = scene->polygonsCount();
-			for(int i=0; i<cp; i++) {
-				const CPolygon *poly = scene->polygon(i);
-				size_t cv = poly->vertexCount();
-				glBegin( GL_LINE_LOOP );
-					for(size_t j=0; j<cv; j++) {
-						const CVertex *vert = poly->vertex(j);
-						const float *data = vert->vertex();
-						glVertex3fv(data);
-					}
-				glEnd();
-			}
-		glEndList ();
-		oldScene = scene;
-	}
-	
 	// Draw the object
-	glCallList(displayList);
+	geometry->draw(parts);
+}
+
+void WireframeMode::render(SoftwareRenderer *renderer, const RenderGeometry *geometry,
+	const QVector<int> & parts, const QColor *defaultColor) const
+{
+	TRACE_ZONE("WireframeMode::render");
+	QColor color = *defaultColor;
+	color.setAlpha(255);
+
+	renderer->setDepthTest(true);
+	renderer->setBlending(true);
+	renderer->setLighting(false, false);
+	renderer->setColor(color);
+	renderer->draw(geometry, parts);
 }
@@ -19,19 +19,33 @@
 #include <QtOpenGL>
 
 #include "MainWindow.h"
+#include "CommandLine.h"
+#include "Trace.h"
 
 /**
 * @brief Creates our QApplication object and its main window.
 *
 * Before creating our main window, we check first if the current system has
 * OpenGL support; if not, terminate the application with an error message.
+* Batch jobs like --render run without a window, see CommandLine.
+* The option --trace=FILE records a timeline of the application, see Trace.
 * 
 * @param[in] argc Number of arguments
 * @param[in] argv Argument vector
 */
 int main(int argc, char** argv)
 {
+	// Batch jobs must also work without a display
+	if (CommandLine::isBatchJob(argc, argv)) {
+		QCoreApplication app(argc, argv);
+		return CommandLine::run(Trace::start(app.arguments()));
+	}
+
 	QApplication app(argc, argv);
+	// Used by QSettings and the cache directory
+	QApplication::setOrganizationName("OffView");
+	QApplication::setApplicationName("OffView");
+	QStringList arguments = Trace::start(app.arguments());
 	
 	// Check for OpenGL support
 	if(!QGLFormat::hasOpenGL()) {
@@ -44,8 +58,8 @@ int main(int argc, char** argv)
 
 	// Check for a supplied file from the arguments
 	QString file = "";
-	if (argc > 1) {
-		file = argv[1];
+	if (arguments.size() > 1) {
+		file = arguments[1];
 	}
 	
 	// Set up main window and start the application
@@ -0,0 +1,79 @@
+#include "MeshComponentsTest.h"
+#include "MeshComponents.h"
+#include "OffScene.h"
+#include "MeshData.h"
+
+void MeshComponentsTest::labelsComponents()
+{
+	OffScene scene(QFINDTESTDATA("data/components.off"), false);
+	MeshComponents components(&scene);
+	QCOMPARE(components.count(), 3);
+	int labels[] = {1, 0, 2, 1, 0, 1, 0, 1, 0, 1, 2};
+	for (int i = 0; i < scene.polygonsCount(); i++) {
+		QCOMPARE(components.componentOf(i), labels[i]);
+	}
+}
+
+void MeshComponentsTest::sortsPolygons()
+{
+	OffScene scene(QFINDTESTDATA("data/components.off"), false);
+	MeshComponents components(&scene);
+	int order[] = {1, 4, 6, 8, 0, 3, 5, 7, 9, 2, 10};
+	for (int i = 0; i < scene.polygonsCount(); i++) {
+		QCOMPARE(components.polygonAt(i), order[i]);
+	}
+	int first[] = {0, 4, 9};
+	int count[] = {4, 5, 2};
+	for (int i = 0; i < components.count(); i++) {
+		QCOMPARE(components.component(i).first, first[i]);
+		QCOMPARE(components.component(i).count, count[i]);
+	}
+}
+
+void MeshComponentsTest::boundsComponents()
+{
+	OffScene scene(QFINDTESTDATA("data/components.off"), false);
+	MeshComponents components(&scene);
+	float min[3][3] = {{0.0f, 0.0f, 0.0f}, {3.0f, 0.0f, 0.0f}, {0.0f, 5.0f, 0.0f}};
+	float max[3][3] = {{1.0f, 1.0f, 1.0f}, {6.0f, 5.0f, 5.0f}, {1.0f, 6.0f, 0.0f}};
+	for (int i = 0; i < components.count(); i++) {
+		for (int k = 0; k < 3; k++) {
+			QCOMPARE(components.component(i).min[k], min[i][k]);
+			QCOMPARE(components.component(i).max[k], max[i][k]);
+		}
+	}
+}
+
+void MeshComponentsTest::labelsLargeScenes()
+{
+	// Separate triangles in the reverse order of their vertices, every
+	// second one is joined to the one before by a quad
+	const int triangles = 100000;
+	MeshData mesh;
+	for (int i = 0; i < triangles; i++) {
+		mesh.positions << float(i) << 0.0f << 0.0f << float(i) + 0.5f << 0.0f << 0.0f
+			<< float(i) << 1.0f << 0.0f;
+	}
+	mesh.offsets << 0;
+	for (int i = triangles - 1; i >= 0; i--) {
+		mesh.indices << 3 * i << 3 * i + 1 << 3 * i + 2;
+		mesh.offsets << mesh.indices.size();
+	}
+	for (int i = 1; i < triangles; i += 2) {
+		mesh.indices << 3 * i - 2 << 3 * i << 3 * i + 2 << 3 * i - 1;
+		mesh.offsets << mesh.indices.size();
+	}
+	QScopedPointer<IScene> scene(OffScene::fromMesh(mesh));
+
+	MeshComponents components(scene.data());
+	QCOMPARE(components.count(), triangles / 2);
+	for (int i = 0; i < triangles; i++) {
+		QCOMPARE(components.componentOf(triangles - 1 - i), i / 2);
+	}
+	for (int i = 0; i < components.count(); i++) {
+		QCOMPARE(components.component(i).count, 3);
+		QCOMPARE(components.polygonAt(3 * i), triangles - 2 - 2 * i);
+		QCOMPARE(components.polygonAt(3 * i + 1), triangles - 1 - 2 * i);
+		QCOMPARE(components.polygonAt(3 * i + 2), triangles + i);
+	}
+}
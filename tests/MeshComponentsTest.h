@@ -0,0 +1,32 @@
+#pragma once
+
+#include <QtTest>
+
+/**
+ * @brief Tests of MeshComponents
+ */
+class MeshComponentsTest : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	/**
+	 * @brief Polygons are labelled by the smallest vertex of their component
+	 */
+	void labelsComponents();
+
+	/**
+	 * @brief The polygons of a component follow each other in their scene order
+	 */
+	void sortsPolygons();
+
+	/**
+	 * @brief Each component gets the box of its polygons
+	 */
+	void boundsComponents();
+
+	/**
+	 * @brief Enough polygons for several threads give the same numbers
+	 */
+	void labelsLargeScenes();
+};
@@ -0,0 +1,95 @@
+#include <cmath>
+
+#include "MeshStatisticsTest.h"
+#include "MeshStatistics.h"
+#include "HalfEdgeMesh.h"
+#include "OffScene.h"
+#include "MeshData.h"
+
+void MeshStatisticsTest::measuresClosedMesh()
+{
+	OffScene scene(QFINDTESTDATA("data/colored.off"), false);
+	MeshStatistics::Report report = MeshStatistics::compute(&scene, *scene.halfEdges(), -1);
+	QCOMPARE(report.vertices, 4);
+	QCOMPARE(report.edges, 6);
+	QCOMPARE(report.polygons, 4);
+	QCOMPARE(report.components, 1);
+	QCOMPARE(report.boundaryEdges, 0);
+	QCOMPARE(report.nonManifoldEdges, 0);
+	QCOMPARE(report.nonManifoldVertices, 0);
+	QCOMPARE(report.boundaryLoops, 0);
+	QCOMPARE(report.eulerCharacteristic, 2);
+	QCOMPARE(report.genus, 0);
+	QCOMPARE(report.valences, QVector<int>() << 0 << 0 << 0 << 4);
+
+	// Three right triangles and an equilateral one with sides of sqrt(2)
+	QCOMPARE(report.area, 1.5 + std::sqrt(3.0) / 2.0);
+	QCOMPARE(report.volume, 1.0 / 6.0);
+	for (int k = 0; k < 3; k++) {
+		QCOMPARE(report.min[k], 0.0f);
+		QCOMPARE(report.max[k], 1.0f);
+	}
+	QCOMPARE(report.minEdgeLength, 1.0);
+	QCOMPARE(report.maxEdgeLength, std::sqrt(2.0));
+	QCOMPARE(report.meanEdgeLength, (1.0 + std::sqrt(2.0)) / 2.0);
+	QCOMPARE(report.edgeLengthDeviation, (std::sqrt(2.0) - 1.0) / 2.0);
+	QVERIFY(!MeshStatistics::describe(report).isEmpty());
+}
+
+void MeshStatisticsTest::measuresOpenMesh()
+{
+	// A grid of quads in the unit square, enough for several blocks
+	const int n = 300;
+	MeshData mesh;
+	for (int y = 0; y <= n; y++) {
+		for (int x = 0; x <= n; x++) {
+			mesh.positions << float(x) / n << float(y) / n << 0.0f;
+		}
+	}
+	mesh.offsets << 0;
+	for (int y = 0; y < n; y++) {
+		for (int x = 0; x < n; x++) {
+			int v = y * (n + 1) + x;
+			mesh.indices << v << v + 1 << v + n + 2 << v + n + 1;
+			mesh.offsets << mesh.indices.size();
+		}
+	}
+	QScopedPointer<OffScene> scene(OffScene::fromMesh(mesh));
+
+	MeshStatistics::Report report = MeshStatistics::compute(scene.data(), *scene->halfEdges(), -1);
+	QCOMPARE(report.vertices, (n + 1) * (n + 1));
+	QCOMPARE(report.edges, 2 * n * (n + 1));
+	QCOMPARE(report.polygons, n * n);
+	QCOMPARE(report.components, 1);
+	QCOMPARE(report.boundaryEdges, 4 * n);
+	QCOMPARE(report.nonManifoldEdges, 0);
+	QCOMPARE(report.nonManifoldVertices, 0);
+	QCOMPARE(report.boundaryLoops, 1);
+	QCOMPARE(report.eulerCharacteristic, 1);
+	QCOMPARE(report.genus, 0);
+	QCOMPARE(report.valences.value(4), n * n);
+	QVERIFY(std::fabs(report.area - 1.0) < 1e-6);
+	QVERIFY(std::fabs(report.volume) < 1e-6);
+	QVERIFY(std::fabs(report.minEdgeLength - 1.0 / n) < 1e-6);
+	QVERIFY(std::fabs(report.maxEdgeLength - 1.0 / n) < 1e-6);
+}
+
+void MeshStatisticsTest::detectsNonManifoldVertices()
+{
+	OffScene scene(QFINDTESTDATA("data/components.off"), false);
+	MeshStatistics::Report report = MeshStatistics::compute(&scene, *scene.halfEdges(), -1);
+	QCOMPARE(report.vertices, 13);
+	QCOMPARE(report.edges, 18);
+	QCOMPARE(report.polygons, 11);
+	QCOMPARE(report.components, 3);
+	QCOMPARE(report.boundaryEdges, 3);
+	QCOMPARE(report.nonManifoldEdges, 0);
+	QCOMPARE(report.nonManifoldVertices, 1);
+	QCOMPARE(report.eulerCharacteristic, 6);
+	QCOMPARE(report.boundaryLoops, -1);
+	QCOMPARE(report.genus, -1);
+
+	// A known number of components is taken as it is
+	report = MeshStatistics::compute(&scene, *scene.halfEdges(), 7);
+	QCOMPARE(report.components, 7);
+}
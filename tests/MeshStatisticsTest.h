@@ -0,0 +1,27 @@
+#pragma once
+
+#include <QtTest>
+
+/**
+ * @brief Tests of MeshStatistics
+ */
+class MeshStatisticsTest : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	/**
+	 * @brief Size, edge lengths and topology of a closed tetrahedron
+	 */
+	void measuresClosedMesh();
+
+	/**
+	 * @brief A large grid has one boundary loop and no handles
+	 */
+	void measuresOpenMesh();
+
+	/**
+	 * @brief A vertex where two fans touch leaves the genus undefined
+	 */
+	void detectsNonManifoldVertices();
+};
@@ -0,0 +1,89 @@
+#include "ObjReaderTest.h"
+#include "ObjReader.h"
+#include "OffWriter.h"
+#include "OffScene.h"
+#include "MeshData.h"
+
+void ObjReaderTest::readsColoredVertices()
+{
+	MeshData mesh;
+	ObjReader::read(QFINDTESTDATA("data/colored.obj"), &mesh);
+	QCOMPARE(mesh.positions, QVector<float>() << 0.0f << 0.0f << 0.0f << 1.0f << 0.0f << 0.0f
+		<< 0.0f << 1.0f << 0.0f << 0.0f << 0.0f << 1.0f);
+	QCOMPARE(mesh.vertexColors, QVector<QColor>() << QColor(Qt::red)
+		<< QColor::fromRgbF(0.0, 1.0, 0.0, 0.5) << QColor(Qt::blue) << QColor(Qt::white));
+	QCOMPARE(mesh.offsets, QVector<int>() << 0 << 3 << 6 << 9 << 12);
+	QCOMPARE(mesh.indices, QVector<int>() << 0 << 2 << 1 << 0 << 1 << 3 << 1 << 2 << 3 << 0 << 3 << 2);
+	QVERIFY(mesh.normals.isEmpty());
+	QVERIFY(mesh.polygonColors.isEmpty());
+}
+
+void ObjReaderTest::splitsByNormals()
+{
+	MeshData mesh;
+	ObjReader::read(QFINDTESTDATA("data/normals.obj"), &mesh);
+	QCOMPARE(mesh.verticesCount(), 12);
+	QCOMPARE(mesh.polygonsCount(), 4);
+	QCOMPARE(mesh.normals.size(), 36);
+
+	// No corner shares its vertex, so they are numbered in the order of the corners
+	int corners[] = {0, 2, 1, 0, 1, 3, 1, 2, 3, 0, 3, 2};
+	float normals[] = {0.0f, 0.0f, -1.0f, 0.0f, -1.0f, 0.0f, 0.5f, 0.5f, 0.5f, -1.0f, 0.0f, 0.0f};
+	QColor colors[] = {QColor(Qt::red), QColor(Qt::green), QColor(Qt::blue), QColor(Qt::white)};
+	MeshData unsplit;
+	ObjReader::read(QFINDTESTDATA("data/colored.obj"), &unsplit);
+	for (int k = 0; k < 12; k++) {
+		QCOMPARE(mesh.indices[k], k);
+		QCOMPARE(mesh.vertexColors[k], colors[corners[k]]);
+		for (int c = 0; c < 3; c++) {
+			QCOMPARE(mesh.positions[3 * k + c], unsplit.positions[3 * corners[k] + c]);
+			QCOMPARE(mesh.normals[3 * k + c], normals[3 * (k / 3) + c]);
+		}
+	}
+}
+
+void ObjReaderTest::writesReadMesh()
+{
+	MeshData mesh;
+	ObjReader::read(QFINDTESTDATA("data/colored.obj"), &mesh);
+	QScopedPointer<IScene> scene(OffScene::fromMesh(mesh));
+
+	QTemporaryDir directory;
+	QVERIFY(directory.isValid());
+	QString file = directory.filePath("written.off");
+	OffWriter::write(scene.data(), file, OffWriter::Text);
+	OffScene read(file, false);
+	QCOMPARE(read.verticesCount(), 4);
+	QCOMPARE(read.polygonsCount(), 4);
+	for (int i = 0; i < 4; i++) {
+		QCOMPARE(read.vertex(i)->color(), mesh.vertexColors[i]);
+		for (int k = 0; k < 3; k++) {
+			QCOMPARE(read.vertex(i)->vertex()[k], mesh.positions[3 * i + k]);
+		}
+	}
+	for (int i = 0; i < 4; i++) {
+		for (int k = 0; k < 3; k++) {
+			QCOMPARE(read.polygon(i)->vertexIndex(k), mesh.indices[3 * i + k]);
+		}
+	}
+}
+
+void ObjReaderTest::rejectsDamagedFiles()
+{
+	QTemporaryDir directory;
+	QVERIFY(directory.isValid());
+	QString file = directory.filePath("damaged.obj");
+	QFile target(file);
+	QVERIFY(target.open(QIODevice::WriteOnly));
+	target.write("v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 4\n");
+	target.close();
+
+	MeshData mesh;
+	bool thrown = false;
+	try {
+		ObjReader::read(file, &mesh);
+	} catch (const QString &) {
+		thrown = true;
+	}
+	QVERIFY(thrown);
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <QtTest>
+
+/**
+ * @brief Tests of ObjReader
+ */
+class ObjReaderTest : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	/**
+	 * @brief Colors of "v" lines, texture coordinates and negative indices
+	 */
+	void readsColoredVertices();
+
+	/**
+	 * @brief Corners with different normals become own vertices, "vc" lines color them
+	 */
+	void splitsByNormals();
+
+	/**
+	 * @brief A read file is written as COFF and reads back the same
+	 */
+	void writesReadMesh();
+
+	/**
+	 * @brief Indices beyond the vertices are rejected
+	 */
+	void rejectsDamagedFiles();
+};
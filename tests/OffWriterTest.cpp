@@ -0,0 +1,159 @@
+#include <cstring>
+
+#include "OffWriterTest.h"
+#include "OffWriter.h"
+#include "OffScene.h"
+#include "OffBinaryReader.h"
+#include "MeshData.h"
+
+void OffWriterTest::formatsShortestFloats()
+{
+	// Subnormals, the limits of float and pseudo random bit patterns
+	QVector<quint32> patterns;
+	patterns << 0x00000001u << 0x00000003u << 0x007fffffu << 0x00800000u << 0x3dcccccdu
+		<< 0x3eaaaaabu << 0x3f800000u << 0x4b7fffffu << 0x7f7fffffu << 0x80000001u;
+	quint32 state = 12345;
+	for (int i = 0; i < 100000; i++) {
+		state = state * 1664525u + 1013904223u;
+		patterns << state;
+	}
+
+	for (quint32 bits : patterns) {
+		float value;
+		memcpy(&value, &bits, sizeof(value));
+		if (!qIsFinite(value)) {
+			continue;
+		}
+		char text[OffWriter::maxFloatChars + 1];
+		QByteArray written(text, int(OffWriter::formatFloat(value, text) - text));
+
+		// OffScene converts each token like this
+		bool ok = false;
+		float read = float(QString::fromLatin1(written).toDouble(&ok));
+		QVERIFY2(ok && sameBits(read, value), written.constData());
+
+		// No shorter number may read back to the same float
+		int shortest = 1;
+		while (float(QByteArray::number(double(value), 'e', shortest - 1).toDouble()) != value) {
+			shortest++;
+		}
+		int exponent = written.indexOf('e');
+		QByteArray mantissa = exponent >= 0 ? written.left(exponent) : written;
+		mantissa.replace("-", "").replace(".", "");
+		while (mantissa.startsWith('0')) {
+			mantissa.remove(0, 1);
+		}
+		while (mantissa.endsWith('0')) {
+			mantissa.chop(1);
+		}
+		QVERIFY2(mantissa.size() <= shortest, written.constData());
+	}
+}
+
+void OffWriterTest::readsTextFile()
+{
+	OffScene scene(QFINDTESTDATA("data/colored.off"), false);
+	QCOMPARE(scene.verticesCount(), 4);
+	QCOMPARE(scene.polygonsCount(), 4);
+	QVERIFY(scene.isColored());
+	QCOMPARE(scene.vertex(1)->color(), QColor::fromRgbF(0.0, 1.0, 0.0, 0.5));
+	QVERIFY(!scene.vertex(2)->isColored());
+	QCOMPARE(scene.vertex(3)->vertex()[2], 1.0f);
+}
+
+void OffWriterTest::readsBinaryFile()
+{
+	OffScene text(QFINDTESTDATA("data/colored.off"), false);
+	QString file = QFINDTESTDATA("data/binary.off");
+	QVERIFY(OffBinaryReader::isBinary(file));
+	MeshData mesh;
+	OffBinaryReader::read(file, &mesh);
+	QScopedPointer<IScene> binary(OffScene::fromMesh(mesh));
+	QCOMPARE(binary->polygonsCount(), 4);
+	compareVertices(&text, binary.data());
+}
+
+void OffWriterTest::writesTextFile()
+{
+	QTemporaryDir directory;
+	QVERIFY(directory.isValid());
+	QString file = directory.filePath("written.off");
+	QScopedPointer<IScene> scenes[2];
+	scenes[0].reset(new OffScene(QFINDTESTDATA("data/colored.off"), false));
+	scenes[1].reset(createScene());
+	for (int i = 0; i < 2; i++) {
+		OffWriter::write(scenes[i].data(), file, OffWriter::Text);
+		QVERIFY(!OffBinaryReader::isBinary(file));
+		OffScene read(file, false);
+		QCOMPARE(read.polygonsCount(), scenes[i]->polygonsCount());
+		compareVertices(scenes[i].data(), &read);
+	}
+}
+
+void OffWriterTest::writesBinaryFile()
+{
+	QTemporaryDir directory;
+	QVERIFY(directory.isValid());
+	QString file = directory.filePath("written.off");
+	QScopedPointer<IScene> scenes[2];
+	scenes[0].reset(new OffScene(QFINDTESTDATA("data/colored.off"), false));
+	scenes[1].reset(createScene());
+	for (int i = 0; i < 2; i++) {
+		OffWriter::write(scenes[i].data(), file, OffWriter::Binary);
+		QVERIFY(OffBinaryReader::isBinary(file));
+		MeshData mesh;
+		OffBinaryReader::read(file, &mesh);
+		QScopedPointer<IScene> read(OffScene::fromMesh(mesh));
+		QCOMPARE(read->polygonsCount(), scenes[i]->polygonsCount());
+		compareVertices(scenes[i].data(), read.data());
+	}
+}
+
+IScene* OffWriterTest::createScene()
+{
+	// A fan of triangles around the first vertex, the positions span all exponents of float
+	MeshData mesh;
+	mesh.positions << 0.0f << 0.0f << 0.0f;
+	quint32 state = 54321;
+	for (int i = 0; i < 1000; i++) {
+		for (int k = 0; k < 3; k++) {
+			state = state * 1664525u + 1013904223u;
+			quint32 bits = state;
+			if ((bits & 0x7f800000u) == 0x7f800000u) {
+				bits &= 0xbfffffffu;
+			}
+			float value;
+			memcpy(&value, &bits, sizeof(value));
+			mesh.positions << value;
+		}
+	}
+	mesh.offsets << 0;
+	for (int i = 1; i < 1000; i++) {
+		mesh.indices << 0 << i << i + 1;
+		mesh.offsets << mesh.indices.size();
+	}
+	return OffScene::fromMesh(mesh);
+}
+
+void OffWriterTest::compareVertices(const IScene *scene, const IScene *read)
+{
+	QCOMPARE(read->verticesCount(), scene->verticesCount());
+	QCOMPARE(read->isColored(), scene->isColored());
+	for (int i = 0; i < scene->verticesCount(); i++) {
+		const CVertex *vertex = scene->vertex(i);
+		const CVertex *readVertex = read->vertex(i);
+		for (int k = 0; k < 3; k++) {
+			QVERIFY2(sameBits(readVertex->vertex()[k], vertex->vertex()[k]),
+				qPrintable(QString("vertex %1").arg(i)));
+		}
+		if (scene->isColored()) {
+			QColor color = vertex->isColored() ? vertex->color() : QColor(Qt::white);
+			QCOMPARE(readVertex->color(), color);
+		}
+	}
+}
+
+bool OffWriterTest::sameBits(float a, float b)
+{
+	return memcmp(&a, &b, sizeof(float)) == 0;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <QtTest>
+
+#include "IScene.h"
+
+/**
+ * @brief Tests of OffWriter and of reading its files again
+ *
+ * The fixtures in tests/data are read, written as text and as binary
+ * file and read again. The positions must come back bit for bit.
+ */
+class OffWriterTest : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	/**
+	 * @brief Every float reads back the same with as few digits as possible
+	 */
+	void formatsShortestFloats();
+
+	/**
+	 * @brief The text fixture has its colored and uncolored elements
+	 */
+	void readsTextFile();
+
+	/**
+	 * @brief The binary fixture has the same mesh as the text fixture
+	 */
+	void readsBinaryFile();
+
+	/**
+	 * @brief A written text file reads back bit for bit
+	 */
+	void writesTextFile();
+
+	/**
+	 * @brief A written binary file reads back bit for bit
+	 */
+	void writesBinaryFile();
+
+private:
+	/**
+	 * @brief Creates a scene with positions of all magnitudes
+	 */
+	static IScene* createScene();
+
+	/**
+	 * @brief Compares the vertices of a scene with a read file
+	 *
+	 * Vertices without a color must come back white.
+	 */
+	static void compareVertices(const IScene *scene, const IScene *read);
+
+	/**
+	 * @brief Are two floats the same bits?
+	 */
+	static bool sameBits(float a, float b);
+};
@@ -0,0 +1,70 @@
+#include "PlyReaderTest.h"
+#include "PlyReader.h"
+#include "OffWriter.h"
+#include "OffScene.h"
+#include "MeshData.h"
+
+void PlyReaderTest::readsLittleEndian()
+{
+	MeshData mesh;
+	PlyReader::read(QFINDTESTDATA("data/little.ply"), &mesh);
+	QCOMPARE(mesh.verticesCount(), 4);
+	QCOMPARE(mesh.positions, QVector<float>() << 0.0f << 0.0f << 0.0f << 1.0f << 0.0f << 0.0f
+		<< 0.0f << 1.0f << 0.0f << 0.0f << 0.0f << 1.0f);
+	QCOMPARE(mesh.vertexColors, QVector<QColor>() << QColor(Qt::red) << QColor(Qt::green)
+		<< QColor(Qt::blue) << QColor(Qt::white));
+	QCOMPARE(mesh.offsets, QVector<int>() << 0 << 3 << 6 << 9 << 12);
+	QCOMPARE(mesh.indices, QVector<int>() << 0 << 2 << 1 << 0 << 1 << 3 << 1 << 2 << 3 << 0 << 3 << 2);
+	QVERIFY(mesh.polygonColors.isEmpty());
+}
+
+void PlyReaderTest::readsBigEndian()
+{
+	MeshData little;
+	PlyReader::read(QFINDTESTDATA("data/little.ply"), &little);
+	MeshData mesh;
+	PlyReader::read(QFINDTESTDATA("data/big.ply"), &mesh);
+	QCOMPARE(mesh.positions, little.positions);
+	QCOMPARE(mesh.offsets, little.offsets);
+	QCOMPARE(mesh.indices, little.indices);
+	QVERIFY(mesh.vertexColors.isEmpty());
+	QCOMPARE(mesh.polygonColors, QVector<QColor>() << QColor(Qt::red) << QColor(Qt::green)
+		<< QColor(Qt::blue) << QColor::fromRgbF(1.0, 1.0, 0.0, 0.5));
+}
+
+void PlyReaderTest::writesReadMesh()
+{
+	QTemporaryDir directory;
+	QVERIFY(directory.isValid());
+	QString file = directory.filePath("written.off");
+	QStringList names;
+	names << "data/little.ply" << "data/big.ply";
+	for (const QString & name : names) {
+		MeshData mesh;
+		PlyReader::read(QFINDTESTDATA(name), &mesh);
+		QScopedPointer<IScene> scene(OffScene::fromMesh(mesh));
+		OffWriter::write(scene.data(), file, OffWriter::Text);
+		OffScene read(file, false);
+		QCOMPARE(read.verticesCount(), 4);
+		QCOMPARE(read.polygonsCount(), 4);
+		QVERIFY(read.isColored());
+		for (int i = 0; i < mesh.vertexColors.size(); i++) {
+			QCOMPARE(read.vertex(i)->color(), mesh.vertexColors[i]);
+		}
+		for (int i = 0; i < mesh.polygonColors.size(); i++) {
+			QCOMPARE(read.polygon(i)->color(), mesh.polygonColors[i]);
+		}
+	}
+}
+
+void PlyReaderTest::rejectsOtherFiles()
+{
+	MeshData mesh;
+	bool thrown = false;
+	try {
+		PlyReader::read(QFINDTESTDATA("data/colored.off"), &mesh);
+	} catch (const QString &) {
+		thrown = true;
+	}
+	QVERIFY(thrown);
+}
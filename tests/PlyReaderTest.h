@@ -0,0 +1,32 @@
+#pragma once
+
+#include <QtTest>
+
+/**
+ * @brief Tests of PlyReader
+ */
+class PlyReaderTest : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	/**
+	 * @brief Little endian float positions with byte colors, other properties and elements are skipped
+	 */
+	void readsLittleEndian();
+
+	/**
+	 * @brief Big endian double positions and unsigned indices with float face colors
+	 */
+	void readsBigEndian();
+
+	/**
+	 * @brief Both files are written as COFF and read back with their colors
+	 */
+	void writesReadMesh();
+
+	/**
+	 * @brief Text files are rejected
+	 */
+	void rejectsOtherFiles();
+};
@@ -0,0 +1,150 @@
+#include <cmath>
+
+#include "QuantizedFileTest.h"
+#include "QuantizedFile.h"
+#include "OffScene.h"
+#include "MeshData.h"
+
+void QuantizedFileTest::writesPaletteColors()
+{
+	OffScene scene(QFINDTESTDATA("data/colored.off"), false);
+	MeshData mesh;
+	writeAndRead(&scene, 16, QuantizedFile::defaultNormalBits, &mesh);
+	QCOMPARE(mesh.verticesCount(), 4);
+	QCOMPARE(mesh.polygonsCount(), 4);
+	QCOMPARE(mesh.vertexColors.size(), 4);
+	QCOMPARE(mesh.polygonColors.size(), 4);
+	for (int i = 0; i < 4; i++) {
+		const CVertex *vertex = scene.vertex(i);
+		QCOMPARE(mesh.vertexColors[i].isValid(), vertex->isColored());
+		if (vertex->isColored()) {
+			QCOMPARE(mesh.vertexColors[i].rgba(), vertex->color().rgba());
+		}
+		const CPolygon *polygon = scene.polygon(i);
+		QCOMPARE(mesh.polygonColors[i].isValid(), polygon->isColored());
+		if (polygon->isColored()) {
+			QCOMPARE(mesh.polygonColors[i].rgba(), polygon->color().rgba());
+		}
+		QCOMPARE(mesh.offsets[i], 3 * i);
+		for (int k = 0; k < 3; k++) {
+			QCOMPARE(mesh.indices[3 * i + k], polygon->vertexIndex(k));
+		}
+	}
+
+	// The corners of the bounding box are exact
+	for (int i = 0; i < 4; i++) {
+		for (int k = 0; k < 3; k++) {
+			QCOMPARE(mesh.positions[3 * i + k], scene.vertex(i)->vertex()[k]);
+		}
+	}
+}
+
+void QuantizedFileTest::writesManyColors()
+{
+	QScopedPointer<IScene> scene(createScene(70000, true));
+	MeshData mesh;
+	writeAndRead(scene.data(), 16, 0, &mesh);
+	QCOMPARE(mesh.vertexColors.size(), scene->verticesCount());
+	QVERIFY(mesh.polygonColors.isEmpty());
+	for (int i = 0; i < scene->verticesCount(); i++) {
+		QCOMPARE(mesh.vertexColors[i].rgba(), scene->vertex(i)->color().rgba());
+	}
+}
+
+void QuantizedFileTest::keepsPositionsWithinStep()
+{
+	QScopedPointer<IScene> scene(createScene(1000, false));
+	QVector<int> bits;
+	bits << QuantizedFile::minPositionBits << 16 << QuantizedFile::maxPositionBits;
+	for (int positionBits : bits) {
+		MeshData mesh;
+		writeAndRead(scene.data(), positionBits, 0, &mesh);
+		QCOMPARE(mesh.verticesCount(), scene->verticesCount());
+		QCOMPARE(mesh.polygonsCount(), scene->polygonsCount());
+		QVERIFY(mesh.vertexColors.isEmpty());
+
+		// The positions span 8 in each direction, float rounding adds a little
+		float step = 8.0f / float((1u << positionBits) - 1);
+		for (int i = 0; i < scene->verticesCount(); i++) {
+			for (int k = 0; k < 3; k++) {
+				float error = std::fabs(mesh.positions[3 * i + k] - scene->vertex(i)->vertex()[k]);
+				QVERIFY2(error <= 0.5f * step + 1e-6f,
+					qPrintable(QString("%1 bits, vertex %2").arg(positionBits).arg(i)));
+			}
+		}
+	}
+}
+
+void QuantizedFileTest::keepsNormals()
+{
+	QScopedPointer<IScene> scene(createScene(1000, false));
+	MeshData mesh;
+	writeAndRead(scene.data(), 16, QuantizedFile::defaultNormalBits, &mesh);
+	QCOMPARE(mesh.normals.size(), 3 * scene->verticesCount());
+	for (int i = 0; i < scene->verticesCount(); i++) {
+		const float *normal = scene->vertex(i)->normal();
+		const float *read = mesh.normals.constData() + 3 * i;
+		double dot = 0.0;
+		double length = 0.0;
+		double readLength = 0.0;
+		for (int k = 0; k < 3; k++) {
+			dot += double(normal[k]) * read[k];
+			length += double(normal[k]) * normal[k];
+			readLength += double(read[k]) * read[k];
+		}
+		if (length > 0.0) {
+			QVERIFY2(dot / std::sqrt(length * readLength) > 0.9999, qPrintable(QString("vertex %1").arg(i)));
+		}
+	}
+
+	writeAndRead(scene.data(), 16, 0, &mesh);
+	QVERIFY(mesh.normals.isEmpty());
+}
+
+void QuantizedFileTest::rejectsOtherFiles()
+{
+	MeshData mesh;
+	bool thrown = false;
+	try {
+		QuantizedFile::read(QFINDTESTDATA("data/binary.off"), &mesh);
+	} catch (const QString &) {
+		thrown = true;
+	}
+	QVERIFY(thrown);
+}
+
+IScene* QuantizedFileTest::createScene(int vertices, bool colored)
+{
+	MeshData mesh;
+	quint32 state = 98765;
+	for (int i = 0; i < vertices; i++) {
+		for (int k = 0; k < 3; k++) {
+			state = state * 1664525u + 1013904223u;
+			mesh.positions << -3.0f + 8.0f * float(state >> 8) / float(1u << 24);
+		}
+		if (colored) {
+			mesh.vertexColors << QColor(i & 255, (i >> 8) & 255, (i >> 16) & 255);
+		}
+	}
+
+	// The box spans exactly 8 in each direction
+	for (int k = 0; k < 3; k++) {
+		mesh.positions[k] = -3.0f;
+		mesh.positions[3 + k] = 5.0f;
+	}
+	mesh.offsets << 0;
+	for (int i = 1; i + 1 < vertices; i++) {
+		mesh.indices << 0 << i << i + 1;
+		mesh.offsets << mesh.indices.size();
+	}
+	return OffScene::fromMesh(mesh);
+}
+
+void QuantizedFileTest::writeAndRead(const IScene *scene, int positionBits, int normalBits, MeshData *mesh)
+{
+	QTemporaryDir directory;
+	QVERIFY(directory.isValid());
+	QString file = directory.filePath("written.ofq");
+	QuantizedFile::write(scene, file, positionBits, normalBits);
+	QuantizedFile::read(file, mesh);
+}
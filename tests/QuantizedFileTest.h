@@ -0,0 +1,54 @@
+#pragma once
+
+#include <QtTest>
+
+#include "IScene.h"
+#include "MeshData.h"
+
+/**
+ * @brief Tests of QuantizedFile
+ */
+class QuantizedFileTest : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	/**
+	 * @brief Few colors are kept through the palette, uncolored vertices stay uncolored
+	 */
+	void writesPaletteColors();
+
+	/**
+	 * @brief More colors than the palette holds are written as RGBA
+	 */
+	void writesManyColors();
+
+	/**
+	 * @brief Positions move at most half a step of the quantization
+	 */
+	void keepsPositionsWithinStep();
+
+	/**
+	 * @brief Normals keep their direction or are left out
+	 */
+	void keepsNormals();
+
+	/**
+	 * @brief Other files are rejected
+	 */
+	void rejectsOtherFiles();
+
+private:
+	/**
+	 * @brief Creates a fan of triangles with pseudo random positions between -3 and 5
+	 *
+	 * @param [in] vertices Number of vertices
+	 * @param [in] colored Gives every vertex a color of its number
+	 */
+	static IScene* createScene(int vertices, bool colored);
+
+	/**
+	 * @brief Writes and reads a scene with the number of bits
+	 */
+	static void writeAndRead(const IScene *scene, int positionBits, int normalBits, MeshData *mesh);
+};
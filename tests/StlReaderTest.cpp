@@ -0,0 +1,76 @@
+#include "StlReaderTest.h"
+#include "StlReader.h"
+#include "VertexWelder.h"
+#include "OffWriter.h"
+#include "OffScene.h"
+#include "MeshData.h"
+
+void StlReaderTest::readsTriangles()
+{
+	MeshData mesh;
+	StlReader::read(QFINDTESTDATA("data/tetrahedron.stl"), &mesh);
+	QCOMPARE(mesh.verticesCount(), 12);
+	QCOMPARE(mesh.polygonsCount(), 4);
+	QVERIFY(mesh.vertexColors.isEmpty());
+	QVERIFY(mesh.polygonColors.isEmpty());
+	QCOMPARE(mesh.positions.mid(3, 6), QVector<float>() << 0.0f << 1.0f << 0.0f << 1.0f << 0.0f << 0.0f);
+
+	QCOMPARE(VertexWelder::weld(&mesh), 8);
+	QCOMPARE(mesh.verticesCount(), 4);
+	QCOMPARE(mesh.offsets, QVector<int>() << 0 << 3 << 6 << 9 << 12);
+	QCOMPARE(mesh.indices, QVector<int>() << 0 << 1 << 2 << 0 << 2 << 3 << 2 << 1 << 3 << 0 << 3 << 1);
+}
+
+void StlReaderTest::writesReadMesh()
+{
+	MeshData mesh;
+	StlReader::read(QFINDTESTDATA("data/tetrahedron.stl"), &mesh);
+	VertexWelder::weld(&mesh);
+	QScopedPointer<IScene> scene(OffScene::fromMesh(mesh));
+
+	QTemporaryDir directory;
+	QVERIFY(directory.isValid());
+	QString file = directory.filePath("tetrahedron.off");
+	OffWriter::write(scene.data(), file, OffWriter::Text);
+	OffScene read(file, false);
+	QCOMPARE(read.verticesCount(), 4);
+	QCOMPARE(read.polygonsCount(), 4);
+	QVERIFY(!read.isColored());
+	for (int i = 0; i < 4; i++) {
+		for (int k = 0; k < 3; k++) {
+			QCOMPARE(read.vertex(i)->vertex()[k], mesh.positions[3 * i + k]);
+		}
+	}
+}
+
+void StlReaderTest::rejectsOtherFiles()
+{
+	MeshData mesh;
+	bool thrown = false;
+	try {
+		StlReader::read(QFINDTESTDATA("data/colored.off"), &mesh);
+	} catch (const QString &) {
+		thrown = true;
+	}
+	QVERIFY(thrown);
+
+	// One triangle less than the file holds
+	QTemporaryDir directory;
+	QVERIFY(directory.isValid());
+	QString file = directory.filePath("short.stl");
+	QFile source(QFINDTESTDATA("data/tetrahedron.stl"));
+	QVERIFY(source.open(QIODevice::ReadOnly));
+	QByteArray data = source.readAll();
+	data[80] = 3;
+	QFile target(file);
+	QVERIFY(target.open(QIODevice::WriteOnly));
+	target.write(data);
+	target.close();
+	thrown = false;
+	try {
+		StlReader::read(file, &mesh);
+	} catch (const QString &) {
+		thrown = true;
+	}
+	QVERIFY(thrown);
+}
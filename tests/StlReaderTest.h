@@ -0,0 +1,27 @@
+#pragma once
+
+#include <QtTest>
+
+/**
+ * @brief Tests of StlReader
+ */
+class StlReaderTest : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	/**
+	 * @brief Each triangle gets its own corners, which weld to the shared vertices
+	 */
+	void readsTriangles();
+
+	/**
+	 * @brief A read and welded file is written as OFF and reads back the same
+	 */
+	void writesReadMesh();
+
+	/**
+	 * @brief Text files and files with a wrong triangle number are rejected
+	 */
+	void rejectsOtherFiles();
+};
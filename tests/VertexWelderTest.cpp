@@ -0,0 +1,100 @@
+#include "VertexWelderTest.h"
+#include "VertexWelder.h"
+
+void VertexWelderTest::weldsIdenticalVertices()
+{
+	// Two triangles with an own copy of each corner, the shared edge has two colors
+	MeshData mesh;
+	addVertex(&mesh, 0.0f, 0.0f, 0.0f);
+	addVertex(&mesh, 1.0f, 0.0f, 0.0f);
+	addVertex(&mesh, 0.0f, 1.0f, 0.0f);
+	addVertex(&mesh, 1.0f, 0.0f, 0.0f);
+	addVertex(&mesh, 1.0f, 1.0f, 0.0f);
+	addVertex(&mesh, 0.0f, 1.0f, -0.0f);
+	mesh.vertexColors = QVector<QColor>(6, QColor(Qt::red));
+	mesh.vertexColors[3] = QColor(Qt::blue);
+	addPolygon(&mesh, QVector<int>() << 0 << 1 << 2);
+	addPolygon(&mesh, QVector<int>() << 3 << 4 << 5);
+
+	QCOMPARE(VertexWelder::weld(&mesh), 1);
+	QCOMPARE(mesh.verticesCount(), 5);
+	QCOMPARE(mesh.vertexColors.size(), 5);
+	QCOMPARE(mesh.indices, QVector<int>() << 0 << 1 << 2 << 3 << 4 << 2);
+	QCOMPARE(mesh.vertexColors[3], QColor(Qt::blue));
+}
+
+void VertexWelderTest::keepsChainsApart()
+{
+	// Each vertex is close to its neighbours, but not to the next but one
+	MeshData mesh;
+	for (int i = 0; i < 5; i++) {
+		addVertex(&mesh, 0.6f * i, 0.0f, 0.0f);
+	}
+	addVertex(&mesh, 0.0f, 5.0f, 0.0f);
+	addVertex(&mesh, 0.0f, 0.0f, 5.0f);
+	for (int i = 0; i < 5; i++) {
+		addPolygon(&mesh, QVector<int>() << i << 5 << 6);
+	}
+
+	VertexWelder::Report report = VertexWelder::clean(&mesh, 1.0f);
+	QCOMPARE(report.vertices, 2);
+	QCOMPARE(mesh.verticesCount(), 5);
+	QCOMPARE(mesh.positions[0], 0.0f);
+	QCOMPARE(mesh.positions[3], 0.6f * 2);
+	QCOMPARE(mesh.positions[6], 0.6f * 4);
+
+	// The triangles of merged vertices are duplicates of the kept ones
+	QCOMPARE(report.duplicatePolygons, 2);
+	QCOMPARE(mesh.polygonsCount(), 3);
+	QCOMPARE(mesh.fileIndices, QVector<int>() << 0 << 2 << 4);
+}
+
+void VertexWelderTest::removesDuplicatePolygons()
+{
+	MeshData mesh;
+	addVertex(&mesh, 0.0f, 0.0f, 0.0f);
+	addVertex(&mesh, 1.0f, 0.0f, 0.0f);
+	addVertex(&mesh, 0.0f, 1.0f, 0.0f);
+	addPolygon(&mesh, QVector<int>() << 0 << 1 << 2);
+	addPolygon(&mesh, QVector<int>() << 1 << 2 << 0);
+	addPolygon(&mesh, QVector<int>() << 2 << 1 << 0);
+	addPolygon(&mesh, QVector<int>() << 2 << 0 << 1);
+
+	VertexWelder::Report report = VertexWelder::clean(&mesh, 0.0f);
+	QCOMPARE(report.vertices, 0);
+	QCOMPARE(report.degeneratePolygons, 0);
+	QCOMPARE(report.duplicatePolygons, 2);
+	QCOMPARE(mesh.fileIndices, QVector<int>() << 0 << 2);
+}
+
+void VertexWelderTest::removesDegeneratePolygons()
+{
+	MeshData mesh;
+	addVertex(&mesh, 0.0f, 0.0f, 0.0f);
+	addVertex(&mesh, 1.0f, 0.0f, 0.0f);
+	addVertex(&mesh, 2.0f, 0.0f, 0.0f);
+	addVertex(&mesh, 0.0f, 1.0f, 0.0f);
+	addPolygon(&mesh, QVector<int>() << 0 << 1 << 2);
+	addPolygon(&mesh, QVector<int>() << 0 << 0 << 1 << 3 << 0);
+	addPolygon(&mesh, QVector<int>() << 1 << 1 << 3);
+
+	VertexWelder::Report report = VertexWelder::clean(&mesh, 0.0f);
+	QCOMPARE(report.degeneratePolygons, 2);
+	QCOMPARE(mesh.polygonsCount(), 1);
+	QCOMPARE(mesh.indices, QVector<int>() << 0 << 1 << 3);
+	QCOMPARE(mesh.fileIndices, QVector<int>() << 1);
+}
+
+void VertexWelderTest::addVertex(MeshData *mesh, float x, float y, float z)
+{
+	mesh->positions << x << y << z;
+}
+
+void VertexWelderTest::addPolygon(MeshData *mesh, const QVector<int> & corners)
+{
+	if (mesh->offsets.isEmpty()) {
+		mesh->offsets.append(0);
+	}
+	mesh->indices += corners;
+	mesh->offsets.append(mesh->indices.size());
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <QtTest>
+
+#include "MeshData.h"
+
+/**
+ * @brief Tests of VertexWelder
+ */
+class VertexWelderTest : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	/**
+	 * @brief Identical corners become one vertex, other colors stay apart
+	 */
+	void weldsIdenticalVertices();
+
+	/**
+	 * @brief A row of close vertices is not pulled into its first vertex
+	 */
+	void keepsChainsApart();
+
+	/**
+	 * @brief Polygons that only start at another corner are removed, back sides are kept
+	 */
+	void removesDuplicatePolygons();
+
+	/**
+	 * @brief Polygons which collapse to a line or a point are removed
+	 */
+	void removesDegeneratePolygons();
+
+private:
+	/**
+	 * @brief Appends a vertex to a mesh
+	 */
+	static void addVertex(MeshData *mesh, float x, float y, float z);
+
+	/**
+	 * @brief Appends a polygon to a mesh
+	 */
+	static void addPolygon(MeshData *mesh, const QVector<int> & corners);
+};
@@ -0,0 +1,44 @@
+/**
+* @file tests/main.cpp
+*
+* @brief Runs the unit tests of OffView
+*
+* All test classes are run one after another, the exit code is the number
+* of classes with failed tests. The arguments of QTest are passed to each
+* class, for example -v2 or a test function name.
+*/
+
+#include <QtTest>
+
+#include "VertexWelderTest.h"
+#include "OffWriterTest.h"
+#include "StlReaderTest.h"
+#include "PlyReaderTest.h"
+#include "ObjReaderTest.h"
+#include "QuantizedFileTest.h"
+#include "MeshComponentsTest.h"
+#include "MeshStatisticsTest.h"
+
+int main(int argc, char** argv)
+{
+	QCoreApplication app(argc, argv);
+
+	int failed = 0;
+	VertexWelderTest vertexWelder;
+	failed += QTest::qExec(&vertexWelder, argc, argv) != 0;
+	OffWriterTest offWriter;
+	failed += QTest::qExec(&offWriter, argc, argv) != 0;
+	StlReaderTest stlReader;
+	failed += QTest::qExec(&stlReader, argc, argv) != 0;
+	PlyReaderTest plyReader;
+	failed += QTest::qExec(&plyReader, argc, argv) != 0;
+	ObjReaderTest objReader;
+	failed += QTest::qExec(&objReader, argc, argv) != 0;
+	QuantizedFileTest quantizedFile;
+	failed += QTest::qExec(&quantizedFile, argc, argv) != 0;
+	MeshComponentsTest meshComponents;
+	failed += QTest::qExec(&meshComponents, argc, argv) != 0;
+	MeshStatisticsTest meshStatistics;
+	failed += QTest::qExec(&meshStatistics, argc, argv) != 0;
+	return failed;
+}
@@ -0,0 +1,72 @@
+# qmake file for the OffView unit tests
+#
+# Build it separately from the application, for example in a directory
+# next to the sources: qmake ../offview/tests/tests.pro && make check
+
+QT += widgets concurrent testlib
+
+CONFIG += c++11
+CONFIG += warn_on
+CONFIG += qt
+CONFIG += console
+CONFIG += testcase
+CONFIG -= app_bundle
+
+TARGET = offtests
+
+INCLUDEPATH += ../src
+
+SOURCES += main.cpp \
+	VertexWelderTest.cpp \
+	OffWriterTest.cpp \
+	StlReaderTest.cpp \
+	PlyReaderTest.cpp \
+	ObjReaderTest.cpp \
+	QuantizedFileTest.cpp \
+	MeshComponentsTest.cpp \
+	MeshStatisticsTest.cpp \
+	../src/CVertex.cpp \
+	../src/CPolygon.cpp \
+	../src/OffScene.cpp \
+	../src/Parallel.cpp \
+	../src/LoadTimings.cpp \
+	../src/Trace.cpp \
+	../src/MemoryReport.cpp \
+	../src/VertexWelder.cpp \
+	../src/OffBinaryReader.cpp \
+	../src/OffWriter.cpp \
+	../src/StlReader.cpp \
+	../src/PlyReader.cpp \
+	../src/ObjReader.cpp \
+	../src/QuantizedFile.cpp \
+	../src/HalfEdgeMesh.cpp \
+	../src/MeshComponents.cpp \
+	../src/MeshStatistics.cpp
+
+HEADERS += VertexWelderTest.h \
+	OffWriterTest.h \
+	StlReaderTest.h \
+	PlyReaderTest.h \
+	ObjReaderTest.h \
+	QuantizedFileTest.h \
+	MeshComponentsTest.h \
+	MeshStatisticsTest.h \
+	../src/CVertex.h \
+	../src/CPolygon.h \
+	../src/IScene.h \
+	../src/OffScene.h \
+	../src/Parallel.h \
+	../src/LoadTimings.h \
+	../src/Trace.h \
+	../src/MemoryReport.h \
+	../src/MeshData.h \
+	../src/VertexWelder.h \
+	../src/OffBinaryReader.h \
+	../src/OffWriter.h \
+	../src/StlReader.h \
+	../src/PlyReader.h \
+	../src/ObjReader.h \
+	../src/QuantizedFile.h \
+	../src/HalfEdgeMesh.h \
+	../src/MeshComponents.h \
+	../src/MeshStatistics.h